@@ -177,4 +177,25 @@ echo "Step 22"
 openssl ca -config ./wolfssl.cnf -gencrl -crldays 1000 -out caEcc384Crl.pem -keyfile ../ca-ecc384-key.pem -cert ../ca-ecc384-cert.pem
 check_result $?
 
+# crl-many, ca-cert CRL with a few hundred entries of varying serial sizes
+# for the sorted revoked serial lookup, revokes server-revoked-cert.pem too
+echo "Step 23"
+cp blank.index.txt demoCA/index.txt
+for i in $(seq 3 301); do
+    len=$(( (i % 16) + 1 ))
+    serial=$(printf "%X%03X" $(( (i % 15) + 1 )) $i)$(echo -n "$i" | sha1sum | cut -c1-$len)
+    [ $(( ${#serial} % 2 )) -eq 1 ] && serial="${serial}0"
+    printf "R\t301231235959Z\t200101000000Z\t%s\tunknown\t/CN=revoked-%d\n" \
+        "$serial" "$i" >> demoCA/index.txt
+done
+openssl ca -config ../renewcerts/wolfssl.cnf -revoke ../server-revoked-cert.pem -keyfile ../ca-key.pem -cert ../ca-cert.pem
+check_result $?
+
+echo "Step 24"
+openssl ca -config ../renewcerts/wolfssl.cnf -gencrl -crldays 1000 -out crl-many.pem -keyfile ../ca-key.pem -cert ../ca-cert.pem
+check_result $?
+openssl crl -in crl-many.pem -text > tmp
+check_result $?
+mv tmp crl-many.pem
+
 exit 0
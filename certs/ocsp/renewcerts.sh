@@ -79,3 +79,23 @@ update_cert server2          "www2.wolfssl.com"                intermediate1-ca
 update_cert server3          "www3.wolfssl.com"                intermediate2-ca v3_req2 07
 update_cert server4          "www4.wolfssl.com"                intermediate2-ca v3_req2 08 # REVOKED
 update_cert server5          "www5.wolfssl.com"                intermediate3-ca v3_req3 09
+
+# $1 cert, $2 ca, signed by the ca so no responder cert has to be trusted
+# thisUpdate is the current time: renew the responses together with the
+# certificates above so it falls inside their validity period
+update_response() {
+    echo "Updating OCSP response \"$1-resp.der\""
+    openssl ocsp -issuer "$2"-cert.pem -cert "$1"-cert.pem -no_nonce \
+        -reqout "$1"-req.der
+    check_result $? "Step 1"
+
+    openssl ocsp -index index-"$2"-issued-certs.txt -rsigner "$2"-cert.pem \
+        -rkey "$2"-key.pem -CA "$2"-cert.pem -reqin "$1"-req.der \
+        -ndays 3650 -respout "$1"-resp.der
+    check_result $? "Step 2"
+
+    rm "$1"-req.der
+}
+
+update_response server1 intermediate1-ca
+update_response server2 intermediate1-ca # REVOKED
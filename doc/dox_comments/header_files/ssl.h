@@ -1904,6 +1904,71 @@ WOLFSSL_API int  wolfSSL_read(WOLFSSL*, void*, int);
 */
 WOLFSSL_API int  wolfSSL_peek(WOLFSSL*, void*, int);
 
+/*!
+    \ingroup IO
+
+    \brief This function is a zero copy version of wolfSSL_read().  Records
+    are decrypted in place in the internal input buffer, and instead of
+    copying the plaintext into a caller buffer data is set to point at the
+    decrypted application data of the current record.  The data is not
+    consumed: it stays valid, and is returned again by the next call, until
+    released with wolfSSL_read_zc_release().  Like wolfSSL_read() this will
+    finish the handshake if needed and at most one record is returned per
+    call.  wolfSSL_read() may be mixed with this function to copy out part of
+    a record.
+
+    \return >0 the number of bytes available at data.
+    \return 0 when the peer closed the connection, see wolfSSL_read().
+    \return SSL_FATAL_ERROR on error or, with non-blocking sockets, when
+    SSL_ERROR_WANT_READ or SSL_ERROR_WANT_WRITE was received. Use
+    wolfSSL_get_error() to get a specific error code.
+    \return BAD_FUNC_ARG if ssl or data is null.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+    \param data set to the decrypted data of the current record.
+
+    _Example_
+    \code
+    WOLFSSL* ssl = 0;
+    const unsigned char* data;
+    int sz;
+    ...
+    sz = wolfSSL_read_zc(ssl, &data);
+    if (sz > 0) {
+        // forward "sz" bytes straight from "data"
+        wolfSSL_read_zc_release(ssl, sz);
+    }
+    \endcode
+
+    \sa wolfSSL_read_zc_release
+    \sa wolfSSL_read
+*/
+WOLFSSL_API int  wolfSSL_read_zc(WOLFSSL*, const unsigned char**);
+
+/*!
+    \ingroup IO
+
+    \brief This function consumes sz bytes of the data returned by
+    wolfSSL_read_zc().  Once the whole record is released the space in the
+    input buffer is reused for the next record, so the pointer must not be
+    used after that.
+
+    \return SSL_SUCCESS will be returned upon success.
+    \return BAD_FUNC_ARG if ssl is null or sz is negative or more than the
+    bytes available.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+    \param sz number of bytes to consume.
+
+    _Example_
+    \code
+    see wolfSSL_read_zc
+    \endcode
+
+    \sa wolfSSL_read_zc
+*/
+WOLFSSL_API int  wolfSSL_read_zc_release(WOLFSSL*, int);
+
 /*!
     \ingroup IO
 
@@ -2322,7 +2387,11 @@ WOLFSSL_API int        wolfSSL_set_session(WOLFSSL*, WOLFSSL_SESSION*);
     The wolfSSL server code allows session resumption by default.
 
     \return pointer If successful the call will return a pointer to the the
-    current SSL session object.
+    current SSL session object. The session is held in the session cache of
+    the connection. With a cache set by wolfSSL_CTX_SetSessionCache() the
+    pointer is only valid until that cache is freed, that is once its last
+    WOLFSSL_CTX is freed. Keep a copy with wolfSSL_SESSION_dup() (built with
+    HAVE_EXT_CACHE) to use the session for longer.
     \return NULL will be returned if ssl is NULL, the SSL session cache is
     disabled, wolfSSL doesn’t have the Session ID available, or mutex
     functions fail.
@@ -2904,6 +2973,162 @@ WOLFSSL_API int  wolfSSL_memrestore_session_cache(const void*, int);
 */
 WOLFSSL_API int  wolfSSL_get_session_cache_memsize(void);
 
+/*!
+    \ingroup Setup
+
+    \brief This function sets how many sessions the internal session cache
+    can hold, overriding the compile time SMALL_SESSION_CACHE,
+    MEDIUM_SESSION_CACHE etc. presets. The size is rounded up to whole cache
+    rows. The cache is allocated when the library is initialized, so this
+    must be called before wolfSSL_Init() or after the last wolfSSL_Cleanup().
+    Each cache row has its own lock so lookups for different sessions don't
+    block each other.
+
+    \return SSL_SUCCESS returned if the size was set.
+    \return BAD_STATE_E returned if the library is already initialized.
+    \return BAD_FUNC_ARG returned if the size needs more rows than a cache
+    supports.
+
+    \param sessions the number of sessions to hold, 0 for the compile time
+    default.
+
+    _Example_
+    \code
+    if (wolfSSL_set_session_cache_size(100000) != SSL_SUCCESS) {
+        // cache size not set
+    }
+    wolfSSL_Init();
+    \endcode
+
+    \sa wolfSSL_Init
+    \sa wolfSSL_get_session_stats
+    \sa wolfSSL_get_session_cache_memsize
+*/
+WOLFSSL_API int  wolfSSL_set_session_cache_size(unsigned int sessions);
+
+/*!
+    \ingroup Setup
+
+    \brief This function creates a session cache that can be given to one
+    or more WOLFSSL_CTX with wolfSSL_CTX_SetSessionCache() so their
+    connections store and look up sessions there instead of in the internal,
+    process wide cache. The size is rounded up to whole cache rows. When a
+    row is full the policy picks the session to replace, an expired one is
+    always used first with WOLFSSL_SESSION_CACHE_LRU and
+    WOLFSSL_SESSION_CACHE_CLOCK. Session persistence and
+    wolfSSL_GetSessionAtIndex() only cover the internal cache.
+
+    \return pointer to the new cache on success.
+    \return NULL if sessions is 0, too large or the policy is unknown, or on
+    memory failure.
+
+    \param sessions the number of sessions to hold.
+    \param timeout session lifetime in seconds, overriding the one of the
+    connection when not 0.
+    \param policy WOLFSSL_SESSION_CACHE_FIFO to replace the oldest stored
+    session, WOLFSSL_SESSION_CACHE_LRU for the least recently used or
+    WOLFSSL_SESSION_CACHE_CLOCK for a second chance approximation of LRU.
+    \param heap memory heap hint, can be NULL.
+
+    _Example_
+    \code
+    WOLFSSL_SESSION_CACHE* cache;
+    cache = wolfSSL_SessionCacheNew(20000, 600, WOLFSSL_SESSION_CACHE_LRU,
+                                    NULL);
+    if (cache == NULL) {
+        // cache not created
+    }
+    wolfSSL_CTX_SetSessionCache(ctx, cache);
+    wolfSSL_SessionCacheFree(cache); // ctx holds a reference
+    \endcode
+
+    \sa wolfSSL_SessionCacheFree
+    \sa wolfSSL_CTX_SetSessionCache
+    \sa wolfSSL_SessionCacheGetStats
+*/
+WOLFSSL_API WOLFSSL_SESSION_CACHE* wolfSSL_SessionCacheNew(unsigned int sessions,
+                               unsigned int timeout, int policy, void* heap);
+
+/*!
+    \ingroup Setup
+
+    \brief This function releases a reference to a session cache made with
+    wolfSSL_SessionCacheNew(). The cache is freed once no WOLFSSL_CTX uses it.
+    Session pointers returned by wolfSSL_get_session() for connections using
+    the cache are not valid after that.
+
+    \return none No returns.
+
+    \param cache the session cache, NULL is ignored.
+
+    _Example_
+    \code
+    wolfSSL_SessionCacheFree(cache);
+    \endcode
+
+    \sa wolfSSL_SessionCacheNew
+*/
+WOLFSSL_API void wolfSSL_SessionCacheFree(WOLFSSL_SESSION_CACHE*);
+
+/*!
+    \ingroup Setup
+
+    \brief This function makes connections created from ctx use cache for
+    session resumption instead of the internal session cache. The ctx takes
+    its own reference to cache, passing NULL goes back to the internal cache.
+    Set it before creating WOLFSSL objects from ctx.
+
+    \return SSL_SUCCESS returned on success.
+    \return BAD_FUNC_ARG returned if ctx is NULL.
+    \return BAD_MUTEX_E returned if the cache reference count can't be locked.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure.
+    \param cache session cache from wolfSSL_SessionCacheNew() or NULL.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx = wolfSSL_CTX_new(wolfTLSv1_2_server_method());
+    if (wolfSSL_CTX_SetSessionCache(ctx, cache) != SSL_SUCCESS) {
+        // cache not set
+    }
+    \endcode
+
+    \sa wolfSSL_SessionCacheNew
+*/
+WOLFSSL_API int  wolfSSL_CTX_SetSessionCache(WOLFSSL_CTX*,
+                                             WOLFSSL_SESSION_CACHE*);
+
+/*!
+    \ingroup Setup
+
+    \brief This function gets the statistics of a session cache: the number
+    of sessions that haven't expired, lookups that found a valid session,
+    lookups that didn't and stored sessions that were replaced before they
+    expired.
+
+    \return SSL_SUCCESS returned on success.
+    \return BAD_STATE_E returned if the internal cache isn't initialized.
+    \return BAD_MUTEX_E returned if a cache row can't be locked.
+
+    \param cache session cache, NULL for the internal cache.
+    \param active number of valid sessions, can be NULL.
+    \param hits number of successful lookups, can be NULL.
+    \param misses number of failed lookups, can be NULL.
+    \param evictions number of valid sessions replaced, can be NULL.
+
+    _Example_
+    \code
+    unsigned int active, hits, misses, evictions;
+    wolfSSL_SessionCacheGetStats(cache, &active, &hits, &misses, &evictions);
+    \endcode
+
+    \sa wolfSSL_SessionCacheNew
+    \sa wolfSSL_get_session_stats
+*/
+WOLFSSL_API int  wolfSSL_SessionCacheGetStats(WOLFSSL_SESSION_CACHE*,
+                  unsigned int* active, unsigned int* hits,
+                  unsigned int* misses, unsigned int* evictions);
+
 /*!
     \ingroup CertsKeys
 
@@ -7483,6 +7708,69 @@ WOLFSSL_API int wolfSSL_CTX_set_group_messages(WOLFSSL_CTX*);
 */
 WOLFSSL_API int wolfSSL_set_group_messages(WOLFSSL*);
 
+/*!
+    \ingroup Setup
+
+    \brief This function sets how many application data records a single
+    wolfSSL_write() may build before sending them.  The records are
+    encrypted back to back into one enlarged output buffer and flushed with
+    one call to the vectored send callback (see wolfSSL_CTX_SetIOSendv()),
+    or to the send callback when none is set, instead of one send per
+    record.  A value of 0 or 1 sends each record on its own, which is the
+    default.  Coalescing is not used for DTLS or when partial writes are
+    enabled.
+
+    \return SSL_SUCCESS will be returned upon success.
+    \return BAD_FUNC_ARG will be returned if the context is null or records
+    is negative or larger than WOLFSSL_MAX_COALESCE_RECORDS.
+
+    \param ctx pointer to the SSL context, created with wolfSSL_CTX_new().
+    \param records maximum number of records flushed per send.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx = 0;
+    ...
+    ret = wolfSSL_CTX_set_coalesce_writes(ctx, 4);
+    if (ret != SSL_SUCCESS) {
+        // failed to set record coalescing
+    }
+    \endcode
+
+    \sa wolfSSL_set_coalesce_writes
+    \sa wolfSSL_CTX_SetIOSendv
+*/
+WOLFSSL_API int wolfSSL_CTX_set_coalesce_writes(WOLFSSL_CTX*, int records);
+
+/*!
+    \ingroup Setup
+
+    \brief This function sets how many application data records a single
+    wolfSSL_write() may build before sending them, see
+    wolfSSL_CTX_set_coalesce_writes().
+
+    \return SSL_SUCCESS will be returned upon success.
+    \return BAD_FUNC_ARG will be returned if ssl is null or records is
+    negative or larger than WOLFSSL_MAX_COALESCE_RECORDS.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+    \param records maximum number of records flushed per send.
+
+    _Example_
+    \code
+    WOLFSSL* ssl = 0;
+    ...
+    ret = wolfSSL_set_coalesce_writes(ssl, 4);
+    if (ret != SSL_SUCCESS) {
+        // failed to set record coalescing
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_set_coalesce_writes
+    \sa wolfSSL_SSLSetIOSendv
+*/
+WOLFSSL_API int wolfSSL_set_coalesce_writes(WOLFSSL*, int records);
+
 /*!
     \brief This function sets the fuzzer callback.
 
@@ -9310,6 +9598,71 @@ WOLFSSL_API int wolfSSL_CertManagerSetOCSPOverrideURL(WOLFSSL_CERT_MANAGER*,
 WOLFSSL_API int wolfSSL_CertManagerSetOCSP_Cb(WOLFSSL_CERT_MANAGER*,
                                                CbOCSPIO, CbOCSPRespFree, void*);
 
+/*!
+    \ingroup CertManager
+    \brief Sets the maximum number of OCSP responses kept by each of the
+    OCSP and OCSP stapling caches of the WOLFSSL_CERT_MANAGER. When a new
+    response would exceed the limit, cached responses past their nextUpdate
+    are dropped first, then the one cached the longest. The default is
+    OCSP_CACHE_MAX_STATUS.
+
+    \return SSL_SUCCESS returned on successful execution.
+    \return BAD_FUNC_ARG returned if cm is NULL or sz is negative.
+
+    \param cm a pointer to a WOLFSSL_CERT_MANAGER structure.
+    \param sz maximum number of cached responses, 0 for no limit.
+
+    _Example_
+    \code
+    WOLFSSL_CERT_MANAGER* cm = wolfSSL_CertManagerNew();
+    …
+    if (wolfSSL_CertManagerSetOCSPCacheSize(cm, 1024) != SSL_SUCCESS) {
+        // failure case
+    }
+    \endcode
+
+    \sa wolfSSL_CertManagerRefreshOCSP
+    \sa wolfSSL_CTX_SetOCSPCacheSize
+*/
+WOLFSSL_API int wolfSSL_CertManagerSetOCSPCacheSize(WOLFSSL_CERT_MANAGER* cm,
+                                                                        int sz);
+
+/*!
+    \ingroup CertManager
+    \brief Fetches new responses from the OCSP responder for every cached
+    response that is older than maxAge seconds or past its nextUpdate. Both
+    the OCSP and OCSP stapling caches are refreshed using the I/O callback
+    set with wolfSSL_CertManagerSetOCSP_Cb. Calling this periodically from an
+    application thread keeps the caches warm so certificate checks and OCSP
+    stapling during a handshake do not wait on the responder. Only
+    certificates that were looked up before are refreshed. A response that
+    fails to refresh stays cached until it expires.
+
+    \return >=0 the number of refreshed responses.
+    \return BAD_FUNC_ARG returned if cm is NULL.
+    \return OCSP_NEED_URL returned if the override URL is in use but unset.
+    \return BAD_MUTEX_E or MEMORY_E on failure.
+
+    \param cm a pointer to a WOLFSSL_CERT_MANAGER structure.
+    \param maxAge refresh responses cached at least this many seconds ago.
+
+    _Example_
+    \code
+    WOLFSSL_CERT_MANAGER* cm;
+    …
+    // from a timer, refresh responses older than an hour
+    if (wolfSSL_CertManagerRefreshOCSP(cm, 3600) < 0) {
+        // failure case
+    }
+    \endcode
+
+    \sa wolfSSL_CertManagerSetOCSPCacheSize
+    \sa wolfSSL_CertManagerSetOCSP_Cb
+    \sa wolfSSL_CTX_RefreshOCSP
+*/
+WOLFSSL_API int wolfSSL_CertManagerRefreshOCSP(WOLFSSL_CERT_MANAGER* cm,
+                                                          unsigned int maxAge);
+
 /*!
     \ingroup CertManager
     \brief This function turns on OCSP stapling if it is not turned on as well
@@ -9828,6 +10181,53 @@ WOLFSSL_API int wolfSSL_CTX_SetOCSP_OverrideURL(WOLFSSL_CTX*, const char*);
 WOLFSSL_API int wolfSSL_CTX_SetOCSP_Cb(WOLFSSL_CTX*,
                                                CbOCSPIO, CbOCSPRespFree, void*);
 
+/*!
+    \ingroup OCSP
+    \brief Sets the maximum number of cached OCSP responses for the
+    WOLFSSL_CTX. See wolfSSL_CertManagerSetOCSPCacheSize.
+
+    \return SSL_SUCCESS returned on successful execution.
+    \return BAD_FUNC_ARG returned if ctx is NULL or sz is negative.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure.
+    \param sz maximum number of cached responses, 0 for no limit.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx = wolfSSL_CTX_new( protocol method );
+    …
+    wolfSSL_CTX_SetOCSPCacheSize(ctx, 1024);
+    \endcode
+
+    \sa wolfSSL_CertManagerSetOCSPCacheSize
+    \sa wolfSSL_CTX_RefreshOCSP
+*/
+WOLFSSL_API int wolfSSL_CTX_SetOCSPCacheSize(WOLFSSL_CTX* ctx, int sz);
+
+/*!
+    \ingroup OCSP
+    \brief Refreshes the cached OCSP responses of the WOLFSSL_CTX that are
+    older than maxAge seconds or past their nextUpdate. See
+    wolfSSL_CertManagerRefreshOCSP.
+
+    \return >=0 the number of refreshed responses.
+    \return BAD_FUNC_ARG returned if ctx is NULL.
+
+    \param ctx a pointer to a WOLFSSL_CTX structure.
+    \param maxAge refresh responses cached at least this many seconds ago.
+
+    _Example_
+    \code
+    WOLFSSL_CTX* ctx;
+    …
+    int refreshed = wolfSSL_CTX_RefreshOCSP(ctx, 3600);
+    \endcode
+
+    \sa wolfSSL_CertManagerRefreshOCSP
+    \sa wolfSSL_CTX_SetOCSPCacheSize
+*/
+WOLFSSL_API int wolfSSL_CTX_RefreshOCSP(WOLFSSL_CTX* ctx, unsigned int maxAge);
+
 /*!
     \brief This function enables OCSP stapling by calling
     wolfSSL_CertManagerEnableOCSPStapling().
@@ -10929,6 +11329,9 @@ WOLFSSL_API int wolfSSL_set_SessionTicket_cb(WOLFSSL*,
 /*!
     \brief This function sets the session ticket key encrypt callback function
     for a server to support session tickets as specified in RFC 5077.
+    A built-in callback that seals tickets with AES-256-GCM (or
+    ChaCha20-Poly1305) and rotates its key can be used instead, see
+    wolfSSL_CTX_UseDefTicketEncCb(). Passing NULL disables tickets.
 
     \return SSL_SUCCESS will be returned upon successfully setting the session.
     \return BAD_FUNC_ARG will be returned on failure. This is caused by passing
@@ -10975,6 +11378,7 @@ WOLFSSL_API int wolfSSL_set_SessionTicket_cb(WOLFSSL*,
 
     \sa wolfSSL_CTX_set_TicketHint
     \sa wolfSSL_CTX_set_TicketEncCtx
+    \sa wolfSSL_CTX_UseDefTicketEncCb
 */
 WOLFSSL_API int wolfSSL_CTX_set_TicketEncCb(WOLFSSL_CTX* ctx,
                                             SessionTicketEncCb);
@@ -11020,6 +11424,102 @@ WOLFSSL_API int wolfSSL_CTX_set_TicketHint(WOLFSSL_CTX* ctx, int);
 */
 WOLFSSL_API int wolfSSL_CTX_set_TicketEncCtx(WOLFSSL_CTX* ctx, void*);
 
+/*!
+    \brief This function makes the server issue session tickets sealed by the
+    built-in callback. Tickets are encrypted with AES-256-GCM, or
+    ChaCha20-Poly1305 when GCM is not available, under a key that rotates
+    every lifetime period. No callback is set by default, so a server only
+    issues tickets once it calls this function or
+    wolfSSL_CTX_set_TicketEncCb(). Replaces a callback set before.
+
+    \return SSL_SUCCESS will be returned upon successfully setting the
+    callback.
+    \return BAD_FUNC_ARG will be returned if ctx is NULL.
+    \return NOT_COMPILED_IN will be returned if the built-in callback is not
+    available, it needs HMAC-SHA256 and AES-256-GCM or ChaCha20-Poly1305.
+
+    \param ctx pointer to the WOLFSSL_CTX object, created
+    with wolfSSL_CTX_new().
+
+    _Example_
+    \code
+    if (wolfSSL_CTX_UseDefTicketEncCb(ctx) != SSL_SUCCESS) {
+        // error enabling session tickets
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_set_TicketKeySecret
+    \sa wolfSSL_CTX_set_TicketKeyLifetime
+    \sa wolfSSL_CTX_set_TicketEncCb
+*/
+WOLFSSL_API int wolfSSL_CTX_UseDefTicketEncCb(WOLFSSL_CTX* ctx);
+
+/*!
+    \brief This function sets the secret the built-in session ticket callback
+    derives its keys from. For server side use. Each key is used for one
+    lifetime period, see wolfSSL_CTX_set_TicketKeyLifetime(), and derived
+    from the secret and the period number. Servers sharing the secret and a
+    lifetime therefore rotate keys together and accept each other's tickets,
+    so stateless resumption works across processes and hosts. Tickets sealed
+    with the previous key are still accepted for the ticket hint after a
+    rotation and a new ticket is issued. Without a secret a random one is
+    generated on first use, so only this CTX accepts its tickets.
+
+    \return SSL_SUCCESS will be returned upon successfully setting the secret.
+    \return BAD_FUNC_ARG will be returned if ctx or secret is NULL or sz is
+    not between 16 and 64 bytes.
+    \return BAD_MUTEX_E will be returned if the key lock fails.
+    \return NOT_COMPILED_IN will be returned if the built-in callback is not
+    available, it needs HMAC-SHA256 and AES-256-GCM or ChaCha20-Poly1305.
+
+    \param ctx pointer to the WOLFSSL_CTX object, created
+    with wolfSSL_CTX_new().
+    \param secret key material shared by the servers
+    \param sz size of secret in bytes
+
+    _Example_
+    \code
+    byte secret[32]; // loaded from a file shared by the fleet
+    ...
+    if (wolfSSL_CTX_set_TicketKeySecret(ctx, secret, sizeof(secret)) !=
+                                                                SSL_SUCCESS) {
+        // error setting ticket key secret
+    }
+    \endcode
+
+    \sa wolfSSL_CTX_UseDefTicketEncCb
+    \sa wolfSSL_CTX_set_TicketKeyLifetime
+    \sa wolfSSL_CTX_set_TicketHint
+*/
+WOLFSSL_API int wolfSSL_CTX_set_TicketKeySecret(WOLFSSL_CTX* ctx,
+                                               const unsigned char* secret,
+                                               unsigned int sz);
+
+/*!
+    \brief This function sets the number of seconds the built-in session
+    ticket callback encrypts with one key before rotating to the next. For
+    server side use. The default is WOLFSSL_TICKET_KEY_LIFETIME, one hour.
+
+    \return SSL_SUCCESS will be returned upon successfully setting the lifetime.
+    \return BAD_FUNC_ARG will be returned if ctx is NULL or seconds is 0.
+    \return BAD_MUTEX_E will be returned if the key lock fails.
+    \return NOT_COMPILED_IN will be returned if the built-in callback is not
+    available.
+
+    \param ctx pointer to the WOLFSSL_CTX object, created
+    with wolfSSL_CTX_new().
+    \param seconds key lifetime in seconds
+
+    _Example_
+    \code
+    wolfSSL_CTX_set_TicketKeyLifetime(ctx, 12 * 60 * 60);
+    \endcode
+
+    \sa wolfSSL_CTX_set_TicketKeySecret
+*/
+WOLFSSL_API int wolfSSL_CTX_set_TicketKeyLifetime(WOLFSSL_CTX* ctx,
+                                                 unsigned int seconds);
+
 /*!
     \ingroup IO
 
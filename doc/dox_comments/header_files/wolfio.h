@@ -81,6 +81,41 @@ WOLFSSL_API int EmbedReceive(WOLFSSL* ssl, char* buf, int sz, void* ctx);
 */
 WOLFSSL_API int EmbedSend(WOLFSSL* ssl, char* buf, int sz, void* ctx);
 
+/*!
+    \brief This function is the vectored send embedded callback. It writes
+    the entries of iov to the socket with a single sendmsg() call and is used
+    to flush application data records that were coalesced by
+    wolfSSL_CTX_set_coalesce_writes().  Available when HAVE_SENDMSG is
+    defined, which is the default for BSD style sockets.
+
+    \return Success This function returns the number of bytes sent, which
+    may be less than the sum of the entries.
+    \return WOLFSSL_CBIO_ERR_WANT_WRITE, WOLFSSL_CBIO_ERR_CONN_RST,
+    WOLFSSL_CBIO_ERR_ISR, WOLFSSL_CBIO_ERR_CONN_CLOSE and
+    WOLFSSL_CBIO_ERR_GENERAL are returned as for EmbedSend().
+
+    \param ssl a pointer to a WOLFSSL structure, created using wolfSSL_new().
+    \param iov array of buffers to send, one per record.
+    \param iovcnt number of entries in iov.
+    \param ctx a void pointer to user registered context.
+
+    _Example_
+    \code
+    WOLFSSL_IOVEC iov[2];
+    ...
+    int dSent = EmbedSendv(ssl, iov, 2, ctx);
+    if (dSent <= 0) {
+        // No bytes sent. Failure case.
+    }
+    \endcode
+
+    \sa EmbedSend
+    \sa wolfSSL_CTX_SetIOSendv
+    \sa wolfSSL_CTX_set_coalesce_writes
+*/
+WOLFSSL_API int EmbedSendv(WOLFSSL* ssl, WOLFSSL_IOVEC* iov, int iovcnt,
+                           void* ctx);
+
 /*!
     \brief This function is the receive embedded callback.
 
@@ -251,6 +286,59 @@ WOLFSSL_API void EmbedOcspRespFree(void*, unsigned char*);
 */
 WOLFSSL_API void wolfSSL_CTX_SetIORecv(WOLFSSL_CTX*, CallbackIORecv);
 
+/*!
+    \brief This function registers a vectored send callback used to flush
+    application data records coalesced by wolfSSL_CTX_set_coalesce_writes().
+    The callback receives one entry per record so a transport that frames
+    records can keep the boundaries, and should return the total number of
+    bytes sent or one of the WOLFSSL_CBIO_ERR_* codes.  When the default
+    EmbedSend() is in use EmbedSendv() is registered automatically.  A
+    custom send callback set with wolfSSL_CTX_SetIOSend() is only paired
+    with a vectored callback set explicitly, without one coalesced records
+    go through the regular send callback as a single buffer.
+
+    \return none no Returns.
+
+    \param ctx pointer to the SSL context, created with wolfSSL_CTX_new().
+    \param callback function to be registered as the vectored send callback,
+    or NULL to flush coalesced records with the regular send callback.
+
+    _Example_
+    \code
+    int MySendv(WOLFSSL* ssl, WOLFSSL_IOVEC* iov, int iovcnt, void* ctx);
+    ...
+    wolfSSL_CTX_SetIOSend(ctx, MySend);
+    wolfSSL_CTX_SetIOSendv(ctx, MySendv);
+    wolfSSL_CTX_set_coalesce_writes(ctx, 4);
+    \endcode
+
+    \sa wolfSSL_SSLSetIOSendv
+    \sa wolfSSL_CTX_SetIOSend
+    \sa wolfSSL_CTX_set_coalesce_writes
+    \sa EmbedSendv
+*/
+WOLFSSL_API void wolfSSL_CTX_SetIOSendv(WOLFSSL_CTX*, CallbackIOSendv);
+
+/*!
+    \brief This function registers a vectored send callback on a single
+    WOLFSSL object, see wolfSSL_CTX_SetIOSendv().
+
+    \return none no Returns.
+
+    \param ssl pointer to the SSL session, created with wolfSSL_new().
+    \param callback function to be registered as the vectored send callback.
+
+    _Example_
+    \code
+    WOLFSSL* ssl = wolfSSL_new(ctx);
+    wolfSSL_SSLSetIOSendv(ssl, MySendv);
+    \endcode
+
+    \sa wolfSSL_CTX_SetIOSendv
+    \sa wolfSSL_set_coalesce_writes
+*/
+WOLFSSL_API void wolfSSL_SSLSetIOSendv(WOLFSSL*, CallbackIOSendv);
+
 /*!
     \brief This function registers a context for the SSL session’s receive
     callback function.  By default, wolfSSL sets the file descriptor passed to
@@ -57,6 +57,7 @@ bench_tls(args);
 #include <string.h>
 #include <unistd.h>
 #include <sys/time.h>
+#include <sys/uio.h>
 #include <errno.h>
 
 /* For testing no pthread support */
@@ -264,6 +265,7 @@ typedef struct {
     double rxTime;
     double txTime;
     int connCount;
+    int resumeCount;
     int rxTotal;
     int txTotal;
 } stats_t;
@@ -283,6 +285,8 @@ typedef struct {
     int runTimeSec;
     int showPeerInfo;
     int showVerbose;
+    int doResume;
+    int coalesce; /* Application data records flushed per send */
 #ifndef NO_WOLFSSL_SERVER
     int listenFd;
 #endif
@@ -519,6 +523,39 @@ static int SocketSend(int sockFd, char* buf, int sz)
     }
     return sent;
 }
+static int SocketSendv(int sockFd, WOLFSSL_IOVEC* iov, int iovcnt)
+{
+    struct iovec vec[16];
+    int i, sent;
+
+    if (iovcnt > (int)(sizeof(vec) / sizeof(vec[0])))
+        iovcnt = (int)(sizeof(vec) / sizeof(vec[0]));
+    for (i = 0; i < iovcnt; i++) {
+        vec[i].iov_base = iov[i].buf;
+        vec[i].iov_len = (size_t)iov[i].sz;
+    }
+
+    sent = (int)writev(sockFd, vec, iovcnt);
+    if (sent == -1) {
+        switch (errno) {
+    #if EAGAIN != SOCKET_EWOULDBLOCK
+        case EAGAIN: /* EAGAIN == EWOULDBLOCK on some systems, but not others */
+    #endif
+        case SOCKET_EWOULDBLOCK:
+            return WOLFSSL_CBIO_ERR_WANT_WRITE;
+        case SOCKET_ECONNRESET:
+            return WOLFSSL_CBIO_ERR_CONN_RST;
+        case SOCKET_EINTR:
+            return WOLFSSL_CBIO_ERR_ISR;
+        case SOCKET_EPIPE:
+            return WOLFSSL_CBIO_ERR_CONN_CLOSE;
+        default:
+            return WOLFSSL_CBIO_ERR_GENERAL;
+        }
+    }
+    return sent;
+}
+
 #if defined(WOLFSSL_DTLS) && !defined(NO_WOLFSSL_SERVER)
 static int ReceiveFrom(WOLFSSL *ssl, int sd, char *buf, int sz)
 {
@@ -631,6 +668,24 @@ static int ServerSend(WOLFSSL* ssl, char* buf, int sz, void* ctx)
 #endif
         return SocketSend(info->server.sockFd, buf, sz);
 }
+static int ServerSendv(WOLFSSL* ssl, WOLFSSL_IOVEC* iov, int iovcnt, void* ctx)
+{
+    info_t* info = (info_t*)ctx;
+    (void)ssl;
+#ifdef HAVE_PTHREAD
+    if (info->useLocalMem) {
+        int i, ret, sent = 0;
+        for (i = 0; i < iovcnt; i++) {
+            ret = ServerMemSend(info, iov[i].buf, iov[i].sz);
+            if (ret < 0)
+                return ret;
+            sent += ret;
+        }
+        return sent;
+    }
+#endif
+    return SocketSendv(info->server.sockFd, iov, iovcnt);
+}
 static int ServerRecv(WOLFSSL* ssl, char* buf, int sz, void* ctx)
 {
     info_t* info = (info_t*)ctx;
@@ -665,6 +720,24 @@ static int ClientSend(WOLFSSL* ssl, char* buf, int sz, void* ctx)
 #endif
         return SocketSend(info->client.sockFd, buf, sz);
 }
+static int ClientSendv(WOLFSSL* ssl, WOLFSSL_IOVEC* iov, int iovcnt, void* ctx)
+{
+    info_t* info = (info_t*)ctx;
+    (void)ssl;
+#ifdef HAVE_PTHREAD
+    if (info->useLocalMem) {
+        int i, ret, sent = 0;
+        for (i = 0; i < iovcnt; i++) {
+            ret = ClientMemSend(info, iov[i].buf, iov[i].sz);
+            if (ret < 0)
+                return ret;
+            sent += ret;
+        }
+        return sent;
+    }
+#endif
+    return SocketSendv(info->client.sockFd, iov, iovcnt);
+}
 static int ClientRecv(WOLFSSL* ssl, char* buf, int sz, void* ctx)
 {
     info_t* info = (info_t*)ctx;
@@ -781,6 +854,9 @@ static int bench_tls_client(info_t* info)
     int ret, readBufSz;
     WOLFSSL_CTX* cli_ctx = NULL;
     WOLFSSL* cli_ssl = NULL;
+#ifndef NO_SESSION_CACHE
+    WOLFSSL_SESSION* session = NULL;
+#endif
     int haveShownPeerInfo = 0;
     int tls13 = XSTRNCMP(info->cipher, "TLS13", 5) == 0;
     int total_sz;
@@ -833,6 +909,14 @@ static int bench_tls_client(info_t* info)
 
     wolfSSL_CTX_SetIOSend(cli_ctx, ClientSend);
     wolfSSL_CTX_SetIORecv(cli_ctx, ClientRecv);
+    if (info->coalesce > 1) {
+        wolfSSL_CTX_SetIOSendv(cli_ctx, ClientSendv);
+        ret = wolfSSL_CTX_set_coalesce_writes(cli_ctx, info->coalesce);
+        if (ret != WOLFSSL_SUCCESS) {
+            printf("error setting record coalescing\n");
+            goto exit;
+        }
+    }
 
     /* set cipher suite */
     ret = wolfSSL_CTX_set_cipher_list(cli_ctx, info->cipher);
@@ -868,6 +952,7 @@ static int bench_tls_client(info_t* info)
     /* BENCHMARK CONNECTIONS LOOP */
     while (!info->client.shutdown) {
         int writeSz = info->packetSize;
+        int rxSz;
     #ifdef BENCH_USE_NONBLOCK
         int err;
     #endif
@@ -905,6 +990,16 @@ static int bench_tls_client(info_t* info)
         wolfSSL_SetIOReadCtx(cli_ssl, info);
         wolfSSL_SetIOWriteCtx(cli_ssl, info);
 
+    #ifndef NO_SESSION_CACHE
+        /* resume the session from the previous connection */
+        if (info->doResume && session != NULL) {
+            ret = wolfSSL_set_session(cli_ssl, session);
+            if (ret != WOLFSSL_SUCCESS && info->showVerbose) {
+                printf("Session not set, doing full handshake\n");
+            }
+        }
+    #endif
+
 #if defined(HAVE_PTHREAD) && defined(WOLFSSL_DTLS)
         /* synchronize with server */ 
         if (info->doDTLS && !info->clientOrserverOnly) {
@@ -938,6 +1033,16 @@ static int bench_tls_client(info_t* info)
         info->client_stats.connTime += start;
         info->client_stats.connCount++;
 
+        if (info->doResume) {
+            if (wolfSSL_session_reused(cli_ssl))
+                info->client_stats.resumeCount++;
+        #ifndef NO_SESSION_CACHE
+            /* points into the process wide session cache, which outlives
+             * cli_ssl and its context */
+            session = wolfSSL_get_session(cli_ssl);
+        #endif
+        }
+
         if ((info->showPeerInfo) && (!haveShownPeerInfo)) {
             haveShownPeerInfo = 1;
             showPeer(cli_ssl);
@@ -989,25 +1094,30 @@ static int bench_tls_client(info_t* info)
             info->client_stats.txTotal += ret;
             total_sz += ret;
 
-            /* read echo of message from server */
+            /* read echo of message from server, one record at a time */
             XMEMSET(readBuf, 0, readBufSz);
-            start = gettime_secs(1);
-        #ifndef BENCH_USE_NONBLOCK
-            ret = wolfSSL_read(cli_ssl, readBuf, readBufSz);
-        #else
-            do {
-                ret = wolfSSL_read(cli_ssl, readBuf, readBufSz);
-                err = wolfSSL_get_error(cli_ssl, ret);
-            }
-            while (err == WOLFSSL_ERROR_WANT_READ);
-        #endif
-            info->client_stats.rxTime += gettime_secs(0) - start;
-            if (ret < 0) {
-                printf("error on client read\n");
-                ret = wolfSSL_get_error(cli_ssl, ret);
-                goto exit;
+            rxSz = 0;
+            while (rxSz < writeSz) {
+                start = gettime_secs(1);
+            #ifndef BENCH_USE_NONBLOCK
+                ret = wolfSSL_read(cli_ssl, readBuf + rxSz, readBufSz - rxSz);
+            #else
+                do {
+                    ret = wolfSSL_read(cli_ssl, readBuf + rxSz,
+                                       readBufSz - rxSz);
+                    err = wolfSSL_get_error(cli_ssl, ret);
+                }
+                while (err == WOLFSSL_ERROR_WANT_READ);
+            #endif
+                info->client_stats.rxTime += gettime_secs(0) - start;
+                if (ret <= 0) {
+                    printf("error on client read\n");
+                    ret = wolfSSL_get_error(cli_ssl, ret);
+                    goto exit;
+                }
+                info->client_stats.rxTotal += ret;
+                rxSz += ret;
             }
-            info->client_stats.rxTotal += ret;
             ret = 0; /* reset return code */
 
             /* validate echo */
@@ -1247,6 +1357,14 @@ static int bench_tls_server(info_t* info)
 
     wolfSSL_CTX_SetIOSend(srv_ctx, ServerSend);
     wolfSSL_CTX_SetIORecv(srv_ctx, ServerRecv);
+    if (info->coalesce > 1) {
+        wolfSSL_CTX_SetIOSendv(srv_ctx, ServerSendv);
+        ret = wolfSSL_CTX_set_coalesce_writes(srv_ctx, info->coalesce);
+        if (ret != WOLFSSL_SUCCESS) {
+            printf("error setting record coalescing\n");
+            goto exit;
+        }
+    }
 
     /* set cipher suite */
     ret = wolfSSL_CTX_set_cipher_list(srv_ctx, info->cipher);
@@ -1336,6 +1454,8 @@ static int bench_tls_server(info_t* info)
 
         info->server_stats.connTime += start;
         info->server_stats.connCount++;
+        if (wolfSSL_session_reused(srv_ssl))
+            info->server_stats.resumeCount++;
 
         /* echo loop */
         ret = 0;
@@ -1478,10 +1598,11 @@ static void print_stats(stats_t* wcStat, const char* desc, const char* cipher, i
                "\tRx          : %9.3f MB/s\n"
                "\tTx          : %9.3f MB/s\n"
                "\tConnect     : %9.3f ms\n"
-               "\tConnect Avg : %9.3f ms\n";
+               "\tConnect Avg : %9.3f ms\n"
+               "\tResumed     : %9d\n";
     }
     else {
-        formatStr = "%-6s  %-33s  %11d  %9d  %9.3f  %9.3f  %9.3f  %9.3f  %17.3f  %15.3f\n";
+        formatStr = "%-6s  %-33s  %11d  %9d  %9.3f  %9.3f  %9.3f  %9.3f  %17.3f  %15.3f  %9d\n";
     }
 
     printf(formatStr,
@@ -1494,7 +1615,8 @@ static void print_stats(stats_t* wcStat, const char* desc, const char* cipher, i
            wcStat->rxTotal / wcStat->rxTime / 1024 / 1024,
            wcStat->txTotal / wcStat->txTime / 1024 / 1024,
            wcStat->connTime * 1000,
-           wcStat->connTime * 1000 / wcStat->connCount);
+           wcStat->connTime * 1000 / wcStat->connCount,
+           wcStat->resumeCount);
 }
 
 static void Usage(void)
@@ -1511,10 +1633,17 @@ static void Usage(void)
     printf("-l <str>    Cipher suite list (: delimited)\n");
     printf("-t <num>    Time <num> (seconds) to run each test (default %d)\n", BENCH_RUNTIME_SEC);
     printf("-p <num>    The packet size <num> in bytes [1-16kB] (default %d)\n", TEST_PACKET_SIZE);
+    printf("            Up to <num> records times 16kB with -W, sockets only\n");
 #ifdef WOLFSSL_DTLS
     printf("            In the case of DTLS, [1-8kB] (default %d)\n", TEST_DTLS_PACKET_SIZE);
 #endif
     printf("-S <num>    The total size <num> in bytes (default %d)\n", TEST_MAX_SIZE);
+    printf("-r          Resume the session of the previous connection\n");
+    printf("-n <num>    Only time <num> wolfSSL_new and wolfSSL_free calls\n");
+    printf("-W <num>    Coalesce up to <num> records into one vectored send\n");
+#ifndef NO_SESSION_CACHE
+    printf("-C <num>    Session cache size <num> in sessions\n");
+#endif
     printf("-v          Show verbose output\n");
 #ifdef DEBUG_WOLFSSL
     printf("-d          Enable debug messages\n");
@@ -1528,6 +1657,48 @@ static void Usage(void)
 #endif
 }
 
+/* Time creating and freeing SSL objects, the RNG of each is instantiated */
+static int bench_ssl_new(int count)
+{
+    WOLFSSL_CTX* ctx;
+    WOLFSSL*     ssl;
+    double start, total;
+    int i;
+
+#ifndef NO_WOLFSSL_CLIENT
+    ctx = wolfSSL_CTX_new(wolfSSLv23_client_method());
+#else
+    ctx = wolfSSL_CTX_new(wolfSSLv23_server_method());
+#endif
+    if (ctx == NULL) {
+        printf("error creating ctx\n");
+        return MEMORY_E;
+    }
+
+    start = gettime_secs(1);
+    for (i = 0; i < count; i++) {
+        ssl = wolfSSL_new(ctx);
+        if (ssl == NULL) {
+            printf("error creating ssl\n");
+            wolfSSL_CTX_free(ctx);
+            return MEMORY_E;
+        }
+        wolfSSL_free(ssl);
+    }
+    total = gettime_secs(0) - start;
+
+    printf("wolfSSL_new/free %d times, %.3f us each, %.0f per second "
+    #ifdef WC_RNG_POOL
+           "(RNG pool)\n",
+    #else
+           "(no RNG pool)\n",
+    #endif
+           count, total * 1000000 / count, count / total);
+
+    wolfSSL_CTX_free(ctx);
+    return 0;
+}
+
 static void ShowCiphers(void)
 {
     char ciphers[WOLFSSL_CIPHER_LIST_MAX_SIZE];
@@ -1565,6 +1736,9 @@ int bench_tls(void* args)
     const char* argHost = BENCH_DEFAULT_HOST;
     int argPort = BENCH_DEFAULT_PORT;
     int argShowPeerInfo = 0;
+    int argResume = 0;
+    int argCoalesce = 0;
+    int argNewCount = 0;
 #ifdef HAVE_PTHREAD
     int doShutdown;
 #endif
@@ -1584,11 +1758,8 @@ int bench_tls(void* args)
         ((func_args*)args)->return_code = -1; /* error state */
     }
 
-    /* Initialize wolfSSL */
-    wolfSSL_Init();
-
     /* Parse command line arguments */
-    while ((ch = mygetopt(argc, argv, "?" "udeil:p:t:vT:sch:P:mS:")) != -1) {
+    while ((ch = mygetopt(argc, argv, "?" "udeil:p:t:vT:sch:P:mS:rC:W:n:")) != -1) {
         switch (ch) {
             case '?' :
                 Usage();
@@ -1630,11 +1801,6 @@ int bench_tls(void* args)
 
             case 'p' :
                 argTestPacketSize = atoi(myoptarg);
-                if (argTestPacketSize > (16 * 1024)) {
-                    printf("Invalid packet size %d\n", argTestPacketSize);
-                    Usage();
-                    ret = MY_EX_USAGE; goto exit;
-                }
             #if defined(WOLFSSL_DTLS) && !defined(NO_WOLFSSL_SERVER)
                 option_p = 1;
             #endif
@@ -1644,6 +1810,32 @@ int bench_tls(void* args)
                 argTestMaxSize = atoi(myoptarg);
                 break;
 
+            case 'r' :
+                argResume = 1;
+                break;
+
+            case 'W' :
+                argCoalesce = atoi(myoptarg);
+                break;
+
+            case 'n' :
+                argNewCount = atoi(myoptarg);
+                break;
+
+            case 'C' :
+            #ifndef NO_SESSION_CACHE
+                /* cache is sized by wolfSSL_Init, done after parsing */
+                ret = wolfSSL_set_session_cache_size(
+                                                (unsigned int)atoi(myoptarg));
+                if (ret != WOLFSSL_SUCCESS) {
+                    printf("Invalid session cache size %s\n", myoptarg);
+                    Usage();
+                    ret = MY_EX_USAGE; goto exit;
+                }
+                ret = 0;
+            #endif
+                break;
+
             case 't' :
                 argRuntimeSec = atoi(myoptarg);
                 break;
@@ -1683,6 +1875,27 @@ int bench_tls(void* args)
     /* reset for test cases */
     myoptind = 0;
 
+    /* a packet larger than one record is only allowed when coalescing and
+     * does not fit the local memory buffers */
+    if (argTestPacketSize > (16 * 1024) &&
+            (argTestPacketSize > argCoalesce * (16 * 1024)
+        #ifdef HAVE_PTHREAD
+                || argLocalMem
+        #endif
+            )) {
+        printf("Invalid packet size %d\n", argTestPacketSize);
+        Usage();
+        ret = MY_EX_USAGE; goto exit;
+    }
+
+    /* Initialize wolfSSL */
+    wolfSSL_Init();
+
+    if (argNewCount > 0) {
+        ret = bench_ssl_new(argNewCount);
+        goto exit;
+    }
+
     if (argCipherList != NULL) {
         /* Use the list from CL argument */
         cipher = argCipherList;
@@ -1773,6 +1986,8 @@ int bench_tls(void* args)
             info->maxSize = argTestMaxSize;
             info->showPeerInfo = argShowPeerInfo;
             info->showVerbose = argShowVerbose;
+            info->doResume = argResume;
+            info->coalesce = argCoalesce;
         #ifndef NO_WOLFSSL_SERVER
             info->listenFd = listenFd;
         #endif
@@ -1869,6 +2084,9 @@ int bench_tls(void* args)
             cli_comb.connCount += info->client_stats.connCount;
             srv_comb.connCount += info->server_stats.connCount;
 
+            cli_comb.resumeCount += info->client_stats.resumeCount;
+            srv_comb.resumeCount += info->server_stats.resumeCount;
+
             cli_comb.connTime += info->client_stats.connTime;
             srv_comb.connTime += info->server_stats.connTime;
 
@@ -1889,9 +2107,10 @@ int bench_tls(void* args)
             printf("Totals for %d Threads\n", argThreadPairs);
         }
         else {
-            printf("%-6s  %-33s  %11s  %9s  %9s  %9s  %9s  %9s  %17s  %15s\n",
+            printf("%-6s  %-33s  %11s  %9s  %9s  %9s  %9s  %9s  %17s  %15s  %9s\n",
                 "Side", "Cipher", "Total Bytes", "Num Conns", "Rx ms", "Tx ms",
-                "Rx MB/s", "Tx MB/s", "Connect Total ms", "Connect Avg ms");
+                "Rx MB/s", "Tx MB/s", "Connect Total ms", "Connect Avg ms",
+                "Resumed");
         #ifndef NO_WOLFSSL_SERVER
             if (!argClientOnly)
                 print_stats(&srv_comb, "Server", theadInfo[0].cipher, 0);
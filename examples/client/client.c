@@ -3407,6 +3407,9 @@ exit:
                                          && defined(HAVE_STACK_SIZE)
     wc_ecc_fp_free();  /* free per thread cache */
 #endif
+#if defined(WC_RNG_POOL) && defined(HAVE_STACK_SIZE)
+    wc_RngPoolFree();  /* free per thread parent DRBG */
+#endif
 
     /* There are use cases  when these assignments are not read. To avoid
      * potential confusion those warnings have been handled here.
@@ -2489,6 +2489,10 @@ exit:
                       && (defined(NO_MAIN_DRIVER) || defined(HAVE_STACK_SIZE))
     wc_ecc_fp_free();  /* free per thread cache */
 #endif
+#if defined(WC_RNG_POOL) && \
+                        (defined(NO_MAIN_DRIVER) || defined(HAVE_STACK_SIZE))
+    wc_RngPoolFree();  /* free per thread parent DRBG */
+#endif
 
 #ifdef WOLFSSL_TIRTOS
     fdCloseSession(Task_self());
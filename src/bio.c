@@ -67,6 +67,94 @@ static int wolfSSL_BIO_BIO_read(WOLFSSL_BIO* bio, void* buf, int len)
 }
 
 
+/* Memory BIO layout:
+ *
+ * ptr    buffer holding the data, num bytes are allocated
+ * rdIdx  offset of the first unread byte in ptr
+ * wrSz   number of unread bytes, stored contiguously after rdIdx
+ *
+ * Reads only advance rdIdx. Writes append after the unread data and reclaim
+ * the consumed front of the buffer or grow it geometrically when out of room,
+ * so both are amortized O(1) per byte. mem_buf->data always points to ptr so
+ * that freeing the BUF_MEM frees the buffer.
+ */
+
+/* Makes room for len more bytes after the unread data of a memory BIO.
+ *
+ * returns 0 on success
+ */
+static int wolfSSL_BIO_MEMORY_grow(WOLFSSL_BIO* bio, int len)
+{
+    int need;
+    int newSz;
+
+    if (len > MAX_BIO_MEM_SZ - bio->wrSz) {
+        WOLFSSL_MSG("Memory BIO size too large");
+        return WOLFSSL_FAILURE;
+    }
+    need = bio->wrSz + len;
+
+    if (need <= bio->num - bio->rdIdx) {
+        return 0;
+    }
+
+    /* Compact once the consumed front is at least as large as the unread data
+     * it would move, keeping the cost of the move paid for by earlier reads. */
+    if (bio->rdIdx > 0 && (bio->rdIdx >= bio->wrSz ||
+                           bio->rdIdx > MAX_BIO_MEM_SZ - need)) {
+        XMEMMOVE(bio->ptr, (byte*)bio->ptr + bio->rdIdx, bio->wrSz);
+        bio->rdIdx = 0;
+        if (need <= bio->num) {
+            return 0;
+        }
+    }
+
+    newSz = bio->num;
+    if (newSz < MIN_BIO_MEM_SZ) {
+        newSz = MIN_BIO_MEM_SZ;
+    }
+    while (newSz < bio->rdIdx + need) {
+        newSz = (newSz > MAX_BIO_MEM_SZ / 2) ? MAX_BIO_MEM_SZ : newSz * 2;
+    }
+
+    if (bio->ptr == NULL) {
+        bio->ptr = (byte*)XMALLOC(newSz, bio->heap, DYNAMIC_TYPE_OPENSSL);
+    }
+    else {
+        byte* tmp = (byte*)XREALLOC(bio->ptr, newSz, bio->heap,
+            DYNAMIC_TYPE_OPENSSL);
+        if (tmp == NULL) {
+            WOLFSSL_MSG("Error on realloc");
+            return WOLFSSL_FAILURE;
+        }
+        bio->ptr = tmp;
+    }
+    if (bio->ptr == NULL) {
+        WOLFSSL_MSG("Error on malloc");
+        return WOLFSSL_FAILURE;
+    }
+    bio->num = newSz;
+    if (bio->mem_buf != NULL) {
+        bio->mem_buf->data = (char*)bio->ptr;
+        bio->mem_buf->max  = bio->num;
+    }
+
+    return 0;
+}
+
+
+/* Marks sz bytes of a memory BIO as read. Rewinds to the start of the buffer
+ * once everything has been consumed. */
+static void wolfSSL_BIO_MEMORY_consume(WOLFSSL_BIO* bio, int sz)
+{
+    bio->rdIdx += sz;
+    bio->wrSz  -= sz;
+    if (bio->wrSz == 0) {
+        bio->rdIdx = 0;
+    }
+}
+
+
 /* Handles reading from a memory type BIO and advancing the state.
  *
  * bio  WOLFSSL_BIO to read from
@@ -82,40 +170,16 @@ static int wolfSSL_BIO_MEMORY_read(WOLFSSL_BIO* bio, void* buf, int len)
 
     sz = wolfSSL_BIO_pending(bio);
     if (sz > 0) {
-        const unsigned char* pt = NULL;
-        int memSz;
-
         if (sz > len) {
             sz = len;
         }
-        memSz = wolfSSL_BIO_get_mem_data(bio, (void*)&pt);
-        if (memSz >= sz && pt != NULL) {
-            byte* tmp;
-
-            XMEMCPY(buf, (void*)pt, sz);
-            if (memSz - sz > 0) {
-                tmp = (byte*)XMALLOC(memSz-sz, bio->heap, DYNAMIC_TYPE_OPENSSL);
-                if (tmp == NULL) {
-                    WOLFSSL_MSG("Memory error");
-                    return WOLFSSL_BIO_ERROR;
-                }
-                XMEMCPY(tmp, (void*)(pt + sz), memSz - sz);
-
-                /* reset internal bio->mem */
-                XFREE(bio->ptr, bio->heap, DYNAMIC_TYPE_OPENSSL);
-                bio->ptr    = tmp;
-                bio->num = memSz-sz;
-                if (bio->mem_buf != NULL) {
-                    bio->mem_buf->data = (char*)bio->ptr;
-                    bio->mem_buf->length = bio->num;
-                }
-            }
-            bio->wrSz  -= sz;
-        }
-        else {
+        if (bio->ptr == NULL) {
             WOLFSSL_MSG("Issue with getting bio mem pointer");
             return 0;
         }
+
+        XMEMCPY(buf, (byte*)bio->ptr + bio->rdIdx, sz);
+        wolfSSL_BIO_MEMORY_consume(bio, sz);
     }
     else {
         return WOLFSSL_BIO_ERROR;
@@ -403,53 +467,21 @@ static int wolfSSL_BIO_BIO_write(WOLFSSL_BIO* bio, const void* data,
 static int wolfSSL_BIO_MEMORY_write(WOLFSSL_BIO* bio, const void* data,
         int len)
 {
-    int   sz;
-    const unsigned char* buf;
-
     WOLFSSL_ENTER("wolfSSL_BIO_MEMORY_write");
 
-    if (bio == NULL || data == NULL) {
+    if (bio == NULL || data == NULL || len < 0) {
         return BAD_FUNC_ARG;
     }
 
-    sz = wolfSSL_BIO_pending(bio);
-    if (sz < 0) {
-        WOLFSSL_MSG("Error getting memory data");
-        return sz;
-    }
-
-    if (bio->ptr == NULL) {
-        bio->ptr = (byte*)XMALLOC(len, bio->heap, DYNAMIC_TYPE_OPENSSL);
-        if (bio->ptr == NULL) {
-            WOLFSSL_MSG("Error on malloc");
-            return WOLFSSL_FAILURE;
-        }
-        bio->num = len;
-        if (bio->mem_buf != NULL) {
-            bio->mem_buf->data = (char*)bio->ptr;
-            bio->mem_buf->length = bio->num;
-        }
+    if (len == 0) {
+        return 0;
     }
 
-    /* check if will fit in current buffer size */
-    if (wolfSSL_BIO_get_mem_data(bio, (void*)&buf) < 0) {
-        return WOLFSSL_BIO_ERROR;
-    }
-    if (bio->num < sz + len) {
-        bio->ptr = (byte*)XREALLOC(bio->ptr, sz + len, bio->heap,
-            DYNAMIC_TYPE_OPENSSL);
-        if (bio->ptr == NULL) {
-            WOLFSSL_MSG("Error on realloc");
-            return WOLFSSL_FAILURE;
-        }
-        bio->num = sz + len;
-        if (bio->mem_buf != NULL) {
-            bio->mem_buf->data = (char*)bio->ptr;
-            bio->mem_buf->length = bio->num;
-        }
+    if (wolfSSL_BIO_MEMORY_grow(bio, len) != 0) {
+        return WOLFSSL_FAILURE;
     }
 
-    XMEMCPY((byte*)bio->ptr + sz, data, len);
+    XMEMCPY((byte*)bio->ptr + bio->rdIdx + bio->wrSz, data, len);
     bio->wrSz += len;
 
     return len;
@@ -998,6 +1030,16 @@ long wolfSSL_BIO_get_mem_ptr(WOLFSSL_BIO *bio, WOLFSSL_BUF_MEM **ptr)
     while (bio != NULL) {
 
         if (bio->type == WOLFSSL_BIO_MEMORY) {
+            /* BUF_MEM users expect the unread data at the start of data */
+            if (bio->rdIdx > 0) {
+                XMEMMOVE(bio->ptr, (byte*)bio->ptr + bio->rdIdx, bio->wrSz);
+                bio->rdIdx = 0;
+            }
+            if (bio->mem_buf != NULL) {
+                bio->mem_buf->data   = (char*)bio->ptr;
+                bio->mem_buf->length = bio->wrSz;
+                bio->mem_buf->max    = bio->num;
+            }
             *ptr = bio->mem_buf;
             ret = WOLFSSL_SUCCESS;
         }
@@ -1125,6 +1167,12 @@ int wolfSSL_BIO_nread0(WOLFSSL_BIO *bio, char **buf)
         return 0;
     }
 
+    /* unread data of a memory BIO is always contiguous */
+    if (bio->type == WOLFSSL_BIO_MEMORY) {
+        *buf = (bio->ptr == NULL) ? NULL : (char*)bio->ptr + bio->rdIdx;
+        return bio->wrSz;
+    }
+
     /* if paired read from pair */
     if (bio->pair != NULL) {
         WOLFSSL_BIO* pair = bio->pair;
@@ -1156,7 +1204,19 @@ int wolfSSL_BIO_nread(WOLFSSL_BIO *bio, char **buf, int num)
     }
 
     if (bio->type == WOLFSSL_BIO_MEMORY) {
-        return SSL_FAILURE;
+        /* the returned data stays valid until the next write or reset */
+        sz = wolfSSL_BIO_nread0(bio, buf);
+        if (num == 0) {
+            return 0;
+        }
+        if (sz == 0) {
+            return WOLFSSL_BIO_ERROR;
+        }
+        if (num < sz) {
+            sz = num;
+        }
+        wolfSSL_BIO_MEMORY_consume(bio, sz);
+        return sz;
     }
 
     if (bio->pair != NULL) {
@@ -1299,6 +1359,7 @@ int wolfSSL_BIO_reset(WOLFSSL_BIO *bio)
             if (bio->mem_buf != NULL) {
                 bio->mem_buf->data = (char*)bio->ptr;
                 bio->mem_buf->length = bio->num;
+                bio->mem_buf->max = bio->num;
             }
             return 0;
 
@@ -1682,6 +1743,14 @@ int wolfSSL_BIO_get_mem_data(WOLFSSL_BIO* bio, void* p)
     if (bio == NULL)
         return WOLFSSL_FATAL_ERROR;
 
+    if (bio->type == WOLFSSL_BIO_MEMORY) {
+        if (p) {
+            *(byte**)p = (bio->ptr == NULL) ? NULL :
+                                              (byte*)bio->ptr + bio->rdIdx;
+        }
+        return bio->wrSz;
+    }
+
     if (p) {
         *(byte**)p = (byte*)bio->ptr;
     }
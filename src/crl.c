@@ -54,7 +54,7 @@ int InitCRL(WOLFSSL_CRL* crl, WOLFSSL_CERT_MANAGER* cm)
     else
         crl->heap = NULL;
     crl->cm = cm;
-    crl->crlList = NULL;
+    XMEMSET(crl->crlTable, 0, sizeof(crl->crlTable));
     crl->monitors[0].path = NULL;
     crl->monitors[1].path = NULL;
 #ifdef HAVE_CRL_MONITOR
@@ -65,11 +65,129 @@ int InitCRL(WOLFSSL_CRL* crl, WOLFSSL_CERT_MANAGER* cm)
         WOLFSSL_MSG("Pthread condition init failed");
         return BAD_COND_E;
     }
-#endif
-    if (wc_InitMutex(&crl->crlLock) != 0) {
+    if (wc_InitMutex(&crl->setupLock) != 0) {
         WOLFSSL_MSG("Init Mutex failed");
         return BAD_MUTEX_E;
     }
+#endif
+    if (wc_InitRwLock(&crl->crlLock) != 0) {
+        WOLFSSL_MSG("Init RwLock failed");
+        return BAD_MUTEX_E;
+    }
+
+    return 0;
+}
+
+
+/* CRL table row for issuer hash */
+static WC_INLINE word32 HashCRL(const byte* hash)
+{
+    return (((word32)hash[0] << 24) | ((word32)hash[1] << 16) |
+            ((word32)hash[2] <<  8) |  (word32)hash[3]) % CRL_TABLE_SIZE;
+}
+
+
+/* order revoked serials by size then value, returns <0, 0 or >0 */
+static WC_INLINE int CompareSerial(const byte* a, int aSz, const byte* b,
+                                   int bSz)
+{
+    if (aSz != bSz)
+        return aSz - bSz;
+    return XMEMCMP(a, b, aSz);
+}
+
+
+/* move the largest of the heap rooted at root down to keep heap order */
+static void SiftRevoked(RevokedCert* rc, int root, int count)
+{
+    RevokedCert tmp;
+    int child;
+
+    while ((child = 2 * root + 1) < count) {
+        if (child + 1 < count &&
+                CompareSerial(rc[child].serialNumber, rc[child].serialSz,
+                    rc[child + 1].serialNumber, rc[child + 1].serialSz) < 0) {
+            child++;
+        }
+        if (CompareSerial(rc[root].serialNumber, rc[root].serialSz,
+                          rc[child].serialNumber, rc[child].serialSz) >= 0) {
+            break;
+        }
+        tmp = rc[root];
+        rc[root] = rc[child];
+        rc[child] = tmp;
+        root = child;
+    }
+}
+
+
+/* Turn the decoded revoked cert list into an array sorted by serial, in place
+ * heap sort so no extra memory is needed for large CRLs. Frees the list, 0 on
+ * success */
+static int SortRevokedCerts(CRL_Entry* crle, RevokedCert* list, int count,
+                            void* heap)
+{
+    RevokedCert* rc = NULL;
+    RevokedCert  tmp;
+    int          i;
+    int          n = 0;
+
+    if (count > 0) {
+        rc = (RevokedCert*)XMALLOC(sizeof(RevokedCert) * count, heap,
+                                   DYNAMIC_TYPE_REVOKED);
+    }
+
+    while (list != NULL) {
+        RevokedCert* next = list->next;
+        if (rc != NULL && n < count) {
+            XMEMCPY(rc[n].serialNumber, list->serialNumber, list->serialSz);
+            rc[n].serialSz = list->serialSz;
+            rc[n].next = NULL;
+            n++;
+        }
+        XFREE(list, heap, DYNAMIC_TYPE_REVOKED);
+        list = next;
+    }
+
+    if (count > 0 && rc == NULL)
+        return MEMORY_E;
+    count = n;
+
+    for (i = count / 2 - 1; i >= 0; i--)
+        SiftRevoked(rc, i, count);
+    for (i = count - 1; i > 0; i--) {
+        tmp = rc[0];
+        rc[0] = rc[i];
+        rc[i] = tmp;
+        SiftRevoked(rc, 0, i);
+    }
+
+    crle->certs = rc;
+    crle->totalCerts = count;
+
+    (void)heap;
+
+    return 0;
+}
+
+
+/* binary search the sorted revoked serials, 1 if found */
+static int FindRevokedCert(CRL_Entry* crle, const byte* serial, int serialSz)
+{
+    int low = 0;
+    int high = crle->totalCerts - 1;
+
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        int cmp = CompareSerial(crle->certs[mid].serialNumber,
+                                crle->certs[mid].serialSz, serial, serialSz);
+        if (cmp == 0)
+            return 1;
+        if (cmp < 0)
+            low = mid + 1;
+        else
+            high = mid - 1;
+    }
 
     return 0;
 }
@@ -89,9 +207,14 @@ static int InitCRL_Entry(CRL_Entry* crle, DecodedCRL* dcrl, const byte* buff,
     crle->lastDateFormat = dcrl->lastDateFormat;
     crle->nextDateFormat = dcrl->nextDateFormat;
 
-    crle->certs = dcrl->certs;   /* take ownsership */
+    /* take ownership */
+    crle->toBeSigned = NULL;
+    crle->signature = NULL;
+    if (SortRevokedCerts(crle, dcrl->certs, dcrl->totalCerts, heap) != 0) {
+        dcrl->certs = NULL;
+        return -1;
+    }
     dcrl->certs = NULL;
-    crle->totalCerts = dcrl->totalCerts;
     crle->verified = verified;
     if (!verified) {
         crle->tbsSz = dcrl->sigIndex - dcrl->certBegin;
@@ -99,12 +222,15 @@ static int InitCRL_Entry(CRL_Entry* crle, DecodedCRL* dcrl, const byte* buff,
         crle->signatureOID = dcrl->signatureOID;
         crle->toBeSigned = (byte*)XMALLOC(crle->tbsSz, heap,
                                           DYNAMIC_TYPE_CRL_ENTRY);
-        if (crle->toBeSigned == NULL)
+        if (crle->toBeSigned == NULL) {
+            XFREE(crle->certs, heap, DYNAMIC_TYPE_REVOKED);
             return -1;
+        }
         crle->signature = (byte*)XMALLOC(crle->signatureSz, heap,
                                          DYNAMIC_TYPE_CRL_ENTRY);
         if (crle->signature == NULL) {
             XFREE(crle->toBeSigned, heap, DYNAMIC_TYPE_CRL_ENTRY);
+            XFREE(crle->certs, heap, DYNAMIC_TYPE_REVOKED);
             return -1;
         }
         XMEMCPY(crle->toBeSigned, buff + dcrl->certBegin, crle->tbsSz);
@@ -115,10 +241,6 @@ static int InitCRL_Entry(CRL_Entry* crle, DecodedCRL* dcrl, const byte* buff,
             XMEMCPY(crle->extAuthKeyId, dcrl->extAuthKeyId, KEYID_SIZE);
     #endif
     }
-    else {
-        crle->toBeSigned = NULL;
-        crle->signature = NULL;
-    }
 
     (void)verified;
     (void)heap;
@@ -130,16 +252,10 @@ static int InitCRL_Entry(CRL_Entry* crle, DecodedCRL* dcrl, const byte* buff,
 /* Free all CRL Entry resources */
 static void FreeCRL_Entry(CRL_Entry* crle, void* heap)
 {
-    RevokedCert* tmp = crle->certs;
-    RevokedCert* next;
-
     WOLFSSL_ENTER("FreeCRL_Entry");
 
-    while (tmp) {
-        next = tmp->next;
-        XFREE(tmp, heap, DYNAMIC_TYPE_REVOKED);
-        tmp = next;
-    }
+    if (crle->certs != NULL)
+        XFREE(crle->certs, heap, DYNAMIC_TYPE_REVOKED);
     if (crle->signature != NULL)
         XFREE(crle->signature, heap, DYNAMIC_TYPE_REVOKED);
     if (crle->toBeSigned != NULL)
@@ -153,7 +269,8 @@ static void FreeCRL_Entry(CRL_Entry* crle, void* heap)
 /* Free all CRL resources */
 void FreeCRL(WOLFSSL_CRL* crl, int dynamic)
 {
-    CRL_Entry* tmp = crl->crlList;
+    CRL_Entry* tmp;
+    int        row;
 
     WOLFSSL_ENTER("FreeCRL");
     if (crl->monitors[0].path)
@@ -162,11 +279,15 @@ void FreeCRL(WOLFSSL_CRL* crl, int dynamic)
     if (crl->monitors[1].path)
         XFREE(crl->monitors[1].path, crl->heap, DYNAMIC_TYPE_CRL_MONITOR);
 
-    while(tmp) {
-        CRL_Entry* next = tmp->next;
-        FreeCRL_Entry(tmp, crl->heap);
-        XFREE(tmp, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
-        tmp = next;
+    for (row = 0; row < CRL_TABLE_SIZE; row++) {
+        tmp = crl->crlTable[row];
+        while(tmp) {
+            CRL_Entry* next = tmp->next;
+            FreeCRL_Entry(tmp, crl->heap);
+            XFREE(tmp, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
+            tmp = next;
+        }
+        crl->crlTable[row] = NULL;
     }
 
 #ifdef HAVE_CRL_MONITOR
@@ -179,156 +300,157 @@ void FreeCRL(WOLFSSL_CRL* crl, int dynamic)
         }
     }
     pthread_cond_destroy(&crl->cond);
+    wc_FreeMutex(&crl->setupLock);
 #endif
-    wc_FreeMutex(&crl->crlLock);
+    wc_FreeRwLock(&crl->crlLock);
     if (dynamic)   /* free self */
         XFREE(crl, crl->heap, DYNAMIC_TYPE_CRL);
 }
 
 
+/* find the newest CRL for issuer hash, call with crlLock held */
+static CRL_Entry* FindCRL_Entry(WOLFSSL_CRL* crl, const byte* issuerHash)
+{
+    CRL_Entry* crle = crl->crlTable[HashCRL(issuerHash)];
+
+    while (crle) {
+        if (XMEMCMP(crle->issuerHash, issuerHash, CRL_DIGEST_SIZE) == 0)
+            break;
+        crle = crle->next;
+    }
+
+    return crle;
+}
+
+
 static int CheckCertCRLList(WOLFSSL_CRL* crl, DecodedCert* cert, int *pFoundEntry)
 {
     CRL_Entry* crle;
     int        foundEntry = 0;
     int        ret = 0;
 
-    if (wc_LockMutex(&crl->crlLock) != 0) {
-        WOLFSSL_MSG("wc_LockMutex failed");
+    /* lookups only need a shared lock, the one time signature check of a
+     * newly loaded CRL takes the write lock to save the result */
+    if (wc_LockRwLock_Rd(&crl->crlLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Rd failed");
         return BAD_MUTEX_E;
     }
 
-    crle = crl->crlList;
+    crle = FindCRL_Entry(crl, cert->issuerHash);
+    if (crle) {
+        WOLFSSL_MSG("Found CRL Entry on list");
 
-    while (crle) {
-        if (XMEMCMP(crle->issuerHash, cert->issuerHash, CRL_DIGEST_SIZE) == 0) {
-            WOLFSSL_MSG("Found CRL Entry on list");
-
-            if (crle->verified == 0) {
-                Signer* ca = NULL;
-            #ifndef NO_SKID
-                byte extAuthKeyId[KEYID_SIZE];
-            #endif
-                byte issuerHash[CRL_DIGEST_SIZE];
-                byte* tbs;
-                word32 tbsSz = crle->tbsSz;
-                byte* sig = NULL;
-                word32 sigSz = crle->signatureSz;
-                word32 sigOID = crle->signatureOID;
-                SignatureCtx sigCtx;
-
-                tbs = (byte*)XMALLOC(tbsSz, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
-                if (tbs == NULL) {
-                    wc_UnLockMutex(&crl->crlLock);
-                    return MEMORY_E;
-                }
-                sig = (byte*)XMALLOC(sigSz, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
-                if (sig == NULL) {
-                    XFREE(tbs, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
-                    wc_UnLockMutex(&crl->crlLock);
-                    return MEMORY_E;
-                }
-
-                XMEMCPY(tbs, crle->toBeSigned, tbsSz);
-                XMEMCPY(sig, crle->signature, sigSz);
-            #ifndef NO_SKID
-                XMEMCPY(extAuthKeyId, crle->extAuthKeyId,
-                                                          sizeof(extAuthKeyId));
-            #endif
-                XMEMCPY(issuerHash, crle->issuerHash, sizeof(issuerHash));
-
-                wc_UnLockMutex(&crl->crlLock);
-
-            #ifndef NO_SKID
-                if (crle->extAuthKeyIdSet)
-                    ca = GetCA(crl->cm, extAuthKeyId);
-                if (ca == NULL)
-                    ca = GetCAByName(crl->cm, issuerHash);
-            #else /* NO_SKID */
-                ca = GetCA(crl->cm, issuerHash);
-            #endif /* NO_SKID */
-                if (ca == NULL) {
-                    XFREE(sig, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
-                    XFREE(tbs, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
-                    WOLFSSL_MSG("Did NOT find CRL issuer CA");
-                    return ASN_CRL_NO_SIGNER_E;
-                }
-
-                ret = VerifyCRL_Signature(&sigCtx, tbs, tbsSz, sig, sigSz,
-                                          sigOID, ca, crl->heap);
+        if (crle->verified == 0) {
+            Signer* ca = NULL;
+        #ifndef NO_SKID
+            byte extAuthKeyId[KEYID_SIZE];
+            byte extAuthKeyIdSet = crle->extAuthKeyIdSet;
+        #endif
+            byte issuerHash[CRL_DIGEST_SIZE];
+            byte* tbs;
+            word32 tbsSz = crle->tbsSz;
+            byte* sig = NULL;
+            word32 sigSz = crle->signatureSz;
+            word32 sigOID = crle->signatureOID;
+            SignatureCtx sigCtx;
+
+            tbs = (byte*)XMALLOC(tbsSz, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
+            if (tbs == NULL) {
+                wc_UnLockRwLock(&crl->crlLock);
+                return MEMORY_E;
+            }
+            sig = (byte*)XMALLOC(sigSz, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
+            if (sig == NULL) {
+                XFREE(tbs, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
+                wc_UnLockRwLock(&crl->crlLock);
+                return MEMORY_E;
+            }
 
+            XMEMCPY(tbs, crle->toBeSigned, tbsSz);
+            XMEMCPY(sig, crle->signature, sigSz);
+        #ifndef NO_SKID
+            XMEMCPY(extAuthKeyId, crle->extAuthKeyId, sizeof(extAuthKeyId));
+        #endif
+            XMEMCPY(issuerHash, crle->issuerHash, sizeof(issuerHash));
+
+            wc_UnLockRwLock(&crl->crlLock);
+
+        #ifndef NO_SKID
+            if (extAuthKeyIdSet)
+                ca = GetCA(crl->cm, extAuthKeyId);
+            if (ca == NULL)
+                ca = GetCAByName(crl->cm, issuerHash);
+        #else /* NO_SKID */
+            ca = GetCA(crl->cm, issuerHash);
+        #endif /* NO_SKID */
+            if (ca == NULL) {
                 XFREE(sig, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
                 XFREE(tbs, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
+                WOLFSSL_MSG("Did NOT find CRL issuer CA");
+                return ASN_CRL_NO_SIGNER_E;
+            }
 
-                if (wc_LockMutex(&crl->crlLock) != 0) {
-                    WOLFSSL_MSG("wc_LockMutex failed");
-                    return BAD_MUTEX_E;
-                }
+            ret = VerifyCRL_Signature(&sigCtx, tbs, tbsSz, sig, sigSz,
+                                      sigOID, ca, crl->heap);
 
-                crle = crl->crlList;
-                while (crle) {
-                    if (XMEMCMP(crle->issuerHash, cert->issuerHash,
-                        CRL_DIGEST_SIZE) == 0) {
-
-                        if (ret == 0)
-                            crle->verified = 1;
-                        else
-                            crle->verified = ret;
-
-                        XFREE(crle->toBeSigned, crl->heap,
-                                                        DYNAMIC_TYPE_CRL_ENTRY);
-                        crle->toBeSigned = NULL;
-                        XFREE(crle->signature, crl->heap,
-                                                        DYNAMIC_TYPE_CRL_ENTRY);
-                        crle->signature = NULL;
-                        break;
-                    }
-                    crle = crle->next;
-                }
-                if (crle == NULL || crle->verified < 0)
-                    break;
+            XFREE(sig, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
+            XFREE(tbs, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
+
+            if (wc_LockRwLock_Wr(&crl->crlLock) != 0) {
+                WOLFSSL_MSG("wc_LockRwLock_Wr failed");
+                return BAD_MUTEX_E;
             }
-            else if (crle->verified < 0) {
-                WOLFSSL_MSG("Cannot use CRL as it didn't verify");
-                ret = crle->verified;
-                break;
+
+            /* table may have been swapped while unlocked */
+            crle = FindCRL_Entry(crl, cert->issuerHash);
+            if (crle && crle->verified == 0) {
+                if (ret == 0)
+                    crle->verified = 1;
+                else
+                    crle->verified = ret;
+
+                XFREE(crle->toBeSigned, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
+                crle->toBeSigned = NULL;
+                XFREE(crle->signature, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
+                crle->signature = NULL;
             }
+            if (crle && crle->verified < 0)
+                crle = NULL;
+        }
+        else if (crle->verified < 0) {
+            WOLFSSL_MSG("Cannot use CRL as it didn't verify");
+            ret = crle->verified;
+            crle = NULL;
+        }
+    }
 
-            WOLFSSL_MSG("Checking next date validity");
+    if (crle) {
+        WOLFSSL_MSG("Checking next date validity");
 
-        #ifdef WOLFSSL_NO_CRL_NEXT_DATE
-            if (crle->nextDateFormat != ASN_OTHER_TYPE)
-        #endif
-            {
-            #ifndef NO_ASN_TIME
-                if (!XVALIDATE_DATE(crle->nextDate,crle->nextDateFormat, AFTER)) {
-                    WOLFSSL_MSG("CRL next date is no longer valid");
-                    ret = ASN_AFTER_DATE_E;
-                }
-            #endif
-            }
-            if (ret == 0) {
-                foundEntry = 1;
+    #ifdef WOLFSSL_NO_CRL_NEXT_DATE
+        if (crle->nextDateFormat != ASN_OTHER_TYPE)
+    #endif
+        {
+        #ifndef NO_ASN_TIME
+            if (!XVALIDATE_DATE(crle->nextDate,crle->nextDateFormat, AFTER)) {
+                WOLFSSL_MSG("CRL next date is no longer valid");
+                ret = ASN_AFTER_DATE_E;
             }
-            break;
+        #endif
+        }
+        if (ret == 0) {
+            foundEntry = 1;
         }
-        crle = crle->next;
     }
 
     if (foundEntry) {
-        RevokedCert* rc = crle->certs;
-
-        while (rc) {
-            if (rc->serialSz == cert->serialSz &&
-                   XMEMCMP(rc->serialNumber, cert->serial, rc->serialSz) == 0) {
-                WOLFSSL_MSG("Cert revoked");
-                ret = CRL_CERT_REVOKED;
-                break;
-            }
-            rc = rc->next;
+        if (FindRevokedCert(crle, cert->serial, cert->serialSz)) {
+            WOLFSSL_MSG("Cert revoked");
+            ret = CRL_CERT_REVOKED;
         }
     }
 
-    wc_UnLockMutex(&crl->crlLock);
+    wc_UnLockRwLock(&crl->crlLock);
 
     *pFoundEntry = foundEntry;
 
@@ -394,6 +516,7 @@ static int AddCRL(WOLFSSL_CRL* crl, DecodedCRL* dcrl, const byte* buff,
                   int verified)
 {
     CRL_Entry* crle;
+    word32     row;
 
     WOLFSSL_ENTER("AddCRL");
 
@@ -409,15 +532,16 @@ static int AddCRL(WOLFSSL_CRL* crl, DecodedCRL* dcrl, const byte* buff,
         return -1;
     }
 
-    if (wc_LockMutex(&crl->crlLock) != 0) {
-        WOLFSSL_MSG("wc_LockMutex failed");
+    row = HashCRL(crle->issuerHash);
+    if (wc_LockRwLock_Wr(&crl->crlLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Wr failed");
         FreeCRL_Entry(crle, crl->heap);
         XFREE(crle, crl->heap, DYNAMIC_TYPE_CRL_ENTRY);
         return BAD_MUTEX_E;
     }
-    crle->next = crl->crlList;
-    crl->crlList = crle;
-    wc_UnLockMutex(&crl->crlLock);
+    crle->next = crl->crlTable[row];
+    crl->crlTable[row] = crle;
+    wc_UnLockRwLock(&crl->crlLock);
 
     return 0;
 }
@@ -494,23 +618,28 @@ int wolfSSL_X509_STORE_add_crl(WOLFSSL_X509_STORE *store, WOLFSSL_X509_CRL *newc
 {
     CRL_Entry   *crle;
     WOLFSSL_CRL *crl;
+    int          row;
 
     WOLFSSL_ENTER("wolfSSL_X509_STORE_add_crl");
     if (store == NULL || newcrl == NULL)
         return BAD_FUNC_ARG;
 
     crl = store->crl;
-    crle = newcrl->crlList;
 
-    if (wc_LockMutex(&crl->crlLock) != 0)
+    if (wc_LockRwLock_Wr(&crl->crlLock) != 0)
     {
-        WOLFSSL_MSG("wc_LockMutex failed");
+        WOLFSSL_MSG("wc_LockRwLock_Wr failed");
         return BAD_MUTEX_E;
     }
-    crle->next = crl->crlList;
-    crl->crlList = crle;
-    newcrl->crlList = NULL;
-    wc_UnLockMutex(&crl->crlLock);
+    /* both tables hash the same way, move entries row by row */
+    for (row = 0; row < CRL_TABLE_SIZE; row++) {
+        while ((crle = newcrl->crlTable[row]) != NULL) {
+            newcrl->crlTable[row] = crle->next;
+            crle->next = crl->crlTable[row];
+            crl->crlTable[row] = crle;
+        }
+    }
+    wc_UnLockRwLock(&crl->crlLock);
 
     WOLFSSL_LEAVE("wolfSSL_X509_STORE_add_crl", WOLFSSL_SUCCESS);
 
@@ -527,15 +656,15 @@ static int SignalSetup(WOLFSSL_CRL* crl, int status)
     int ret;
 
     /* signal to calling thread we're setup */
-    if (wc_LockMutex(&crl->crlLock) != 0) {
-        WOLFSSL_MSG("wc_LockMutex crlLock failed");
+    if (wc_LockMutex(&crl->setupLock) != 0) {
+        WOLFSSL_MSG("wc_LockMutex setupLock failed");
         return BAD_MUTEX_E;
     }
 
         crl->setup = status;
         ret = pthread_cond_signal(&crl->cond);
 
-    wc_UnLockMutex(&crl->crlLock);
+    wc_UnLockMutex(&crl->setupLock);
 
     if (ret != 0)
         return BAD_COND_E;
@@ -548,6 +677,7 @@ static int SignalSetup(WOLFSSL_CRL* crl, int status)
 static int SwapLists(WOLFSSL_CRL* crl)
 {
     int        ret;
+    int        row;
     CRL_Entry* newList;
 #ifdef WOLFSSL_SMALL_STACK
     WOLFSSL_CRL* tmp;
@@ -593,8 +723,10 @@ static int SwapLists(WOLFSSL_CRL* crl)
         }
     }
 
-    if (wc_LockMutex(&crl->crlLock) != 0) {
-        WOLFSSL_MSG("wc_LockMutex failed");
+    /* new table is fully loaded and verified above, readers see either the
+     * old or the new one */
+    if (wc_LockRwLock_Wr(&crl->crlLock) != 0) {
+        WOLFSSL_MSG("wc_LockRwLock_Wr failed");
         FreeCRL(tmp, 0);
 #ifdef WOLFSSL_SMALL_STACK
         XFREE(tmp, NULL, DYNAMIC_TYPE_TMP_BUFFER);
@@ -602,13 +734,14 @@ static int SwapLists(WOLFSSL_CRL* crl)
         return -1;
     }
 
-    newList = tmp->crlList;
-
-    /* swap lists */
-    tmp->crlList  = crl->crlList;
-    crl->crlList = newList;
+    /* swap tables */
+    for (row = 0; row < CRL_TABLE_SIZE; row++) {
+        newList = tmp->crlTable[row];
+        tmp->crlTable[row] = crl->crlTable[row];
+        crl->crlTable[row] = newList;
+    }
 
-    wc_UnLockMutex(&crl->crlLock);
+    wc_UnLockRwLock(&crl->crlLock);
 
     FreeCRL(tmp, 0);
 
@@ -932,13 +1065,13 @@ static int StartMonitorCRL(WOLFSSL_CRL* crl)
     }
 
     /* wait for setup to complete */
-    if (wc_LockMutex(&crl->crlLock) != 0) {
-        WOLFSSL_MSG("wc_LockMutex crlLock error");
+    if (wc_LockMutex(&crl->setupLock) != 0) {
+        WOLFSSL_MSG("wc_LockMutex setupLock error");
         return BAD_MUTEX_E;
     }
 
         while (crl->setup == 0) {
-            if (pthread_cond_wait(&crl->cond, &crl->crlLock) != 0) {
+            if (pthread_cond_wait(&crl->cond, &crl->setupLock) != 0) {
                 ret = BAD_COND_E;
                 break;
             }
@@ -947,7 +1080,7 @@ static int StartMonitorCRL(WOLFSSL_CRL* crl)
         if (crl->setup < 0)
             ret = crl->setup;  /* store setup error */
 
-    wc_UnLockMutex(&crl->crlLock);
+    wc_UnLockMutex(&crl->setupLock);
 
     if (ret < 0) {
         WOLFSSL_MSG("DoMonitor setup failure");
@@ -1695,6 +1695,9 @@ int InitSSL_Ctx(WOLFSSL_CTX* ctx, WOLFSSL_METHOD* method, void* heap)
     #else
         ctx->CBIORecv = EmbedReceive;
         ctx->CBIOSend = EmbedSend;
+        #ifdef HAVE_SENDMSG
+            ctx->CBIOSendv = EmbedSendv;
+        #endif
         #ifdef WOLFSSL_DTLS
             if (method->version.major == DTLS_MAJOR) {
                 ctx->CBIORecv   = EmbedReceiveFrom;
@@ -1775,6 +1778,13 @@ int InitSSL_Ctx(WOLFSSL_CTX* ctx, WOLFSSL_METHOD* method, void* heap)
 
 #if defined(HAVE_SESSION_TICKET) && !defined(NO_WOLFSSL_SERVER)
     ctx->ticketHint = SESSION_TICKET_HINT_DEFAULT;
+    #ifndef WOLFSSL_NO_DEF_TICKET_ENC_CB
+    if (wc_InitMutex(&ctx->ticketKeyCtx.mutex) < 0) {
+        WOLFSSL_MSG("Mutex error on ticket key init");
+        return BAD_MUTEX_E;
+    }
+    ctx->ticketKeyCtx.lifetime = WOLFSSL_TICKET_KEY_LIFETIME;
+    #endif
 #endif
 
 #ifdef HAVE_WOLF_EVENT
@@ -1804,6 +1814,10 @@ void SSL_CtxResourceFree(WOLFSSL_CTX* ctx)
     wolfEventQueue_Free(&ctx->event_queue);
 #endif /* HAVE_WOLF_EVENT */
 
+#ifdef WOLFSSL_KEY_SHARE_POOL
+    KeySharePool_Free(ctx);
+#endif
+
 #ifdef WOLFSSL_STATIC_MEMORY
     if (ctx->onHeap == 1) {
         XFREE(ctx->method, ctx->heap, DYNAMIC_TYPE_METHOD);
@@ -1820,6 +1834,11 @@ void SSL_CtxResourceFree(WOLFSSL_CTX* ctx)
         ctx->suites = NULL;
     }
 
+#ifndef NO_SESSION_CACHE
+    wolfSSL_SessionCacheFree(ctx->sessionCache);
+    ctx->sessionCache = NULL;
+#endif
+
 #ifndef NO_DH
     XFREE(ctx->serverDH_G.buffer, ctx->heap, DYNAMIC_TYPE_PUBLIC_KEY);
     ctx->serverDH_G.buffer = NULL;
@@ -1827,6 +1846,13 @@ void SSL_CtxResourceFree(WOLFSSL_CTX* ctx)
     ctx->serverDH_P.buffer = NULL;
 #endif /* !NO_DH */
 
+#if defined(HAVE_SESSION_TICKET) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB)
+    ForceZero(ctx->ticketKeyCtx.keys, sizeof(ctx->ticketKeyCtx.keys));
+    ForceZero(ctx->ticketKeyCtx.secret, sizeof(ctx->ticketKeyCtx.secret));
+    wc_FreeMutex(&ctx->ticketKeyCtx.mutex);
+#endif
+
 #ifdef SINGLE_THREADED
     if (ctx->rng) {
         wc_FreeRng(ctx->rng);
@@ -4269,6 +4295,9 @@ int EccMakeKey(WOLFSSL* ssl, ecc_key* key, ecc_key* peer)
     int ret = 0;
     int keySz = 0;
     int ecc_curve = ECC_CURVE_DEF;
+#if defined(WOLFSSL_KEY_SHARE_POOL) && defined(HAVE_ECC_KEY_IMPORT)
+    KeySharePoolEntry* poolKey = NULL;
+#endif
 
     WOLFSSL_ENTER("EccMakeKey");
 
@@ -4298,6 +4327,15 @@ int EccMakeKey(WOLFSSL* ssl, ecc_key* key, ecc_key* peer)
         ret = ssl->ctx->EccKeyGenCb(ssl, key, keySz, ecc_curve, ctx);
     }
     else
+#endif
+#if defined(WOLFSSL_KEY_SHARE_POOL) && defined(HAVE_ECC_KEY_IMPORT)
+    if (ecc_curve != ECC_CURVE_DEF && (poolKey = KeySharePool_Take(ssl->ctx,
+                           GetCurveByOID((int)ssl->ecdhCurveOID))) != NULL) {
+        ret = wc_ecc_import_private_key_ex(poolKey->priv, poolKey->privSz,
+                              poolKey->pub, poolKey->pubSz, key, ecc_curve);
+        KeySharePool_FreeEntry(poolKey, ssl->ctx->heap);
+    }
+    else
 #endif
     {
         ret = wc_ecc_make_key_ex(ssl->rng, keySz, key, ecc_curve);
@@ -4586,6 +4624,9 @@ static int X25519MakeKey(WOLFSSL* ssl, curve25519_key* key,
         curve25519_key* peer)
 {
     int ret = 0;
+#if defined(WOLFSSL_KEY_SHARE_POOL) && defined(HAVE_CURVE25519_KEY_IMPORT)
+    KeySharePoolEntry* poolKey = NULL;
+#endif
 
     (void)peer;
 
@@ -4604,6 +4645,15 @@ static int X25519MakeKey(WOLFSSL* ssl, curve25519_key* key,
         ret = ssl->ctx->X25519KeyGenCb(ssl, key, CURVE25519_KEYSIZE, ctx);
     }
     else
+#endif
+#if defined(WOLFSSL_KEY_SHARE_POOL) && defined(HAVE_CURVE25519_KEY_IMPORT)
+    if ((poolKey = KeySharePool_Take(ssl->ctx, WOLFSSL_ECC_X25519)) != NULL) {
+        ret = wc_curve25519_import_private_raw_ex(poolKey->priv,
+                                poolKey->privSz, poolKey->pub, poolKey->pubSz,
+                                key, EC25519_LITTLE_ENDIAN);
+        KeySharePool_FreeEntry(poolKey, ssl->ctx->heap);
+    }
+    else
 #endif
     {
         ret = wc_curve25519_make_key(ssl->rng, CURVE25519_KEYSIZE, key);
@@ -5324,6 +5374,7 @@ int SetSSL_CTX(WOLFSSL* ssl, WOLFSSL_CTX* ctx, int writeDup)
     ssl->options.partialWrite  = ctx->partialWrite;
     ssl->options.quietShutdown = ctx->quietShutdown;
     ssl->options.groupMessages = ctx->groupMessages;
+    ssl->options.coalesceRecords = ctx->coalesceRecords;
 
 #ifndef NO_DH
     #if !defined(WOLFSSL_OLD_PRIME_CHECK) && !defined(HAVE_FIPS) && \
@@ -5394,6 +5445,7 @@ int SetSSL_CTX(WOLFSSL* ssl, WOLFSSL_CTX* ctx, int writeDup)
 
     ssl->CBIORecv = ctx->CBIORecv;
     ssl->CBIOSend = ctx->CBIOSend;
+    ssl->CBIOSendv = ctx->CBIOSendv;
 #ifdef OPENSSL_EXTRA
     ssl->readAhead = ctx->readAhead;
 #endif
@@ -5402,10 +5454,30 @@ int SetSSL_CTX(WOLFSSL* ssl, WOLFSSL_CTX* ctx, int writeDup)
     return ret;
 }
 
+/* Handshake hashes that can be run in this build */
+static const byte hsHashAvail = 0
+#if !defined(NO_MD5) && !defined(NO_OLD_TLS)
+    | HS_HASH_MD5
+#endif
+#if !defined(NO_SHA) && (!defined(NO_OLD_TLS) || \
+                              defined(WOLFSSL_ALLOW_TLS_SHA1))
+    | HS_HASH_SHA
+#endif
+#ifndef NO_SHA256
+    | HS_HASH_SHA256
+#endif
+#ifdef WOLFSSL_SHA384
+    | HS_HASH_SHA384
+#endif
+#ifdef WOLFSSL_SHA512
+    | HS_HASH_SHA512
+#endif
+    ;
+
+/* Messages are buffered rather than hashed until the cipher suite is known.
+ * Only the hashes that are read are then run over the messages. */
 int InitHandshakeHashes(WOLFSSL* ssl)
 {
-    int ret;
-
     /* make sure existing handshake hashes are free'd */
     if (ssl->hsHashes != NULL) {
         FreeHandshakeHashes(ssl);
@@ -5419,73 +5491,49 @@ int InitHandshakeHashes(WOLFSSL* ssl)
         return MEMORY_E;
     }
     XMEMSET(ssl->hsHashes, 0, sizeof(HS_Hashes));
+    ssl->hsHashes->buffering = 1;
 
-#ifndef NO_OLD_TLS
-#ifndef NO_MD5
-    ret = wc_InitMd5_ex(&ssl->hsHashes->hashMd5, ssl->heap, ssl->devId);
-    if (ret != 0)
-        return ret;
-    #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
-        wc_Md5SetFlags(&ssl->hsHashes->hashMd5, WC_HASH_FLAG_WILLCOPY);
-    #endif
+    return 0;
+}
+
+/* Free the running hashes in mask. */
+static void FreeHandshakeHashCtx(WOLFSSL* ssl, byte mask)
+{
+    HS_Hashes* hs = ssl->hsHashes;
+
+    mask &= hs->hashMask;
+#if !defined(NO_MD5) && !defined(NO_OLD_TLS)
+    if (mask & HS_HASH_MD5)
+        wc_Md5Free(&hs->hashMd5);
 #endif
-#ifndef NO_SHA
-    ret = wc_InitSha_ex(&ssl->hsHashes->hashSha, ssl->heap, ssl->devId);
-    if (ret != 0)
-        return ret;
-    #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
-        wc_ShaSetFlags(&ssl->hsHashes->hashSha, WC_HASH_FLAG_WILLCOPY);
-    #endif
+#if !defined(NO_SHA) && (!defined(NO_OLD_TLS) || \
+                              defined(WOLFSSL_ALLOW_TLS_SHA1))
+    if (mask & HS_HASH_SHA)
+        wc_ShaFree(&hs->hashSha);
 #endif
-#endif /* !NO_OLD_TLS */
 #ifndef NO_SHA256
-    ret = wc_InitSha256_ex(&ssl->hsHashes->hashSha256, ssl->heap, ssl->devId);
-    if (ret != 0)
-        return ret;
-    #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
-        wc_Sha256SetFlags(&ssl->hsHashes->hashSha256, WC_HASH_FLAG_WILLCOPY);
-    #endif
+    if (mask & HS_HASH_SHA256)
+        wc_Sha256Free(&hs->hashSha256);
 #endif
 #ifdef WOLFSSL_SHA384
-    ret = wc_InitSha384_ex(&ssl->hsHashes->hashSha384, ssl->heap, ssl->devId);
-    if (ret != 0)
-        return ret;
-    #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
-        wc_Sha384SetFlags(&ssl->hsHashes->hashSha384, WC_HASH_FLAG_WILLCOPY);
-    #endif
+    if (mask & HS_HASH_SHA384)
+        wc_Sha384Free(&hs->hashSha384);
 #endif
 #ifdef WOLFSSL_SHA512
-    ret = wc_InitSha512_ex(&ssl->hsHashes->hashSha512, ssl->heap, ssl->devId);
-    if (ret != 0)
-        return ret;
-    #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
-        wc_Sha512SetFlags(&ssl->hsHashes->hashSha512, WC_HASH_FLAG_WILLCOPY);
-    #endif
+    if (mask & HS_HASH_SHA512)
+        wc_Sha512Free(&hs->hashSha512);
 #endif
-
-    return ret;
+    hs->hashMask &= ~mask;
 }
 
 void FreeHandshakeHashes(WOLFSSL* ssl)
 {
     if (ssl->hsHashes) {
-#ifndef NO_OLD_TLS
-    #ifndef NO_MD5
-        wc_Md5Free(&ssl->hsHashes->hashMd5);
-    #endif
-    #ifndef NO_SHA
-        wc_ShaFree(&ssl->hsHashes->hashSha);
-    #endif
-#endif /* !NO_OLD_TLS */
-    #ifndef NO_SHA256
-        wc_Sha256Free(&ssl->hsHashes->hashSha256);
-    #endif
-    #ifdef WOLFSSL_SHA384
-        wc_Sha384Free(&ssl->hsHashes->hashSha384);
-    #endif
-    #ifdef WOLFSSL_SHA512
-        wc_Sha512Free(&ssl->hsHashes->hashSha512);
-    #endif
+        FreeHandshakeHashCtx(ssl, HS_HASH_ALL);
+        if (ssl->hsHashes->rawMsgs != NULL) {
+            XFREE(ssl->hsHashes->rawMsgs, ssl->heap, DYNAMIC_TYPE_HASHES);
+            ssl->hsHashes->rawMsgs = NULL;
+        }
     #if (defined(HAVE_ED25519) || defined(HAVE_ED448)) && \
                                                 !defined(WOLFSSL_NO_CLIENT_AUTH)
         if (ssl->hsHashes->messages != NULL) {
@@ -5499,6 +5547,174 @@ void FreeHandshakeHashes(WOLFSSL* ssl)
     }
 }
 
+/* Start the handshake hashes in mask that are not running yet.
+ * Each new hash is fed the messages buffered so far.
+ *
+ * ssl   SSL/TLS object.
+ * mask  HS_HASH_* bits of the hashes needed.
+ * returns BAD_STATE_E when a hash is needed after the messages were dropped,
+ * otherwise 0 on success.
+ */
+int SetHandshakeHashes(WOLFSSL* ssl, byte mask)
+{
+    int        ret = 0;
+    HS_Hashes* hs;
+    byte*      msgs;
+    word32     len;
+
+    if (ssl == NULL || ssl->hsHashes == NULL)
+        return BAD_FUNC_ARG;
+
+    hs = ssl->hsHashes;
+    mask &= hsHashAvail & ~hs->hashMask;
+    if (mask == 0)
+        return 0;
+    if (!hs->buffering) {
+        WOLFSSL_MSG("Handshake hash not kept after cipher suite negotiated");
+        return BAD_STATE_E;
+    }
+    msgs = hs->rawMsgs;
+    len = hs->rawLen;
+
+#if !defined(NO_MD5) && !defined(NO_OLD_TLS)
+    if (ret == 0 && (mask & HS_HASH_MD5)) {
+        ret = wc_InitMd5_ex(&hs->hashMd5, ssl->heap, ssl->devId);
+        if (ret == 0) {
+            hs->hashMask |= HS_HASH_MD5;
+        #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
+            wc_Md5SetFlags(&hs->hashMd5, WC_HASH_FLAG_WILLCOPY);
+        #endif
+            if (len > 0)
+                ret = wc_Md5Update(&hs->hashMd5, msgs, len);
+        }
+    }
+#endif
+#if !defined(NO_SHA) && (!defined(NO_OLD_TLS) || \
+                              defined(WOLFSSL_ALLOW_TLS_SHA1))
+    if (ret == 0 && (mask & HS_HASH_SHA)) {
+        ret = wc_InitSha_ex(&hs->hashSha, ssl->heap, ssl->devId);
+        if (ret == 0) {
+            hs->hashMask |= HS_HASH_SHA;
+        #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
+            wc_ShaSetFlags(&hs->hashSha, WC_HASH_FLAG_WILLCOPY);
+        #endif
+            if (len > 0)
+                ret = wc_ShaUpdate(&hs->hashSha, msgs, len);
+        }
+    }
+#endif
+#ifndef NO_SHA256
+    if (ret == 0 && (mask & HS_HASH_SHA256)) {
+        ret = wc_InitSha256_ex(&hs->hashSha256, ssl->heap, ssl->devId);
+        if (ret == 0) {
+            hs->hashMask |= HS_HASH_SHA256;
+        #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
+            wc_Sha256SetFlags(&hs->hashSha256, WC_HASH_FLAG_WILLCOPY);
+        #endif
+            if (len > 0)
+                ret = wc_Sha256Update(&hs->hashSha256, msgs, len);
+        }
+    }
+#endif
+#ifdef WOLFSSL_SHA384
+    if (ret == 0 && (mask & HS_HASH_SHA384)) {
+        ret = wc_InitSha384_ex(&hs->hashSha384, ssl->heap, ssl->devId);
+        if (ret == 0) {
+            hs->hashMask |= HS_HASH_SHA384;
+        #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
+            wc_Sha384SetFlags(&hs->hashSha384, WC_HASH_FLAG_WILLCOPY);
+        #endif
+            if (len > 0)
+                ret = wc_Sha384Update(&hs->hashSha384, msgs, len);
+        }
+    }
+#endif
+#ifdef WOLFSSL_SHA512
+    if (ret == 0 && (mask & HS_HASH_SHA512)) {
+        ret = wc_InitSha512_ex(&hs->hashSha512, ssl->heap, ssl->devId);
+        if (ret == 0) {
+            hs->hashMask |= HS_HASH_SHA512;
+        #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
+            wc_Sha512SetFlags(&hs->hashSha512, WC_HASH_FLAG_WILLCOPY);
+        #endif
+            if (len > 0)
+                ret = wc_Sha512Update(&hs->hashSha512, msgs, len);
+        }
+    }
+#endif
+
+    return ret;
+}
+
+/* Whether a TLS v1.2 CertificateVerify may be sent or received.
+ * The hash it is signed with is only known once the signature algorithm has
+ * been picked from the CertificateRequest.
+ */
+static int HandshakeMayVerifyCert(WOLFSSL* ssl)
+{
+    if (ssl->options.resuming)
+        return 0;
+#if !defined(NO_CERTS) && !defined(WOLFSSL_NO_CLIENT_AUTH)
+    if (ssl->options.side == WOLFSSL_SERVER_END)
+        return ssl->options.verifyPeer;
+    if (ssl->buffers.certificate != NULL &&
+                                        ssl->buffers.certificate->buffer != NULL)
+        return 1;
+    #ifdef OPENSSL_EXTRA
+    if (ssl->ctx->CBClientCert != NULL)
+        return 1;
+    #endif
+#endif
+    return 0;
+}
+
+/* Keep only the handshake hashes needed by the negotiated protocol version
+ * and cipher suite and stop buffering messages.
+ * Called once the ServerHello is sent or received.
+ *
+ * ssl  SSL/TLS object.
+ * returns 0 on success, otherwise failure.
+ */
+int FinalizeHandshakeHashes(WOLFSSL* ssl)
+{
+    int        ret;
+    HS_Hashes* hs;
+    byte       mask;
+
+    if (ssl == NULL || ssl->hsHashes == NULL)
+        return BAD_FUNC_ARG;
+
+    hs = ssl->hsHashes;
+    if (!hs->buffering)
+        return 0;
+
+    if (!IsAtLeastTLSv1_2(ssl))
+        mask = HS_HASH_MD5 | HS_HASH_SHA;
+    else if (!IsAtLeastTLSv1_3(ssl->version) && HandshakeMayVerifyCert(ssl))
+        mask = HS_HASH_ALL;
+    else if (ssl->specs.mac_algorithm == sha384_mac)
+        mask = HS_HASH_SHA384;
+    else if (ssl->specs.mac_algorithm == sha512_mac)
+        mask = HS_HASH_SHA512;
+    else
+        mask = HS_HASH_SHA256;
+
+    ret = SetHandshakeHashes(ssl, mask);
+    if (ret != 0)
+        return ret;
+
+    FreeHandshakeHashCtx(ssl, (byte)~mask);
+    if (hs->rawMsgs != NULL) {
+        XFREE(hs->rawMsgs, ssl->heap, DYNAMIC_TYPE_HASHES);
+        hs->rawMsgs = NULL;
+    }
+    hs->rawLen = 0;
+    hs->rawSz = 0;
+    hs->buffering = 0;
+
+    return 0;
+}
+
 
 /* init everything to 0, NULL, default values before calling anything that may
    fail so that destructor has a "good" state to cleanup
@@ -5820,7 +6036,13 @@ int InitSSL(WOLFSSL* ssl, WOLFSSL_CTX* ctx, int writeDup)
         ssl->options.weOwnRng = 1;
 
         /* FIPS RNG API does not accept a heap hint */
-#ifndef HAVE_FIPS
+#ifdef WC_RNG_POOL
+        /* seeded from this thread's parent DRBG */
+        if ( (ret = wc_InitRngPool(ssl->rng, ssl->heap, ssl->devId)) != 0) {
+            WOLFSSL_MSG("RNG Init error");
+            return ret;
+        }
+#elif !defined(HAVE_FIPS)
         if ( (ret = wc_InitRng_ex(ssl->rng, ssl->heap, ssl->devId)) != 0) {
             WOLFSSL_MSG("RNG Init error");
             return ret;
@@ -6277,6 +6499,11 @@ void SSL_ResourceFree(WOLFSSL* ssl)
     }
     XFREE(ssl->buffers.dtlsCtx.peer.sa, ssl->heap, DYNAMIC_TYPE_SOCKADDR);
     ssl->buffers.dtlsCtx.peer.sa = NULL;
+#ifdef WOLFSSL_DTLS_CID
+    XFREE(ssl->buffers.dtlsCtx.pendingPeer.sa, ssl->heap,
+          DYNAMIC_TYPE_SOCKADDR);
+    ssl->buffers.dtlsCtx.pendingPeer.sa = NULL;
+#endif
 #ifndef NO_WOLFSSL_SERVER
     XFREE(ssl->buffers.dtlsCookieSecret.buffer, ssl->heap,
           DYNAMIC_TYPE_COOKIE_PWD);
@@ -6815,6 +7042,97 @@ static WC_INLINE void WriteSEQ(WOLFSSL* ssl, int verifyOrder, byte* out)
 #endif /* !NO_OLD_TLS || WOLFSSL_DTLS ||
         *     ((HAVE_CHACHA || HAVE_AESCCM || HAVE_AESGCM) && HAVE_AEAD) */
 
+#ifdef WOLFSSL_DTLS_CID
+/* Connection IDs are only used on records protected with an AEAD cipher
+ * suite that follows the current RFCs.
+ * returns 1 when the negotiated suite can carry CID records, 0 otherwise */
+int DtlsCidSupportedSuite(WOLFSSL* ssl)
+{
+    if (!ssl->options.dtls || ssl->specs.cipher_type != aead)
+        return 0;
+#if defined(HAVE_CHACHA) && defined(HAVE_POLY1305)
+    if (ssl->specs.bulk_cipher_algorithm == wolfssl_chacha &&
+                                                   ssl->options.oldPoly != 0)
+        return 0;
+#endif
+    return 1;
+}
+
+/* Size of the connection ID to put on outgoing records, 0 when records go out
+ * with the plain DTLS header. Only protected records, epoch 1 and up, carry
+ * the connection ID. The Finished can go out before the peer's
+ * ChangeCipherSpec turns on encryptionOn, so the write epoch is checked. */
+static WC_INLINE byte DtlsCidTxSz(WOLFSSL* ssl)
+{
+    if (!ssl->options.dtls || !ssl->dtlsCidInfo.negotiated ||
+                                                ssl->keys.dtls_epoch == 0)
+        return 0;
+    return ssl->dtlsCidInfo.txSz;
+}
+
+/* Whether the record being processed carries a connection ID. Only DTLS
+ * records after a connection ID was negotiated can, GetRecordHeader()
+ * rejects any other tls12_cid record. */
+static WC_INLINE int DtlsCidRxRecord(WOLFSSL* ssl)
+{
+    return ssl->options.dtls && ssl->dtlsCidInfo.negotiated &&
+                                              ssl->curRL.type == dtls12_cid;
+}
+
+#ifdef HAVE_AEAD
+/* Write the additional data for a record carrying a connection ID.
+ * RFC 9146, section 5:
+ *   seq_num_placeholder + tls12_cid + cid_length + tls12_cid +
+ *   DTLSCiphertext.version + epoch + sequence_number + cid +
+ *   length_of_DTLSInnerPlaintext
+ *
+ * ssl     WOLFSSL structure holding the connection IDs.
+ * aad     Buffer of at least AEAD_AUTH_DATA_MAX_SZ bytes.
+ * verify  1 for a record received from the peer, 0 for one being sent.
+ * sz      Length of the inner plaintext.
+ * returns the number of bytes written.
+ */
+static word32 DtlsCidWriteAAD(WOLFSSL* ssl, byte* aad, int verify, word16 sz)
+{
+    const byte* cid;
+    byte        cidSz;
+    word32      idx = 0;
+
+    if (verify) {
+        cid   = ssl->dtlsCidInfo.rx;
+        cidSz = ssl->dtlsCidInfo.rxSz;
+    }
+    else {
+        cid   = ssl->dtlsCidInfo.tx;
+        cidSz = ssl->dtlsCidInfo.txSz;
+    }
+
+    XMEMSET(aad, 0xff, SEQ_SZ);
+    idx += SEQ_SZ;
+    aad[idx++] = dtls12_cid;
+    aad[idx++] = cidSz;
+    aad[idx++] = dtls12_cid;
+    if (verify) {
+        aad[idx++] = ssl->curRL.pvMajor;
+        aad[idx++] = ssl->curRL.pvMinor;
+    }
+    else {
+        aad[idx++] = ssl->version.major;
+        aad[idx++] = ssl->version.minor;
+    }
+    /* epoch and sequence number */
+    WriteSEQ(ssl, verify ? PEER_ORDER : CUR_ORDER, aad + idx);
+    idx += SEQ_SZ;
+    XMEMCPY(aad + idx, cid, cidSz);
+    idx += cidSz;
+    c16toa(sz, aad + idx);
+    idx += LENGTH_SZ;
+
+    return idx;
+}
+#endif /* HAVE_AEAD */
+#endif /* WOLFSSL_DTLS_CID */
+
 #ifdef WOLFSSL_DTLS
 
 /* functions for managing DTLS datagram reordering */
@@ -7584,6 +7902,85 @@ static int EdDSA_Update(WOLFSSL* ssl, const byte* data, int sz)
 }
 #endif /* (HAVE_ED25519 || HAVE_ED448) && !WOLFSSL_NO_CLIENT_AUTH */
 
+/* Add data to the running handshake hashes and, until the cipher suite is
+ * known, to the message buffer.
+ *
+ * ssl   SSL/TLS object.
+ * data  Handshake message data.
+ * sz    Size of data.
+ * returns MEMORY_E when the buffer can't be grown, otherwise 0 on success.
+ */
+int HashRaw(WOLFSSL* ssl, const byte* data, int sz)
+{
+    int        ret = 0;
+    HS_Hashes* hs = ssl->hsHashes;
+
+    if (hs == NULL || sz < 0)
+        return BAD_FUNC_ARG;
+
+    if (hs->buffering && sz > 0) {
+        if (hs->rawLen + (word32)sz > hs->rawSz) {
+            word32 newSz = hs->rawSz * 2;
+            byte*  msgs;
+
+            if (newSz < HS_HASH_BUFFER_SZ)
+                newSz = HS_HASH_BUFFER_SZ;
+            if (newSz < hs->rawLen + (word32)sz)
+                newSz = hs->rawLen + (word32)sz;
+            msgs = (byte*)XREALLOC(hs->rawMsgs, newSz, ssl->heap,
+                                                           DYNAMIC_TYPE_HASHES);
+            if (msgs == NULL)
+                return MEMORY_E;
+            hs->rawMsgs = msgs;
+            hs->rawSz = newSz;
+        }
+        XMEMCPY(hs->rawMsgs + hs->rawLen, data, sz);
+        hs->rawLen += (word32)sz;
+    }
+
+#if !defined(NO_MD5) && !defined(NO_OLD_TLS)
+    if (hs->hashMask & HS_HASH_MD5) {
+        ret = wc_Md5Update(&hs->hashMd5, data, sz);
+        if (ret != 0)
+            return ret;
+    }
+#endif
+#if !defined(NO_SHA) && (!defined(NO_OLD_TLS) || \
+                              defined(WOLFSSL_ALLOW_TLS_SHA1))
+    if (hs->hashMask & HS_HASH_SHA) {
+        ret = wc_ShaUpdate(&hs->hashSha, data, sz);
+        if (ret != 0)
+            return ret;
+    }
+#endif
+
+    if (IsAtLeastTLSv1_2(ssl)) {
+    #ifndef NO_SHA256
+        if (hs->hashMask & HS_HASH_SHA256) {
+            ret = wc_Sha256Update(&hs->hashSha256, data, sz);
+            if (ret != 0)
+                return ret;
+        }
+    #endif
+    #ifdef WOLFSSL_SHA384
+        if (hs->hashMask & HS_HASH_SHA384) {
+            ret = wc_Sha384Update(&hs->hashSha384, data, sz);
+            if (ret != 0)
+                return ret;
+        }
+    #endif
+    #ifdef WOLFSSL_SHA512
+        if (hs->hashMask & HS_HASH_SHA512) {
+            ret = wc_Sha512Update(&hs->hashSha512, data, sz);
+            if (ret != 0)
+                return ret;
+        }
+    #endif
+    }
+
+    return ret;
+}
+
 #ifndef NO_CERTS
 int HashOutputRaw(WOLFSSL* ssl, const byte* output, int sz)
 {
@@ -7599,39 +7996,13 @@ int HashOutputRaw(WOLFSSL* ssl, const byte* output, int sz)
     if (ssl->fuzzerCb)
         ssl->fuzzerCb(ssl, output, sz, FUZZ_HASH, ssl->fuzzerCtx);
 #endif
-#ifndef NO_OLD_TLS
-    #ifndef NO_SHA
-        wc_ShaUpdate(&ssl->hsHashes->hashSha, output, sz);
-    #endif
-    #ifndef NO_MD5
-        wc_Md5Update(&ssl->hsHashes->hashMd5, output, sz);
-    #endif
-#endif /* NO_OLD_TLS */
-
-    if (IsAtLeastTLSv1_2(ssl)) {
-    #ifndef NO_SHA256
-        ret = wc_Sha256Update(&ssl->hsHashes->hashSha256, output, sz);
-        if (ret != 0)
-            return ret;
-    #endif
-    #ifdef WOLFSSL_SHA384
-        ret = wc_Sha384Update(&ssl->hsHashes->hashSha384, output, sz);
-        if (ret != 0)
-            return ret;
-    #endif
-    #ifdef WOLFSSL_SHA512
-        ret = wc_Sha512Update(&ssl->hsHashes->hashSha512, output, sz);
-        if (ret != 0)
-            return ret;
-    #endif
-    #if !defined(WOLFSSL_NO_CLIENT_AUTH) && \
+    ret = HashRaw(ssl, output, sz);
+#if !defined(WOLFSSL_NO_CLIENT_AUTH) && \
                ((defined(HAVE_ED25519) && !defined(NO_ED25519_CLIENT_AUTH)) || \
                 (defined(HAVE_ED448) && !defined(NO_ED448_CLIENT_AUTH)))
+    if (ret == 0 && IsAtLeastTLSv1_2(ssl))
         ret = EdDSA_Update(ssl, output, sz);
-        if (ret != 0)
-            return ret;
-    #endif
-    }
+#endif
 
     return ret;
 }
@@ -7660,39 +8031,13 @@ int HashOutput(WOLFSSL* ssl, const byte* output, int sz, int ivSz)
         sz  -= DTLS_RECORD_EXTRA;
     }
 #endif
-#ifndef NO_OLD_TLS
-    #ifndef NO_SHA
-        wc_ShaUpdate(&ssl->hsHashes->hashSha, adj, sz);
-    #endif
-    #ifndef NO_MD5
-        wc_Md5Update(&ssl->hsHashes->hashMd5, adj, sz);
-    #endif
-#endif
-
-    if (IsAtLeastTLSv1_2(ssl)) {
-    #ifndef NO_SHA256
-        ret = wc_Sha256Update(&ssl->hsHashes->hashSha256, adj, sz);
-        if (ret != 0)
-            return ret;
-    #endif
-    #ifdef WOLFSSL_SHA384
-        ret = wc_Sha384Update(&ssl->hsHashes->hashSha384, adj, sz);
-        if (ret != 0)
-            return ret;
-    #endif
-    #ifdef WOLFSSL_SHA512
-        ret = wc_Sha512Update(&ssl->hsHashes->hashSha512, adj, sz);
-        if (ret != 0)
-            return ret;
-    #endif
-    #if !defined(WOLFSSL_NO_CLIENT_AUTH) && \
+    ret = HashRaw(ssl, adj, sz);
+#if !defined(WOLFSSL_NO_CLIENT_AUTH) && \
                ((defined(HAVE_ED25519) && !defined(NO_ED25519_CLIENT_AUTH)) || \
                 (defined(HAVE_ED448) && !defined(NO_ED448_CLIENT_AUTH)))
+    if (ret == 0 && IsAtLeastTLSv1_2(ssl))
         ret = EdDSA_Update(ssl, adj, sz);
-        if (ret != 0)
-            return ret;
-    #endif
-    }
+#endif
 
     return ret;
 }
@@ -7720,39 +8065,13 @@ int HashInput(WOLFSSL* ssl, const byte* input, int sz)
         return BAD_FUNC_ARG;
     }
 
-#ifndef NO_OLD_TLS
-    #ifndef NO_SHA
-        wc_ShaUpdate(&ssl->hsHashes->hashSha, adj, sz);
-    #endif
-    #ifndef NO_MD5
-        wc_Md5Update(&ssl->hsHashes->hashMd5, adj, sz);
-    #endif
-#endif
-
-    if (IsAtLeastTLSv1_2(ssl)) {
-    #ifndef NO_SHA256
-        ret = wc_Sha256Update(&ssl->hsHashes->hashSha256, adj, sz);
-        if (ret != 0)
-            return ret;
-    #endif
-    #ifdef WOLFSSL_SHA384
-        ret = wc_Sha384Update(&ssl->hsHashes->hashSha384, adj, sz);
-        if (ret != 0)
-            return ret;
-    #endif
-    #ifdef WOLFSSL_SHA512
-        ret = wc_Sha512Update(&ssl->hsHashes->hashSha512, adj, sz);
-        if (ret != 0)
-            return ret;
-    #endif
-    #if !defined(WOLFSSL_NO_CLIENT_AUTH) && \
+    ret = HashRaw(ssl, adj, sz);
+#if !defined(WOLFSSL_NO_CLIENT_AUTH) && \
                ((defined(HAVE_ED25519) && !defined(NO_ED25519_CLIENT_AUTH)) || \
                 (defined(HAVE_ED448) && !defined(NO_ED448_CLIENT_AUTH)))
+    if (ret == 0 && IsAtLeastTLSv1_2(ssl))
         ret = EdDSA_Update(ssl, adj, sz);
-        if (ret != 0)
-            return ret;
-    #endif
-    }
+#endif
 
     return ret;
 }
@@ -8006,6 +8325,60 @@ void ShrinkInputBuffer(WOLFSSL* ssl, int forcedFree)
     ssl->buffers.inputBuffer.length = usedLength;
 }
 
+/* Whether to flush the output buffer with the vectored send callback. Only
+ * used for coalesced application data. The default vectored send goes
+ * straight to the socket so it is only used with the default send.
+ */
+static WC_INLINE int UseSendv(WOLFSSL* ssl)
+{
+    if (ssl->CBIOSendv == NULL || ssl->options.coalesceRecords <= 1 ||
+                                                          ssl->options.dtls) {
+        return 0;
+    }
+#ifdef HAVE_SENDMSG
+    if (ssl->CBIOSendv == EmbedSendv && ssl->CBIOSend != EmbedSend)
+        return 0;
+#endif
+    return 1;
+}
+
+
+/* Send what is left of the output buffer with the vectored send callback, an
+ * entry per TLS record so the transport still sees the record boundaries.
+ * Records are laid out from the start of the buffer, sent ones still in place.
+ * Returns what the callback returned.
+ */
+static int SendBufferedv(WOLFSSL* ssl)
+{
+    WOLFSSL_IOVEC iov[WOLFSSL_MAX_COALESCE_RECORDS];
+    byte*  buf   = ssl->buffers.outputBuffer.buffer;
+    word32 idx   = ssl->buffers.outputBuffer.idx;
+    word32 end   = idx + ssl->buffers.outputBuffer.length;
+    word32 pos   = 0;
+    word32 recEnd;
+    word16 recSz;
+    int    cnt   = 0;
+
+    while (pos < end && cnt < WOLFSSL_MAX_COALESCE_RECORDS) {
+        recEnd = end;
+        if (end - pos >= RECORD_HEADER_SZ) {
+            ato16(buf + pos + RECORD_HEADER_SZ - LENGTH_SZ, &recSz);
+            if (pos + RECORD_HEADER_SZ + recSz < end)
+                recEnd = pos + RECORD_HEADER_SZ + recSz;
+        }
+        if (recEnd > idx) {
+            word32 start = max(pos, idx);
+            iov[cnt].buf = (char*)buf + start;
+            iov[cnt].sz  = (int)(recEnd - start);
+            cnt++;
+        }
+        pos = recEnd;
+    }
+
+    return ssl->CBIOSendv(ssl, iov, cnt, ssl->IOCB_WriteCtx);
+}
+
+
 int SendBuffered(WOLFSSL* ssl)
 {
     if (ssl->CBIOSend == NULL) {
@@ -8022,8 +8395,12 @@ int SendBuffered(WOLFSSL* ssl)
 #endif
 
     while (ssl->buffers.outputBuffer.length > 0) {
-        int sent = ssl->CBIOSend(ssl,
-                                      (char*)ssl->buffers.outputBuffer.buffer +
+        int sent;
+
+        if (UseSendv(ssl))
+            sent = SendBufferedv(ssl);
+        else
+            sent = ssl->CBIOSend(ssl, (char*)ssl->buffers.outputBuffer.buffer +
                                       ssl->buffers.outputBuffer.idx,
                                       (int)ssl->buffers.outputBuffer.length,
                                       ssl->IOCB_WriteCtx);
@@ -8285,6 +8662,29 @@ static int GetRecordHeader(WOLFSSL* ssl, const byte* input, word32* inOutIdx,
         *inOutIdx += OPAQUE16_LEN;
         ato32(input + *inOutIdx, &ssl->keys.curSeq_lo);
         *inOutIdx += OPAQUE32_LEN;  /* advance past rest of seq */
+    #ifdef WOLFSSL_DTLS_CID
+        if (rh->type == dtls12_cid && ssl->dtlsCidInfo.negotiated) {
+            byte cidSz = ssl->dtlsCidInfo.rxSz;
+
+            /* The CID sits between the sequence number and the length. Drop
+             * records that don't carry the CID we handed out. */
+            if (cidSz == 0 ||
+                    !IsEncryptionOn(ssl, 0) ||
+                    ssl->buffers.inputBuffer.length - *inOutIdx <
+                                             (word32)cidSz + LENGTH_SZ ||
+                    ConstantCompare(input + *inOutIdx, ssl->dtlsCidInfo.rx,
+                                    cidSz) != 0) {
+                WOLFSSL_MSG("Unexpected DTLS connection ID");
+                return SEQUENCE_ERROR;
+            }
+            *inOutIdx += cidSz;
+        }
+        else if (rh->type != dtls12_cid && ssl->dtlsCidInfo.negotiated &&
+                 ssl->dtlsCidInfo.rxSz > 0 && IsEncryptionOn(ssl, 0)) {
+            WOLFSSL_MSG("Protected DTLS record without connection ID");
+            return SEQUENCE_ERROR;
+        }
+    #endif
         ato16(input + *inOutIdx, size);
         *inOutIdx += LENGTH_SZ;
 #endif
@@ -8354,6 +8754,16 @@ static int GetRecordHeader(WOLFSSL* ssl, const byte* input, word32* inOutIdx,
         case application_data:
         case alert:
             break;
+    #ifdef WOLFSSL_DTLS_CID
+        case dtls12_cid:
+            /* only DTLS with a negotiated connection ID uses this type */
+            if (!ssl->options.dtls || !ssl->dtlsCidInfo.negotiated) {
+                WOLFSSL_MSG("Connection ID record not negotiated");
+                SendAlert(ssl, alert_fatal, unexpected_message);
+                return UNKNOWN_RECORD_TYPE;
+            }
+            break;
+    #endif
         case no_type:
         default:
             WOLFSSL_MSG("Unknown Record Type");
@@ -8562,7 +8972,9 @@ static int BuildFinished(WOLFSSL* ssl, Hashes* hashes, const byte* sender)
 #endif
 #ifndef NO_OLD_TLS
     if (!ssl->options.tls) {
-        ret = BuildMD5(ssl, hashes, sender);
+        ret = SetHandshakeHashes(ssl, HS_HASH_MD5 | HS_HASH_SHA);
+        if (ret == 0)
+            ret = BuildMD5(ssl, hashes, sender);
         if (ret == 0) {
             ret = BuildSHA(ssl, hashes, sender);
         }
@@ -12773,8 +13185,9 @@ static WC_INLINE int DtlsCheckWindow(WOLFSSL* ssl)
     }
 #endif
     else if (curLT) {
-        word32 idx = diff / DTLS_WORD_BITS;
-        word32 newDiff = diff % DTLS_WORD_BITS;
+        /* bit 0 of the window is the record before the next expected one */
+        word32 idx = (diff - 1) / DTLS_WORD_BITS;
+        word32 newDiff = (diff - 1) % DTLS_WORD_BITS;
 
         /* verify idx is valid for window array */
         if (idx >= WOLFSSL_DTLS_WINDOW_WORDS) {
@@ -12885,8 +13298,8 @@ static WC_INLINE int DtlsUpdateWindow(WOLFSSL* ssl)
     }
 
     if (curLT) {
-        word32 idx = diff / DTLS_WORD_BITS;
-        word32 newDiff = diff % DTLS_WORD_BITS;
+        word32 idx = (diff - 1) / DTLS_WORD_BITS;
+        word32 newDiff = (diff - 1) % DTLS_WORD_BITS;
 
         if (idx < WOLFSSL_DTLS_WINDOW_WORDS)
             window[idx] |= (1 << newDiff);
@@ -13192,7 +13605,8 @@ static int  ChachaAEADEncrypt(WOLFSSL* ssl, byte* out, const byte* input,
     int ret       = 0;
     word32 msgLen = (sz - ssl->specs.aead_mac_size);
     byte tag[POLY1305_AUTH_SZ];
-    byte add[AEAD_AUTH_DATA_SZ];
+    byte add[AEAD_AUTH_DATA_MAX_SZ];
+    word32 addSz  = AEAD_AUTH_DATA_SZ;
     byte nonce[CHACHA20_NONCE_SZ];
     byte poly[CHACHA20_256_KEY_SIZE]; /* generated key for poly1305 */
     #ifdef CHACHA_AEAD_TEST
@@ -13282,6 +13696,13 @@ static int  ChachaAEADEncrypt(WOLFSSL* ssl, byte* out, const byte* input,
         return ret;
     }
 
+#ifdef WOLFSSL_DTLS_CID
+    /* The nonce above is built from the real sequence number, the additional
+     * data of a CID record starts with a placeholder instead. */
+    if (DtlsCidTxSz(ssl) > 0)
+        addSz = DtlsCidWriteAAD(ssl, add, 0, (word16)msgLen);
+#endif
+
     /* get the poly1305 tag using either old padding scheme or more recent */
     if (ssl->options.oldPoly != 0) {
         if ((ret = Poly1305TagOld(ssl, add, (const byte* )out,
@@ -13297,7 +13718,7 @@ static int  ChachaAEADEncrypt(WOLFSSL* ssl, byte* out, const byte* input,
             return ret;
         }
         if ((ret = wc_Poly1305_MAC(ssl->auth.poly1305, add,
-                            sizeof(add), out, msgLen, tag, sizeof(tag))) != 0) {
+                                  addSz, out, msgLen, tag, sizeof(tag))) != 0) {
             ForceZero(poly, sizeof(poly));
             return ret;
         }
@@ -13346,7 +13767,8 @@ static int  ChachaAEADEncrypt(WOLFSSL* ssl, byte* out, const byte* input,
 static int ChachaAEADDecrypt(WOLFSSL* ssl, byte* plain, const byte* input,
                            word16 sz)
 {
-    byte add[AEAD_AUTH_DATA_SZ];
+    byte add[AEAD_AUTH_DATA_MAX_SZ];
+    word32 addSz = AEAD_AUTH_DATA_SZ;
     byte nonce[CHACHA20_NONCE_SZ];
     byte tag[POLY1305_AUTH_SZ];
     byte poly[CHACHA20_256_KEY_SIZE]; /* generated key for mac */
@@ -13429,6 +13851,11 @@ static int ChachaAEADDecrypt(WOLFSSL* ssl, byte* plain, const byte* input,
     }
     ForceZero(nonce, CHACHA20_NONCE_SZ); /* done with nonce, clear it */
 
+#ifdef WOLFSSL_DTLS_CID
+    if (DtlsCidRxRecord(ssl))
+        addSz = DtlsCidWriteAAD(ssl, add, 1, (word16)msgLen);
+#endif
+
     /* get the tag using Poly1305 */
     if (ssl->options.oldPoly != 0) {
         if ((ret = Poly1305TagOld(ssl, add, input, poly, sz, tag)) != 0) {
@@ -13443,7 +13870,7 @@ static int ChachaAEADDecrypt(WOLFSSL* ssl, byte* plain, const byte* input,
             return ret;
         }
         if ((ret = wc_Poly1305_MAC(ssl->auth.poly1305, add,
-                   sizeof(add), (byte*)input, msgLen, tag, sizeof(tag))) != 0) {
+                   addSz, (byte*)input, msgLen, tag, sizeof(tag))) != 0) {
             ForceZero(poly, sizeof(poly));
             return ret;
         }
@@ -13573,6 +14000,7 @@ static WC_INLINE int EncryptDo(WOLFSSL* ssl, byte* out, const byte* input,
         {
             AES_AUTH_ENCRYPT_FUNC aes_auth_fn;
             const byte* additionalSrc;
+            word32 addSz = AEAD_AUTH_DATA_SZ;
 
         #ifdef WOLFSSL_ASYNC_CRYPT
             /* initialize event */
@@ -13611,6 +14039,13 @@ static WC_INLINE int EncryptDo(WOLFSSL* ssl, byte* out, const byte* input,
              * IV length minus the authentication tag size. */
             c16toa(sz - AESGCM_EXP_IV_SZ - ssl->specs.aead_mac_size,
                                 ssl->encrypt.additional + AEAD_LEN_OFFSET);
+        #ifdef WOLFSSL_DTLS_CID
+            if (DtlsCidTxSz(ssl) > 0) {
+                addSz = DtlsCidWriteAAD(ssl, ssl->encrypt.additional, 0,
+                                (word16)(sz - AESGCM_EXP_IV_SZ -
+                                         ssl->specs.aead_mac_size));
+            }
+        #endif
 #if !defined(NO_PUBLIC_GCM_SET_IV) && \
     ((defined(HAVE_FIPS) || defined(HAVE_SELFTEST)) && \
     (!defined(HAVE_FIPS_VERSION) || (HAVE_FIPS_VERSION < 2)))
@@ -13625,7 +14060,7 @@ static WC_INLINE int EncryptDo(WOLFSSL* ssl, byte* out, const byte* input,
                     ssl->encrypt.nonce, AESGCM_NONCE_SZ,
                     out + sz - ssl->specs.aead_mac_size,
                     ssl->specs.aead_mac_size,
-                    ssl->encrypt.additional, AEAD_AUTH_DATA_SZ);
+                    ssl->encrypt.additional, addSz);
         #ifdef WOLFSSL_ASYNC_CRYPT
             if (ret == WC_PENDING_E && asyncOkay) {
                 ret = wolfSSL_AsyncPush(ssl, asyncDev);
@@ -13725,7 +14160,7 @@ static WC_INLINE int Encrypt(WOLFSSL* ssl, byte* out, const byte* input, word16
                 ssl->specs.bulk_cipher_algorithm == wolfssl_aes_gcm) {
                 /* make sure auth iv and auth are allocated */
                 if (ssl->encrypt.additional == NULL)
-                    ssl->encrypt.additional = (byte*)XMALLOC(AEAD_AUTH_DATA_SZ,
+                    ssl->encrypt.additional = (byte*)XMALLOC(AEAD_AUTH_DATA_MAX_SZ,
                                                    ssl->heap, DYNAMIC_TYPE_AES_BUFFER);
                 if (ssl->encrypt.nonce == NULL)
                     ssl->encrypt.nonce = (byte*)XMALLOC(AESGCM_NONCE_SZ,
@@ -13850,6 +14285,7 @@ static WC_INLINE int DecryptDo(WOLFSSL* ssl, byte* plain, const byte* input,
         case wolfssl_aes_ccm: /* GCM AEAD macros use same size as CCM */
         {
             wc_AesAuthDecryptFunc aes_auth_fn;
+            word32 addSz = AEAD_AUTH_DATA_SZ;
 
         #ifdef WOLFSSL_ASYNC_CRYPT
             /* initialize event */
@@ -13879,6 +14315,13 @@ static WC_INLINE int DecryptDo(WOLFSSL* ssl, byte* plain, const byte* input,
 
             c16toa(sz - AESGCM_EXP_IV_SZ - ssl->specs.aead_mac_size,
                                     ssl->decrypt.additional + AEAD_LEN_OFFSET);
+        #ifdef WOLFSSL_DTLS_CID
+            if (DtlsCidRxRecord(ssl)) {
+                addSz = DtlsCidWriteAAD(ssl, ssl->decrypt.additional, 1,
+                                (word16)(sz - AESGCM_EXP_IV_SZ -
+                                         ssl->specs.aead_mac_size));
+            }
+        #endif
             XMEMCPY(ssl->decrypt.nonce, ssl->keys.aead_dec_imp_IV,
                                                             AESGCM_IMP_IV_SZ);
             XMEMCPY(ssl->decrypt.nonce + AESGCM_IMP_IV_SZ, input,
@@ -13890,7 +14333,7 @@ static WC_INLINE int DecryptDo(WOLFSSL* ssl, byte* plain, const byte* input,
                         ssl->decrypt.nonce, AESGCM_NONCE_SZ,
                         input + sz - ssl->specs.aead_mac_size,
                         ssl->specs.aead_mac_size,
-                        ssl->decrypt.additional, AEAD_AUTH_DATA_SZ)) < 0) {
+                        ssl->decrypt.additional, addSz)) < 0) {
             #ifdef WOLFSSL_ASYNC_CRYPT
                 if (ret == WC_PENDING_E) {
                     ret = wolfSSL_AsyncPush(ssl, &ssl->decrypt.aes->asyncDev);
@@ -13986,7 +14429,7 @@ static WC_INLINE int Decrypt(WOLFSSL* ssl, byte* plain, const byte* input,
                 ssl->specs.bulk_cipher_algorithm == wolfssl_aes_gcm) {
                 /* make sure auth iv and auth are allocated */
                 if (ssl->decrypt.additional == NULL)
-                    ssl->decrypt.additional = (byte*)XMALLOC(AEAD_AUTH_DATA_SZ,
+                    ssl->decrypt.additional = (byte*)XMALLOC(AEAD_AUTH_DATA_MAX_SZ,
                                                    ssl->heap, DYNAMIC_TYPE_AES_BUFFER);
                 if (ssl->decrypt.nonce == NULL)
                     ssl->decrypt.nonce = (byte*)XMALLOC(AESGCM_NONCE_SZ,
@@ -14614,6 +15057,58 @@ static WC_INLINE int VerifyMac(WOLFSSL* ssl, const byte* input, word32 msgSz,
 }
 
 
+#ifdef WOLFSSL_DTLS_CID
+/* Finish a decrypted record that carried a connection ID. The real content
+ * type is the last non-zero byte of the inner plaintext; it and the zero
+ * padding after it are added to padSz so the record handlers skip them.
+ * When the datagram came from a new address, the peer is moved there as the
+ * record authenticated and is newer than any seen so far (RFC 9146 sec 6).
+ *
+ * ssl  WOLFSSL structure with the record just decrypted.
+ * returns 0 on success, DECRYPT_ERROR when there is no content type.
+ */
+static int DtlsCidProcessRecord(WOLFSSL* ssl)
+{
+    byte*  buf = ssl->buffers.inputBuffer.buffer;
+    word32 idx = ssl->buffers.inputBuffer.idx;
+    word32 end = idx + ssl->curSize - ssl->keys.padSz;
+    word32 i;
+
+    /* idx is already past the explicit IV */
+    if (CipherHasExpIV(ssl))
+        end -= AESGCM_EXP_IV_SZ;
+
+    for (i = end; i > idx && buf[i - 1] == 0; i--)
+        ;
+    if (i == idx) {
+        WOLFSSL_MSG("CID record without content type");
+        return DECRYPT_ERROR;
+    }
+    i--;
+    ssl->curRL.type = buf[i];
+    ssl->keys.padSz += end - i;
+
+    if (ssl->buffers.dtlsCtx.pendingPeer.sz > 0 && !ssl->options.haveMcast) {
+        WOLFSSL_DTLS_PEERSEQ* peerSeq = ssl->keys.peerSeq;
+
+        if (ssl->keys.curEpoch == peerSeq->nextEpoch &&
+                (ssl->keys.curSeq_hi > peerSeq->nextSeq_hi ||
+                 (ssl->keys.curSeq_hi == peerSeq->nextSeq_hi &&
+                  ssl->keys.curSeq_lo >= peerSeq->nextSeq_lo))) {
+            WOLFSSL_MSG("DTLS peer moved to a new address");
+            XFREE(ssl->buffers.dtlsCtx.peer.sa, ssl->heap,
+                  DYNAMIC_TYPE_SOCKADDR);
+            ssl->buffers.dtlsCtx.peer = ssl->buffers.dtlsCtx.pendingPeer;
+            ssl->buffers.dtlsCtx.pendingPeer.sa = NULL;
+            ssl->buffers.dtlsCtx.pendingPeer.sz = 0;
+        }
+    }
+
+    return 0;
+}
+#endif /* WOLFSSL_DTLS_CID */
+
+
 /* process input requests, return 0 is done, 1 is call again to complete, and
    negative number is error */
 int ProcessReply(WOLFSSL* ssl)
@@ -15092,6 +15587,18 @@ int ProcessReply(WOLFSSL* ssl)
                     ssl->curRL.type = ssl->buffers.inputBuffer.buffer[i];
                     ssl->keys.padSz = ssl->buffers.inputBuffer.length - i;
                 }
+#endif
+#ifdef WOLFSSL_DTLS_CID
+                if (DtlsCidRxRecord(ssl)) {
+                    ret = DtlsCidProcessRecord(ssl);
+                    if (ret != 0) {
+                        /* pretend the datagram never happened */
+                        ssl->options.processReply = doProcessInit;
+                        ssl->buffers.inputBuffer.idx =
+                                            ssl->buffers.inputBuffer.length;
+                        return ret;
+                    }
+                }
 #endif
             }
 
@@ -15727,39 +16234,64 @@ static int BuildSHA_CertVerify(WOLFSSL* ssl, byte* digest)
 
 int BuildCertHashes(WOLFSSL* ssl, Hashes* hashes)
 {
-    int ret = 0;
+    int  ret = 0;
+    byte mask = HS_HASH_MD5 | HS_HASH_SHA;
 
     (void)hashes;
 
-    if (ssl->options.tls) {
-    #if !defined(NO_MD5) && !defined(NO_OLD_TLS)
-        ret = wc_Md5GetHash(&ssl->hsHashes->hashMd5, hashes->md5);
+    /* while still buffering, start every hash that may be signed over;
+     * afterwards only the hashes kept for the cipher suite are available */
+    if (ssl->options.tls && IsAtLeastTLSv1_2(ssl)) {
+        mask = HS_HASH_SHA256 | HS_HASH_SHA384 | HS_HASH_SHA512;
+        if (!IsAtLeastTLSv1_3(ssl->version))
+            mask |= HS_HASH_MD5 | HS_HASH_SHA;
+    }
+    if (ssl->hsHashes->buffering) {
+        ret = SetHandshakeHashes(ssl, mask);
         if (ret != 0)
             return ret;
+    }
+    mask &= ssl->hsHashes->hashMask;
+
+    if (ssl->options.tls) {
+    #if !defined(NO_MD5) && !defined(NO_OLD_TLS)
+        if (mask & HS_HASH_MD5) {
+            ret = wc_Md5GetHash(&ssl->hsHashes->hashMd5, hashes->md5);
+            if (ret != 0)
+                return ret;
+        }
     #endif
     #if !defined(NO_SHA)
-        ret = wc_ShaGetHash(&ssl->hsHashes->hashSha, hashes->sha);
-        if (ret != 0)
-            return ret;
+        if (mask & HS_HASH_SHA) {
+            ret = wc_ShaGetHash(&ssl->hsHashes->hashSha, hashes->sha);
+            if (ret != 0)
+                return ret;
+        }
     #endif
         if (IsAtLeastTLSv1_2(ssl)) {
             #ifndef NO_SHA256
+            if (mask & HS_HASH_SHA256) {
                 ret = wc_Sha256GetHash(&ssl->hsHashes->hashSha256,
                                        hashes->sha256);
                 if (ret != 0)
                     return ret;
+            }
             #endif
             #ifdef WOLFSSL_SHA384
+            if (mask & HS_HASH_SHA384) {
                 ret = wc_Sha384GetHash(&ssl->hsHashes->hashSha384,
                                        hashes->sha384);
                 if (ret != 0)
                     return ret;
+            }
             #endif
             #ifdef WOLFSSL_SHA512
+            if (mask & HS_HASH_SHA512) {
                 ret = wc_Sha512GetHash(&ssl->hsHashes->hashSha512,
                                        hashes->sha512);
                 if (ret != 0)
                     return ret;
+            }
             #endif
         }
     }
@@ -15793,6 +16325,9 @@ typedef struct BuildMsgArgs {
     word16 size;
     word32 ivSz;      /* TLSv1.1  IV */
     byte*  iv;
+#ifdef WOLFSSL_DTLS_CID
+    word32 cidSz;     /* connection ID in the record header */
+#endif
 } BuildMsgArgs;
 
 static void FreeBuildMsgArgs(WOLFSSL* ssl, void* pArgs)
@@ -15902,6 +16437,14 @@ int BuildMessage(WOLFSSL* ssl, byte* output, int outSz, const byte* input,
                 args->headerSz += DTLS_RECORD_EXTRA;
             }
         #endif
+        #ifdef WOLFSSL_DTLS_CID
+            args->cidSz = DtlsCidTxSz(ssl);
+            if (args->cidSz > 0) {
+                args->sz       += args->cidSz + ENUM_LEN; /* and inner type */
+                args->idx      += args->cidSz;
+                args->headerSz += args->cidSz;
+            }
+        #endif
 
         #ifndef WOLFSSL_AEAD_ONLY
             if (ssl->specs.cipher_type == block) {
@@ -15970,6 +16513,15 @@ int BuildMessage(WOLFSSL* ssl, byte* output, int outSz, const byte* input,
 
             args->size = (word16)(args->sz - args->headerSz);    /* include mac and digest */
             AddRecordHeader(output, args->size, (byte)type, ssl);
+        #ifdef WOLFSSL_DTLS_CID
+            if (args->cidSz > 0) {
+                /* tls12_cid header: the CID goes before the length */
+                output[0] = dtls12_cid;
+                XMEMCPY(output + DTLS_RECORD_HEADER_SZ - LENGTH_SZ,
+                        ssl->dtlsCidInfo.tx, args->cidSz);
+                c16toa(args->size, output + args->headerSz - LENGTH_SZ);
+            }
+        #endif
 
             /* write to output */
             if (args->ivSz > 0) {
@@ -15979,6 +16531,12 @@ int BuildMessage(WOLFSSL* ssl, byte* output, int outSz, const byte* input,
             }
             XMEMCPY(output + args->idx, input, inSz);
             args->idx += inSz;
+        #ifdef WOLFSSL_DTLS_CID
+            if (args->cidSz > 0) {
+                /* real content type ends the inner plaintext, no padding */
+                output[args->idx++] = (byte)type;
+            }
+        #endif
 
             ssl->options.buildMsgState = BUILD_MSG_HASH;
         }
@@ -15986,7 +16544,14 @@ int BuildMessage(WOLFSSL* ssl, byte* output, int outSz, const byte* input,
         case BUILD_MSG_HASH:
         {
             if (type == handshake && hashOutput) {
+            #ifdef WOLFSSL_DTLS_CID
+                /* hash from past the CID as if the header were plain */
+                ret = HashOutput(ssl, output,
+                                 args->headerSz - args->cidSz + inSz,
+                                 args->ivSz + args->cidSz);
+            #else
                 ret = HashOutput(ssl, output, args->headerSz + inSz, args->ivSz);
+            #endif
                 if (ret != 0)
                     goto exit_buildmsg;
             }
@@ -17170,6 +17735,7 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
         ret,
         dtlsExtra = 0;
     int groupMsgs = 0;
+    int maxRecords;
 
     if (ssl->error == WANT_WRITE
     #ifdef WOLFSSL_ASYNC_CRYPT
@@ -17249,66 +17815,93 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
     }
 #endif
 
-    for (;;) {
-        int   len;
-        byte* out;
-        byte* sendBuffer = (byte*)data + sent;  /* may switch on comp */
-        int   buffSz;                           /* may switch on comp */
-        int   outputSz;
-#ifdef HAVE_LIBZ
-        byte  comp[MAX_RECORD_SIZE + MAX_COMP_EXTRA];
+    /* build several records before sending them with one send call */
+    maxRecords = ssl->options.coalesceRecords;
+    if (maxRecords < 1 || ssl->options.partialWrite || ssl->options.dtls)
+        maxRecords = 1;
+#ifdef WOLFSSL_ASYNC_CRYPT
+    /* records built before a pending one would be left unaccounted */
+    maxRecords = 1;
 #endif
 
+    for (;;) {
+        int   len = 0;      /* plain text in the records built for this send */
+        int   records = 0;
+
         if (sent == sz) break;
 
-        len = wolfSSL_GetMaxRecordSize(ssl, sz - sent);
+        do {
+            int   recLen;
+            byte* out;
+            byte* sendBuffer = (byte*)data + sent + len;  /* may switch on comp */
+            int   buffSz;                           /* may switch on comp */
+            int   outputSz;
+#ifdef HAVE_LIBZ
+            byte  comp[MAX_RECORD_SIZE + MAX_COMP_EXTRA];
+#endif
+
+            recLen = wolfSSL_GetMaxRecordSize(ssl, sz - sent - len);
 
 #ifdef WOLFSSL_DTLS
-        if (IsDtlsNotSctpMode(ssl)) {
-            len = min(len, MAX_UDP_SIZE);
-        }
+            if (IsDtlsNotSctpMode(ssl)) {
+                recLen = min(recLen, MAX_UDP_SIZE);
+            }
 #endif
-        buffSz = len;
+            buffSz = recLen;
 
-        /* check for available size */
-        outputSz = len + COMP_EXTRA + dtlsExtra + MAX_MSG_EXTRA;
-        if ((ret = CheckAvailableSize(ssl, outputSz)) != 0)
-            return ssl->error = ret;
+            /* check for available size */
+            outputSz = recLen + COMP_EXTRA + dtlsExtra + MAX_MSG_EXTRA;
+            if (records == 0 && maxRecords > 1) {
+                /* make room for all the records at once, not one by one */
+                int need = (sz - sent + recLen - 1) / recLen;
+                if (need > maxRecords)
+                    need = maxRecords;
+                ret = CheckAvailableSize(ssl, outputSz * need);
+            }
+            else {
+                ret = CheckAvailableSize(ssl, outputSz);
+            }
+            if (ret != 0)
+                return ssl->error = ret;
 
-        /* get output buffer */
-        out = ssl->buffers.outputBuffer.buffer +
-              ssl->buffers.outputBuffer.length;
+            /* get output buffer */
+            out = ssl->buffers.outputBuffer.buffer +
+                  ssl->buffers.outputBuffer.length;
 
 #ifdef HAVE_LIBZ
-        if (ssl->options.usingCompression) {
-            buffSz = myCompress(ssl, sendBuffer, buffSz, comp, sizeof(comp));
-            if (buffSz < 0) {
-                return buffSz;
+            if (ssl->options.usingCompression) {
+                buffSz = myCompress(ssl, sendBuffer, buffSz, comp,
+                                    sizeof(comp));
+                if (buffSz < 0) {
+                    return buffSz;
+                }
+                sendBuffer = comp;
             }
-            sendBuffer = comp;
-        }
 #endif
-        if (!ssl->options.tls1_3) {
-            sendSz = BuildMessage(ssl, out, outputSz, sendBuffer, buffSz,
-                                  application_data, 0, 0, 1);
-        }
-        else {
+            if (!ssl->options.tls1_3) {
+                sendSz = BuildMessage(ssl, out, outputSz, sendBuffer, buffSz,
+                                      application_data, 0, 0, 1);
+            }
+            else {
 #ifdef WOLFSSL_TLS13
-            sendSz = BuildTls13Message(ssl, out, outputSz, sendBuffer, buffSz,
-                                       application_data, 0, 0, 1);
+                sendSz = BuildTls13Message(ssl, out, outputSz, sendBuffer,
+                                           buffSz, application_data, 0, 0, 1);
 #else
-            sendSz = BUFFER_ERROR;
+                sendSz = BUFFER_ERROR;
 #endif
-        }
-        if (sendSz < 0) {
-        #ifdef WOLFSSL_ASYNC_CRYPT
-            if (sendSz == WC_PENDING_E)
-                ssl->error = sendSz;
-        #endif
-            return BUILD_MSG_ERROR;
-        }
+            }
+            if (sendSz < 0) {
+            #ifdef WOLFSSL_ASYNC_CRYPT
+                if (sendSz == WC_PENDING_E)
+                    ssl->error = sendSz;
+            #endif
+                return BUILD_MSG_ERROR;
+            }
 
-        ssl->buffers.outputBuffer.length += sendSz;
+            ssl->buffers.outputBuffer.length += sendSz;
+            len += recLen;
+            records++;
+        } while (records < maxRecords && sent + len < sz);
 
         if ( (ssl->error = SendBuffered(ssl)) < 0) {
             WOLFSSL_ERROR(ssl->error);
@@ -17337,13 +17930,11 @@ int SendData(WOLFSSL* ssl, const void* data, int sz)
     return sent;
 }
 
-/* process input data */
-int ReceiveData(WOLFSSL* ssl, byte* output, int sz, int peek)
+/* Process records until decrypted application data is available in
+ * clearOutputBuffer. Returns 0 with data available or with a length of 0 when
+ * the peer closed the connection, otherwise the error. */
+static int ProcessAppData(WOLFSSL* ssl)
 {
-    int size;
-
-    WOLFSSL_ENTER("ReceiveData()");
-
     /* reset error state */
     if (ssl->error == WANT_READ
     #ifdef WOLFSSL_ASYNC_CRYPT
@@ -17422,6 +18013,21 @@ startScr:
         #endif
     }
 
+    return 0;
+}
+
+/* process input data */
+int ReceiveData(WOLFSSL* ssl, byte* output, int sz, int peek)
+{
+    int size;
+    int ret;
+
+    WOLFSSL_ENTER("ReceiveData()");
+
+    ret = ProcessAppData(ssl);
+    if (ret != 0 || ssl->buffers.clearOutputBuffer.length == 0)
+        return ret;
+
     if (sz < (int)ssl->buffers.clearOutputBuffer.length)
         size = sz;
     else
@@ -17442,6 +18048,42 @@ startScr:
     return size;
 }
 
+/* Process input data without copying it out. *data is set to the decrypted
+ * application data of the current record, which stays in place in the input
+ * buffer until released with ReleaseDataZeroCopy(). Returns the size. */
+int ReceiveDataZeroCopy(WOLFSSL* ssl, const byte** data)
+{
+    int ret;
+
+    WOLFSSL_ENTER("ReceiveDataZeroCopy()");
+
+    ret = ProcessAppData(ssl);
+    if (ret != 0 || ssl->buffers.clearOutputBuffer.length == 0)
+        return ret;
+
+    *data = ssl->buffers.clearOutputBuffer.buffer;
+    ret = (int)ssl->buffers.clearOutputBuffer.length;
+
+    WOLFSSL_LEAVE("ReceiveDataZeroCopy()", ret);
+    return ret;
+}
+
+/* consume sz bytes of the data returned by ReceiveDataZeroCopy() */
+int ReleaseDataZeroCopy(WOLFSSL* ssl, int sz)
+{
+    if (sz < 0 || sz > (int)ssl->buffers.clearOutputBuffer.length)
+        return BAD_FUNC_ARG;
+
+    ssl->buffers.clearOutputBuffer.length -= sz;
+    ssl->buffers.clearOutputBuffer.buffer += sz;
+
+    if (ssl->buffers.clearOutputBuffer.length == 0 &&
+                                           ssl->buffers.inputBuffer.dynamicFlag)
+       ShrinkInputBuffer(ssl, NO_FORCED_FREE);
+
+    return 0;
+}
+
 
 /* send alert message */
 int SendAlert(WOLFSSL* ssl, int severity, int type)
@@ -20207,6 +20849,16 @@ exit_dpk:
 #endif /* HAVE_SECRET_CALLBACK */
 
         ret = CompleteServerHello(ssl);
+    #ifdef WOLFSSL_DTLS_CID
+        if (ret == 0 && ssl->dtlsCidInfo.negotiated &&
+                                                !DtlsCidSupportedSuite(ssl)) {
+            WOLFSSL_MSG("Server used connection IDs with a non-AEAD suite");
+            SendAlert(ssl, alert_fatal, illegal_parameter);
+            ret = UNSUPPORTED_SUITE;
+        }
+    #endif
+        if (ret == 0)
+            ret = FinalizeHandshakeHashes(ssl);
 
         WOLFSSL_LEAVE("DoServerHello", ret);
         WOLFSSL_END(WC_FUNC_SERVER_HELLO_DO);
@@ -24140,6 +24792,11 @@ static int DoSessionTicket(WOLFSSL* ssl, const byte* input, word32* inOutIdx,
         WOLFSSL_START(WC_FUNC_SERVER_HELLO_SEND);
         WOLFSSL_ENTER("SendServerHello");
 
+        /* cipher suite is chosen, only keep the hashes it needs */
+        ret = FinalizeHandshakeHashes(ssl);
+        if (ret != 0)
+            return ret;
+
         length = VERSION_SZ + RAN_LEN
                + ID_LEN + ENUM_LEN
                + SUITE_LEN
@@ -26207,22 +26864,11 @@ static int DoSessionTicket(WOLFSSL* ssl, const byte* input, word32* inOutIdx,
 #endif
 
         /* manually hash input since different format */
-#ifndef NO_OLD_TLS
-#ifndef NO_MD5
-        wc_Md5Update(&ssl->hsHashes->hashMd5, input + idx, sz);
-#endif
-#ifndef NO_SHA
-        wc_ShaUpdate(&ssl->hsHashes->hashSha, input + idx, sz);
-#endif
-#endif
-#ifndef NO_SHA256
-        if (IsAtLeastTLSv1_2(ssl)) {
-            int shaRet = wc_Sha256Update(&ssl->hsHashes->hashSha256,
-                                         input + idx, sz);
-            if (shaRet != 0)
-                return shaRet;
+        {
+            int hashRet = HashRaw(ssl, input + idx, sz);
+            if (hashRet != 0)
+                return hashRet;
         }
-#endif
 
         /* does this value mean client_hello? */
         idx++;
@@ -27772,6 +28418,238 @@ static int DoSessionTicket(WOLFSSL* ssl, const byte* input, word32* inOutIdx,
     }
 
 
+#ifndef WOLFSSL_NO_DEF_TICKET_ENC_CB
+    /* derive the name and key for rotation period from the secret, 0 on
+     * success */
+    static int DeriveTicketKey(TicketEncCbCtx* keyCtx, word32 period,
+                               TicketEncCbKey* key, void* heap)
+    {
+        static const byte nameLabel[] = "ticket name";
+        static const byte keyLabel[]  = "ticket key";
+        byte  periodBuf[OPAQUE32_LEN];
+        byte  digest[WC_SHA256_DIGEST_SIZE];
+        int   ret;
+    #ifdef WOLFSSL_SMALL_STACK
+        Hmac* hmac = (Hmac*)XMALLOC(sizeof(Hmac), heap, DYNAMIC_TYPE_HMAC);
+        if (hmac == NULL)
+            return MEMORY_E;
+    #else
+        Hmac  hmac[1];
+    #endif
+
+        c32toa(period, periodBuf);
+
+        ret = wc_HmacInit(hmac, heap, INVALID_DEVID);
+        if (ret == 0) {
+            ret = wc_HmacSetKey(hmac, WC_SHA256, keyCtx->secret,
+                                keyCtx->secretSz);
+            if (ret == 0)
+                ret = wc_HmacUpdate(hmac, nameLabel, sizeof(nameLabel) - 1);
+            if (ret == 0)
+                ret = wc_HmacUpdate(hmac, periodBuf, sizeof(periodBuf));
+            if (ret == 0)
+                ret = wc_HmacFinal(hmac, digest);
+            if (ret == 0) {
+                XMEMCPY(key->name, digest, WOLFSSL_TICKET_NAME_SZ);
+                ret = wc_HmacSetKey(hmac, WC_SHA256, keyCtx->secret,
+                                    keyCtx->secretSz);
+            }
+            if (ret == 0)
+                ret = wc_HmacUpdate(hmac, keyLabel, sizeof(keyLabel) - 1);
+            if (ret == 0)
+                ret = wc_HmacUpdate(hmac, periodBuf, sizeof(periodBuf));
+            if (ret == 0)
+                ret = wc_HmacFinal(hmac, key->key);
+            wc_HmacFree(hmac);
+        }
+
+        if (ret == 0) {
+            key->period = period;
+            key->valid  = 1;
+        }
+        ForceZero(digest, sizeof(digest));
+
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(hmac, heap, DYNAMIC_TYPE_HMAC);
+    #endif
+        (void)heap;
+
+        return ret;
+    }
+
+
+    /* copy out the key for rotation period, deriving it if not cached and
+     * generating a random secret on first use, call with mutex held */
+    static int GetTicketKey(WOLFSSL* ssl, TicketEncCbCtx* keyCtx,
+                            word32 period, TicketEncCbKey* key)
+    {
+        int i;
+        int victim;
+        int ret;
+
+        if (keyCtx->secretSz == 0) {
+            ret = wc_RNG_GenerateBlock(ssl->rng, keyCtx->secret,
+                                       WOLFSSL_TICKET_KEY_SZ);
+            if (ret != 0)
+                return ret;
+            keyCtx->secretSz = WOLFSSL_TICKET_KEY_SZ;
+        }
+
+        for (i = 0; i < WOLFSSL_TICKET_KEYS_CACHED; i++) {
+            if (keyCtx->keys[i].valid && keyCtx->keys[i].period == period) {
+                XMEMCPY(key, &keyCtx->keys[i], sizeof(TicketEncCbKey));
+                return 0;
+            }
+        }
+
+        /* replace an empty slot or the oldest period */
+        victim = 0;
+        for (i = 0; i < WOLFSSL_TICKET_KEYS_CACHED; i++) {
+            if (!keyCtx->keys[i].valid) {
+                victim = i;
+                break;
+            }
+            if (keyCtx->keys[i].period < keyCtx->keys[victim].period)
+                victim = i;
+        }
+        ret = DeriveTicketKey(keyCtx, period, &keyCtx->keys[victim],
+                              ssl->heap);
+        if (ret == 0)
+            XMEMCPY(key, &keyCtx->keys[victim], sizeof(TicketEncCbKey));
+
+        return ret;
+    }
+
+
+    /* seal or open the ticket with key, 0 on success */
+    static int TicketEncCbCrypt(WOLFSSL* ssl, const TicketEncCbKey* key,
+                                const byte* iv, byte* mac, int enc,
+                                byte* ticket, int inLen)
+    {
+        byte aad[WOLFSSL_TICKET_NAME_SZ + WOLFSSL_TICKET_IV_SZ + LENGTH_SZ];
+        int  ret;
+    #if defined(HAVE_AESGCM) && defined(WOLFSSL_AES_256)
+    #ifdef WOLFSSL_SMALL_STACK
+        Aes* aes;
+    #else
+        Aes  aes[1];
+    #endif
+    #endif
+
+        /* key name, iv and length are authenticated */
+        XMEMCPY(aad, key->name, WOLFSSL_TICKET_NAME_SZ);
+        XMEMCPY(aad + WOLFSSL_TICKET_NAME_SZ, iv, WOLFSSL_TICKET_IV_SZ);
+        c16toa((word16)inLen, aad + WOLFSSL_TICKET_NAME_SZ +
+                                                          WOLFSSL_TICKET_IV_SZ);
+
+    #if defined(HAVE_AESGCM) && defined(WOLFSSL_AES_256)
+    #ifdef WOLFSSL_SMALL_STACK
+        aes = (Aes*)XMALLOC(sizeof(Aes), ssl->heap, DYNAMIC_TYPE_CIPHER);
+        if (aes == NULL)
+            return MEMORY_E;
+    #endif
+        ret = wc_AesInit(aes, ssl->heap, INVALID_DEVID);
+        if (ret == 0) {
+            ret = wc_AesGcmSetKey(aes, key->key, AES_256_KEY_SIZE);
+            if (ret == 0 && enc) {
+                ret = wc_AesGcmEncrypt(aes, ticket, ticket, inLen, iv,
+                                       GCM_NONCE_MID_SZ, mac, AES_BLOCK_SIZE,
+                                       aad, sizeof(aad));
+            }
+            else if (ret == 0) {
+                ret = wc_AesGcmDecrypt(aes, ticket, ticket, inLen, iv,
+                                       GCM_NONCE_MID_SZ, mac, AES_BLOCK_SIZE,
+                                       aad, sizeof(aad));
+            }
+            wc_AesFree(aes);
+        }
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(aes, ssl->heap, DYNAMIC_TYPE_CIPHER);
+    #endif
+    #else
+        (void)ssl;
+        if (enc) {
+            ret = wc_ChaCha20Poly1305_Encrypt(key->key, iv, aad, sizeof(aad),
+                                              ticket, inLen, ticket, mac);
+        }
+        else {
+            ret = wc_ChaCha20Poly1305_Decrypt(key->key, iv, aad, sizeof(aad),
+                                              ticket, inLen, mac, ticket);
+        }
+    #endif
+
+        return ret;
+    }
+
+
+    /* built-in session ticket callback, seals tickets with AES-256-GCM (or
+     * ChaCha20-Poly1305) under a key that rotates every lifetime seconds.
+     * Tickets under the previous key are accepted, and replaced, for the
+     * ticket hint after a rotation. Keys come from the CTX, userCtx unused */
+    int DefTicketEncCb(WOLFSSL* ssl, byte key_name[WOLFSSL_TICKET_NAME_SZ],
+                       byte iv[WOLFSSL_TICKET_IV_SZ],
+                       byte mac[WOLFSSL_TICKET_MAC_SZ],
+                       int enc, byte* ticket, int inLen, int* outLen,
+                       void* userCtx)
+    {
+        TicketEncCbCtx* keyCtx = &ssl->ctx->ticketKeyCtx;
+        TicketEncCbKey  key;
+        word32          now = LowResTimer();
+        word32          period;
+        int             ret = WOLFSSL_TICKET_RET_OK;
+        int             keyRet;
+
+        (void)userCtx;
+
+        if (enc) {
+            keyRet = wc_RNG_GenerateBlock(ssl->rng, iv, WOLFSSL_TICKET_IV_SZ);
+            if (keyRet != 0)
+                return WOLFSSL_TICKET_RET_REJECT;
+        }
+
+        if (wc_LockMutex(&keyCtx->mutex) != 0)
+            return BAD_MUTEX_E;
+        period = now / keyCtx->lifetime;
+        keyRet = GetTicketKey(ssl, keyCtx, period, &key);
+        if (keyRet == 0 && !enc &&
+                XMEMCMP(key_name, key.name, WOLFSSL_TICKET_NAME_SZ) != 0) {
+            /* previous key only while its tickets may still be in use */
+            ret = WOLFSSL_TICKET_RET_REJECT;
+            if (period > 0 && ssl->ctx->ticketHint > 0 &&
+                    now - period * keyCtx->lifetime <
+                                                (word32)ssl->ctx->ticketHint) {
+                keyRet = GetTicketKey(ssl, keyCtx, period - 1, &key);
+                if (keyRet == 0 && XMEMCMP(key_name, key.name,
+                                           WOLFSSL_TICKET_NAME_SZ) == 0) {
+                    ret = WOLFSSL_TICKET_RET_CREATE;
+                }
+            }
+        }
+        wc_UnLockMutex(&keyCtx->mutex);
+
+        if (keyRet != 0) {
+            WOLFSSL_MSG("Unable to get ticket key");
+            ret = WOLFSSL_TICKET_RET_REJECT;
+        }
+        else if (enc) {
+            XMEMCPY(key_name, key.name, WOLFSSL_TICKET_NAME_SZ);
+            if (TicketEncCbCrypt(ssl, &key, iv, mac, 1, ticket, inLen) != 0)
+                ret = WOLFSSL_TICKET_RET_REJECT;
+        }
+        else if (ret != WOLFSSL_TICKET_RET_REJECT) {
+            if (TicketEncCbCrypt(ssl, &key, iv, mac, 0, ticket, inLen) != 0) {
+                WOLFSSL_MSG("Ticket failed authentication");
+                ret = WOLFSSL_TICKET_RET_REJECT;
+            }
+        }
+        *outLen = inLen;   /* no padding */
+        ForceZero(&key, sizeof(key));
+
+        return ret;
+    }
+#endif /* !WOLFSSL_NO_DEF_TICKET_ENC_CB */
+
+
     /* send Session Ticket */
     int SendTicket(WOLFSSL* ssl)
     {
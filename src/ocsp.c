@@ -54,11 +54,46 @@ int InitOCSP(WOLFSSL_OCSP* ocsp, WOLFSSL_CERT_MANAGER* cm)
 
     ocsp->cm = cm;
 
+    ocsp->statusTable = (CertStatus**)XMALLOC(
+                             sizeof(CertStatus*) * OCSP_STATUS_TABLE_SIZE,
+                             cm->heap, DYNAMIC_TYPE_OCSP);
+    if (ocsp->statusTable == NULL)
+        return MEMORY_E;
+    XMEMSET(ocsp->statusTable, 0, sizeof(CertStatus*) * OCSP_STATUS_TABLE_SIZE);
+    ocsp->statusTableSz = OCSP_STATUS_TABLE_SIZE;
+
     return 0;
 }
 
 
-static int InitOcspEntry(OcspEntry* entry, OcspRequest* request)
+static WC_INLINE word32 HashOCSP(const byte* issuerHash)
+{
+    return (((word32)issuerHash[0] << 24) | ((word32)issuerHash[1] << 16) |
+            ((word32)issuerHash[2] <<  8) |  (word32)issuerHash[3]) %
+                                                                OCSP_TABLE_SIZE;
+}
+
+
+/* FNV-1a over the issuer hashes and serial a response is cached under.
+ * Serials of one issuer are often sequential so all their bytes are used. */
+static word32 HashOcspStatus(const OcspEntry* entry, const byte* serial,
+                                                                   int serialSz)
+{
+    word32 hash = 2166136261U;
+    int    i;
+
+    for (i = 0; i < 4; i++) {
+        hash = (hash ^ entry->issuerHash[i])    * 16777619U;
+        hash = (hash ^ entry->issuerKeyHash[i]) * 16777619U;
+    }
+    for (i = 0; i < serialSz; i++)
+        hash = (hash ^ serial[i]) * 16777619U;
+
+    return hash;
+}
+
+
+static int InitOcspEntry(OcspEntry* entry, OcspRequest* request, void* heap)
 {
     WOLFSSL_ENTER("InitOcspEntry");
 
@@ -67,24 +102,40 @@ static int InitOcspEntry(OcspEntry* entry, OcspRequest* request)
     XMEMCPY(entry->issuerHash,    request->issuerHash,    OCSP_DIGEST_SIZE);
     XMEMCPY(entry->issuerKeyHash, request->issuerKeyHash, OCSP_DIGEST_SIZE);
 
+    /* remember the responder so cached responses can be refreshed later */
+    if (request->urlSz != 0 && request->url != NULL) {
+        entry->url = (byte*)XMALLOC(request->urlSz, heap,
+                                                       DYNAMIC_TYPE_OCSP_ENTRY);
+        if (entry->url == NULL)
+            return MEMORY_E;
+
+        XMEMCPY(entry->url, request->url, request->urlSz);
+        entry->urlSz = request->urlSz;
+    }
+
+    (void)heap;
+
     return 0;
 }
 
 
-static void FreeOcspEntry(OcspEntry* entry, void* heap)
+static void FreeCertStatus(CertStatus* status, void* heap)
 {
-    CertStatus *status, *next;
+    if (status->rawOcspResponse)
+        XFREE(status->rawOcspResponse, heap, DYNAMIC_TYPE_OCSP_STATUS);
 
-    WOLFSSL_ENTER("FreeOcspEntry");
+    XFREE(status, heap, DYNAMIC_TYPE_OCSP_STATUS);
 
-    for (status = entry->status; status; status = next) {
-        next = status->next;
+    (void)heap;
+}
 
-        if (status->rawOcspResponse)
-            XFREE(status->rawOcspResponse, heap, DYNAMIC_TYPE_OCSP_STATUS);
 
-        XFREE(status, heap, DYNAMIC_TYPE_OCSP_STATUS);
-    }
+static void FreeOcspEntry(OcspEntry* entry, void* heap)
+{
+    WOLFSSL_ENTER("FreeOcspEntry");
+
+    if (entry->url)
+        XFREE(entry->url, heap, DYNAMIC_TYPE_OCSP_ENTRY);
 
     (void)heap;
 }
@@ -92,14 +143,26 @@ static void FreeOcspEntry(OcspEntry* entry, void* heap)
 
 void FreeOCSP(WOLFSSL_OCSP* ocsp, int dynamic)
 {
-    OcspEntry *entry, *next;
+    OcspEntry  *entry, *next;
+    CertStatus *status, *nextStatus;
+    int         row;
 
     WOLFSSL_ENTER("FreeOCSP");
 
-    for (entry = ocsp->ocspList; entry; entry = next) {
-        next = entry->next;
-        FreeOcspEntry(entry, ocsp->cm->heap);
-        XFREE(entry, ocsp->cm->heap, DYNAMIC_TYPE_OCSP_ENTRY);
+    /* every cached response is on the LRU list */
+    for (status = ocsp->lruHead; status; status = nextStatus) {
+        nextStatus = status->lruNext;
+        FreeCertStatus(status, ocsp->cm->heap);
+    }
+    if (ocsp->statusTable)
+        XFREE(ocsp->statusTable, ocsp->cm->heap, DYNAMIC_TYPE_OCSP);
+
+    for (row = 0; row < OCSP_TABLE_SIZE; row++) {
+        for (entry = ocsp->ocspTable[row]; entry; entry = next) {
+            next = entry->next;
+            FreeOcspEntry(entry, ocsp->cm->heap);
+            XFREE(entry, ocsp->cm->heap, DYNAMIC_TYPE_OCSP_ENTRY);
+        }
     }
 
     wc_FreeMutex(&ocsp->ocspLock);
@@ -122,6 +185,138 @@ static int xstat2err(int st)
     }
 }
 
+
+/* Is the cached response within its thisUpdate/nextUpdate window */
+static int OcspStatusCurrent(CertStatus* status)
+{
+#ifndef NO_ASN_TIME
+    return XVALIDATE_DATE(status->thisDate, status->thisDateFormat, BEFORE)
+        && status->nextDate[0] != 0
+        && XVALIDATE_DATE(status->nextDate, status->nextDateFormat, AFTER);
+#else
+    (void)status;
+    return 1;
+#endif
+}
+
+
+/* Move status to the most recently used end. Call with ocspLock held. */
+static void OcspLruTouch(WOLFSSL_OCSP* ocsp, CertStatus* status)
+{
+    if (ocsp->lruTail == status)
+        return;
+
+    /* unlink if already on the list */
+    if (status->lruPrev)
+        status->lruPrev->lruNext = status->lruNext;
+    else if (ocsp->lruHead == status)
+        ocsp->lruHead = status->lruNext;
+    if (status->lruNext)
+        status->lruNext->lruPrev = status->lruPrev;
+
+    status->lruPrev = ocsp->lruTail;
+    status->lruNext = NULL;
+    if (ocsp->lruTail)
+        ocsp->lruTail->lruNext = status;
+    else
+        ocsp->lruHead = status;
+    ocsp->lruTail = status;
+}
+
+
+/* Rehash the cached responses into rows rows. The current table is kept if
+ * the new one can't be allocated. Call with ocspLock held. */
+static int ResizeOcspStatusTable(WOLFSSL_OCSP* ocsp, word32 rows)
+{
+    CertStatus** table;
+    CertStatus*  status;
+    CertStatus*  next;
+    word32       i;
+    word32       row;
+
+    table = (CertStatus**)XMALLOC(sizeof(CertStatus*) * rows, ocsp->cm->heap,
+                                                             DYNAMIC_TYPE_OCSP);
+    if (table == NULL)
+        return MEMORY_E;
+    XMEMSET(table, 0, sizeof(CertStatus*) * rows);
+
+    for (i = 0; i < ocsp->statusTableSz; i++) {
+        for (status = ocsp->statusTable[i]; status != NULL; status = next) {
+            next = status->next;
+
+            row = status->hash % rows;
+            status->next = table[row];
+            table[row] = status;
+        }
+    }
+
+    XFREE(ocsp->statusTable, ocsp->cm->heap, DYNAMIC_TYPE_OCSP);
+    ocsp->statusTable   = table;
+    ocsp->statusTableSz = rows;
+
+    return 0;
+}
+
+
+/* Link a new response of entry into the cache, takes ownership. Grows the
+ * table once the rows get long. Call with ocspLock held. */
+static void AddOcspStatus(WOLFSSL_OCSP* ocsp, OcspEntry* entry,
+                                                            CertStatus* status)
+{
+    word32 row;
+
+    status->entry = entry;
+    status->hash  = HashOcspStatus(entry, status->serial, status->serialSz);
+    status->lruPrev = status->lruNext = NULL;
+
+    row = status->hash % ocsp->statusTableSz;
+    status->next = ocsp->statusTable[row];
+    ocsp->statusTable[row] = status;
+    OcspLruTouch(ocsp, status);
+
+    entry->totalStatus++;
+    ocsp->totalStatus++;
+
+    if ((word32)ocsp->totalStatus >
+                              ocsp->statusTableSz * OCSP_STATUS_TABLE_LOAD) {
+        /* keep using the current rows if growing fails */
+        (void)ResizeOcspStatusTable(ocsp, ocsp->statusTableSz * 2 + 1);
+    }
+}
+
+
+/* Drop the least recently used response to make room for a new one. Call
+ * with ocspLock held, returns 1 if a response was dropped. */
+static int EvictOcspStatus(WOLFSSL_OCSP* ocsp)
+{
+    CertStatus*  victim = ocsp->lruHead;
+    CertStatus** prev;
+
+    if (victim == NULL)
+        return 0;
+
+    /* rows are kept short by resizing */
+    for (prev = &ocsp->statusTable[victim->hash % ocsp->statusTableSz];
+                                    *prev != victim; prev = &(*prev)->next) {
+        if (*prev == NULL)
+            return 0;
+    }
+    *prev = victim->next;
+
+    ocsp->lruHead = victim->lruNext;
+    if (ocsp->lruHead)
+        ocsp->lruHead->lruPrev = NULL;
+    else
+        ocsp->lruTail = NULL;
+
+    victim->entry->totalStatus--;
+    ocsp->totalStatus--;
+
+    FreeCertStatus(victim, ocsp->cm->heap);
+
+    return 1;
+}
+
 int CheckCertOCSP_ex(WOLFSSL_OCSP* ocsp, DecodedCert* cert, buffer* responseBuffer, WOLFSSL* ssl)
 {
     int ret = OCSP_LOOKUP_FAIL;
@@ -167,16 +362,19 @@ int CheckCertOCSP(WOLFSSL_OCSP* ocsp, DecodedCert* cert, buffer* responseBuffer)
 static int GetOcspEntry(WOLFSSL_OCSP* ocsp, OcspRequest* request,
                                                               OcspEntry** entry)
 {
+    word32 row;
+
     WOLFSSL_ENTER("GetOcspEntry");
 
     *entry = NULL;
+    row = HashOCSP(request->issuerHash);
 
     if (wc_LockMutex(&ocsp->ocspLock) != 0) {
         WOLFSSL_LEAVE("CheckCertOCSP", BAD_MUTEX_E);
         return BAD_MUTEX_E;
     }
 
-    for (*entry = ocsp->ocspList; *entry; *entry = (*entry)->next)
+    for (*entry = ocsp->ocspTable[row]; *entry; *entry = (*entry)->next)
         if (XMEMCMP((*entry)->issuerHash,    request->issuerHash,
                                                          OCSP_DIGEST_SIZE) == 0
         &&  XMEMCMP((*entry)->issuerKeyHash, request->issuerKeyHash,
@@ -187,9 +385,14 @@ static int GetOcspEntry(WOLFSSL_OCSP* ocsp, OcspRequest* request,
         *entry = (OcspEntry*)XMALLOC(sizeof(OcspEntry),
                                        ocsp->cm->heap, DYNAMIC_TYPE_OCSP_ENTRY);
         if (*entry) {
-            InitOcspEntry(*entry, request);
-            (*entry)->next = ocsp->ocspList;
-            ocsp->ocspList = *entry;
+            if (InitOcspEntry(*entry, request, ocsp->cm->heap) != 0) {
+                XFREE(*entry, ocsp->cm->heap, DYNAMIC_TYPE_OCSP_ENTRY);
+                *entry = NULL;
+            }
+            else {
+                (*entry)->next = ocsp->ocspTable[row];
+                ocsp->ocspTable[row] = *entry;
+            }
         }
     }
 
@@ -199,54 +402,60 @@ static int GetOcspEntry(WOLFSSL_OCSP* ocsp, OcspRequest* request,
 }
 
 
+/* Find the cached response of entry for serial. Call with ocspLock held. */
+static CertStatus* FindCertStatus(WOLFSSL_OCSP* ocsp, OcspEntry* entry,
+                                  const byte* serial, int serialSz)
+{
+    CertStatus* status;
+    word32      hash = HashOcspStatus(entry, serial, serialSz);
+
+    for (status = ocsp->statusTable[hash % ocsp->statusTableSz]; status;
+                                                        status = status->next)
+        if (status->hash == hash && status->entry == entry
+        &&  status->serialSz == serialSz
+        &&  !XMEMCMP(status->serial, serial, serialSz))
+            break;
+
+    return status;
+}
+
+
 /* Mallocs responseBuffer->buffer and is up to caller to free on success
  *
  * Returns OCSP status
  */
 static int GetOcspStatus(WOLFSSL_OCSP* ocsp, OcspRequest* request,
-                  OcspEntry* entry, CertStatus** status, buffer* responseBuffer)
+                                      OcspEntry* entry, buffer* responseBuffer)
 {
     int ret = OCSP_INVALID_STATUS;
+    CertStatus* status;
 
     WOLFSSL_ENTER("GetOcspStatus");
 
-    *status = NULL;
-
     if (wc_LockMutex(&ocsp->ocspLock) != 0) {
         WOLFSSL_LEAVE("CheckCertOCSP", BAD_MUTEX_E);
         return BAD_MUTEX_E;
     }
 
-    for (*status = entry->status; *status; *status = (*status)->next)
-        if ((*status)->serialSz == request->serialSz
-        &&  !XMEMCMP((*status)->serial, request->serial, (*status)->serialSz))
-            break;
+    status = FindCertStatus(ocsp, entry, request->serial, request->serialSz);
+    if (status)
+        OcspLruTouch(ocsp, status);
 
-    if (responseBuffer && *status && !(*status)->rawOcspResponse) {
+    if (responseBuffer && status && !status->rawOcspResponse) {
         /* force fetching again */
         ret = OCSP_INVALID_STATUS;
     }
-    else if (*status) {
-#ifndef NO_ASN_TIME
-        if (XVALIDATE_DATE((*status)->thisDate,
-                                             (*status)->thisDateFormat, BEFORE)
-        &&  ((*status)->nextDate[0] != 0)
-        &&  XVALIDATE_DATE((*status)->nextDate,
-                                             (*status)->nextDateFormat, AFTER))
-#endif
-        {
-            ret = xstat2err((*status)->status);
-
-            if (responseBuffer) {
-                responseBuffer->buffer = (byte*)XMALLOC(
-                   (*status)->rawOcspResponseSz, NULL, DYNAMIC_TYPE_TMP_BUFFER);
-
-                if (responseBuffer->buffer) {
-                    responseBuffer->length = (*status)->rawOcspResponseSz;
-                    XMEMCPY(responseBuffer->buffer,
-                            (*status)->rawOcspResponse,
-                            (*status)->rawOcspResponseSz);
-                }
+    else if (status && OcspStatusCurrent(status)) {
+        ret = xstat2err(status->status);
+
+        if (responseBuffer) {
+            responseBuffer->buffer = (byte*)XMALLOC(
+                       status->rawOcspResponseSz, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+            if (responseBuffer->buffer) {
+                responseBuffer->length = status->rawOcspResponseSz;
+                XMEMCPY(responseBuffer->buffer, status->rawOcspResponse,
+                                                     status->rawOcspResponseSz);
             }
         }
     }
@@ -335,25 +544,45 @@ WOLFSSL_LOCAL int CheckOcspResponse(WOLFSSL_OCSP *ocsp, byte *response, int resp
         goto end;
     }
 
+    newStatus->cachedTime = LowResTimer();
+
+    if (status == NULL && entry != NULL) {
+        /* refresh the cached response for this serial if there is one */
+        status = FindCertStatus(ocsp, entry, newStatus->serial,
+                                                         newStatus->serialSz);
+    }
+
     if (status != NULL) {
         if (status->rawOcspResponse) {
             XFREE(status->rawOcspResponse, ocsp->cm->heap,
                   DYNAMIC_TYPE_OCSP_STATUS);
         }
 
-        /* Replace existing certificate entry with updated */
-        newStatus->next = status->next;
+        /* Replace existing certificate entry with updated, keeping its
+         * place in the cache */
+        newStatus->next    = status->next;
+        newStatus->hash    = status->hash;
+        newStatus->entry   = status->entry;
+        newStatus->lruPrev = status->lruPrev;
+        newStatus->lruNext = status->lruNext;
         XMEMCPY(status, newStatus, sizeof(CertStatus));
+        if (status->entry != NULL)
+            OcspLruTouch(ocsp, status);
     }
-    else {
+    else if (entry != NULL) {
+        /* keep the cache bounded */
+        while (ocsp->cm->ocspCacheSz > 0 &&
+               ocsp->totalStatus >= ocsp->cm->ocspCacheSz) {
+            if (EvictOcspStatus(ocsp) == 0)
+                break;
+        }
+
         /* Save new certificate entry */
         status = (CertStatus*)XMALLOC(sizeof(CertStatus),
                                       ocsp->cm->heap, DYNAMIC_TYPE_OCSP_STATUS);
         if (status != NULL) {
             XMEMCPY(status, newStatus, sizeof(CertStatus));
-            status->next  = entry->status;
-            entry->status = status;
-            entry->totalStatus++;
+            AddOcspStatus(ocsp, entry, status);
         }
     }
 
@@ -385,16 +614,57 @@ end:
     return ret;
 }
 
-/* 0 on success */
-int CheckOcspRequest(WOLFSSL_OCSP* ocsp, OcspRequest* ocspRequest,
-                                                      buffer* responseBuffer)
+/* Send the request to the responder at url and cache the answer in entry.
+ *
+ * Returns OCSP status
+ */
+static int SendOcspRequest(WOLFSSL_OCSP* ocsp, OcspRequest* ocspRequest,
+                           OcspEntry* entry, void* ioCtx, const char* url,
+                           int urlSz, buffer* responseBuffer)
 {
-    OcspEntry*  entry          = NULL;
-    CertStatus* status         = NULL;
     byte*       request        = NULL;
     int         requestSz      = 2048;
     int         responseSz     = 0;
     byte*       response       = NULL;
+    int         ret            = -1;
+
+    request = (byte*)XMALLOC(requestSz, ocsp->cm->heap, DYNAMIC_TYPE_OCSP);
+    if (request == NULL) {
+        WOLFSSL_LEAVE("CheckCertOCSP", MEMORY_ERROR);
+        if (responseBuffer) {
+            XFREE(responseBuffer->buffer, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+            responseBuffer->buffer = NULL;
+        }
+        return MEMORY_ERROR;
+    }
+
+    requestSz = EncodeOcspRequest(ocspRequest, request, requestSz);
+    if (requestSz > 0 && ocsp->cm->ocspIOCb) {
+        responseSz = ocsp->cm->ocspIOCb(ioCtx, url, urlSz,
+                                        request, requestSz, &response);
+    }
+    if (responseSz == WOLFSSL_CBIO_ERR_WANT_READ) {
+        ret = OCSP_WANT_READ;
+    }
+
+    XFREE(request, ocsp->cm->heap, DYNAMIC_TYPE_OCSP);
+
+    if (responseSz >= 0 && response) {
+        ret = CheckOcspResponse(ocsp, response, responseSz, responseBuffer,
+                                NULL, entry, ocspRequest);
+    }
+
+    if (response != NULL && ocsp->cm->ocspRespFreeCb)
+        ocsp->cm->ocspRespFreeCb(ioCtx, response);
+
+    return ret;
+}
+
+/* 0 on success */
+int CheckOcspRequest(WOLFSSL_OCSP* ocsp, OcspRequest* ocspRequest,
+                                                      buffer* responseBuffer)
+{
+    OcspEntry*  entry          = NULL;
     const char* url            = NULL;
     int         urlSz          = 0;
     int         ret            = -1;
@@ -415,7 +685,7 @@ int CheckOcspRequest(WOLFSSL_OCSP* ocsp, OcspRequest* ocspRequest,
     if (ret != 0)
         return ret;
 
-    ret = GetOcspStatus(ocsp, ocspRequest, entry, &status, responseBuffer);
+    ret = GetOcspStatus(ocsp, ocspRequest, entry, responseBuffer);
     if (ret != OCSP_INVALID_STATUS)
         return ret;
 
@@ -426,10 +696,12 @@ int CheckOcspRequest(WOLFSSL_OCSP* ocsp, OcspRequest* ocspRequest,
 
 #if defined(OPENSSL_ALL) || defined(WOLFSSL_NGINX) || defined(WOLFSSL_HAPROXY)
     if (ocsp->statusCb != NULL && ssl != NULL) {
+        byte* response = NULL;
+
         ret = ocsp->statusCb(ssl, ioCtx);
         if (ret == 0) {
             ret = wolfSSL_get_ocsp_response(ssl, &response);
-            ret = CheckOcspResponse(ocsp, response, ret, responseBuffer, status,
+            ret = CheckOcspResponse(ocsp, response, ret, responseBuffer, NULL,
                                 entry, NULL);
             if (response != NULL)
                 XFREE(response, NULL, DYNAMIC_TYPE_OPENSSL);
@@ -456,39 +728,160 @@ int CheckOcspRequest(WOLFSSL_OCSP* ocsp, OcspRequest* ocspRequest,
         return 0;
     }
 
-    request = (byte*)XMALLOC(requestSz, ocsp->cm->heap, DYNAMIC_TYPE_OCSP);
-    if (request == NULL) {
-        WOLFSSL_LEAVE("CheckCertOCSP", MEMORY_ERROR);
-        if (responseBuffer) {
-            XFREE(responseBuffer->buffer, NULL, DYNAMIC_TYPE_TMP_BUFFER);
-            responseBuffer->buffer = NULL;
-        }
-        return MEMORY_ERROR;
-    }
+    ret = SendOcspRequest(ocsp, ocspRequest, entry, ioCtx, url, urlSz,
+                                                                responseBuffer);
 
-    requestSz = EncodeOcspRequest(ocspRequest, request, requestSz);
-    if (requestSz > 0 && ocsp->cm->ocspIOCb) {
-        responseSz = ocsp->cm->ocspIOCb(ioCtx, url, urlSz,
-                                        request, requestSz, &response);
+    /* Keep responseBuffer in the case of getting to response check. Caller
+     * should free responseBuffer after checking OCSP return value in "ret" */
+    WOLFSSL_LEAVE("CheckOcspRequest", ret);
+    return ret;
+}
+
+
+/* Cached response that is due for a refresh */
+typedef struct OcspRefresh {
+    OcspEntry* entry;
+    byte       serial[EXTERNAL_SERIAL_SIZE];
+    int        serialSz;
+    byte       stapled;                  /* keep the raw response too */
+} OcspRefresh;
+
+/* Fetch new responses for cached ones that are older than maxAge seconds or
+ * past their nextUpdate, so lookups made during a handshake keep hitting the
+ * cache instead of waiting on the responder. Responses that fail to refresh
+ * stay cached until they expire or are evicted.
+ *
+ * Returns the number of refreshed responses or a negative error.
+ */
+int RefreshOCSP(WOLFSSL_OCSP* ocsp, word32 maxAge)
+{
+    OcspRefresh* due = NULL;
+    OcspEntry*   entry;
+    CertStatus*  status;
+    const char*  url;
+    int          urlSz;
+    int          dueSz = 0;
+    int          refreshed = 0;
+    int          ret = 0;
+    int          i;
+    word32       now;
+
+    WOLFSSL_ENTER("RefreshOCSP");
+
+    if (ocsp == NULL)
+        return BAD_FUNC_ARG;
+
+    if (wc_LockMutex(&ocsp->ocspLock) != 0)
+        return BAD_MUTEX_E;
+
+    /* collect what is due while locked, the lookups happen without the lock */
+    if (ocsp->totalStatus > 0) {
+        due = (OcspRefresh*)XMALLOC(sizeof(OcspRefresh) * ocsp->totalStatus,
+                                       ocsp->cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
+        if (due == NULL)
+            ret = MEMORY_E;
     }
-    if (responseSz == WOLFSSL_CBIO_ERR_WANT_READ) {
-        ret = OCSP_WANT_READ;
+
+    now = LowResTimer();
+    for (status = ocsp->lruHead; ret == 0 && status; status = status->lruNext) {
+        if (dueSz == ocsp->totalStatus)
+            break;
+        if (now - status->cachedTime < maxAge && OcspStatusCurrent(status))
+            continue;
+
+        due[dueSz].entry    = status->entry;
+        due[dueSz].serialSz = status->serialSz;
+        due[dueSz].stapled  = status->rawOcspResponse != NULL;
+        XMEMCPY(due[dueSz].serial, status->serial, status->serialSz);
+        dueSz++;
     }
 
-    XFREE(request, ocsp->cm->heap, DYNAMIC_TYPE_OCSP);
+    wc_UnLockMutex(&ocsp->ocspLock);
 
-    if (responseSz >= 0 && response) {
-        ret = CheckOcspResponse(ocsp, response, responseSz, responseBuffer, status,
-                            entry, ocspRequest);
+    for (i = 0; ret == 0 && i < dueSz; i++) {
+    #ifdef WOLFSSL_SMALL_STACK
+        OcspRequest* ocspRequest;
+    #else
+        OcspRequest  ocspRequest[1];
+    #endif
+        buffer  responseBuffer;
+        int     useNonce;
+
+        entry = due[i].entry;
+
+        /* entries and their url live as long as the table */
+        if (ocsp->cm->ocspUseOverrideURL) {
+            url = ocsp->cm->ocspOverrideURL;
+            if (url == NULL || url[0] == '\0') {
+                ret = OCSP_NEED_URL;
+                break;
+            }
+            urlSz = (int)XSTRLEN(url);
+        }
+        else if (entry->url != NULL) {
+            url = (const char*)entry->url;
+            urlSz = entry->urlSz;
+        }
+        else
+            continue;
+
+    #ifdef WOLFSSL_SMALL_STACK
+        ocspRequest = (OcspRequest*)XMALLOC(sizeof(OcspRequest), NULL,
+                                                       DYNAMIC_TYPE_TMP_BUFFER);
+        if (ocspRequest == NULL) {
+            ret = MEMORY_E;
+            break;
+        }
+    #endif
+
+        /* a stapled response is shared by many peers so leave out the nonce */
+        useNonce = ocsp->cm->ocspSendNonce && !due[i].stapled;
+        ret = InitOcspRequest(ocspRequest, NULL, (byte)useNonce,
+                                                                ocsp->cm->heap);
+        if (ret == 0) {
+            XMEMCPY(ocspRequest->issuerHash, entry->issuerHash,
+                                                              OCSP_DIGEST_SIZE);
+            XMEMCPY(ocspRequest->issuerKeyHash, entry->issuerKeyHash,
+                                                              OCSP_DIGEST_SIZE);
+            ocspRequest->serial = (byte*)XMALLOC(due[i].serialSz,
+                                    ocsp->cm->heap, DYNAMIC_TYPE_OCSP_REQUEST);
+            if (ocspRequest->serial == NULL)
+                ret = MEMORY_E;
+        }
+        if (ret == 0) {
+            XMEMCPY(ocspRequest->serial, due[i].serial, due[i].serialSz);
+            ocspRequest->serialSz = due[i].serialSz;
+
+            responseBuffer.buffer = NULL;
+            responseBuffer.length = 0;
+
+            ret = SendOcspRequest(ocsp, ocspRequest, entry,
+                                  ocsp->cm->ocspIOCtx, url, urlSz,
+                                  due[i].stapled ? &responseBuffer : NULL);
+            if (ret == 0 || ret == OCSP_CERT_REVOKED) {
+                refreshed++;
+            }
+            else {
+                WOLFSSL_MSG("OCSP refresh failed, keeping cached response");
+            }
+            ret = 0;
+
+            if (responseBuffer.buffer)
+                XFREE(responseBuffer.buffer, ocsp->cm->heap,
+                                                       DYNAMIC_TYPE_TMP_BUFFER);
+        }
+
+        FreeOcspRequest(ocspRequest);
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(ocspRequest, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    #endif
     }
 
-    if (response != NULL && ocsp->cm->ocspRespFreeCb)
-        ocsp->cm->ocspRespFreeCb(ioCtx, response);
+    if (due)
+        XFREE(due, ocsp->cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
 
-    /* Keep responseBuffer in the case of getting to response check. Caller
-     * should free responseBuffer after checking OCSP return value in "ret" */
-    WOLFSSL_LEAVE("CheckOcspRequest", ret);
-    return ret;
+    WOLFSSL_LEAVE("RefreshOCSP", ret == 0 ? refreshed : ret);
+    return ret == 0 ? refreshed : ret;
 }
 
 #if defined(OPENSSL_ALL) || defined(WOLFSSL_NGINX) || defined(WOLFSSL_HAPROXY) || \
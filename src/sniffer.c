@@ -72,6 +72,16 @@
     /* Cache unclosed Sessions for 15 minutes since last used */
 #endif
 
+#ifndef WOLFSSL_SNIFFER_HASH_SIZE
+    #define WOLFSSL_SNIFFER_HASH_SIZE 499
+    /* Default Session Hash Table Rows, see ssl_SetSessionTableSize() */
+#endif
+
+#ifndef WOLFSSL_SNIFFER_SHARDS
+    #define WOLFSSL_SNIFFER_SHARDS 31
+    /* Session Hash Table locks, row r is guarded by lock r % SHARDS */
+#endif
+
 /* Misc constants */
 enum {
     MAX_SERVER_ADDRESS = 128, /* maximum server address length */
@@ -88,7 +98,8 @@ enum {
     TCP_PROTOCOL       = 6,   /* TCP Protocol id */
     NO_NEXT_HEADER     = 59,  /* IPv6 no headers follow */
     TRACE_MSG_SZ       = 80,  /* Trace Message buffer size */
-    HASH_SIZE          = 499, /* Session Hash Table Rows */
+    SERVER_HASH_SIZE   = 31,  /* Server address Hash Table Rows */
+    MAX_PORT_NUMBER    = 65535, /* TCP port numbers fit a word16 */
     PSEUDO_HDR_SZ      = 12,  /* TCP Pseudo Header size in bytes */
     FATAL_ERROR_STATE  =  1,  /* SnifferSession fatal error state */
     TICKET_HINT_LEN    = 4,   /* Session Ticket Hint length */
@@ -96,7 +107,11 @@ enum {
     MAX_INPUT_SZ       = MAX_RECORD_SIZE + COMP_EXTRA + MAX_MSG_EXTRA +
                          MTU_EXTRA,  /* Max input sz of reassembly */
     EXT_MASTER_SECRET  = 0x17, /* Extended Master Secret Extension ID */
-    TICKET_EXT_ID      = 0x23 /* Session Ticket Extension ID */
+    TICKET_EXT_ID      = 0x23, /* Session Ticket Extension ID */
+    PRE_SHARED_KEY_EXT_ID = 0x29, /* Pre-Shared Key Extension ID */
+    SUPPORTED_VERSIONS_EXT_ID = 0x2b, /* Supported Versions Extension ID */
+    KEY_LOG_HASH_SIZE  = 64,  /* Key Log Table Rows */
+    KEY_LOG_LINE_SZ    = 256  /* Key Log File line length, max */
 };
 
 
@@ -275,7 +290,15 @@ static const char* const msgTable[] =
     /* 91 */
     "No data destination Error",
     "Store data callback failed",
-    "Loading chain input"
+    "Loading chain input",
+    "Session Table Size Failure, zero or set after init",
+    "Session Secret Not Available",
+
+    /* 96 */
+    "Key Log File Load Error",
+    "Got Encrypted Extensions",
+    "Got Key Update",
+    "Got Hello Retry Request"
 };
 
 
@@ -324,6 +347,16 @@ typedef struct NamedKey {
 #endif
 
 
+/* Key Log entry holds a secret for the session with the client random */
+typedef struct KeyLogEntry {
+    byte                clientRandom[RAN_LEN];   /* session lookup key */
+    byte                secret[SECRET_LEN];      /* the secret itself */
+    word32              secretSz;                /* size of secret */
+    int                 secretType;              /* SNIFFER_SECRET_* */
+    struct KeyLogEntry* next;                    /* for hash table list */
+} KeyLogEntry;
+
+
 typedef struct IpAddrInfo {
     int version;
     union {
@@ -344,6 +377,7 @@ typedef struct SnifferServer {
     wolfSSL_Mutex  namedKeysMutex;               /* mutex for namedKey list */
 #endif
     struct SnifferServer* next;                  /* for list */
+    struct SnifferServer* hashNext;              /* for address hash row */
 } SnifferServer;
 
 
@@ -361,6 +395,7 @@ typedef struct Flags {
     byte           srvAckFault;     /* server acked unseen data from client */
     byte           cliSkipPartial;  /* client skips partial data to catch up */
     byte           srvSkipPartial;  /* server skips partial data to catch up */
+    byte           ephemeral;       /* server sent its key exchange */
 #ifdef HAVE_EXTENDED_MASTER
     byte           expectEms;       /* expect extended master secret */
 #endif
@@ -426,15 +461,27 @@ typedef struct SnifferSession {
 } SnifferSession;
 
 
-/* Sniffer Server List and mutex */
+/* Sniffer Server List, address hash of it, registered ports, and lock,
+ * servers are only added while configuring so packets take a read lock */
 static WOLFSSL_GLOBAL SnifferServer* ServerList = 0;
-static WOLFSSL_GLOBAL wolfSSL_Mutex ServerListMutex;
+static WOLFSSL_GLOBAL SnifferServer* ServerTable[SERVER_HASH_SIZE];
+static WOLFSSL_GLOBAL byte ServerPorts[(MAX_PORT_NUMBER + 1) / 8];
+static WOLFSSL_GLOBAL wolfSSL_RwLock ServerListLock;
 
 
-/* Session Hash Table, mutex, and count */
-static WOLFSSL_GLOBAL SnifferSession* SessionTable[HASH_SIZE];
-static WOLFSSL_GLOBAL wolfSSL_Mutex SessionMutex;
-static WOLFSSL_GLOBAL int SessionCount = 0;
+/* Session Hash Table shard, guards its rows and counts the sessions added
+ * to them for finding stale ones */
+typedef struct SessionShard {
+    wolfSSL_Mutex mutex;
+    word32        added;
+} SessionShard;
+
+/* Session Hash Table and its shards, the table is sized once by
+ * ssl_InitSniffer() so lookups can hash without a lock */
+static WOLFSSL_GLOBAL SnifferSession** SessionTable = NULL;
+static WOLFSSL_GLOBAL word32 SessionTableSz = 0;
+static WOLFSSL_GLOBAL word32 SessionTableRows = WOLFSSL_SNIFFER_HASH_SIZE;
+static WOLFSSL_GLOBAL SessionShard SessionShards[WOLFSSL_SNIFFER_SHARDS];
 
 /* Recovery of missed data switches and stats */
 static WOLFSSL_GLOBAL wolfSSL_Mutex RecoveryMutex; /* for stats */
@@ -465,6 +512,13 @@ static WOLFSSL_GLOBAL void* WatchCbCtx = NULL;
 static WOLFSSL_GLOBAL SSLStoreDataCb StoreDataCb;
 #endif
 
+/* Secret Callback for ephemeral key exchanges and TLS v1.3, and the Key Log
+ * entries it looks up when set by ssl_LoadKeyLogFile() */
+static WOLFSSL_GLOBAL SSLSecretCb SecretCb;
+static WOLFSSL_GLOBAL void* SecretCbCtx = NULL;
+static WOLFSSL_GLOBAL KeyLogEntry* KeyLogTable[KEY_LOG_HASH_SIZE];
+static WOLFSSL_GLOBAL wolfSSL_Mutex KeyLogMutex;
+
 
 static void UpdateMissedDataSessions(void)
 {
@@ -494,10 +548,23 @@ static void UpdateMissedDataSessions(void)
 /* Initialize overall Sniffer */
 void ssl_InitSniffer(void)
 {
+    int i;
+
     wolfSSL_Init();
-    wc_InitMutex(&ServerListMutex);
-    wc_InitMutex(&SessionMutex);
+    wc_InitRwLock(&ServerListLock);
+    for (i = 0; i < WOLFSSL_SNIFFER_SHARDS; i++) {
+        wc_InitMutex(&SessionShards[i].mutex);
+        SessionShards[i].added = 0;
+    }
+    SessionTable = (SnifferSession**)XMALLOC(
+            sizeof(SnifferSession*) * SessionTableRows, NULL,
+            DYNAMIC_TYPE_SNIFFER_SESSION);
+    if (SessionTable != NULL) {
+        XMEMSET(SessionTable, 0, sizeof(SnifferSession*) * SessionTableRows);
+        SessionTableSz = SessionTableRows;
+    }
     wc_InitMutex(&RecoveryMutex);
+    wc_InitMutex(&KeyLogMutex);
 #ifdef WOLFSSL_SNIFFER_STATS
     XMEMSET(&SnifferStats, 0, sizeof(SSLStats));
     wc_InitMutex(&StatsMutex);
@@ -609,6 +676,26 @@ static void FreeSnifferSession(SnifferSession* session)
 }
 
 
+/* Free Key Log Table entries and zero out the secrets they hold */
+static void FreeKeyLogTable(void)
+{
+    KeyLogEntry* entry;
+    KeyLogEntry* next;
+    word32 i;
+
+    for (i = 0; i < KEY_LOG_HASH_SIZE; i++) {
+        entry = KeyLogTable[i];
+        while (entry) {
+            next = entry->next;
+            ForceZero(entry, sizeof(KeyLogEntry));
+            XFREE(entry, NULL, DYNAMIC_TYPE_SNIFFER_KEY_LOG);
+            entry = next;
+        }
+        KeyLogTable[i] = NULL;
+    }
+}
+
+
 /* Free overall Sniffer */
 void ssl_FreeSniffer(void)
 {
@@ -616,10 +703,11 @@ void ssl_FreeSniffer(void)
     SnifferServer*  removeServer;
     SnifferSession* session;
     SnifferSession* removeSession;
-    int i;
+    word32 i;
 
-    wc_LockMutex(&ServerListMutex);
-    wc_LockMutex(&SessionMutex);
+    wc_LockRwLock_Wr(&ServerListLock);
+    for (i = 0; i < WOLFSSL_SNIFFER_SHARDS; i++)
+        wc_LockMutex(&SessionShards[i].mutex);
 
     srv = ServerList;
     while (srv) {
@@ -627,8 +715,11 @@ void ssl_FreeSniffer(void)
         srv = srv->next;
         FreeSnifferServer(removeServer);
     }
+    ServerList = NULL;
+    XMEMSET(ServerTable, 0, sizeof(ServerTable));
+    XMEMSET(ServerPorts, 0, sizeof(ServerPorts));
 
-    for (i = 0; i < HASH_SIZE; i++) {
+    for (i = 0; i < SessionTableSz; i++) {
         session = SessionTable[i];
         while (session) {
             removeSession = session;
@@ -636,13 +727,25 @@ void ssl_FreeSniffer(void)
             FreeSnifferSession(removeSession);
         }
     }
+    XFREE(SessionTable, NULL, DYNAMIC_TYPE_SNIFFER_SESSION);
+    SessionTable = NULL;
+    SessionTableSz = 0;
 
-    wc_UnLockMutex(&SessionMutex);
-    wc_UnLockMutex(&ServerListMutex);
+    for (i = 0; i < WOLFSSL_SNIFFER_SHARDS; i++) {
+        wc_UnLockMutex(&SessionShards[i].mutex);
+        wc_FreeMutex(&SessionShards[i].mutex);
+    }
+    wc_UnLockRwLock(&ServerListLock);
 
     wc_FreeMutex(&RecoveryMutex);
-    wc_FreeMutex(&SessionMutex);
-    wc_FreeMutex(&ServerListMutex);
+    wc_FreeRwLock(&ServerListLock);
+
+    wc_LockMutex(&KeyLogMutex);
+    FreeKeyLogTable();
+    wc_UnLockMutex(&KeyLogMutex);
+    wc_FreeMutex(&KeyLogMutex);
+    SecretCb = NULL;
+    SecretCbCtx = NULL;
 
 #ifdef WOLF_CRYPTO_CB
 #ifdef HAVE_INTEL_QA_SYNC
@@ -726,24 +829,39 @@ static int HashUpdate(HsHashes* hash, const byte* input, int sz)
 }
 
 
-static int HashCopy(HS_Hashes* d, HsHashes* s)
+/* Take over the EMS session hash, nothing buffered is replayed after this */
+static int HashCopy(WOLFSSL* ssl, HsHashes* s)
 {
+    HS_Hashes* d = ssl->hsHashes;
+
 #ifndef NO_OLD_TLS
 #ifndef NO_SHA
         XMEMCPY(&d->hashSha, &s->hashSha, sizeof(wc_Sha));
+        d->hashMask |= HS_HASH_SHA;
 #endif
 #ifndef NO_MD5
         XMEMCPY(&d->hashMd5, &s->hashMd5, sizeof(wc_Md5));
+        d->hashMask |= HS_HASH_MD5;
 #endif
 #endif
 
 #ifndef NO_SHA256
         XMEMCPY(&d->hashSha256, &s->hashSha256, sizeof(wc_Sha256));
+        d->hashMask |= HS_HASH_SHA256;
 #endif
 #ifdef WOLFSSL_SHA384
         XMEMCPY(&d->hashSha384, &s->hashSha384, sizeof(wc_Sha384));
+        d->hashMask |= HS_HASH_SHA384;
 #endif
 
+    if (d->rawMsgs != NULL) {
+        XFREE(d->rawMsgs, ssl->heap, DYNAMIC_TYPE_HASHES);
+        d->rawMsgs = NULL;
+    }
+    d->rawLen = 0;
+    d->rawSz = 0;
+    d->buffering = 0;
+
     return 0;
 }
 
@@ -1172,53 +1290,104 @@ static WC_INLINE int MatchAddr(IpAddrInfo l, IpAddrInfo r)
 }
 
 
+/* Hash a server address, return ServerTable row */
+static WC_INLINE word32 ServerHash(IpAddrInfo* addr)
+{
+    word32 hash = 0;
+
+    if (addr->version == IPV4) {
+        hash = addr->ip4;
+    }
+    else if (addr->version == IPV6) {
+        word32* x = (word32*)addr->ip6;
+        hash = x[0] ^ x[1] ^ x[2] ^ x[3];
+    }
+    hash ^= hash >> 16;
+
+    return hash % SERVER_HASH_SIZE;
+}
+
+
+/* Find registered server by address and port, caller holds ServerListLock */
+static SnifferServer* FindSnifferServer(IpAddrInfo* addr, int port)
+{
+    SnifferServer* sniffer = ServerTable[ServerHash(addr)];
+
+    while (sniffer != NULL &&
+            (sniffer->port != port || !MatchAddr(sniffer->server, *addr))) {
+        sniffer = sniffer->hashNext;
+    }
+
+    return sniffer;
+}
+
+
+/* Add new server to list and lookup tables, caller holds ServerListLock */
+static void AddSnifferServer(SnifferServer* sniffer)
+{
+    word32 row = ServerHash(&sniffer->server);
+
+    sniffer->next = ServerList;
+    ServerList = sniffer;
+    sniffer->hashNext = ServerTable[row];
+    ServerTable[row] = sniffer;
+    if (sniffer->port >= 0 && sniffer->port <= MAX_PORT_NUMBER)
+        ServerPorts[sniffer->port / 8] |= (byte)(1 << (sniffer->port % 8));
+}
+
+
 #ifndef WOLFSSL_SNIFFER_WATCH
 
-/* See if this IPV4 network order address has been registered */
+/* See if this address has been registered, any port */
+/* caller holds ServerListLock */
 /* return 1 is true, 0 is false */
-static int IsServerRegistered(word32 addr)
+static int IsServerAddrRegistered(IpAddrInfo* addr)
 {
-    int ret = 0;     /* false */
-    SnifferServer* sniffer;
+    SnifferServer* sniffer = ServerTable[ServerHash(addr)];
 
-    wc_LockMutex(&ServerListMutex);
-
-    sniffer = ServerList;
     while (sniffer) {
-        if (sniffer->server.ip4 == addr) {
-            ret = 1;
-            break;
-        }
-        sniffer = sniffer->next;
+        if (MatchAddr(sniffer->server, *addr))
+            return 1;
+        sniffer = sniffer->hashNext;
     }
 
-    wc_UnLockMutex(&ServerListMutex);
+    return 0;
+}
+
+
+/* See if this IPV4 network order address has been registered */
+/* return 1 is true, 0 is false */
+static int IsServerRegistered(word32 addr)
+{
+    int ret;
+    IpAddrInfo ip;
+
+    XMEMSET(&ip, 0, sizeof(ip));
+    ip.version = IPV4;
+    ip.ip4 = addr;
+
+    wc_LockRwLock_Rd(&ServerListLock);
+    ret = IsServerAddrRegistered(&ip);
+    wc_UnLockRwLock(&ServerListLock);
 
     return ret;
 }
 
 
-/* See if this port has been registered to watch */
-/* See if this IPV4 network order address has been registered */
+/* See if this IPV6 network order address has been registered */
 /* return 1 is true, 0 is false */
 static int IsServerRegistered6(byte* addr)
 {
-    int ret = 0;     /* false */
-    SnifferServer* sniffer;
-
-    wc_LockMutex(&ServerListMutex);
+    int ret;
+    IpAddrInfo ip;
 
-    sniffer = ServerList;
-    while (sniffer) {
-        if (sniffer->server.version == IPV6 &&
-                0 == XMEMCMP(sniffer->server.ip6, addr, sizeof(sniffer->server.ip6))) {
-            ret = 1;
-            break;
-        }
-        sniffer = sniffer->next;
-    }
+    XMEMSET(&ip, 0, sizeof(ip));
+    ip.version = IPV6;
+    XMEMCPY(ip.ip6, addr, sizeof(ip.ip6));
 
-    wc_UnLockMutex(&ServerListMutex);
+    wc_LockRwLock_Rd(&ServerListLock);
+    ret = IsServerAddrRegistered(&ip);
+    wc_UnLockRwLock(&ServerListLock);
 
     return ret;
 }
@@ -1229,20 +1398,14 @@ static int IsServerRegistered6(byte* addr)
 static int IsPortRegistered(word32 port)
 {
     int ret = 0;    /* false */
-    SnifferServer* sniffer;
 
-    wc_LockMutex(&ServerListMutex);
-
-    sniffer = ServerList;
-    while (sniffer) {
-        if (sniffer->port == (int)port) {
-            ret = 1;
-            break;
-        }
-        sniffer = sniffer->next;
-    }
+    if (port > MAX_PORT_NUMBER)
+        return 0;
 
-    wc_UnLockMutex(&ServerListMutex);
+    wc_LockRwLock_Rd(&ServerListLock);
+    if (ServerPorts[port / 8] & (1 << (port % 8)))
+        ret = 1;
+    wc_UnLockRwLock(&ServerListLock);
 
     return ret;
 }
@@ -1255,27 +1418,19 @@ static SnifferServer* GetSnifferServer(IpInfo* ipInfo, TcpInfo* tcpInfo)
 {
     SnifferServer* sniffer;
 
-    wc_LockMutex(&ServerListMutex);
-
-    sniffer = ServerList;
+    wc_LockRwLock_Rd(&ServerListLock);
 
 #ifndef WOLFSSL_SNIFFER_WATCH
-    while (sniffer) {
-        if (sniffer->port == tcpInfo->srcPort &&
-                MatchAddr(sniffer->server, ipInfo->src))
-            break;
-        if (sniffer->port == tcpInfo->dstPort &&
-                MatchAddr(sniffer->server, ipInfo->dst))
-            break;
-
-        sniffer = sniffer->next;
-    }
+    sniffer = FindSnifferServer(&ipInfo->src, tcpInfo->srcPort);
+    if (sniffer == NULL)
+        sniffer = FindSnifferServer(&ipInfo->dst, tcpInfo->dstPort);
 #else
+    sniffer = ServerList;
     (void)ipInfo;
     (void)tcpInfo;
 #endif
 
-    wc_UnLockMutex(&ServerListMutex);
+    wc_UnLockRwLock(&ServerListLock);
 
     return sniffer;
 }
@@ -1301,7 +1456,20 @@ static word32 SessionHash(IpInfo* ipInfo, TcpInfo* tcpInfo)
     }
     hash *= tcpInfo->srcPort * tcpInfo->dstPort;
 
-    return hash % HASH_SIZE;
+    /* mix high bits down, the product is symmetric so both directions of a
+     * connection still land on the same row */
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3b;
+    hash ^= hash >> 16;
+
+    return hash % SessionTableSz;
+}
+
+
+/* Get the shard guarding a Session Hash Table row */
+static WC_INLINE SessionShard* GetSessionShard(word32 row)
+{
+    return &SessionShards[row % WOLFSSL_SNIFFER_SHARDS];
 }
 
 
@@ -1310,11 +1478,17 @@ static SnifferSession* GetSnifferSession(IpInfo* ipInfo, TcpInfo* tcpInfo)
 {
     SnifferSession* session;
     time_t          currTime = time(NULL);
-    word32          row = SessionHash(ipInfo, tcpInfo);
+    word32          row;
+    SessionShard*   shard;
+
+    if (SessionTable == NULL)
+        return NULL;
 
-    assert(row <= HASH_SIZE);
+    row = SessionHash(ipInfo, tcpInfo);
+    assert(row < SessionTableSz);
+    shard = GetSessionShard(row);
 
-    wc_LockMutex(&SessionMutex);
+    wc_LockMutex(&shard->mutex);
 
     session = SessionTable[row];
     while (session) {
@@ -1336,7 +1510,7 @@ static SnifferSession* GetSnifferSession(IpInfo* ipInfo, TcpInfo* tcpInfo)
     if (session)
         session->lastUsed= currTime; /* keep session alive, remove stale will */
                                      /* leave alone */
-    wc_UnLockMutex(&SessionMutex);
+    wc_UnLockMutex(&shard->mutex);
 
     /* determine side */
     if (session) {
@@ -1459,7 +1633,7 @@ static int CreateWatchSnifferServer(char* error)
     if (CryptoDeviceId != INVALID_DEVID)
 	    wolfSSL_CTX_SetDevId(sniffer->ctx, CryptoDeviceId);
 #endif
-    ServerList = sniffer;
+    AddSnifferServer(sniffer);
 
     return 0;
 }
@@ -1467,6 +1641,50 @@ static int CreateWatchSnifferServer(char* error)
 #endif
 
 
+/* Get the network order address of a passed in server address */
+static void GetServerAddress(const char* address, IpAddrInfo* serverIp)
+{
+    serverIp->version = IPV4;
+    serverIp->ip4 = inet_addr(address);
+    if (serverIp->ip4 == INADDR_NONE) {
+        if (inet_pton(AF_INET6, address, serverIp->ip6) == 1) {
+            serverIp->version = IPV6;
+        }
+    }
+}
+
+
+/* Create a new Sniffer Server for address and port, caller adds it */
+/* returns the server on success, NULL on error */
+static SnifferServer* CreateSnifferServer(const char* address, int port,
+                                          IpAddrInfo* serverIp, char* error)
+{
+    SnifferServer* sniffer;
+
+    sniffer = (SnifferServer*)XMALLOC(sizeof(SnifferServer),
+            NULL, DYNAMIC_TYPE_SNIFFER_SERVER);
+    if (sniffer == NULL) {
+        SetError(MEMORY_STR, error, NULL, 0);
+        return NULL;
+    }
+    InitSnifferServer(sniffer);
+
+    XSTRNCPY(sniffer->address, address, MAX_SERVER_ADDRESS-1);
+    sniffer->address[MAX_SERVER_ADDRESS-1] = '\0';
+    sniffer->server = *serverIp;
+    sniffer->port = port;
+
+    sniffer->ctx = SSL_CTX_new(TLSv1_2_client_method());
+    if (!sniffer->ctx) {
+        SetError(MEMORY_STR, error, NULL, 0);
+        FreeSnifferServer(sniffer);
+        return NULL;
+    }
+
+    return sniffer;
+}
+
+
 static int SetNamedPrivateKey(const char* name, const char* address, int port,
             const char* keyFile, int typeKey, const char* password, char* error)
 {
@@ -1508,44 +1726,16 @@ static int SetNamedPrivateKey(const char* name, const char* address, int port,
     }
 #endif
 
-    serverIp.version = IPV4;
-    serverIp.ip4 = inet_addr(address);
-    if (serverIp.ip4 == INADDR_NONE) {
-        if (inet_pton(AF_INET6, address, serverIp.ip6) == 1) {
-            serverIp.version = IPV6;
-        }
-    }
-    sniffer = ServerList;
-    while (sniffer != NULL &&
-            (!MatchAddr(sniffer->server, serverIp) || sniffer->port != port)) {
-        sniffer = sniffer->next;
-    }
+    GetServerAddress(address, &serverIp);
+    sniffer = FindSnifferServer(&serverIp, port);
 
     if (sniffer == NULL) {
         isNew = 1;
-        sniffer = (SnifferServer*)XMALLOC(sizeof(SnifferServer),
-                NULL, DYNAMIC_TYPE_SNIFFER_SERVER);
+        sniffer = CreateSnifferServer(address, port, &serverIp, error);
         if (sniffer == NULL) {
-            SetError(MEMORY_STR, error, NULL, 0);
-#ifdef HAVE_SNI
-            FreeNamedKey(namedKey);
-#endif
-            return -1;
-        }
-        InitSnifferServer(sniffer);
-
-        XSTRNCPY(sniffer->address, address, MAX_SERVER_ADDRESS-1);
-        sniffer->address[MAX_SERVER_ADDRESS-1] = '\0';
-        sniffer->server = serverIp;
-        sniffer->port = port;
-
-        sniffer->ctx = SSL_CTX_new(TLSv1_2_client_method());
-        if (!sniffer->ctx) {
-            SetError(MEMORY_STR, error, NULL, 0);
 #ifdef HAVE_SNI
             FreeNamedKey(namedKey);
 #endif
-            FreeSnifferServer(sniffer);
             return -1;
         }
     }
@@ -1578,10 +1768,8 @@ static int SetNamedPrivateKey(const char* name, const char* address, int port,
     }
 #endif
 
-    if (isNew) {
-        sniffer->next = ServerList;
-        ServerList = sniffer;
-    }
+    if (isNew)
+        AddSnifferServer(sniffer);
 
     return 0;
 }
@@ -1601,10 +1789,10 @@ int ssl_SetNamedPrivateKey(const char* name,
     TraceHeader();
     TraceSetNamedServer(name, address, port, keyFile);
 
-    wc_LockMutex(&ServerListMutex);
+    wc_LockRwLock_Wr(&ServerListLock);
     ret = SetNamedPrivateKey(name, address, port, keyFile,
                              typeKey, password, error);
-    wc_UnLockMutex(&ServerListMutex);
+    wc_UnLockRwLock(&ServerListLock);
 
     if (ret == 0)
         Trace(NEW_SERVER_STR);
@@ -1625,10 +1813,10 @@ int ssl_SetPrivateKey(const char* address, int port, const char* keyFile,
     TraceHeader();
     TraceSetServer(address, port, keyFile);
 
-    wc_LockMutex(&ServerListMutex);
+    wc_LockRwLock_Wr(&ServerListLock);
     ret = SetNamedPrivateKey(NULL, address, port, keyFile,
                              typeKey, password, error);
-    wc_UnLockMutex(&ServerListMutex);
+    wc_UnLockRwLock(&ServerListLock);
 
     if (ret == 0)
         Trace(NEW_SERVER_STR);
@@ -1826,6 +2014,232 @@ static void CallConnectionCb(SnifferSession* session)
 }
 
 
+/* Get a secret of secretType for the session from the secret callback */
+/* returns the size of the secret on success, -1 on error */
+static int GetSessionSecret(SnifferSession* session, int secretType,
+                            byte* secret)
+{
+    const byte* clientRandom;
+    word32      secretSz = SECRET_LEN;
+
+    if (SecretCb == NULL)
+        return -1;
+
+    /* each side frees its arrays when the other side's Finished is done */
+    if (session->sslServer->arrays != NULL)
+        clientRandom = session->sslServer->arrays->clientRandom;
+    else if (session->sslClient->arrays != NULL)
+        clientRandom = session->sslClient->arrays->clientRandom;
+    else
+        return -1;
+
+    if (SecretCb(clientRandom, secretType, secret, &secretSz,
+                 SecretCbCtx) != 0 || secretSz == 0 || secretSz > SECRET_LEN)
+        return -1;
+
+    return (int)secretSz;
+}
+
+
+/* Get the master secret for a TLS v1.2 or older session from the secret
+ * callback, for ephemeral key exchanges and resumptions we didn't see */
+/* returns 0 on success, -1 when not available */
+static int GetMasterSecret(SnifferSession* session)
+{
+    if (GetSessionSecret(session, SNIFFER_SECRET_TLS12_MASTER_SECRET,
+                    session->sslServer->arrays->masterSecret) != SECRET_LEN)
+        return -1;
+
+    /* make sure client has master secret too */
+    XMEMCPY(session->sslClient->arrays->masterSecret,
+            session->sslServer->arrays->masterSecret, SECRET_LEN);
+
+    return 0;
+}
+
+
+/* Derive and set the keys of both sides from the master secret */
+/* returns 0 on success, -1 on error */
+static int DeriveSessionKeys(SnifferSession* session, char* error)
+{
+    int ret;
+
+    if (SetCipherSpecs(session->sslServer) != 0) {
+        SetError(BAD_CIPHER_SPEC_STR, error, session, FATAL_ERROR_STATE);
+        return -1;
+    }
+
+    if (SetCipherSpecs(session->sslClient) != 0) {
+        SetError(BAD_CIPHER_SPEC_STR, error, session, FATAL_ERROR_STATE);
+        return -1;
+    }
+
+    if (session->sslServer->options.tls) {
+        ret =  DeriveTlsKeys(session->sslServer);
+        ret += DeriveTlsKeys(session->sslClient);
+    }
+    else {
+        ret =  DeriveKeys(session->sslServer);
+        ret += DeriveKeys(session->sslClient);
+    }
+    ret += SetKeysSide(session->sslServer, ENCRYPT_AND_DECRYPT_SIDE);
+    ret += SetKeysSide(session->sslClient, ENCRYPT_AND_DECRYPT_SIDE);
+
+    if (ret != 0) {
+        SetError(BAD_DERIVE_STR, error, session, FATAL_ERROR_STATE);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+#ifdef WOLFSSL_TLS13
+
+/* ServerHello random of a HelloRetryRequest, RFC 8446 4.1.3 */
+static const byte helloRetryRandom[RAN_LEN] = {
+    0xCF, 0x21, 0xAD, 0x74, 0xE5, 0x9A, 0x61, 0x11,
+    0xBE, 0x1D, 0x8C, 0x02, 0x1E, 0x65, 0xB8, 0x91,
+    0xC2, 0xA2, 0x11, 0x16, 0x7A, 0xBB, 0x8C, 0x5E,
+    0x07, 0x9E, 0x09, 0xE2, 0xC8, 0xA8, 0x33, 0x9C
+};
+
+
+/* Get the TLS v1.3 traffic secret of secretType into ssl */
+/* returns 0 on success, -1 on error */
+static int GetTls13Secret(SnifferSession* session, SSL* ssl, int secretType)
+{
+    byte* secret = ssl->serverSecret;
+
+    if (secretType == SNIFFER_SECRET_CLIENT_HANDSHAKE_TRAFFIC_SECRET ||
+        secretType == SNIFFER_SECRET_CLIENT_TRAFFIC_SECRET)
+        secret = ssl->clientSecret;
+
+    /* secrets are the size of the cipher suite's hash */
+    if (GetSessionSecret(session, secretType, secret) != ssl->specs.hash_size)
+        return -1;
+
+    return 0;
+}
+
+
+/* Set up both sides of a TLS v1.3 session with its handshake traffic keys,
+ * the secrets come from the secret callback and the keys from the TLS v1.3
+ * key schedule */
+/* returns 0 on success, -1 on error */
+static int SetupTls13HandshakeKeys(SnifferSession* session, int resuming,
+                                   char* error)
+{
+    int ret;
+
+    if (SecretCb == NULL) {
+#ifdef WOLFSSL_SNIFFER_STATS
+        INC_STAT(SnifferStats.sslEphemeralMisses);
+#endif
+        SetError(SECRET_MISSING_STR, error, session, FATAL_ERROR_STATE);
+        return -1;
+    }
+
+    if (SetCipherSpecs(session->sslServer) != 0) {
+        SetError(BAD_CIPHER_SPEC_STR, error, session, FATAL_ERROR_STATE);
+        return -1;
+    }
+
+    if (SetCipherSpecs(session->sslClient) != 0) {
+        SetError(BAD_CIPHER_SPEC_STR, error, session, FATAL_ERROR_STATE);
+        return -1;
+    }
+
+    if (GetTls13Secret(session, session->sslServer,
+                SNIFFER_SECRET_CLIENT_HANDSHAKE_TRAFFIC_SECRET) != 0 ||
+        GetTls13Secret(session, session->sslServer,
+                SNIFFER_SECRET_SERVER_HANDSHAKE_TRAFFIC_SECRET) != 0) {
+#ifdef WOLFSSL_SNIFFER_STATS
+        INC_STAT(SnifferStats.sslKeyFails);
+#endif
+        SetError(SECRET_MISSING_STR, error, session, FATAL_ERROR_STATE);
+        return -1;
+    }
+
+    /* store for client side as well */
+    XMEMCPY(session->sslClient->clientSecret, session->sslServer->clientSecret,
+            SECRET_LEN);
+    XMEMCPY(session->sslClient->serverSecret, session->sslServer->serverSecret,
+            SECRET_LEN);
+
+    ret  = DeriveTls13Keys(session->sslServer, no_key,
+                           ENCRYPT_AND_DECRYPT_SIDE, 1);
+    ret += DeriveTls13Keys(session->sslClient, no_key,
+                           ENCRYPT_AND_DECRYPT_SIDE, 1);
+    ret += SetKeysSide(session->sslServer, ENCRYPT_AND_DECRYPT_SIDE);
+    ret += SetKeysSide(session->sslClient, ENCRYPT_AND_DECRYPT_SIDE);
+
+    if (ret != 0) {
+        SetError(BAD_DERIVE_STR, error, session, FATAL_ERROR_STATE);
+        return -1;
+    }
+
+    /* everything after the ServerHello is encrypted */
+    session->flags.serverCipherOn = 1;
+    session->flags.clientCipherOn = 1;
+    session->flags.resuming = (byte)resuming;
+
+#ifdef WOLFSSL_SNIFFER_STATS
+    if (resuming)
+        INC_STAT(SnifferStats.sslResumedConns);
+    else
+        INC_STAT(SnifferStats.sslStandardConns);
+#endif
+
+    CallConnectionCb(session);
+
+    return 0;
+}
+
+
+/* Switch the sending side of a TLS v1.3 session to its application traffic
+ * keys after its Finished, or to its next ones after a Key Update */
+/* returns 0 on success, -1 on error */
+static int UpdateTls13Keys(SnifferSession* session, int secret, char* error)
+{
+    SSL* ssl;
+    int  secretType;
+    int  ret;
+
+    if (session->flags.side == WOLFSSL_SERVER_END) {
+        ssl = session->sslServer;
+        secretType = SNIFFER_SECRET_CLIENT_TRAFFIC_SECRET;
+    }
+    else {
+        ssl = session->sslClient;
+        secretType = SNIFFER_SECRET_SERVER_TRAFFIC_SECRET;
+    }
+
+    if (secret == traffic_key) {
+        if (GetTls13Secret(session, ssl, secretType) != 0) {
+#ifdef WOLFSSL_SNIFFER_STATS
+            INC_STAT(SnifferStats.sslKeyFails);
+#endif
+            SetError(SECRET_MISSING_STR, error, session, FATAL_ERROR_STATE);
+            return -1;
+        }
+        secret = no_key;    /* have it, just derive the keys */
+    }
+
+    ret = DeriveTls13Keys(ssl, secret, DECRYPT_SIDE_ONLY, 1);
+    if (ret == 0)
+        ret = SetKeysSide(ssl, DECRYPT_SIDE_ONLY);
+    if (ret != 0) {
+        SetError(BAD_DERIVE_STR, error, session, FATAL_ERROR_STATE);
+        return -1;
+    }
+
+    return 0;
+}
+
+#endif /* WOLFSSL_TLS13 */
+
+
 /* Process Client Key Exchange, RSA or static ECDH */
 static int ProcessClientKeyExchange(const byte* input, int* sslBytes,
                                     SnifferSession* session, char* error)
@@ -1834,6 +2248,22 @@ static int ProcessClientKeyExchange(const byte* input, int* sslBytes,
     int tryEcc = 0;
     int ret;
 
+    if (GetMasterSecret(session) == 0) {
+        /* secret callback knows the session, no need to decrypt */
+        ret = DeriveSessionKeys(session, error);
+        if (ret == 0)
+            CallConnectionCb(session);
+        return ret;
+    }
+
+    if (session->flags.ephemeral) {
+#ifdef WOLFSSL_SNIFFER_STATS
+        INC_STAT(SnifferStats.sslEphemeralMisses);
+#endif
+        SetError(SECRET_MISSING_STR, error, session, FATAL_ERROR_STATE);
+        return -1;
+    }
+
     if (session->sslServer->buffers.key == NULL ||
         session->sslServer->buffers.key->buffer == NULL ||
         session->sslServer->buffers.key->length == 0) {
@@ -2168,12 +2598,11 @@ static int ProcessServerHello(int msgSz, const byte* input, int* sslBytes,
         return -1;
     }
 
-#ifdef HAVE_EXTENDED_MASTER
     /* extensions */
     if ((initialBytes - *sslBytes) < msgSz) {
         word16 len;
 
-        /* skip extensions until extended master secret */
+        /* skip extensions we don't need */
         /* make sure can read len */
         if (SUITE_LEN > *sslBytes) {
             SetError(SERVER_HELLO_INPUT_STR, error, session, FATAL_ERROR_STATE);
@@ -2208,9 +2637,21 @@ static int ProcessServerHello(int msgSz, const byte* input, int* sslBytes,
                 return -1;
             }
 
+#ifdef HAVE_EXTENDED_MASTER
             if (extType[0] == 0x00 && extType[1] == EXT_MASTER_SECRET) {
                 session->flags.expectEms = 1;
             }
+#endif
+#ifdef WOLFSSL_TLS13
+            /* negotiated version and whether the PSK was accepted */
+            if (extType[0] == 0x00 && extType[1] == SUPPORTED_VERSIONS_EXT_ID
+                                   && extLen == VERSION_SZ) {
+                XMEMCPY(&pv, input, VERSION_SZ);
+            }
+            if (extType[0] == 0x00 && extType[1] == PRE_SHARED_KEY_EXT_ID) {
+                doResume = 1;
+            }
+#endif
 
             input     += extLen;
             *sslBytes -= extLen;
@@ -2218,12 +2659,32 @@ static int ProcessServerHello(int msgSz, const byte* input, int* sslBytes,
         }
     }
 
+#ifdef HAVE_EXTENDED_MASTER
     if (!session->flags.expectEms) {
         XFREE(session->hash, NULL, DYNAMIC_TYPE_HASHES);
         session->hash = NULL;
     }
 #endif
 
+#ifdef WOLFSSL_TLS13
+    if (IsAtLeastTLSv1_3(pv)) {
+        session->sslServer->version = pv;
+        session->sslClient->version = pv;
+        session->sslServer->options.tls1_3 = 1;
+        session->sslClient->options.tls1_3 = 1;
+
+        if (XMEMCMP(session->sslServer->arrays->serverRandom,
+                    helloRetryRandom, RAN_LEN) == 0) {
+            /* wait for the second ClientHello and the real ServerHello */
+            Trace(GOT_HELLO_RETRY_STR);
+            return 0;
+        }
+
+        return SetupTls13HandshakeKeys(session, doResume, error);
+    }
+    doResume = 0;
+#endif
+
     if (session->sslServer->options.haveSessionId) {
         if (XMEMCMP(session->sslServer->arrays->sessionID,
                     session->sslClient->arrays->sessionID, ID_LEN) == 0)
@@ -2242,10 +2703,9 @@ static int ProcessServerHello(int msgSz, const byte* input, int* sslBytes,
     }
 
     if (doResume ) {
-        int ret = 0;
         SSL_SESSION* resume = GetSession(session->sslServer,
                                   session->sslServer->arrays->masterSecret, 0);
-        if (resume == NULL) {
+        if (resume == NULL && GetMasterSecret(session) != 0) {
 #ifdef WOLFSSL_SNIFFER_STATS
             INC_STAT(SnifferStats.sslResumeMisses);
 #endif
@@ -2260,33 +2720,11 @@ static int ProcessServerHello(int msgSz, const byte* input, int* sslBytes,
         Trace(SERVER_DID_RESUMPTION_STR);
 #ifdef WOLFSSL_SNIFFER_STATS
         INC_STAT(SnifferStats.sslResumedConns);
-        INC_STAT(SnifferStats.sslResumptionValid);
+        if (resume != NULL)
+            INC_STAT(SnifferStats.sslResumptionValid);
 #endif
-        if (SetCipherSpecs(session->sslServer) != 0) {
-            SetError(BAD_CIPHER_SPEC_STR, error, session, FATAL_ERROR_STATE);
-            return -1;
-        }
-
-        if (SetCipherSpecs(session->sslClient) != 0) {
-            SetError(BAD_CIPHER_SPEC_STR, error, session, FATAL_ERROR_STATE);
-            return -1;
-        }
-
-        if (session->sslServer->options.tls) {
-            ret =  DeriveTlsKeys(session->sslServer);
-            ret += DeriveTlsKeys(session->sslClient);
-        }
-        else {
-            ret =  DeriveKeys(session->sslServer);
-            ret += DeriveKeys(session->sslClient);
-        }
-        ret += SetKeysSide(session->sslServer, ENCRYPT_AND_DECRYPT_SIDE);
-        ret += SetKeysSide(session->sslClient, ENCRYPT_AND_DECRYPT_SIDE);
-
-        if (ret != 0) {
-            SetError(BAD_DERIVE_STR, error, session, FATAL_ERROR_STATE);
+        if (DeriveSessionKeys(session, error) != 0)
             return -1;
-        }
     }
     else {
 #ifdef WOLFSSL_SNIFFER_STATS
@@ -2518,6 +2956,9 @@ static int ProcessCertificate(const byte* input, int* sslBytes,
         return 0;
 
     if (WatchCb == NULL) {
+        /* the secret callback doesn't need the server's key */
+        if (SecretCb != NULL)
+            return 0;
         SetError(WATCH_CB_MISSING_STR, error, session, FATAL_ERROR_STATE);
         return -1;
     }
@@ -2589,26 +3030,41 @@ static int ProcessFinished(const byte* input, int size, int* sslBytes,
     else
         ssl = session->sslClient;
 
-    ret = DoFinished(ssl, input, &inOutIdx, (word32) size, (word32) *sslBytes,
-                                                                         SNIFF);
-    *sslBytes -= (int)inOutIdx;
+#ifdef WOLFSSL_TLS13
+    if (ssl->options.tls1_3) {
+        /* can't verify without the transcript hash, just switch keys */
+        ret = UpdateTls13Keys(session, traffic_key, error);
+        if (ret != 0)
+            return ret;
+        *sslBytes -= size;
 
-    if (ret < 0) {
-        SetError(BAD_FINISHED_MSG, error, session, FATAL_ERROR_STATE);
-        return ret;
+        ssl->options.handShakeState = HANDSHAKE_DONE;
+        ssl->options.handShakeDone  = 1;
     }
+    else
+#endif
+    {
+        ret = DoFinished(ssl, input, &inOutIdx, (word32) size,
+                         (word32) *sslBytes, SNIFF);
+        *sslBytes -= (int)inOutIdx;
+
+        if (ret < 0) {
+            SetError(BAD_FINISHED_MSG, error, session, FATAL_ERROR_STATE);
+            return ret;
+        }
 
-    if (ret == 0 && session->flags.cached == 0) {
-        if (session->sslServer->options.haveSessionId) {
-            WOLFSSL_SESSION* sess = GetSession(session->sslServer, NULL, 0);
-            if (sess == NULL) {
-                AddSession(session->sslServer);  /* don't re add */
+        if (ret == 0 && session->flags.cached == 0) {
+            if (session->sslServer->options.haveSessionId) {
+                WOLFSSL_SESSION* sess = GetSession(session->sslServer, NULL, 0);
+                if (sess == NULL) {
+                    AddSession(session->sslServer);  /* don't re add */
 #ifdef WOLFSSL_SNIFFER_STATS
-                INC_STAT(SnifferStats.sslResumptionInserts);
+                    INC_STAT(SnifferStats.sslResumptionInserts);
 #endif
-            }
-            session->flags.cached = 1;
-         }
+                }
+                session->flags.cached = 1;
+             }
+        }
     }
 
     /* If receiving a finished message from one side, free the resources
@@ -2648,9 +3104,11 @@ static int DoHandShake(const byte* input, int* sslBytes,
         return ret;
     }
 
-    /* A session's arrays are released when the handshake is completed. */
+    /* A session's arrays are released when the handshake is completed,
+     * TLS v1.3 has no renegotiation but does send post-handshake messages */
     if (session->sslServer->arrays == NULL &&
-        session->sslClient->arrays == NULL) {
+        session->sslClient->arrays == NULL &&
+        !session->sslServer->options.tls1_3) {
 
         SetError(NO_SECURE_RENEGOTIATION, error, session, FATAL_ERROR_STATE);
         return -1;
@@ -2675,7 +3133,9 @@ static int DoHandShake(const byte* input, int* sslBytes,
             break;
         case session_ticket:
             Trace(GOT_SESSION_TICKET_STR);
-            ret = ProcessSessionTicket(input, sslBytes, session, error);
+            /* TLS v1.3 tickets are only used with PSKs from the secrets */
+            if (!session->sslServer->options.tls1_3)
+                ret = ProcessSessionTicket(input, sslBytes, session, error);
             break;
         case server_hello:
             Trace(GOT_SERVER_HELLO_STR);
@@ -2685,10 +3145,15 @@ static int DoHandShake(const byte* input, int* sslBytes,
             Trace(GOT_CERT_REQ_STR);
             break;
         case server_key_exchange:
+            Trace(GOT_SERVER_KEY_EX_STR);
+            if (SecretCb != NULL) {
+                /* secret callback may know the master secret */
+                session->flags.ephemeral = 1;
+                break;
+            }
 #ifdef WOLFSSL_SNIFFER_STATS
             INC_STAT(SnifferStats.sslEphemeralMisses);
 #endif
-            Trace(GOT_SERVER_KEY_EX_STR);
             /* can't know temp key passively */
             SetError(BAD_CIPHER_SPEC_STR, error, session, FATAL_ERROR_STATE);
             ret = -1;
@@ -2701,7 +3166,8 @@ static int DoHandShake(const byte* input, int* sslBytes,
 #endif
             }
 #ifdef WOLFSSL_SNIFFER_WATCH
-            ret = ProcessCertificate(input, sslBytes, session, error);
+            if (!session->sslServer->options.tls1_3)
+                ret = ProcessCertificate(input, sslBytes, session, error);
 #endif
             break;
         case server_hello_done:
@@ -2719,10 +3185,8 @@ static int DoHandShake(const byte* input, int* sslBytes,
             Trace(GOT_CLIENT_KEY_EX_STR);
 #ifdef HAVE_EXTENDED_MASTER
             if (session->flags.expectEms && session->hash != NULL) {
-                if (HashCopy(session->sslServer->hsHashes,
-                             session->hash) == 0 &&
-                    HashCopy(session->sslClient->hsHashes,
-                             session->hash) == 0) {
+                if (HashCopy(session->sslServer, session->hash) == 0 &&
+                    HashCopy(session->sslClient, session->hash) == 0) {
 
                     session->sslServer->options.haveEMS = 1;
                     session->sslClient->options.haveEMS = 1;
@@ -2750,6 +3214,16 @@ static int DoHandShake(const byte* input, int* sslBytes,
         case certificate_status:
             Trace(GOT_CERT_STATUS_STR);
             break;
+#ifdef WOLFSSL_TLS13
+        case encrypted_extensions:
+            Trace(GOT_ENC_EXT_STR);
+            break;
+        case key_update:
+            Trace(GOT_KEY_UPDATE_STR);
+            if (session->sslServer->options.tls1_3)
+                ret = UpdateTls13Keys(session, update_traffic_key, error);
+            break;
+#endif
         default:
             SetError(GOT_UNKNOWN_HANDSHAKE_STR, error, session, 0);
             return -1;
@@ -2761,6 +3235,26 @@ static int DoHandShake(const byte* input, int* sslBytes,
 }
 
 
+#if defined(WOLFSSL_TLS13) || (defined(HAVE_CHACHA) && defined(HAVE_POLY1305))
+
+/* Build the nonce of records without an explicit IV, the implicit IV xor'd
+ * with the record sequence number */
+static void BuildSequenceNonce(SSL* ssl, byte* nonce)
+{
+    byte seq[SEQ_SZ];
+    int  i;
+
+    c32toa(ssl->keys.peer_sequence_number_hi, seq);
+    c32toa(ssl->keys.peer_sequence_number_lo, seq + OPAQUE32_LEN);
+
+    XMEMCPY(nonce, ssl->keys.aead_dec_imp_IV, AEAD_NONCE_SZ);
+    for (i = 0; i < SEQ_SZ; i++)
+        nonce[AEAD_NONCE_SZ - SEQ_SZ + i] ^= seq[i];
+}
+
+#endif
+
+
 /* Decrypt input into plain output, 0 on success */
 static int Decrypt(SSL* ssl, byte* output, const byte* input, word32 sz)
 {
@@ -2815,19 +3309,31 @@ static int Decrypt(SSL* ssl, byte* output, const byte* input, word32 sz)
 
         #ifdef HAVE_AESGCM
         case wolfssl_aes_gcm:
-            if (sz >= (word32)(AESGCM_EXP_IV_SZ + ssl->specs.aead_mac_size))
+        {
+            /* TLS v1.3 has no explicit IV */
+            word32 expIvSz = ssl->options.tls1_3 ? 0 : AESGCM_EXP_IV_SZ;
+
+            if (sz >= expIvSz + ssl->specs.aead_mac_size)
             {
                 /* scratch buffer, sniffer ignores auth tag*/
                 byte authTag[WOLFSSL_MIN_AUTH_TAG_SZ];
 
                 byte nonce[AESGCM_NONCE_SZ];
-                XMEMCPY(nonce, ssl->keys.aead_dec_imp_IV, AESGCM_IMP_IV_SZ);
-                XMEMCPY(nonce + AESGCM_IMP_IV_SZ, input, AESGCM_EXP_IV_SZ);
+            #ifdef WOLFSSL_TLS13
+                if (ssl->options.tls1_3)
+                    BuildSequenceNonce(ssl, nonce);
+                else
+            #endif
+                {
+                    XMEMCPY(nonce, ssl->keys.aead_dec_imp_IV,
+                            AESGCM_IMP_IV_SZ);
+                    XMEMCPY(nonce + AESGCM_IMP_IV_SZ, input, AESGCM_EXP_IV_SZ);
+                }
 
                 if (wc_AesGcmEncrypt(ssl->decrypt.aes,
                             output,
-                            input + AESGCM_EXP_IV_SZ,
-                            sz - AESGCM_EXP_IV_SZ - ssl->specs.aead_mac_size,
+                            input + expIvSz,
+                            sz - expIvSz - ssl->specs.aead_mac_size,
                             nonce, AESGCM_NONCE_SZ,
                             authTag, sizeof(authTag),
                             NULL, 0) < 0) {
@@ -2841,8 +3347,33 @@ static int Decrypt(SSL* ssl, byte* output, const byte* input, word32 sz)
                 ret = -1;
             }
             break;
+        }
          #endif
 
+        #if defined(HAVE_CHACHA) && defined(HAVE_POLY1305)
+        case wolfssl_chacha:
+            if (sz >= ssl->specs.aead_mac_size && !ssl->options.oldPoly) {
+                /* block 0 makes the poly1305 key, sniffer ignores auth tag */
+                byte nonce[CHACHA20_NONCE_SZ];
+                BuildSequenceNonce(ssl, nonce);
+
+                ret = wc_Chacha_SetIV(ssl->decrypt.chacha, nonce, 1);
+                if (ret == 0)
+                    ret = wc_Chacha_Process(ssl->decrypt.chacha, output, input,
+                                            sz - ssl->specs.aead_mac_size);
+                if (ret != 0) {
+                    Trace(BAD_DECRYPT);
+                    ret = -1;
+                }
+                ForceZero(nonce, CHACHA20_NONCE_SZ);
+            }
+            else {
+                Trace(BAD_DECRYPT_SIZE);
+                ret = -1;
+            }
+            break;
+        #endif
+
         #ifdef HAVE_NULL_CIPHER
         case wolfssl_cipher_null:
             XMEMCPY(output, input, sz);
@@ -2870,7 +3401,17 @@ static const byte* DecryptMessage(SSL* ssl, const byte* input, word32 sz,
         *error = ret;
         return NULL;
     }
+    /* the sequence number is part of the nonce without an explicit IV */
+    if (++ssl->keys.peer_sequence_number_lo == 0)
+        ssl->keys.peer_sequence_number_hi++;
     ssl->keys.encryptSz = sz;
+#ifdef WOLFSSL_TLS13
+    if (ssl->options.tls1_3) {
+        /* caller strips the padding and record type after the content */
+        ssl->keys.padSz = 0;
+        return output;
+    }
+#endif
     if (ssl->options.tls1_1 && ssl->specs.cipher_type == block) {
         output += ssl->specs.block_size;     /* go past TLSv1.1 IV */
         ivExtra = ssl->specs.block_size;
@@ -2899,17 +3440,19 @@ static void RemoveSession(SnifferSession* session, IpInfo* ipInfo,
     SnifferSession* current;
     word32          row = rowHint;
     int             haveLock = 0;
+    SessionShard*   shard;
 
     if (ipInfo && tcpInfo)
         row = SessionHash(ipInfo, tcpInfo);
     else
         haveLock = 1;
 
-    assert(row <= HASH_SIZE);
+    assert(row < SessionTableSz);
     Trace(REMOVE_SESSION_STR);
 
+    shard = GetSessionShard(row);
     if (!haveLock)
-        wc_LockMutex(&SessionMutex);
+        wc_LockMutex(&shard->mutex);
 
     current = SessionTable[row];
 
@@ -2928,17 +3471,18 @@ static void RemoveSession(SnifferSession* session, IpInfo* ipInfo,
     }
 
     if (!haveLock)
-        wc_UnLockMutex(&SessionMutex);
+        wc_UnLockMutex(&shard->mutex);
 }
 
 
-/* Remove stale sessions from the Session Table, have a lock */
-static void RemoveStaleSessions(void)
+/* Remove stale sessions from the Session Table rows of a shard, have its
+ * lock */
+static void RemoveStaleSessions(word32 shard)
 {
     word32 i;
     SnifferSession* session;
 
-    for (i = 0; i < HASH_SIZE; i++) {
+    for (i = shard; i < SessionTableSz; i += WOLFSSL_SNIFFER_SHARDS) {
         session = SessionTable[i];
         while (session) {
             SnifferSession* next = session->next;
@@ -2957,9 +3501,14 @@ static SnifferSession* CreateSession(IpInfo* ipInfo, TcpInfo* tcpInfo,
                                      char* error)
 {
     SnifferSession* session = 0;
-    int row;
+    word32 row;
+    SessionShard* shard;
 
     Trace(NEW_SESSION_STR);
+    if (SessionTable == NULL) {
+        SetError(MEMORY_STR, error, NULL, 0);
+        return 0;
+    }
     /* create a new one */
     session = (SnifferSession*)XMALLOC(sizeof(SnifferSession),
             NULL, DYNAMIC_TYPE_SNIFFER_SESSION);
@@ -3023,21 +3572,23 @@ static SnifferSession* CreateSession(IpInfo* ipInfo, TcpInfo* tcpInfo,
     session->sslServer->options.side = WOLFSSL_SERVER_END;
 
     row = SessionHash(ipInfo, tcpInfo);
+    shard = GetSessionShard(row);
 
     /* add it to the session table */
-    wc_LockMutex(&SessionMutex);
+    wc_LockMutex(&shard->mutex);
 
     session->next = SessionTable[row];
     SessionTable[row] = session;
 
-    SessionCount++;
-
-    if ( (SessionCount % HASH_SIZE) == 0) {
+    /* sweep a shard once it has seen as many new sessions as it has rows */
+    shard->added++;
+    if (shard->added * WOLFSSL_SNIFFER_SHARDS >= SessionTableSz) {
+        shard->added = 0;
         TraceFindingStale();
-        RemoveStaleSessions();
+        RemoveStaleSessions(row % WOLFSSL_SNIFFER_SHARDS);
     }
 
-    wc_UnLockMutex(&SessionMutex);
+    wc_UnLockMutex(&shard->mutex);
 
     /* CreateSession is called in response to a SYN packet, we know this
      * is headed to the server. Also we know the server is one we care
@@ -3944,11 +4495,12 @@ doMessage:
     recordEnd = sslFrame + rhSize;   /* may have more than one record */
     inRecordEnd = recordEnd;
 
-    /* decrypt if needed */
-    if ((session->flags.side == WOLFSSL_SERVER_END &&
+    /* decrypt if needed, TLS v1.3 change cipher spec is never encrypted */
+    if (((session->flags.side == WOLFSSL_SERVER_END &&
                                                session->flags.serverCipherOn)
      || (session->flags.side == WOLFSSL_CLIENT_END &&
-                                               session->flags.clientCipherOn)) {
+                                               session->flags.clientCipherOn))
+     && !(ssl->options.tls1_3 && rh.type == change_cipher_spec)) {
         int ivAdvance = 0;  /* TLSv1.1 advance amount */
         if (ssl->decrypt.setup != 1) {
             SetError(DECRYPT_KEYS_NOT_SETUP, error, session, FATAL_ERROR_STATE);
@@ -3980,6 +4532,26 @@ doMessage:
             SetError(BAD_DECRYPT, error, session, FATAL_ERROR_STATE);
             return -1;
         }
+
+#ifdef WOLFSSL_TLS13
+        if (ssl->options.tls1_3) {
+            /* real record type is the last non zero byte, then padding */
+            int contentSz = rhSize - ssl->specs.aead_mac_size;
+
+            while (contentSz > 0 && sslFrame[contentSz - 1] == 0)
+                contentSz--;
+            if (contentSz == 0) {
+                SetError(BAD_DECRYPT, error, session, FATAL_ERROR_STATE);
+                return -1;
+            }
+            contentSz--;
+            rh.type = sslFrame[contentSz];
+
+            recordEnd = sslFrame + contentSz;
+            sslBytes = contentSz;
+            ssl->keys.encryptSz = contentSz;
+        }
+#endif
     }
 
 doPart:
@@ -4007,6 +4579,13 @@ doPart:
             }
             break;
         case change_cipher_spec:
+            if (ssl->options.tls1_3) {
+                /* only sent for middlebox compatibility */
+                Trace(GOT_CHANGE_CIPHER_STR);
+                sslFrame += 1;
+                sslBytes -= 1;
+                break;
+            }
             if (session->flags.side == WOLFSSL_SERVER_END)
                 session->flags.serverCipherOn = 1;
             else
@@ -4102,6 +4681,7 @@ doPart:
             sslFrame += rhSize;
             sslBytes -= rhSize;
             break;
+        case dtls12_cid: /* DTLS only, the sniffer decodes TLS over TCP */
         case no_type:
         default:
             SetError(GOT_UNKNOWN_RECORD_STR, error, session, FATAL_ERROR_STATE);
@@ -4400,6 +4980,23 @@ int ssl_EnableRecovery(int onOff, int maxMemory, char* error)
 }
 
 
+/* Sets the number of Session Hash Table rows ssl_InitSniffer() creates, so
+ * only before it is called, or after ssl_FreeSniffer(). The rows are fixed
+ * while sniffing since packets are hashed to a row before taking its lock.
+ * returns 0 on success, -1 on error */
+int ssl_SetSessionTableSize(unsigned int rows, char* error)
+{
+    if (rows == 0 || SessionTable != NULL) {
+        SetError(SESSION_TABLE_STR, error, NULL, 0);
+        return -1;
+    }
+
+    SessionTableRows = rows;
+
+    return 0;
+}
+
+
 
 #ifdef WOLFSSL_SESSION_STATS
 
@@ -4418,19 +5015,22 @@ int ssl_GetSessionStats(unsigned int* active,     unsigned int* total,
 
     if (reassemblyMem) {
         SnifferSession* session;
-        int i;
+        word32 shard;
+        word32 i;
 
         *reassemblyMem = 0;
-        wc_LockMutex(&SessionMutex);
-        for (i = 0; i < HASH_SIZE; i++) {
-            session = SessionTable[i];
-            while (session) {
-                *reassemblyMem += session->cliReassemblyMemory;
-                *reassemblyMem += session->srvReassemblyMemory;
-                session = session->next;
+        for (shard = 0; shard < WOLFSSL_SNIFFER_SHARDS; shard++) {
+            wc_LockMutex(&SessionShards[shard].mutex);
+            for (i = shard; i < SessionTableSz; i += WOLFSSL_SNIFFER_SHARDS) {
+                session = SessionTable[i];
+                while (session) {
+                    *reassemblyMem += session->cliReassemblyMemory;
+                    *reassemblyMem += session->srvReassemblyMemory;
+                    session = session->next;
+                }
             }
+            wc_UnLockMutex(&SessionShards[shard].mutex);
         }
-        wc_UnLockMutex(&SessionMutex);
     }
 
     ret = wolfSSL_get_session_stats(active, total, peak, maxSessions);
@@ -4607,5 +5207,240 @@ int ssl_SetStoreDataCallback(SSLStoreDataCb cb)
 
 #endif /* WOLFSSL_SNIFFER_STORE_DATA_CB */
 
+/* Sets the secret callback, used for the master secret of ephemeral key
+ * exchanges and resumptions not seen, and the TLS v1.3 traffic secrets */
+/* returns 0 on success */
+int ssl_SetSecretCallback(SSLSecretCb cb, char* error)
+{
+    (void)error;
+    SecretCb = cb;
+    return 0;
+}
+
+
+int ssl_SetSecretCtx(void* ctx, char* error)
+{
+    (void)error;
+    SecretCbCtx = ctx;
+    return 0;
+}
+
+
+/* Sets a server and port to decode with the secret callback alone */
+/* returns 0 on success, -1 on error */
+int ssl_SetSecretServer(const char* address, int port, char* error)
+{
+    SnifferServer* sniffer;
+    IpAddrInfo     serverIp;
+    int            ret = 0;
+
+    if (address == NULL || port < 0 || port > MAX_PORT_NUMBER) {
+        SetError(BAD_INPUT_STR, error, NULL, 0);
+        return -1;
+    }
+
+    TraceHeader();
+    TraceSetServer(address, port, "(secret callback)");
+
+    GetServerAddress(address, &serverIp);
+
+    wc_LockRwLock_Wr(&ServerListLock);
+    sniffer = FindSnifferServer(&serverIp, port);
+    if (sniffer == NULL) {
+        sniffer = CreateSnifferServer(address, port, &serverIp, error);
+        if (sniffer == NULL)
+            ret = -1;
+        else {
+#ifdef WOLF_CRYPTO_CB
+            wolfSSL_CTX_SetDevId(sniffer->ctx, CryptoDeviceId);
+#endif
+            AddSnifferServer(sniffer);
+        }
+    }
+    wc_UnLockRwLock(&ServerListLock);
+
+    if (ret == 0)
+        Trace(NEW_SERVER_STR);
+
+    return ret;
+}
+
+
+/* Key Log File labels, indexed by secret type */
+static const char* const keyLogLabels[SNIFFER_SECRET_COUNT] = {
+    "CLIENT_RANDOM",
+    "CLIENT_HANDSHAKE_TRAFFIC_SECRET",
+    "SERVER_HANDSHAKE_TRAFFIC_SECRET",
+    "CLIENT_TRAFFIC_SECRET_0",
+    "SERVER_TRAFFIC_SECRET_0"
+};
+
+
+/* Secret callback looking up the Key Log File entries */
+static int KeyLogSecretCb(const byte* clientRandom, int secretType,
+                          byte* secret, word32* secretSz, void* ctx)
+{
+    KeyLogEntry* entry;
+    int          ret = -1;
+
+    (void)ctx;
+
+    wc_LockMutex(&KeyLogMutex);
+    entry = KeyLogTable[clientRandom[RAN_LEN - 1] % KEY_LOG_HASH_SIZE];
+    while (entry) {
+        if (entry->secretType == secretType &&
+                XMEMCMP(entry->clientRandom, clientRandom, RAN_LEN) == 0) {
+            if (entry->secretSz <= *secretSz) {
+                XMEMCPY(secret, entry->secret, entry->secretSz);
+                *secretSz = entry->secretSz;
+                ret = 0;
+            }
+            break;
+        }
+        entry = entry->next;
+    }
+    wc_UnLockMutex(&KeyLogMutex);
+
+    return ret;
+}
+
+
+/* Decode exactly outSz bytes of hex */
+/* returns 0 on success, -1 on error */
+static int KeyLogHexDecode(const char* in, word32 inSz, byte* out,
+                           word32 outSz)
+{
+    word32 i;
+
+    if (inSz != outSz * 2)
+        return -1;
+
+    for (i = 0; i < inSz; i++) {
+        char c = in[i];
+        byte b;
+
+        if (c >= '0' && c <= '9')
+            b = (byte)(c - '0');
+        else if (c >= 'a' && c <= 'f')
+            b = (byte)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F')
+            b = (byte)(c - 'A' + 10);
+        else
+            return -1;
+
+        if (i & 1)
+            out[i / 2] |= b;
+        else
+            out[i / 2] = (byte)(b << 4);
+    }
+
+    return 0;
+}
+
+
+/* Add a Key Log File line, "<label> <client random> <secret>" in hex,
+ * caller holds KeyLogMutex */
+/* returns 0 on success or line not needed, -1 on error */
+static int AddKeyLogLine(const char* line)
+{
+    const char*  field[3];
+    word32       fieldSz[3];
+    int          fields = 0;
+    int          secretType;
+    KeyLogEntry* entry;
+    word32       row;
+
+    while (fields < 3) {
+        while (*line == ' ' || *line == '\t')
+            line++;
+        if (*line == '\0' || *line == '\r' || *line == '\n')
+            break;
+        field[fields] = line;
+        while (*line != '\0' && *line != ' ' && *line != '\t' &&
+               *line != '\r' && *line != '\n')
+            line++;
+        fieldSz[fields] = (word32)(line - field[fields]);
+        fields++;
+    }
+
+    /* blank line or comment */
+    if (fields == 0 || field[0][0] == '#')
+        return 0;
+    if (fields != 3)
+        return -1;
+
+    for (secretType = 0; secretType < SNIFFER_SECRET_COUNT; secretType++) {
+        if (fieldSz[0] == (word32)XSTRLEN(keyLogLabels[secretType]) &&
+                XSTRNCMP(field[0], keyLogLabels[secretType], fieldSz[0]) == 0)
+            break;
+    }
+    /* secrets we don't use, like the exporter ones */
+    if (secretType == SNIFFER_SECRET_COUNT)
+        return 0;
+
+    entry = (KeyLogEntry*)XMALLOC(sizeof(KeyLogEntry), NULL,
+                                  DYNAMIC_TYPE_SNIFFER_KEY_LOG);
+    if (entry == NULL)
+        return -1;
+
+    entry->secretType = secretType;
+    entry->secretSz = fieldSz[2] / 2;
+    if (entry->secretSz > SECRET_LEN ||
+            KeyLogHexDecode(field[1], fieldSz[1], entry->clientRandom,
+                            RAN_LEN) != 0 ||
+            KeyLogHexDecode(field[2], fieldSz[2], entry->secret,
+                            entry->secretSz) != 0) {
+        ForceZero(entry, sizeof(KeyLogEntry));
+        XFREE(entry, NULL, DYNAMIC_TYPE_SNIFFER_KEY_LOG);
+        return -1;
+    }
+
+    row = entry->clientRandom[RAN_LEN - 1] % KEY_LOG_HASH_SIZE;
+    entry->next = KeyLogTable[row];
+    KeyLogTable[row] = entry;
+
+    return 0;
+}
+
+
+/* Loads the secrets of an NSS format Key Log File, as written for
+ * SSLKEYLOGFILE, and sets the secret callback to look them up */
+/* returns 0 on success, -1 on error */
+int ssl_LoadKeyLogFile(const char* keyLogFile, char* error)
+{
+    XFILE file;
+    char  line[KEY_LOG_LINE_SZ];
+    int   ret = 0;
+
+    if (keyLogFile == NULL) {
+        SetError(KEY_LOG_FILE_STR, error, NULL, 0);
+        return -1;
+    }
+
+    file = XFOPEN(keyLogFile, "r");
+    if (file == XBADFILE) {
+        SetError(KEY_LOG_FILE_STR, error, NULL, 0);
+        return -1;
+    }
+
+    wc_LockMutex(&KeyLogMutex);
+    while (ret == 0 && XFGETS(line, sizeof(line), file) != NULL)
+        ret = AddKeyLogLine(line);
+    wc_UnLockMutex(&KeyLogMutex);
+    XFCLOSE(file);
+    ForceZero(line, sizeof(line));
+
+    if (ret != 0) {
+        SetError(KEY_LOG_FILE_STR, error, NULL, 0);
+        return -1;
+    }
+
+    SecretCb = KeyLogSecretCb;
+    SecretCbCtx = NULL;
+
+    return 0;
+}
+
+
 #endif /* WOLFSSL_SNIFFER */
 #endif /* WOLFCRYPT_ONLY */
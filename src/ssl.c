@@ -1132,6 +1132,172 @@ int wolfSSL_dtls_get_drop_stats(WOLFSSL* ssl,
 #endif /* WOLFSSL_DTLS_DROP_STATS */
 
 
+#ifdef WOLFSSL_DTLS_CID
+
+/* Ask for DTLS 1.2 connection IDs (RFC 9146) in the handshake. Call before
+ * wolfSSL_connect()/wolfSSL_accept(). A server only agrees when the client
+ * asks too and an AEAD cipher suite is negotiated.
+ * returns WOLFSSL_SUCCESS on success */
+int wolfSSL_dtls_cid_use(WOLFSSL* ssl)
+{
+    int ret;
+
+    WOLFSSL_ENTER("wolfSSL_dtls_cid_use()");
+
+    if (ssl == NULL || !ssl->options.dtls)
+        return BAD_FUNC_ARG;
+
+    ret = TLSX_UseConnectionID(ssl);
+    if (ret == 0)
+        ret = WOLFSSL_SUCCESS;
+
+    WOLFSSL_LEAVE("wolfSSL_dtls_cid_use()", ret);
+    return ret;
+}
+
+/* returns WOLFSSL_SUCCESS when connection IDs were negotiated */
+int wolfSSL_dtls_cid_is_enabled(WOLFSSL* ssl)
+{
+    if (ssl == NULL || !ssl->dtlsCidInfo.negotiated)
+        return WOLFSSL_FAILURE;
+
+    return WOLFSSL_SUCCESS;
+}
+
+/* Set the CID the peer is to put on the records it sends us. This is the
+ * value a server looks up with wolfSSL_dtls_cid_parse() to find the
+ * connection a datagram belongs to. A zero length means we don't need one.
+ * returns WOLFSSL_SUCCESS on success */
+int wolfSSL_dtls_cid_set(WOLFSSL* ssl, const unsigned char* cid,
+                         unsigned int cidSz)
+{
+    if (ssl == NULL || (cid == NULL && cidSz > 0) ||
+                                                  cidSz > DTLS_CID_MAX_SIZE)
+        return BAD_FUNC_ARG;
+
+    /* can't change once the peer is using it */
+    if (ssl->dtlsCidInfo.negotiated)
+        return WOLFSSL_FAILURE;
+
+    if (cidSz > 0)
+        XMEMCPY(ssl->dtlsCidInfo.rx, cid, cidSz);
+    ssl->dtlsCidInfo.rxSz = (byte)cidSz;
+
+    return WOLFSSL_SUCCESS;
+}
+
+static int DtlsCidGetSize(WOLFSSL* ssl, unsigned int* cidSz, int rx)
+{
+    if (ssl == NULL || cidSz == NULL)
+        return BAD_FUNC_ARG;
+    if (!ssl->dtlsCidInfo.negotiated)
+        return WOLFSSL_FAILURE;
+
+    *cidSz = rx ? ssl->dtlsCidInfo.rxSz : ssl->dtlsCidInfo.txSz;
+    return WOLFSSL_SUCCESS;
+}
+
+static int DtlsCidGet(WOLFSSL* ssl, unsigned char* buf, unsigned int bufSz,
+                      int rx)
+{
+    const byte* cid;
+    byte        cidSz;
+
+    if (ssl == NULL || buf == NULL)
+        return BAD_FUNC_ARG;
+    if (!ssl->dtlsCidInfo.negotiated)
+        return WOLFSSL_FAILURE;
+
+    cid   = rx ? ssl->dtlsCidInfo.rx   : ssl->dtlsCidInfo.tx;
+    cidSz = rx ? ssl->dtlsCidInfo.rxSz : ssl->dtlsCidInfo.txSz;
+    if (bufSz < cidSz)
+        return BUFFER_E;
+
+    XMEMCPY(buf, cid, cidSz);
+    return WOLFSSL_SUCCESS;
+}
+
+/* Size of the negotiated CID on records we receive. */
+int wolfSSL_dtls_cid_get_rx_size(WOLFSSL* ssl, unsigned int* cidSz)
+{
+    return DtlsCidGetSize(ssl, cidSz, 1);
+}
+
+/* Copy out the negotiated CID on records we receive. */
+int wolfSSL_dtls_cid_get_rx(WOLFSSL* ssl, unsigned char* buf,
+                            unsigned int bufSz)
+{
+    return DtlsCidGet(ssl, buf, bufSz, 1);
+}
+
+/* Size of the negotiated CID on records we send. */
+int wolfSSL_dtls_cid_get_tx_size(WOLFSSL* ssl, unsigned int* cidSz)
+{
+    return DtlsCidGetSize(ssl, cidSz, 0);
+}
+
+/* Copy out the negotiated CID on records we send. */
+int wolfSSL_dtls_cid_get_tx(WOLFSSL* ssl, unsigned char* buf,
+                            unsigned int bufSz)
+{
+    return DtlsCidGet(ssl, buf, bufSz, 0);
+}
+
+/* Peek at the connection ID of the first record in a raw datagram so a server
+ * reading many peers from one socket can find the WOLFSSL object it belongs
+ * to. The CID isn't length prefixed on the wire, so the caller passes the
+ * size it hands out with wolfSSL_dtls_cid_set().
+ * returns a pointer to the CID in msg, or NULL when the datagram doesn't
+ * start with a CID record */
+const unsigned char* wolfSSL_dtls_cid_parse(const unsigned char* msg,
+                                            unsigned int msgSz,
+                                            unsigned int cidSz)
+{
+    if (msg == NULL || cidSz == 0 ||
+            msgSz < DTLS_RECORD_HEADER_SZ + cidSz || msg[0] != dtls12_cid)
+        return NULL;
+
+    return msg + DTLS_RECORD_HEADER_SZ - LENGTH_SZ;
+}
+
+/* Tell the record layer the address the next datagram came from, for I/O
+ * callbacks that demultiplex datagrams by connection ID. When it isn't the
+ * current peer, the peer (wolfSSL_dtls_get_peer()) only moves there once a
+ * record of the datagram authenticates and is newer than any seen before.
+ * Call it for every datagram, with a NULL peer when it came from the current
+ * peer, so a rejected datagram can't leave its address behind.
+ * returns WOLFSSL_SUCCESS on success */
+int wolfSSL_dtls_cid_set_pending_peer(WOLFSSL* ssl, const void* peer,
+                                      unsigned int peerSz)
+{
+    WOLFSSL_SOCKADDR* pending;
+
+    if (ssl == NULL || (peer == NULL && peerSz > 0))
+        return BAD_FUNC_ARG;
+
+    pending = &ssl->buffers.dtlsCtx.pendingPeer;
+    if (peer == NULL || peerSz == 0) {
+        pending->sz = 0;
+        return WOLFSSL_SUCCESS;
+    }
+    /* only a connection ID says the datagram is ours */
+    if (!ssl->dtlsCidInfo.negotiated)
+        return WOLFSSL_FAILURE;
+
+    XFREE(pending->sa, ssl->heap, DYNAMIC_TYPE_SOCKADDR);
+    pending->sz = 0;
+    pending->sa = XMALLOC(peerSz, ssl->heap, DYNAMIC_TYPE_SOCKADDR);
+    if (pending->sa == NULL)
+        return MEMORY_E;
+    XMEMCPY(pending->sa, peer, peerSz);
+    pending->sz = peerSz;
+
+    return WOLFSSL_SUCCESS;
+}
+
+#endif /* WOLFSSL_DTLS_CID */
+
+
 #if defined(WOLFSSL_MULTICAST)
 
 int wolfSSL_CTX_mcast_set_member_id(WOLFSSL_CTX* ctx, word16 id)
@@ -1998,6 +2164,30 @@ int wolfSSL_write(WOLFSSL* ssl, const void* data, int sz)
         return ret;
 }
 
+#ifdef HAVE_WRITE_DUP
+/* let the write side know about a fatal read error, returns updated ret */
+static int ReadNotifyWriteDup(WOLFSSL* ssl, int ret)
+{
+    if (ssl->dupWrite) {
+        if (ssl->error != 0 && ssl->error != WANT_READ
+        #ifdef WOLFSSL_ASYNC_CRYPT
+            && ssl->error != WC_PENDING_E
+        #endif
+        ) {
+            int notifyErr;
+
+            WOLFSSL_MSG("Notifying write side of fatal read error");
+            notifyErr  = NotifyWriteSide(ssl, ssl->error);
+            if (notifyErr < 0) {
+                ret = ssl->error = notifyErr;
+            }
+        }
+    }
+
+    return ret;
+}
+#endif
+
 static int wolfSSL_read_internal(WOLFSSL* ssl, void* data, int sz, int peek)
 {
     int ret;
@@ -2035,21 +2225,7 @@ static int wolfSSL_read_internal(WOLFSSL* ssl, void* data, int sz, int peek)
     ret = ReceiveData(ssl, (byte*)data, sz, peek);
 
 #ifdef HAVE_WRITE_DUP
-    if (ssl->dupWrite) {
-        if (ssl->error != 0 && ssl->error != WANT_READ
-        #ifdef WOLFSSL_ASYNC_CRYPT
-            && ssl->error != WC_PENDING_E
-        #endif
-        ) {
-            int notifyErr;
-
-            WOLFSSL_MSG("Notifying write side of fatal read error");
-            notifyErr  = NotifyWriteSide(ssl, ssl->error);
-            if (notifyErr < 0) {
-                ret = ssl->error = notifyErr;
-            }
-        }
-    }
+    ret = ReadNotifyWriteDup(ssl, ret);
 #endif
 
     WOLFSSL_LEAVE("wolfSSL_read_internal()", ret);
@@ -2084,6 +2260,72 @@ int wolfSSL_read(WOLFSSL* ssl, void* data, int sz)
 }
 
 
+/* Zero copy read, sets *data to the decrypted application data of the
+ * current record in place in the input buffer. The data stays valid and is
+ * returned again by the next call until consumed with
+ * wolfSSL_read_zc_release(). Returns the number of bytes available, 0 when
+ * the peer closed the connection or WOLFSSL_FATAL_ERROR */
+int wolfSSL_read_zc(WOLFSSL* ssl, const unsigned char** data)
+{
+    int ret;
+
+    WOLFSSL_ENTER("wolfSSL_read_zc()");
+
+    if (ssl == NULL || data == NULL)
+        return BAD_FUNC_ARG;
+
+#ifdef HAVE_WRITE_DUP
+    if (ssl->dupWrite && ssl->dupSide == WRITE_DUP_SIDE) {
+        WOLFSSL_MSG("Write dup side cannot read");
+        return WRITE_DUP_READ_E;
+    }
+#endif
+
+#ifdef HAVE_ERRNO_H
+        errno = 0;
+#endif
+
+#ifdef WOLFSSL_DTLS
+    if (ssl->options.dtls) {
+        ssl->dtls_expected_rx = MAX_MTU;
+    #if defined(WOLFSSL_SCTP) || defined(WOLFSSL_DTLS_MTU)
+        ssl->dtls_expected_rx = max(ssl->dtls_expected_rx, ssl->dtlsMtuSz);
+    #endif
+    }
+#endif
+
+    *data = NULL;
+    ret = ReceiveDataZeroCopy(ssl, data);
+
+#ifdef HAVE_WRITE_DUP
+    ret = ReadNotifyWriteDup(ssl, ret);
+#endif
+
+    WOLFSSL_LEAVE("wolfSSL_read_zc()", ret);
+
+    if (ret < 0)
+        return WOLFSSL_FATAL_ERROR;
+    else
+        return ret;
+}
+
+
+/* consume sz bytes of the data returned by wolfSSL_read_zc(), WOLFSSL_SUCCESS
+ * on ok */
+int wolfSSL_read_zc_release(WOLFSSL* ssl, int sz)
+{
+    WOLFSSL_ENTER("wolfSSL_read_zc_release()");
+
+    if (ssl == NULL)
+        return BAD_FUNC_ARG;
+
+    if (ReleaseDataZeroCopy(ssl, sz) != 0)
+        return BAD_FUNC_ARG;
+
+    return WOLFSSL_SUCCESS;
+}
+
+
 #ifdef WOLFSSL_MULTICAST
 
 int wolfSSL_mcast_read(WOLFSSL* ssl, word16* id, void* data, int sz)
@@ -2803,6 +3045,85 @@ int wolfSSL_CTX_set_TicketEncCtx(WOLFSSL_CTX* ctx, void* userCtx)
     return WOLFSSL_SUCCESS;
 }
 
+/* issue tickets with the built-in rotating key callback, WOLFSSL_SUCCESS on
+   ok */
+int wolfSSL_CTX_UseDefTicketEncCb(WOLFSSL_CTX* ctx)
+{
+#ifndef WOLFSSL_NO_DEF_TICKET_ENC_CB
+    WOLFSSL_ENTER("wolfSSL_CTX_UseDefTicketEncCb");
+
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+
+    ctx->ticketEncCb = DefTicketEncCb;
+
+    return WOLFSSL_SUCCESS;
+#else
+    (void)ctx;
+    return NOT_COMPILED_IN;
+#endif
+}
+
+/* set the secret the built-in ticket callback derives its keys from, servers
+   sharing the secret accept each other's tickets, WOLFSSL_SUCCESS on ok */
+int wolfSSL_CTX_set_TicketKeySecret(WOLFSSL_CTX* ctx,
+                                    const unsigned char* secret,
+                                    unsigned int sz)
+{
+#ifndef WOLFSSL_NO_DEF_TICKET_ENC_CB
+    TicketEncCbCtx* keyCtx;
+
+    WOLFSSL_ENTER("wolfSSL_CTX_set_TicketKeySecret");
+
+    if (ctx == NULL || secret == NULL || sz < WOLFSSL_TICKET_SECRET_MIN_SZ ||
+                                            sz > WOLFSSL_TICKET_SECRET_MAX_SZ)
+        return BAD_FUNC_ARG;
+
+    keyCtx = &ctx->ticketKeyCtx;
+    if (wc_LockMutex(&keyCtx->mutex) != 0)
+        return BAD_MUTEX_E;
+    ForceZero(keyCtx->keys, sizeof(keyCtx->keys));
+    ForceZero(keyCtx->secret, sizeof(keyCtx->secret));
+    XMEMCPY(keyCtx->secret, secret, sz);
+    keyCtx->secretSz = sz;
+    wc_UnLockMutex(&keyCtx->mutex);
+
+    return WOLFSSL_SUCCESS;
+#else
+    (void)ctx;
+    (void)secret;
+    (void)sz;
+    return NOT_COMPILED_IN;
+#endif
+}
+
+/* set seconds between built-in ticket key rotations, WOLFSSL_SUCCESS on ok */
+int wolfSSL_CTX_set_TicketKeyLifetime(WOLFSSL_CTX* ctx, unsigned int seconds)
+{
+#ifndef WOLFSSL_NO_DEF_TICKET_ENC_CB
+    TicketEncCbCtx* keyCtx;
+
+    WOLFSSL_ENTER("wolfSSL_CTX_set_TicketKeyLifetime");
+
+    if (ctx == NULL || seconds == 0)
+        return BAD_FUNC_ARG;
+
+    keyCtx = &ctx->ticketKeyCtx;
+    if (wc_LockMutex(&keyCtx->mutex) != 0)
+        return BAD_MUTEX_E;
+    /* periods change meaning, derive again */
+    ForceZero(keyCtx->keys, sizeof(keyCtx->keys));
+    keyCtx->lifetime = seconds;
+    wc_UnLockMutex(&keyCtx->mutex);
+
+    return WOLFSSL_SUCCESS;
+#else
+    (void)ctx;
+    (void)seconds;
+    return NOT_COMPILED_IN;
+#endif
+}
+
 #endif /* !defined(NO_WOLFSSL_CLIENT) && defined(HAVE_SESSION_TICKET) */
 
 /* Session Ticket */
@@ -3508,6 +3829,9 @@ int wolfSSL_GetHmacSize(WOLFSSL* ssl)
 
 #ifndef NO_CERTS
 
+static int  ResizeCATable(WOLFSSL_CERT_MANAGER* cm, word32 rows);
+static void UnloadCATable(WOLFSSL_CERT_MANAGER* cm);
+
 WOLFSSL_CERT_MANAGER* wolfSSL_CTX_GetCertManager(WOLFSSL_CTX* ctx)
 {
     WOLFSSL_CERT_MANAGER* cm = NULL;
@@ -3526,12 +3850,28 @@ WOLFSSL_CERT_MANAGER* wolfSSL_CertManagerNew_ex(void* heap)
                                          DYNAMIC_TYPE_CERT_MANAGER);
     if (cm) {
         XMEMSET(cm, 0, sizeof(WOLFSSL_CERT_MANAGER));
+        cm->heap = heap;
+
+        if (wc_InitRwLock(&cm->caLock) != 0) {
+            WOLFSSL_MSG("Bad mutex init");
+            wolfSSL_CertManagerFree(cm);
+            return NULL;
+        }
+
+        if (ResizeCATable(cm, CA_TABLE_SIZE) != 0) {
+            WOLFSSL_MSG("CA table alloc failed");
+            wolfSSL_CertManagerFree(cm);
+            return NULL;
+        }
 
-        if (wc_InitMutex(&cm->caLock) != 0) {
+        #ifdef WOLFSSL_CERT_VERIFY_CACHE
+        if (wc_InitRwLock(&cm->verifyLock) != 0) {
             WOLFSSL_MSG("Bad mutex init");
             wolfSSL_CertManagerFree(cm);
             return NULL;
         }
+        cm->verifyCacheSz = CERT_VERIFY_CACHE_SIZE;
+        #endif
 
         #ifdef WOLFSSL_TRUST_PEER_CERT
         if (wc_InitMutex(&cm->tpLock) != 0) {
@@ -3548,7 +3888,9 @@ WOLFSSL_CERT_MANAGER* wolfSSL_CertManagerNew_ex(void* heap)
         #ifdef HAVE_ECC
             cm->minEccKeySz = MIN_ECCKEY_SZ;
         #endif
-            cm->heap = heap;
+        #ifdef HAVE_OCSP
+            cm->ocspCacheSz = OCSP_CACHE_MAX_STATUS;
+        #endif
     }
 
     return cm;
@@ -3581,8 +3923,18 @@ void wolfSSL_CertManagerFree(WOLFSSL_CERT_MANAGER* cm)
                 FreeOCSP(cm->ocsp_stapling, 1);
         #endif
         #endif
-        FreeSignerTable(cm->caTable, CA_TABLE_SIZE, cm->heap);
-        wc_FreeMutex(&cm->caLock);
+        if (cm->caTable != NULL) {
+            FreeSignerTable(cm->caTable, (int)cm->caTableSz, cm->heap);
+            XFREE(cm->caTable, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+        }
+    #ifndef NO_SKID
+        XFREE(cm->caNameTable, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+    #endif
+        wc_FreeRwLock(&cm->caLock);
+    #ifdef WOLFSSL_CERT_VERIFY_CACHE
+        XFREE(cm->verifyCache, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+        wc_FreeRwLock(&cm->verifyLock);
+    #endif
 
         #ifdef WOLFSSL_TRUST_PEER_CERT
         FreeTrustedPeerTable(cm->tpTable, TP_TABLE_SIZE, cm->heap);
@@ -3621,11 +3973,11 @@ WOLFSSL_STACK* wolfSSL_CertManagerGetCerts(WOLFSSL_CERT_MANAGER* cm)
         return NULL;
     }
 
-    if (wc_LockMutex(&cm->caLock) != 0) {
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0) {
         goto error_init;
     }
 
-    for (row = 0; row < CA_TABLE_SIZE; row++) {
+    for (row = 0; row < cm->caTableSz; row++) {
         signers = cm->caTable[row];
         while (signers && signers->derCert && signers->derCert->buffer) {
 
@@ -3676,7 +4028,7 @@ WOLFSSL_STACK* wolfSSL_CertManagerGetCerts(WOLFSSL_CERT_MANAGER* cm)
             dCert = NULL;
         }
     }
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
     if (!found) {
        goto error_init;
@@ -3685,7 +4037,7 @@ WOLFSSL_STACK* wolfSSL_CertManagerGetCerts(WOLFSSL_CERT_MANAGER* cm)
     return sk;
 
 error:
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
 error_init:
 
@@ -3798,18 +4150,45 @@ int wolfSSL_CertManagerUnloadCAs(WOLFSSL_CERT_MANAGER* cm)
     if (cm == NULL)
         return BAD_FUNC_ARG;
 
-    if (wc_LockMutex(&cm->caLock) != 0)
+    if (wc_LockRwLock_Wr(&cm->caLock) != 0)
         return BAD_MUTEX_E;
 
-    FreeSignerTable(cm->caTable, CA_TABLE_SIZE, cm->heap);
+    UnloadCATable(cm);
 
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
 
     return WOLFSSL_SUCCESS;
 }
 
 
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+/* Set the number of certificates remembered as verified, 0 turns the cache
+ * off. A remembered certificate seen again with the same signer key skips the
+ * signature check; dates, name constraints and revocation are still checked.
+ * Entries are dropped when the CAs are unloaded. */
+int wolfSSL_CertManagerSetVerifyCacheSize(WOLFSSL_CERT_MANAGER* cm, int sz)
+{
+    WOLFSSL_ENTER("wolfSSL_CertManagerSetVerifyCacheSize");
+
+    if (cm == NULL || sz < 0)
+        return BAD_FUNC_ARG;
+
+    if (wc_LockRwLock_Wr(&cm->verifyLock) != 0)
+        return BAD_MUTEX_E;
+
+    /* reallocated on next use */
+    XFREE(cm->verifyCache, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+    cm->verifyCache = NULL;
+    cm->verifyCacheSz = (word32)sz;
+
+    wc_UnLockRwLock(&cm->verifyLock);
+
+    return WOLFSSL_SUCCESS;
+}
+#endif /* WOLFSSL_CERT_VERIFY_CACHE */
+
+
 #ifdef WOLFSSL_TRUST_PEER_CERT
 int wolfSSL_CertManagerUnload_trust_peers(WOLFSSL_CERT_MANAGER* cm)
 {
@@ -3910,6 +4289,32 @@ int wolfSSL_set_group_messages(WOLFSSL* ssl)
 }
 
 
+/* build up to records application data records before sending them with one
+   send call, 0 or 1 sends each record on its own */
+int wolfSSL_CTX_set_coalesce_writes(WOLFSSL_CTX* ctx, int records)
+{
+    if (ctx == NULL || records < 0 || records > WOLFSSL_MAX_COALESCE_RECORDS)
+       return BAD_FUNC_ARG;
+
+    ctx->coalesceRecords = (byte)records;
+
+    return WOLFSSL_SUCCESS;
+}
+
+
+/* build up to records application data records before sending them with one
+   send call for ssl object, 0 or 1 sends each record on its own */
+int wolfSSL_set_coalesce_writes(WOLFSSL* ssl, int records)
+{
+    if (ssl == NULL || records < 0 || records > WOLFSSL_MAX_COALESCE_RECORDS)
+       return BAD_FUNC_ARG;
+
+    ssl->options.coalesceRecords = (byte)records;
+
+    return WOLFSSL_SUCCESS;
+}
+
+
 /* make minVersion the internal equivalent SSL version */
 static int SetMinVersionHelper(byte* minVersion, int version)
 {
@@ -4097,9 +4502,133 @@ static WC_INLINE word32 MakeWordFromHash(const byte* hashID)
 #ifndef NO_CERTS
 
 /* hash is the SHA digest of name, just use first 32 bits as hash */
-static WC_INLINE word32 HashSigner(const byte* hash)
+static WC_INLINE word32 HashSigner(const byte* hash, word32 rows)
+{
+    return MakeWordFromHash(hash) % rows;
+}
+
+
+/* hash the signer is kept under in caTable */
+static WC_INLINE byte* SignerKeyHash(Signer* signer)
+{
+#ifndef NO_SKID
+    return signer->subjectKeyIdHash;
+#else
+    return signer->subjectNameHash;
+#endif
+}
+
+
+/* Rehash all CA signers into tables of rows rows, have write lock. The
+ * current tables are kept if the new ones can't be allocated. */
+static int ResizeCATable(WOLFSSL_CERT_MANAGER* cm, word32 rows)
+{
+    Signer** caTable;
+#ifndef NO_SKID
+    Signer** caNameTable;
+#endif
+    Signer*  signer;
+    Signer*  next;
+    word32   i;
+    word32   row;
+
+    caTable = (Signer**)XMALLOC(sizeof(Signer*) * rows, cm->heap,
+                                                     DYNAMIC_TYPE_CERT_MANAGER);
+    if (caTable == NULL)
+        return MEMORY_E;
+    XMEMSET(caTable, 0, sizeof(Signer*) * rows);
+
+#ifndef NO_SKID
+    caNameTable = (Signer**)XMALLOC(sizeof(Signer*) * rows, cm->heap,
+                                                     DYNAMIC_TYPE_CERT_MANAGER);
+    if (caNameTable == NULL) {
+        XFREE(caTable, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+        return MEMORY_E;
+    }
+    XMEMSET(caNameTable, 0, sizeof(Signer*) * rows);
+#endif
+
+    for (i = 0; i < cm->caTableSz; i++) {
+        for (signer = cm->caTable[i]; signer != NULL; signer = next) {
+            next = signer->next;
+
+            row = HashSigner(SignerKeyHash(signer), rows);
+            signer->next = caTable[row];
+            caTable[row] = signer;
+        #ifndef NO_SKID
+            row = HashSigner(signer->subjectNameHash, rows);
+            signer->nameNext = caNameTable[row];
+            caNameTable[row] = signer;
+        #endif
+        }
+    }
+
+    XFREE(cm->caTable, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+    cm->caTable = caTable;
+#ifndef NO_SKID
+    XFREE(cm->caNameTable, cm->heap, DYNAMIC_TYPE_CERT_MANAGER);
+    cm->caNameTable = caNameTable;
+#endif
+    cm->caTableSz = rows;
+
+    return 0;
+}
+
+
+/* Link signer into the CA tables, takes ownership. Grows the tables once
+ * the rows get long. Have write lock, returns the caTable row used. */
+static word32 AddSignerToTable(WOLFSSL_CERT_MANAGER* cm, Signer* signer)
+{
+    word32 row;
+
+#ifndef NO_SKID
+    row = HashSigner(signer->subjectNameHash, cm->caTableSz);
+    signer->nameNext = cm->caNameTable[row];
+    cm->caNameTable[row] = signer;
+#endif
+    row = HashSigner(SignerKeyHash(signer), cm->caTableSz);
+    signer->next = cm->caTable[row];
+    cm->caTable[row] = signer;
+    cm->caCount++;
+
+    if (cm->caCount > cm->caTableSz * CA_TABLE_LOAD) {
+        /* keep searching the current rows if growing fails */
+        if (ResizeCATable(cm, cm->caTableSz * 2 + 1) == 0)
+            row = HashSigner(SignerKeyHash(signer), cm->caTableSz);
+    }
+
+    return row;
+}
+
+
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+/* Forget all verified certificates. Called before their signers are freed. */
+static void FlushVerifyCache(WOLFSSL_CERT_MANAGER* cm)
 {
-    return MakeWordFromHash(hash) % CA_TABLE_SIZE;
+    if (wc_LockRwLock_Wr(&cm->verifyLock) != 0) {
+        WOLFSSL_MSG("Lock on verifyLock failed");
+        return;
+    }
+    if (cm->verifyCache != NULL) {
+        XMEMSET(cm->verifyCache, 0,
+                sizeof(CertVerifyEntry) * cm->verifyCacheSz);
+    }
+    wc_UnLockRwLock(&cm->verifyLock);
+}
+#endif
+
+
+/* Free all CA signers, have write lock */
+static void UnloadCATable(WOLFSSL_CERT_MANAGER* cm)
+{
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+    FlushVerifyCache(cm);
+#endif
+    FreeSignerTable(cm->caTable, (int)cm->caTableSz, cm->heap);
+#ifndef NO_SKID
+    XMEMSET(cm->caNameTable, 0, sizeof(Signer*) * cm->caTableSz);
+#endif
+    cm->caCount = 0;
 }
 
 
@@ -4114,11 +4643,10 @@ int AlreadySigner(WOLFSSL_CERT_MANAGER* cm, byte* hash)
         return ret;
     }
 
-    row = HashSigner(hash);
-
-    if (wc_LockMutex(&cm->caLock) != 0) {
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0) {
         return ret;
     }
+    row = HashSigner(hash, cm->caTableSz);
     signers = cm->caTable[row];
     while (signers) {
         byte* subjectHash;
@@ -4135,7 +4663,7 @@ int AlreadySigner(WOLFSSL_CERT_MANAGER* cm, byte* hash)
         }
         signers = signers->next;
     }
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
     return ret;
 }
@@ -4253,14 +4781,15 @@ Signer* GetCA(void* vp, byte* hash)
     WOLFSSL_CERT_MANAGER* cm = (WOLFSSL_CERT_MANAGER*)vp;
     Signer* ret = NULL;
     Signer* signers;
-    word32  row = HashSigner(hash);
+    word32  row;
 
     if (cm == NULL)
         return NULL;
 
-    if (wc_LockMutex(&cm->caLock) != 0)
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0)
         return ret;
 
+    row = HashSigner(hash, cm->caTableSz);
     signers = cm->caTable[row];
     while (signers) {
         byte* subjectHash;
@@ -4275,14 +4804,14 @@ Signer* GetCA(void* vp, byte* hash)
         }
         signers = signers->next;
     }
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
     return ret;
 }
 
 
 #ifndef NO_SKID
-/* return CA if found, otherwise NULL. Walk through hash table. */
+/* return CA if found, otherwise NULL. Uses the subject name hash table. */
 Signer* GetCAByName(void* vp, byte* hash)
 {
     WOLFSSL_CERT_MANAGER* cm = (WOLFSSL_CERT_MANAGER*)vp;
@@ -4293,26 +4822,138 @@ Signer* GetCAByName(void* vp, byte* hash)
     if (cm == NULL)
         return NULL;
 
-    if (wc_LockMutex(&cm->caLock) != 0)
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0)
         return ret;
 
-    for (row = 0; row < CA_TABLE_SIZE && ret == NULL; row++) {
-        signers = cm->caTable[row];
-        while (signers && ret == NULL) {
-            if (XMEMCMP(hash, signers->subjectNameHash,
-                        SIGNER_DIGEST_SIZE) == 0) {
-                ret = signers;
-            }
-            signers = signers->next;
+    row = HashSigner(hash, cm->caTableSz);
+    signers = cm->caNameTable[row];
+    while (signers) {
+        if (XMEMCMP(hash, signers->subjectNameHash, SIGNER_DIGEST_SIZE) == 0) {
+            ret = signers;
+            break;
         }
+        signers = signers->nameNext;
     }
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
     return ret;
 }
 #endif
 
 
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+/* row of the verify cache holding a certificate hash */
+static word32 VerifyCacheRow(const byte* certHash, word32 rows)
+{
+    return (((word32)certHash[0] << 24) | ((word32)certHash[1] << 16) |
+            ((word32)certHash[2] << 8)  |  (word32)certHash[3]) % rows;
+}
+
+
+/* Set the hash of the identity of a signer, its key type, key id and public
+ * key, that verify cache entries are kept under. Computed once when the
+ * signer is made. Without it the signer's certificates aren't cached. */
+static void SetSignerVerifyHash(Signer* signer)
+{
+    int ret;
+    byte oid[OPAQUE32_LEN];
+#ifdef WOLFSSL_SMALL_STACK
+    wc_Sha256* sha;
+#else
+    wc_Sha256  sha[1];
+#endif
+
+#ifdef WOLFSSL_SMALL_STACK
+    sha = (wc_Sha256*)XMALLOC(sizeof(wc_Sha256), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    if (sha == NULL)
+        return;
+#endif
+
+    c32toa(signer->keyOID, oid);
+    ret = wc_InitSha256(sha);
+    if (ret == 0) {
+        ret = wc_Sha256Update(sha, oid, sizeof(oid));
+    #ifndef NO_SKID
+        if (ret == 0) {
+            ret = wc_Sha256Update(sha, signer->subjectKeyIdHash,
+                                  SIGNER_DIGEST_SIZE);
+        }
+    #endif
+        if (ret == 0)
+            ret = wc_Sha256Update(sha, signer->publicKey, signer->pubKeySize);
+        if (ret == 0)
+            ret = wc_Sha256Final(sha, signer->verifyHash);
+        wc_Sha256Free(sha);
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(sha, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+
+    signer->verifyHashSet = (ret == 0);
+}
+
+
+/* return 1 if the certificate with certHash was verified by a signer with the
+ * same key before, otherwise 0 */
+int CertVerifyCache_Find(void* vp, const byte* certHash, const Signer* signer)
+{
+    WOLFSSL_CERT_MANAGER* cm = (WOLFSSL_CERT_MANAGER*)vp;
+    CertVerifyEntry* entry;
+    int found = 0;
+
+    if (cm == NULL || signer == NULL || !signer->verifyHashSet)
+        return 0;
+
+    if (wc_LockRwLock_Rd(&cm->verifyLock) != 0)
+        return 0;
+
+    if (cm->verifyCache != NULL) {
+        entry = &cm->verifyCache[VerifyCacheRow(certHash, cm->verifyCacheSz)];
+        found = entry->used &&
+            XMEMCMP(entry->certHash, certHash, WC_SHA256_DIGEST_SIZE) == 0 &&
+            XMEMCMP(entry->signerHash, signer->verifyHash,
+                    WC_SHA256_DIGEST_SIZE) == 0;
+    }
+    wc_UnLockRwLock(&cm->verifyLock);
+
+    return found;
+}
+
+
+/* remember that signer verified the certificate with certHash, replaces the
+ * certificate previously held in its row */
+void CertVerifyCache_Add(void* vp, const byte* certHash, const Signer* signer)
+{
+    WOLFSSL_CERT_MANAGER* cm = (WOLFSSL_CERT_MANAGER*)vp;
+    CertVerifyEntry* entry;
+
+    if (cm == NULL || signer == NULL || !signer->verifyHashSet)
+        return;
+
+    if (wc_LockRwLock_Wr(&cm->verifyLock) != 0)
+        return;
+
+    if (cm->verifyCache == NULL && cm->verifyCacheSz > 0) {
+        cm->verifyCache = (CertVerifyEntry*)XMALLOC(
+                sizeof(CertVerifyEntry) * cm->verifyCacheSz, cm->heap,
+                DYNAMIC_TYPE_CERT_MANAGER);
+        if (cm->verifyCache != NULL) {
+            XMEMSET(cm->verifyCache, 0,
+                    sizeof(CertVerifyEntry) * cm->verifyCacheSz);
+        }
+    }
+    if (cm->verifyCache != NULL) {
+        entry = &cm->verifyCache[VerifyCacheRow(certHash, cm->verifyCacheSz)];
+        XMEMCPY(entry->certHash, certHash, WC_SHA256_DIGEST_SIZE);
+        XMEMCPY(entry->signerHash, signer->verifyHash, WC_SHA256_DIGEST_SIZE);
+        entry->used = 1;
+    }
+    wc_UnLockRwLock(&cm->verifyLock);
+}
+#endif /* WOLFSSL_CERT_VERIFY_CACHE */
+
+
 #ifdef WOLFSSL_TRUST_PEER_CERT
 /* add a trusted peer cert to linked list */
 int AddTrustedPeer(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int verify)
@@ -4450,7 +5091,7 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
 {
     int         ret;
     Signer*     signer = NULL;
-    word32      row;
+    word32      row = 0;
     byte*       subjectHash;
 #ifdef WOLFSSL_SMALL_STACK
     DecodedCert* cert = NULL;
@@ -4597,17 +5238,19 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
         cert->permittedNames = NULL;
         cert->excludedNames = NULL;
     #endif
-
-    #ifndef NO_SKID
-        row = HashSigner(signer->subjectKeyIdHash);
-    #else
-        row = HashSigner(signer->subjectNameHash);
+    #if defined(HAVE_ECC) && defined(WOLFSSL_ECC_KEY_TABLE)
+        /* not fatal, signatures are verified without the table */
+        if (MakeSignerEccTable(signer, cm->heap) != 0) {
+            WOLFSSL_MSG("\tUnable to make ECC table for CA");
+        }
+    #endif
+    #ifdef WOLFSSL_CERT_VERIFY_CACHE
+        SetSignerVerifyHash(signer);
     #endif
 
-        if (wc_LockMutex(&cm->caLock) == 0) {
-            signer->next = cm->caTable[row];
-            cm->caTable[row] = signer;   /* takes ownership */
-            wc_UnLockMutex(&cm->caLock);
+        if (wc_LockRwLock_Wr(&cm->caLock) == 0) {
+            row = AddSignerToTable(cm, signer);   /* takes ownership */
+            wc_UnLockRwLock(&cm->caLock);
             if (cm->caCacheCallback)
                 cm->caCacheCallback(der->buffer, (int)der->length, type);
         }
@@ -4645,6 +5288,7 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
     WOLFSSL_MSG("\tFreeing der CA");
     FreeDer(pDer);
     WOLFSSL_MSG("\t\tOK Freeing der CA");
+    (void)row;
 
     WOLFSSL_LEAVE("AddCA", ret);
 
@@ -4704,13 +5348,16 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
         WOLFSSL_SESSION Sessions[SESSIONS_PER_ROW];
     } SessionRow;
 
-    static WOLFSSL_GLOBAL SessionRow SessionCache[SESSION_ROWS];
-
-    #if defined(WOLFSSL_SESSION_STATS) && defined(WOLFSSL_PEAK_SESSIONS)
-        static WOLFSSL_GLOBAL word32 PeakSessions;
-    #endif
-
-    static WOLFSSL_GLOBAL wolfSSL_Mutex session_mutex; /* SessionCache mutex */
+    /* replacement state and counters of a row, not persisted */
+    typedef struct SessionRowInfo {
+        word32 useCount;                       /* row access counter        */
+        word32 lastUse[SESSIONS_PER_ROW];      /* LRU, useCount at last use */
+        byte   referenced[SESSIONS_PER_ROW];   /* CLOCK, reference bits     */
+        int    hand;                           /* CLOCK, next to consider   */
+        word32 hits;                           /* lookups that found one    */
+        word32 misses;                         /* lookups that didn't       */
+        word32 evictions;                      /* live sessions replaced    */
+    } SessionRowInfo;
 
     #ifndef NO_CLIENT_CACHE
 
@@ -4725,11 +5372,502 @@ int AddCA(WOLFSSL_CERT_MANAGER* cm, DerBuffer** pDer, int type, int verify)
             ClientSession Clients[SESSIONS_PER_ROW];
         } ClientRow;
 
-        static WOLFSSL_GLOBAL ClientRow ClientCache[SESSION_ROWS];
-                                                     /* Client Cache */
-                                                     /* uses session mutex */
     #endif  /* NO_CLIENT_CACHE */
 
+    /* ClientSession row/idx are stored in 16 bits */
+    #ifndef WOLFSSL_SESSION_CACHE_MAX_ROWS
+        #define WOLFSSL_SESSION_CACHE_MAX_ROWS 0xFFFF
+    #endif
+
+    /* A session cache, rows of SESSIONS_PER_ROW sessions picked by a hash of
+       the session ID. Each row is guarded by its own mutex so that lookups
+       and inserts on different rows don't serialize. A client row lock may
+       be taken while holding a session row lock, never the other way
+       around. */
+    struct WOLFSSL_SESSION_CACHE {
+        SessionRow*     rows;
+        wolfSSL_Mutex*  rowLocks;
+        SessionRowInfo* rowInfo;
+    #ifndef NO_CLIENT_CACHE
+        ClientRow*      clientRows;       /* same number of rows as rows */
+        wolfSSL_Mutex*  clientRowLocks;
+    #endif
+        word32          rowCount;
+        word32          timeout;          /* 0 uses the session's timeout */
+        int             policy;           /* WOLFSSL_SESSION_CACHE_FIFO... */
+        int             refCount;
+        wolfSSL_Mutex   refMutex;
+        void*           heap;
+        byte            isStatic:1;       /* rows are the static arrays */
+    };
+
+    #define SESSION_ROW_LOCK(c, row)   wc_LockMutex(&(c)->rowLocks[(row)])
+    #define SESSION_ROW_UNLOCK(c, row) wc_UnLockMutex(&(c)->rowLocks[(row)])
+    #define CLIENT_ROW_LOCK(c, row)    wc_LockMutex(&(c)->clientRowLocks[(row)])
+    #define CLIENT_ROW_UNLOCK(c, row)  wc_UnLockMutex(&(c)->clientRowLocks[(row)])
+
+    /* The compile time presets above size the default, statically allocated
+       process wide cache. wolfSSL_set_session_cache_size() may be used
+       before wolfSSL_Init() to have a cache with a different number of rows
+       allocated instead. A WOLFSSL_CTX may also be given a cache of its own
+       with wolfSSL_CTX_SetSessionCache(). */
+    static WOLFSSL_GLOBAL SessionRow     StaticSessionRows[SESSION_ROWS];
+    static WOLFSSL_GLOBAL wolfSSL_Mutex  StaticSessionRowLocks[SESSION_ROWS];
+    static WOLFSSL_GLOBAL SessionRowInfo StaticSessionRowInfo[SESSION_ROWS];
+    #ifndef NO_CLIENT_CACHE
+        static WOLFSSL_GLOBAL ClientRow     StaticClientRows[SESSION_ROWS];
+        static WOLFSSL_GLOBAL wolfSSL_Mutex StaticClientRowLocks[SESSION_ROWS];
+    #endif
+
+    static WOLFSSL_GLOBAL WOLFSSL_SESSION_CACHE SessionCache;
+    static WOLFSSL_GLOBAL word32 SessionCacheRows = SESSION_ROWS;
+
+    #if defined(WOLFSSL_SESSION_STATS) && defined(WOLFSSL_PEAK_SESSIONS)
+        static WOLFSSL_GLOBAL word32 PeakSessions;
+    #endif
+
+    /* guards cache wide state (PeakSessions) and sessions not stored in a
+       cache, rows have their own locks */
+    static WOLFSSL_GLOBAL wolfSSL_Mutex session_mutex;
+
+
+/* Allocate the rows of cache, zeroed */
+static int SessionCacheAllocRows(WOLFSSL_SESSION_CACHE* cache, word32 rows,
+                                 void* heap)
+{
+    int ret = 0;
+
+    cache->rows = (SessionRow*)XMALLOC(sizeof(SessionRow) * rows, heap,
+                                       DYNAMIC_TYPE_SESSION_CACHE);
+    cache->rowLocks = (wolfSSL_Mutex*)XMALLOC(sizeof(wolfSSL_Mutex) * rows,
+                                       heap, DYNAMIC_TYPE_SESSION_CACHE);
+    cache->rowInfo = (SessionRowInfo*)XMALLOC(sizeof(SessionRowInfo) * rows,
+                                       heap, DYNAMIC_TYPE_SESSION_CACHE);
+    if (cache->rows == NULL || cache->rowLocks == NULL ||
+                                                      cache->rowInfo == NULL) {
+        ret = MEMORY_E;
+    }
+#ifndef NO_CLIENT_CACHE
+    cache->clientRows = (ClientRow*)XMALLOC(sizeof(ClientRow) * rows, heap,
+                                       DYNAMIC_TYPE_SESSION_CACHE);
+    cache->clientRowLocks = (wolfSSL_Mutex*)XMALLOC(sizeof(wolfSSL_Mutex) *
+                                 rows, heap, DYNAMIC_TYPE_SESSION_CACHE);
+    if (cache->clientRows == NULL || cache->clientRowLocks == NULL)
+        ret = MEMORY_E;
+#endif
+
+    if (ret != 0) {
+        WOLFSSL_MSG("Session cache allocation failed");
+        XFREE(cache->rows, heap, DYNAMIC_TYPE_SESSION_CACHE);
+        XFREE(cache->rowLocks, heap, DYNAMIC_TYPE_SESSION_CACHE);
+        XFREE(cache->rowInfo, heap, DYNAMIC_TYPE_SESSION_CACHE);
+        cache->rows     = NULL;
+        cache->rowLocks = NULL;
+        cache->rowInfo  = NULL;
+    #ifndef NO_CLIENT_CACHE
+        XFREE(cache->clientRows, heap, DYNAMIC_TYPE_SESSION_CACHE);
+        XFREE(cache->clientRowLocks, heap, DYNAMIC_TYPE_SESSION_CACHE);
+        cache->clientRows     = NULL;
+        cache->clientRowLocks = NULL;
+    #endif
+        return ret;
+    }
+
+    XMEMSET(cache->rows, 0, sizeof(SessionRow) * rows);
+    XMEMSET(cache->rowInfo, 0, sizeof(SessionRowInfo) * rows);
+#ifndef NO_CLIENT_CACHE
+    XMEMSET(cache->clientRows, 0, sizeof(ClientRow) * rows);
+#endif
+    cache->rowCount = rows;
+    cache->heap     = heap;
+
+    return 0;
+}
+
+
+/* Free the rows of cache unless static, the row locks are already freed */
+static void SessionCacheFreeRowMem(WOLFSSL_SESSION_CACHE* cache)
+{
+#ifdef HAVE_SESSION_TICKET
+    word32 i;
+    int    j;
+#endif
+
+    if (cache->isStatic) {
+        cache->rows = NULL;
+        return;
+    }
+
+#ifdef HAVE_SESSION_TICKET
+    for (i = 0; i < cache->rowCount; i++) {
+        for (j = 0; j < SESSIONS_PER_ROW; j++) {
+            WOLFSSL_SESSION* session = &cache->rows[i].Sessions[j];
+            if (session->isDynamic) {
+                XFREE(session->ticket, NULL, DYNAMIC_TYPE_SESSION_TICK);
+            }
+        }
+    }
+#endif
+
+    XFREE(cache->rows, cache->heap, DYNAMIC_TYPE_SESSION_CACHE);
+    XFREE(cache->rowLocks, cache->heap, DYNAMIC_TYPE_SESSION_CACHE);
+    XFREE(cache->rowInfo, cache->heap, DYNAMIC_TYPE_SESSION_CACHE);
+#ifndef NO_CLIENT_CACHE
+    XFREE(cache->clientRows, cache->heap, DYNAMIC_TYPE_SESSION_CACHE);
+    XFREE(cache->clientRowLocks, cache->heap, DYNAMIC_TYPE_SESSION_CACHE);
+#endif
+    cache->rows = NULL;
+}
+
+
+/* Free the first count row locks of cache */
+static void SessionCacheFreeLocks(WOLFSSL_SESSION_CACHE* cache, word32 count)
+{
+    word32 i;
+
+    for (i = 0; i < count; i++) {
+        wc_FreeMutex(&cache->rowLocks[i]);
+    #ifndef NO_CLIENT_CACHE
+        wc_FreeMutex(&cache->clientRowLocks[i]);
+    #endif
+    }
+}
+
+
+/* Free the row locks and, unless static, the rows of cache */
+static void SessionCacheFreeRows(WOLFSSL_SESSION_CACHE* cache)
+{
+    if (cache->rows == NULL)
+        return;
+
+    SessionCacheFreeLocks(cache, cache->rowCount);
+    SessionCacheFreeRowMem(cache);
+}
+
+
+/* Initialize the row locks of cache. On failure the locks made so far are
+ * freed again. */
+static int SessionCacheInitLocks(WOLFSSL_SESSION_CACHE* cache)
+{
+    word32 i;
+
+    for (i = 0; i < cache->rowCount; i++) {
+        if (wc_InitMutex(&cache->rowLocks[i]) != 0) {
+            WOLFSSL_MSG("Bad Init Mutex session row");
+            SessionCacheFreeLocks(cache, i);
+            return BAD_MUTEX_E;
+        }
+    #ifndef NO_CLIENT_CACHE
+        if (wc_InitMutex(&cache->clientRowLocks[i]) != 0) {
+            WOLFSSL_MSG("Bad Init Mutex client row");
+            wc_FreeMutex(&cache->rowLocks[i]);
+            SessionCacheFreeLocks(cache, i);
+            return BAD_MUTEX_E;
+        }
+    #endif
+    }
+
+    return 0;
+}
+
+
+/* Release the process wide session cache rows and their locks */
+static void FreeSessionCache(void)
+{
+    SessionCacheFreeRows(&SessionCache);
+}
+
+
+/* Set up the process wide session cache, allocating the rows if the requested
+   number of rows isn't the compile time default */
+static int InitSessionCache(void)
+{
+    int ret;
+
+    SessionCache.timeout  = 0;
+    SessionCache.policy   = WOLFSSL_SESSION_CACHE_FIFO;
+    SessionCache.refCount = 1;
+
+    if (SessionCacheRows != SESSION_ROWS) {
+        SessionCache.isStatic = 0;
+        ret = SessionCacheAllocRows(&SessionCache, SessionCacheRows, NULL);
+        if (ret != 0) {
+            SessionCacheRows = SESSION_ROWS;
+            return ret;
+        }
+    }
+    else {
+        SessionCache.rows     = StaticSessionRows;
+        SessionCache.rowLocks = StaticSessionRowLocks;
+        SessionCache.rowInfo  = StaticSessionRowInfo;
+    #ifndef NO_CLIENT_CACHE
+        SessionCache.clientRows     = StaticClientRows;
+        SessionCache.clientRowLocks = StaticClientRowLocks;
+    #endif
+        SessionCache.rowCount = SESSION_ROWS;
+        SessionCache.heap     = NULL;
+        SessionCache.isStatic = 1;
+    }
+
+    ret = SessionCacheInitLocks(&SessionCache);
+    if (ret != 0) {
+        SessionCacheFreeRowMem(&SessionCache);
+        SessionCacheRows = SESSION_ROWS;
+    }
+
+    return ret;
+}
+
+
+/* Set the number of sessions the internal session cache holds, rounded up to
+   whole rows of SESSIONS_PER_ROW. The cache is sized when the library is
+   initialized so this has to be called before wolfSSL_Init() (or after the
+   last wolfSSL_Cleanup()). Using 0 goes back to the compile time default.
+   Returns WOLFSSL_SUCCESS on ok */
+int wolfSSL_set_session_cache_size(word32 sessions)
+{
+    word32 rows;
+
+    WOLFSSL_ENTER("wolfSSL_set_session_cache_size");
+
+    if (initRefCount != 0) {
+        WOLFSSL_MSG("Session cache size must be set before wolfSSL_Init");
+        return BAD_STATE_E;
+    }
+
+    if (sessions == 0)
+        rows = SESSION_ROWS;
+    else
+        rows = sessions / SESSIONS_PER_ROW +
+               ((sessions % SESSIONS_PER_ROW) != 0 ? 1 : 0);
+
+    if (rows > WOLFSSL_SESSION_CACHE_MAX_ROWS)
+        return BAD_FUNC_ARG;
+
+    SessionCacheRows = rows;
+
+    return WOLFSSL_SUCCESS;
+}
+
+
+/* Create a session cache that can be attached to one or more WOLFSSL_CTX
+   with wolfSSL_CTX_SetSessionCache() instead of the process wide one.
+   sessions is rounded up to whole rows, timeout (seconds) overrides the
+   timeout of the sessions stored when non zero and policy is one of
+   WOLFSSL_SESSION_CACHE_FIFO, WOLFSSL_SESSION_CACHE_LRU or
+   WOLFSSL_SESSION_CACHE_CLOCK, used to pick which session of a full row to
+   replace. Returns the new cache or NULL on error */
+WOLFSSL_SESSION_CACHE* wolfSSL_SessionCacheNew(word32 sessions, word32 timeout,
+                                               int policy, void* heap)
+{
+    WOLFSSL_SESSION_CACHE* cache;
+    word32 rows;
+
+    WOLFSSL_ENTER("wolfSSL_SessionCacheNew");
+
+    if (sessions == 0)
+        return NULL;
+    if (policy != WOLFSSL_SESSION_CACHE_FIFO &&
+            policy != WOLFSSL_SESSION_CACHE_LRU &&
+            policy != WOLFSSL_SESSION_CACHE_CLOCK) {
+        return NULL;
+    }
+
+    rows = sessions / SESSIONS_PER_ROW +
+           ((sessions % SESSIONS_PER_ROW) != 0 ? 1 : 0);
+    if (rows > WOLFSSL_SESSION_CACHE_MAX_ROWS)
+        return NULL;
+
+    cache = (WOLFSSL_SESSION_CACHE*)XMALLOC(sizeof(WOLFSSL_SESSION_CACHE), heap,
+                                            DYNAMIC_TYPE_SESSION_CACHE);
+    if (cache == NULL)
+        return NULL;
+    XMEMSET(cache, 0, sizeof(WOLFSSL_SESSION_CACHE));
+
+    if (SessionCacheAllocRows(cache, rows, heap) != 0) {
+        XFREE(cache, heap, DYNAMIC_TYPE_SESSION_CACHE);
+        return NULL;
+    }
+    cache->timeout  = timeout;
+    cache->policy   = policy;
+    cache->refCount = 1;
+
+    if (wc_InitMutex(&cache->refMutex) != 0) {
+        SessionCacheFreeRowMem(cache);
+        XFREE(cache, heap, DYNAMIC_TYPE_SESSION_CACHE);
+        return NULL;
+    }
+    if (SessionCacheInitLocks(cache) != 0) {
+        SessionCacheFreeRowMem(cache);
+        wc_FreeMutex(&cache->refMutex);
+        XFREE(cache, heap, DYNAMIC_TYPE_SESSION_CACHE);
+        return NULL;
+    }
+
+    WOLFSSL_LEAVE("wolfSSL_SessionCacheNew", 0);
+
+    return cache;
+}
+
+
+/* Release a reference to cache, freed when no WOLFSSL_CTX uses it anymore */
+void wolfSSL_SessionCacheFree(WOLFSSL_SESSION_CACHE* cache)
+{
+    int doFree = 0;
+    void* heap;
+
+    WOLFSSL_ENTER("wolfSSL_SessionCacheFree");
+
+    if (cache == NULL || cache == &SessionCache)
+        return;
+
+    if (wc_LockMutex(&cache->refMutex) != 0) {
+        WOLFSSL_MSG("Couldn't lock session cache mutex");
+        return;
+    }
+    if (--cache->refCount == 0)
+        doFree = 1;
+    wc_UnLockMutex(&cache->refMutex);
+
+    if (doFree) {
+        heap = cache->heap;
+        SessionCacheFreeRows(cache);
+        wc_FreeMutex(&cache->refMutex);
+        XFREE(cache, heap, DYNAMIC_TYPE_SESSION_CACHE);
+        (void)heap;
+    }
+}
+
+
+/* Use cache for the sessions of connections made from ctx instead of the
+   process wide cache. NULL goes back to the process wide cache. The ctx
+   holds a reference to cache. Returns WOLFSSL_SUCCESS on ok */
+int wolfSSL_CTX_SetSessionCache(WOLFSSL_CTX* ctx, WOLFSSL_SESSION_CACHE* cache)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_SetSessionCache");
+
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+
+    if (cache != NULL) {
+        if (wc_LockMutex(&cache->refMutex) != 0)
+            return BAD_MUTEX_E;
+        cache->refCount++;
+        wc_UnLockMutex(&cache->refMutex);
+    }
+
+    wolfSSL_SessionCacheFree(ctx->sessionCache);
+    ctx->sessionCache = cache;
+
+    return WOLFSSL_SUCCESS;
+}
+
+
+/* Get the statistics of cache, NULL for the process wide cache. Any of the
+   outputs may be NULL. Returns WOLFSSL_SUCCESS on ok */
+int wolfSSL_SessionCacheGetStats(WOLFSSL_SESSION_CACHE* cache, word32* active,
+                                 word32* hits, word32* misses,
+                                 word32* evictions)
+{
+    word32 i;
+    int    idx;
+    word32 now = LowResTimer();
+
+    WOLFSSL_ENTER("wolfSSL_SessionCacheGetStats");
+
+    if (cache == NULL)
+        cache = &SessionCache;
+    if (cache->rows == NULL)
+        return BAD_STATE_E;
+
+    if (active)    *active = 0;
+    if (hits)      *hits = 0;
+    if (misses)    *misses = 0;
+    if (evictions) *evictions = 0;
+
+    for (i = 0; i < cache->rowCount; i++) {
+        SessionRow* row = &cache->rows[i];
+
+        if (SESSION_ROW_LOCK(cache, i) != 0)
+            return BAD_MUTEX_E;
+
+        if (active) {
+            for (idx = 0; idx < (int)min((word32)row->totalCount,
+                                               SESSIONS_PER_ROW); idx++) {
+                if (now < row->Sessions[idx].bornOn +
+                                                row->Sessions[idx].timeout) {
+                    (*active)++;
+                }
+            }
+        }
+        if (hits)      *hits      += cache->rowInfo[i].hits;
+        if (misses)    *misses    += cache->rowInfo[i].misses;
+        if (evictions) *evictions += cache->rowInfo[i].evictions;
+
+        SESSION_ROW_UNLOCK(cache, i);
+    }
+
+    return WOLFSSL_SUCCESS;
+}
+
+/* Get the session cache connections of ssl use */
+static WC_INLINE WOLFSSL_SESSION_CACHE* GetSessionCache(WOLFSSL* ssl)
+{
+    if (ssl->ctx != NULL && ssl->ctx->sessionCache != NULL)
+        return ssl->ctx->sessionCache;
+    return &SessionCache;
+}
+
+
+/* Record a use of the session at idx of a row, row lock held */
+static WC_INLINE void SessionRowTouch(SessionRowInfo* info, int idx)
+{
+    info->lastUse[idx]    = ++info->useCount;
+    info->referenced[idx] = 1;
+}
+
+
+/* Pick the session of a full row to replace with the policy of cache, an
+   expired session if there is one. Row lock held, returns the idx */
+static int SessionRowVictim(WOLFSSL_SESSION_CACHE* cache, word32 row)
+{
+    SessionRow*     sessRow = &cache->rows[row];
+    SessionRowInfo* info    = &cache->rowInfo[row];
+    word32          now     = LowResTimer();
+    word32          age, oldest = 0;
+    int             victim  = 0;
+    int             i;
+
+    for (i = 0; i < SESSIONS_PER_ROW; i++) {
+        if (now >= sessRow->Sessions[i].bornOn + sessRow->Sessions[i].timeout)
+            return i;
+    }
+
+    if (cache->policy == WOLFSSL_SESSION_CACHE_CLOCK) {
+        /* second chance, clear reference bits until one is found unset */
+        for (i = 0; i < 2 * SESSIONS_PER_ROW; i++) {
+            victim = info->hand;
+            info->hand = (info->hand + 1) % SESSIONS_PER_ROW;
+            if (!info->referenced[victim])
+                break;
+            info->referenced[victim] = 0;
+        }
+    }
+    else {
+        /* least recently used, age is modulo the row use counter */
+        for (i = 0; i < SESSIONS_PER_ROW; i++) {
+            age = info->useCount - info->lastUse[i];
+            if (age > oldest) {
+                oldest = age;
+                victim = i;
+            }
+        }
+    }
+
+    return victim;
+}
+
+
 #endif /* NO_SESSION_CACHE */
 
 WOLFSSL_ABI
@@ -4756,6 +5894,10 @@ int wolfSSL_Init(void)
             WOLFSSL_MSG("Bad Init Mutex session");
             return BAD_MUTEX_E;
         }
+        if (InitSessionCache() != 0) {
+            WOLFSSL_MSG("Session cache init failed");
+            return WC_INIT_E;
+        }
 #endif
         if (wc_InitMutex(&count_mutex) != 0) {
             WOLFSSL_MSG("Bad Init Mutex count");
@@ -6334,6 +7476,54 @@ int wolfSSL_CertManagerSetOCSP_Cb(WOLFSSL_CERT_MANAGER* cm,
 }
 
 
+/* Bound the number of OCSP responses kept by each of the OCSP and OCSP
+ * stapling caches, 0 for no limit. Expired responses are dropped first, then
+ * the ones cached the longest. */
+int wolfSSL_CertManagerSetOCSPCacheSize(WOLFSSL_CERT_MANAGER* cm, int sz)
+{
+    WOLFSSL_ENTER("wolfSSL_CertManagerSetOCSPCacheSize");
+    if (cm == NULL || sz < 0)
+        return BAD_FUNC_ARG;
+
+    cm->ocspCacheSz = sz;
+
+    return WOLFSSL_SUCCESS;
+}
+
+
+/* Fetch new responses for cached ones older than maxAge seconds or past their
+ * nextUpdate. Meant to be called periodically by the application so that
+ * certificate checks and stapling are served from the cache.
+ *
+ * Returns the number of refreshed responses or a negative error. */
+int wolfSSL_CertManagerRefreshOCSP(WOLFSSL_CERT_MANAGER* cm,
+                                   unsigned int maxAge)
+{
+    int ret = 0;
+    int refreshed = 0;
+
+    WOLFSSL_ENTER("wolfSSL_CertManagerRefreshOCSP");
+    if (cm == NULL)
+        return BAD_FUNC_ARG;
+
+    if (cm->ocsp != NULL) {
+        ret = RefreshOCSP(cm->ocsp, maxAge);
+        if (ret > 0)
+            refreshed += ret;
+    }
+#if !defined(NO_WOLFSSL_SERVER) && (defined(HAVE_CERTIFICATE_STATUS_REQUEST) \
+                               ||  defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2))
+    if (ret >= 0 && cm->ocsp_stapling != NULL) {
+        ret = RefreshOCSP(cm->ocsp_stapling, maxAge);
+        if (ret > 0)
+            refreshed += ret;
+    }
+#endif
+
+    return ret < 0 ? ret : refreshed;
+}
+
+
 int wolfSSL_EnableOCSP(WOLFSSL* ssl, int options)
 {
     WOLFSSL_ENTER("wolfSSL_EnableOCSP");
@@ -6436,6 +7626,26 @@ int wolfSSL_CTX_SetOCSP_Cb(WOLFSSL_CTX* ctx, CbOCSPIO ioCb,
         return BAD_FUNC_ARG;
 }
 
+
+int wolfSSL_CTX_SetOCSPCacheSize(WOLFSSL_CTX* ctx, int sz)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_SetOCSPCacheSize");
+    if (ctx)
+        return wolfSSL_CertManagerSetOCSPCacheSize(ctx->cm, sz);
+    else
+        return BAD_FUNC_ARG;
+}
+
+
+int wolfSSL_CTX_RefreshOCSP(WOLFSSL_CTX* ctx, unsigned int maxAge)
+{
+    WOLFSSL_ENTER("wolfSSL_CTX_RefreshOCSP");
+    if (ctx)
+        return wolfSSL_CertManagerRefreshOCSP(ctx->cm, maxAge);
+    else
+        return BAD_FUNC_ARG;
+}
+
 #if defined(HAVE_CERTIFICATE_STATUS_REQUEST) \
  || defined(HAVE_CERTIFICATE_STATUS_REQUEST_V2)
 int wolfSSL_CTX_EnableOCSPStapling(WOLFSSL_CTX* ctx)
@@ -10154,10 +11364,11 @@ typedef struct {
 /* get how big the the session cache save buffer needs to be */
 int wolfSSL_get_session_cache_memsize(void)
 {
-    int sz  = (int)(sizeof(SessionCache) + sizeof(cache_header_t));
+    int sz  = (int)(sizeof(SessionRow) * SessionCacheRows +
+                    sizeof(cache_header_t));
 
     #ifndef NO_CLIENT_CACHE
-        sz += (int)(sizeof(ClientCache));
+        sz += (int)(sizeof(ClientRow) * SessionCacheRows);
     #endif
 
     return sz;
@@ -10182,27 +11393,32 @@ int wolfSSL_memsave_session_cache(void* mem, int sz)
     }
 
     cache_header.version   = WOLFSSL_CACHE_VERSION;
-    cache_header.rows      = SESSION_ROWS;
+    cache_header.rows      = (int)SessionCacheRows;
     cache_header.columns   = SESSIONS_PER_ROW;
     cache_header.sessionSz = (int)sizeof(WOLFSSL_SESSION);
     XMEMCPY(mem, &cache_header, sizeof(cache_header));
 
-    if (wc_LockMutex(&session_mutex) != 0) {
-        WOLFSSL_MSG("Session cache mutex lock failed");
-        return BAD_MUTEX_E;
+    for (i = 0; i < cache_header.rows; ++i) {
+        if (SESSION_ROW_LOCK(&SessionCache, i) != 0) {
+            WOLFSSL_MSG("Session cache mutex lock failed");
+            return BAD_MUTEX_E;
+        }
+        XMEMCPY(row++, SessionCache.rows + i, sizeof(SessionRow));
+        SESSION_ROW_UNLOCK(&SessionCache, i);
     }
 
-    for (i = 0; i < cache_header.rows; ++i)
-        XMEMCPY(row++, SessionCache + i, sizeof(SessionRow));
-
 #ifndef NO_CLIENT_CACHE
     clRow = (ClientRow*)row;
-    for (i = 0; i < cache_header.rows; ++i)
-        XMEMCPY(clRow++, ClientCache + i, sizeof(ClientRow));
+    for (i = 0; i < cache_header.rows; ++i) {
+        if (CLIENT_ROW_LOCK(&SessionCache, i) != 0) {
+            WOLFSSL_MSG("Client cache mutex lock failed");
+            return BAD_MUTEX_E;
+        }
+        XMEMCPY(clRow++, SessionCache.clientRows + i, sizeof(ClientRow));
+        CLIENT_ROW_UNLOCK(&SessionCache, i);
+    }
 #endif
 
-    wc_UnLockMutex(&session_mutex);
-
     WOLFSSL_LEAVE("wolfSSL_memsave_session_cache", WOLFSSL_SUCCESS);
 
     return WOLFSSL_SUCCESS;
@@ -10228,7 +11444,7 @@ int wolfSSL_memrestore_session_cache(const void* mem, int sz)
 
     XMEMCPY(&cache_header, mem, sizeof(cache_header));
     if (cache_header.version   != WOLFSSL_CACHE_VERSION ||
-        cache_header.rows      != SESSION_ROWS ||
+        cache_header.rows      != (int)SessionCacheRows ||
         cache_header.columns   != SESSIONS_PER_ROW ||
         cache_header.sessionSz != (int)sizeof(WOLFSSL_SESSION)) {
 
@@ -10236,22 +11452,27 @@ int wolfSSL_memrestore_session_cache(const void* mem, int sz)
         return CACHE_MATCH_ERROR;
     }
 
-    if (wc_LockMutex(&session_mutex) != 0) {
-        WOLFSSL_MSG("Session cache mutex lock failed");
-        return BAD_MUTEX_E;
+    for (i = 0; i < cache_header.rows; ++i) {
+        if (SESSION_ROW_LOCK(&SessionCache, i) != 0) {
+            WOLFSSL_MSG("Session cache mutex lock failed");
+            return BAD_MUTEX_E;
+        }
+        XMEMCPY(SessionCache.rows + i, row++, sizeof(SessionRow));
+        SESSION_ROW_UNLOCK(&SessionCache, i);
     }
 
-    for (i = 0; i < cache_header.rows; ++i)
-        XMEMCPY(SessionCache + i, row++, sizeof(SessionRow));
-
 #ifndef NO_CLIENT_CACHE
     clRow = (ClientRow*)row;
-    for (i = 0; i < cache_header.rows; ++i)
-        XMEMCPY(ClientCache + i, clRow++, sizeof(ClientRow));
+    for (i = 0; i < cache_header.rows; ++i) {
+        if (CLIENT_ROW_LOCK(&SessionCache, i) != 0) {
+            WOLFSSL_MSG("Client cache mutex lock failed");
+            return BAD_MUTEX_E;
+        }
+        XMEMCPY(SessionCache.clientRows + i, clRow++, sizeof(ClientRow));
+        CLIENT_ROW_UNLOCK(&SessionCache, i);
+    }
 #endif
 
-    wc_UnLockMutex(&session_mutex);
-
     WOLFSSL_LEAVE("wolfSSL_memrestore_session_cache", WOLFSSL_SUCCESS);
 
     return WOLFSSL_SUCCESS;
@@ -10277,7 +11498,7 @@ int wolfSSL_save_session_cache(const char *fname)
         return WOLFSSL_BAD_FILE;
     }
     cache_header.version   = WOLFSSL_CACHE_VERSION;
-    cache_header.rows      = SESSION_ROWS;
+    cache_header.rows      = (int)SessionCacheRows;
     cache_header.columns   = SESSIONS_PER_ROW;
     cache_header.sessionSz = (int)sizeof(WOLFSSL_SESSION);
 
@@ -10289,15 +11510,15 @@ int wolfSSL_save_session_cache(const char *fname)
         return FWRITE_ERROR;
     }
 
-    if (wc_LockMutex(&session_mutex) != 0) {
-        WOLFSSL_MSG("Session cache mutex lock failed");
-        XFCLOSE(file);
-        return BAD_MUTEX_E;
-    }
-
     /* session cache */
     for (i = 0; i < cache_header.rows; ++i) {
-        ret = (int)XFWRITE(SessionCache + i, sizeof(SessionRow), 1, file);
+        if (SESSION_ROW_LOCK(&SessionCache, i) != 0) {
+            WOLFSSL_MSG("Session cache mutex lock failed");
+            rc = BAD_MUTEX_E;
+            break;
+        }
+        ret = (int)XFWRITE(SessionCache.rows + i, sizeof(SessionRow), 1, file);
+        SESSION_ROW_UNLOCK(&SessionCache, i);
         if (ret != 1) {
             WOLFSSL_MSG("Session cache member file write failed");
             rc = FWRITE_ERROR;
@@ -10307,8 +11528,14 @@ int wolfSSL_save_session_cache(const char *fname)
 
 #ifndef NO_CLIENT_CACHE
     /* client cache */
-    for (i = 0; i < cache_header.rows; ++i) {
-        ret = (int)XFWRITE(ClientCache + i, sizeof(ClientRow), 1, file);
+    for (i = 0; rc == WOLFSSL_SUCCESS && i < cache_header.rows; ++i) {
+        if (CLIENT_ROW_LOCK(&SessionCache, i) != 0) {
+            WOLFSSL_MSG("Client cache mutex lock failed");
+            rc = BAD_MUTEX_E;
+            break;
+        }
+        ret = (int)XFWRITE(SessionCache.clientRows + i, sizeof(ClientRow), 1, file);
+        CLIENT_ROW_UNLOCK(&SessionCache, i);
         if (ret != 1) {
             WOLFSSL_MSG("Client cache member file write failed");
             rc = FWRITE_ERROR;
@@ -10317,8 +11544,6 @@ int wolfSSL_save_session_cache(const char *fname)
     }
 #endif /* NO_CLIENT_CACHE */
 
-    wc_UnLockMutex(&session_mutex);
-
     XFCLOSE(file);
     WOLFSSL_LEAVE("wolfSSL_save_session_cache", rc);
 
@@ -10351,7 +11576,7 @@ int wolfSSL_restore_session_cache(const char *fname)
         return FREAD_ERROR;
     }
     if (cache_header.version   != WOLFSSL_CACHE_VERSION ||
-        cache_header.rows      != SESSION_ROWS ||
+        cache_header.rows      != (int)SessionCacheRows ||
         cache_header.columns   != SESSIONS_PER_ROW ||
         cache_header.sessionSz != (int)sizeof(WOLFSSL_SESSION)) {
 
@@ -10360,39 +11585,57 @@ int wolfSSL_restore_session_cache(const char *fname)
         return CACHE_MATCH_ERROR;
     }
 
-    if (wc_LockMutex(&session_mutex) != 0) {
-        WOLFSSL_MSG("Session cache mutex lock failed");
-        XFCLOSE(file);
-        return BAD_MUTEX_E;
-    }
-
     /* session cache */
     for (i = 0; i < cache_header.rows; ++i) {
-        ret = (int)XFREAD(SessionCache + i, sizeof(SessionRow), 1, file);
+        if (SESSION_ROW_LOCK(&SessionCache, i) != 0) {
+            WOLFSSL_MSG("Session cache mutex lock failed");
+            rc = BAD_MUTEX_E;
+            break;
+        }
+        ret = (int)XFREAD(SessionCache.rows + i, sizeof(SessionRow), 1, file);
+        SESSION_ROW_UNLOCK(&SessionCache, i);
         if (ret != 1) {
             WOLFSSL_MSG("Session cache member file read failed");
-            XMEMSET(SessionCache, 0, sizeof SessionCache);
             rc = FREAD_ERROR;
             break;
         }
     }
+    if (rc == FREAD_ERROR) {
+        for (i = 0; i < cache_header.rows; ++i) {
+            if (SESSION_ROW_LOCK(&SessionCache, i) == 0) {
+                XMEMSET(SessionCache.rows + i, 0, sizeof(SessionRow));
+                SESSION_ROW_UNLOCK(&SessionCache, i);
+            }
+        }
+    }
 
 #ifndef NO_CLIENT_CACHE
     /* client cache */
-    for (i = 0; i < cache_header.rows; ++i) {
-        ret = (int)XFREAD(ClientCache + i, sizeof(ClientRow), 1, file);
+    for (i = 0; rc == WOLFSSL_SUCCESS && i < cache_header.rows; ++i) {
+        if (CLIENT_ROW_LOCK(&SessionCache, i) != 0) {
+            WOLFSSL_MSG("Client cache mutex lock failed");
+            rc = BAD_MUTEX_E;
+            break;
+        }
+        ret = (int)XFREAD(SessionCache.clientRows + i, sizeof(ClientRow), 1, file);
+        CLIENT_ROW_UNLOCK(&SessionCache, i);
         if (ret != 1) {
             WOLFSSL_MSG("Client cache member file read failed");
-            XMEMSET(ClientCache, 0, sizeof ClientCache);
             rc = FREAD_ERROR;
             break;
         }
     }
+    if (rc == FREAD_ERROR) {
+        for (i = 0; i < cache_header.rows; ++i) {
+            if (CLIENT_ROW_LOCK(&SessionCache, i) == 0) {
+                XMEMSET(SessionCache.clientRows + i, 0, sizeof(ClientRow));
+                CLIENT_ROW_UNLOCK(&SessionCache, i);
+            }
+        }
+    }
 
 #endif /* NO_CLIENT_CACHE */
 
-    wc_UnLockMutex(&session_mutex);
-
     XFCLOSE(file);
     WOLFSSL_LEAVE("wolfSSL_restore_session_cache", rc);
 
@@ -10466,19 +11709,18 @@ long wolfSSL_CTX_set_session_cache_mode(WOLFSSL_CTX* ctx, long mode)
 #if defined(PERSIST_CERT_CACHE)
 
 
-#define WOLFSSL_CACHE_CERT_VERSION 1
+#define WOLFSSL_CACHE_CERT_VERSION 2
 
 typedef struct {
     int version;                 /* cache cert layout version id */
-    int rows;                    /* hash table rows, CA_TABLE_SIZE */
-    int columns[CA_TABLE_SIZE];  /* columns per row on list */
+    int signers;                 /* number of signers stored */
     int signerSz;                /* sizeof Signer object */
 } CertCacheHeader;
 
 /* current cert persistence layout is:
 
    1) CertCacheHeader
-   2) caTable
+   2) caTable signers, rehashed into the table on restore
 
    update WOLFSSL_CERT_CACHE_VERSION if change layout for the following
    PERSIST_CERT_CACHE functions
@@ -10525,41 +11767,22 @@ static WC_INLINE int GetCertCacheMemSize(WOLFSSL_CERT_MANAGER* cm)
 
     sz = sizeof(CertCacheHeader);
 
-    for (i = 0; i < CA_TABLE_SIZE; i++)
+    for (i = 0; i < (int)cm->caTableSz; i++)
         sz += GetCertCacheRowMemory(cm->caTable[i]);
 
     return sz;
 }
 
 
-/* Store cert cache header columns with number of items per list, have lock */
-static WC_INLINE void SetCertHeaderColumns(WOLFSSL_CERT_MANAGER* cm, int* columns)
-{
-    int     i;
-    Signer* row;
-
-    for (i = 0; i < CA_TABLE_SIZE; i++) {
-        int count = 0;
-        row = cm->caTable[i];
-
-        while (row) {
-            ++count;
-            row = row->next;
-        }
-        columns[i] = count;
-    }
-}
-
-
-/* Restore whole cert row from memory, have lock, return bytes consumed,
-   < 0 on error, have lock */
-static WC_INLINE int RestoreCertRow(WOLFSSL_CERT_MANAGER* cm, byte* current,
-                                 int row, int listSz, const byte* end)
+/* Restore listSz signers from memory, return bytes consumed, < 0 on error,
+   have lock */
+static WC_INLINE int RestoreCertSigners(WOLFSSL_CERT_MANAGER* cm, byte* current,
+                                        int listSz, const byte* end)
 {
     int idx = 0;
 
     if (listSz < 0) {
-        WOLFSSL_MSG("Row header corrupted, negative value");
+        WOLFSSL_MSG("Cache header corrupted, negative value");
         return PARSE_ERROR;
     }
 
@@ -10636,8 +11859,16 @@ static WC_INLINE int RestoreCertRow(WOLFSSL_CERT_MANAGER* cm, byte* current,
             idx += SIGNER_DIGEST_SIZE;
         #endif
 
-        signer->next = cm->caTable[row];
-        cm->caTable[row] = signer;
+        #if defined(HAVE_ECC) && defined(WOLFSSL_ECC_KEY_TABLE)
+            if (MakeSignerEccTable(signer, cm->heap) != 0) {
+                WOLFSSL_MSG("Unable to make ECC table for restored CA");
+            }
+        #endif
+        #ifdef WOLFSSL_CERT_VERIFY_CACHE
+            SetSignerVerifyHash(signer);
+        #endif
+
+        (void)AddSignerToTable(cm, signer);
 
         --listSz;
     }
@@ -10703,14 +11934,13 @@ static WC_INLINE int DoMemSaveCertCache(WOLFSSL_CERT_MANAGER* cm,
         CertCacheHeader hdr;
 
         hdr.version  = WOLFSSL_CACHE_CERT_VERSION;
-        hdr.rows     = CA_TABLE_SIZE;
-        SetCertHeaderColumns(cm, hdr.columns);
+        hdr.signers  = (int)cm->caCount;
         hdr.signerSz = (int)sizeof(Signer);
 
         XMEMCPY(mem, &hdr, sizeof(CertCacheHeader));
         current = (byte*)mem + sizeof(CertCacheHeader);
 
-        for (i = 0; i < CA_TABLE_SIZE; ++i)
+        for (i = 0; i < (int)cm->caTableSz; ++i)
             current += StoreCertRow(cm, current, i);
     }
 
@@ -10736,8 +11966,8 @@ int CM_SaveCertCache(WOLFSSL_CERT_MANAGER* cm, const char* fname)
        return WOLFSSL_BAD_FILE;
     }
 
-    if (wc_LockMutex(&cm->caLock) != 0) {
-        WOLFSSL_MSG("wc_LockMutex on caLock failed");
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0) {
+        WOLFSSL_MSG("Lock on caLock failed");
         XFCLOSE(file);
         return BAD_MUTEX_E;
     }
@@ -10759,7 +11989,7 @@ int CM_SaveCertCache(WOLFSSL_CERT_MANAGER* cm, const char* fname)
         XFREE(mem, cm->heap, DYNAMIC_TYPE_TMP_BUFFER);
     }
 
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
     XFCLOSE(file);
 
     return rc;
@@ -10830,8 +12060,8 @@ int CM_MemSaveCertCache(WOLFSSL_CERT_MANAGER* cm, void* mem, int sz, int* used)
 
     WOLFSSL_ENTER("CM_MemSaveCertCache");
 
-    if (wc_LockMutex(&cm->caLock) != 0) {
-        WOLFSSL_MSG("wc_LockMutex on caLock failed");
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0) {
+        WOLFSSL_MSG("Lock on caLock failed");
         return BAD_MUTEX_E;
     }
 
@@ -10839,7 +12069,7 @@ int CM_MemSaveCertCache(WOLFSSL_CERT_MANAGER* cm, void* mem, int sz, int* used)
     if (ret == WOLFSSL_SUCCESS)
         *used  = GetCertCacheMemSize(cm);
 
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
     return ret;
 }
@@ -10849,7 +12079,7 @@ int CM_MemSaveCertCache(WOLFSSL_CERT_MANAGER* cm, void* mem, int sz, int* used)
 int CM_MemRestoreCertCache(WOLFSSL_CERT_MANAGER* cm, const void* mem, int sz)
 {
     int ret = WOLFSSL_SUCCESS;
-    int i;
+    int added;
     CertCacheHeader* hdr = (CertCacheHeader*)mem;
     byte*            current = (byte*)mem + sizeof(CertCacheHeader);
     byte*            end     = (byte*)mem + sz;  /* don't go over */
@@ -10862,31 +12092,26 @@ int CM_MemRestoreCertCache(WOLFSSL_CERT_MANAGER* cm, const void* mem, int sz)
     }
 
     if (hdr->version  != WOLFSSL_CACHE_CERT_VERSION ||
-        hdr->rows     != CA_TABLE_SIZE ||
         hdr->signerSz != (int)sizeof(Signer)) {
 
         WOLFSSL_MSG("Cert Cache Memory header mismatch");
         return CACHE_MATCH_ERROR;
     }
 
-    if (wc_LockMutex(&cm->caLock) != 0) {
-        WOLFSSL_MSG("wc_LockMutex on caLock failed");
+    if (wc_LockRwLock_Wr(&cm->caLock) != 0) {
+        WOLFSSL_MSG("Lock on caLock failed");
         return BAD_MUTEX_E;
     }
 
-    FreeSignerTable(cm->caTable, CA_TABLE_SIZE, cm->heap);
+    UnloadCATable(cm);
 
-    for (i = 0; i < CA_TABLE_SIZE; ++i) {
-        int added = RestoreCertRow(cm, current, i, hdr->columns[i], end);
-        if (added < 0) {
-            WOLFSSL_MSG("RestoreCertRow error");
-            ret = added;
-            break;
-        }
-        current += added;
+    added = RestoreCertSigners(cm, current, hdr->signers, end);
+    if (added < 0) {
+        WOLFSSL_MSG("RestoreCertSigners error");
+        ret = added;
     }
 
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
     return ret;
 }
@@ -10899,14 +12124,14 @@ int CM_GetCertCacheMemSize(WOLFSSL_CERT_MANAGER* cm)
 
     WOLFSSL_ENTER("CM_GetCertCacheMemSize");
 
-    if (wc_LockMutex(&cm->caLock) != 0) {
-        WOLFSSL_MSG("wc_LockMutex on caLock failed");
+    if (wc_LockRwLock_Rd(&cm->caLock) != 0) {
+        WOLFSSL_MSG("Lock on caLock failed");
         return BAD_MUTEX_E;
     }
 
     sz = GetCertCacheMemSize(cm);
 
-    wc_UnLockMutex(&cm->caLock);
+    wc_UnLockRwLock(&cm->caLock);
 
     return sz;
 }
@@ -12168,6 +13393,7 @@ int wolfSSL_Cleanup(void)
 #endif
 
 #ifndef NO_SESSION_CACHE
+    FreeSessionCache();
     if (wc_FreeMutex(&session_mutex) != 0)
         ret = BAD_MUTEX_E;
 #endif
@@ -12258,6 +13484,8 @@ WOLFSSL_SESSION* GetSessionClient(WOLFSSL* ssl, const byte* id, int len)
     int             idx;
     int             count;
     int             error = 0;
+    ClientRow       clRow;
+    WOLFSSL_SESSION_CACHE* cache;
 
     WOLFSSL_ENTER("GetSessionClient");
 
@@ -12281,50 +13509,69 @@ WOLFSSL_SESSION* GetSessionClient(WOLFSSL* ssl, const byte* id, int len)
         return NULL;
 #endif
 
-    row = HashSession(id, len, &error) % SESSION_ROWS;
+    cache = GetSessionCache(ssl);
+    row = HashSession(id, len, &error) % cache->rowCount;
     if (error != 0) {
         WOLFSSL_MSG("Hash session failed");
         return NULL;
     }
 
-    if (wc_LockMutex(&session_mutex) != 0) {
-        WOLFSSL_MSG("Lock session mutex failed");
+    /* take a snapshot of the client row so its lock isn't held while the
+       session rows it refers to are locked */
+    if (CLIENT_ROW_LOCK(cache, row) != 0) {
+        WOLFSSL_MSG("Lock client row mutex failed");
         return NULL;
     }
+    clRow = cache->clientRows[row];
+    CLIENT_ROW_UNLOCK(cache, row);
 
     /* start from most recently used */
-    count = min((word32)ClientCache[row].totalCount, SESSIONS_PER_ROW);
-    idx = ClientCache[row].nextIdx - 1;
+    count = min((word32)clRow.totalCount, SESSIONS_PER_ROW);
+    idx = clRow.nextIdx - 1;
     if (idx < 0)
         idx = SESSIONS_PER_ROW - 1; /* if back to front, the previous was end */
 
     for (; count > 0; --count, idx = idx ? idx - 1 : SESSIONS_PER_ROW - 1) {
         WOLFSSL_SESSION* current;
         ClientSession   clSess;
+        int             match = 0;
 
         if (idx >= SESSIONS_PER_ROW || idx < 0) { /* sanity check */
             WOLFSSL_MSG("Bad idx");
             break;
         }
 
-        clSess = ClientCache[row].Clients[idx];
+        clSess = clRow.Clients[idx];
+        if (clSess.serverRow >= cache->rowCount ||
+                                         clSess.serverIdx >= SESSIONS_PER_ROW) {
+            WOLFSSL_MSG("Bad client cache entry");
+            continue;
+        }
 
-        current = &SessionCache[clSess.serverRow].Sessions[clSess.serverIdx];
+        if (SESSION_ROW_LOCK(cache, clSess.serverRow) != 0) {
+            WOLFSSL_MSG("Lock session row mutex failed");
+            break;
+        }
+        current = &cache->rows[clSess.serverRow].Sessions[clSess.serverIdx];
         if (XMEMCMP(current->serverID, id, len) == 0) {
             WOLFSSL_MSG("Found a serverid match for client");
             if (LowResTimer() < (current->bornOn + current->timeout)) {
                 WOLFSSL_MSG("Session valid");
                 ret = current;
-                break;
+                match = 1;
+                SessionRowTouch(&cache->rowInfo[clSess.serverRow],
+                                clSess.serverIdx);
             } else {
                 WOLFSSL_MSG("Session timed out");  /* could have more for id */
             }
         } else {
             WOLFSSL_MSG("ServerID not a match from client table");
         }
-    }
+        SESSION_ROW_UNLOCK(cache, clSess.serverRow);
 
-    wc_UnLockMutex(&session_mutex);
+        if (match)
+            break;
+    }
 
     return ret;
 }
@@ -12374,6 +13621,8 @@ WOLFSSL_SESSION* GetSession(WOLFSSL* ssl, byte* masterSecret,
     int          idx;
     int          count;
     int          error = 0;
+    WOLFSSL_SESSION_CACHE* cache;
+    SessionRow*  sessRow;
 
     (void)       restoreSessionCerts;
 
@@ -12408,18 +13657,20 @@ WOLFSSL_SESSION* GetSession(WOLFSSL* ssl, byte* masterSecret,
         return NULL;
 #endif
 
-    row = HashSession(id, ID_LEN, &error) % SESSION_ROWS;
+    cache = GetSessionCache(ssl);
+    row = HashSession(id, ID_LEN, &error) % cache->rowCount;
     if (error != 0) {
         WOLFSSL_MSG("Hash session failed");
         return NULL;
     }
 
-    if (wc_LockMutex(&session_mutex) != 0)
+    if (SESSION_ROW_LOCK(cache, row) != 0)
         return 0;
+    sessRow = &cache->rows[row];
 
     /* start from most recently used */
-    count = min((word32)SessionCache[row].totalCount, SESSIONS_PER_ROW);
-    idx = SessionCache[row].nextIdx - 1;
+    count = min((word32)sessRow->totalCount, SESSIONS_PER_ROW);
+    idx = sessRow->nextIdx - 1;
     if (idx < 0)
         idx = SESSIONS_PER_ROW - 1; /* if back to front, the previous was end */
 
@@ -12431,13 +13682,14 @@ WOLFSSL_SESSION* GetSession(WOLFSSL* ssl, byte* masterSecret,
             break;
         }
 
-        current = &SessionCache[row].Sessions[idx];
+        current = &sessRow->Sessions[idx];
         if (XMEMCMP(current->sessionID, id, ID_LEN) == 0) {
             WOLFSSL_MSG("Found a session match");
             if (LowResTimer() < (current->bornOn + current->timeout)) {
                 WOLFSSL_MSG("Session valid");
                 ret = current;
                 RestoreSession(ssl, ret, masterSecret, restoreSessionCerts);
+                SessionRowTouch(&cache->rowInfo[row], idx);
             } else {
                 WOLFSSL_MSG("Session timed out");
             }
@@ -12447,12 +13699,57 @@ WOLFSSL_SESSION* GetSession(WOLFSSL* ssl, byte* masterSecret,
         }
     }
 
-    wc_UnLockMutex(&session_mutex);
+    if (ret != NULL)
+        cache->rowInfo[row].hits++;
+    else
+        cache->rowInfo[row].misses++;
+
+    SESSION_ROW_UNLOCK(cache, row);
 
     return ret;
 }
 
 
+/* Get the lock of the row of cache that holds session, NULL if not in cache */
+static wolfSSL_Mutex* GetSessionRowLock(WOLFSSL_SESSION_CACHE* cache,
+                                        const WOLFSSL_SESSION* session)
+{
+    wolfssl_word start = (wolfssl_word)cache->rows;
+    wolfssl_word addr  = (wolfssl_word)session;
+
+    if (addr >= start &&
+          addr < start + (wolfssl_word)(sizeof(SessionRow) * cache->rowCount)) {
+        return &cache->rowLocks[(addr - start) / sizeof(SessionRow)];
+    }
+
+    return NULL;
+}
+
+
+/* Get the lock that guards session. Sessions in a session cache, including the
+ * cache of another context, are guarded by the lock of their row, any other
+ * session by the global session mutex.
+ */
+static wolfSSL_Mutex* GetSessionLock(WOLFSSL* ssl,
+                                     const WOLFSSL_SESSION* session)
+{
+    wolfSSL_Mutex* lock = NULL;
+
+    if (ssl->ctx != NULL && ssl->ctx->sessionCache != NULL)
+        lock = GetSessionRowLock(ssl->ctx->sessionCache, session);
+    if (lock == NULL)
+        lock = GetSessionRowLock(&SessionCache, session);
+    /* cache recorded when the session was added, is alive while session is */
+    if (lock == NULL && session->cache != NULL &&
+                                             session->cache != &SessionCache)
+        lock = GetSessionRowLock(session->cache, session);
+    if (lock == NULL)
+        lock = &session_mutex;
+
+    return lock;
+}
+
+
 static int GetDeepCopySession(WOLFSSL* ssl, WOLFSSL_SESSION* copyFrom)
 {
     WOLFSSL_SESSION* copyInto = &ssl->session;
@@ -12460,6 +13757,7 @@ static int GetDeepCopySession(WOLFSSL* ssl, WOLFSSL_SESSION* copyFrom)
     int ticketLen             = 0;
     int doDynamicCopy         = 0;
     int ret                   = WOLFSSL_SUCCESS;
+    wolfSSL_Mutex* lock;
 
     (void)ticketLen;
     (void)doDynamicCopy;
@@ -12468,6 +13766,8 @@ static int GetDeepCopySession(WOLFSSL* ssl, WOLFSSL_SESSION* copyFrom)
     if (!ssl || !copyFrom)
         return BAD_FUNC_ARG;
 
+    lock = GetSessionLock(ssl, copyFrom);
+
 #ifdef HAVE_SESSION_TICKET
     /* Free old dynamic ticket if we had one to avoid leak */
     if (copyInto->isDynamic) {
@@ -12477,7 +13777,7 @@ static int GetDeepCopySession(WOLFSSL* ssl, WOLFSSL_SESSION* copyFrom)
     }
 #endif
 
-    if (wc_LockMutex(&session_mutex) != 0)
+    if (wc_LockMutex(lock) != 0)
         return BAD_MUTEX_E;
 
 #ifdef HAVE_SESSION_TICKET
@@ -12487,6 +13787,7 @@ static int GetDeepCopySession(WOLFSSL* ssl, WOLFSSL_SESSION* copyFrom)
 #endif
 
     *copyInto = *copyFrom;
+    copyInto->cache = NULL;
 
     /* Default ticket to non dynamic. This will avoid crash if we fail below */
 #ifdef HAVE_SESSION_TICKET
@@ -12499,13 +13800,13 @@ static int GetDeepCopySession(WOLFSSL* ssl, WOLFSSL_SESSION* copyFrom)
     copyInto->cipherSuite    = copyFrom->cipherSuite;
 #endif
 
-    if (wc_UnLockMutex(&session_mutex) != 0) {
+    if (wc_UnLockMutex(lock) != 0) {
         return BAD_MUTEX_E;
     }
 
 #ifdef HAVE_SESSION_TICKET
 #ifdef WOLFSSL_TLS13
-    if (wc_LockMutex(&session_mutex) != 0) {
+    if (wc_LockMutex(lock) != 0) {
         XFREE(tmpBuff, ssl->heap, DYNAMIC_TYPE_SESSION_TICK);
         return BAD_MUTEX_E;
     }
@@ -12526,7 +13827,7 @@ static int GetDeepCopySession(WOLFSSL* ssl, WOLFSSL_SESSION* copyFrom)
 #endif
     XMEMCPY(copyInto->masterSecret, copyFrom->masterSecret, SECRET_LEN);
 
-    if (wc_UnLockMutex(&session_mutex) != 0) {
+    if (wc_UnLockMutex(lock) != 0) {
         if (ret == WOLFSSL_SUCCESS)
             ret = BAD_MUTEX_E;
     }
@@ -12539,7 +13840,7 @@ static int GetDeepCopySession(WOLFSSL* ssl, WOLFSSL_SESSION* copyFrom)
         if (!tmpBuff)
             return MEMORY_ERROR;
 
-        if (wc_LockMutex(&session_mutex) != 0) {
+        if (wc_LockMutex(lock) != 0) {
             XFREE(tmpBuff, ssl->heap, DYNAMIC_TYPE_SESSION_TICK);
             return BAD_MUTEX_E;
         }
@@ -12562,7 +13863,7 @@ static int GetDeepCopySession(WOLFSSL* ssl, WOLFSSL_SESSION* copyFrom)
     }
 
     if (doDynamicCopy) {
-        if (wc_UnLockMutex(&session_mutex) != 0) {
+        if (wc_UnLockMutex(lock) != 0) {
             if (ret == WOLFSSL_SUCCESS)
                 ret = BAD_MUTEX_E;
         }
@@ -12619,8 +13920,7 @@ int SetSession(WOLFSSL* ssl, WOLFSSL_SESSION* session)
 
 
 #ifdef WOLFSSL_SESSION_STATS
-static int get_locked_session_stats(word32* active, word32* total,
-                                    word32* peak);
+static int get_session_stats(word32* active, word32* total, word32* peak);
 #endif
 
 int AddSession(WOLFSSL* ssl)
@@ -12633,6 +13933,8 @@ int AddSession(WOLFSSL* ssl)
     int    ticLen  = 0;
 #endif
     WOLFSSL_SESSION* session;
+    WOLFSSL_SESSION_CACHE* cache = GetSessionCache(ssl);
+    SessionRow* sessRow = NULL;
     int i;
     int overwrite = 0;
 
@@ -12680,13 +13982,13 @@ int AddSession(WOLFSSL* ssl)
 #if defined(WOLFSSL_TLS13) && defined(HAVE_SESSION_TICKET)
         if (ssl->options.tls1_3) {
             row = HashSession(ssl->session.sessionID, ID_LEN, &error) %
-                    SESSION_ROWS;
+                    cache->rowCount;
         }
         else
 #endif
         {
             row = HashSession(ssl->arrays->sessionID, ID_LEN, &error) %
-                    SESSION_ROWS;
+                    cache->rowCount;
         }
         if (error != 0) {
             WOLFSSL_MSG("Hash session failed");
@@ -12696,16 +13998,17 @@ int AddSession(WOLFSSL* ssl)
             return error;
         }
 
-        if (wc_LockMutex(&session_mutex) != 0) {
+        if (SESSION_ROW_LOCK(cache, row) != 0) {
 #ifdef HAVE_SESSION_TICKET
             XFREE(tmpBuff, ssl->heap, DYNAMIC_TYPE_SESSION_TICK);
 #endif
             return BAD_MUTEX_E;
         }
+        sessRow = &cache->rows[row];
 
         for (i=0; i<SESSIONS_PER_ROW; i++) {
             if (ssl->options.tls1_3) {
-                if (XMEMCMP(ssl->session.sessionID, SessionCache[row].Sessions[i].sessionID, ID_LEN) == 0) {
+                if (XMEMCMP(ssl->session.sessionID, sessRow->Sessions[i].sessionID, ID_LEN) == 0) {
                     WOLFSSL_MSG("Session already exists. Overwriting.");
                     overwrite = 1;
                     idx = i;
@@ -12713,7 +14016,7 @@ int AddSession(WOLFSSL* ssl)
                 }
             }
             else {
-                if (XMEMCMP(ssl->arrays->sessionID, SessionCache[row].Sessions[i].sessionID, ID_LEN) == 0) {
+                if (XMEMCMP(ssl->arrays->sessionID, sessRow->Sessions[i].sessionID, ID_LEN) == 0) {
                     WOLFSSL_MSG("Session already exists. Overwriting.");
                     overwrite = 1;
                     idx = i;
@@ -12723,12 +14026,25 @@ int AddSession(WOLFSSL* ssl)
         }
 
         if (!overwrite) {
-            idx = SessionCache[row].nextIdx++;
+            if (cache->policy == WOLFSSL_SESSION_CACHE_FIFO ||
+                                    sessRow->totalCount < SESSIONS_PER_ROW) {
+                idx = sessRow->nextIdx++;
+            }
+            else {
+                idx = SessionRowVictim(cache, row);
+            }
+            if (sessRow->totalCount >= SESSIONS_PER_ROW &&
+                    LowResTimer() < sessRow->Sessions[idx].bornOn +
+                                    sessRow->Sessions[idx].timeout) {
+                cache->rowInfo[row].evictions++;
+            }
         }
+        SessionRowTouch(&cache->rowInfo[row], idx);
 #ifdef SESSION_INDEX
         ssl->sessionIndex = (row << SESSIDX_ROW_SHIFT) | idx;
 #endif
-        session = &SessionCache[row].Sessions[idx];
+        session = &sessRow->Sessions[idx];
+        session->cache = cache;
     }
 
     if (!ssl->options.tls1_3)
@@ -12756,7 +14072,7 @@ int AddSession(WOLFSSL* ssl)
     }
 #endif
 
-    session->timeout = ssl->timeout;
+    session->timeout = cache->timeout != 0 ? cache->timeout : ssl->timeout;
     session->bornOn  = LowResTimer();
 
 #ifdef HAVE_SESSION_TICKET
@@ -12843,9 +14159,9 @@ int AddSession(WOLFSSL* ssl)
 #endif
     {
         if (error == 0) {
-            SessionCache[row].totalCount++;
-            if (SessionCache[row].nextIdx == SESSIONS_PER_ROW)
-                SessionCache[row].nextIdx = 0;
+            sessRow->totalCount++;
+            if (sessRow->nextIdx == SESSIONS_PER_ROW)
+                sessRow->nextIdx = 0;
         }
     }
 #ifndef NO_CLIENT_CACHE
@@ -12864,20 +14180,24 @@ int AddSession(WOLFSSL* ssl)
 #endif
             {
                 clientRow = HashSession(ssl->session.serverID,
-                        ssl->session.idLen, &error) % SESSION_ROWS;
+                        ssl->session.idLen, &error) % cache->rowCount;
                 if (error != 0) {
                     WOLFSSL_MSG("Hash session failed");
+                } else if (CLIENT_ROW_LOCK(cache, clientRow) != 0) {
+                    error = BAD_MUTEX_E;
                 } else {
-                    clientIdx = ClientCache[clientRow].nextIdx++;
+                    ClientRow* clRow = &cache->clientRows[clientRow];
+
+                    clientIdx = clRow->nextIdx++;
 
-                    ClientCache[clientRow].Clients[clientIdx].serverRow =
-                                                                   (word16)row;
-                    ClientCache[clientRow].Clients[clientIdx].serverIdx =
-                                                                   (word16)idx;
+                    clRow->Clients[clientIdx].serverRow = (word16)row;
+                    clRow->Clients[clientIdx].serverIdx = (word16)idx;
 
-                    ClientCache[clientRow].totalCount++;
-                    if (ClientCache[clientRow].nextIdx == SESSIONS_PER_ROW)
-                        ClientCache[clientRow].nextIdx = 0;
+                    clRow->totalCount++;
+                    if (clRow->nextIdx == SESSIONS_PER_ROW)
+                        clRow->nextIdx = 0;
+
+                    CLIENT_ROW_UNLOCK(cache, clientRow);
                 }
             }
         }
@@ -12886,33 +14206,39 @@ int AddSession(WOLFSSL* ssl)
     }
 #endif /* NO_CLIENT_CACHE */
 
+#ifdef HAVE_EXT_CACHE
+    if (!ssl->options.internalCacheOff)
+#endif
+    {
+        if (SESSION_ROW_UNLOCK(cache, row) != 0)
+            return BAD_MUTEX_E;
+    }
+
 #if defined(WOLFSSL_SESSION_STATS) && defined(WOLFSSL_PEAK_SESSIONS)
 #ifdef HAVE_EXT_CACHE
     if (!ssl->options.internalCacheOff)
 #endif
     {
-        if (error == 0) {
+        /* peak is tracked for the internal cache only */
+        if (error == 0 && cache == &SessionCache) {
             word32 active = 0;
 
-            error = get_locked_session_stats(&active, NULL, NULL);
+            /* rows are counted without the row lock held above, the peak is
+             * guarded by the global session mutex */
+            error = get_session_stats(&active, NULL, NULL);
             if (error == WOLFSSL_SUCCESS) {
                 error = 0;  /* back to this function ok */
 
+                if (wc_LockMutex(&session_mutex) != 0)
+                    return BAD_MUTEX_E;
                 if (active > PeakSessions)
                     PeakSessions = active;
+                wc_UnLockMutex(&session_mutex);
             }
         }
     }
 #endif /* defined(WOLFSSL_SESSION_STATS) && defined(WOLFSSL_PEAK_SESSIONS) */
 
-#ifdef HAVE_EXT_CACHE
-    if (!ssl->options.internalCacheOff)
-#endif
-    {
-        if (wc_UnLockMutex(&session_mutex) != 0)
-            return BAD_MUTEX_E;
-    }
-
 #ifdef HAVE_EXT_CACHE
     if (error == 0 && ssl->ctx->new_sess_cb != NULL)
         ssl->ctx->new_sess_cb(ssl, session);
@@ -12943,18 +14269,23 @@ int wolfSSL_GetSessionAtIndex(int idx, WOLFSSL_SESSION* session)
     row = idx >> SESSIDX_ROW_SHIFT;
     col = idx & SESSIDX_IDX_MASK;
 
-    if (wc_LockMutex(&session_mutex) != 0) {
+    if (row < 0 || row >= (int)SessionCacheRows) {
+        WOLFSSL_LEAVE("wolfSSL_GetSessionAtIndex", result);
+        return result;
+    }
+
+    if (SESSION_ROW_LOCK(&SessionCache, row) != 0) {
         return BAD_MUTEX_E;
     }
 
-    if (row < SESSION_ROWS &&
-        col < (int)min(SessionCache[row].totalCount, SESSIONS_PER_ROW)) {
+    if (col < (int)min(SessionCache.rows[row].totalCount, SESSIONS_PER_ROW)) {
         XMEMCPY(session,
-                 &SessionCache[row].Sessions[col], sizeof(WOLFSSL_SESSION));
+                 &SessionCache.rows[row].Sessions[col], sizeof(WOLFSSL_SESSION));
+        session->cache = NULL;
         result = WOLFSSL_SUCCESS;
     }
 
-    if (wc_UnLockMutex(&session_mutex) != 0)
+    if (SESSION_ROW_UNLOCK(&SessionCache, row) != 0)
         result = BAD_MUTEX_E;
 
     WOLFSSL_LEAVE("wolfSSL_GetSessionAtIndex", result);
@@ -13008,11 +14339,12 @@ WOLFSSL_X509* wolfSSL_SESSION_get0_peer(WOLFSSL_SESSION* session)
 
 #ifdef WOLFSSL_SESSION_STATS
 
-/* requires session_mutex lock held, WOLFSSL_SUCCESS on ok */
-static int get_locked_session_stats(word32* active, word32* total, word32* peak)
+/* locks each row in turn, peak is read under session_mutex,
+ * WOLFSSL_SUCCESS on ok */
+static int get_session_stats(word32* active, word32* total, word32* peak)
 {
     int result = WOLFSSL_SUCCESS;
-    int i;
+    word32 i;
     int count;
     int idx;
     word32 now   = 0;
@@ -13021,16 +14353,23 @@ static int get_locked_session_stats(word32* active, word32* total, word32* peak)
 
     (void)peak;
 
-    WOLFSSL_ENTER("get_locked_session_stats");
+    WOLFSSL_ENTER("get_session_stats");
+
+    for (i = 0; i < SessionCacheRows; i++) {
+        if (SESSION_ROW_LOCK(&SessionCache, i) != 0) {
+            result = BAD_MUTEX_E;
+            break;
+        }
 
-    for (i = 0; i < SESSION_ROWS; i++) {
-        seen += SessionCache[i].totalCount;
+        seen += SessionCache.rows[i].totalCount;
 
-        if (active == NULL)
+        if (active == NULL) {
+            SESSION_ROW_UNLOCK(&SessionCache, i);
             continue;  /* no need to calculate what we can't set */
+        }
 
-        count = min((word32)SessionCache[i].totalCount, SESSIONS_PER_ROW);
-        idx   = SessionCache[i].nextIdx - 1;
+        count = min((word32)SessionCache.rows[i].totalCount, SESSIONS_PER_ROW);
+        idx   = SessionCache.rows[i].nextIdx - 1;
         if (idx < 0)
             idx = SESSIONS_PER_ROW - 1; /* if back to front previous was end */
 
@@ -13041,11 +14380,18 @@ static int get_locked_session_stats(word32* active, word32* total, word32* peak)
             }
 
             /* if not expired then good */
-            if (ticks < (SessionCache[i].Sessions[idx].bornOn +
-                         SessionCache[i].Sessions[idx].timeout) ) {
+            if (ticks < (SessionCache.rows[i].Sessions[idx].bornOn +
+                         SessionCache.rows[i].Sessions[idx].timeout) ) {
                 now++;
             }
         }
+
+        SESSION_ROW_UNLOCK(&SessionCache, i);
+    }
+
+    if (result != WOLFSSL_SUCCESS) {
+        WOLFSSL_LEAVE("get_session_stats", result);
+        return result;
     }
 
     if (active)
@@ -13055,11 +14401,15 @@ static int get_locked_session_stats(word32* active, word32* total, word32* peak)
         *total = seen;
 
 #ifdef WOLFSSL_PEAK_SESSIONS
-    if (peak)
+    if (peak) {
+        if (wc_LockMutex(&session_mutex) != 0)
+            return BAD_MUTEX_E;
         *peak = PeakSessions;
+        wc_UnLockMutex(&session_mutex);
+    }
 #endif
 
-    WOLFSSL_LEAVE("get_locked_session_stats", result);
+    WOLFSSL_LEAVE("get_session_stats", result);
 
     return result;
 }
@@ -13074,7 +14424,7 @@ int wolfSSL_get_session_stats(word32* active, word32* total, word32* peak,
     WOLFSSL_ENTER("wolfSSL_get_session_stats");
 
     if (maxSessions) {
-        *maxSessions = SESSIONS_PER_ROW * SESSION_ROWS;
+        *maxSessions = SESSIONS_PER_ROW * SessionCacheRows;
 
         if (active == NULL && total == NULL && peak == NULL)
             return result;  /* we're done */
@@ -13084,14 +14434,7 @@ int wolfSSL_get_session_stats(word32* active, word32* total, word32* peak,
     if (active == NULL && total == NULL && peak == NULL)
         return BAD_FUNC_ARG;
 
-    if (wc_LockMutex(&session_mutex) != 0) {
-        return BAD_MUTEX_E;
-    }
-
-    result = get_locked_session_stats(active, total, peak);
-
-    if (wc_UnLockMutex(&session_mutex) != 0)
-        result = BAD_MUTEX_E;
+    result = get_session_stats(active, total, peak);
 
     WOLFSSL_LEAVE("wolfSSL_get_session_stats", result);
 
@@ -13126,28 +14469,27 @@ int wolfSSL_get_session_stats(word32* active, word32* total, word32* peak,
 #endif
         printf("Max   Sessions      = %d\n", maxSessions);
 
-        E = (double)totalSessionsSeen / SESSION_ROWS;
+        E = (double)totalSessionsSeen / SessionCacheRows;
 
-        for (i = 0; i < SESSION_ROWS; i++) {
-            double diff = SessionCache[i].totalCount - E;
+        for (i = 0; i < (int)SessionCacheRows; i++) {
+            double diff = SessionCache.rows[i].totalCount - E;
             diff *= diff;                /* square    */
             diff /= E;                   /* normalize */
 
             chiSquare += diff;
         }
         printf("  chi-square = %5.1f, d.f. = %d\n", chiSquare,
-                                                     SESSION_ROWS - 1);
-        #if (SESSION_ROWS == 11)
+                                               (int)SessionCacheRows - 1);
+        if (SessionCacheRows == 11)
             printf(" .05 p value =  18.3, chi-square should be less\n");
-        #elif (SESSION_ROWS == 211)
+        else if (SessionCacheRows == 211)
             printf(".05 p value  = 244.8, chi-square should be less\n");
-        #elif (SESSION_ROWS == 5981)
+        else if (SessionCacheRows == 5981)
             printf(".05 p value  = 6161.0, chi-square should be less\n");
-        #elif (SESSION_ROWS == 3)
+        else if (SessionCacheRows == 3)
             printf(".05 p value  =   6.0, chi-square should be less\n");
-        #elif (SESSION_ROWS == 2861)
+        else if (SessionCacheRows == 2861)
             printf(".05 p value  = 2985.5, chi-square should be less\n");
-        #endif
         printf("\n");
 
         return ret;
@@ -13953,6 +15295,19 @@ int wolfSSL_set_compression(WOLFSSL* ssl)
     }
 
 
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+    int wolfSSL_CTX_SetVerifyCacheSize(WOLFSSL_CTX* ctx, int sz)
+    {
+        WOLFSSL_ENTER("wolfSSL_CTX_SetVerifyCacheSize");
+
+        if (ctx == NULL)
+            return BAD_FUNC_ARG;
+
+        return wolfSSL_CertManagerSetVerifyCacheSize(ctx->cm, sz);
+    }
+#endif
+
+
 #ifdef WOLFSSL_TRUST_PEER_CERT
     int wolfSSL_CTX_Unload_trust_peers(WOLFSSL_CTX* ctx)
     {
@@ -14011,7 +15366,9 @@ int wolfSSL_set_compression(WOLFSSL* ssl)
         (void)sz;
         WOLFSSL_MSG("session cache is set at compile time");
         #ifndef NO_SESSION_CACHE
-            return (long)(SESSIONS_PER_ROW * SESSION_ROWS);
+            if (ctx != NULL && ctx->sessionCache != NULL)
+                return (long)(SESSIONS_PER_ROW * ctx->sessionCache->rowCount);
+            return (long)(SESSIONS_PER_ROW * SessionCacheRows);
         #else
             return 0;
         #endif
@@ -14901,6 +16258,8 @@ int wolfSSL_set_compression(WOLFSSL* ssl)
                     return NULL;
                 }
                 bio->mem_buf->data = (char*)bio->ptr;
+                bio->mem_buf->length = 0;
+                bio->mem_buf->max = 0;
             }
 
             if (method->type == WOLFSSL_BIO_MD) {
@@ -14942,6 +16301,7 @@ int wolfSSL_set_compression(WOLFSSL* ssl)
         if (bio->mem_buf != NULL) {
             bio->mem_buf->data = (char*)bio->ptr;
             bio->mem_buf->length = bio->num;
+            bio->mem_buf->max = bio->num;
         }
 
         XMEMCPY(bio->ptr, buf, len);
@@ -16560,53 +17920,8 @@ size_t wolfSSL_get_client_random(const WOLFSSL* ssl, unsigned char* out,
         XMEMSET(&ssl->msgsReceived, 0, sizeof(ssl->msgsReceived));
 
         if (ssl->hsHashes != NULL) {
-#ifndef NO_OLD_TLS
-#ifndef NO_MD5
-            if (wc_InitMd5_ex(&ssl->hsHashes->hashMd5, ssl->heap,
-                    ssl->devId) != 0) {
-                return WOLFSSL_FAILURE;
-            }
-        #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
-            wc_Md5SetFlags(&ssl->hsHashes->hashMd5, WC_HASH_FLAG_WILLCOPY);
-        #endif
-#endif
-#ifndef NO_SHA
-            if (wc_InitSha_ex(&ssl->hsHashes->hashSha, ssl->heap,
-                    ssl->devId) != 0) {
+            if (InitHandshakeHashes(ssl) != 0)
                 return WOLFSSL_FAILURE;
-            }
-        #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
-            wc_ShaSetFlags(&ssl->hsHashes->hashSha, WC_HASH_FLAG_WILLCOPY);
-        #endif
-#endif
-#endif
-#ifndef NO_SHA256
-            if (wc_InitSha256_ex(&ssl->hsHashes->hashSha256, ssl->heap,
-                    ssl->devId) != 0) {
-                return WOLFSSL_FAILURE;
-            }
-        #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
-            wc_Sha256SetFlags(&ssl->hsHashes->hashSha256, WC_HASH_FLAG_WILLCOPY);
-        #endif
-#endif
-#ifdef WOLFSSL_SHA384
-            if (wc_InitSha384_ex(&ssl->hsHashes->hashSha384, ssl->heap,
-                    ssl->devId) != 0) {
-                return WOLFSSL_FAILURE;
-            }
-        #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
-            wc_Sha384SetFlags(&ssl->hsHashes->hashSha384, WC_HASH_FLAG_WILLCOPY);
-        #endif
-#endif
-#ifdef WOLFSSL_SHA512
-            if (wc_InitSha512_ex(&ssl->hsHashes->hashSha512, ssl->heap,
-                    ssl->devId) != 0) {
-                return WOLFSSL_FAILURE;
-            }
-        #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
-            wc_Sha512SetFlags(&ssl->hsHashes->hashSha512, WC_HASH_FLAG_WILLCOPY);
-        #endif
-#endif
         }
 #ifdef SESSION_CERTS
         ssl->session.chain.count = 0;
@@ -16749,7 +18064,9 @@ size_t wolfSSL_get_client_random(const WOLFSSL* ssl, unsigned char* out,
     {
         (void)ctx;
         #ifndef NO_SESSION_CACHE
-            return (long)(SESSIONS_PER_ROW * SESSION_ROWS);
+            if (ctx != NULL && ctx->sessionCache != NULL)
+                return (long)(SESSIONS_PER_ROW * ctx->sessionCache->rowCount);
+            return (long)(SESSIONS_PER_ROW * SessionCacheRows);
         #else
             return 0;
         #endif
@@ -19219,6 +20536,9 @@ WOLFSSL_SESSION* wolfSSL_SESSION_dup(WOLFSSL_SESSION* session)
     if (copy != NULL) {
         XMEMCPY(copy, session, sizeof(WOLFSSL_SESSION));
         copy->isAlloced = 1;
+    #ifndef NO_SESSION_CACHE
+        copy->cache = NULL;
+    #endif
 #ifdef HAVE_SESSION_TICKET
         if (session->isDynamic) {
             copy->ticket = (byte*)XMALLOC(session->ticketLen, NULL,
@@ -46494,10 +47814,11 @@ int wolfSSL_X509_CA_num(WOLFSSL_X509_STORE* store)
         return WOLFSSL_FAILURE;
     }
 
-    table = store->cm->caTable;
-    if (table){
-        if (wc_LockMutex(&store->cm->caLock) == 0){
-            for (i = 0; i < CA_TABLE_SIZE; i++) {
+    /* table may be resized by another thread, only read it under lock */
+    if (wc_LockRwLock_Rd(&store->cm->caLock) == 0){
+        table = store->cm->caTable;
+        if (table){
+            for (i = 0; i < (int)store->cm->caTableSz; i++) {
                 Signer* signer = table[i];
                 while (signer) {
                     Signer* next = signer->next;
@@ -46505,8 +47826,8 @@ int wolfSSL_X509_CA_num(WOLFSSL_X509_STORE* store)
                     signer = next;
                 }
             }
-            wc_UnLockMutex(&store->cm->caLock);
         }
+        wc_UnLockRwLock(&store->cm->caLock);
     }
 
     return cnt_ret;
@@ -50,6 +50,10 @@
     #include "libntruencrypt/ntru_crypto.h"
     #include <wolfssl/wolfcrypt/random.h>
 #endif
+#ifdef WOLFSSL_KEY_SHARE_POOL_THREAD
+    #include <errno.h>
+    #include <time.h>
+#endif
 
 #ifdef HAVE_QSH
     static int TLSX_AddQSHKey(QSHKey** list, QSHKey* key);
@@ -152,22 +156,33 @@ int BuildTlsHandshakeHash(WOLFSSL* ssl, byte* hash, word32* hashLen)
     if (ssl == NULL || hash == NULL || hashLen == NULL || *hashLen < HSHASH_SZ)
         return BAD_FUNC_ARG;
 
-    /* for constant timing perform these even if error */
+    if (!IsAtLeastTLSv1_2(ssl)) {
 #ifndef NO_OLD_TLS
-    ret |= wc_Md5GetHash(&ssl->hsHashes->hashMd5, hash);
-    ret |= wc_ShaGetHash(&ssl->hsHashes->hashSha, &hash[WC_MD5_DIGEST_SIZE]);
+        ret = SetHandshakeHashes(ssl, HS_HASH_MD5 | HS_HASH_SHA);
+        if (ret != 0)
+            return ret;
+        /* for constant timing perform these even if error */
+        ret |= wc_Md5GetHash(&ssl->hsHashes->hashMd5, hash);
+        ret |= wc_ShaGetHash(&ssl->hsHashes->hashSha,
+                                                  &hash[WC_MD5_DIGEST_SIZE]);
 #endif
-
-    if (IsAtLeastTLSv1_2(ssl)) {
+    }
+    else {
 #ifndef NO_SHA256
         if (ssl->specs.mac_algorithm <= sha256_mac ||
             ssl->specs.mac_algorithm == blake2b_mac) {
+            ret = SetHandshakeHashes(ssl, HS_HASH_SHA256);
+            if (ret != 0)
+                return ret;
             ret |= wc_Sha256GetHash(&ssl->hsHashes->hashSha256, hash);
             hashSz = WC_SHA256_DIGEST_SIZE;
         }
 #endif
 #ifdef WOLFSSL_SHA384
         if (ssl->specs.mac_algorithm == sha384_mac) {
+            ret = SetHandshakeHashes(ssl, HS_HASH_SHA384);
+            if (ret != 0)
+                return ret;
             ret |= wc_Sha384GetHash(&ssl->hsHashes->hashSha384, hash);
             hashSz = WC_SHA384_DIGEST_SIZE;
         }
@@ -5864,6 +5879,189 @@ static int TLSX_EncryptThenMac_Use(WOLFSSL* ssl)
 
 #endif /* HAVE_ENCRYPT_THEN_MAC && !WOLFSSL_AEAD_ONLY */
 
+#ifdef WOLFSSL_DTLS_CID
+/******************************************************************************/
+/* DTLS 1.2 Connection ID                                                     */
+/******************************************************************************/
+
+/**
+ * Get the size of the Connection ID extension.
+ *
+ * data     Connection ID state of the SSL object.
+ * msgType  Type of message to put extension into.
+ * pSz      Size of extension data.
+ * return SANITY_MSG_E when the message is not allowed to have extension and
+ *        0 otherwise.
+ */
+static int TLSX_ConnectionID_GetSize(void* data, byte msgType, word16* pSz)
+{
+    DtlsCidInfo* info = (DtlsCidInfo*)data;
+
+    if (msgType != client_hello && msgType != server_hello) {
+        return SANITY_MSG_E;
+    }
+
+    /* Length byte followed by the CID we want to receive. */
+    *pSz += OPAQUE8_LEN + info->rxSz;
+
+    return 0;
+}
+
+/**
+ * Write the Connection ID extension.
+ * Each side sends the CID it wants to see on the records it receives.
+ *
+ * data     Connection ID state of the SSL object.
+ * output   Extension data buffer.
+ * msgType  Type of message to put extension into.
+ * pSz      Size of extension data.
+ * return SANITY_MSG_E when the message is not allowed to have extension and
+ *        0 otherwise.
+ */
+static int TLSX_ConnectionID_Write(void* data, byte* output, byte msgType,
+                                   word16* pSz)
+{
+    DtlsCidInfo* info = (DtlsCidInfo*)data;
+
+    if (msgType != client_hello && msgType != server_hello) {
+        return SANITY_MSG_E;
+    }
+
+    output[0] = info->rxSz;
+    XMEMCPY(output + OPAQUE8_LEN, info->rx, info->rxSz);
+    *pSz += OPAQUE8_LEN + info->rxSz;
+
+    return 0;
+}
+
+/**
+ * Parse the Connection ID extension.
+ * A server only replies when the application enabled connection IDs. The
+ * reply is held back by TLSX_ConnectionID_ValidateResponse() when the chosen
+ * cipher suite can't protect CID records.
+ *
+ * ssl      SSL object
+ * input    Extension data buffer.
+ * length   Length of this extension's data.
+ * msgType  Type of message to extension appeared in.
+ * return SANITY_MSG_E when the message is not allowed to have extension,
+ *        BUFFER_ERROR when the extension's data is invalid and
+ *        0 otherwise.
+ */
+static int TLSX_ConnectionID_Parse(WOLFSSL* ssl, byte* input, word16 length,
+                                   byte msgType)
+{
+    DtlsCidInfo* info = &ssl->dtlsCidInfo;
+    byte         cidSz;
+
+    if (msgType != client_hello && msgType != server_hello) {
+        return SANITY_MSG_E;
+    }
+
+    if (length < OPAQUE8_LEN)
+        return BUFFER_ERROR;
+    cidSz = input[0];
+    if (length != OPAQUE8_LEN + cidSz)
+        return BUFFER_ERROR;
+
+    if (msgType == client_hello) {
+        /* Only negotiate when the application asked for connection IDs. */
+        if (!ssl->options.dtls ||
+                TLSX_Find(ssl->extensions, TLSX_CONNECTION_ID) == NULL) {
+            return 0;
+        }
+        if (cidSz > DTLS_CID_MAX_SIZE) {
+            WOLFSSL_MSG("Peer connection ID too long, not using CIDs");
+            return 0;
+        }
+
+        XMEMCPY(info->tx, input + OPAQUE8_LEN, cidSz);
+        info->txSz = cidSz;
+        TLSX_SetResponse(ssl, TLSX_CONNECTION_ID);
+        return 0;
+    }
+
+    /* Server Hello */
+    if (!ssl->options.dtls ||
+            TLSX_Find(ssl->extensions, TLSX_CONNECTION_ID) == NULL) {
+        return SANITY_MSG_E;
+    }
+    if (cidSz > DTLS_CID_MAX_SIZE) {
+        WOLFSSL_MSG("Peer connection ID too long");
+        return BUFFER_ERROR;
+    }
+
+    XMEMCPY(info->tx, input + OPAQUE8_LEN, cidSz);
+    info->txSz = cidSz;
+    info->negotiated = 1;
+
+    return 0;
+}
+
+#ifndef NO_WOLFSSL_SERVER
+/**
+ * Decide whether the server replies with the Connection ID extension.
+ * CID records are only protected with AEAD cipher suites, so the extension is
+ * left out of the ServerHello for anything else.
+ *
+ * ssl        SSL object
+ * semaphore  Extensions that are not to be written.
+ */
+static void TLSX_ConnectionID_ValidateResponse(WOLFSSL* ssl, byte* semaphore)
+{
+    TLSX* extension = TLSX_Find(ssl->extensions, TLSX_CONNECTION_ID);
+
+    if (extension == NULL || !extension->resp)
+        return;
+
+    if (DtlsCidSupportedSuite(ssl)) {
+        ssl->dtlsCidInfo.negotiated = 1;
+    }
+    else {
+        WOLFSSL_MSG("Cipher suite can't protect CID records, not using CIDs");
+        ssl->dtlsCidInfo.negotiated = 0;
+        TURN_ON(semaphore, TLSX_ToSemaphore(TLSX_CONNECTION_ID));
+    }
+}
+#endif
+
+/**
+ * Add the Connection ID extension to list.
+ * The extension data refers to the connection ID state of the SSL object.
+ *
+ * ssl      SSL object
+ * return MEMORY_E when unable to allocate memory and 0 otherwise.
+ */
+int TLSX_UseConnectionID(WOLFSSL* ssl)
+{
+    int ret = 0;
+
+    if (TLSX_Find(ssl->extensions, TLSX_CONNECTION_ID) == NULL) {
+        ret = TLSX_Push(&ssl->extensions, TLSX_CONNECTION_ID,
+                        &ssl->dtlsCidInfo, ssl->heap);
+    }
+
+    return ret;
+}
+
+#define CID_GET_SIZE  TLSX_ConnectionID_GetSize
+#define CID_WRITE     TLSX_ConnectionID_Write
+#define CID_PARSE     TLSX_ConnectionID_Parse
+#ifndef NO_WOLFSSL_SERVER
+#define CID_VALIDATE_RESPONSE TLSX_ConnectionID_ValidateResponse
+#else
+#define CID_VALIDATE_RESPONSE(a, b)
+#endif
+
+#else
+
+#define CID_GET_SIZE(a, b, c)    0
+#define CID_WRITE(a, b, c, d)    0
+#define CID_PARSE(a, b, c, d)    0
+#define CID_VALIDATE_RESPONSE(a, b)
+
+#endif /* WOLFSSL_DTLS_CID */
+
 /******************************************************************************/
 /* Supported Versions                                                         */
 /******************************************************************************/
@@ -6585,144 +6783,1043 @@ static int TLSX_SetSignatureAlgorithmsCert(TLSX** extensions, const void* data,
 #endif /* WOLFSSL_TLS13 */
 
 
+#ifdef WOLFSSL_KEY_SHARE_POOL
+
 /******************************************************************************/
-/* Key Share                                                                  */
+/* Key Share Pool                                                             */
 /******************************************************************************/
 
-#ifdef WOLFSSL_TLS13
-/* Create a key share entry using named Diffie-Hellman parameters group.
- * Generates a key pair.
+#if defined(HAVE_ECC) && defined(HAVE_ECC_KEY_EXPORT) && \
+    defined(HAVE_ECC_KEY_IMPORT)
+/* Get the wolfCrypt curve id of an ECC named group that can be pooled.
  *
- * ssl   The SSL/TLS object.
- * kse   The key share entry object.
- * returns 0 on success, otherwise failure.
+ * group  The named group.
+ * returns the curve id, or ECC_CURVE_INVALID when not supported.
  */
-static int TLSX_KeyShare_GenDhKey(WOLFSSL *ssl, KeyShareEntry* kse)
+static int KeySharePool_EccCurveId(word16 group)
 {
-    int             ret;
-#ifndef NO_DH
-    byte*           keyData;
-    void*           key = NULL;
-    word32          keySz;
-    word32          dataSz;
-    const DhParams* params;
-#ifdef WOLFSSL_SMALL_STACK
-    DhKey*          dhKey = NULL;
-#else
-    DhKey           dhKey[1];
+    switch (group) {
+    #ifndef NO_ECC_SECP
+        #if !defined(NO_ECC256)  || defined(HAVE_ALL_CURVES)
+        case WOLFSSL_ECC_SECP256R1:
+            return ECC_SECP256R1;
+        #endif
+        #if defined(HAVE_ECC384) || defined(HAVE_ALL_CURVES)
+        case WOLFSSL_ECC_SECP384R1:
+            return ECC_SECP384R1;
+        #endif
+        #if defined(HAVE_ECC521) || defined(HAVE_ALL_CURVES)
+        case WOLFSSL_ECC_SECP521R1:
+            return ECC_SECP521R1;
+        #endif
+    #endif /* !NO_ECC_SECP */
+        default:
+            return ECC_CURVE_INVALID;
+    }
+}
 #endif
 
-    /* TODO: [TLS13] The key size should come from wolfcrypt. */
-    /* Pick the parameters from the named group. */
-    switch (kse->group) {
+#ifndef NO_DH
+/* Get the parameters and private key size of a named FFDHE group.
+ * Sizes match those used by TLSX_KeyShare_GenDhKey().
+ *
+ * group   The named group.
+ * privSz  The private key size.
+ * returns the parameters, or NULL when not supported.
+ */
+static const DhParams* KeySharePool_DhParams(word16 group, word32* privSz)
+{
+    switch (group) {
     #ifdef HAVE_FFDHE_2048
         case WOLFSSL_FFDHE_2048:
-            params = wc_Dh_ffdhe2048_Get();
-            keySz = 29;
-            break;
+            *privSz = 29;
+            return wc_Dh_ffdhe2048_Get();
     #endif
     #ifdef HAVE_FFDHE_3072
         case WOLFSSL_FFDHE_3072:
-            params = wc_Dh_ffdhe3072_Get();
-            keySz = 34;
-            break;
+            *privSz = 34;
+            return wc_Dh_ffdhe3072_Get();
     #endif
     #ifdef HAVE_FFDHE_4096
         case WOLFSSL_FFDHE_4096:
-            params = wc_Dh_ffdhe4096_Get();
-            keySz = 39;
-            break;
+            *privSz = 39;
+            return wc_Dh_ffdhe4096_Get();
     #endif
     #ifdef HAVE_FFDHE_6144
         case WOLFSSL_FFDHE_6144:
-            params = wc_Dh_ffdhe6144_Get();
-            keySz = 46;
-            break;
+            *privSz = 46;
+            return wc_Dh_ffdhe6144_Get();
     #endif
     #ifdef HAVE_FFDHE_8192
         case WOLFSSL_FFDHE_8192:
-            params = wc_Dh_ffdhe8192_Get();
-            keySz = 52;
-            break;
+            *privSz = 52;
+            return wc_Dh_ffdhe8192_Get();
     #endif
         default:
-            return BAD_FUNC_ARG;
+            (void)privSz;
+            return NULL;
     }
+}
+#endif /* !NO_DH */
 
-#ifdef WOLFSSL_SMALL_STACK
-    dhKey = (DhKey*)XMALLOC(sizeof(DhKey), ssl->heap, DYNAMIC_TYPE_DH);
-    if (dhKey == NULL)
-        return MEMORY_E;
-#endif
-
-    ret = wc_InitDhKey_ex(dhKey, ssl->heap, ssl->devId);
-    if (ret != 0) {
-    #ifdef WOLFSSL_SMALL_STACK
-        XFREE(dhKey, ssl->heap, DYNAMIC_TYPE_DH);
-    #endif
-        return ret;
-    }
+/* Get the sizes of the encoded private and public keys of a named group.
+ *
+ * group   The named group.
+ * privSz  The private key size.
+ * pubSz   The public key size.
+ * returns 0 on success, BAD_FUNC_ARG when the group can't be pooled.
+ */
+static int KeySharePool_KeySizes(word16 group, word32* privSz, word32* pubSz)
+{
+#ifndef NO_DH
+    const DhParams* params;
 
-    /* Allocate space for the public key. */
-    dataSz = params->p_len;
-    keyData = (byte*)XMALLOC(dataSz, ssl->heap, DYNAMIC_TYPE_PUBLIC_KEY);
-    if (keyData == NULL) {
-        ret = MEMORY_E;
-        goto end;
-    }
-    /* Allocate space for the private key. */
-    key = (byte*)XMALLOC(keySz, ssl->heap, DYNAMIC_TYPE_PRIVATE_KEY);
-    if (key == NULL) {
-        ret = MEMORY_E;
-        goto end;
+    if ((group & NAMED_DH_MASK) == NAMED_DH_MASK) {
+        params = KeySharePool_DhParams(group, privSz);
+        if (params == NULL)
+            return BAD_FUNC_ARG;
+        *pubSz = params->p_len;
+        return 0;
     }
-
-    /* Set key */
-    ret = wc_DhSetKey(dhKey,
-        (byte*)params->p, params->p_len,
-        (byte*)params->g, params->g_len);
-    if (ret != 0)
-        goto end;
-
-    /* Generate a new key pair. */
-    ret = wc_DhGenerateKeyPair(dhKey, ssl->rng, (byte*)key, &keySz, keyData,
-                               &dataSz);
-#ifdef WOLFSSL_ASYNC_CRYPT
-    /* TODO: Make this function non-blocking */
-    if (ret == WC_PENDING_E) {
-        ret = wc_AsyncWait(ret, &dhKey->asyncDev, WC_ASYNC_FLAG_NONE);
+#endif
+#if defined(HAVE_CURVE25519) && defined(HAVE_CURVE25519_KEY_EXPORT) && \
+    defined(HAVE_CURVE25519_KEY_IMPORT)
+    if (group == WOLFSSL_ECC_X25519) {
+        *privSz = CURVE25519_KEYSIZE;
+        *pubSz = CURVE25519_KEYSIZE;
+        return 0;
     }
 #endif
-    if (ret != 0)
-        goto end;
+#if defined(HAVE_ECC) && defined(HAVE_ECC_KEY_EXPORT) && \
+    defined(HAVE_ECC_KEY_IMPORT)
+    {
+        int curveId = KeySharePool_EccCurveId(group);
 
-    if (params->p_len != dataSz) {
-        /* Pad the front of the key data with zeros. */
-        XMEMMOVE(keyData + params->p_len - dataSz, keyData, dataSz);
-        XMEMSET(keyData, 0, params->p_len - dataSz);
+        if (curveId != ECC_CURVE_INVALID) {
+            *privSz = (word32)wc_ecc_get_curve_size_from_id(curveId);
+            *pubSz = *privSz * 2 + 1;
+            return 0;
+        }
     }
-
-    kse->pubKey = keyData;
-    kse->pubKeyLen = params->p_len;
-    kse->key = key;
-    kse->keyLen = keySz;
-
-#ifdef WOLFSSL_DEBUG_TLS
-    WOLFSSL_MSG("Public DH Key");
-    WOLFSSL_BUFFER(keyData, params->p_len);
 #endif
 
-end:
+    (void)group;
+    (void)privSz;
+    (void)pubSz;
 
-    wc_FreeDhKey(dhKey);
-#ifdef WOLFSSL_SMALL_STACK
-    XFREE(dhKey, ssl->heap, DYNAMIC_TYPE_DH);
-#endif
+    return BAD_FUNC_ARG;
+}
 
-    if (ret != 0) {
-        /* Data owned by key share entry otherwise. */
-        if (keyData != NULL)
-            XFREE(keyData, ssl->heap, DYNAMIC_TYPE_PUBLIC_KEY);
+/* Generate the key pair of a pool entry.
+ * Buffers of the entry are allocated and sized by KeySharePool_KeySizes().
+ *
+ * rng    The random number generator.
+ * group  The named group.
+ * entry  The pool entry.
+ * heap   The heap used for allocation.
+ * returns 0 on success, otherwise failure.
+ */
+static int KeySharePool_GenKey(WC_RNG* rng, word16 group,
+                               KeySharePoolEntry* entry, void* heap)
+{
+    int ret = BAD_FUNC_ARG;
+
+#ifndef NO_DH
+    if ((group & NAMED_DH_MASK) == NAMED_DH_MASK) {
+        const DhParams* params;
+        word32          privSz;
+    #ifdef WOLFSSL_SMALL_STACK
+        DhKey*          dhKey;
+    #else
+        DhKey           dhKey[1];
+    #endif
+
+        params = KeySharePool_DhParams(group, &privSz);
+        if (params == NULL)
+            return BAD_FUNC_ARG;
+    #ifdef WOLFSSL_SMALL_STACK
+        dhKey = (DhKey*)XMALLOC(sizeof(DhKey), heap, DYNAMIC_TYPE_DH);
+        if (dhKey == NULL)
+            return MEMORY_E;
+    #endif
+        ret = wc_InitDhKey_ex(dhKey, heap, INVALID_DEVID);
+        if (ret == 0) {
+            ret = wc_DhSetKey(dhKey, (byte*)params->p, params->p_len,
+                                     (byte*)params->g, params->g_len);
+            if (ret == 0) {
+                ret = wc_DhGenerateKeyPair(dhKey, rng, entry->priv,
+                                  &entry->privSz, entry->pub, &entry->pubSz);
+            }
+            if (ret == 0 && entry->pubSz != params->p_len) {
+                /* Pad the front of the key data with zeros. */
+                XMEMMOVE(entry->pub + params->p_len - entry->pubSz,
+                         entry->pub, entry->pubSz);
+                XMEMSET(entry->pub, 0, params->p_len - entry->pubSz);
+                entry->pubSz = params->p_len;
+            }
+            wc_FreeDhKey(dhKey);
+        }
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(dhKey, heap, DYNAMIC_TYPE_DH);
+    #endif
+        return ret;
+    }
+#endif /* !NO_DH */
+#if defined(HAVE_CURVE25519) && defined(HAVE_CURVE25519_KEY_EXPORT) && \
+    defined(HAVE_CURVE25519_KEY_IMPORT)
+    if (group == WOLFSSL_ECC_X25519) {
+    #ifdef WOLFSSL_SMALL_STACK
+        curve25519_key* key;
+    #else
+        curve25519_key  key[1];
+    #endif
+
+    #ifdef WOLFSSL_SMALL_STACK
+        key = (curve25519_key*)XMALLOC(sizeof(curve25519_key), heap,
+                                                      DYNAMIC_TYPE_CURVE25519);
+        if (key == NULL)
+            return MEMORY_E;
+    #endif
+        ret = wc_curve25519_init(key);
+        if (ret == 0) {
+            ret = wc_curve25519_make_key(rng, CURVE25519_KEYSIZE, key);
+            if (ret == 0) {
+                ret = wc_curve25519_export_key_raw_ex(key, entry->priv,
+                                  &entry->privSz, entry->pub, &entry->pubSz,
+                                  EC25519_LITTLE_ENDIAN);
+            }
+            wc_curve25519_free(key);
+        }
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(key, heap, DYNAMIC_TYPE_CURVE25519);
+    #endif
+        return ret;
+    }
+#endif
+#if defined(HAVE_ECC) && defined(HAVE_ECC_KEY_EXPORT) && \
+    defined(HAVE_ECC_KEY_IMPORT)
+    {
+        int       curveId = KeySharePool_EccCurveId(group);
+    #ifdef WOLFSSL_SMALL_STACK
+        ecc_key*  key;
+    #else
+        ecc_key   key[1];
+    #endif
+
+        if (curveId == ECC_CURVE_INVALID)
+            return BAD_FUNC_ARG;
+    #ifdef WOLFSSL_SMALL_STACK
+        key = (ecc_key*)XMALLOC(sizeof(ecc_key), heap, DYNAMIC_TYPE_ECC);
+        if (key == NULL)
+            return MEMORY_E;
+    #endif
+        ret = wc_ecc_init_ex(key, heap, INVALID_DEVID);
+        if (ret == 0) {
+            ret = wc_ecc_make_key_ex(rng, (int)entry->privSz, key, curveId);
+            if (ret == 0) {
+                ret = wc_ecc_export_private_only(key, entry->priv,
+                                                 &entry->privSz);
+            }
+            if (ret == 0)
+                ret = wc_ecc_export_x963(key, entry->pub, &entry->pubSz);
+            wc_ecc_free(key);
+        }
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(key, heap, DYNAMIC_TYPE_ECC);
+    #endif
+    }
+#endif
+
+    (void)rng;
+    (void)group;
+    (void)entry;
+    (void)heap;
+
+    return ret;
+}
+
+/* Free a key pair taken from, or never added to, a pool.
+ * The private key is cleared before it is released.
+ *
+ * entry  The key pair.
+ * heap   The heap used for allocation.
+ */
+void KeySharePool_FreeEntry(KeySharePoolEntry* entry, void* heap)
+{
+    if (entry == NULL)
+        return;
+
+    if (entry->priv != NULL) {
+        ForceZero(entry->priv, entry->privSz);
+        XFREE(entry->priv, heap, DYNAMIC_TYPE_PRIVATE_KEY);
+    }
+    if (entry->pub != NULL)
+        XFREE(entry->pub, heap, DYNAMIC_TYPE_PUBLIC_KEY);
+    XFREE(entry, heap, DYNAMIC_TYPE_TLSX);
+
+    (void)heap;
+}
+
+/* Allocate a pool entry and generate its key pair.
+ *
+ * rng    The random number generator.
+ * group  The named group.
+ * heap   The heap used for allocation.
+ * entry  The new pool entry.
+ * returns 0 on success, otherwise failure.
+ */
+static int KeySharePool_Generate(WC_RNG* rng, word16 group, void* heap,
+                                 KeySharePoolEntry** entry)
+{
+    int                ret;
+    KeySharePoolEntry* e;
+
+    e = (KeySharePoolEntry*)XMALLOC(sizeof(KeySharePoolEntry), heap,
+                                                           DYNAMIC_TYPE_TLSX);
+    if (e == NULL)
+        return MEMORY_E;
+    XMEMSET(e, 0, sizeof(KeySharePoolEntry));
+
+    ret = KeySharePool_KeySizes(group, &e->privSz, &e->pubSz);
+    if (ret == 0) {
+        e->priv = (byte*)XMALLOC(e->privSz, heap, DYNAMIC_TYPE_PRIVATE_KEY);
+        e->pub = (byte*)XMALLOC(e->pubSz, heap, DYNAMIC_TYPE_PUBLIC_KEY);
+        if (e->priv == NULL || e->pub == NULL)
+            ret = MEMORY_E;
+    }
+    if (ret == 0)
+        ret = KeySharePool_GenKey(rng, group, e, heap);
+
+    if (ret != 0) {
+        KeySharePool_FreeEntry(e, heap);
+        return ret;
+    }
+
+    *entry = e;
+    return 0;
+}
+
+/* Find the slot of a named group. Pool lock must be held.
+ *
+ * pool   The key share pool.
+ * group  The named group, 0 finds an unused slot.
+ * returns the slot, or NULL when the group isn't pooled.
+ */
+static KeySharePoolGroup* KeySharePool_Find(KeySharePool* pool, word16 group)
+{
+    int i;
+
+    for (i = 0; i < KEY_SHARE_POOL_GROUPS; i++) {
+        if (pool->groups[i].group == group)
+            return &pool->groups[i];
+    }
+
+    return NULL;
+}
+
+/* Find a named group holding fewer key pairs than its depth.
+ * Pool lock must be held.
+ *
+ * pool  The key share pool.
+ * returns the named group, or 0 when every group is full.
+ */
+static word16 KeySharePool_Wanted(KeySharePool* pool)
+{
+    int i;
+
+    for (i = 0; i < KEY_SHARE_POOL_GROUPS; i++) {
+        if (pool->groups[i].group != 0 &&
+                                pool->groups[i].count < pool->groups[i].depth)
+            return pool->groups[i].group;
+    }
+
+    return 0;
+}
+
+/* Add a generated key pair to its group. The key pair is freed when the group
+ * was removed or filled by another caller while it was generated.
+ * Pool lock must be held.
+ *
+ * pool   The key share pool.
+ * group  The named group.
+ * entry  The generated key pair.
+ */
+static void KeySharePool_Add(KeySharePool* pool, word16 group,
+                             KeySharePoolEntry* entry)
+{
+    KeySharePoolGroup* slot = KeySharePool_Find(pool, group);
+
+    if (slot == NULL || slot->count >= slot->depth) {
+        KeySharePool_FreeEntry(entry, pool->heap);
+        return;
+    }
+
+    entry->next = slot->head;
+    slot->head = entry;
+    slot->count++;
+}
+
+/* Remove key pairs from a group until it holds no more than its depth.
+ * Pool lock must be held.
+ *
+ * pool  The key share pool.
+ * slot  The group.
+ */
+static void KeySharePool_Trim(KeySharePool* pool, KeySharePoolGroup* slot)
+{
+    KeySharePoolEntry* entry;
+
+    while (slot->count > slot->depth && (entry = slot->head) != NULL) {
+        slot->head = entry->next;
+        slot->count--;
+        KeySharePool_FreeEntry(entry, pool->heap);
+    }
+}
+
+/* Generate one key pair for a group that is below its depth.
+ * Generation is done without the pool lock held.
+ *
+ * pool  The key share pool.
+ * rng   The random number generator.
+ * returns 1 when a key pair was generated, 0 when the pool is full, otherwise
+ * failure.
+ */
+static int KeySharePool_FillOne(KeySharePool* pool, WC_RNG* rng)
+{
+    int                ret;
+    word16             group;
+    KeySharePoolEntry* entry = NULL;
+
+    if (wc_LockMutex(&pool->lock) != 0)
+        return BAD_MUTEX_E;
+    group = KeySharePool_Wanted(pool);
+    wc_UnLockMutex(&pool->lock);
+
+    if (group == 0)
+        return 0;
+
+    ret = KeySharePool_Generate(rng, group, pool->heap, &entry);
+    if (ret != 0)
+        return ret;
+
+    if (wc_LockMutex(&pool->lock) != 0) {
+        KeySharePool_FreeEntry(entry, pool->heap);
+        return BAD_MUTEX_E;
+    }
+    KeySharePool_Add(pool, group, entry);
+    wc_UnLockMutex(&pool->lock);
+
+    return 1;
+}
+
+#ifdef WOLFSSL_KEY_SHARE_POOL_THREAD
+/* Wait on the pool condition for a number of milliseconds.
+ * Called with the pool lock held.
+ *
+ * pool  The key share pool.
+ * ms    The time to wait in milliseconds.
+ * returns 0 when woken or timed out, otherwise failure.
+ */
+static int KeySharePool_Sleep(KeySharePool* pool, int ms)
+{
+    struct timespec ts;
+    int             ret;
+
+    if (clock_gettime(CLOCK_REALTIME, &ts) != 0)
+        return -1;
+    ts.tv_sec  += ms / 1000;
+    ts.tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+
+    ret = pthread_cond_timedwait(&pool->cond, &pool->lock, &ts);
+    if (ret == ETIMEDOUT)
+        ret = 0;
+
+    return ret;
+}
+
+/* Refill thread. Tops up the pool and waits for a take or a stop request.
+ * A failed generation is retried after a delay that doubles up to
+ * KEY_SHARE_POOL_RETRY_MAX_MS.
+ *
+ * arg  The key share pool.
+ * returns NULL.
+ */
+static void* KeySharePool_Thread(void* arg)
+{
+    KeySharePool*      pool = (KeySharePool*)arg;
+    KeySharePoolEntry* entry;
+    word16             group;
+    int                ret;
+    int                delay = 0;
+
+    if (wc_LockMutex(&pool->lock) != 0)
+        return NULL;
+
+    while (!pool->stop) {
+        group = KeySharePool_Wanted(pool);
+        if (group == 0) {
+            if (pthread_cond_wait(&pool->cond, &pool->lock) != 0)
+                break;
+            continue;
+        }
+
+        wc_UnLockMutex(&pool->lock);
+        entry = NULL;
+        ret = KeySharePool_Generate(&pool->rng, group, pool->heap, &entry);
+        if (wc_LockMutex(&pool->lock) != 0) {
+            KeySharePool_FreeEntry(entry, pool->heap);
+            return NULL;
+        }
+        if (ret != 0) {
+            WOLFSSL_MSG("Key share pool generation failed, retrying");
+            WOLFSSL_ERROR(ret);
+            if (delay == 0)
+                delay = KEY_SHARE_POOL_RETRY_MS;
+            else if (delay < KEY_SHARE_POOL_RETRY_MAX_MS / 2)
+                delay *= 2;
+            else
+                delay = KEY_SHARE_POOL_RETRY_MAX_MS;
+            if (!pool->stop && KeySharePool_Sleep(pool, delay) != 0)
+                break;
+            continue;
+        }
+        delay = 0;
+        KeySharePool_Add(pool, group, entry);
+    }
+
+    wc_UnLockMutex(&pool->lock);
+
+    return NULL;
+}
+#endif /* WOLFSSL_KEY_SHARE_POOL_THREAD */
+
+/* Get the pool of the context. The pointer is set once under the context
+ * lock and stays until the context is freed.
+ *
+ * ctx  The SSL/TLS context.
+ * returns the pool, or NULL when none is set.
+ */
+static KeySharePool* KeySharePool_Get(WOLFSSL_CTX* ctx)
+{
+    KeySharePool* pool;
+
+    if (wc_LockMutex(&ctx->countMutex) != 0)
+        return NULL;
+    pool = ctx->keySharePool;
+    wc_UnLockMutex(&ctx->countMutex);
+
+    return pool;
+}
+
+/* Take a key pair out of the pool of the context. A key pair is handed out
+ * once only; the caller frees it with KeySharePool_FreeEntry() using the heap
+ * of the context.
+ *
+ * ctx    The SSL/TLS context.
+ * group  The named group.
+ * returns the key pair, or NULL when none is ready.
+ */
+KeySharePoolEntry* KeySharePool_Take(WOLFSSL_CTX* ctx, word16 group)
+{
+    KeySharePool*      pool;
+    KeySharePoolGroup* slot;
+    KeySharePoolEntry* entry = NULL;
+
+    if (ctx == NULL || (pool = KeySharePool_Get(ctx)) == NULL)
+        return NULL;
+
+    if (wc_LockMutex(&pool->lock) != 0)
+        return NULL;
+
+    slot = KeySharePool_Find(pool, group);
+    if (slot != NULL && (entry = slot->head) != NULL) {
+        slot->head = entry->next;
+        slot->count--;
+        entry->next = NULL;
+    #ifdef WOLFSSL_KEY_SHARE_POOL_THREAD
+        if (pool->running)
+            pthread_cond_signal(&pool->cond);
+    #endif
+    }
+
+    wc_UnLockMutex(&pool->lock);
+
+    WOLFSSL_MSG(entry != NULL ? "Key share taken from pool" :
+                                "Key share pool empty");
+
+    return entry;
+}
+
+/* Stop the refill thread and free the pool of the context.
+ *
+ * ctx  The SSL/TLS context.
+ */
+void KeySharePool_Free(WOLFSSL_CTX* ctx)
+{
+    KeySharePool*      pool = ctx->keySharePool;
+    KeySharePoolEntry* entry;
+    int                i;
+
+    if (pool == NULL)
+        return;
+
+    wolfSSL_CTX_KeySharePoolStop(ctx);
+
+    for (i = 0; i < KEY_SHARE_POOL_GROUPS; i++) {
+        while ((entry = pool->groups[i].head) != NULL) {
+            pool->groups[i].head = entry->next;
+            KeySharePool_FreeEntry(entry, pool->heap);
+        }
+    }
+#ifdef WOLFSSL_KEY_SHARE_POOL_THREAD
+    pthread_cond_destroy(&pool->cond);
+#endif
+    wc_FreeMutex(&pool->lock);
+    XFREE(pool, ctx->heap, DYNAMIC_TYPE_TLSX);
+    ctx->keySharePool = NULL;
+}
+
+/* Create the pool of the context when not already set.
+ * Creation is done under the context lock so that racing callers share one
+ * pool.
+ *
+ * ctx   The SSL/TLS context.
+ * pool  The pool of the context.
+ * returns 0 on success, otherwise failure.
+ */
+static int KeySharePool_New(WOLFSSL_CTX* ctx, KeySharePool** pool)
+{
+    KeySharePool* p;
+
+    p = (KeySharePool*)XMALLOC(sizeof(KeySharePool), ctx->heap,
+                                                           DYNAMIC_TYPE_TLSX);
+    if (p == NULL)
+        return MEMORY_E;
+    XMEMSET(p, 0, sizeof(KeySharePool));
+    p->heap = ctx->heap;
+    if (wc_InitMutex(&p->lock) != 0) {
+        XFREE(p, ctx->heap, DYNAMIC_TYPE_TLSX);
+        return BAD_MUTEX_E;
+    }
+#ifdef WOLFSSL_KEY_SHARE_POOL_THREAD
+    if (pthread_cond_init(&p->cond, NULL) != 0) {
+        wc_FreeMutex(&p->lock);
+        XFREE(p, ctx->heap, DYNAMIC_TYPE_TLSX);
+        return BAD_COND_E;
+    }
+#endif
+
+    if (wc_LockMutex(&ctx->countMutex) != 0) {
+    #ifdef WOLFSSL_KEY_SHARE_POOL_THREAD
+        pthread_cond_destroy(&p->cond);
+    #endif
+        wc_FreeMutex(&p->lock);
+        XFREE(p, ctx->heap, DYNAMIC_TYPE_TLSX);
+        return BAD_MUTEX_E;
+    }
+    if (ctx->keySharePool == NULL) {
+        ctx->keySharePool = p;
+        p = NULL;
+    }
+    *pool = ctx->keySharePool;
+    wc_UnLockMutex(&ctx->countMutex);
+
+    /* Another caller set the pool first. */
+    if (p != NULL) {
+    #ifdef WOLFSSL_KEY_SHARE_POOL_THREAD
+        pthread_cond_destroy(&p->cond);
+    #endif
+        wc_FreeMutex(&p->lock);
+        XFREE(p, ctx->heap, DYNAMIC_TYPE_TLSX);
+    }
+
+    return 0;
+}
+
+/* Keep key pairs of a named group generated ahead of the handshakes of the
+ * context. Each key pair is used by one handshake only. A depth of 0 stops
+ * pooling the group.
+ *
+ * ctx    The SSL/TLS context.
+ * group  The named group: SECP256R1, SECP384R1, SECP521R1, X25519 or FFDHE.
+ * depth  The number of key pairs to keep ready.
+ * returns WOLFSSL_SUCCESS on success, BAD_FUNC_ARG when the group can't be
+ * pooled and BUFFER_E when KEY_SHARE_POOL_GROUPS groups are pooled already.
+ */
+int wolfSSL_CTX_UseKeySharePool(WOLFSSL_CTX* ctx, word16 group, int depth)
+{
+    int                ret = WOLFSSL_SUCCESS;
+    word32             privSz;
+    word32             pubSz;
+    KeySharePool*      pool;
+    KeySharePoolGroup* slot;
+
+    WOLFSSL_ENTER("wolfSSL_CTX_UseKeySharePool");
+
+    if (ctx == NULL || group == 0 || depth < 0 ||
+                                              depth > KEY_SHARE_POOL_MAX_DEPTH)
+        return BAD_FUNC_ARG;
+    if (KeySharePool_KeySizes(group, &privSz, &pubSz) != 0)
+        return BAD_FUNC_ARG;
+
+    if ((pool = KeySharePool_Get(ctx)) == NULL) {
+        if (depth == 0)
+            return WOLFSSL_SUCCESS;
+        if ((ret = KeySharePool_New(ctx, &pool)) != 0)
+            return ret;
+        ret = WOLFSSL_SUCCESS;
+    }
+
+    if (wc_LockMutex(&pool->lock) != 0)
+        return BAD_MUTEX_E;
+
+    slot = KeySharePool_Find(pool, group);
+    if (slot == NULL && depth > 0) {
+        slot = KeySharePool_Find(pool, 0);
+        if (slot == NULL)
+            ret = BUFFER_E;
+        else
+            slot->group = group;
+    }
+    if (slot != NULL) {
+        slot->depth = depth;
+        KeySharePool_Trim(pool, slot);
+        if (depth == 0)
+            slot->group = 0;
+    #ifdef WOLFSSL_KEY_SHARE_POOL_THREAD
+        if (pool->running)
+            pthread_cond_signal(&pool->cond);
+    #endif
+    }
+
+    wc_UnLockMutex(&pool->lock);
+
+    WOLFSSL_LEAVE("wolfSSL_CTX_UseKeySharePool", ret);
+
+    return ret;
+}
+
+/* Generate key pairs until every pooled group of the context is at its depth.
+ * Intended to be called when the application is idle.
+ *
+ * ctx  The SSL/TLS context.
+ * returns WOLFSSL_SUCCESS on success, otherwise failure.
+ */
+int wolfSSL_CTX_KeySharePoolRefill(WOLFSSL_CTX* ctx)
+{
+    int           ret;
+    KeySharePool* pool;
+#ifdef WOLFSSL_SMALL_STACK
+    WC_RNG* rng;
+#else
+    WC_RNG  rng[1];
+#endif
+
+    WOLFSSL_ENTER("wolfSSL_CTX_KeySharePoolRefill");
+
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+    if ((pool = KeySharePool_Get(ctx)) == NULL)
+        return WOLFSSL_SUCCESS;
+
+#ifdef WOLFSSL_SMALL_STACK
+    rng = (WC_RNG*)XMALLOC(sizeof(WC_RNG), ctx->heap, DYNAMIC_TYPE_RNG);
+    if (rng == NULL)
+        return MEMORY_E;
+#endif
+
+    ret = wc_InitRng_ex(rng, ctx->heap, INVALID_DEVID);
+    if (ret == 0) {
+        while ((ret = KeySharePool_FillOne(pool, rng)) == 1)
+            ;
+        wc_FreeRng(rng);
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(rng, ctx->heap, DYNAMIC_TYPE_RNG);
+#endif
+
+    if (ret == 0)
+        ret = WOLFSSL_SUCCESS;
+
+    WOLFSSL_LEAVE("wolfSSL_CTX_KeySharePoolRefill", ret);
+
+    return ret;
+}
+
+/* Get the number of key pairs of a named group ready in the pool.
+ *
+ * ctx    The SSL/TLS context.
+ * group  The named group.
+ * returns the number of key pairs, or BAD_FUNC_ARG when ctx is NULL.
+ */
+int wolfSSL_CTX_KeySharePoolCount(WOLFSSL_CTX* ctx, word16 group)
+{
+    int                count = 0;
+    KeySharePool*      pool;
+    KeySharePoolGroup* slot;
+
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+    if ((pool = KeySharePool_Get(ctx)) == NULL)
+        return 0;
+
+    if (wc_LockMutex(&pool->lock) != 0)
+        return BAD_MUTEX_E;
+    slot = KeySharePool_Find(pool, group);
+    if (slot != NULL)
+        count = slot->count;
+    wc_UnLockMutex(&pool->lock);
+
+    return count;
+}
+
+/* Start a thread that keeps the pool of the context topped up. The thread
+ * generates a replacement each time a handshake takes a key pair.
+ * Pooled groups are set with wolfSSL_CTX_UseKeySharePool() first.
+ *
+ * ctx  The SSL/TLS context.
+ * returns WOLFSSL_SUCCESS on success, NOT_COMPILED_IN without thread support,
+ * otherwise failure.
+ */
+int wolfSSL_CTX_KeySharePoolStart(WOLFSSL_CTX* ctx)
+{
+#ifdef WOLFSSL_KEY_SHARE_POOL_THREAD
+    int           ret;
+    KeySharePool* pool;
+
+    WOLFSSL_ENTER("wolfSSL_CTX_KeySharePoolStart");
+
+    if (ctx == NULL || (pool = KeySharePool_Get(ctx)) == NULL)
+        return BAD_FUNC_ARG;
+
+    if (wc_LockMutex(&pool->lock) != 0)
+        return BAD_MUTEX_E;
+    if (pool->running) {
+        /* A stop in progress still owns the thread and RNG. */
+        ret = pool->stop ? BAD_STATE_E : WOLFSSL_SUCCESS;
+        wc_UnLockMutex(&pool->lock);
+        WOLFSSL_MSG("Key share pool thread already running");
+        return ret;
+    }
+
+    ret = wc_InitRng_ex(&pool->rng, pool->heap, INVALID_DEVID);
+    if (ret == 0) {
+        pool->stop = 0;
+        if (pthread_create(&pool->tid, NULL, KeySharePool_Thread, pool) != 0) {
+            WOLFSSL_MSG("Thread creation error");
+            wc_FreeRng(&pool->rng);
+            ret = THREAD_CREATE_E;
+        }
+        else {
+            pool->running = 1;
+            ret = WOLFSSL_SUCCESS;
+        }
+    }
+    wc_UnLockMutex(&pool->lock);
+
+    return ret;
+#else
+    (void)ctx;
+
+    WOLFSSL_MSG("Key share pool thread not compiled in");
+
+    return NOT_COMPILED_IN;
+#endif
+}
+
+/* Stop the refill thread of the context. Pooled key pairs are kept.
+ *
+ * ctx  The SSL/TLS context.
+ * returns WOLFSSL_SUCCESS on success, otherwise failure.
+ */
+int wolfSSL_CTX_KeySharePoolStop(WOLFSSL_CTX* ctx)
+{
+#ifdef WOLFSSL_KEY_SHARE_POOL_THREAD
+    KeySharePool* pool;
+    pthread_t     tid;
+
+    WOLFSSL_ENTER("wolfSSL_CTX_KeySharePoolStop");
+
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+    if ((pool = KeySharePool_Get(ctx)) == NULL)
+        return WOLFSSL_SUCCESS;
+
+    if (wc_LockMutex(&pool->lock) != 0)
+        return BAD_MUTEX_E;
+    if (!pool->running || pool->stop) {
+        /* Not started, or another caller is stopping it. */
+        wc_UnLockMutex(&pool->lock);
+        return WOLFSSL_SUCCESS;
+    }
+    pool->stop = 1;
+    tid = pool->tid;
+    pthread_cond_signal(&pool->cond);
+    wc_UnLockMutex(&pool->lock);
+
+    pthread_join(tid, NULL);
+    wc_FreeRng(&pool->rng);
+
+    if (wc_LockMutex(&pool->lock) != 0)
+        return BAD_MUTEX_E;
+    pool->running = 0;
+    pool->stop = 0;
+    wc_UnLockMutex(&pool->lock);
+
+    return WOLFSSL_SUCCESS;
+#else
+    if (ctx == NULL)
+        return BAD_FUNC_ARG;
+
+    return WOLFSSL_SUCCESS;
+#endif
+}
+
+#endif /* WOLFSSL_KEY_SHARE_POOL */
+
+/******************************************************************************/
+/* Key Share                                                                  */
+/******************************************************************************/
+
+#ifdef WOLFSSL_TLS13
+/* Create a key share entry using named Diffie-Hellman parameters group.
+ * Generates a key pair.
+ *
+ * ssl   The SSL/TLS object.
+ * kse   The key share entry object.
+ * returns 0 on success, otherwise failure.
+ */
+static int TLSX_KeyShare_GenDhKey(WOLFSSL *ssl, KeyShareEntry* kse)
+{
+    int             ret;
+#ifndef NO_DH
+    byte*           keyData;
+    void*           key = NULL;
+    word32          keySz;
+    word32          dataSz;
+    const DhParams* params;
+#ifdef WOLFSSL_SMALL_STACK
+    DhKey*          dhKey = NULL;
+#else
+    DhKey           dhKey[1];
+#endif
+
+    /* TODO: [TLS13] The key size should come from wolfcrypt. */
+    /* Pick the parameters from the named group. */
+    switch (kse->group) {
+    #ifdef HAVE_FFDHE_2048
+        case WOLFSSL_FFDHE_2048:
+            params = wc_Dh_ffdhe2048_Get();
+            keySz = 29;
+            break;
+    #endif
+    #ifdef HAVE_FFDHE_3072
+        case WOLFSSL_FFDHE_3072:
+            params = wc_Dh_ffdhe3072_Get();
+            keySz = 34;
+            break;
+    #endif
+    #ifdef HAVE_FFDHE_4096
+        case WOLFSSL_FFDHE_4096:
+            params = wc_Dh_ffdhe4096_Get();
+            keySz = 39;
+            break;
+    #endif
+    #ifdef HAVE_FFDHE_6144
+        case WOLFSSL_FFDHE_6144:
+            params = wc_Dh_ffdhe6144_Get();
+            keySz = 46;
+            break;
+    #endif
+    #ifdef HAVE_FFDHE_8192
+        case WOLFSSL_FFDHE_8192:
+            params = wc_Dh_ffdhe8192_Get();
+            keySz = 52;
+            break;
+    #endif
+        default:
+            return BAD_FUNC_ARG;
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    dhKey = (DhKey*)XMALLOC(sizeof(DhKey), ssl->heap, DYNAMIC_TYPE_DH);
+    if (dhKey == NULL)
+        return MEMORY_E;
+#endif
+
+    ret = wc_InitDhKey_ex(dhKey, ssl->heap, ssl->devId);
+    if (ret != 0) {
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(dhKey, ssl->heap, DYNAMIC_TYPE_DH);
+    #endif
+        return ret;
+    }
+
+    /* Allocate space for the public key. */
+    dataSz = params->p_len;
+    keyData = (byte*)XMALLOC(dataSz, ssl->heap, DYNAMIC_TYPE_PUBLIC_KEY);
+    if (keyData == NULL) {
+        ret = MEMORY_E;
+        goto end;
+    }
+    /* Allocate space for the private key. */
+    key = (byte*)XMALLOC(keySz, ssl->heap, DYNAMIC_TYPE_PRIVATE_KEY);
+    if (key == NULL) {
+        ret = MEMORY_E;
+        goto end;
+    }
+
+    /* Set key */
+    ret = wc_DhSetKey(dhKey,
+        (byte*)params->p, params->p_len,
+        (byte*)params->g, params->g_len);
+    if (ret != 0)
+        goto end;
+
+    /* Generate a new key pair. */
+    ret = wc_DhGenerateKeyPair(dhKey, ssl->rng, (byte*)key, &keySz, keyData,
+                               &dataSz);
+#ifdef WOLFSSL_ASYNC_CRYPT
+    /* TODO: Make this function non-blocking */
+    if (ret == WC_PENDING_E) {
+        ret = wc_AsyncWait(ret, &dhKey->asyncDev, WC_ASYNC_FLAG_NONE);
+    }
+#endif
+    if (ret != 0)
+        goto end;
+
+    if (params->p_len != dataSz) {
+        /* Pad the front of the key data with zeros. */
+        XMEMMOVE(keyData + params->p_len - dataSz, keyData, dataSz);
+        XMEMSET(keyData, 0, params->p_len - dataSz);
+    }
+
+    kse->pubKey = keyData;
+    kse->pubKeyLen = params->p_len;
+    kse->key = key;
+    kse->keyLen = keySz;
+
+#ifdef WOLFSSL_DEBUG_TLS
+    WOLFSSL_MSG("Public DH Key");
+    WOLFSSL_BUFFER(keyData, params->p_len);
+#endif
+
+end:
+
+    wc_FreeDhKey(dhKey);
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(dhKey, ssl->heap, DYNAMIC_TYPE_DH);
+#endif
+
+    if (ret != 0) {
+        /* Data owned by key share entry otherwise. */
+        if (keyData != NULL)
+            XFREE(keyData, ssl->heap, DYNAMIC_TYPE_PUBLIC_KEY);
         if (key != NULL)
             XFREE(key, ssl->heap, DYNAMIC_TYPE_PRIVATE_KEY);
     }
@@ -7006,6 +8103,97 @@ end:
     return ret;
 }
 
+#ifdef WOLFSSL_KEY_SHARE_POOL
+/* Set the key pair of a key share entry from one generated ahead of time.
+ *
+ * ssl    The SSL/TLS object.
+ * kse    The key share entry object.
+ * entry  The key pair taken from the pool, freed by this function.
+ * returns 0 on success, otherwise failure.
+ */
+static int TLSX_KeyShare_PoolKey(WOLFSSL *ssl, KeyShareEntry* kse,
+                                 KeySharePoolEntry* entry)
+{
+    int   ret = 0;
+    int   keyInit = 0;
+    void* key = NULL;
+    byte* keyData;
+
+    keyData = (byte*)XMALLOC(entry->pubSz, ssl->heap, DYNAMIC_TYPE_PUBLIC_KEY);
+    if (keyData == NULL)
+        ret = MEMORY_E;
+
+    if (ret == 0 && (kse->group & NAMED_DH_MASK) == NAMED_DH_MASK) {
+        key = XMALLOC(entry->privSz, ssl->heap, DYNAMIC_TYPE_PRIVATE_KEY);
+        if (key == NULL)
+            ret = MEMORY_E;
+        else {
+            XMEMCPY(key, entry->priv, entry->privSz);
+            kse->keyLen = entry->privSz;
+        }
+    }
+#if defined(HAVE_CURVE25519) && defined(HAVE_CURVE25519_KEY_IMPORT)
+    else if (ret == 0 && kse->group == WOLFSSL_ECC_X25519) {
+        key = XMALLOC(sizeof(curve25519_key), ssl->heap,
+                                                      DYNAMIC_TYPE_PRIVATE_KEY);
+        if (key == NULL)
+            ret = MEMORY_E;
+        if (ret == 0)
+            ret = wc_curve25519_init((curve25519_key*)key);
+        if (ret == 0) {
+            keyInit = 1;
+            ret = wc_curve25519_import_private_raw_ex(entry->priv,
+                                 entry->privSz, entry->pub, entry->pubSz,
+                                 (curve25519_key*)key, EC25519_LITTLE_ENDIAN);
+        }
+    }
+#endif
+#if defined(HAVE_ECC) && defined(HAVE_ECC_KEY_EXPORT) && \
+    defined(HAVE_ECC_KEY_IMPORT)
+    else if (ret == 0) {
+        key = XMALLOC(sizeof(ecc_key), ssl->heap, DYNAMIC_TYPE_PRIVATE_KEY);
+        if (key == NULL)
+            ret = MEMORY_E;
+        if (ret == 0)
+            ret = wc_ecc_init_ex((ecc_key*)key, ssl->heap, ssl->devId);
+        if (ret == 0) {
+            keyInit = 1;
+            ret = wc_ecc_import_private_key_ex(entry->priv, entry->privSz,
+                                   entry->pub, entry->pubSz, (ecc_key*)key,
+                                   KeySharePool_EccCurveId(kse->group));
+        }
+    }
+#endif
+
+    if (ret == 0) {
+        XMEMCPY(keyData, entry->pub, entry->pubSz);
+        kse->pubKey = keyData;
+        kse->pubKeyLen = entry->pubSz;
+        kse->key = key;
+    }
+    else {
+        if (keyInit) {
+        #ifdef HAVE_CURVE25519
+            if (kse->group == WOLFSSL_ECC_X25519)
+                wc_curve25519_free((curve25519_key*)key);
+        #endif
+        #ifdef HAVE_ECC
+            if (kse->group != WOLFSSL_ECC_X25519)
+                wc_ecc_free((ecc_key*)key);
+        #endif
+        }
+        if (key != NULL)
+            XFREE(key, ssl->heap, DYNAMIC_TYPE_PRIVATE_KEY);
+        if (keyData != NULL)
+            XFREE(keyData, ssl->heap, DYNAMIC_TYPE_PUBLIC_KEY);
+    }
+
+    KeySharePool_FreeEntry(entry, ssl->ctx->heap);
+
+    return ret;
+}
+#endif /* WOLFSSL_KEY_SHARE_POOL */
+
 /* Generate a secret/key using the key share entry.
  *
  * ssl  The SSL/TLS object.
@@ -7013,6 +8201,14 @@ end:
  */
 static int TLSX_KeyShare_GenKey(WOLFSSL *ssl, KeyShareEntry *kse)
 {
+#ifdef WOLFSSL_KEY_SHARE_POOL
+    KeySharePoolEntry* entry = KeySharePool_Take(ssl->ctx, kse->group);
+
+    /* Use a key pair generated ahead of time when one is ready. */
+    if (entry != NULL)
+        return TLSX_KeyShare_PoolKey(ssl, kse, entry);
+#endif
+
     /* Named FFHE groups have a bit set to identify them. */
     if ((kse->group & NAMED_DH_MASK) == NAMED_DH_MASK)
         return TLSX_KeyShare_GenDhKey(ssl, kse);
@@ -9206,6 +10402,11 @@ void TLSX_FreeAll(TLSX* list, void* heap)
             case TLSX_ENCRYPT_THEN_MAC:
                 break;
 #endif
+#ifdef WOLFSSL_DTLS_CID
+            case TLSX_CONNECTION_ID:
+                /* data is part of the SSL object */
+                break;
+#endif
 #ifdef WOLFSSL_TLS13
             case TLSX_SUPPORTED_VERSIONS:
                 break;
@@ -9348,6 +10549,11 @@ static int TLSX_GetSize(TLSX* list, byte* semaphore, byte msgType,
                 ret = ETM_GET_SIZE(msgType, &length);
                 break;
 #endif /* HAVE_ENCRYPT_THEN_MAC */
+#ifdef WOLFSSL_DTLS_CID
+            case TLSX_CONNECTION_ID:
+                ret = CID_GET_SIZE(extension->data, msgType, &length);
+                break;
+#endif
 #ifdef WOLFSSL_TLS13
             case TLSX_SUPPORTED_VERSIONS:
                 ret = SV_GET_SIZE(extension->data, msgType, &length);
@@ -9517,6 +10723,13 @@ static int TLSX_Write(TLSX* list, byte* output, byte* semaphore,
                 ret = ETM_WRITE(extension->data, output, msgType, &offset);
                 break;
 #endif /* HAVE_ENCRYPT_THEN_MAC */
+#ifdef WOLFSSL_DTLS_CID
+            case TLSX_CONNECTION_ID:
+                WOLFSSL_MSG("Connection ID extension to write");
+                ret = CID_WRITE(extension->data, output + offset, msgType,
+                                &offset);
+                break;
+#endif
 #ifdef WOLFSSL_TLS13
             case TLSX_SUPPORTED_VERSIONS:
                 WOLFSSL_MSG("Supported Versions extension to write");
@@ -10508,6 +11721,7 @@ int TLSX_GetResponseSize(WOLFSSL* ssl, byte msgType, word16* pLength)
 #ifndef NO_WOLFSSL_SERVER
         case server_hello:
             PF_VALIDATE_RESPONSE(ssl, semaphore);
+            CID_VALIDATE_RESPONSE(ssl, semaphore);
     #ifdef WOLFSSL_TLS13
                 if (IsAtLeastTLSv1_3(ssl->version)) {
                     XMEMSET(semaphore, 0xff, SEMAPHORE_SIZE);
@@ -10628,6 +11842,7 @@ int TLSX_WriteResponse(WOLFSSL *ssl, byte* output, byte msgType, word16* pOffset
 #ifndef NO_WOLFSSL_SERVER
             case server_hello:
                 PF_VALIDATE_RESPONSE(ssl, semaphore);
+                CID_VALIDATE_RESPONSE(ssl, semaphore);
     #ifdef WOLFSSL_TLS13
                 if (IsAtLeastTLSv1_3(ssl->version)) {
                     XMEMSET(semaphore, 0xff, SEMAPHORE_SIZE);
@@ -11083,6 +12298,18 @@ int TLSX_Parse(WOLFSSL* ssl, byte* input, word16 length, byte msgType,
                 break;
 #endif /* HAVE_ENCRYPT_THEN_MAC */
 
+#ifdef WOLFSSL_DTLS_CID
+            case TLSX_CONNECTION_ID:
+                WOLFSSL_MSG("Connection ID extension received");
+
+                /* Only defined for DTLS 1.2 records */
+                if (IsAtLeastTLSv1_3(ssl->version))
+                    break;
+
+                ret = CID_PARSE(ssl, input + offset, size, msgType);
+                break;
+#endif
+
 #ifdef WOLFSSL_TLS13
             case TLSX_SUPPORTED_VERSIONS:
                 WOLFSSL_MSG("Skipping Supported Versions - already processed");
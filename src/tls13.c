@@ -400,8 +400,12 @@ static int DeriveKey(WOLFSSL* ssl, byte* output, int outputLen,
             case sha256_mac:
                 hashSz    = WC_SHA256_DIGEST_SIZE;
                 digestAlg = WC_SHA256;
-                if (includeMsgs)
-                    ret = wc_Sha256GetHash(&ssl->hsHashes->hashSha256, hash);
+                if (includeMsgs) {
+                    ret = SetHandshakeHashes(ssl, HS_HASH_SHA256);
+                    if (ret == 0)
+                        ret = wc_Sha256GetHash(&ssl->hsHashes->hashSha256,
+                                                                         hash);
+                }
             break;
         #endif
 
@@ -409,8 +413,12 @@ static int DeriveKey(WOLFSSL* ssl, byte* output, int outputLen,
             case sha384_mac:
                 hashSz    = WC_SHA384_DIGEST_SIZE;
                 digestAlg = WC_SHA384;
-                if (includeMsgs)
-                    ret = wc_Sha384GetHash(&ssl->hsHashes->hashSha384, hash);
+                if (includeMsgs) {
+                    ret = SetHandshakeHashes(ssl, HS_HASH_SHA384);
+                    if (ret == 0)
+                        ret = wc_Sha384GetHash(&ssl->hsHashes->hashSha384,
+                                                                         hash);
+                }
             break;
         #endif
 
@@ -418,8 +426,12 @@ static int DeriveKey(WOLFSSL* ssl, byte* output, int outputLen,
             case sha512_mac:
                 hashSz    = WC_SHA512_DIGEST_SIZE;
                 digestAlg = WC_SHA512;
-                if (includeMsgs)
-                    ret = wc_Sha512GetHash(&ssl->hsHashes->hashSha512, hash);
+                if (includeMsgs) {
+                    ret = SetHandshakeHashes(ssl, HS_HASH_SHA512);
+                    if (ret == 0)
+                        ret = wc_Sha512GetHash(&ssl->hsHashes->hashSha512,
+                                                                         hash);
+                }
             break;
         #endif
     }
@@ -1005,21 +1017,27 @@ static int BuildTls13HandshakeHmac(WOLFSSL* ssl, byte* key, byte* hash,
         case sha256_mac:
             hashType = WC_SHA256;
             hashSz = WC_SHA256_DIGEST_SIZE;
-            ret = wc_Sha256GetHash(&ssl->hsHashes->hashSha256, hash);
+            ret = SetHandshakeHashes(ssl, HS_HASH_SHA256);
+            if (ret == 0)
+                ret = wc_Sha256GetHash(&ssl->hsHashes->hashSha256, hash);
             break;
     #endif /* !NO_SHA256 */
     #ifdef WOLFSSL_SHA384
         case sha384_mac:
             hashType = WC_SHA384;
             hashSz = WC_SHA384_DIGEST_SIZE;
-            ret = wc_Sha384GetHash(&ssl->hsHashes->hashSha384, hash);
+            ret = SetHandshakeHashes(ssl, HS_HASH_SHA384);
+            if (ret == 0)
+                ret = wc_Sha384GetHash(&ssl->hsHashes->hashSha384, hash);
             break;
     #endif /* WOLFSSL_SHA384 */
     #ifdef WOLFSSL_TLS13_SHA512
         case sha512_mac:
             hashType = WC_SHA512;
             hashSz = WC_SHA512_DIGEST_SIZE;
-            ret = wc_Sha512GetHash(&ssl->hsHashes->hashSha512, hash);
+            ret = SetHandshakeHashes(ssl, HS_HASH_SHA512);
+            if (ret == 0)
+                ret = wc_Sha512GetHash(&ssl->hsHashes->hashSha512, hash);
             break;
     #endif /* WOLFSSL_TLS13_SHA512 */
     }
@@ -1063,6 +1081,8 @@ static const byte writeIVLabel[WRITE_IV_LABEL_SZ+1]   = "iv";
  *          traffic messages.
  *          update_traffic_key when deriving next keys and IVs for encrypting
  *          traffic messages.
+ *          no_key when only deriving keys and IVs from the secrets already
+ *          set, as the sniffer does with secrets from a key log.
  * side     ENCRYPT_SIDE_ONLY when only encryption secret needs to be derived.
  *          DECRYPT_SIDE_ONLY when only decryption secret needs to be derived.
  *          ENCRYPT_AND_DECRYPT_SIDE when both secret needs to be derived.
@@ -1070,7 +1090,7 @@ static const byte writeIVLabel[WRITE_IV_LABEL_SZ+1]   = "iv";
  *          store ready for provisioning.
  * returns 0 on success, otherwise failure.
  */
-static int DeriveTls13Keys(WOLFSSL* ssl, int secret, int side, int store)
+int DeriveTls13Keys(WOLFSSL* ssl, int secret, int side, int store)
 {
     int   ret = BAD_FUNC_ARG; /* Assume failure */
     int   i = 0;
@@ -1425,40 +1445,6 @@ end:
 #endif
 #endif /* HAVE_SESSION_TICKET || !NO_PSK */
 
-
-#if !defined(NO_WOLFSSL_SERVER) && (defined(HAVE_SESSION_TICKET) || \
-                                    !defined(NO_PSK))
-/* Add input to all handshake hashes.
- *
- * ssl    The SSL/TLS object.
- * input  The data to hash.
- * sz     The size of the data to hash.
- * returns 0 on success, otherwise failure.
- */
-static int HashInputRaw(WOLFSSL* ssl, const byte* input, int sz)
-{
-    int ret = BAD_FUNC_ARG;
-
-#ifndef NO_SHA256
-    ret = wc_Sha256Update(&ssl->hsHashes->hashSha256, input, sz);
-    if (ret != 0)
-        return ret;
-#endif
-#ifdef WOLFSSL_SHA384
-    ret = wc_Sha384Update(&ssl->hsHashes->hashSha384, input, sz);
-    if (ret != 0)
-        return ret;
-#endif
-#ifdef WOLFSSL_TLS13_SHA512
-    ret = wc_Sha512Update(&ssl->hsHashes->hashSha512, input, sz);
-    if (ret != 0)
-        return ret;
-#endif
-
-    return ret;
-}
-#endif
-
 /* Extract the handshake header information.
  *
  * ssl       The SSL/TLS object.
@@ -3197,6 +3183,8 @@ int DoTls13ServerHello(WOLFSSL* ssl, const byte* input, word32* inOutIdx,
         ssl->chVersion.minor = TLSv1_2_MINOR;
         /* Complete TLS v1.2 processing of ServerHello. */
         ret = CompleteServerHello(ssl);
+        if (ret == 0)
+            ret = FinalizeHandshakeHashes(ssl);
 #else
         WOLFSSL_MSG("Client using higher version, fatal error");
         ret = VERSION_ERROR;
@@ -3270,6 +3258,9 @@ int DoTls13ServerHello(WOLFSSL* ssl, const byte* input, word32* inOutIdx,
     if (*extMsgType == server_hello) {
         ssl->keys.encryptionOn = 1;
         ssl->options.serverState = SERVER_HELLO_COMPLETE;
+
+        /* Cipher suite is known, only keep the hash it needs. */
+        ret = FinalizeHandshakeHashes(ssl);
     }
     else {
         ssl->options.tls1_3 = 1;
@@ -3764,7 +3755,7 @@ static int DoPreSharedKeys(WOLFSSL* ssl, const byte* input, word32 helloSz,
     }
 
     /* Hash the rest of the ClientHello. */
-    ret = HashInputRaw(ssl, input + helloSz - bindersLen, bindersLen);
+    ret = HashRaw(ssl, input + helloSz - bindersLen, bindersLen);
     if (ret != 0)
         return ret;
 
@@ -4512,7 +4503,11 @@ int SendTls13ServerHello(WOLFSSL* ssl, byte extMsgType)
         if ((ret = RestartHandshakeHash(ssl)) < 0)
             return ret;
     }
+    else
 #endif
+    /* Cipher suite is known, only keep the hash it needs. */
+    if ((ret = FinalizeHandshakeHashes(ssl)) != 0)
+        return ret;
 
 #ifdef WOLFSSL_TLS13_DRAFT_18
     /* Protocol version, server random, cipher suite and extensions. */
@@ -4972,21 +4967,27 @@ static WC_INLINE int GetMsgHash(WOLFSSL* ssl, byte* hash)
     switch (ssl->specs.mac_algorithm) {
     #ifndef NO_SHA256
         case sha256_mac:
-            ret = wc_Sha256GetHash(&ssl->hsHashes->hashSha256, hash);
+            ret = SetHandshakeHashes(ssl, HS_HASH_SHA256);
+            if (ret == 0)
+                ret = wc_Sha256GetHash(&ssl->hsHashes->hashSha256, hash);
             if (ret == 0)
                 ret = WC_SHA256_DIGEST_SIZE;
             break;
     #endif /* !NO_SHA256 */
     #ifdef WOLFSSL_SHA384
         case sha384_mac:
-            ret = wc_Sha384GetHash(&ssl->hsHashes->hashSha384, hash);
+            ret = SetHandshakeHashes(ssl, HS_HASH_SHA384);
+            if (ret == 0)
+                ret = wc_Sha384GetHash(&ssl->hsHashes->hashSha384, hash);
             if (ret == 0)
                 ret = WC_SHA384_DIGEST_SIZE;
             break;
     #endif /* WOLFSSL_SHA384 */
     #ifdef WOLFSSL_TLS13_SHA512
         case sha512_mac:
-            ret = wc_Sha512GetHash(&ssl->hsHashes->hashSha512, hash);
+            ret = SetHandshakeHashes(ssl, HS_HASH_SHA512);
+            if (ret == 0)
+                ret = wc_Sha512GetHash(&ssl->hsHashes->hashSha512, hash);
             if (ret == 0)
                 ret = WC_SHA512_DIGEST_SIZE;
             break;
@@ -7001,14 +7002,14 @@ static int ExpectedResumptionSecret(WOLFSSL* ssl)
 #ifdef WOLFSSL_EARLY_DATA
     if (ssl->earlyData != no_early_data) {
         static byte endOfEarlyData[] = { 0x05, 0x00, 0x00, 0x00 };
-        ret = HashInputRaw(ssl, endOfEarlyData, sizeof(endOfEarlyData));
+        ret = HashRaw(ssl, endOfEarlyData, sizeof(endOfEarlyData));
         if (ret != 0)
             return ret;
     }
 #endif
-    if ((ret = HashInputRaw(ssl, header, sizeof(header))) != 0)
+    if ((ret = HashRaw(ssl, header, sizeof(header))) != 0)
         return ret;
-    if ((ret = HashInputRaw(ssl, mac, finishedSz)) != 0)
+    if ((ret = HashRaw(ssl, mac, finishedSz)) != 0)
         return ret;
 
     if ((ret = DeriveResumptionSecret(ssl, ssl->session.masterSecret)) != 0)
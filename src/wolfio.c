@@ -251,6 +251,34 @@ int EmbedReceive(WOLFSSL *ssl, char *buf, int sz, void *ctx)
     return recvd;
 }
 
+/* Translates the last error of a failed send to a WOLFSSL_CBIO_ERR_* code */
+static int TranslateSendError(void)
+{
+    int err = wolfSSL_LastError();
+    WOLFSSL_MSG("Embed Send error");
+
+    if (err == SOCKET_EWOULDBLOCK || err == SOCKET_EAGAIN) {
+        WOLFSSL_MSG("\tWould Block");
+        return WOLFSSL_CBIO_ERR_WANT_WRITE;
+    }
+    else if (err == SOCKET_ECONNRESET) {
+        WOLFSSL_MSG("\tConnection reset");
+        return WOLFSSL_CBIO_ERR_CONN_RST;
+    }
+    else if (err == SOCKET_EINTR) {
+        WOLFSSL_MSG("\tSocket interrupted");
+        return WOLFSSL_CBIO_ERR_ISR;
+    }
+    else if (err == SOCKET_EPIPE) {
+        WOLFSSL_MSG("\tSocket EPIPE");
+        return WOLFSSL_CBIO_ERR_CONN_CLOSE;
+    }
+    else {
+        WOLFSSL_MSG("\tGeneral error");
+        return WOLFSSL_CBIO_ERR_GENERAL;
+    }
+}
+
 /* The send embedded callback
  *  return : nb bytes sent, or error
  */
@@ -265,35 +293,52 @@ int EmbedSend(WOLFSSL* ssl, char *buf, int sz, void *ctx)
 #endif
 
     sent = wolfIO_Send(sd, buf, sz, ssl->wflags);
-    if (sent < 0) {
-        int err = wolfSSL_LastError();
-        WOLFSSL_MSG("Embed Send error");
+    if (sent < 0)
+        return TranslateSendError();
 
-        if (err == SOCKET_EWOULDBLOCK || err == SOCKET_EAGAIN) {
-            WOLFSSL_MSG("\tWould Block");
-            return WOLFSSL_CBIO_ERR_WANT_WRITE;
-        }
-        else if (err == SOCKET_ECONNRESET) {
-            WOLFSSL_MSG("\tConnection reset");
-            return WOLFSSL_CBIO_ERR_CONN_RST;
-        }
-        else if (err == SOCKET_EINTR) {
-            WOLFSSL_MSG("\tSocket interrupted");
-            return WOLFSSL_CBIO_ERR_ISR;
-        }
-        else if (err == SOCKET_EPIPE) {
-            WOLFSSL_MSG("\tSocket EPIPE");
-            return WOLFSSL_CBIO_ERR_CONN_CLOSE;
-        }
-        else {
-            WOLFSSL_MSG("\tGeneral error");
-            return WOLFSSL_CBIO_ERR_GENERAL;
-        }
+    return sent;
+}
+
+#ifdef HAVE_SENDMSG
+
+#ifndef WOLFSSL_MAX_SENDV_IOV
+    #define WOLFSSL_MAX_SENDV_IOV 16
+#endif
+
+/* The vectored send embedded callback, gathers the buffers into one sendmsg()
+ * call. At most WOLFSSL_MAX_SENDV_IOV buffers are sent at a time.
+ *  return : nb bytes sent, or error
+ */
+int EmbedSendv(WOLFSSL* ssl, WOLFSSL_IOVEC* iov, int iovcnt, void *ctx)
+{
+    int sd = *(int*)ctx;
+    int sent;
+    int i;
+    struct iovec  vec[WOLFSSL_MAX_SENDV_IOV];
+    struct msghdr msg;
+
+    if (iovcnt > WOLFSSL_MAX_SENDV_IOV)
+        iovcnt = WOLFSSL_MAX_SENDV_IOV;
+
+    for (i = 0; i < iovcnt; i++) {
+        vec[i].iov_base = iov[i].buf;
+        vec[i].iov_len  = (size_t)iov[i].sz;
     }
 
+    XMEMSET(&msg, 0, sizeof(msg));
+    msg.msg_iov    = vec;
+    msg.msg_iovlen = iovcnt;
+
+    sent = (int)sendmsg(sd, &msg, ssl->wflags);
+    sent = TranslateReturnCode(sent, sd);
+    if (sent < 0)
+        return TranslateSendError();
+
     return sent;
 }
 
+#endif /* HAVE_SENDMSG */
+
 
 #ifdef WOLFSSL_DTLS
 
@@ -372,6 +417,20 @@ int EmbedReceiveFrom(WOLFSSL *ssl, char *buf, int sz, void *ctx)
         }
     }
     else {
+    #ifdef WOLFSSL_DTLS_CID
+        /* With connection IDs the peer may show up at a new address after a
+         * NAT rebinding. Remember where the datagram came from; the record
+         * layer only switches over once a record from there authenticates. */
+        if (ssl->dtlsCidInfo.negotiated && dtlsCtx->peer.sz > 0 &&
+                (peerSz != (XSOCKLENT)dtlsCtx->peer.sz ||
+                 XMEMCMP(&peer, dtlsCtx->peer.sa, peerSz) != 0)) {
+            if (wolfSSL_dtls_cid_set_pending_peer(ssl, &peer,
+                                                  peerSz) != WOLFSSL_SUCCESS)
+                return WOLFSSL_CBIO_ERR_GENERAL;
+            return recvd;
+        }
+        wolfSSL_dtls_cid_set_pending_peer(ssl, NULL, 0);
+    #endif
         if (dtlsCtx->peer.sz > 0
                 && peerSz != (XSOCKLENT)dtlsCtx->peer.sz
                 && XMEMCMP(&peer, dtlsCtx->peer.sa, peerSz) != 0) {
@@ -1545,6 +1604,14 @@ void wolfSSL_CTX_SetIOSend(WOLFSSL_CTX *ctx, CallbackIOSend CBIOSend)
 }
 
 
+/* sets the vectored send callback used to flush coalesced records */
+void wolfSSL_CTX_SetIOSendv(WOLFSSL_CTX *ctx, CallbackIOSendv CBIOSendv)
+{
+    if (ctx)
+        ctx->CBIOSendv = CBIOSendv;
+}
+
+
 /* sets the IO callback to use for receives at WOLFSSL level */
 void wolfSSL_SSLSetIORecv(WOLFSSL *ssl, CallbackIORecv CBIORecv)
 {
@@ -1569,6 +1636,14 @@ void wolfSSL_SSLSetIOSend(WOLFSSL *ssl, CallbackIOSend CBIOSend)
 }
 
 
+/* sets the vectored send callback to use at WOLFSSL level */
+void wolfSSL_SSLSetIOSendv(WOLFSSL *ssl, CallbackIOSendv CBIOSendv)
+{
+    if (ssl)
+        ssl->CBIOSendv = CBIOSendv;
+}
+
+
 void wolfSSL_SetIOReadCtx(WOLFSSL* ssl, void *rctx)
 {
     if (ssl)
@@ -303,6 +303,7 @@ int main(int argc, char** argv)
     char         err[PCAP_ERRBUF_SIZE];
 	char         filter[32];
 	const char  *server = NULL;
+    const char  *keyLogFile = NULL;
 	struct       bpf_program fp;
 	pcap_if_t   *d;
 	pcap_addr_t *a;
@@ -313,11 +314,30 @@ int main(int argc, char** argv)
 
     signal(SIGINT, sig_handler);
 
+    /* leading options, these have to be set before the sniffer starts */
+    while (argc > 2 && argv[1][0] == '-') {
+        if (strcmp(argv[1], "-t") == 0) {
+            /* Session Hash Table rows */
+            if (ssl_SetSessionTableSize((unsigned int)atoi(argv[2]), err) != 0)
+                err_sys(err);
+        }
+        else if (strcmp(argv[1], "-k") == 0) {
+            /* NSS Key Log File with the session secrets */
+            keyLogFile = argv[2];
+        }
+        else
+            break;
+        argc -= 2;
+        argv += 2;
+    }
+
 #ifndef _WIN32
     ssl_InitSniffer();   /* dll load on Windows */
 #endif
     ssl_Trace("./tracefile.txt", err);
     ssl_EnableRecovery(1, -1, err);
+    if (keyLogFile != NULL && ssl_LoadKeyLogFile(keyLogFile, err) != 0)
+        err_sys(err);
 #ifdef WOLFSSL_SNIFFER_WATCH
     ssl_SetWatchKeyCallback(myWatchCb, err);
 #endif
@@ -476,8 +496,9 @@ int main(int argc, char** argv)
     }
     else {
         /* usage error */
-        printf( "usage: ./snifftest or ./snifftest dump pemKey"
-                " [server] [port] [password]\n");
+        printf( "usage: ./snifftest [-t rows] [-k keylog] or ./snifftest"
+                " [-t rows] [-k keylog] dump pemKey [server] [port]"
+                " [password]\n");
         exit(EXIT_FAILURE);
     }
 
@@ -1201,6 +1201,9 @@ static void test_wolfSSL_CertManagerCRL(void)
     const char* ca_cert = "./certs/ca-cert.pem";
     const char* crl1     = "./certs/crl/crl.pem";
     const char* crl2     = "./certs/crl/crl2.pem";
+    const char* crlMany  = "./certs/crl/crl-many.pem";
+    byte*  crlBuf = NULL;
+    size_t crlSz = 0;
 
     WOLFSSL_CERT_MANAGER* cm = NULL;
 
@@ -1219,6 +1222,269 @@ static void test_wolfSSL_CertManagerCRL(void)
         wolfSSL_CertManagerLoadCA(cm, ca_cert, NULL));
     wolfSSL_CertManagerFree(cm);
 
+    /* revoked serial lookup in a CRL with a few hundred entries */
+    AssertNotNull(cm = wolfSSL_CertManagerNew());
+    AssertIntEQ(WOLFSSL_SUCCESS,
+        wolfSSL_CertManagerLoadCA(cm, ca_cert, NULL));
+    AssertIntEQ(0, load_file(crlMany, &crlBuf, &crlSz));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerLoadCRLBuffer(cm, crlBuf,
+        (long)crlSz, WOLFSSL_FILETYPE_PEM));
+    AssertIntEQ(CRL_CERT_REVOKED, wolfSSL_CertManagerVerify(cm,
+        "./certs/server-revoked-cert.pem", WOLFSSL_FILETYPE_PEM));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerVerify(cm,
+        "./certs/server-cert.pem", WOLFSSL_FILETYPE_PEM));
+    wolfSSL_CertManagerFree(cm);
+    free(crlBuf);
+
+#endif
+}
+
+#if defined(HAVE_OCSP) && !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && \
+    !defined(NO_RSA) && !defined(NO_SHA) && defined(WOLFSSL_PEM_TO_DER)
+typedef struct test_ocsp_responder {
+    byte*  resp;
+    size_t respSz;
+    int    calls;
+} test_ocsp_responder;
+
+/* stands in for the responder, answers every request with the same response */
+static int test_ocsp_responder_cb(void* ctx, const char* url, int urlSz,
+    unsigned char* req, int reqSz, unsigned char** resp)
+{
+    test_ocsp_responder* responder = (test_ocsp_responder*)ctx;
+
+    (void)url;
+    (void)urlSz;
+    (void)req;
+    (void)reqSz;
+
+    responder->calls++;
+    *resp = responder->resp;
+    return (int)responder->respSz;
+}
+
+static int test_ocsp_load_der(const char* file, byte* der, int derSz)
+{
+    byte*  pem = NULL;
+    size_t pemSz = 0;
+
+    AssertIntEQ(0, load_file(file, &pem, &pemSz));
+    derSz = wc_CertPemToDer(pem, (int)pemSz, der, derSz, CERT_TYPE);
+    AssertIntGT(derSz, 0);
+    free(pem);
+
+    return derSz;
+}
+#endif
+
+static void test_wolfSSL_CertManagerOCSPCache(void)
+{
+#if defined(HAVE_OCSP) && !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && \
+    !defined(NO_RSA) && !defined(NO_SHA) && defined(WOLFSSL_PEM_TO_DER)
+    WOLFSSL_CERT_MANAGER* cm = NULL;
+    test_ocsp_responder   responder;
+    byte*  goodResp = NULL;
+    size_t goodRespSz = 0;
+    byte*  revokedResp = NULL;
+    size_t revokedRespSz = 0;
+    byte   good[FOURK_BUF];
+    int    goodSz;
+    byte   revoked[FOURK_BUF];
+    int    revokedSz;
+
+    printf(testingFmt, "wolfSSL_CertManagerOCSPCache()");
+
+    goodSz = test_ocsp_load_der("./certs/ocsp/server1-cert.pem", good,
+        (int)sizeof(good));
+    revokedSz = test_ocsp_load_der("./certs/ocsp/server2-cert.pem", revoked,
+        (int)sizeof(revoked));
+    AssertIntEQ(0, load_file("./certs/ocsp/server1-resp.der", &goodResp,
+        &goodRespSz));
+    AssertIntEQ(0, load_file("./certs/ocsp/server2-resp.der", &revokedResp,
+        &revokedRespSz));
+
+    XMEMSET(&responder, 0, sizeof(responder));
+    AssertNotNull(cm = wolfSSL_CertManagerNew());
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerLoadCA(cm,
+        "./certs/ocsp/root-ca-cert.pem", NULL));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerLoadCA(cm,
+        "./certs/ocsp/intermediate1-ca-cert.pem", NULL));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerEnableOCSP(cm, 0));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerSetOCSP_Cb(cm,
+        test_ocsp_responder_cb, NULL, &responder));
+
+    /* second check is answered from the cache */
+    responder.resp = goodResp;
+    responder.respSz = goodRespSz;
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerCheckOCSP(cm, good,
+        goodSz));
+    AssertIntEQ(1, responder.calls);
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerCheckOCSP(cm, good,
+        goodSz));
+    AssertIntEQ(1, responder.calls);
+
+    /* only responses older than maxAge are fetched again */
+    AssertIntEQ(0, wolfSSL_CertManagerRefreshOCSP(cm, 3600));
+    AssertIntEQ(1, responder.calls);
+    AssertIntEQ(1, wolfSSL_CertManagerRefreshOCSP(cm, 0));
+    AssertIntEQ(2, responder.calls);
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerCheckOCSP(cm, good,
+        goodSz));
+    AssertIntEQ(2, responder.calls);
+
+    /* a full cache drops the least recently used response */
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CertManagerSetOCSPCacheSize(cm, -1));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerSetOCSPCacheSize(cm, 1));
+    responder.resp = revokedResp;
+    responder.respSz = revokedRespSz;
+    AssertIntEQ(OCSP_CERT_REVOKED, wolfSSL_CertManagerCheckOCSP(cm, revoked,
+        revokedSz));
+    AssertIntEQ(3, responder.calls);
+    AssertIntEQ(OCSP_CERT_REVOKED, wolfSSL_CertManagerCheckOCSP(cm, revoked,
+        revokedSz));
+    AssertIntEQ(3, responder.calls);
+    responder.resp = goodResp;
+    responder.respSz = goodRespSz;
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerCheckOCSP(cm, good,
+        goodSz));
+    AssertIntEQ(4, responder.calls);
+
+    AssertIntEQ(BAD_FUNC_ARG, wolfSSL_CertManagerRefreshOCSP(NULL, 0));
+
+    wolfSSL_CertManagerFree(cm);
+    free(goodResp);
+    free(revokedResp);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+static void test_wolfSSL_CertManagerCATable(void)
+{
+#if !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_DIR) && \
+    !defined(WOLFSSL_TIRTOS)
+    WOLFSSL_CTX* ctx;
+    WOLFSSL_CERT_MANAGER* cm;
+
+    printf(testingFmt, "wolfSSL_CertManagerCATable()");
+
+    /* enough CAs to grow the signer table past its initial rows */
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_client_method()));
+    AssertNotNull(cm = wolfSSL_CTX_GetCertManager(ctx));
+    wolfSSL_CTX_load_verify_locations_ex(ctx, NULL, "./certs",
+        WOLFSSL_LOAD_FLAG_IGNORE_ERR);
+    wolfSSL_CTX_load_verify_locations_ex(ctx, NULL, "./certs/ocsp",
+        WOLFSSL_LOAD_FLAG_IGNORE_ERR);
+    wolfSSL_CTX_load_verify_locations_ex(ctx, NULL, "./certs/external",
+        WOLFSSL_LOAD_FLAG_IGNORE_ERR);
+    wolfSSL_CTX_load_verify_locations_ex(ctx, NULL, "./certs/intermediate",
+        WOLFSSL_LOAD_FLAG_IGNORE_ERR);
+
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerVerify(cm,
+        "./certs/server-cert.pem", WOLFSSL_FILETYPE_PEM));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerVerify(cm,
+        "./certs/ocsp/server1-cert.pem", WOLFSSL_FILETYPE_PEM));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerVerify(cm,
+        "./certs/intermediate/server-int-cert.pem", WOLFSSL_FILETYPE_PEM));
+
+    /* unloading empties both indexes */
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerUnloadCAs(cm));
+    AssertIntEQ(ASN_NO_SIGNER_E, wolfSSL_CertManagerVerify(cm,
+        "./certs/server-cert.pem", WOLFSSL_FILETYPE_PEM));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerLoadCA(cm,
+        "./certs/ca-cert.pem", NULL));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CertManagerVerify(cm,
+        "./certs/server-cert.pem", WOLFSSL_FILETYPE_PEM));
+
+    wolfSSL_CTX_free(ctx);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+static void test_wolfSSL_CertManagerVerifyCache(void)
+{
+#if defined(WOLFSSL_CERT_VERIFY_CACHE) && !defined(NO_CERTS) && \
+    !defined(NO_RSA) && !defined(NO_SHA256) && defined(USE_CERT_BUFFERS_2048)
+    WOLFSSL_CERT_MANAGER* cm;
+    byte bad[sizeof_server_cert_der_2048];
+    byte otherCa[sizeof_ca_cert_der_2048];
+    int  i;
+
+    printf(testingFmt, "wolfSSL_CertManagerSetVerifyCacheSize()");
+
+    AssertNotNull(cm = wolfSSL_CertManagerNew());
+    AssertIntEQ(wolfSSL_CertManagerSetVerifyCacheSize(NULL, 16), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CertManagerSetVerifyCacheSize(cm, -1), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CTX_SetVerifyCacheSize(NULL, 16), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CertManagerSetVerifyCacheSize(cm, 16),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerLoadCABuffer(cm, ca_cert_der_2048,
+                sizeof_ca_cert_der_2048, WOLFSSL_FILETYPE_ASN1),
+                WOLFSSL_SUCCESS);
+
+    /* second verify is served from the cache */
+    AssertIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, server_cert_der_2048,
+                sizeof_server_cert_der_2048, WOLFSSL_FILETYPE_ASN1),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, server_cert_der_2048,
+                sizeof_server_cert_der_2048, WOLFSSL_FILETYPE_ASN1),
+                WOLFSSL_SUCCESS);
+
+    /* a changed signature is a different certificate */
+    XMEMCPY(bad, server_cert_der_2048, sizeof(bad));
+    bad[sizeof(bad) - 1] ^= 0x01;
+    AssertIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, bad, sizeof(bad),
+                WOLFSSL_FILETYPE_ASN1), ASN_SIG_CONFIRM_E);
+
+    /* unloading the signer forgets what it verified */
+    AssertIntEQ(wolfSSL_CertManagerUnloadCAs(cm), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, server_cert_der_2048,
+                sizeof_server_cert_der_2048, WOLFSSL_FILETYPE_ASN1),
+                ASN_NO_SIGNER_E);
+    AssertIntEQ(wolfSSL_CertManagerLoadCABuffer(cm, ca_cert_der_2048,
+                sizeof_ca_cert_der_2048, WOLFSSL_FILETYPE_ASN1),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, server_cert_der_2048,
+                sizeof_server_cert_der_2048, WOLFSSL_FILETYPE_ASN1),
+                WOLFSSL_SUCCESS);
+
+    /* a CA with the same name and key id but another key checks again */
+    XMEMCPY(otherCa, ca_cert_der_2048, sizeof(otherCa));
+    for (i = 0; i + 5 < (int)sizeof(otherCa); i++) {
+        /* INTEGER of 257 bytes: the 2048-bit modulus */
+        if (otherCa[i] == 0x02 && otherCa[i + 1] == 0x82 &&
+                otherCa[i + 2] == 0x01 && otherCa[i + 3] == 0x01 &&
+                otherCa[i + 4] == 0x00) {
+            otherCa[i + 16] ^= 0x01;
+            break;
+        }
+    }
+    AssertIntLT(i + 5, (int)sizeof(otherCa));
+    AssertIntEQ(wolfSSL_CertManagerUnloadCAs(cm), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerLoadCABuffer(cm, otherCa, sizeof(otherCa),
+                WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, server_cert_der_2048,
+                sizeof_server_cert_der_2048, WOLFSSL_FILETYPE_ASN1),
+                ASN_SIG_CONFIRM_E);
+    AssertIntEQ(wolfSSL_CertManagerUnloadCAs(cm), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerLoadCABuffer(cm, ca_cert_der_2048,
+                sizeof_ca_cert_der_2048, WOLFSSL_FILETYPE_ASN1),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, server_cert_der_2048,
+                sizeof_server_cert_der_2048, WOLFSSL_FILETYPE_ASN1),
+                WOLFSSL_SUCCESS);
+
+    /* off */
+    AssertIntEQ(wolfSSL_CertManagerSetVerifyCacheSize(cm, 0), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, server_cert_der_2048,
+                sizeof_server_cert_der_2048, WOLFSSL_FILETYPE_ASN1),
+                WOLFSSL_SUCCESS);
+
+    wolfSSL_CertManagerFree(cm);
+
+    printf(resultFmt, passed);
 #endif
 }
 
@@ -2499,6 +2765,9 @@ done:
                             && defined(HAVE_THREAD_LS)
     wc_ecc_fp_free();  /* free per thread cache */
 #endif
+#if defined(NO_MAIN_DRIVER) && defined(WC_RNG_POOL)
+    wc_RngPoolFree();  /* free per thread parent DRBG */
+#endif
 
 #if defined(HAVE_SESSION_TICKET) && defined(HAVE_CHACHA) && \
                                     defined(HAVE_POLY1305)
@@ -2695,6 +2964,9 @@ done:
                             && defined(HAVE_THREAD_LS)
     wc_ecc_fp_free();  /* free per thread cache */
 #endif
+#if defined(NO_MAIN_DRIVER) && defined(WC_RNG_POOL)
+    wc_RngPoolFree();  /* free per thread parent DRBG */
+#endif
 
 #ifndef WOLFSSL_TIRTOS
     return 0;
@@ -2881,6 +3153,9 @@ done:
                             && defined(HAVE_THREAD_LS)
     wc_ecc_fp_free();  /* free per thread cache */
 #endif
+#if defined(NO_MAIN_DRIVER) && defined(WC_RNG_POOL)
+    wc_RngPoolFree();  /* free per thread parent DRBG */
+#endif
 
     return;
 }
@@ -3259,6 +3534,9 @@ static THREAD_RETURN WOLFSSL_THREAD run_wolfssl_server(void* args)
                             && defined(HAVE_THREAD_LS)
     wc_ecc_fp_free();  /* free per thread cache */
 #endif
+#if defined(NO_MAIN_DRIVER) && defined(WC_RNG_POOL)
+    wc_RngPoolFree();  /* free per thread parent DRBG */
+#endif
 
 #ifndef WOLFSSL_TIRTOS
     return 0;
@@ -13160,6 +13438,181 @@ static int test_wc_RsaEncryptSize (void)
 
 } /* END test_wc_RsaEncryptSize*/
 
+/*
+ * Testing wc_RsaSSL_Sign() with a key that is reused and decoded again, the
+ * Montgomery parameters and blinding cached on the key must follow it.
+ */
+static int test_wc_RsaKeyReuse (void)
+{
+#if !defined(NO_RSA) && defined(USE_CERT_BUFFERS_2048) && \
+    !defined(HAVE_USER_RSA) && !defined(WC_NO_RNG) && \
+    !defined(WOLFSSL_RSA_PUBLIC_ONLY)
+    RsaKey  key;
+    RsaKey  other;
+    WC_RNG  rng;
+    const byte in[] = "Everyone gets Friday off.";
+    byte    sig[256];
+    byte    first[256];
+    byte    otherSig[256];
+    byte    plain[256];
+    word32  idx;
+    int     i;
+
+    printf(testingFmt, "wc_RsaKeyReuse()");
+
+    AssertIntEQ(wc_InitRng(&rng), 0);
+    AssertIntEQ(wc_InitRsaKey(&key, HEAP_HINT), 0);
+    AssertIntEQ(wc_InitRsaKey(&other, HEAP_HINT), 0);
+    idx = 0;
+    AssertIntEQ(wc_RsaPrivateKeyDecode(client_key_der_2048, &idx, &key,
+                sizeof_client_key_der_2048), 0);
+    idx = 0;
+    AssertIntEQ(wc_RsaPrivateKeyDecode(server_key_der_2048, &idx, &other,
+                sizeof_server_key_der_2048), 0);
+    AssertIntEQ(wc_RsaSSL_Sign(in, sizeof(in), otherSig, sizeof(otherSig),
+                &other, &rng), sizeof(otherSig));
+
+    /* PKCS #1 v1.5 signatures are deterministic */
+    for (i = 0; i < 4; i++) {
+        AssertIntEQ(wc_RsaSSL_Sign(in, sizeof(in), sig, sizeof(sig), &key,
+                    &rng), sizeof(sig));
+        if (i == 0)
+            XMEMCPY(first, sig, sizeof(sig));
+        AssertIntEQ(XMEMCMP(sig, first, sizeof(sig)), 0);
+        AssertIntEQ(wc_RsaSSL_Verify(sig, sizeof(sig), plain, sizeof(plain),
+                    &key), sizeof(in));
+        AssertIntEQ(XMEMCMP(plain, in, sizeof(in)), 0);
+    }
+
+    /* another key decoded into the used one */
+#ifndef USE_FAST_MATH
+    wc_FreeRsaKey(&key);
+    AssertIntEQ(wc_InitRsaKey(&key, HEAP_HINT), 0);
+#endif
+    idx = 0;
+    AssertIntEQ(wc_RsaPrivateKeyDecode(server_key_der_2048, &idx, &key,
+                sizeof_server_key_der_2048), 0);
+    AssertIntEQ(wc_RsaSSL_Sign(in, sizeof(in), sig, sizeof(sig), &key, &rng),
+                sizeof(sig));
+    AssertIntEQ(XMEMCMP(sig, otherSig, sizeof(sig)), 0);
+    AssertIntLT(wc_RsaSSL_Verify(first, sizeof(first), plain, sizeof(plain),
+                &key), 0);
+
+    /* and back */
+#ifndef USE_FAST_MATH
+    wc_FreeRsaKey(&key);
+    AssertIntEQ(wc_InitRsaKey(&key, HEAP_HINT), 0);
+#endif
+    idx = 0;
+    AssertIntEQ(wc_RsaPrivateKeyDecode(client_key_der_2048, &idx, &key,
+                sizeof_client_key_der_2048), 0);
+    AssertIntEQ(wc_RsaSSL_Sign(in, sizeof(in), sig, sizeof(sig), &key, &rng),
+                sizeof(sig));
+    AssertIntEQ(XMEMCMP(sig, first, sizeof(sig)), 0);
+
+    wc_FreeRsaKey(&other);
+    wc_FreeRsaKey(&key);
+    wc_FreeRng(&rng);
+
+    printf(resultFmt, passed);
+#endif
+
+    return 0;
+} /* END test_wc_RsaKeyReuse */
+
+/*
+ * Testing wc_DhAgree() with a key that is reused and given new parameters,
+ * the Montgomery parameters cached on the key must follow its prime.
+ */
+static int test_wc_DhKeyReuse (void)
+{
+#if !defined(NO_DH) && defined(USE_CERT_BUFFERS_2048) && \
+    defined(HAVE_FFDHE_2048) && !defined(WC_NO_RNG) && !defined(HAVE_FIPS) && \
+    !defined(HAVE_SELFTEST)
+    DhKey   key;
+    DhKey   peer;
+    WC_RNG  rng;
+    const DhParams* params;
+    byte    priv[256];
+    byte    pub[256];
+    byte    peerPriv[256];
+    byte    peerPub[256];
+    byte    agree[256];
+    byte    first[256];
+    byte    peerAgree[256];
+    word32  privSz, pubSz, peerPrivSz, peerPubSz, agreeSz, firstSz;
+    word32  peerAgreeSz;
+    word32  idx;
+    int     i, round;
+
+    printf(testingFmt, "wc_DhKeyReuse()");
+
+    AssertIntEQ(wc_InitRng(&rng), 0);
+    AssertIntEQ(wc_InitDhKey(&key), 0);
+    AssertIntEQ(wc_InitDhKey(&peer), 0);
+    params = wc_Dh_ffdhe2048_Get();
+
+    for (round = 0; round < 2; round++) {
+        /* decoded parameters first, then a different prime on the same key */
+        if (round == 0) {
+            idx = 0;
+            AssertIntEQ(wc_DhKeyDecode(dh_key_der_2048, &idx, &key,
+                        sizeof_dh_key_der_2048), 0);
+            idx = 0;
+            AssertIntEQ(wc_DhKeyDecode(dh_key_der_2048, &idx, &peer,
+                        sizeof_dh_key_der_2048), 0);
+        }
+        else {
+        #ifndef USE_FAST_MATH
+            wc_FreeDhKey(&key);
+            wc_FreeDhKey(&peer);
+            AssertIntEQ(wc_InitDhKey(&key), 0);
+            AssertIntEQ(wc_InitDhKey(&peer), 0);
+        #endif
+            AssertIntEQ(wc_DhSetKey(&key, params->p, params->p_len,
+                        params->g, params->g_len), 0);
+            AssertIntEQ(wc_DhSetKey(&peer, params->p, params->p_len,
+                        params->g, params->g_len), 0);
+        }
+
+        privSz = sizeof(priv);
+        pubSz = sizeof(pub);
+        AssertIntEQ(wc_DhGenerateKeyPair(&key, &rng, priv, &privSz, pub,
+                    &pubSz), 0);
+        peerPrivSz = sizeof(peerPriv);
+        peerPubSz = sizeof(peerPub);
+        AssertIntEQ(wc_DhGenerateKeyPair(&peer, &rng, peerPriv, &peerPrivSz,
+                    peerPub, &peerPubSz), 0);
+        peerAgreeSz = sizeof(peerAgree);
+        AssertIntEQ(wc_DhAgree(&peer, peerAgree, &peerAgreeSz, peerPriv,
+                    peerPrivSz, pub, pubSz), 0);
+
+        firstSz = 0;
+        for (i = 0; i < 3; i++) {
+            agreeSz = sizeof(agree);
+            AssertIntEQ(wc_DhAgree(&key, agree, &agreeSz, priv, privSz,
+                        peerPub, peerPubSz), 0);
+            if (i == 0) {
+                XMEMCPY(first, agree, agreeSz);
+                firstSz = agreeSz;
+            }
+            AssertIntEQ(agreeSz, firstSz);
+            AssertIntEQ(XMEMCMP(agree, first, agreeSz), 0);
+        }
+        AssertIntEQ(agreeSz, peerAgreeSz);
+        AssertIntEQ(XMEMCMP(agree, peerAgree, agreeSz), 0);
+    }
+
+    wc_FreeDhKey(&peer);
+    wc_FreeDhKey(&key);
+    wc_FreeRng(&rng);
+
+    printf(resultFmt, passed);
+#endif
+
+    return 0;
+} /* END test_wc_DhKeyReuse */
+
 /*
  * Testing wc_RsaFlattenPublicKey()
  */
@@ -17696,6 +18149,156 @@ static int test_wc_ecc_verify_hash_ex (void)
 
 } /* END test_wc_ecc_verify_hash_ex */
 
+#if defined(HAVE_ECC) && defined(WOLFSSL_ECC_KEY_TABLE) && \
+    defined(HAVE_ECC_VERIFY) && !defined(NO_CERTS) && !defined(NO_ASN)
+/* Verify a certificate against an ECC CA. Loading the CA makes the table of
+ * its key that the signature checks then use. */
+static void test_wc_ecc_key_table_chain(const byte* ca, int caSz,
+                                        const byte* cert, int certSz)
+{
+    WOLFSSL_CERT_MANAGER* cm;
+    byte*                 bad;
+
+    AssertNotNull(cm = wolfSSL_CertManagerNew());
+    AssertIntEQ(wolfSSL_CertManagerLoadCABuffer(cm, ca, caSz,
+                WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, cert, certSz,
+                WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, cert, certSz,
+                WOLFSSL_FILETYPE_ASN1), WOLFSSL_SUCCESS);
+
+    /* last byte of the signature changed */
+    AssertNotNull(bad = (byte*)XMALLOC(certSz, NULL, DYNAMIC_TYPE_TMP_BUFFER));
+    XMEMCPY(bad, cert, certSz);
+    bad[certSz - 1] ^= 0x01;
+    AssertIntEQ(wolfSSL_CertManagerVerifyBuffer(cm, bad, certSz,
+                WOLFSSL_FILETYPE_ASN1), ASN_SIG_CONFIRM_E);
+    XFREE(bad, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+
+    wolfSSL_CertManagerFree(cm);
+}
+#endif
+
+/*
+ * Testing wc_ecc_key_table_new(), wc_ecc_set_key_table() and
+ * wc_ecc_key_table_free()
+ */
+static int test_wc_ecc_key_table (void)
+{
+#if defined(HAVE_ECC) && defined(WOLFSSL_ECC_KEY_TABLE) && \
+    defined(HAVE_ECC_SIGN) && defined(HAVE_ECC_VERIFY) && !defined(WC_NO_RNG)
+    ecc_key         key;
+    ecc_key         other;
+    ecc_key_table*  table = NULL;
+    WC_RNG          rng;
+    byte            hash[] = "Everyone gets Friday off.EccTbl";
+    byte            iHash[] = "Everyone gets Friday off.......";
+    byte            sig[ECC_MAX_SIG_SIZE];
+    word32          sigSz = (word32)sizeof(sig);
+    int             verify = 0;
+    int             ret;
+
+    printf(testingFmt, "wc_ecc_key_table_new()");
+
+    AssertIntEQ(wc_InitRng(&rng), 0);
+    AssertIntEQ(wc_ecc_init(&key), 0);
+    AssertIntEQ(wc_ecc_init(&other), 0);
+    AssertIntEQ(wc_ecc_make_key(&rng, KEY32, &key), 0);
+    AssertIntEQ(wc_ecc_make_key(&rng, KEY32, &other), 0);
+    AssertIntEQ(wc_ecc_sign_hash(hash, sizeof(hash), sig, &sigSz, &rng, &key),
+                0);
+
+    AssertIntEQ(wc_ecc_key_table_new(NULL, &table, NULL), BAD_FUNC_ARG);
+    AssertIntEQ(wc_ecc_key_table_new(&key, NULL, NULL), BAD_FUNC_ARG);
+    AssertIntEQ(wc_ecc_set_key_table(NULL, table), BAD_FUNC_ARG);
+
+    ret = wc_ecc_key_table_new(&key, &table, NULL);
+    if (ret != NOT_COMPILED_IN) {
+        AssertIntEQ(ret, 0);
+        AssertNotNull(table);
+
+        /* Table only accepted for the key it was made from. */
+        AssertIntEQ(wc_ecc_set_key_table(&other, table), ECC_BAD_ARG_E);
+        AssertIntEQ(wc_ecc_set_key_table(&key, table), 0);
+
+        AssertIntEQ(wc_ecc_verify_hash(sig, sigSz, hash, sizeof(hash), &verify,
+                                       &key), 0);
+        AssertIntEQ(verify, 1);
+        AssertIntEQ(wc_ecc_verify_hash(sig, sigSz, iHash, sizeof(iHash),
+                                       &verify, &key), 0);
+        AssertIntEQ(verify, 0);
+
+        /* New public key on the key - table is ignored. */
+        AssertIntEQ(wc_ecc_make_key(&rng, KEY32, &key), 0);
+        AssertIntEQ(wc_ecc_verify_hash(sig, sigSz, hash, sizeof(hash), &verify,
+                                       &key), 0);
+        AssertIntEQ(verify, 0);
+        sigSz = (word32)sizeof(sig);
+        AssertIntEQ(wc_ecc_sign_hash(hash, sizeof(hash), sig, &sigSz, &rng,
+                                     &key), 0);
+        AssertIntEQ(wc_ecc_verify_hash(sig, sigSz, hash, sizeof(hash), &verify,
+                                       &key), 0);
+        AssertIntEQ(verify, 1);
+
+        AssertIntEQ(wc_ecc_set_key_table(&key, NULL), 0);
+        wc_ecc_key_table_free(table);
+        table = NULL;
+    }
+    wc_ecc_key_table_free(NULL);
+
+#if defined(HAVE_ECC384) || defined(HAVE_ALL_CURVES)
+    /* P-384 key with its own table */
+    wc_ecc_free(&key);
+    AssertIntEQ(wc_ecc_init(&key), 0);
+    AssertIntEQ(wc_ecc_make_key(&rng, 48, &key), 0);
+    sigSz = (word32)sizeof(sig);
+    AssertIntEQ(wc_ecc_sign_hash(hash, sizeof(hash), sig, &sigSz, &rng, &key),
+                0);
+    ret = wc_ecc_key_table_new(&key, &table, NULL);
+    if (ret != NOT_COMPILED_IN) {
+        AssertIntEQ(ret, 0);
+        AssertIntEQ(wc_ecc_set_key_table(&other, table), ECC_BAD_ARG_E);
+        AssertIntEQ(wc_ecc_set_key_table(&key, table), 0);
+        AssertIntEQ(wc_ecc_verify_hash(sig, sigSz, hash, sizeof(hash), &verify,
+                                       &key), 0);
+        AssertIntEQ(verify, 1);
+        AssertIntEQ(wc_ecc_verify_hash(sig, sigSz, iHash, sizeof(iHash),
+                                       &verify, &key), 0);
+        AssertIntEQ(verify, 0);
+        AssertIntEQ(wc_ecc_set_key_table(&key, NULL), 0);
+        wc_ecc_key_table_free(table);
+    }
+#endif
+
+#if !defined(NO_CERTS) && !defined(NO_ASN)
+    /* certificates signed by an ECC CA loaded into a certificate manager */
+    test_wc_ecc_key_table_chain(ca_ecc_cert_der_256, sizeof_ca_ecc_cert_der_256,
+                                serv_ecc_der_256, sizeof_serv_ecc_der_256);
+#if (defined(HAVE_ECC384) || defined(HAVE_ALL_CURVES)) && \
+    defined(WOLFSSL_SHA384) && !defined(NO_FILESYSTEM)
+    {
+        byte*  cert = NULL;
+        size_t certSz = 0;
+
+        AssertIntEQ(load_file("./certs/client-ecc384-cert.der", &cert,
+                              &certSz), 0);
+        test_wc_ecc_key_table_chain(ca_ecc_cert_der_384,
+                                    sizeof_ca_ecc_cert_der_384, cert,
+                                    (int)certSz);
+        free(cert);
+    }
+#endif
+#endif
+
+    wc_ecc_free(&other);
+    wc_ecc_free(&key);
+    AssertIntEQ(wc_FreeRng(&rng), 0);
+
+    printf(resultFmt, passed);
+#endif
+    return 0;
+} /* END test_wc_ecc_key_table */
+
 /*
  * Testing wc_ecc_mulmod()
  */
@@ -24355,6 +24958,59 @@ static void test_wolfSSL_ERR_put_error(void)
 }
 
 
+#if defined(ERROR_QUEUE_PER_THREAD) && !defined(NO_ERROR_QUEUE) && \
+    defined(OPENSSL_EXTRA) && defined(DEBUG_WOLFSSL) && \
+    !defined(SINGLE_THREADED)
+static THREAD_RETURN WOLFSSL_THREAD test_ERR_queue_thread(void* args)
+{
+    func_args* fa = (func_args*)args;
+    const char* file;
+    int line;
+
+    fa->return_code = TEST_FAIL;
+    /* errors from the main thread are not in this thread's queue */
+    if (ERR_peek_last_error() == 0) {
+        ERR_put_error(0, SYS_F_BIND, 21, "thread file", 21);
+        if (ERR_get_error_line(&file, &line) == 21 && line == 21)
+            fa->return_code = TEST_SUCCESS;
+    }
+    ERR_put_error(0, SYS_F_BIND, 22, "thread file", 22);
+    ERR_remove_state(0);
+
+#ifndef WOLFSSL_TIRTOS
+    return 0;
+#endif
+}
+#endif
+
+static void test_wolfSSL_ERR_queue_per_thread(void)
+{
+#if defined(ERROR_QUEUE_PER_THREAD) && !defined(NO_ERROR_QUEUE) && \
+    defined(OPENSSL_EXTRA) && defined(DEBUG_WOLFSSL) && \
+    !defined(SINGLE_THREADED)
+    func_args   args;
+    THREAD_TYPE thread;
+
+    printf(testingFmt, "wolfSSL_ERR_queue_per_thread()");
+
+    XMEMSET(&args, 0, sizeof(args));
+    ERR_clear_error();
+    ERR_put_error(0, SYS_F_ACCEPT, 20, "this file", 20);
+
+    start_thread(test_ERR_queue_thread, &args, &thread);
+    join_thread(thread);
+    AssertIntEQ(args.return_code, TEST_SUCCESS);
+
+    /* the thread's errors did not land in this queue */
+    AssertIntEQ(ERR_peek_last_error(), 20);
+    AssertIntEQ(ERR_get_error(), 20);
+    AssertIntEQ(ERR_get_error(), 0);
+    ERR_clear_error();
+
+    printf(resultFmt, passed);
+#endif
+}
+
 static void test_wolfSSL_ERR_print_errors(void)
 {
     #if !defined(NO_ERROR_QUEUE) && defined(OPENSSL_EXTRA) && \
@@ -25303,6 +25959,65 @@ static void test_wolfSSL_BIO_write(void)
 }
 
 
+static void test_wolfSSL_BIO_s_mem(void)
+{
+    #if defined(OPENSSL_EXTRA)
+    BIO* bio;
+    BUF_MEM* buf = NULL;
+    char* pt = NULL;
+    const unsigned char* p = NULL;
+    char msg[] = "memory BIO test";
+    char out[sizeof(msg)];
+    int  i;
+
+    printf(testingFmt, "wolfSSL_BIO_s_mem()");
+
+    AssertNotNull(bio = BIO_new(BIO_s_mem()));
+    AssertIntEQ(BIO_nread0(bio, &pt), 0);
+    AssertIntEQ(BIO_nread(bio, &pt, 1), WOLFSSL_BIO_ERROR);
+
+    /* interleave small writes and reads, pending data must stay in order */
+    for (i = 0; i < 1000; i++) {
+        AssertIntEQ(BIO_write(bio, msg, sizeof(msg)), sizeof(msg));
+        AssertIntEQ(BIO_write(bio, msg, sizeof(msg)), sizeof(msg));
+        XMEMSET(out, 0, sizeof(out));
+        AssertIntEQ(BIO_read(bio, out, sizeof(out)), sizeof(out));
+        AssertIntEQ(XMEMCMP(out, msg, sizeof(msg)), 0);
+    }
+    AssertIntEQ((int)BIO_ctrl_pending(bio), 1000 * sizeof(msg));
+
+    /* peek does not consume, nread does */
+    AssertIntEQ(BIO_nread0(bio, &pt), 1000 * sizeof(msg));
+    AssertNotNull(pt);
+    AssertIntEQ(XMEMCMP(pt, msg, sizeof(msg)), 0);
+    AssertIntEQ(BIO_nread(bio, &pt, 0), 0);
+    AssertIntEQ(BIO_nread(bio, &pt, 4), 4);
+    AssertIntEQ(XMEMCMP(pt, msg, 4), 0);
+    AssertIntEQ(BIO_get_mem_data(bio, &p), 1000 * sizeof(msg) - 4);
+    AssertIntEQ(XMEMCMP(p, msg + 4, sizeof(msg) - 4), 0);
+
+    /* BUF_MEM view starts at the unread data */
+    AssertIntEQ(SSL_SUCCESS, (int)BIO_get_mem_ptr(bio, &buf));
+    AssertNotNull(buf);
+    AssertIntEQ((int)buf->length, 1000 * sizeof(msg) - 4);
+    AssertIntEQ(XMEMCMP(buf->data, msg + 4, sizeof(msg) - 4), 0);
+
+    for (i = 0; i < 1000; i++) {
+        AssertIntGT(BIO_nread(bio, &pt, sizeof(msg)), 0);
+    }
+    AssertIntEQ((int)BIO_ctrl_pending(bio), 0);
+    AssertIntEQ(BIO_read(bio, out, sizeof(out)), WOLFSSL_BIO_ERROR);
+
+    AssertIntEQ(BIO_write(bio, msg, sizeof(msg)), sizeof(msg));
+    AssertIntEQ(BIO_reset(bio), 0);
+    AssertIntEQ((int)BIO_ctrl_pending(bio), 0);
+    BIO_free(bio);
+
+    printf(resultFmt, passed);
+    #endif
+}
+
+
 static void test_wolfSSL_BIO_printf(void)
 {
     #if defined(OPENSSL_ALL)
@@ -30591,6 +31306,151 @@ static int test_wc_RNG_GenerateBlock(void)
 
     return ret;
 }
+
+#ifdef WC_RNG_POOL
+static int test_wc_InitRngPool(void)
+{
+    int i, ret;
+    WC_RNG rng1;
+    WC_RNG rng2;
+    byte key1[32];
+    byte key2[32];
+
+    ret = wc_InitRngPool(NULL, NULL, INVALID_DEVID);
+    if (ret != BAD_FUNC_ARG)
+        return -1;
+
+    /* children of the same parent produce different output */
+    for (i = 0; i < 10; i++) {
+        ret = wc_InitRngPool(&rng1, HEAP_HINT, INVALID_DEVID);
+        if (ret != 0)
+            return ret;
+        ret = wc_InitRngPool(&rng2, HEAP_HINT, INVALID_DEVID);
+        if (ret == 0)
+            ret = wc_RNG_GenerateBlock(&rng1, key1, sizeof(key1));
+        if (ret == 0)
+            ret = wc_RNG_GenerateBlock(&rng2, key2, sizeof(key2));
+        if (ret == 0 && XMEMCMP(key1, key2, sizeof(key1)) == 0)
+            ret = -1;
+        wc_FreeRng(&rng1);
+        wc_FreeRng(&rng2);
+        if (ret != 0)
+            break;
+    }
+
+    wc_RngPoolFree();
+
+    return ret;
+}
+#endif /* WC_RNG_POOL */
+#endif
+
+#if defined(WOLFSSL_ASYNC_CRYPT) && defined(WOLFSSL_ASYNC_CRYPT_TEST) && \
+    defined(HAVE_ECC) && defined(HAVE_ECC_SIGN) && defined(HAVE_ECC_VERIFY)
+#define TEST_ASYNC_KEYS 4
+/* Signs with several keys bound to the software async device at once and
+ * collects the completions from the worker pool with wolfEventQueue_Poll() */
+static int test_wc_AsyncSwDevice(void)
+{
+    int ret = 0, i, done = 0, count;
+    int devIdAsync = INVALID_DEVID;
+    int verify[TEST_ASYNC_KEYS];
+    WOLF_EVENT_QUEUE queue;
+    WOLF_EVENT* events[TEST_ASYNC_KEYS];
+    WC_RNG rng[TEST_ASYNC_KEYS];
+    ecc_key key[TEST_ASYNC_KEYS];
+    byte hash[WC_SHA256_DIGEST_SIZE];
+    byte sig[TEST_ASYNC_KEYS][ECC_MAX_SIG_SIZE];
+    word32 sigSz[TEST_ASYNC_KEYS];
+
+    AssertIntEQ(wolfAsync_DevOpen(&devIdAsync), 0);
+    AssertIntEQ(wolfEventQueue_Init(&queue), 0);
+    XMEMSET(hash, 0x5a, sizeof(hash));
+
+    for (i = 0; i < TEST_ASYNC_KEYS; i++) {
+        AssertIntEQ(wc_InitRng(&rng[i]), 0);
+        AssertIntEQ(wc_ecc_init_ex(&key[i], HEAP_HINT, devIdAsync), 0);
+        ret = wc_ecc_make_key(&rng[i], 32, &key[i]);
+        AssertIntEQ(ret, WC_PENDING_E);
+        AssertIntEQ(wc_AsyncWait(ret, &key[i].asyncDev, WC_ASYNC_FLAG_NONE),
+                    0);
+
+        sigSz[i] = sizeof(sig[i]);
+        ret = wc_ecc_sign_hash(hash, sizeof(hash), sig[i], &sigSz[i], &rng[i],
+                               &key[i]);
+        AssertIntEQ(ret, WC_PENDING_E);
+        AssertIntEQ(wc_AsyncHandle(&key[i].asyncDev, &queue,
+                                   WC_ASYNC_FLAG_CALL_AGAIN), 0);
+    }
+
+    while (done < TEST_ASYNC_KEYS) {
+        count = 0;
+        AssertIntEQ(wolfEventQueue_Poll(&queue, NULL, events, TEST_ASYNC_KEYS,
+                                        WOLF_POLL_FLAG_CHECK_HW, &count), 0);
+        for (i = 0; i < count; i++) {
+            AssertIntEQ(events[i]->state, WOLF_EVENT_STATE_DONE);
+            AssertIntEQ(events[i]->ret, 0);
+        }
+        done += count;
+    }
+    AssertIntEQ(wolfEventQueue_Count(&queue), 0);
+
+    /* waiting on a job handed to the pool takes it back off the queue or
+     * waits for the worker running it, so it only runs once */
+    for (i = 0; i < TEST_ASYNC_KEYS; i++) {
+        AssertIntEQ(wc_ecc_sign_hash(hash, sizeof(hash), sig[i], &sigSz[i],
+                                     &rng[i], &key[i]), 0);
+        sigSz[i] = sizeof(sig[i]);
+        ret = wc_ecc_sign_hash(hash, sizeof(hash), sig[i], &sigSz[i], &rng[i],
+                               &key[i]);
+        AssertIntEQ(ret, WC_PENDING_E);
+        AssertIntEQ(wc_AsyncHandle(&key[i].asyncDev, &queue,
+                                   WC_ASYNC_FLAG_CALL_AGAIN), 0);
+        AssertIntEQ(wc_AsyncWait(ret, &key[i].asyncDev,
+                                 WC_ASYNC_FLAG_CALL_AGAIN), 0);
+    }
+    /* the events are still reported once */
+    done = 0;
+    while (done < TEST_ASYNC_KEYS) {
+        count = 0;
+        AssertIntEQ(wolfEventQueue_Poll(&queue, NULL, events, TEST_ASYNC_KEYS,
+                                        WOLF_POLL_FLAG_CHECK_HW, &count), 0);
+        for (i = 0; i < count; i++) {
+            AssertIntEQ(events[i]->ret, 0);
+        }
+        done += count;
+    }
+    AssertIntEQ(wolfEventQueue_Count(&queue), 0);
+
+    for (i = 0; i < TEST_ASYNC_KEYS; i++) {
+        /* second call encodes the signature computed by the device */
+        AssertIntEQ(wc_ecc_sign_hash(hash, sizeof(hash), sig[i], &sigSz[i],
+                                     &rng[i], &key[i]), 0);
+
+        verify[i] = 0;
+        ret = wc_ecc_verify_hash(sig[i], sigSz[i], hash, sizeof(hash),
+                                 &verify[i], &key[i]);
+        while (ret == WC_PENDING_E) {
+            ret = wc_AsyncWait(ret, &key[i].asyncDev,
+                               WC_ASYNC_FLAG_CALL_AGAIN);
+            if (ret >= 0) {
+                ret = wc_ecc_verify_hash(sig[i], sigSz[i], hash, sizeof(hash),
+                                         &verify[i], &key[i]);
+            }
+        }
+        AssertIntEQ(ret, 0);
+        AssertIntEQ(verify[i], 1);
+
+        wc_ecc_free(&key[i]);
+        wc_FreeRng(&rng[i]);
+    }
+
+    wolfEventQueue_Free(&queue);
+    wolfAsync_DevClose(&devIdAsync);
+    AssertIntEQ(devIdAsync, INVALID_DEVID);
+
+    return 0;
+}
 #endif
 
 static void test_wolfSSL_X509_CRL(void)
@@ -31640,21 +32500,1029 @@ static void test_wolfSSL_CTX_LoadCRL()
 #endif
 }
 
-static void test_SetTmpEC_DHE_Sz(void)
+static void test_wolfSSL_set_session_cache_size(void)
 {
-#if defined(HAVE_ECC) && !defined(NO_WOLFSSL_CLIENT)
-    WOLFSSL_CTX *ctx;
-    WOLFSSL *ssl;
+#ifndef NO_SESSION_CACHE
+#ifdef PERSIST_SESSION_CACHE
+    byte* mem;
+    int   memSz;
+#endif
+#ifdef WOLFSSL_SESSION_STATS
+    word32 maxSessions = 0;
+#endif
 
-    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_client_method()));
-    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_SetTmpEC_DHE_Sz(ctx, 32));
-    AssertNotNull(ssl = wolfSSL_new(ctx));
-    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_SetTmpEC_DHE_Sz(ssl, 32));
+    printf(testingFmt, "wolfSSL_set_session_cache_size()");
 
-    wolfSSL_free(ssl);
-    wolfSSL_CTX_free(ctx);
+    /* size is fixed once the library is initialized */
+    AssertIntEQ(wolfSSL_Init(), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_set_session_cache_size(100), BAD_STATE_E);
+    AssertIntEQ(wolfSSL_Cleanup(), WOLFSSL_SUCCESS);
+
+    AssertIntEQ(wolfSSL_set_session_cache_size(0xFFFFFFFF), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_set_session_cache_size(1000), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_Init(), WOLFSSL_SUCCESS);
+
+#ifdef WOLFSSL_SESSION_STATS
+    AssertIntEQ(wolfSSL_get_session_stats(NULL, NULL, NULL, &maxSessions),
+                WOLFSSL_SUCCESS);
+    AssertIntGE(maxSessions, 1000);
 #endif
-}
+#ifdef PERSIST_SESSION_CACHE
+    memSz = wolfSSL_get_session_cache_memsize();
+    AssertIntGT(memSz, 0);
+    AssertNotNull(mem = (byte*)XMALLOC(memSz, NULL, DYNAMIC_TYPE_TMP_BUFFER));
+    AssertIntEQ(wolfSSL_memsave_session_cache(mem, memSz), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_memrestore_session_cache(mem, memSz), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_Cleanup(), WOLFSSL_SUCCESS);
+
+    /* a cache saved with a different number of rows can't be restored */
+    AssertIntEQ(wolfSSL_set_session_cache_size(0), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_Init(), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_memrestore_session_cache(mem, memSz),
+                CACHE_MATCH_ERROR);
+    XFREE(mem, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+
+    AssertIntEQ(wolfSSL_Cleanup(), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_set_session_cache_size(0), WOLFSSL_SUCCESS);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+#if !defined(NO_SESSION_CACHE) && defined(HAVE_IO_TESTS_DEPENDENCIES) && \
+    !defined(WOLFSSL_NO_TLS12) && !defined(SINGLE_THREADED)
+static WOLFSSL_SESSION_CACHE* testSessionCache = NULL;
+
+static void test_session_cache_ctx_ready(WOLFSSL_CTX* ctx)
+{
+    AssertIntEQ(wolfSSL_CTX_SetSessionCache(ctx, testSessionCache),
+                WOLFSSL_SUCCESS);
+#ifdef OPENSSL_EXTRA
+    AssertIntGE(wolfSSL_CTX_sess_get_cache_size(ctx), 64);
+#endif
+}
+#endif
+
+static void test_wolfSSL_CTX_SetSessionCache(void)
+{
+#ifndef NO_SESSION_CACHE
+    WOLFSSL_SESSION_CACHE* cache;
+    word32 active = 0, hits = 0, misses = 0, evictions = 0;
+#if defined(HAVE_IO_TESTS_DEPENDENCIES) && !defined(WOLFSSL_NO_TLS12) && \
+    !defined(SINGLE_THREADED)
+    tcp_ready ready;
+    func_args client_args;
+    func_args server_args;
+    THREAD_TYPE serverThread;
+    callback_functions func_cb_client;
+    callback_functions func_cb_server;
+#endif
+
+    printf(testingFmt, "wolfSSL_CTX_SetSessionCache()");
+
+    AssertNull(wolfSSL_SessionCacheNew(0, 0, WOLFSSL_SESSION_CACHE_LRU, NULL));
+    AssertNull(wolfSSL_SessionCacheNew(10, 0, -1, NULL));
+    AssertNull(wolfSSL_SessionCacheNew(0xFFFFFFFF, 0,
+                                       WOLFSSL_SESSION_CACHE_LRU, NULL));
+    AssertIntEQ(wolfSSL_CTX_SetSessionCache(NULL, NULL), BAD_FUNC_ARG);
+    wolfSSL_SessionCacheFree(NULL);
+
+    AssertNotNull(cache = wolfSSL_SessionCacheNew(1, 0,
+                                       WOLFSSL_SESSION_CACHE_CLOCK, NULL));
+    AssertIntEQ(wolfSSL_SessionCacheGetStats(cache, &active, &hits, &misses,
+                                             &evictions), WOLFSSL_SUCCESS);
+    AssertIntEQ(active + hits + misses + evictions, 0);
+    AssertIntEQ(wolfSSL_SessionCacheGetStats(NULL, &active, NULL, NULL, NULL),
+                WOLFSSL_SUCCESS);
+    wolfSSL_SessionCacheFree(cache);
+
+#if defined(HAVE_IO_TESTS_DEPENDENCIES) && !defined(WOLFSSL_NO_TLS12) && \
+    !defined(SINGLE_THREADED)
+    /* the sessions of the server end in the cache of its ctx */
+    AssertNotNull(testSessionCache = wolfSSL_SessionCacheNew(64, 3600,
+                                       WOLFSSL_SESSION_CACHE_LRU, NULL));
+
+    XMEMSET(&server_args, 0, sizeof(func_args));
+    XMEMSET(&client_args, 0, sizeof(func_args));
+    XMEMSET(&func_cb_client, 0, sizeof(callback_functions));
+    XMEMSET(&func_cb_server, 0, sizeof(callback_functions));
+
+    StartTCP();
+    InitTcpReady(&ready);
+
+#if defined(USE_WINDOWS_API)
+    /* use RNG to get random port if using windows */
+    ready.port = GetRandomPort();
+#endif
+
+    server_args.signal = &ready;
+    client_args.signal = &ready;
+    server_args.return_code = TEST_FAIL;
+    client_args.return_code = TEST_FAIL;
+
+    func_cb_client.method = wolfTLSv1_2_client_method;
+    client_args.callbacks = &func_cb_client;
+    func_cb_server.method = wolfTLSv1_2_server_method;
+    func_cb_server.ctx_ready = &test_session_cache_ctx_ready;
+    server_args.callbacks = &func_cb_server;
+
+    start_thread(test_server_nofail, &server_args, &serverThread);
+    wait_tcp_ready(&server_args);
+    test_client_nofail(&client_args, NULL);
+    join_thread(serverThread);
+
+    AssertTrue(client_args.return_code);
+    AssertTrue(server_args.return_code);
+
+    FreeTcpReady(&ready);
+
+    /* server ctx is gone, the cache is still referenced here */
+    AssertIntEQ(wolfSSL_SessionCacheGetStats(testSessionCache, &active, &hits,
+                                       &misses, &evictions), WOLFSSL_SUCCESS);
+    AssertIntEQ(active, 1);
+    AssertIntEQ(evictions, 0);
+    wolfSSL_SessionCacheFree(testSessionCache);
+    testSessionCache = NULL;
+#endif
+
+    printf(resultFmt, passed);
+#endif
+}
+
+static void test_SetTmpEC_DHE_Sz(void)
+{
+#if defined(HAVE_ECC) && !defined(NO_WOLFSSL_CLIENT)
+    WOLFSSL_CTX *ctx;
+    WOLFSSL *ssl;
+
+    AssertNotNull(ctx = wolfSSL_CTX_new(wolfSSLv23_client_method()));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_CTX_SetTmpEC_DHE_Sz(ctx, 32));
+    AssertNotNull(ssl = wolfSSL_new(ctx));
+    AssertIntEQ(WOLFSSL_SUCCESS, wolfSSL_SetTmpEC_DHE_Sz(ssl, 32));
+
+    wolfSSL_free(ssl);
+    wolfSSL_CTX_free(ctx);
+#endif
+}
+
+#if !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_NO_TLS12)
+#define TEST_MEMIO_PIPE_SZ (128 * 1024)
+
+typedef struct test_memio_pipe {
+    byte* buf;
+    int   len;
+    int   idx;
+    int   sendvCalls;
+    int   sendvIovs;
+} test_memio_pipe;
+
+static int test_memio_send(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    test_memio_pipe* pipe = (test_memio_pipe*)ctx;
+    (void)ssl;
+
+    if (pipe->len + sz > TEST_MEMIO_PIPE_SZ)
+        return WOLFSSL_CBIO_ERR_WANT_WRITE;
+    XMEMCPY(pipe->buf + pipe->len, buf, sz);
+    pipe->len += sz;
+
+    return sz;
+}
+
+#ifndef WOLFSSL_ASYNC_CRYPT
+static int test_memio_sendv(WOLFSSL* ssl, WOLFSSL_IOVEC* iov, int iovcnt,
+                            void* ctx)
+{
+    test_memio_pipe* pipe = (test_memio_pipe*)ctx;
+    int i, sent = 0;
+
+    pipe->sendvCalls++;
+    pipe->sendvIovs += iovcnt;
+    for (i = 0; i < iovcnt; i++) {
+        int ret = test_memio_send(ssl, iov[i].buf, iov[i].sz, ctx);
+        if (ret < 0)
+            return sent > 0 ? sent : ret;
+        sent += ret;
+    }
+
+    return sent;
+}
+#endif
+
+static int test_memio_recv(WOLFSSL* ssl, char* buf, int sz, void* ctx)
+{
+    test_memio_pipe* pipe = (test_memio_pipe*)ctx;
+    (void)ssl;
+
+    if (pipe->idx == pipe->len)
+        return WOLFSSL_CBIO_ERR_WANT_READ;
+    if (sz > pipe->len - pipe->idx)
+        sz = pipe->len - pipe->idx;
+    XMEMCPY(buf, pipe->buf + pipe->idx, sz);
+    pipe->idx += sz;
+    if (pipe->idx == pipe->len)
+        pipe->idx = pipe->len = 0;
+
+    return sz;
+}
+
+#ifdef WOLFSSL_ASYNC_CRYPT
+/* number of times a handshake step waited on the async device */
+static int test_memio_pending = 0;
+#endif
+
+/* runs a handshake step until it is done or waits on the peer. With async
+   crypto, a step pending on the device is polled until the device completes
+   it and called again. returns 1 when the handshake is done */
+static int test_memio_step(WOLFSSL* ssl, int (*step)(WOLFSSL*))
+{
+    int ret, err;
+
+    for (;;) {
+        ret = step(ssl);
+        if (ret == WOLFSSL_SUCCESS)
+            return 1;
+        err = wolfSSL_get_error(ssl, ret);
+    #ifdef WOLFSSL_ASYNC_CRYPT
+        if (err == WC_PENDING_E) {
+            test_memio_pending++;
+            while ((ret = wolfSSL_AsyncPoll(ssl,
+                                            WOLF_POLL_FLAG_CHECK_HW)) == 0) {
+            #ifndef WC_NO_ASYNC_THREADING
+                wc_AsyncThreadYield();
+            #endif
+            }
+            AssertIntEQ(ret, 1);
+            continue;
+        }
+    #endif
+        AssertIntEQ(err, WOLFSSL_ERROR_WANT_READ);
+        return 0;
+    }
+}
+
+/* completes the handshake between client and server over the two in memory
+   pipes */
+static void test_memio_handshake(WOLFSSL* cli, WOLFSSL* srv,
+                                 test_memio_pipe* toServer,
+                                 test_memio_pipe* toClient)
+{
+    int cliDone = 0, srvDone = 0;
+    int i;
+
+    wolfSSL_SetIOWriteCtx(cli, toServer);
+    wolfSSL_SetIOReadCtx(cli, toClient);
+    wolfSSL_SetIOWriteCtx(srv, toClient);
+    wolfSSL_SetIOReadCtx(srv, toServer);
+
+    for (i = 0; i < 10 && !(cliDone && srvDone); i++) {
+        if (!cliDone)
+            cliDone = test_memio_step(cli, wolfSSL_connect);
+        if (!srvDone)
+            srvDone = test_memio_step(srv, wolfSSL_accept);
+    }
+    AssertTrue(cliDone && srvDone);
+}
+
+/* creates a client and server connected through the two in memory pipes and
+   completes the handshake */
+static void test_memio_connect(WOLFSSL_CTX* cliCtx, WOLFSSL_CTX* srvCtx,
+                               WOLFSSL** cliOut, WOLFSSL** srvOut,
+                               test_memio_pipe* toServer,
+                               test_memio_pipe* toClient)
+{
+    WOLFSSL* cli;
+    WOLFSSL* srv;
+
+    AssertNotNull(cli = wolfSSL_new(cliCtx));
+    AssertNotNull(srv = wolfSSL_new(srvCtx));
+    test_memio_handshake(cli, srv, toServer, toClient);
+
+    *cliOut = cli;
+    *srvOut = srv;
+}
+
+/* allocates the buffers of the two in memory pipes */
+static void test_memio_pipes_new(test_memio_pipe* toServer,
+                                 test_memio_pipe* toClient)
+{
+    XMEMSET(toServer, 0, sizeof(*toServer));
+    XMEMSET(toClient, 0, sizeof(*toClient));
+    AssertNotNull(toServer->buf = (byte*)XMALLOC(TEST_MEMIO_PIPE_SZ, NULL,
+                                                 DYNAMIC_TYPE_TMP_BUFFER));
+    AssertNotNull(toClient->buf = (byte*)XMALLOC(TEST_MEMIO_PIPE_SZ, NULL,
+                                                 DYNAMIC_TYPE_TMP_BUFFER));
+}
+
+static void test_memio_pipes_free(test_memio_pipe* toServer,
+                                  test_memio_pipe* toClient)
+{
+    XFREE(toServer->buf, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(toClient->buf, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    toServer->buf = toClient->buf = NULL;
+}
+
+/* creates a ctx doing its I/O over the in memory pipes. A server uses the
+   RSA test certificate, a client doesn't verify the peer. */
+static WOLFSSL_CTX* test_memio_new_ctx(method_provider method, int server)
+{
+    WOLFSSL_CTX* ctx;
+
+    AssertNotNull(ctx = wolfSSL_CTX_new(method()));
+    if (server) {
+        AssertIntEQ(wolfSSL_CTX_use_certificate_file(ctx, svrCertFile,
+                    WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+        AssertIntEQ(wolfSSL_CTX_use_PrivateKey_file(ctx, svrKeyFile,
+                    WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    }
+    else {
+        wolfSSL_CTX_set_verify(ctx, WOLFSSL_VERIFY_NONE, 0);
+    }
+    wolfSSL_CTX_SetIOSend(ctx, test_memio_send);
+    wolfSSL_CTX_SetIORecv(ctx, test_memio_recv);
+
+    return ctx;
+}
+
+/* allocates the pipes and creates a client and server ctx to connect over
+   them, undone by test_memio_cleanup_ctx() */
+static void test_memio_setup_ctx(method_provider cliMethod,
+                                 method_provider srvMethod,
+                                 WOLFSSL_CTX** cliCtx, WOLFSSL_CTX** srvCtx,
+                                 test_memio_pipe* toServer,
+                                 test_memio_pipe* toClient)
+{
+    test_memio_pipes_new(toServer, toClient);
+    *cliCtx = test_memio_new_ctx(cliMethod, 0);
+    *srvCtx = test_memio_new_ctx(srvMethod, 1);
+}
+
+static void test_memio_cleanup_ctx(WOLFSSL_CTX* cliCtx, WOLFSSL_CTX* srvCtx,
+                                   test_memio_pipe* toServer,
+                                   test_memio_pipe* toClient)
+{
+    wolfSSL_CTX_free(cliCtx);
+    wolfSSL_CTX_free(srvCtx);
+    test_memio_pipes_free(toServer, toClient);
+}
+
+#endif
+
+#if !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_NO_TLS12) && !defined(WOLFSSL_ASYNC_CRYPT)
+/* writes 4 full records from the client, returns the number of vectored
+   sends it took */
+static int test_coalesce_write(int records, test_memio_pipe* toServer,
+                               test_memio_pipe* toClient, const byte* msg,
+                               byte* recv, int msgSz)
+{
+    WOLFSSL_CTX* cliCtx;
+    WOLFSSL_CTX* srvCtx;
+    WOLFSSL*     cli;
+    WOLFSSL*     srv;
+    int ret, got = 0;
+
+    cliCtx = test_memio_new_ctx(wolfTLSv1_2_client_method, 0);
+    srvCtx = test_memio_new_ctx(wolfTLSv1_2_server_method, 1);
+    AssertIntEQ(wolfSSL_CTX_set_coalesce_writes(cliCtx, records),
+                WOLFSSL_SUCCESS);
+    wolfSSL_CTX_SetIOSendv(cliCtx, test_memio_sendv);
+
+    test_memio_connect(cliCtx, srvCtx, &cli, &srv, toServer, toClient);
+
+    toServer->sendvCalls = toServer->sendvIovs = 0;
+    AssertIntEQ(wolfSSL_write(cli, msg, msgSz), msgSz);
+    while (got < msgSz) {
+        ret = wolfSSL_read(srv, recv + got, msgSz - got);
+        AssertIntGT(ret, 0);
+        got += ret;
+    }
+    AssertIntEQ(XMEMCMP(msg, recv, msgSz), 0);
+
+    wolfSSL_free(cli);
+    wolfSSL_free(srv);
+    wolfSSL_CTX_free(cliCtx);
+    wolfSSL_CTX_free(srvCtx);
+
+    return toServer->sendvCalls;
+}
+#endif
+
+static void test_wolfSSL_AsyncSwDevice_handshake(void)
+{
+#if defined(WOLFSSL_ASYNC_CRYPT) && defined(WOLFSSL_ASYNC_CRYPT_TEST) && \
+    !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_NO_TLS12)
+    WOLFSSL_CTX* cliCtx;
+    WOLFSSL_CTX* srvCtx;
+    WOLFSSL*     cli;
+    WOLFSSL*     srv;
+    test_memio_pipe toServer;
+    test_memio_pipe toClient;
+    int  devIdAsync = INVALID_DEVID;
+    byte msg[] = "async";
+    byte reply[sizeof(msg)];
+
+    printf(testingFmt, "software async device handshake");
+
+    AssertIntEQ(wolfAsync_DevOpen(&devIdAsync), 0);
+    test_memio_setup_ctx(wolfTLSv1_2_client_method, wolfTLSv1_2_server_method,
+                         &cliCtx, &srvCtx, &toServer, &toClient);
+    AssertIntEQ(wolfSSL_CTX_SetDevId(cliCtx, devIdAsync), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_SetDevId(srvCtx, devIdAsync), WOLFSSL_SUCCESS);
+
+    test_memio_pending = 0;
+    test_memio_connect(cliCtx, srvCtx, &cli, &srv, &toServer, &toClient);
+    /* the public key operations went through the device */
+    AssertIntGT(test_memio_pending, 0);
+
+    AssertIntEQ(wolfSSL_write(cli, msg, sizeof(msg)), sizeof(msg));
+    AssertIntEQ(wolfSSL_read(srv, reply, sizeof(reply)), sizeof(msg));
+    AssertIntEQ(XMEMCMP(msg, reply, sizeof(msg)), 0);
+
+    wolfSSL_free(cli);
+    wolfSSL_free(srv);
+    test_memio_cleanup_ctx(cliCtx, srvCtx, &toServer, &toClient);
+    wolfAsync_DevClose(&devIdAsync);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+static void test_wolfSSL_set_coalesce_writes(void)
+{
+#if !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_NO_TLS12) && !defined(WOLFSSL_ASYNC_CRYPT)
+    test_memio_pipe toServer;
+    test_memio_pipe toClient;
+    byte* msg;
+    byte* recv;
+    int   msgSz = 4 * 16384;
+
+    printf(testingFmt, "wolfSSL_set_coalesce_writes()");
+
+    AssertIntEQ(wolfSSL_CTX_set_coalesce_writes(NULL, 4), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_set_coalesce_writes(NULL, 4), BAD_FUNC_ARG);
+
+    test_memio_pipes_new(&toServer, &toClient);
+    AssertNotNull(msg = (byte*)XMALLOC(msgSz, NULL, DYNAMIC_TYPE_TMP_BUFFER));
+    AssertNotNull(recv = (byte*)XMALLOC(msgSz, NULL, DYNAMIC_TYPE_TMP_BUFFER));
+    XMEMSET(msg, 0xA5, msgSz);
+
+    /* one record per send, vectored send not used */
+    AssertIntEQ(test_coalesce_write(0, &toServer, &toClient, msg, recv, msgSz),
+                0);
+    /* all four records in one vectored send, one entry per record */
+    AssertIntEQ(test_coalesce_write(16, &toServer,
+                &toClient, msg, recv, msgSz), 1);
+    AssertIntEQ(toServer.sendvIovs, 4);
+    /* two records at a time */
+    AssertIntEQ(test_coalesce_write(2, &toServer, &toClient, msg, recv, msgSz),
+                2);
+    AssertIntEQ(toServer.sendvIovs, 4);
+
+    XFREE(msg, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    XFREE(recv, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    test_memio_pipes_free(&toServer, &toClient);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+#if !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_NO_TLS12) && !defined(WOLFSSL_ASYNC_CRYPT) && \
+    !defined(NO_SESSION_CACHE)
+/* connects with session, when not NULL, and returns the session the client
+   ends up with. *reused is set when the handshake resumed session. */
+static WOLFSSL_SESSION* test_session_cache_connect(WOLFSSL_CTX* cliCtx,
+    WOLFSSL_CTX* srvCtx, WOLFSSL_SESSION* session, int* reused,
+    test_memio_pipe* toServer, test_memio_pipe* toClient)
+{
+    WOLFSSL*         cli;
+    WOLFSSL*         srv;
+    WOLFSSL_SESSION* ret;
+
+    AssertNotNull(cli = wolfSSL_new(cliCtx));
+    AssertNotNull(srv = wolfSSL_new(srvCtx));
+    if (session != NULL)
+        AssertIntEQ(wolfSSL_set_session(cli, session), WOLFSSL_SUCCESS);
+    test_memio_handshake(cli, srv, toServer, toClient);
+    *reused = wolfSSL_session_reused(cli);
+    AssertIntEQ(wolfSSL_session_reused(srv), *reused);
+    AssertNotNull(ret = wolfSSL_get_session(cli));
+    wolfSSL_free(cli);
+    wolfSSL_free(srv);
+
+    return ret;
+}
+#endif
+
+static void test_wolfSSL_SessionCache_eviction(void)
+{
+#if !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_NO_TLS12) && !defined(WOLFSSL_ASYNC_CRYPT) && \
+    !defined(NO_SESSION_CACHE)
+    WOLFSSL_CTX* cliCtx;
+    WOLFSSL_CTX* srvCtx;
+    WOLFSSL_SESSION_CACHE* cliCache;
+    WOLFSSL_SESSION_CACHE* srvCache;
+    WOLFSSL_SESSION_CACHE* otherCache;
+    WOLFSSL_SESSION* sess[4];
+    WOLFSSL* cli;
+    WOLFSSL* srv;
+    test_memio_pipe toServer;
+    test_memio_pipe toClient;
+    word32 active = 0, hits = 0, misses = 0, evictions = 0;
+    int    reused = 0;
+    int    i;
+
+    printf(testingFmt, "wolfSSL_SessionCache eviction");
+
+    test_memio_setup_ctx(wolfTLSv1_2_client_method, wolfTLSv1_2_server_method,
+                         &cliCtx, &srvCtx, &toServer, &toClient);
+    /* server cache is a single row of SESSIONS_PER_ROW (3) sessions, the
+       client one is large enough to keep every session it gets */
+    AssertNotNull(srvCache = wolfSSL_SessionCacheNew(3, 0,
+                                       WOLFSSL_SESSION_CACHE_LRU, NULL));
+    AssertNotNull(cliCache = wolfSSL_SessionCacheNew(3000, 0,
+                                       WOLFSSL_SESSION_CACHE_LRU, NULL));
+    AssertIntEQ(wolfSSL_CTX_SetSessionCache(srvCtx, srvCache),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_SetSessionCache(cliCtx, cliCache),
+                WOLFSSL_SUCCESS);
+
+    /* fill the server cache */
+    for (i = 0; i < 3; i++) {
+        sess[i] = test_session_cache_connect(cliCtx, srvCtx, NULL, &reused,
+                                             &toServer, &toClient);
+        AssertIntEQ(reused, 0);
+    }
+    AssertIntEQ(wolfSSL_SessionCacheGetStats(srvCache, &active, NULL, NULL,
+                                             &evictions), WOLFSSL_SUCCESS);
+    AssertIntEQ(active, 3);
+    AssertIntEQ(evictions, 0);
+
+    /* using the oldest makes the second the least recently used */
+    (void)test_session_cache_connect(cliCtx, srvCtx, sess[0], &reused,
+                                     &toServer, &toClient);
+    AssertIntEQ(reused, 1);
+
+    /* a new session replaces the least recently used one */
+    sess[3] = test_session_cache_connect(cliCtx, srvCtx, NULL, &reused,
+                                         &toServer, &toClient);
+    AssertIntEQ(reused, 0);
+    AssertIntEQ(wolfSSL_SessionCacheGetStats(srvCache, &active, &hits, &misses,
+                                             &evictions), WOLFSSL_SUCCESS);
+    AssertIntEQ(active, 3);
+    AssertIntEQ(hits, 1);
+    AssertIntEQ(evictions, 1);
+
+    /* the others are still there */
+    for (i = 0; i < 4; i++) {
+        if (i == 1)
+            continue;
+        (void)test_session_cache_connect(cliCtx, srvCtx, sess[i], &reused,
+                                         &toServer, &toClient);
+        AssertIntEQ(reused, 1);
+    }
+
+    /* the victim does a full handshake, its new session evicts another */
+    (void)test_session_cache_connect(cliCtx, srvCtx, sess[1], &reused,
+                                     &toServer, &toClient);
+    AssertIntEQ(reused, 0);
+    AssertIntEQ(wolfSSL_SessionCacheGetStats(srvCache, &active, &hits, &misses,
+                                             &evictions), WOLFSSL_SUCCESS);
+    AssertIntEQ(hits, 4);
+    AssertIntGE(misses, 1);
+    AssertIntEQ(evictions, 2);
+
+    /* a session in the cache of another context is copied under its row */
+    AssertNotNull(otherCache = wolfSSL_SessionCacheNew(3, 0,
+                                       WOLFSSL_SESSION_CACHE_LRU, NULL));
+    AssertIntEQ(wolfSSL_CTX_SetSessionCache(cliCtx, otherCache),
+                WOLFSSL_SUCCESS);
+    AssertNotNull(cli = wolfSSL_new(cliCtx));
+    AssertNotNull(srv = wolfSSL_new(srvCtx));
+    AssertIntEQ(wolfSSL_set_session(cli, sess[3]), WOLFSSL_SUCCESS);
+    test_memio_handshake(cli, srv, &toServer, &toClient);
+    AssertIntEQ(wolfSSL_session_reused(cli), 1);
+    wolfSSL_free(cli);
+    wolfSSL_free(srv);
+
+    wolfSSL_SessionCacheFree(srvCache);
+    wolfSSL_SessionCacheFree(cliCache);
+    wolfSSL_SessionCacheFree(otherCache);
+    test_memio_cleanup_ctx(cliCtx, srvCtx, &toServer, &toClient);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+static void test_wolfSSL_read_zc(void)
+{
+#if !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_NO_TLS12) && !defined(WOLFSSL_ASYNC_CRYPT)
+    WOLFSSL_CTX* cliCtx;
+    WOLFSSL_CTX* srvCtx;
+    WOLFSSL*     cli;
+    WOLFSSL*     srv;
+    test_memio_pipe toServer;
+    test_memio_pipe toClient;
+    const unsigned char* data;
+    const unsigned char* again;
+    byte  msg[20000];
+    byte  rest[4000];
+    int   i;
+
+    printf(testingFmt, "wolfSSL_read_zc()");
+
+    AssertIntEQ(wolfSSL_read_zc(NULL, &data), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_read_zc_release(NULL, 0), BAD_FUNC_ARG);
+
+    for (i = 0; i < (int)sizeof(msg); i++)
+        msg[i] = (byte)i;
+
+    test_memio_setup_ctx(wolfTLSv1_2_client_method, wolfTLSv1_2_server_method,
+                         &cliCtx, &srvCtx, &toServer, &toClient);
+    test_memio_connect(cliCtx, srvCtx, &cli, &srv, &toServer, &toClient);
+
+    AssertIntEQ(wolfSSL_read_zc(srv, NULL), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_read_zc(srv, &data), WOLFSSL_FATAL_ERROR);
+    AssertIntEQ(wolfSSL_get_error(srv, WOLFSSL_FATAL_ERROR),
+                WOLFSSL_ERROR_WANT_READ);
+
+    /* first record is 16kB, the rest follows in a second record */
+    AssertIntEQ(wolfSSL_write(cli, msg, sizeof(msg)), sizeof(msg));
+    AssertIntEQ(wolfSSL_read_zc(srv, &data), 16384);
+    AssertIntEQ(XMEMCMP(data, msg, 16384), 0);
+    /* not consumed until released */
+    AssertIntEQ(wolfSSL_read_zc(srv, &again), 16384);
+    AssertPtrEq(again, data);
+    AssertIntEQ(wolfSSL_read_zc_release(srv, 16385), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_read_zc_release(srv, 100), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_read_zc(srv, &again), 16384 - 100);
+    AssertPtrEq(again, (data + 100));
+    AssertIntEQ(wolfSSL_read_zc_release(srv, 16384 - 100), WOLFSSL_SUCCESS);
+
+    /* mixes with the copying read */
+    AssertIntEQ(wolfSSL_read(srv, rest, 1000), 1000);
+    AssertIntEQ(XMEMCMP(rest, msg + 16384, 1000), 0);
+    AssertIntEQ(wolfSSL_read_zc(srv, &data), sizeof(msg) - 16384 - 1000);
+    AssertIntEQ(XMEMCMP(data, msg + 16384 + 1000, sizeof(msg) - 16384 - 1000),
+                0);
+    AssertIntEQ(wolfSSL_read_zc_release(srv, sizeof(msg) - 16384 - 1000),
+                WOLFSSL_SUCCESS);
+
+    /* close notify from peer */
+    wolfSSL_shutdown(cli);
+    AssertIntEQ(wolfSSL_read_zc(srv, &data), 0);
+
+    wolfSSL_free(cli);
+    wolfSSL_free(srv);
+    test_memio_cleanup_ctx(cliCtx, srvCtx, &toServer, &toClient);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+#if !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_NO_TLS12) && !defined(WOLFSSL_ASYNC_CRYPT) && \
+    defined(HAVE_AESGCM) && defined(WOLFSSL_AES_256) && \
+    defined(WOLFSSL_SHA384)
+/* handshakes with the SHA-384 suite, with client authentication when mutual,
+   and checks application data gets through */
+static void test_handshake_hash_suite(method_provider cliMethod,
+                                      method_provider srvMethod,
+                                      const char* suite, int mutual)
+{
+    WOLFSSL_CTX* cliCtx;
+    WOLFSSL_CTX* srvCtx;
+    WOLFSSL*     cli;
+    WOLFSSL*     srv;
+    test_memio_pipe toServer;
+    test_memio_pipe toClient;
+    const char msg[] = "handshake hash";
+    char reply[sizeof(msg)];
+
+    test_memio_setup_ctx(cliMethod, srvMethod, &cliCtx, &srvCtx, &toServer,
+                         &toClient);
+    AssertIntEQ(wolfSSL_CTX_set_cipher_list(cliCtx, suite), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_set_cipher_list(srvCtx, suite), WOLFSSL_SUCCESS);
+    if (mutual) {
+        wolfSSL_CTX_set_verify(srvCtx, WOLFSSL_VERIFY_PEER |
+                               WOLFSSL_VERIFY_FAIL_IF_NO_PEER_CERT, 0);
+        AssertIntEQ(wolfSSL_CTX_load_verify_locations(srvCtx, cliCertFile,
+                    0), WOLFSSL_SUCCESS);
+        AssertIntEQ(wolfSSL_CTX_use_certificate_file(cliCtx, cliCertFile,
+                    WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+        AssertIntEQ(wolfSSL_CTX_use_PrivateKey_file(cliCtx, cliKeyFile,
+                    WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    }
+
+    /* a wrong transcript hash fails the Finished check */
+    test_memio_connect(cliCtx, srvCtx, &cli, &srv, &toServer, &toClient);
+    AssertStrEQ(wolfSSL_get_cipher_name(cli), suite);
+    AssertIntEQ(wolfSSL_write(cli, msg, sizeof(msg)), sizeof(msg));
+    AssertIntEQ(wolfSSL_read(srv, reply, sizeof(reply)), sizeof(msg));
+    AssertIntEQ(XMEMCMP(reply, msg, sizeof(msg)), 0);
+
+    wolfSSL_free(cli);
+    wolfSSL_free(srv);
+    test_memio_cleanup_ctx(cliCtx, srvCtx, &toServer, &toClient);
+}
+#endif
+
+/* The transcript hash is only picked once the ServerHello is known, messages
+   before it are buffered and replayed into the hash of the suite. */
+static void test_wolfSSL_handshake_hash_after_hello(void)
+{
+#if !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_NO_TLS12) && !defined(WOLFSSL_ASYNC_CRYPT) && \
+    defined(HAVE_AESGCM) && defined(WOLFSSL_AES_256) && \
+    defined(WOLFSSL_SHA384)
+    printf(testingFmt, "handshake hash chosen after ServerHello");
+
+#ifdef HAVE_ECC
+    test_handshake_hash_suite(wolfTLSv1_2_client_method,
+                              wolfTLSv1_2_server_method,
+                              "ECDHE-RSA-AES256-GCM-SHA384", 0);
+    /* CertificateVerify hash is picked from the CertificateRequest */
+    test_handshake_hash_suite(wolfTLSv1_2_client_method,
+                              wolfTLSv1_2_server_method,
+                              "ECDHE-RSA-AES256-GCM-SHA384", 1);
+#endif
+#ifdef WOLFSSL_TLS13
+    test_handshake_hash_suite(wolfTLSv1_3_client_method,
+                              wolfTLSv1_3_server_method,
+                              "TLS13-AES256-GCM-SHA384", 0);
+    test_handshake_hash_suite(wolfTLSv1_3_client_method,
+                              wolfTLSv1_3_server_method,
+                              "TLS13-AES256-GCM-SHA384", 1);
+#endif
+
+    printf(resultFmt, passed);
+#endif
+}
+
+/* built-in ticket callback needs HMAC-SHA256 and an AEAD */
+#if defined(HAVE_SESSION_TICKET) && !defined(NO_HMAC) && \
+    !defined(NO_SHA256) && ((defined(HAVE_AESGCM) && \
+    defined(WOLFSSL_AES_256)) || (defined(HAVE_CHACHA) && \
+    defined(HAVE_POLY1305))) && !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB)
+    #define TEST_DEF_TICKET_ENC_CB
+#endif
+
+#if !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_NO_TLS12) && !defined(WOLFSSL_ASYNC_CRYPT) && \
+    defined(TEST_DEF_TICKET_ENC_CB) && !defined(NO_SESSION_CACHE)
+static WOLFSSL_CTX* test_ticket_server_ctx(const byte* secret, word32 sz)
+{
+    WOLFSSL_CTX* ctx;
+
+    ctx = test_memio_new_ctx(wolfTLSv1_2_server_method, 1);
+    /* only tickets can resume */
+    wolfSSL_CTX_set_session_cache_mode(ctx, WOLFSSL_SESS_CACHE_OFF);
+    AssertIntEQ(wolfSSL_CTX_UseDefTicketEncCb(ctx), WOLFSSL_SUCCESS);
+    if (secret != NULL) {
+        AssertIntEQ(wolfSSL_CTX_set_TicketKeySecret(ctx, secret, sz),
+                    WOLFSSL_SUCCESS);
+    }
+
+    return ctx;
+}
+
+/* resumes session on a new connection to srvCtx, returns if resumed */
+static int test_ticket_resume(WOLFSSL_CTX* cliCtx, WOLFSSL_CTX* srvCtx,
+                              WOLFSSL_SESSION* session,
+                              test_memio_pipe* toServer,
+                              test_memio_pipe* toClient)
+{
+    WOLFSSL* cli;
+    WOLFSSL* srv;
+    int      reused;
+
+    AssertNotNull(cli = wolfSSL_new(cliCtx));
+    AssertNotNull(srv = wolfSSL_new(srvCtx));
+    AssertIntEQ(wolfSSL_set_session(cli, session), WOLFSSL_SUCCESS);
+    test_memio_handshake(cli, srv, toServer, toClient);
+    reused = wolfSSL_session_reused(cli);
+    AssertIntEQ(wolfSSL_session_reused(srv), reused);
+    wolfSSL_free(cli);
+    wolfSSL_free(srv);
+
+    return reused;
+}
+#endif
+
+static void test_wolfSSL_CTX_set_TicketKeySecret(void)
+{
+#if !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_NO_TLS12) && !defined(WOLFSSL_ASYNC_CRYPT) && \
+    defined(TEST_DEF_TICKET_ENC_CB) && !defined(NO_SESSION_CACHE)
+    WOLFSSL_CTX* cliCtx;
+    WOLFSSL_CTX* srvCtx;
+    WOLFSSL_CTX* peerCtx;
+    WOLFSSL_CTX* otherCtx;
+    WOLFSSL_CTX* noTicketCtx;
+    WOLFSSL*     cli;
+    WOLFSSL*     srv;
+    WOLFSSL_SESSION* session;
+    test_memio_pipe toServer;
+    test_memio_pipe toClient;
+    byte secret[32];
+    byte other[32];
+    byte ticket[512];
+    word32 ticketSz;
+
+    printf(testingFmt, "wolfSSL_CTX_set_TicketKeySecret()");
+
+    XMEMSET(secret, 0x5a, sizeof(secret));
+    XMEMSET(other, 0xa5, sizeof(other));
+    test_memio_pipes_new(&toServer, &toClient);
+
+    srvCtx   = test_ticket_server_ctx(secret, sizeof(secret));
+    peerCtx  = test_ticket_server_ctx(secret, sizeof(secret));
+    otherCtx = test_ticket_server_ctx(other, sizeof(other));
+    /* tickets are opt-in */
+    noTicketCtx = test_memio_new_ctx(wolfTLSv1_2_server_method, 1);
+    wolfSSL_CTX_set_session_cache_mode(noTicketCtx, WOLFSSL_SESS_CACHE_OFF);
+
+    AssertIntEQ(wolfSSL_CTX_UseDefTicketEncCb(NULL), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CTX_set_TicketKeySecret(NULL, secret, sizeof(secret)),
+                BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CTX_set_TicketKeySecret(srvCtx, NULL, sizeof(secret)),
+                BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CTX_set_TicketKeySecret(srvCtx, secret,
+                15), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CTX_set_TicketKeySecret(srvCtx, secret,
+                65), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CTX_set_TicketKeyLifetime(NULL, 60), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CTX_set_TicketKeyLifetime(srvCtx, 0), BAD_FUNC_ARG);
+    /* peers must also agree on the lifetime to derive the same keys */
+    AssertIntEQ(wolfSSL_CTX_set_TicketKeyLifetime(srvCtx, 24 * 60 * 60),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_set_TicketKeyLifetime(peerCtx, 24 * 60 * 60),
+                WOLFSSL_SUCCESS);
+
+    cliCtx = test_memio_new_ctx(wolfTLSv1_2_client_method, 0);
+    AssertIntEQ(wolfSSL_CTX_UseSessionTicket(cliCtx), WOLFSSL_SUCCESS);
+
+    /* full handshake issues a ticket from the built-in callback */
+    test_memio_connect(cliCtx, srvCtx, &cli, &srv, &toServer, &toClient);
+    AssertIntEQ(wolfSSL_session_reused(cli), 0);
+    ticketSz = sizeof(ticket);
+    AssertIntEQ(wolfSSL_get_SessionTicket(cli, ticket, &ticketSz),
+                WOLFSSL_SUCCESS);
+    AssertIntGT(ticketSz, 0);
+    AssertNotNull(session = wolfSSL_get_session(cli));
+
+    /* same server, and one sharing the secret, accept the ticket */
+    AssertIntEQ(test_ticket_resume(cliCtx, srvCtx, session, &toServer,
+                                   &toClient), 1);
+    AssertIntEQ(test_ticket_resume(cliCtx, peerCtx, session, &toServer,
+                                   &toClient), 1);
+    /* different secret falls back to a full handshake */
+    AssertIntEQ(test_ticket_resume(cliCtx, otherCtx, session, &toServer,
+                                   &toClient), 0);
+    wolfSSL_free(cli);
+    wolfSSL_free(srv);
+
+    /* server without a ticket callback issues no ticket */
+    test_memio_connect(cliCtx, noTicketCtx, &cli, &srv, &toServer, &toClient);
+    ticketSz = sizeof(ticket);
+    AssertIntEQ(wolfSSL_get_SessionTicket(cli, ticket, &ticketSz),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(ticketSz, 0);
+
+    wolfSSL_free(cli);
+    wolfSSL_free(srv);
+    wolfSSL_CTX_free(noTicketCtx);
+    wolfSSL_CTX_free(peerCtx);
+    wolfSSL_CTX_free(otherCtx);
+    test_memio_cleanup_ctx(cliCtx, srvCtx, &toServer, &toClient);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+#if defined(WOLFSSL_FUNC_TIME) && !defined(NO_WOLFSSL_CLIENT) && \
+    !defined(NO_WOLFSSL_SERVER) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_CERTS) && !defined(NO_RSA) && !defined(WOLFSSL_NO_TLS12) && \
+    !defined(WOLFSSL_ASYNC_CRYPT)
+static int test_func_time_cb(const char* name, word64 calls, word64 cycles,
+                             void* ctx)
+{
+    (void)name;
+    (void)cycles;
+    *(word64*)ctx += calls;
+    return 0;
+}
+
+#ifndef SINGLE_THREADED
+/* handshakes once in its own thread, whose counters outlive it */
+static THREAD_RETURN WOLFSSL_THREAD test_func_time_thread(void* args)
+{
+    func_args* fa = (func_args*)args;
+    WOLFSSL_CTX* cliCtx;
+    WOLFSSL_CTX* srvCtx;
+    WOLFSSL*     cli;
+    WOLFSSL*     srv;
+    test_memio_pipe toServer;
+    test_memio_pipe toClient;
+
+    test_memio_setup_ctx(wolfTLSv1_2_client_method, wolfTLSv1_2_server_method,
+                         &cliCtx, &srvCtx, &toServer, &toClient);
+    test_memio_connect(cliCtx, srvCtx, &cli, &srv, &toServer, &toClient);
+    wolfSSL_free(cli);
+    wolfSSL_free(srv);
+    test_memio_cleanup_ctx(cliCtx, srvCtx, &toServer, &toClient);
+    fa->return_code = TEST_SUCCESS;
+
+#ifndef WOLFSSL_TIRTOS
+    return 0;
+#endif
+}
+#endif
+#endif
+
+static void test_wc_FuncTime(void)
+{
+#if defined(WOLFSSL_FUNC_TIME) && !defined(NO_WOLFSSL_CLIENT) && \
+    !defined(NO_WOLFSSL_SERVER) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_CERTS) && !defined(NO_RSA) && !defined(WOLFSSL_NO_TLS12) && \
+    !defined(WOLFSSL_ASYNC_CRYPT)
+    WOLFSSL_CTX* cliCtx;
+    WOLFSSL_CTX* srvCtx;
+    WOLFSSL*     cli;
+    WOLFSSL*     srv;
+    test_memio_pipe toServer;
+    test_memio_pipe toClient;
+    word64 calls, cycles, total = 0;
+#ifndef SINGLE_THREADED
+    func_args   args;
+    THREAD_TYPE thread;
+#endif
+
+    printf(testingFmt, "wc_FuncTime");
+
+    AssertNull(wc_FuncTimeName(-1));
+    AssertNull(wc_FuncTimeName(WC_FUNC_COUNT));
+    AssertStrEQ(wc_FuncTimeName(WC_FUNC_CLIENT_HELLO_SEND), "SendClientHello");
+    AssertIntEQ(wc_FuncTimeGet(WC_FUNC_COUNT, &calls, &cycles), BAD_FUNC_ARG);
+    AssertIntEQ(wc_FuncTimeDump(NULL, NULL), BAD_FUNC_ARG);
+
+    test_memio_setup_ctx(wolfTLSv1_2_client_method, wolfTLSv1_2_server_method,
+                         &cliCtx, &srvCtx, &toServer, &toClient);
+
+    wc_FuncTimeReset();
+    test_memio_connect(cliCtx, srvCtx, &cli, &srv, &toServer, &toClient);
+
+    AssertIntEQ(wc_FuncTimeGet(WC_FUNC_CLIENT_HELLO_SEND, &calls, &cycles), 0);
+    AssertTrue(calls == 1);
+    AssertTrue(cycles > 0);
+    AssertIntEQ(wc_FuncTimeGet(WC_FUNC_CLIENT_HELLO_DO, &calls, NULL), 0);
+    AssertTrue(calls == 1);
+    AssertIntEQ(wc_FuncTimeDump(test_func_time_cb, &total), 0);
+    AssertTrue(total > 2);
+
+    wc_FuncTimeReset();
+    AssertIntEQ(wc_FuncTimeGet(WC_FUNC_CLIENT_HELLO_SEND, &calls, &cycles), 0);
+    AssertTrue(calls == 0 && cycles == 0);
+
+#ifndef SINGLE_THREADED
+    /* the calls of a thread that has exited are still counted */
+    XMEMSET(&args, 0, sizeof(args));
+    start_thread(test_func_time_thread, &args, &thread);
+    join_thread(thread);
+    AssertIntEQ(args.return_code, TEST_SUCCESS);
+    AssertIntEQ(wc_FuncTimeGet(WC_FUNC_CLIENT_HELLO_SEND, &calls, &cycles), 0);
+    AssertTrue(calls == 1);
+    AssertTrue(cycles > 0);
+    wc_FuncTimeReset();
+    AssertIntEQ(wc_FuncTimeGet(WC_FUNC_CLIENT_HELLO_SEND, &calls, &cycles), 0);
+    AssertTrue(calls == 0 && cycles == 0);
+#endif
+
+    wolfSSL_free(cli);
+    wolfSSL_free(srv);
+    test_memio_cleanup_ctx(cliCtx, srvCtx, &toServer, &toClient);
+
+    printf(resultFmt, passed);
+#endif
+}
 
 static void test_wolfSSL_dtls_set_mtu(void)
 {
@@ -31697,6 +33565,567 @@ static void test_wolfSSL_dtls_set_mtu(void)
 #endif
 }
 
+static void test_wolfSSL_dtls_cid(void)
+{
+#if defined(WOLFSSL_DTLS_CID) && !defined(NO_WOLFSSL_CLIENT) && \
+    !defined(NO_WOLFSSL_SERVER) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_CERTS) && !defined(NO_RSA) && !defined(WOLFSSL_NO_TLS12) && \
+    !defined(WOLFSSL_ASYNC_CRYPT)
+    WOLFSSL_CTX* cliCtx;
+    WOLFSSL_CTX* srvCtx;
+    WOLFSSL*     cli;
+    WOLFSSL*     srv;
+    test_memio_pipe toServer;
+    test_memio_pipe toClient;
+    const byte cliCid[] = { 0x01, 0x02, 0x03, 0x04 };
+    const byte srvCid[] = { 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5 };
+    byte big[256];
+    byte cid[32];
+    byte msg[] = "connection id";
+    byte reply[sizeof(msg)];
+    unsigned int sz;
+    /* stand-ins for the sockaddr a custom I/O callback received from */
+    byte addrA[] = { 10, 0, 0, 1 };
+    byte addrB[] = { 10, 0, 0, 2 };
+    byte addrC[] = { 10, 0, 0, 3 };
+    byte peer[sizeof(addrA)];
+    byte stash[256];
+    int  stashSz;
+
+    printf(testingFmt, "wolfSSL_dtls_cid()");
+
+    XMEMSET(big, 0, sizeof(big));
+    test_memio_setup_ctx(wolfDTLSv1_2_client_method,
+                         wolfDTLSv1_2_server_method,
+                         &cliCtx, &srvCtx, &toServer, &toClient);
+
+    AssertNotNull(cli = wolfSSL_new(cliCtx));
+    AssertNotNull(srv = wolfSSL_new(srvCtx));
+
+    AssertIntEQ(wolfSSL_dtls_cid_use(NULL), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_dtls_cid_set(NULL, cliCid, sizeof(cliCid)),
+                BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_dtls_cid_set(cli, big, sizeof(big)), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_dtls_cid_is_enabled(cli), WOLFSSL_FAILURE);
+    AssertIntEQ(wolfSSL_dtls_cid_get_rx_size(cli, &sz), WOLFSSL_FAILURE);
+    AssertIntEQ(wolfSSL_dtls_cid_set_pending_peer(srv, addrB, sizeof(addrB)),
+                WOLFSSL_FAILURE);
+
+    AssertIntEQ(wolfSSL_dtls_cid_use(cli), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_dtls_cid_use(srv), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_dtls_cid_set(cli, cliCid, sizeof(cliCid)),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_dtls_cid_set(srv, srvCid, sizeof(srvCid)),
+                WOLFSSL_SUCCESS);
+    test_memio_handshake(cli, srv, &toServer, &toClient);
+
+    AssertIntEQ(wolfSSL_dtls_cid_is_enabled(cli), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_dtls_cid_is_enabled(srv), WOLFSSL_SUCCESS);
+    /* each side sends the id the other one asked for */
+    AssertIntEQ(wolfSSL_dtls_cid_get_tx_size(cli, &sz), WOLFSSL_SUCCESS);
+    AssertIntEQ(sz, sizeof(srvCid));
+    AssertIntEQ(wolfSSL_dtls_cid_get_tx(cli, cid, sizeof(cid)),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(XMEMCMP(cid, srvCid, sizeof(srvCid)), 0);
+    AssertIntEQ(wolfSSL_dtls_cid_get_rx_size(srv, &sz), WOLFSSL_SUCCESS);
+    AssertIntEQ(sz, sizeof(srvCid));
+    AssertIntEQ(wolfSSL_dtls_cid_get_tx(srv, cid, 1), BUFFER_E);
+    AssertIntEQ(wolfSSL_dtls_cid_get_tx(srv, cid, sizeof(cid)),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(XMEMCMP(cid, cliCid, sizeof(cliCid)), 0);
+    AssertIntEQ(wolfSSL_dtls_cid_get_rx(cli, cid, sizeof(cid)),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(XMEMCMP(cid, cliCid, sizeof(cliCid)), 0);
+    AssertIntEQ(wolfSSL_dtls_cid_set(cli, cliCid, sizeof(cliCid)),
+                WOLFSSL_FAILURE);
+
+    /* application data goes out as tls12_cid records */
+    AssertIntEQ(wolfSSL_write(cli, msg, sizeof(msg)), sizeof(msg));
+    AssertNotNull(wolfSSL_dtls_cid_parse(toServer.buf, toServer.len,
+                                         sizeof(srvCid)));
+    AssertIntEQ(XMEMCMP(wolfSSL_dtls_cid_parse(toServer.buf, toServer.len,
+                        sizeof(srvCid)), srvCid, sizeof(srvCid)), 0);
+    AssertNull(wolfSSL_dtls_cid_parse(toServer.buf, 12, sizeof(srvCid)));
+    AssertIntEQ(wolfSSL_read(srv, reply, sizeof(reply)), sizeof(msg));
+    AssertIntEQ(XMEMCMP(msg, reply, sizeof(msg)), 0);
+
+    AssertIntEQ(wolfSSL_write(srv, msg, sizeof(msg)), sizeof(msg));
+    AssertIntEQ(toClient.buf[0], 25);
+    /* a record with the wrong id is silently dropped */
+    toClient.buf[11] ^= 0xff;
+    AssertIntEQ(wolfSSL_read(cli, reply, sizeof(reply)), WOLFSSL_FATAL_ERROR);
+    AssertIntEQ(wolfSSL_get_error(cli, WOLFSSL_FATAL_ERROR),
+                WOLFSSL_ERROR_WANT_READ);
+    AssertIntEQ(wolfSSL_write(srv, msg, sizeof(msg)), sizeof(msg));
+    AssertIntEQ(wolfSSL_read(cli, reply, sizeof(reply)), sizeof(msg));
+    AssertIntEQ(XMEMCMP(msg, reply, sizeof(msg)), 0);
+
+    /* the server only follows the client to a new address on a record from
+     * there that authenticates and is newer than any seen before */
+    AssertIntEQ(wolfSSL_dtls_set_peer(srv, addrA, sizeof(addrA)),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_dtls_cid_set_pending_peer(NULL, addrB, sizeof(addrB)),
+                BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_dtls_cid_set_pending_peer(srv, NULL, sizeof(addrB)),
+                BAD_FUNC_ARG);
+
+    /* forged record, dropped with the session left usable */
+    AssertIntEQ(wolfSSL_write(cli, msg, sizeof(msg)), sizeof(msg));
+    toServer.buf[toServer.len - 1] ^= 0xff;
+    AssertIntEQ(wolfSSL_dtls_cid_set_pending_peer(srv, addrC, sizeof(addrC)),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_read(srv, reply, sizeof(reply)), WOLFSSL_FATAL_ERROR);
+    AssertIntEQ(wolfSSL_get_error(srv, WOLFSSL_FATAL_ERROR),
+                DECRYPT_ERROR);
+    sz = sizeof(peer);
+    AssertIntEQ(wolfSSL_dtls_get_peer(srv, peer, &sz), WOLFSSL_SUCCESS);
+    AssertIntEQ(sz, sizeof(addrA));
+    AssertIntEQ(XMEMCMP(peer, addrA, sizeof(addrA)), 0);
+
+    /* replayed record */
+    AssertIntEQ(wolfSSL_write(cli, msg, sizeof(msg)), sizeof(msg));
+    AssertIntLE(toServer.len, sizeof(stash));
+    stashSz = toServer.len;
+    XMEMCPY(stash, toServer.buf, stashSz);
+    AssertIntEQ(wolfSSL_dtls_cid_set_pending_peer(srv, NULL, 0),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_read(srv, reply, sizeof(reply)), sizeof(msg));
+    XMEMCPY(toServer.buf, stash, stashSz);
+    toServer.len = stashSz;
+    AssertIntEQ(wolfSSL_dtls_cid_set_pending_peer(srv, addrC, sizeof(addrC)),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_read(srv, reply, sizeof(reply)), WOLFSSL_FATAL_ERROR);
+    AssertIntEQ(wolfSSL_get_error(srv, WOLFSSL_FATAL_ERROR),
+                WOLFSSL_ERROR_WANT_READ);
+    sz = sizeof(peer);
+    AssertIntEQ(wolfSSL_dtls_get_peer(srv, peer, &sz), WOLFSSL_SUCCESS);
+    AssertIntEQ(XMEMCMP(peer, addrA, sizeof(addrA)), 0);
+
+    /* authentic record that arrives after a newer one */
+    AssertIntEQ(wolfSSL_write(cli, msg, sizeof(msg)), sizeof(msg));
+    AssertIntLE(toServer.len, sizeof(stash));
+    stashSz = toServer.len;
+    XMEMCPY(stash, toServer.buf, stashSz);
+    toServer.len = 0;
+    AssertIntEQ(wolfSSL_write(cli, msg, sizeof(msg)), sizeof(msg));
+    AssertIntEQ(wolfSSL_dtls_cid_set_pending_peer(srv, NULL, 0),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_read(srv, reply, sizeof(reply)), sizeof(msg));
+    XMEMCPY(toServer.buf, stash, stashSz);
+    toServer.len = stashSz;
+    AssertIntEQ(wolfSSL_dtls_cid_set_pending_peer(srv, addrC, sizeof(addrC)),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_read(srv, reply, sizeof(reply)), sizeof(msg));
+    sz = sizeof(peer);
+    AssertIntEQ(wolfSSL_dtls_get_peer(srv, peer, &sz), WOLFSSL_SUCCESS);
+    AssertIntEQ(XMEMCMP(peer, addrA, sizeof(addrA)), 0);
+
+    /* NAT rebinding, the next record shows up from another address */
+    AssertIntEQ(wolfSSL_write(cli, msg, sizeof(msg)), sizeof(msg));
+    AssertIntEQ(wolfSSL_dtls_cid_set_pending_peer(srv, addrB, sizeof(addrB)),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_read(srv, reply, sizeof(reply)), sizeof(msg));
+    AssertIntEQ(XMEMCMP(msg, reply, sizeof(msg)), 0);
+    sz = sizeof(peer);
+    AssertIntEQ(wolfSSL_dtls_get_peer(srv, peer, &sz), WOLFSSL_SUCCESS);
+    AssertIntEQ(sz, sizeof(addrB));
+    AssertIntEQ(XMEMCMP(peer, addrB, sizeof(addrB)), 0);
+
+    wolfSSL_free(cli);
+    wolfSSL_free(srv);
+    test_memio_cleanup_ctx(cliCtx, srvCtx, &toServer, &toClient);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+#if defined(WOLFSSL_DTLS_CID) && !defined(NO_WOLFSSL_CLIENT) && \
+    !defined(NO_WOLFSSL_SERVER) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_CERTS) && !defined(NO_RSA) && !defined(WOLFSSL_NO_TLS12) && \
+    !defined(WOLFSSL_ASYNC_CRYPT)
+/* handshakes asking for connection IDs with only the given suite enabled,
+   expectCid says whether the suite can protect CID records */
+static void test_dtls_cid_suite(const char* suite, int ecc, int expectCid)
+{
+    WOLFSSL_CTX* cliCtx;
+    WOLFSSL_CTX* srvCtx;
+    WOLFSSL*     cli;
+    WOLFSSL*     srv;
+    test_memio_pipe toServer;
+    test_memio_pipe toClient;
+    const byte cliCid[] = { 0x01, 0x02, 0x03, 0x04 };
+    const byte srvCid[] = { 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5 };
+    byte msg[] = "connection id";
+    byte reply[sizeof(msg)];
+    int  expectSuccess = expectCid ? WOLFSSL_SUCCESS : WOLFSSL_FAILURE;
+
+    test_memio_setup_ctx(wolfDTLSv1_2_client_method,
+                         wolfDTLSv1_2_server_method,
+                         &cliCtx, &srvCtx, &toServer, &toClient);
+    if (ecc) {
+        AssertIntEQ(wolfSSL_CTX_use_certificate_file(srvCtx, eccCertFile,
+                    WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+        AssertIntEQ(wolfSSL_CTX_use_PrivateKey_file(srvCtx, eccKeyFile,
+                    WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    }
+    AssertIntEQ(wolfSSL_CTX_set_cipher_list(cliCtx, suite), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_set_cipher_list(srvCtx, suite), WOLFSSL_SUCCESS);
+
+    AssertNotNull(cli = wolfSSL_new(cliCtx));
+    AssertNotNull(srv = wolfSSL_new(srvCtx));
+    AssertIntEQ(wolfSSL_dtls_cid_use(cli), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_dtls_cid_use(srv), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_dtls_cid_set(cli, cliCid, sizeof(cliCid)),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_dtls_cid_set(srv, srvCid, sizeof(srvCid)),
+                WOLFSSL_SUCCESS);
+    test_memio_handshake(cli, srv, &toServer, &toClient);
+    AssertStrEQ(wolfSSL_get_cipher_name(cli), suite);
+
+    AssertIntEQ(wolfSSL_dtls_cid_is_enabled(cli), expectSuccess);
+    AssertIntEQ(wolfSSL_dtls_cid_is_enabled(srv), expectSuccess);
+
+    AssertIntEQ(wolfSSL_write(cli, msg, sizeof(msg)), sizeof(msg));
+    AssertIntEQ(toServer.buf[0], expectCid ? 25 : 23);
+    AssertIntEQ(wolfSSL_read(srv, reply, sizeof(reply)), sizeof(msg));
+    AssertIntEQ(XMEMCMP(msg, reply, sizeof(msg)), 0);
+    AssertIntEQ(wolfSSL_write(srv, msg, sizeof(msg)), sizeof(msg));
+    AssertIntEQ(toClient.buf[0], expectCid ? 25 : 23);
+    AssertIntEQ(wolfSSL_read(cli, reply, sizeof(reply)), sizeof(msg));
+    AssertIntEQ(XMEMCMP(msg, reply, sizeof(msg)), 0);
+
+    wolfSSL_free(cli);
+    wolfSSL_free(srv);
+    test_memio_cleanup_ctx(cliCtx, srvCtx, &toServer, &toClient);
+}
+#endif
+
+static void test_wolfSSL_dtls_cid_suites(void)
+{
+#if defined(WOLFSSL_DTLS_CID) && !defined(NO_WOLFSSL_CLIENT) && \
+    !defined(NO_WOLFSSL_SERVER) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_CERTS) && !defined(NO_RSA) && !defined(WOLFSSL_NO_TLS12) && \
+    !defined(WOLFSSL_ASYNC_CRYPT)
+    printf(testingFmt, "wolfSSL_dtls_cid() suites");
+
+#if defined(HAVE_CHACHA) && defined(HAVE_POLY1305) && defined(HAVE_ECC)
+    test_dtls_cid_suite("ECDHE-RSA-CHACHA20-POLY1305", 0, 1);
+#endif
+#if defined(HAVE_AESCCM) && defined(HAVE_ECC)
+    test_dtls_cid_suite("ECDHE-ECDSA-AES128-CCM", 1, 1);
+#endif
+    /* connection IDs are only used with AEAD suites */
+#if defined(HAVE_AES_CBC) && defined(HAVE_ECC) && !defined(NO_SHA256)
+    test_dtls_cid_suite("ECDHE-RSA-AES128-SHA256", 0, 0);
+#endif
+
+    printf(resultFmt, passed);
+#endif
+}
+
+static void test_wolfSSL_dtls_cid_rebind(void)
+{
+#if defined(WOLFSSL_DTLS_CID) && !defined(NO_WOLFSSL_CLIENT) && \
+    !defined(NO_WOLFSSL_SERVER) && !defined(NO_FILESYSTEM) && \
+    !defined(NO_CERTS) && !defined(NO_RSA) && !defined(WOLFSSL_NO_TLS12) && \
+    !defined(WOLFSSL_USER_IO) && !defined(USE_WINDOWS_API) && \
+    defined(HAVE_AESGCM) && !defined(WOLFSSL_ASYNC_CRYPT)
+    WOLFSSL_CTX*   cliCtx;
+    WOLFSSL_CTX*   srvCtx;
+    WOLFSSL*       cli;
+    WOLFSSL*       srv;
+    SOCKET_T       sock[4];
+    SOCKADDR_IN    addr[4];
+    SOCKADDR_IN    peer;
+    socklen_t      addrSz;
+    unsigned int   peerSz;
+    const byte cliCid[] = { 0x01, 0x02, 0x03, 0x04 };
+    const byte srvCid[] = { 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5 };
+    byte msg[] = "connection id";
+    byte reply[sizeof(msg)];
+    byte forged[256];
+    int  forgedSz;
+    int  cliDone = 0, srvDone = 0;
+    int  i, ret;
+
+    printf(testingFmt, "wolfSSL_dtls_cid() NAT rebinding");
+
+    /* 0 server, 1 client, 2 client after the rebinding, 3 attacker */
+    for (i = 0; i < 4; i++) {
+        sock[i] = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        AssertIntGE(sock[i], 0);
+        XMEMSET(&addr[i], 0, sizeof(addr[i]));
+        addr[i].sin_family = AF_INET;
+        addr[i].sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        AssertIntEQ(bind(sock[i], (struct sockaddr*)&addr[i],
+                         sizeof(addr[i])), 0);
+        addrSz = sizeof(addr[i]);
+        AssertIntEQ(getsockname(sock[i], (struct sockaddr*)&addr[i], &addrSz),
+                    0);
+        tcp_set_nonblocking(&sock[i]);
+    }
+
+    AssertNotNull(cliCtx = wolfSSL_CTX_new(wolfDTLSv1_2_client_method()));
+    AssertNotNull(srvCtx = wolfSSL_CTX_new(wolfDTLSv1_2_server_method()));
+    wolfSSL_CTX_set_verify(cliCtx, WOLFSSL_VERIFY_NONE, 0);
+    AssertIntEQ(wolfSSL_CTX_use_certificate_file(srvCtx, svrCertFile,
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_use_PrivateKey_file(srvCtx, svrKeyFile,
+                WOLFSSL_FILETYPE_PEM), WOLFSSL_SUCCESS);
+    AssertNotNull(cli = wolfSSL_new(cliCtx));
+    AssertNotNull(srv = wolfSSL_new(srvCtx));
+    AssertIntEQ(wolfSSL_set_fd(cli, sock[1]), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_set_fd(srv, sock[0]), WOLFSSL_SUCCESS);
+    wolfSSL_dtls_set_using_nonblock(cli, 1);
+    wolfSSL_dtls_set_using_nonblock(srv, 1);
+    AssertIntEQ(wolfSSL_dtls_set_peer(cli, &addr[0], sizeof(addr[0])),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_dtls_set_peer(srv, &addr[1], sizeof(addr[1])),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_dtls_cid_use(cli), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_dtls_cid_use(srv), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_dtls_cid_set(cli, cliCid, sizeof(cliCid)),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_dtls_cid_set(srv, srvCid, sizeof(srvCid)),
+                WOLFSSL_SUCCESS);
+
+    for (i = 0; i < 10 && !(cliDone && srvDone); i++) {
+        if (!cliDone) {
+            ret = wolfSSL_connect(cli);
+            if (ret == WOLFSSL_SUCCESS)
+                cliDone = 1;
+            else
+                AssertIntEQ(wolfSSL_get_error(cli, ret),
+                            WOLFSSL_ERROR_WANT_READ);
+        }
+        if (!srvDone) {
+            ret = wolfSSL_accept(srv);
+            if (ret == WOLFSSL_SUCCESS)
+                srvDone = 1;
+            else
+                AssertIntEQ(wolfSSL_get_error(srv, ret),
+                            WOLFSSL_ERROR_WANT_READ);
+        }
+    }
+    AssertTrue(cliDone && srvDone);
+    AssertIntEQ(wolfSSL_dtls_cid_is_enabled(srv), WOLFSSL_SUCCESS);
+
+    /* the client's NAT mapping changes */
+    AssertIntEQ(wolfSSL_set_fd(cli, sock[2]), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_write(cli, msg, sizeof(msg)), sizeof(msg));
+    AssertIntEQ(wolfSSL_read(srv, reply, sizeof(reply)), sizeof(msg));
+    AssertIntEQ(XMEMCMP(msg, reply, sizeof(msg)), 0);
+    peerSz = sizeof(peer);
+    AssertIntEQ(wolfSSL_dtls_get_peer(srv, &peer, &peerSz), WOLFSSL_SUCCESS);
+    AssertIntEQ(peerSz, sizeof(addr[2]));
+    AssertIntEQ(XMEMCMP(&peer, &addr[2], sizeof(addr[2])), 0);
+    /* replies go to the new address */
+    AssertIntEQ(wolfSSL_write(srv, msg, sizeof(msg)), sizeof(msg));
+    AssertIntEQ(wolfSSL_read(cli, reply, sizeof(reply)), sizeof(msg));
+
+    /* a forged record with the right connection ID doesn't move the peer */
+    AssertIntEQ(wolfSSL_set_fd(cli, sock[3]), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_write(cli, msg, sizeof(msg)), sizeof(msg));
+    forgedSz = (int)recvfrom(sock[0], (char*)forged, sizeof(forged), 0, NULL,
+                             NULL);
+    AssertIntGT(forgedSz, 0);
+    forged[forgedSz - 1] ^= 0xff;
+    AssertIntEQ((int)sendto(sock[3], (char*)forged, forgedSz, 0,
+                            (struct sockaddr*)&addr[0], sizeof(addr[0])),
+                forgedSz);
+    AssertIntEQ(wolfSSL_read(srv, reply, sizeof(reply)), WOLFSSL_FATAL_ERROR);
+    AssertIntEQ(wolfSSL_get_error(srv, WOLFSSL_FATAL_ERROR),
+                DECRYPT_ERROR);
+    peerSz = sizeof(peer);
+    AssertIntEQ(wolfSSL_dtls_get_peer(srv, &peer, &peerSz), WOLFSSL_SUCCESS);
+    AssertIntEQ(XMEMCMP(&peer, &addr[2], sizeof(addr[2])), 0);
+    /* and the next authentic one from the current address still reads */
+    AssertIntEQ(wolfSSL_set_fd(cli, sock[2]), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_write(cli, msg, sizeof(msg)), sizeof(msg));
+    AssertIntEQ(wolfSSL_read(srv, reply, sizeof(reply)), sizeof(msg));
+    peerSz = sizeof(peer);
+    AssertIntEQ(wolfSSL_dtls_get_peer(srv, &peer, &peerSz), WOLFSSL_SUCCESS);
+    AssertIntEQ(XMEMCMP(&peer, &addr[2], sizeof(addr[2])), 0);
+
+    wolfSSL_free(cli);
+    wolfSSL_free(srv);
+    wolfSSL_CTX_free(cliCtx);
+    wolfSSL_CTX_free(srvCtx);
+    for (i = 0; i < 4; i++)
+        CloseSocket(sock[i]);
+
+    printf(resultFmt, passed);
+#endif
+}
+
+#if !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_NO_TLS12) && !defined(WOLFSSL_ASYNC_CRYPT) && \
+    defined(WOLFSSL_KEY_SHARE_POOL) && defined(HAVE_ECC) && \
+    !defined(NO_ECC256) && defined(HAVE_SUPPORTED_CURVES) && \
+    defined(HAVE_PTHREAD)
+/* sets up, starts and stops the pool racing the main thread */
+static THREAD_RETURN WOLFSSL_THREAD test_key_share_pool_thread(void* args)
+{
+    func_args*   fa = (func_args*)args;
+    WOLFSSL_CTX* ctx = fa->callbacks->ctx;
+    int          i;
+    int          ret;
+
+    fa->return_code = TEST_SUCCESS;
+    if (wolfSSL_CTX_UseKeySharePool(ctx, WOLFSSL_ECC_SECP256R1, 2) !=
+                                                            WOLFSSL_SUCCESS)
+        fa->return_code = TEST_FAIL;
+    for (i = 0; i < 20; i++) {
+        ret = wolfSSL_CTX_KeySharePoolStart(ctx);
+        /* BAD_STATE_E when the other thread is part way through a stop */
+        if (ret != WOLFSSL_SUCCESS && ret != BAD_STATE_E)
+            fa->return_code = TEST_FAIL;
+        if (wolfSSL_CTX_KeySharePoolStop(ctx) != WOLFSSL_SUCCESS)
+            fa->return_code = TEST_FAIL;
+    }
+
+#ifndef WOLFSSL_TIRTOS
+    return 0;
+#endif
+}
+#endif
+
+static void test_wolfSSL_CTX_UseKeySharePool(void)
+{
+#if !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(NO_FILESYSTEM) && !defined(NO_CERTS) && !defined(NO_RSA) && \
+    !defined(WOLFSSL_NO_TLS12) && !defined(WOLFSSL_ASYNC_CRYPT) && \
+    defined(WOLFSSL_KEY_SHARE_POOL) && defined(HAVE_ECC) && \
+    !defined(NO_ECC256) && defined(HAVE_SUPPORTED_CURVES)
+    WOLFSSL_CTX* cliCtx;
+    WOLFSSL_CTX* srvCtx;
+    WOLFSSL*     cli;
+    WOLFSSL*     srv;
+    test_memio_pipe toServer;
+    test_memio_pipe toClient;
+    char  buf[8];
+    int   i;
+#ifdef HAVE_PTHREAD
+    int   ret;
+    func_args args;
+    callback_functions cbs;
+    THREAD_TYPE thread;
+#endif
+
+    printf(testingFmt, "wolfSSL_CTX_UseKeySharePool()");
+
+    test_memio_setup_ctx(wolfTLSv1_2_client_method, wolfTLSv1_2_server_method,
+                         &cliCtx, &srvCtx, &toServer, &toClient);
+    AssertIntEQ(wolfSSL_CTX_UseSupportedCurve(cliCtx, WOLFSSL_ECC_SECP256R1),
+                WOLFSSL_SUCCESS);
+
+    AssertIntEQ(wolfSSL_CTX_UseKeySharePool(NULL, WOLFSSL_ECC_SECP256R1, 2),
+                BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CTX_UseKeySharePool(srvCtx, WOLFSSL_ECC_SECP256R1, -1),
+                BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CTX_UseKeySharePool(srvCtx, WOLFSSL_ECC_SECP256R1,
+                100000), BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CTX_UseKeySharePool(srvCtx, WOLFSSL_ECC_SECP160R1, 2),
+                BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CTX_KeySharePoolCount(NULL, WOLFSSL_ECC_SECP256R1),
+                BAD_FUNC_ARG);
+    AssertIntEQ(wolfSSL_CTX_KeySharePoolCount(srvCtx, WOLFSSL_ECC_SECP256R1),
+                0);
+    AssertIntEQ(wolfSSL_CTX_KeySharePoolRefill(NULL), BAD_FUNC_ARG);
+
+    AssertIntEQ(wolfSSL_CTX_UseKeySharePool(srvCtx, WOLFSSL_ECC_SECP256R1, 3),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_KeySharePoolCount(srvCtx, WOLFSSL_ECC_SECP256R1),
+                0);
+    AssertIntEQ(wolfSSL_CTX_KeySharePoolRefill(srvCtx), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_KeySharePoolCount(srvCtx, WOLFSSL_ECC_SECP256R1),
+                3);
+
+    /* each server key exchange takes its own key pair from the pool */
+    for (i = 0; i < 2; i++) {
+        test_memio_connect(cliCtx, srvCtx, &cli, &srv, &toServer, &toClient);
+        AssertIntEQ(wolfSSL_CTX_KeySharePoolCount(srvCtx,
+                    WOLFSSL_ECC_SECP256R1), 2 - i);
+        AssertIntEQ(wolfSSL_write(cli, "pool", 4), 4);
+        AssertIntEQ(wolfSSL_read(srv, buf, sizeof(buf)), 4);
+        AssertIntEQ(XMEMCMP(buf, "pool", 4), 0);
+        wolfSSL_free(cli);
+        wolfSSL_free(srv);
+    }
+
+    /* lower depth drops key pairs, 0 stops pooling the group */
+    AssertIntEQ(wolfSSL_CTX_KeySharePoolRefill(srvCtx), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_KeySharePoolCount(srvCtx, WOLFSSL_ECC_SECP256R1),
+                3);
+    AssertIntEQ(wolfSSL_CTX_UseKeySharePool(srvCtx, WOLFSSL_ECC_SECP256R1, 1),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_KeySharePoolCount(srvCtx, WOLFSSL_ECC_SECP256R1),
+                1);
+    AssertIntEQ(wolfSSL_CTX_UseKeySharePool(srvCtx, WOLFSSL_ECC_SECP256R1, 0),
+                WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_KeySharePoolCount(srvCtx, WOLFSSL_ECC_SECP256R1),
+                0);
+
+#ifdef HAVE_PTHREAD
+    /* refill thread replaces the key pairs taken */
+    AssertIntEQ(wolfSSL_CTX_UseKeySharePool(srvCtx, WOLFSSL_ECC_SECP256R1, 2),
+                WOLFSSL_SUCCESS);
+    ret = wolfSSL_CTX_KeySharePoolStart(srvCtx);
+    if (ret != NOT_COMPILED_IN) {
+        AssertIntEQ(ret, WOLFSSL_SUCCESS);
+        for (i = 0; i < 500 && wolfSSL_CTX_KeySharePoolCount(srvCtx,
+                                         WOLFSSL_ECC_SECP256R1) < 2; i++)
+            usleep(10000);
+        AssertIntEQ(wolfSSL_CTX_KeySharePoolCount(srvCtx,
+                    WOLFSSL_ECC_SECP256R1), 2);
+        test_memio_connect(cliCtx, srvCtx, &cli, &srv, &toServer, &toClient);
+        wolfSSL_free(cli);
+        wolfSSL_free(srv);
+        for (i = 0; i < 500 && wolfSSL_CTX_KeySharePoolCount(srvCtx,
+                                         WOLFSSL_ECC_SECP256R1) < 2; i++)
+            usleep(10000);
+        AssertIntEQ(wolfSSL_CTX_KeySharePoolCount(srvCtx,
+                    WOLFSSL_ECC_SECP256R1), 2);
+        AssertIntEQ(wolfSSL_CTX_KeySharePoolStop(srvCtx), WOLFSSL_SUCCESS);
+        AssertIntEQ(wolfSSL_CTX_KeySharePoolStop(srvCtx), WOLFSSL_SUCCESS);
+        /* freeing the context also stops a running thread */
+        AssertIntEQ(wolfSSL_CTX_KeySharePoolStart(srvCtx), WOLFSSL_SUCCESS);
+        AssertIntEQ(wolfSSL_CTX_KeySharePoolStart(srvCtx), WOLFSSL_SUCCESS);
+    }
+#endif
+
+    test_memio_cleanup_ctx(cliCtx, srvCtx, &toServer, &toClient);
+
+#ifdef HAVE_PTHREAD
+    /* pool creation, start and stop from two threads at once */
+    AssertNotNull(srvCtx = wolfSSL_CTX_new(wolfTLSv1_2_server_method()));
+    XMEMSET(&args, 0, sizeof(args));
+    XMEMSET(&cbs, 0, sizeof(cbs));
+    cbs.ctx = srvCtx;
+    args.callbacks = &cbs;
+    start_thread(test_key_share_pool_thread, &args, &thread);
+    AssertIntEQ(wolfSSL_CTX_UseKeySharePool(srvCtx, WOLFSSL_ECC_SECP256R1, 2),
+                WOLFSSL_SUCCESS);
+    for (i = 0; i < 20; i++) {
+        ret = wolfSSL_CTX_KeySharePoolStart(srvCtx);
+        if (ret != BAD_STATE_E && ret != NOT_COMPILED_IN)
+            AssertIntEQ(ret, WOLFSSL_SUCCESS);
+        AssertIntEQ(wolfSSL_CTX_KeySharePoolStop(srvCtx), WOLFSSL_SUCCESS);
+    }
+    join_thread(thread);
+    if (ret != NOT_COMPILED_IN)
+        AssertIntEQ(args.return_code, TEST_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_KeySharePoolRefill(srvCtx), WOLFSSL_SUCCESS);
+    AssertIntEQ(wolfSSL_CTX_KeySharePoolCount(srvCtx, WOLFSSL_ECC_SECP256R1),
+                2);
+    wolfSSL_CTX_free(srvCtx);
+#endif
+
+    printf(resultFmt, passed);
+#endif
+}
+
 #if !defined(NO_RSA) && !defined(NO_SHA) && !defined(NO_FILESYSTEM) && \
     !defined(NO_CERTS)
 static int load_ca_into_cm(WOLFSSL_CERT_MANAGER* cm, char* certA)
@@ -31965,6 +34394,8 @@ void ApiTest(void)
     AssertTrue(test_fileAccess());
 
     printf(" Begin API Tests\n");
+    /* sizes the session cache, before the library is initialized */
+    test_wolfSSL_set_session_cache_size();
     AssertIntEQ(test_wolfSSL_Init(), WOLFSSL_SUCCESS);
     /* wolfcrypt initialization tests */
     test_wolfSSL_Method_Allocators();
@@ -31983,6 +34414,9 @@ void ApiTest(void)
     test_wolfSSL_CertManagerGetCerts();
     test_wolfSSL_CertManagerSetVerify();
     test_wolfSSL_CertManagerCRL();
+    test_wolfSSL_CertManagerOCSPCache();
+    test_wolfSSL_CertManagerCATable();
+    test_wolfSSL_CertManagerVerifyCache();
     test_wolfSSL_CTX_load_verify_locations_ex();
     test_wolfSSL_CTX_load_verify_buffer_ex();
     test_wolfSSL_CTX_load_verify_chain_buffer_format();
@@ -31999,7 +34433,19 @@ void ApiTest(void)
     test_wolfSSL_SetTmpDH_buffer();
     test_wolfSSL_SetMinMaxDhKey_Sz();
     test_SetTmpEC_DHE_Sz();
+    test_wolfSSL_CTX_SetSessionCache();
+    test_wolfSSL_SessionCache_eviction();
+    test_wolfSSL_set_coalesce_writes();
+    test_wolfSSL_AsyncSwDevice_handshake();
+    test_wolfSSL_read_zc();
+    test_wolfSSL_handshake_hash_after_hello();
+    test_wolfSSL_CTX_set_TicketKeySecret();
+    test_wc_FuncTime();
     test_wolfSSL_dtls_set_mtu();
+    test_wolfSSL_dtls_cid();
+    test_wolfSSL_dtls_cid_suites();
+    test_wolfSSL_dtls_cid_rebind();
+    test_wolfSSL_CTX_UseKeySharePool();
 #if !defined(NO_WOLFSSL_CLIENT) && !defined(NO_WOLFSSL_SERVER) && \
     defined(HAVE_IO_TESTS_DEPENDENCIES)
     test_wolfSSL_read_write();
@@ -32121,6 +34567,7 @@ void ApiTest(void)
     test_wolfSSL_PKCS8_Compat();
     test_wolfSSL_PKCS8_d2i();
     test_wolfSSL_ERR_put_error();
+    test_wolfSSL_ERR_queue_per_thread();
     test_wolfSSL_ERR_print_errors();
     test_wolfSSL_HMAC();
     test_wolfSSL_OBJ();
@@ -32138,6 +34585,7 @@ void ApiTest(void)
     test_wolfSSL_BIO_should_retry();
     test_wolfSSL_d2i_PUBKEY();
     test_wolfSSL_BIO_write();
+    test_wolfSSL_BIO_s_mem();
     test_wolfSSL_BIO_printf();
     test_wolfSSL_BIO_f_md();
     test_wolfSSL_SESSION();
@@ -32391,6 +34839,8 @@ void ApiTest(void)
     AssertIntEQ(test_wc_RsaPublicEncryptDecrypt_ex(), 0);
     AssertIntEQ(test_wc_RsaEncryptSize(), 0);
     AssertIntEQ(test_wc_RsaSSL_SignVerify(), 0);
+    AssertIntEQ(test_wc_RsaKeyReuse(), 0);
+    AssertIntEQ(test_wc_DhKeyReuse(), 0);
     AssertIntEQ(test_wc_RsaFlattenPublicKey(), 0);
     AssertIntEQ(test_RsaDecryptBoundsCheck(), 0);
     AssertIntEQ(test_wc_AesCcmSetKey(), 0);
@@ -32430,6 +34880,13 @@ void ApiTest(void)
     AssertIntEQ(test_wc_RNG_GenerateBlock_Reseed(), 0);
     #endif
     AssertIntEQ(test_wc_RNG_GenerateBlock(), 0);
+    #ifdef WC_RNG_POOL
+    AssertIntEQ(test_wc_InitRngPool(), 0);
+    #endif
+#endif
+#if defined(WOLFSSL_ASYNC_CRYPT) && defined(WOLFSSL_ASYNC_CRYPT_TEST) && \
+    defined(HAVE_ECC) && defined(HAVE_ECC_SIGN) && defined(HAVE_ECC_VERIFY)
+    AssertIntEQ(test_wc_AsyncSwDevice(), 0);
 #endif
 
     AssertIntEQ(test_wc_ed25519_make_key(), 0);
@@ -32479,6 +34936,7 @@ void ApiTest(void)
     AssertIntEQ(test_wc_ecc_pointFns(), 0);
     AssertIntEQ(test_wc_ecc_shared_secret_ssh(), 0);
     AssertIntEQ(test_wc_ecc_verify_hash_ex(), 0);
+    AssertIntEQ(test_wc_ecc_key_table(), 0);
     AssertIntEQ(test_wc_ecc_mulmod(), 0);
     AssertIntEQ(test_wc_ecc_is_valid_idx(), 0);
 
@@ -249,6 +249,11 @@
 #define BENCH_RIPEMD             0x00001000
 #define BENCH_BLAKE2B            0x00002000
 #define BENCH_BLAKE2S            0x00004000
+#define BENCH_SHAKE256           0x00008000
+#define BENCH_SHA3_256_X4        0x00010000
+#define BENCH_SHAKE256_X4        0x00020000
+#define BENCH_SHA256_MULTI       0x00040000
+#define BENCH_SHA512_MULTI       0x00080000
 
 /* MAC algorithms. */
 #define BENCH_CMAC               0x00000001
@@ -388,12 +393,14 @@ static const bench_alg bench_digest_opt[] = {
 #endif
 #ifndef NO_SHA256
     { "-sha256",             BENCH_SHA256            },
+    { "-sha256-multi",       BENCH_SHA256_MULTI      },
 #endif
 #ifdef WOLFSSL_SHA384
     { "-sha384",             BENCH_SHA384            },
 #endif
 #ifdef WOLFSSL_SHA512
     { "-sha512",             BENCH_SHA512            },
+    { "-sha512-multi",       BENCH_SHA512_MULTI      },
 #endif
 #ifdef WOLFSSL_SHA3
     { "-sha3",               BENCH_SHA3              },
@@ -409,6 +416,13 @@ static const bench_alg bench_digest_opt[] = {
     #ifndef WOLFSSL_NOSHA3_512
     { "-sha3-512",           BENCH_SHA3_512          },
     #endif
+    #ifndef WOLFSSL_NOSHA3_256
+    { "-sha3-256-x4",        BENCH_SHA3_256_X4       },
+    #endif
+    #ifdef WOLFSSL_SHAKE256
+    { "-shake256",           BENCH_SHAKE256          },
+    { "-shake256-x4",        BENCH_SHAKE256_X4       },
+    #endif
 #endif
 #ifdef WOLFSSL_RIPEMD
     { "-ripemd",             BENCH_RIPEMD            },
@@ -935,6 +949,8 @@ static int csv_header_count = 0;
 
 /* for compatibility */
 #define BENCH_SIZE bench_size
+/* number of messages passed to each multi-buffer hash call */
+#define BENCH_MULTI_MSGS 16
 
 /* globals for cipher tests */
 static THREAD_LS_T byte* bench_plain = NULL;
@@ -1259,6 +1275,43 @@ static void bench_stats_sym_finish(const char* desc, int doAsync, int count,
     TEST_SLEEP();
 }
 
+#if !defined(NO_SHA256) || defined(WOLFSSL_SHA512)
+/* msgSz is the size of each message hashed, count is the number of messages */
+static void bench_stats_msg_finish(const char* algo, int msgSz, int count,
+                                   double start, int ret)
+{
+    double total, msgSec = 0;
+    char msg[128] = {0};
+
+    total = current_time(0) - start;
+    if (total > 0)
+        msgSec = count / total;
+
+    /* format and print to terminal */
+    if (csv_format == 1) {
+        XSNPRINTF(msg, sizeof(msg), "%s multi %d,%.3f,\n", algo, msgSz,
+                  msgSec);
+    } else {
+        XSNPRINTF(msg, sizeof(msg), "%-7s multi %5d bytes %8d msgs took %5.3f"
+                  " sec, %10.0f msgs/sec\n", algo, msgSz, count, total, msgSec);
+    }
+    printf("%s", msg);
+
+    /* show errors */
+    if (ret < 0) {
+        printf("Benchmark %s multi %d failed: %d\n", algo, msgSz, ret);
+    }
+
+    /* Add to thread stats */
+    bench_stats_add(BENCH_STAT_ASYM, algo, msgSz, "multi", 0, msgSec, "msgs",
+                    ret);
+
+    (void)ret;
+
+    TEST_SLEEP();
+}
+#endif
+
 #ifdef BENCH_ASYM
 #if defined(HAVE_ECC) || !defined(WOLFSSL_RSA_PUBLIC_ONLY) || \
                                    defined(WOLFSSL_PUBLIC_MP) || !defined(NO_DH)
@@ -1581,6 +1634,9 @@ static void* benchmarks_do(void* args)
         bench_sha256(1);
     #endif
     }
+    if (bench_all || (bench_digest_algs & BENCH_SHA256_MULTI)) {
+        bench_sha256_multi();
+    }
 #endif
 #ifdef WOLFSSL_SHA384
     if (bench_all || (bench_digest_algs & BENCH_SHA384)) {
@@ -1603,6 +1659,9 @@ static void* benchmarks_do(void* args)
         bench_sha512(1);
     #endif
     }
+    if (bench_all || (bench_digest_algs & BENCH_SHA512_MULTI)) {
+        bench_sha512_multi();
+    }
 #endif
 #ifdef WOLFSSL_SHA3
     #ifndef WOLFSSL_NOSHA3_224
@@ -1649,6 +1708,19 @@ static void* benchmarks_do(void* args)
     #endif
     }
     #endif /* WOLFSSL_NOSHA3_512 */
+    #ifndef WOLFSSL_NOSHA3_256
+    if (bench_all || (bench_digest_algs & BENCH_SHA3_256_X4)) {
+        bench_sha3_256_x4();
+    }
+    #endif /* WOLFSSL_NOSHA3_256 */
+    #ifdef WOLFSSL_SHAKE256
+    if (bench_all || (bench_digest_algs & BENCH_SHAKE256)) {
+        bench_shake256();
+    }
+    if (bench_all || (bench_digest_algs & BENCH_SHAKE256_X4)) {
+        bench_shake256_x4();
+    }
+    #endif /* WOLFSSL_SHAKE256 */
 #endif
 #ifdef WOLFSSL_RIPEMD
     if (bench_all || (bench_digest_algs & BENCH_RIPEMD))
@@ -3343,6 +3415,40 @@ exit:
 
     FREE_ARRAY(digest, BENCH_MAX_PENDING, HEAP_HINT);
 }
+
+void bench_sha256_multi(void)
+{
+    static const word32 msgSz[] = { 64, 1024, 16384 };
+    const byte* data[BENCH_MULTI_MSGS];
+    word32 len[BENCH_MULTI_MSGS];
+    byte*  out[BENCH_MULTI_MSGS];
+    byte   digest[BENCH_MULTI_MSGS][WC_SHA256_DIGEST_SIZE];
+    double start;
+    int    ret = 0, i, j, count, times;
+
+    for (j = 0; j < (int)(sizeof(msgSz) / sizeof(*msgSz)); j++) {
+        if (msgSz[j] > (word32)bench_size)
+            break;
+        for (i = 0; i < BENCH_MULTI_MSGS; i++) {
+            data[i] = bench_plain;
+            len[i] = msgSz[j];
+            out[i] = digest[i];
+        }
+
+        bench_stats_start(&count, &start);
+        do {
+            for (times = 0; times < numBlocks; times++) {
+                ret = wc_Sha256HashMulti(data, len, out, BENCH_MULTI_MSGS);
+                if (ret != 0)
+                    break;
+            } /* for times */
+            count += times * BENCH_MULTI_MSGS;
+        } while (ret == 0 && bench_stats_sym_check(start));
+        bench_stats_msg_finish("SHA-256", msgSz[j], count, start, ret);
+        if (ret != 0)
+            break;
+    }
+}
 #endif
 
 #ifdef WOLFSSL_SHA384
@@ -3503,6 +3609,40 @@ exit:
 
     FREE_ARRAY(digest, BENCH_MAX_PENDING, HEAP_HINT);
 }
+
+void bench_sha512_multi(void)
+{
+    static const word32 msgSz[] = { 64, 1024, 16384 };
+    const byte* data[BENCH_MULTI_MSGS];
+    word32 len[BENCH_MULTI_MSGS];
+    byte*  out[BENCH_MULTI_MSGS];
+    byte   digest[BENCH_MULTI_MSGS][WC_SHA512_DIGEST_SIZE];
+    double start;
+    int    ret = 0, i, j, count, times;
+
+    for (j = 0; j < (int)(sizeof(msgSz) / sizeof(*msgSz)); j++) {
+        if (msgSz[j] > (word32)bench_size)
+            break;
+        for (i = 0; i < BENCH_MULTI_MSGS; i++) {
+            data[i] = bench_plain;
+            len[i] = msgSz[j];
+            out[i] = digest[i];
+        }
+
+        bench_stats_start(&count, &start);
+        do {
+            for (times = 0; times < numBlocks; times++) {
+                ret = wc_Sha512HashMulti(data, len, out, BENCH_MULTI_MSGS);
+                if (ret != 0)
+                    break;
+            } /* for times */
+            count += times * BENCH_MULTI_MSGS;
+        } while (ret == 0 && bench_stats_sym_check(start));
+        bench_stats_msg_finish("SHA-512", msgSz[j], count, start, ret);
+        if (ret != 0)
+            break;
+    }
+}
 #endif
 
 
@@ -3826,6 +3966,94 @@ exit:
     FREE_ARRAY(digest, BENCH_MAX_PENDING, HEAP_HINT);
 }
 #endif /* WOLFSSL_NOSHA3_512 */
+
+#ifndef WOLFSSL_NOSHA3_256
+void bench_sha3_256_x4(void)
+{
+    const byte* data[4];
+    word32 len[4];
+    byte*  out[4];
+    byte   digest[4][WC_SHA3_256_DIGEST_SIZE];
+    double start;
+    int    ret = 0, i, count, times;
+
+    for (i = 0; i < 4; i++) {
+        data[i] = bench_plain;
+        len[i] = BENCH_SIZE;
+        out[i] = digest[i];
+    }
+
+    bench_stats_start(&count, &start);
+    do {
+        for (times = 0; times < numBlocks; times++) {
+            ret = wc_Sha3_256Hash_x4(data, len, out);
+            if (ret != 0)
+                goto exit_sha3_256_x4;
+        } /* for times */
+        count += times;
+    } while (bench_stats_sym_check(start));
+exit_sha3_256_x4:
+    /* four messages hashed per call */
+    bench_stats_sym_finish("SHA3-256 x4", 0, count * 4, bench_size, start,
+                           ret);
+}
+#endif /* WOLFSSL_NOSHA3_256 */
+
+#ifdef WOLFSSL_SHAKE256
+void bench_shake256(void)
+{
+    wc_Shake hash;
+    byte     digest[WC_SHA3_512_DIGEST_SIZE];
+    double   start;
+    int      ret = 0, count, times;
+
+    bench_stats_start(&count, &start);
+    do {
+        for (times = 0; times < numBlocks; times++) {
+            ret = wc_InitShake256(&hash, HEAP_HINT, INVALID_DEVID);
+            ret |= wc_Shake256_Update(&hash, bench_plain, BENCH_SIZE);
+            ret |= wc_Shake256_Final(&hash, digest, sizeof(digest));
+            if (ret != 0)
+                goto exit_shake256;
+        } /* for times */
+        count += times;
+    } while (bench_stats_sym_check(start));
+exit_shake256:
+    bench_stats_sym_finish("SHAKE256", 0, count, bench_size, start, ret);
+
+    wc_Shake256_Free(&hash);
+}
+
+void bench_shake256_x4(void)
+{
+    const byte* data[4];
+    word32 len[4];
+    byte*  out[4];
+    byte   digest[4][WC_SHA3_512_DIGEST_SIZE];
+    double start;
+    int    ret = 0, i, count, times;
+
+    for (i = 0; i < 4; i++) {
+        data[i] = bench_plain;
+        len[i] = BENCH_SIZE;
+        out[i] = digest[i];
+    }
+
+    bench_stats_start(&count, &start);
+    do {
+        for (times = 0; times < numBlocks; times++) {
+            ret = wc_Shake256Hash_x4(data, len, out, WC_SHA3_512_DIGEST_SIZE);
+            if (ret != 0)
+                goto exit_shake256_x4;
+        } /* for times */
+        count += times;
+    } while (bench_stats_sym_check(start));
+exit_shake256_x4:
+    /* four messages hashed per call */
+    bench_stats_sym_finish("SHAKE256 x4", 0, count * 4, bench_size, start,
+                           ret);
+}
+#endif /* WOLFSSL_SHAKE256 */
 #endif
 
 
@@ -4266,7 +4494,7 @@ void bench_pbkdf2(void)
                             0x78, 0x57, 0x8E, 0x5a, 0x5d, 0x63, 0xcb, 0x06,
                             0x78, 0x57, 0x8E, 0x5a, 0x5d, 0x63, 0xcb, 0x06,
                             0x78, 0x57, 0x8E, 0x5a, 0x5d, 0x63, 0xcb, 0x06 };
-    byte derived[32];
+    byte derived[256];
 
     bench_stats_start(&count, &start);
     do {
@@ -4275,6 +4503,17 @@ void bench_pbkdf2(void)
         count++;
     } while (bench_stats_sym_check(start));
     bench_stats_sym_finish("PBKDF2", 32, count, 32, start, ret);
+
+    /* key spanning multiple hash outputs */
+    bench_stats_start(&count, &start);
+    do {
+        ret = wc_PBKDF2(derived, (const byte*)passwd32, (int)XSTRLEN(passwd32),
+            salt32, (int)sizeof(salt32), 1000, (int)sizeof(derived),
+            WC_SHA256);
+        count++;
+    } while (bench_stats_sym_check(start));
+    bench_stats_sym_finish("PBKDF2 256B", 32, count, (int)sizeof(derived),
+                           start, ret);
 }
 #endif /* !NO_PWDBASED */
 
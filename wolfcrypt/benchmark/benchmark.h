@@ -61,12 +61,17 @@ void bench_md5(int);
 void bench_sha(int);
 void bench_sha224(int);
 void bench_sha256(int);
+void bench_sha256_multi(void);
 void bench_sha384(int);
 void bench_sha512(int);
+void bench_sha512_multi(void);
 void bench_sha3_224(int);
 void bench_sha3_256(int);
 void bench_sha3_384(int);
 void bench_sha3_512(int);
+void bench_sha3_256_x4(void);
+void bench_shake256(void);
+void bench_shake256_x4(void);
 int  bench_ripemd(void);
 void bench_cmac(void);
 void bench_scrypt(void);
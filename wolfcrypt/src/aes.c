@@ -2801,10 +2801,15 @@ static void wc_AesDecrypt(Aes* aes, const byte* inBlock, byte* outBlock)
     }
 
     #if defined(WOLFSSL_AES_DIRECT) || defined(WOLFSSL_AES_COUNTER)
-        /* AES-CTR and AES-DIRECT need to use this for key setup, no aesni yet */
+        /* AES-CTR and AES-DIRECT need to use this for key setup */
         int wc_AesSetKeyDirect(Aes* aes, const byte* userKey, word32 keylen,
                             const byte* iv, int dir)
         {
+        #ifdef WOLFSSL_AESNI
+            /* direct and counter blocks go through wc_AesEncrypt() and
+             * wc_AesDecrypt() which handle the AES-NI key schedule */
+            return wc_AesSetKey(aes, userKey, keylen, iv, dir);
+        #else
             int ret;
 
         #ifdef WOLFSSL_IMX6_CAAM_BLOB
@@ -2831,6 +2836,7 @@ static void wc_AesDecrypt(Aes* aes, const byte* inBlock, byte* outBlock)
         #endif
 
             return ret;
+        #endif /* WOLFSSL_AESNI */
         }
     #endif /* WOLFSSL_AES_DIRECT || WOLFSSL_AES_COUNTER */
 #endif /* wc_AesSetKey block */
@@ -3560,10 +3566,10 @@ int wc_AesSetIV(Aes* aes, const byte* iv)
         #else /* WOLFSSL_ASYNC_CRYPT_TEST */
             if (wc_AsyncTestInit(&aes->asyncDev, ASYNC_TEST_AES_CBC_ENCRYPT)) {
                 WC_ASYNC_TEST* testDev = &aes->asyncDev.test;
-                testDev->aes.aes = aes;
-                testDev->aes.out = out;
-                testDev->aes.in = in;
-                testDev->aes.sz = sz;
+                testDev->args.aes.aes = aes;
+                testDev->args.aes.out = out;
+                testDev->args.aes.in = in;
+                testDev->args.aes.sz = sz;
                 return WC_PENDING_E;
             }
         #endif
@@ -3659,10 +3665,10 @@ int wc_AesSetIV(Aes* aes, const byte* iv)
         #else /* WOLFSSL_ASYNC_CRYPT_TEST */
             if (wc_AsyncTestInit(&aes->asyncDev, ASYNC_TEST_AES_CBC_DECRYPT)) {
                 WC_ASYNC_TEST* testDev = &aes->asyncDev.test;
-                testDev->aes.aes = aes;
-                testDev->aes.out = out;
-                testDev->aes.in = in;
-                testDev->aes.sz = sz;
+                testDev->args.aes.aes = aes;
+                testDev->args.aes.out = out;
+                testDev->args.aes.in = in;
+                testDev->args.aes.sz = sz;
                 return WC_PENDING_E;
             }
         #endif
@@ -3921,11 +3927,46 @@ int wc_AesSetIV(Aes* aes, const byte* iv)
             }
         }
 
+    #ifndef XTRANSFORM_AESCTRBLOCK
+        /* counter blocks encrypted per call, independent blocks let AES-NI
+         * interleave their rounds */
+        #ifndef WC_AES_CTR_BLOCKS
+            #define WC_AES_CTR_BLOCKS 16
+        #endif
+
+        /* fill keyStream with the encrypted next blocks counters */
+        static void AesCtrKeyStream(Aes* aes, byte* keyStream, word32 blocks)
+        {
+            word32 i;
+
+            for (i = 0; i < blocks; i++) {
+                XMEMCPY(keyStream + i * AES_BLOCK_SIZE, aes->reg,
+                        AES_BLOCK_SIZE);
+                IncrementAesCounter((byte*)aes->reg);
+            }
+
+        #ifdef WOLFSSL_AESNI
+            if (haveAESNI && aes->use_aesni) {
+                AES_ECB_encrypt(keyStream, keyStream, blocks * AES_BLOCK_SIZE,
+                                (byte*)aes->key, aes->rounds);
+                return;
+            }
+        #endif
+            for (i = 0; i < blocks; i++) {
+                wc_AesEncrypt(aes, keyStream + i * AES_BLOCK_SIZE,
+                              keyStream + i * AES_BLOCK_SIZE);
+            }
+        }
+    #endif /* !XTRANSFORM_AESCTRBLOCK */
+
         /* Software AES - CTR Encrypt */
         int wc_AesCtrEncrypt(Aes* aes, byte* out, const byte* in, word32 sz)
         {
             byte* tmp;
-            byte scratch[AES_BLOCK_SIZE];
+        #ifndef XTRANSFORM_AESCTRBLOCK
+            ALIGN16 byte keyStream[WC_AES_CTR_BLOCKS * AES_BLOCK_SIZE];
+            word32 blocks;
+        #endif
 
             if (aes == NULL || out == NULL || in == NULL) {
                 return BAD_FUNC_ARG;
@@ -3940,14 +3981,9 @@ int wc_AesSetIV(Aes* aes, const byte* iv)
             }
 
             /* do as many block size ops as possible */
+        #ifdef XTRANSFORM_AESCTRBLOCK
             while (sz >= AES_BLOCK_SIZE) {
-            #ifdef XTRANSFORM_AESCTRBLOCK
                 XTRANSFORM_AESCTRBLOCK(aes, out, in);
-            #else
-                wc_AesEncrypt(aes, (byte*)aes->reg, scratch);
-                xorbuf(scratch, in, AES_BLOCK_SIZE);
-                XMEMCPY(out, scratch, AES_BLOCK_SIZE);
-            #endif
                 IncrementAesCounter((byte*)aes->reg);
 
                 out += AES_BLOCK_SIZE;
@@ -3955,7 +3991,24 @@ int wc_AesSetIV(Aes* aes, const byte* iv)
                 sz  -= AES_BLOCK_SIZE;
                 aes->left = 0;
             }
-            ForceZero(scratch, AES_BLOCK_SIZE);
+        #else
+            if (sz >= AES_BLOCK_SIZE)
+                aes->left = 0;
+            while (sz >= AES_BLOCK_SIZE) {
+                blocks = sz / AES_BLOCK_SIZE;
+                if (blocks > WC_AES_CTR_BLOCKS)
+                    blocks = WC_AES_CTR_BLOCKS;
+
+                AesCtrKeyStream(aes, keyStream, blocks);
+                xorbuf(keyStream, in, blocks * AES_BLOCK_SIZE);
+                XMEMCPY(out, keyStream, blocks * AES_BLOCK_SIZE);
+
+                out += blocks * AES_BLOCK_SIZE;
+                in  += blocks * AES_BLOCK_SIZE;
+                sz  -= blocks * AES_BLOCK_SIZE;
+            }
+            ForceZero(keyStream, sizeof(keyStream));
+        #endif
 
             /* handle non block size remaining and store unused byte count in left */
             if (sz) {
@@ -6260,16 +6313,16 @@ int wc_AesGcmEncrypt(Aes* aes, byte* out, const byte* in, word32 sz,
     #else /* WOLFSSL_ASYNC_CRYPT_TEST */
         if (wc_AsyncTestInit(&aes->asyncDev, ASYNC_TEST_AES_GCM_ENCRYPT)) {
             WC_ASYNC_TEST* testDev = &aes->asyncDev.test;
-            testDev->aes.aes = aes;
-            testDev->aes.out = out;
-            testDev->aes.in = in;
-            testDev->aes.sz = sz;
-            testDev->aes.iv = iv;
-            testDev->aes.ivSz = ivSz;
-            testDev->aes.authTag = authTag;
-            testDev->aes.authTagSz = authTagSz;
-            testDev->aes.authIn = authIn;
-            testDev->aes.authInSz = authInSz;
+            testDev->args.aes.aes = aes;
+            testDev->args.aes.out = out;
+            testDev->args.aes.in = in;
+            testDev->args.aes.sz = sz;
+            testDev->args.aes.iv = iv;
+            testDev->args.aes.ivSz = ivSz;
+            testDev->args.aes.authTag = authTag;
+            testDev->args.aes.authTagSz = authTagSz;
+            testDev->args.aes.authIn = authIn;
+            testDev->args.aes.authInSz = authInSz;
             return WC_PENDING_E;
         }
     #endif
@@ -6714,16 +6767,16 @@ int wc_AesGcmDecrypt(Aes* aes, byte* out, const byte* in, word32 sz,
     #else /* WOLFSSL_ASYNC_CRYPT_TEST */
         if (wc_AsyncTestInit(&aes->asyncDev, ASYNC_TEST_AES_GCM_DECRYPT)) {
             WC_ASYNC_TEST* testDev = &aes->asyncDev.test;
-            testDev->aes.aes = aes;
-            testDev->aes.out = out;
-            testDev->aes.in = in;
-            testDev->aes.sz = sz;
-            testDev->aes.iv = iv;
-            testDev->aes.ivSz = ivSz;
-            testDev->aes.authTag = (byte*)authTag;
-            testDev->aes.authTagSz = authTagSz;
-            testDev->aes.authIn = authIn;
-            testDev->aes.authInSz = authInSz;
+            testDev->args.aes.aes = aes;
+            testDev->args.aes.out = out;
+            testDev->args.aes.in = in;
+            testDev->args.aes.sz = sz;
+            testDev->args.aes.iv = iv;
+            testDev->args.aes.ivSz = ivSz;
+            testDev->args.aes.authTag = (byte*)authTag;
+            testDev->args.aes.authTagSz = authTagSz;
+            testDev->args.aes.authIn = authIn;
+            testDev->args.aes.authInSz = authInSz;
             return WC_PENDING_E;
         }
     #endif
@@ -2580,6 +2580,7 @@ int wc_RsaPrivateKeyDecode(const byte* input, word32* inOutIdx, RsaKey* key,
     if (GetMyVersion(input, inOutIdx, &version, inSz) < 0)
         return ASN_PARSE_E;
 
+    wc_RsaFreeCache(key);
     key->type = RSA_PRIVATE;
 
     if (GetInt(&key->n,  input, inOutIdx, inSz) < 0 ||
@@ -4348,6 +4349,7 @@ int wc_RsaPublicKeyDecodeRaw(const byte* n, word32 nSz, const byte* e,
     if (n == NULL || e == NULL || key == NULL)
         return BAD_FUNC_ARG;
 
+    wc_RsaFreeCache(key);
     key->type = RSA_PUBLIC;
 
     if (mp_init(&key->n) != MP_OKAY)
@@ -4415,6 +4417,8 @@ int wc_DhKeyDecode(const byte* input, word32* inOutIdx, DhKey* key, word32 inSz)
     temp = *inOutIdx;
     #endif
 
+    wc_DhFreeCache(key);
+
     /* Assume input started after 1.2.840.113549.1.3.1 dhKeyAgreement */
     if (GetInt(&key->p,  input, inOutIdx, inSz) < 0 ||
         GetInt(&key->g,  input, inOutIdx, inSz) < 0) {
@@ -7157,6 +7161,14 @@ static int ConfirmSignature(SignatureCtx* sigCtx,
                         WOLFSSL_MSG("ASN Key import error ECC");
                         goto exit_cs;
                     }
+                #ifdef WOLFSSL_ECC_KEY_TABLE
+                    if (sigCtx->eccTable != NULL &&
+                            wc_ecc_set_key_table(sigCtx->key.ecc,
+                                                 sigCtx->eccTable) != 0) {
+                        /* verify without the table */
+                        WOLFSSL_MSG("Signer ECC table does not match key");
+                    }
+                #endif
                 #ifdef WOLFSSL_ASYNC_CRYPT
                     sigCtx->asyncDev = &sigCtx->key.ecc->asyncDev;
                 #endif
@@ -8871,6 +8883,12 @@ int ParseCert(DecodedCert* cert, int type, int verify, void* cm)
     #ifndef NO_SKID
         Signer* GetCAByName(void* signers, byte* hash);
     #endif
+    #ifdef WOLFSSL_CERT_VERIFY_CACHE
+        int  CertVerifyCache_Find(void* cm, const byte* certHash,
+                                  const Signer* signer);
+        void CertVerifyCache_Add(void* cm, const byte* certHash,
+                                 const Signer* signer);
+    #endif
 #ifdef __cplusplus
     }
 #endif
@@ -9198,6 +9216,9 @@ static int CheckCertSignature_ex(const byte* cert, word32 certSz, void* heap,
                                cert + idx, len, signatureOID, NULL);
         }
         else {
+        #if defined(HAVE_ECC) && defined(WOLFSSL_ECC_KEY_TABLE)
+            sigCtx->eccTable = ca->eccTable;
+        #endif
             ret = ConfirmSignature(sigCtx, cert + tbsCertIdx,
                                sigIndex - tbsCertIdx,
                                ca->publicKey, ca->pubKeySize, ca->keyOID,
@@ -9494,18 +9515,38 @@ int ParseCertRelative(DecodedCert* cert, int type, int verify, void* cm)
         if (cert->ca) {
             if (verify == VERIFY || verify == VERIFY_OCSP ||
                                                  verify == VERIFY_SKIP_DATE) {
-                /* try to confirm/verify signature */
-                if ((ret = ConfirmSignature(&cert->sigCtx,
-                        cert->source + cert->certBegin,
-                        cert->sigIndex - cert->certBegin,
-                        cert->ca->publicKey, cert->ca->pubKeySize,
-                        cert->ca->keyOID, cert->signature,
-                        cert->sigLength, cert->signatureOID,
-                        tsip_encRsaKeyIdx)) != 0) {
-                    if (ret != 0 && ret != WC_PENDING_E) {
-                        WOLFSSL_MSG("Confirm signature failed");
-                    }
+            #ifdef WOLFSSL_CERT_VERIFY_CACHE
+                byte certHash[WC_SHA256_DIGEST_SIZE];
+
+                /* same DER verified by the same signer key before */
+                if ((ret = wc_Sha256Hash(cert->source, cert->maxIdx,
+                                                           certHash)) != 0)
                     return ret;
+                if (CertVerifyCache_Find(cm, certHash, cert->ca)) {
+                    WOLFSSL_MSG("Signature verified before, skipping");
+                }
+                else
+            #endif
+                {
+                #if defined(HAVE_ECC) && defined(WOLFSSL_ECC_KEY_TABLE)
+                    cert->sigCtx.eccTable = cert->ca->eccTable;
+                #endif
+                    /* try to confirm/verify signature */
+                    if ((ret = ConfirmSignature(&cert->sigCtx,
+                            cert->source + cert->certBegin,
+                            cert->sigIndex - cert->certBegin,
+                            cert->ca->publicKey, cert->ca->pubKeySize,
+                            cert->ca->keyOID, cert->signature,
+                            cert->sigLength, cert->signatureOID,
+                            tsip_encRsaKeyIdx)) != 0) {
+                        if (ret != 0 && ret != WC_PENDING_E) {
+                            WOLFSSL_MSG("Confirm signature failed");
+                        }
+                        return ret;
+                    }
+                #ifdef WOLFSSL_CERT_VERIFY_CACHE
+                    CertVerifyCache_Add(cm, certHash, cert->ca);
+                #endif
                 }
             }
         #ifndef IGNORE_NAME_CONSTRAINTS
@@ -9571,6 +9612,9 @@ void FreeSigner(Signer* signer, void* heap)
 #endif
 #ifdef WOLFSSL_SIGNER_DER_CERT
     FreeDer(&signer->derCert);
+#endif
+#if defined(HAVE_ECC) && defined(WOLFSSL_ECC_KEY_TABLE)
+    wc_ecc_key_table_free(signer->eccTable);
 #endif
     XFREE(signer, heap, DYNAMIC_TYPE_SIGNER);
 
@@ -9578,6 +9622,53 @@ void FreeSigner(Signer* signer, void* heap)
 }
 
 
+#if defined(HAVE_ECC) && defined(WOLFSSL_ECC_KEY_TABLE)
+/* Pre-compute a verification table for an ECC signer's public key.
+ * Signatures made by the signer are verified with the table from then on.
+ * returns 0 on success or when the signer does not have an ECC key */
+int MakeSignerEccTable(Signer* signer, void* heap)
+{
+    int ret;
+    word32 idx = 0;
+#ifdef WOLFSSL_SMALL_STACK
+    ecc_key* key;
+#else
+    ecc_key  key[1];
+#endif
+
+    if (signer == NULL)
+        return BAD_FUNC_ARG;
+    if (signer->keyOID != ECDSAk || signer->eccTable != NULL)
+        return 0;
+
+#ifdef WOLFSSL_SMALL_STACK
+    key = (ecc_key*)XMALLOC(sizeof(ecc_key), heap, DYNAMIC_TYPE_ECC);
+    if (key == NULL)
+        return MEMORY_E;
+#endif
+
+    ret = wc_ecc_init_ex(key, heap, INVALID_DEVID);
+    if (ret == 0) {
+        ret = wc_EccPublicKeyDecode(signer->publicKey, &idx, key,
+                                    signer->pubKeySize);
+        if (ret == 0)
+            ret = wc_ecc_key_table_new(key, &signer->eccTable, heap);
+        wc_ecc_free(key);
+    }
+    if (ret == NOT_COMPILED_IN) {
+        /* no table support for the signer's curve */
+        ret = 0;
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(key, heap, DYNAMIC_TYPE_ECC);
+#endif
+
+    return ret;
+}
+#endif /* HAVE_ECC && WOLFSSL_ECC_KEY_TABLE */
+
+
 /* Free the whole singer table with number of rows */
 void FreeSignerTable(Signer** table, int rows, void* heap)
 {
@@ -16679,6 +16770,9 @@ static int DecodeBasicOcspResponse(byte* source, word32* ioIndex,
         if (ca) {
             SignatureCtx sigCtx;
             InitSignatureCtx(&sigCtx, heap, INVALID_DEVID);
+        #if defined(HAVE_ECC) && defined(WOLFSSL_ECC_KEY_TABLE)
+            sigCtx.eccTable = ca->eccTable;
+        #endif
 
             /* ConfirmSignature is blocking here */
             sigValid = ConfirmSignature(&sigCtx, resp->response,
@@ -17203,6 +17297,9 @@ int VerifyCRL_Signature(SignatureCtx* sigCtx, const byte* toBeSigned,
 #endif /* IGNORE_KEY_EXTENSIONS */
 
     InitSignatureCtx(sigCtx, heap, INVALID_DEVID);
+#if defined(HAVE_ECC) && defined(WOLFSSL_ECC_KEY_TABLE)
+    sigCtx->eccTable = ca->eccTable;
+#endif
     if (ConfirmSignature(sigCtx, toBeSigned, tbsSz, ca->publicKey,
                          ca->pubKeySize, ca->keyOID, signature, sigSz,
                          signatureOID, NULL) != 0) {
@@ -0,0 +1,704 @@
+/* async.c
+ *
+ * Copyright (C) 2006-2020 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+
+
+#ifdef HAVE_CONFIG_H
+    #include <config.h>
+#endif
+
+#include <wolfssl/wolfcrypt/settings.h>
+
+#ifdef WOLFSSL_ASYNC_CRYPT
+
+#include <wolfssl/wolfcrypt/async.h>
+#include <wolfssl/wolfcrypt/error-crypt.h>
+#include <wolfssl/wolfcrypt/logging.h>
+#ifndef NO_RSA
+    #include <wolfssl/wolfcrypt/rsa.h>
+#endif
+#ifdef HAVE_ECC
+    #include <wolfssl/wolfcrypt/ecc.h>
+#endif
+#ifndef NO_DH
+    #include <wolfssl/wolfcrypt/dh.h>
+#endif
+#ifndef NO_AES
+    #include <wolfssl/wolfcrypt/aes.h>
+#endif
+#ifndef NO_DES3
+    #include <wolfssl/wolfcrypt/des3.h>
+#endif
+
+#ifndef WC_NO_ASYNC_THREADING
+    #include <sched.h>
+    #include <unistd.h>
+#endif
+
+/* A deferred operation is recorded by wc_AsyncTestInit() in asyncDev->test
+ * and replayed here by calling the public API again. The replay reaches
+ * wc_AsyncTestInit() with test.type still set, so it runs synchronously. */
+static int wolfAsync_DoSw(WC_ASYNC_DEV* asyncDev)
+{
+    int ret = 0;
+    WC_ASYNC_TEST* testDev = &asyncDev->test;
+
+    switch (testDev->type) {
+        case ASYNC_TEST_NONE:
+            break;
+
+    #if !defined(NO_RSA) && defined(WC_ASYNC_ENABLE_RSA)
+        case ASYNC_TEST_RSA_FUNC:
+            ret = wc_RsaFunction(testDev->args.rsaFunc.in,
+                testDev->args.rsaFunc.inSz, testDev->args.rsaFunc.out,
+                testDev->args.rsaFunc.outSz, testDev->args.rsaFunc.type,
+                testDev->args.rsaFunc.key, testDev->args.rsaFunc.rng);
+            break;
+        #if defined(WOLFSSL_KEY_GEN) && defined(WC_ASYNC_ENABLE_RSA_KEYGEN)
+        case ASYNC_TEST_RSA_MAKE:
+            ret = wc_MakeRsaKey(testDev->args.rsaMake.key,
+                testDev->args.rsaMake.size, testDev->args.rsaMake.e,
+                testDev->args.rsaMake.rng);
+            break;
+        #endif
+    #endif /* !NO_RSA && WC_ASYNC_ENABLE_RSA */
+
+    #if defined(HAVE_ECC) && defined(WC_ASYNC_ENABLE_ECC)
+        case ASYNC_TEST_ECC_MAKE:
+            ret = wc_ecc_make_key_ex(testDev->args.eccMake.rng,
+                testDev->args.eccMake.size, testDev->args.eccMake.key,
+                testDev->args.eccMake.curve_id);
+            break;
+        #ifdef HAVE_ECC_SIGN
+        case ASYNC_TEST_ECC_SIGN:
+            ret = wc_ecc_sign_hash_ex(testDev->args.eccSign.in,
+                testDev->args.eccSign.inSz, testDev->args.eccSign.rng,
+                testDev->args.eccSign.key, (mp_int*)testDev->args.eccSign.r,
+                (mp_int*)testDev->args.eccSign.s);
+            break;
+        #endif
+        #ifdef HAVE_ECC_VERIFY
+        case ASYNC_TEST_ECC_VERIFY:
+            ret = wc_ecc_verify_hash_ex((mp_int*)testDev->args.eccVerify.r,
+                (mp_int*)testDev->args.eccVerify.s,
+                testDev->args.eccVerify.hash, testDev->args.eccVerify.hashlen,
+                testDev->args.eccVerify.stat, testDev->args.eccVerify.key);
+            break;
+        #endif
+        #ifdef HAVE_ECC_DHE
+        case ASYNC_TEST_ECC_SHARED_SEC:
+            ret = wc_ecc_shared_secret_gen(
+                testDev->args.eccSharedSec.private_key,
+                (ecc_point*)testDev->args.eccSharedSec.public_point,
+                testDev->args.eccSharedSec.out,
+                testDev->args.eccSharedSec.outLen);
+            break;
+        #endif
+    #endif /* HAVE_ECC && WC_ASYNC_ENABLE_ECC */
+
+    #if !defined(NO_DH) && defined(WC_ASYNC_ENABLE_DH)
+        case ASYNC_TEST_DH_GEN:
+            ret = wc_DhGenerateKeyPair(testDev->args.dhGen.key,
+                testDev->args.dhGen.rng, testDev->args.dhGen.priv,
+                testDev->args.dhGen.privSz, testDev->args.dhGen.pub,
+                testDev->args.dhGen.pubSz);
+            break;
+        case ASYNC_TEST_DH_AGREE:
+            ret = wc_DhAgree(testDev->args.dhAgree.key,
+                testDev->args.dhAgree.agree, testDev->args.dhAgree.agreeSz,
+                testDev->args.dhAgree.priv, testDev->args.dhAgree.privSz,
+                testDev->args.dhAgree.otherPub, testDev->args.dhAgree.pubSz);
+            break;
+    #endif /* !NO_DH && WC_ASYNC_ENABLE_DH */
+
+    #if !defined(NO_AES) && defined(WC_ASYNC_ENABLE_AES)
+        #ifdef HAVE_AES_CBC
+        case ASYNC_TEST_AES_CBC_ENCRYPT:
+            ret = wc_AesCbcEncrypt(testDev->args.aes.aes, testDev->args.aes.out,
+                testDev->args.aes.in, testDev->args.aes.sz);
+            break;
+            #ifdef HAVE_AES_DECRYPT
+        case ASYNC_TEST_AES_CBC_DECRYPT:
+            ret = wc_AesCbcDecrypt(testDev->args.aes.aes, testDev->args.aes.out,
+                testDev->args.aes.in, testDev->args.aes.sz);
+            break;
+            #endif
+        #endif /* HAVE_AES_CBC */
+        #ifdef HAVE_AESGCM
+        case ASYNC_TEST_AES_GCM_ENCRYPT:
+            ret = wc_AesGcmEncrypt(testDev->args.aes.aes, testDev->args.aes.out,
+                testDev->args.aes.in, testDev->args.aes.sz,
+                testDev->args.aes.iv, testDev->args.aes.ivSz,
+                (byte*)testDev->args.aes.authTag, testDev->args.aes.authTagSz,
+                testDev->args.aes.authIn, testDev->args.aes.authInSz);
+            break;
+            #ifdef HAVE_AES_DECRYPT
+        case ASYNC_TEST_AES_GCM_DECRYPT:
+            ret = wc_AesGcmDecrypt(testDev->args.aes.aes, testDev->args.aes.out,
+                testDev->args.aes.in, testDev->args.aes.sz,
+                testDev->args.aes.iv, testDev->args.aes.ivSz,
+                testDev->args.aes.authTag, testDev->args.aes.authTagSz,
+                testDev->args.aes.authIn, testDev->args.aes.authInSz);
+            break;
+            #endif
+        #endif /* HAVE_AESGCM */
+    #endif /* !NO_AES && WC_ASYNC_ENABLE_AES */
+
+    #if !defined(NO_DES3) && defined(WC_ASYNC_ENABLE_3DES)
+        case ASYNC_TEST_DES3_CBC_ENCRYPT:
+            ret = wc_Des3_CbcEncrypt(testDev->args.des.des,
+                testDev->args.des.out, testDev->args.des.in,
+                testDev->args.des.sz);
+            break;
+        case ASYNC_TEST_DES3_CBC_DECRYPT:
+            ret = wc_Des3_CbcDecrypt(testDev->args.des.des,
+                testDev->args.des.out, testDev->args.des.in,
+                testDev->args.des.sz);
+            break;
+    #endif /* !NO_DES3 && WC_ASYNC_ENABLE_3DES */
+
+        default:
+            WOLFSSL_MSG("Async operation not supported by software device");
+            ret = NOT_COMPILED_IN;
+            break;
+    }
+
+    return ret;
+}
+
+
+#ifndef WC_NO_ASYNC_THREADING
+
+/* Worker pool shared by every open device. Jobs are WC_ASYNC_DEV objects
+ * linked through swNext. A job is queued, then running once a worker or
+ * wc_AsyncWait() takes it, so it only runs once. It is finished when its
+ * test.type is cleared. swState and test.type of a submitted job are only
+ * written with the pool lock held. */
+typedef struct AsyncPool {
+    pthread_mutex_t lock;
+    pthread_cond_t  jobCond;    /* signalled when a job is queued */
+    pthread_cond_t  doneCond;   /* signalled when a job completes */
+    WC_ASYNC_DEV*   head;
+    WC_ASYNC_DEV*   tail;
+    pthread_t       threads[WC_ASYNC_THREAD_MAX];
+    int             threadCount;
+    int             refCount;   /* number of open devices */
+    int             stop;
+} AsyncPool;
+
+static AsyncPool asyncPool = {
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER,
+    PTHREAD_COND_INITIALIZER, NULL, NULL, { 0 }, 0, 0, 0
+};
+
+static void* AsyncPoolWorker(void* arg)
+{
+    WC_ASYNC_DEV* asyncDev;
+    int ret;
+
+    (void)arg;
+
+    pthread_mutex_lock(&asyncPool.lock);
+    for (;;) {
+        while (asyncPool.head == NULL && !asyncPool.stop) {
+            pthread_cond_wait(&asyncPool.jobCond, &asyncPool.lock);
+        }
+        /* drain queued jobs before honouring stop */
+        asyncDev = asyncPool.head;
+        if (asyncDev == NULL) {
+            break;
+        }
+        asyncPool.head = asyncDev->swNext;
+        if (asyncPool.head == NULL) {
+            asyncPool.tail = NULL;
+        }
+        asyncDev->swNext = NULL;
+        asyncDev->swState = WC_ASYNC_SW_RUNNING;
+        pthread_mutex_unlock(&asyncPool.lock);
+
+        ret = wolfAsync_DoSw(asyncDev);
+
+        pthread_mutex_lock(&asyncPool.lock);
+        asyncDev->swRet = ret;
+        asyncDev->swState = WC_ASYNC_SW_IDLE;
+        asyncDev->test.type = ASYNC_TEST_NONE;
+        pthread_cond_broadcast(&asyncPool.doneCond);
+    }
+    pthread_mutex_unlock(&asyncPool.lock);
+
+    return NULL;
+}
+
+/* Take a job back off the queue, must be called with the pool locked */
+static void AsyncPoolUnlink(WC_ASYNC_DEV* asyncDev)
+{
+    WC_ASYNC_DEV* prev = NULL;
+    WC_ASYNC_DEV* cur;
+
+    for (cur = asyncPool.head; cur != NULL; prev = cur, cur = cur->swNext) {
+        if (cur == asyncDev) {
+            if (prev == NULL) {
+                asyncPool.head = cur->swNext;
+            }
+            else {
+                prev->swNext = cur->swNext;
+            }
+            if (asyncPool.tail == cur) {
+                asyncPool.tail = prev;
+            }
+            cur->swNext = NULL;
+            break;
+        }
+    }
+}
+
+/* must be called with the pool locked */
+static void AsyncPoolJoin(void)
+{
+    int i, count = asyncPool.threadCount;
+
+    asyncPool.stop = 1;
+    pthread_cond_broadcast(&asyncPool.jobCond);
+    pthread_mutex_unlock(&asyncPool.lock);
+    for (i = 0; i < count; i++) {
+        pthread_join(asyncPool.threads[i], NULL);
+    }
+    pthread_mutex_lock(&asyncPool.lock);
+    asyncPool.threadCount = 0;
+    asyncPool.stop = 0;
+}
+
+#endif /* !WC_NO_ASYNC_THREADING */
+
+/* Hand a deferred operation to the worker pool, or run it in place when no
+ * pool is running. */
+static void wolfAsync_Submit(WC_ASYNC_DEV* asyncDev)
+{
+    int ret;
+
+#ifndef WC_NO_ASYNC_THREADING
+    pthread_mutex_lock(&asyncPool.lock);
+    if (asyncDev->test.type == ASYNC_TEST_NONE) {
+        /* nothing was deferred */
+        asyncDev->swRet = 0;
+        pthread_mutex_unlock(&asyncPool.lock);
+        return;
+    }
+    if (asyncPool.threadCount > 0) {
+        asyncDev->swNext = NULL;
+        if (asyncPool.tail == NULL) {
+            asyncPool.head = asyncDev;
+        }
+        else {
+            asyncPool.tail->swNext = asyncDev;
+        }
+        asyncPool.tail = asyncDev;
+        asyncDev->swState = WC_ASYNC_SW_QUEUED;
+        pthread_cond_signal(&asyncPool.jobCond);
+        pthread_mutex_unlock(&asyncPool.lock);
+        return;
+    }
+    pthread_mutex_unlock(&asyncPool.lock);
+#endif
+
+    ret = wolfAsync_DoSw(asyncDev);
+    asyncDev->swRet = ret;
+    asyncDev->test.type = ASYNC_TEST_NONE;
+}
+
+/* Returns 1 once the worker has finished the operation */
+static int wolfAsync_IsDone(WC_ASYNC_DEV* asyncDev)
+{
+    int done;
+
+#ifndef WC_NO_ASYNC_THREADING
+    pthread_mutex_lock(&asyncPool.lock);
+#endif
+    done = (asyncDev->test.type == ASYNC_TEST_NONE);
+#ifndef WC_NO_ASYNC_THREADING
+    pthread_mutex_unlock(&asyncPool.lock);
+#endif
+
+    return done;
+}
+
+
+int wolfAsync_HardwareStart(void)
+{
+    int ret = 0;
+#ifndef WC_NO_ASYNC_THREADING
+    int i, count;
+
+    pthread_mutex_lock(&asyncPool.lock);
+    if (asyncPool.refCount++ == 0) {
+        count = WC_ASYNC_THREAD_COUNT;
+        if (count <= 0) {
+            count = wc_AsyncGetNumberOfCpus();
+        }
+        if (count > WC_ASYNC_THREAD_MAX) {
+            count = WC_ASYNC_THREAD_MAX;
+        }
+        for (i = 0; i < count; i++) {
+            if (pthread_create(&asyncPool.threads[i], NULL, AsyncPoolWorker,
+                                                                NULL) != 0) {
+                break;
+            }
+            asyncPool.threadCount++;
+        }
+        if (asyncPool.threadCount == 0) {
+            asyncPool.refCount--;
+            ret = WC_HW_E;
+        }
+    }
+    pthread_mutex_unlock(&asyncPool.lock);
+#endif
+
+    return ret;
+}
+
+void wolfAsync_HardwareStop(void)
+{
+#ifndef WC_NO_ASYNC_THREADING
+    pthread_mutex_lock(&asyncPool.lock);
+    if (asyncPool.refCount > 0 && --asyncPool.refCount == 0) {
+        AsyncPoolJoin();
+    }
+    pthread_mutex_unlock(&asyncPool.lock);
+#endif
+}
+
+int wolfAsync_DevOpen(int* devId)
+{
+    int ret;
+
+    if (devId == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    ret = wolfAsync_HardwareStart();
+    *devId = (ret == 0) ? WOLFSSL_ASYNC_DEVID : INVALID_DEVID;
+
+    return ret;
+}
+
+int wolfAsync_DevOpenThread(int* devId, void* threadId)
+{
+    /* the pool is shared, workers are not bound to the caller */
+    (void)threadId;
+
+    return wolfAsync_DevOpen(devId);
+}
+
+void wolfAsync_DevClose(int* devId)
+{
+    if (devId != NULL && *devId == WOLFSSL_ASYNC_DEVID) {
+        wolfAsync_HardwareStop();
+        *devId = INVALID_DEVID;
+    }
+}
+
+
+int wolfAsync_DevCtxInit(WC_ASYNC_DEV* asyncDev, word32 marker, void* heap,
+    int devId)
+{
+    if (asyncDev == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    XMEMSET(asyncDev, 0, sizeof(WC_ASYNC_DEV));
+    asyncDev->heap = heap;
+    /* objects not bound to the software device stay synchronous */
+    if (devId == WOLFSSL_ASYNC_DEVID) {
+        asyncDev->marker = marker;
+    }
+
+    return 0;
+}
+
+void wolfAsync_DevCtxFree(WC_ASYNC_DEV* asyncDev, word32 marker)
+{
+    if (asyncDev == NULL || asyncDev->marker != marker) {
+        return;
+    }
+
+#ifndef WC_NO_ASYNC_THREADING
+    /* never release an object a worker is still using */
+    pthread_mutex_lock(&asyncPool.lock);
+    while (asyncDev->event.state == WOLF_EVENT_STATE_PENDING &&
+                                    asyncDev->test.type != ASYNC_TEST_NONE) {
+        pthread_cond_wait(&asyncPool.doneCond, &asyncPool.lock);
+    }
+    pthread_mutex_unlock(&asyncPool.lock);
+#endif
+
+    asyncDev->marker = WOLFSSL_ASYNC_MARKER_INVALID;
+    asyncDev->test.type = ASYNC_TEST_NONE;
+}
+
+int wolfAsync_DevCopy(WC_ASYNC_DEV* src, WC_ASYNC_DEV* dst)
+{
+    if (src == NULL || dst == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    /* the copy shares the device but none of the in-flight state */
+    dst->marker = src->marker;
+    dst->heap = src->heap;
+    dst->swRet = 0;
+    dst->swState = WC_ASYNC_SW_IDLE;
+    dst->swNext = NULL;
+    XMEMSET(&dst->event, 0, sizeof(WOLF_EVENT));
+    XMEMSET(&dst->test, 0, sizeof(WC_ASYNC_TEST));
+
+    return 0;
+}
+
+
+int wolfAsync_EventInit(WOLF_EVENT* event, WOLF_EVENT_TYPE type,
+    void* context, word32 flags)
+{
+    int ret;
+
+    ret = wolfEvent_Init(event, type, context);
+    if (ret == 0) {
+        event->flags = flags;
+        event->dev.async = (WC_ASYNC_DEV*)event;
+        event->state = WOLF_EVENT_STATE_READY;
+    }
+
+    return ret;
+}
+
+int wolfAsync_EventPoll(WOLF_EVENT* event, WOLF_EVENT_FLAG flags)
+{
+    WC_ASYNC_DEV* asyncDev;
+
+    (void)flags;
+
+    if (event == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    asyncDev = event->dev.async;
+    if (asyncDev != NULL && event->state == WOLF_EVENT_STATE_PENDING &&
+                                                wolfAsync_IsDone(asyncDev)) {
+        event->ret = asyncDev->swRet;
+        event->state = WOLF_EVENT_STATE_DONE;
+    }
+
+    return 0;
+}
+
+int wolfAsync_EventPop(WOLF_EVENT* event, WOLF_EVENT_TYPE type)
+{
+    int ret;
+
+    if (event == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    if (event->type != type || event->state == WOLF_EVENT_STATE_READY) {
+        ret = WC_NOT_PENDING_E;
+    }
+    else if (event->state == WOLF_EVENT_STATE_DONE) {
+        ret = event->ret;
+        event->state = WOLF_EVENT_STATE_READY;
+    }
+    else {
+        ret = WC_PENDING_E;
+    }
+
+    return ret;
+}
+
+int wolfAsync_EventQueuePush(WOLF_EVENT_QUEUE* queue, WOLF_EVENT* event)
+{
+    int ret;
+
+    if (queue == NULL || event == NULL || event->dev.async == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    event->state = WOLF_EVENT_STATE_PENDING;
+    ret = wolfEventQueue_Push(queue, event);
+    if (ret == 0) {
+        wolfAsync_Submit(event->dev.async);
+    }
+    else {
+        event->state = WOLF_EVENT_STATE_READY;
+    }
+
+    return ret;
+}
+
+int wolfAsync_EventQueuePoll(WOLF_EVENT_QUEUE* queue, void* context_filter,
+    WOLF_EVENT** events, int maxEvents, WOLF_EVENT_FLAG flags, int* eventCount)
+{
+    return wolfEventQueue_Poll(queue, context_filter, events, maxEvents, flags,
+        eventCount);
+}
+
+
+/* Called by an algorithm before deferring an operation. Returns 1 when the
+ * caller should record its arguments and return WC_PENDING_E, 0 when the
+ * operation is being replayed and must run synchronously. */
+int wc_AsyncTestInit(WC_ASYNC_DEV* asyncDev, int type)
+{
+    if (asyncDev == NULL || asyncDev->test.type != ASYNC_TEST_NONE) {
+        return 0;
+    }
+
+    asyncDev->test.type = type;
+
+    return 1;
+}
+
+int wc_AsyncHandle(WC_ASYNC_DEV* asyncDev, WOLF_EVENT_QUEUE* queue,
+    word32 flags)
+{
+    int ret;
+
+    if (asyncDev == NULL || queue == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    ret = wolfAsync_EventInit(&asyncDev->event, WOLF_EVENT_TYPE_ASYNC_WOLFCRYPT,
+        asyncDev, flags);
+    if (ret == 0) {
+        ret = wolfAsync_EventQueuePush(queue, &asyncDev->event);
+    }
+
+    return ret;
+}
+
+/* Complete a pending operation. One that hasn't been handed to a worker, or
+ * is still queued for one, runs on the calling thread. Blocking callers gain
+ * nothing from a worker. One a worker has taken is waited for. The replay
+ * on a worker never returns WC_PENDING_E, so a worker doesn't wait here. */
+int wc_AsyncWait(int ret, WC_ASYNC_DEV* asyncDev, word32 flags)
+{
+    int run = 1;
+    int submitted = 0;
+
+    (void)flags;
+
+    if (ret != WC_PENDING_E) {
+        return ret;
+    }
+    if (asyncDev == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+#ifndef WC_NO_ASYNC_THREADING
+    pthread_mutex_lock(&asyncPool.lock);
+    if (asyncDev->swState == WC_ASYNC_SW_QUEUED) {
+        /* claim it before a worker does */
+        AsyncPoolUnlink(asyncDev);
+        asyncDev->swState = WC_ASYNC_SW_RUNNING;
+        submitted = 1;
+    }
+    else if (asyncDev->swState == WC_ASYNC_SW_RUNNING) {
+        while (asyncDev->swState != WC_ASYNC_SW_IDLE) {
+            pthread_cond_wait(&asyncPool.doneCond, &asyncPool.lock);
+        }
+        run = 0;
+        submitted = 1;
+    }
+    else if (asyncDev->test.type == ASYNC_TEST_NONE) {
+        /* a worker, or wolfAsync_Submit() in place, already finished it */
+        run = 0;
+        submitted = 1;
+    }
+    pthread_mutex_unlock(&asyncPool.lock);
+#else
+    if (asyncDev->test.type == ASYNC_TEST_NONE) {
+        run = 0;
+        submitted = 1;
+    }
+#endif
+
+    if (run) {
+        ret = wolfAsync_DoSw(asyncDev);
+    #ifndef WC_NO_ASYNC_THREADING
+        pthread_mutex_lock(&asyncPool.lock);
+    #endif
+        asyncDev->swRet = ret;
+        asyncDev->swState = WC_ASYNC_SW_IDLE;
+        asyncDev->test.type = ASYNC_TEST_NONE;
+    #ifndef WC_NO_ASYNC_THREADING
+        pthread_cond_broadcast(&asyncPool.doneCond);
+        pthread_mutex_unlock(&asyncPool.lock);
+    #endif
+    }
+    else {
+        ret = asyncDev->swRet;
+    }
+
+    /* a submitted event stays pending until polled off its queue */
+    if (!submitted) {
+        asyncDev->event.state = WOLF_EVENT_STATE_READY;
+    }
+
+    return ret;
+}
+
+
+int wc_AsyncGetNumberOfCpus(void)
+{
+    int count = 1;
+
+#if !defined(WC_NO_ASYNC_THREADING) && defined(_SC_NPROCESSORS_ONLN)
+    count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (count < 1) {
+        count = 1;
+    }
+#endif
+
+    return count;
+}
+
+#ifndef WC_NO_ASYNC_THREADING
+int wc_AsyncThreadCreate(pthread_t* thread, AsyncThreadFunc_t function,
+    void* params)
+{
+    if (thread == NULL || function == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    return (pthread_create(thread, NULL, function, params) == 0) ? 0 :
+                                                               WC_HW_E;
+}
+
+int wc_AsyncThreadJoin(pthread_t* thread)
+{
+    if (thread == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    return (pthread_join(*thread, NULL) == 0) ? 0 : BAD_STATE_E;
+}
+
+void wc_AsyncThreadYield(void)
+{
+    sched_yield();
+}
+#endif /* !WC_NO_ASYNC_THREADING */
+
+#endif /* WOLFSSL_ASYNC_CRYPT */
@@ -1644,10 +1644,10 @@
         #else /* WOLFSSL_ASYNC_CRYPT_TEST */
             if (wc_AsyncTestInit(&des->asyncDev, ASYNC_TEST_DES3_CBC_ENCRYPT)) {
                 WC_ASYNC_TEST* testDev = &des->asyncDev.test;
-                testDev->des.des = des;
-                testDev->des.out = out;
-                testDev->des.in = in;
-                testDev->des.sz = sz;
+                testDev->args.des.des = des;
+                testDev->args.des.out = out;
+                testDev->args.des.in = in;
+                testDev->args.des.sz = sz;
                 return WC_PENDING_E;
             }
         #endif
@@ -1695,10 +1695,10 @@
         #else /* WOLFSSL_ASYNC_CRYPT_TEST */
             if (wc_AsyncTestInit(&des->asyncDev, ASYNC_TEST_DES3_CBC_DECRYPT)) {
                 WC_ASYNC_TEST* testDev = &des->asyncDev.test;
-                testDev->des.des = des;
-                testDev->des.out = out;
-                testDev->des.in = in;
-                testDev->des.sz = sz;
+                testDev->args.des.des = des;
+                testDev->args.des.out = out;
+                testDev->args.des.in = in;
+                testDev->args.des.sz = sz;
                 return WC_PENDING_E;
             }
         #endif
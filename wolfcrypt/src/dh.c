@@ -930,6 +930,14 @@ int wc_InitDhKey_ex(DhKey* key, void* heap, int devId)
 
     key->heap = heap; /* for XMALLOC/XFREE in future */
 
+#ifdef HAVE_MP_MONT_CTX
+    key->mont = NULL;
+    #ifndef SINGLE_THREADED
+    if (wc_InitMutex(&key->montMutex) != 0)
+        return BAD_MUTEX_E;
+    #endif
+#endif
+
 #if !defined(WOLFSSL_QT) && !defined(OPENSSL_ALL)
     if (mp_init_multi(&key->p, &key->g, &key->q, NULL, NULL, NULL) != MP_OKAY)
 #else
@@ -954,6 +962,17 @@ int wc_InitDhKey(DhKey* key)
 }
 
 
+/* Free the Montgomery parameters cached on the key. Called when the key is
+ * freed and when a new prime is loaded into it. */
+void wc_DhFreeCache(DhKey* key)
+{
+#ifdef HAVE_MP_MONT_CTX
+    XFREE(key->mont, key->heap, DYNAMIC_TYPE_DH);
+    key->mont = NULL;
+#endif
+    (void)key;
+}
+
 int wc_FreeDhKey(DhKey* key)
 {
     if (key) {
@@ -964,6 +983,13 @@ int wc_FreeDhKey(DhKey* key)
     #if defined(WOLFSSL_ASYNC_CRYPT) && defined(WC_ASYNC_ENABLE_DH)
         wolfAsync_DevCtxFree(&key->asyncDev, WOLFSSL_ASYNC_MARKER_DH);
     #endif
+
+    #ifdef HAVE_MP_MONT_CTX
+        wc_DhFreeCache(key);
+        #ifndef SINGLE_THREADED
+        wc_FreeMutex(&key->montMutex);
+        #endif
+    #endif
     }
     return 0;
 }
@@ -1225,6 +1251,59 @@ static int GeneratePrivateDh(DhKey* key, WC_RNG* rng, byte* priv,
 }
 
 
+#ifdef HAVE_MP_MONT_CTX
+/* Get the Montgomery parameters of p, computed on first use and kept on the
+ * key. They are computed again if p has been changed. */
+static int DhGetMont(DhKey* key, mp_mont_ctx** mont)
+{
+    int ret = 0;
+
+#ifndef SINGLE_THREADED
+    if (wc_LockMutex(&key->montMutex) != 0)
+        return BAD_MUTEX_E;
+#endif
+
+    if (key->mont == NULL) {
+        key->mont = (mp_mont_ctx*)XMALLOC(sizeof(mp_mont_ctx), key->heap,
+                                                              DYNAMIC_TYPE_DH);
+        if (key->mont == NULL)
+            ret = MEMORY_E;
+        else
+            XMEMSET(key->mont, 0, sizeof(mp_mont_ctx));
+    }
+
+    if (ret == 0 && mp_cmp(&key->mont->m, &key->p) != MP_EQ) {
+        if (mp_mont_ctx_set(key->mont, &key->p) != MP_OKAY) {
+            mp_zero(&key->mont->m);
+            ret = MP_INIT_E;
+        }
+    }
+
+    *mont = key->mont;
+
+#ifndef SINGLE_THREADED
+    wc_UnLockMutex(&key->montMutex);
+#endif
+
+    return ret;
+}
+
+/* y = g^x mod key->p using the cached Montgomery parameters of p */
+static int DhExptMod(DhKey* key, mp_int* g, mp_int* x, mp_int* y)
+{
+    mp_mont_ctx* mont = NULL;
+    int ret;
+
+    ret = DhGetMont(key, &mont);
+    if (ret == 0 && mp_exptmod_mont(g, x, x->used, &key->p, mont,
+                                                                y) != MP_OKAY)
+        ret = MP_EXPTMOD_E;
+
+    return ret;
+}
+#endif /* HAVE_MP_MONT_CTX */
+
+
 static int GeneratePublicDh(DhKey* key, byte* priv, word32 privSz,
     byte* pub, word32* pubSz)
 {
@@ -1276,8 +1355,13 @@ static int GeneratePublicDh(DhKey* key, byte* priv, word32 privSz,
     if (mp_read_unsigned_bin(x, priv, privSz) != MP_OKAY)
         ret = MP_READ_E;
 
+#ifdef HAVE_MP_MONT_CTX
+    if (ret == 0)
+        ret = DhExptMod(key, &key->g, x, y);
+#else
     if (ret == 0 && mp_exptmod(&key->g, x, &key->p, y) != MP_OKAY)
         ret = MP_EXPTMOD_E;
+#endif
 
     if (ret == 0 && mp_to_unsigned_bin(y, pub) != MP_OKAY)
         ret = MP_TO_E;
@@ -1355,12 +1439,12 @@ static int wc_DhGenerateKeyPair_Async(DhKey* key, WC_RNG* rng,
 #else /* WOLFSSL_ASYNC_CRYPT_TEST */
     if (wc_AsyncTestInit(&key->asyncDev, ASYNC_TEST_DH_GEN)) {
         WC_ASYNC_TEST* testDev = &key->asyncDev.test;
-        testDev->dhGen.key = key;
-        testDev->dhGen.rng = rng;
-        testDev->dhGen.priv = priv;
-        testDev->dhGen.privSz = privSz;
-        testDev->dhGen.pub = pub;
-        testDev->dhGen.pubSz = pubSz;
+        testDev->args.dhGen.key = key;
+        testDev->args.dhGen.rng = rng;
+        testDev->args.dhGen.priv = priv;
+        testDev->args.dhGen.privSz = privSz;
+        testDev->args.dhGen.pub = pub;
+        testDev->args.dhGen.pubSz = pubSz;
         return WC_PENDING_E;
     }
 #endif
@@ -1499,8 +1583,12 @@ int wc_DhCheckPubKey_ex(DhKey* key, const byte* pub, word32 pubSz,
     /* SP 800-56Ar3, section 5.6.2.3.1, process step 2 */
 #ifndef WOLFSSL_SP_MATH
             /* calculate (y^q) mod(p), store back into y */
+        #ifdef HAVE_MP_MONT_CTX
+            ret = DhExptMod(key, y, q, y);
+        #else
             if (mp_exptmod(y, q, p, y) != MP_OKAY)
                 ret = MP_EXPTMOD_E;
+        #endif
 #else
             ret = WC_KEY_SIZE_E;
 #endif
@@ -1969,8 +2057,13 @@ static int wc_DhAgree_Sync(DhKey* key, byte* agree, word32* agreeSz,
     if (ret == 0 && mp_read_unsigned_bin(y, otherPub, pubSz) != MP_OKAY)
         ret = MP_READ_E;
 
+#ifdef HAVE_MP_MONT_CTX
+    if (ret == 0)
+        ret = DhExptMod(key, y, x, z);
+#else
     if (ret == 0 && mp_exptmod(y, x, &key->p, z) != MP_OKAY)
         ret = MP_EXPTMOD_E;
+#endif
 
     /* make sure z is not one (SP800-56A, 5.7.1.1) */
     if (ret == 0 && (mp_cmp_d(z, 1) == MP_EQ))
@@ -2024,13 +2117,13 @@ static int wc_DhAgree_Async(DhKey* key, byte* agree, word32* agreeSz,
 #else /* WOLFSSL_ASYNC_CRYPT_TEST */
     if (wc_AsyncTestInit(&key->asyncDev, ASYNC_TEST_DH_AGREE)) {
         WC_ASYNC_TEST* testDev = &key->asyncDev.test;
-        testDev->dhAgree.key = key;
-        testDev->dhAgree.agree = agree;
-        testDev->dhAgree.agreeSz = agreeSz;
-        testDev->dhAgree.priv = priv;
-        testDev->dhAgree.privSz = privSz;
-        testDev->dhAgree.otherPub = otherPub;
-        testDev->dhAgree.pubSz = pubSz;
+        testDev->args.dhAgree.key = key;
+        testDev->args.dhAgree.agree = agree;
+        testDev->args.dhAgree.agreeSz = agreeSz;
+        testDev->args.dhAgree.priv = priv;
+        testDev->args.dhAgree.privSz = privSz;
+        testDev->args.dhAgree.otherPub = otherPub;
+        testDev->args.dhAgree.pubSz = pubSz;
         return WC_PENDING_E;
     }
 #endif
@@ -2149,6 +2242,8 @@ static int _DhSetKey(DhKey* key, const byte* p, word32 pSz, const byte* g,
     }
 
     if (ret == 0) {
+        wc_DhFreeCache(key);
+
         /* may have leading 0 */
         if (p[0] == 0) {
             pSz--; p++;
@@ -2293,6 +2388,7 @@ int wc_DhGenerateParams(WC_RNG *rng, int modSz, DhKey *dh)
         /* force even */
         buf[bufSz - 1] &= ~1;
 
+        wc_DhFreeCache(dh);
         if (mp_init_multi(&tmp, &tmp2, &dh->p, &dh->q, &dh->g, 0)
                 != MP_OKAY) {
             ret = MP_INIT_E;
@@ -51,6 +51,8 @@ Possible ECC enable options:
  * ECC_CACHE_CURVE:     Enables cache of curve info to improve perofrmance
                                                                 default: off
  * FP_ECC:              ECC Fixed Point Cache                   default: off
+ * WOLFSSL_ECC_KEY_TABLE: Pre-computed tables for public keys   default: off
+                        Uses SP tables for SP curves, FP_ECC LUTs otherwise
  * USE_ECC_B_PARAM:     Enable ECC curve B param                default: off
                          (on for HAVE_COMP_KEY)
  * WOLFSSL_ECC_CURVE_STATIC:                                    default off (on for windows)
@@ -149,6 +151,25 @@ ECC Curve Sizes:
     #define GEN_MEM_ERR MP_MEM
 #endif
 
+#ifdef WOLFSSL_ECC_KEY_TABLE
+    /* Curves not verified with SP use the fixed point LUT as the table */
+    #if defined(FP_ECC) && defined(ECC_SHAMIR) && \
+        !defined(WOLFSSL_SP_MATH) && !defined(FREESCALE_LTC_ECC) && \
+        !defined(WOLFSSL_ATECC508A) && !defined(WOLFSSL_ATECC608A) && \
+        !defined(WOLFSSL_CRYPTOCELL) && !defined(WOLFSSL_STM32_PKA)
+        #define WC_ECC_KEY_TABLE_FP
+    #endif
+
+    #ifdef WOLFSSL_SP_ECC_TABLE
+        static const byte* ecc_key_table_sp(ecc_key* key);
+    #endif
+    #ifdef WC_ECC_KEY_TABLE_FP
+        static int ecc_key_table_mul2add(ecc_key* key, ecc_point* A,
+            mp_int* kA, ecc_point* B, mp_int* kB, ecc_point* C, mp_int* a,
+            mp_int* modulus);
+    #endif
+#endif /* WOLFSSL_ECC_KEY_TABLE */
+
 
 /* internal ECC states */
 enum {
@@ -3754,10 +3775,10 @@ static int wc_ecc_shared_secret_gen_async(ecc_key* private_key,
 #elif defined(WOLFSSL_ASYNC_CRYPT_TEST)
     if (wc_AsyncTestInit(&private_key->asyncDev, ASYNC_TEST_ECC_SHARED_SEC)) {
         WC_ASYNC_TEST* testDev = &private_key->asyncDev.test;
-        testDev->eccSharedSec.private_key = private_key;
-        testDev->eccSharedSec.public_point = point;
-        testDev->eccSharedSec.out = out;
-        testDev->eccSharedSec.outLen = outlen;
+        testDev->args.eccSharedSec.private_key = private_key;
+        testDev->args.eccSharedSec.public_point = point;
+        testDev->args.eccSharedSec.out = out;
+        testDev->args.eccSharedSec.outLen = outlen;
         return WC_PENDING_E;
     }
 #endif
@@ -4175,10 +4196,10 @@ int wc_ecc_make_key_ex(WC_RNG* rng, int keysize, ecc_key* key, int curve_id)
     #else
         if (wc_AsyncTestInit(&key->asyncDev, ASYNC_TEST_ECC_MAKE)) {
             WC_ASYNC_TEST* testDev = &key->asyncDev.test;
-            testDev->eccMake.rng = rng;
-            testDev->eccMake.key = key;
-            testDev->eccMake.size = keysize;
-            testDev->eccMake.curve_id = curve_id;
+            testDev->args.eccMake.rng = rng;
+            testDev->args.eccMake.key = key;
+            testDev->args.eccMake.size = keysize;
+            testDev->args.eccMake.curve_id = curve_id;
             return WC_PENDING_E;
         }
     #endif
@@ -4947,12 +4968,12 @@ int wc_ecc_sign_hash_ex(const byte* in, word32 inlen, WC_RNG* rng,
     if (key->asyncDev.marker == WOLFSSL_ASYNC_MARKER_ECC) {
         if (wc_AsyncTestInit(&key->asyncDev, ASYNC_TEST_ECC_SIGN)) {
             WC_ASYNC_TEST* testDev = &key->asyncDev.test;
-            testDev->eccSign.in = in;
-            testDev->eccSign.inSz = inlen;
-            testDev->eccSign.rng = rng;
-            testDev->eccSign.key = key;
-            testDev->eccSign.r = r;
-            testDev->eccSign.s = s;
+            testDev->args.eccSign.in = in;
+            testDev->args.eccSign.inSz = inlen;
+            testDev->args.eccSign.rng = rng;
+            testDev->args.eccSign.key = key;
+            testDev->args.eccSign.r = r;
+            testDev->args.eccSign.s = s;
             return WC_PENDING_E;
         }
     }
@@ -5899,12 +5920,12 @@ int wc_ecc_verify_hash_ex(mp_int *r, mp_int *s, const byte* hash,
     if (key->asyncDev.marker == WOLFSSL_ASYNC_MARKER_ECC) {
         if (wc_AsyncTestInit(&key->asyncDev, ASYNC_TEST_ECC_VERIFY)) {
             WC_ASYNC_TEST* testDev = &key->asyncDev.test;
-            testDev->eccVerify.r = r;
-            testDev->eccVerify.s = s;
-            testDev->eccVerify.hash = hash;
-            testDev->eccVerify.hashlen = hashlen;
-            testDev->eccVerify.stat = res;
-            testDev->eccVerify.key = key;
+            testDev->args.eccVerify.r = r;
+            testDev->args.eccVerify.s = s;
+            testDev->args.eccVerify.hash = hash;
+            testDev->args.eccVerify.hashlen = hashlen;
+            testDev->args.eccVerify.stat = res;
+            testDev->args.eccVerify.key = key;
             return WC_PENDING_E;
         }
     }
@@ -5988,12 +6009,26 @@ int wc_ecc_verify_hash_ex(mp_int *r, mp_int *s, const byte* hash,
 #if defined(WOLFSSL_SP_MATH) && !defined(FREESCALE_LTC_ECC)
 #ifndef WOLFSSL_SP_NO_256
   if (key->idx != ECC_CUSTOM_IDX && ecc_sets[key->idx].id == ECC_SECP256R1) {
+  #ifdef WOLFSSL_SP_ECC_TABLE
+      if (ecc_key_table_sp(key) != NULL) {
+          return sp_ecc_verify_table_256(hash, hashlen, key->pubkey.x,
+                          key->pubkey.y, key->pubkey.z, r, s, res,
+                          ecc_key_table_sp(key), key->heap);
+      }
+  #endif
       return sp_ecc_verify_256(hash, hashlen, key->pubkey.x, key->pubkey.y,
                                            key->pubkey.z, r, s, res, key->heap);
   }
 #endif
 #ifdef WOLFSSL_SP_384
   if (key->idx != ECC_CUSTOM_IDX && ecc_sets[key->idx].id == ECC_SECP384R1) {
+  #ifdef WOLFSSL_SP_ECC_TABLE
+      if (ecc_key_table_sp(key) != NULL) {
+          return sp_ecc_verify_table_384(hash, hashlen, key->pubkey.x,
+                          key->pubkey.y, key->pubkey.z, r, s, res,
+                          ecc_key_table_sp(key), key->heap);
+      }
+  #endif
       return sp_ecc_verify_384(hash, hashlen, key->pubkey.x, key->pubkey.y,
                                            key->pubkey.z, r, s, res, key->heap);
   }
@@ -6008,6 +6043,13 @@ int wc_ecc_verify_hash_ex(mp_int *r, mp_int *s, const byte* hash,
 #ifndef WOLFSSL_SP_NO_256
         if (key->idx != ECC_CUSTOM_IDX &&
                                        ecc_sets[key->idx].id == ECC_SECP256R1) {
+        #ifdef WOLFSSL_SP_ECC_TABLE
+            if (ecc_key_table_sp(key) != NULL) {
+                return sp_ecc_verify_table_256(hash, hashlen, key->pubkey.x,
+                                         key->pubkey.y, key->pubkey.z, r, s,
+                                         res, ecc_key_table_sp(key), key->heap);
+            }
+        #endif
             return sp_ecc_verify_256(hash, hashlen, key->pubkey.x,
                                          key->pubkey.y, key->pubkey.z,r, s, res,
                                          key->heap);
@@ -6016,6 +6058,13 @@ int wc_ecc_verify_hash_ex(mp_int *r, mp_int *s, const byte* hash,
 #ifdef WOLFSSL_SP_384
         if (key->idx != ECC_CUSTOM_IDX &&
                                        ecc_sets[key->idx].id == ECC_SECP384R1) {
+        #ifdef WOLFSSL_SP_ECC_TABLE
+            if (ecc_key_table_sp(key) != NULL) {
+                return sp_ecc_verify_table_384(hash, hashlen, key->pubkey.x,
+                                         key->pubkey.y, key->pubkey.z, r, s,
+                                         res, ecc_key_table_sp(key), key->heap);
+            }
+        #endif
             return sp_ecc_verify_384(hash, hashlen, key->pubkey.x,
                                          key->pubkey.y, key->pubkey.z,r, s, res,
                                          key->heap);
@@ -6241,8 +6290,17 @@ int wc_ecc_verify_hash_ex(mp_int *r, mp_int *s, const byte* hash,
 #else
     /* use Shamir's trick to compute u1*mG + u2*mQ using half the doubles */
     if (err == MP_OKAY) {
-        err = ecc_mul2add(mG, u1, mQ, u2, mG, curve->Af, curve->prime,
+    #ifdef WC_ECC_KEY_TABLE_FP
+        if (key->table != NULL) {
+            err = ecc_key_table_mul2add(key, mG, u1, mQ, u2, mG, curve->Af,
+                                                                  curve->prime);
+        }
+        else
+    #endif
+        {
+            err = ecc_mul2add(mG, u1, mQ, u2, mG, curve->Af, curve->prime,
                                                                      key->heap);
+        }
     }
 #endif /* ECC_SHAMIR */
 #endif /* FREESCALE_LTC_ECC */
@@ -8704,41 +8762,41 @@ static int find_base(ecc_point* g)
 }
 
 /* add a new base to the cache */
-static int add_entry(int idx, ecc_point *g)
+static int add_entry(fp_cache_t* cache, ecc_point *g)
 {
    unsigned x, y;
 
    /* allocate base and LUT */
-   fp_cache[idx].g = wc_ecc_new_point();
-   if (fp_cache[idx].g == NULL) {
+   cache->g = wc_ecc_new_point();
+   if (cache->g == NULL) {
       return GEN_MEM_ERR;
    }
 
    /* copy x and y */
-   if ((mp_copy(g->x, fp_cache[idx].g->x) != MP_OKAY) ||
-       (mp_copy(g->y, fp_cache[idx].g->y) != MP_OKAY) ||
-       (mp_copy(g->z, fp_cache[idx].g->z) != MP_OKAY)) {
-      wc_ecc_del_point(fp_cache[idx].g);
-      fp_cache[idx].g = NULL;
+   if ((mp_copy(g->x, cache->g->x) != MP_OKAY) ||
+       (mp_copy(g->y, cache->g->y) != MP_OKAY) ||
+       (mp_copy(g->z, cache->g->z) != MP_OKAY)) {
+      wc_ecc_del_point(cache->g);
+      cache->g = NULL;
       return GEN_MEM_ERR;
    }
 
    for (x = 0; x < (1U<<FP_LUT); x++) {
-      fp_cache[idx].LUT[x] = wc_ecc_new_point();
-      if (fp_cache[idx].LUT[x] == NULL) {
+      cache->LUT[x] = wc_ecc_new_point();
+      if (cache->LUT[x] == NULL) {
          for (y = 0; y < x; y++) {
-            wc_ecc_del_point(fp_cache[idx].LUT[y]);
-            fp_cache[idx].LUT[y] = NULL;
+            wc_ecc_del_point(cache->LUT[y]);
+            cache->LUT[y] = NULL;
          }
-         wc_ecc_del_point(fp_cache[idx].g);
-         fp_cache[idx].g         = NULL;
-         fp_cache[idx].lru_count = 0;
+         wc_ecc_del_point(cache->g);
+         cache->g         = NULL;
+         cache->lru_count = 0;
          return GEN_MEM_ERR;
       }
    }
 
-   fp_cache[idx].LUT_set   = 0;
-   fp_cache[idx].lru_count = 0;
+   cache->LUT_set   = 0;
+   cache->lru_count = 0;
 
    return MP_OKAY;
 }
@@ -8750,8 +8808,8 @@ static int add_entry(int idx, ecc_point *g)
  * The algorithm builds patterns in increasing bit order by first making all
  * single bit input patterns, then all two bit input patterns and so on
  */
-static int build_lut(int idx, mp_int* a, mp_int* modulus, mp_digit mp,
-    mp_int* mu)
+static int build_lut(fp_cache_t* cache, mp_int* a, mp_int* modulus,
+    mp_digit mp, mp_int* mu)
 {
    int err;
    unsigned x, y, bitlen, lut_gap;
@@ -8775,17 +8833,17 @@ static int build_lut(int idx, mp_int* a, mp_int* modulus, mp_digit mp,
     lut_gap = bitlen / FP_LUT;
 
     /* init the mu */
-    err = mp_init_copy(&fp_cache[idx].mu, mu);
+    err = mp_init_copy(&cache->mu, mu);
    }
 
    /* copy base */
    if (err == MP_OKAY) {
-     if ((mp_mulmod(fp_cache[idx].g->x, mu, modulus,
-                  fp_cache[idx].LUT[1]->x) != MP_OKAY) ||
-         (mp_mulmod(fp_cache[idx].g->y, mu, modulus,
-                  fp_cache[idx].LUT[1]->y) != MP_OKAY) ||
-         (mp_mulmod(fp_cache[idx].g->z, mu, modulus,
-                  fp_cache[idx].LUT[1]->z) != MP_OKAY)) {
+     if ((mp_mulmod(cache->g->x, mu, modulus,
+                  cache->LUT[1]->x) != MP_OKAY) ||
+         (mp_mulmod(cache->g->y, mu, modulus,
+                  cache->LUT[1]->y) != MP_OKAY) ||
+         (mp_mulmod(cache->g->z, mu, modulus,
+                  cache->LUT[1]->z) != MP_OKAY)) {
        err = MP_MULMOD_E;
      }
    }
@@ -8794,20 +8852,20 @@ static int build_lut(int idx, mp_int* a, mp_int* modulus, mp_digit mp,
    for (x = 1; x < FP_LUT; x++) {
       if (err != MP_OKAY)
           break;
-      if ((mp_copy(fp_cache[idx].LUT[1<<(x-1)]->x,
-                   fp_cache[idx].LUT[1<<x]->x) != MP_OKAY) ||
-          (mp_copy(fp_cache[idx].LUT[1<<(x-1)]->y,
-                   fp_cache[idx].LUT[1<<x]->y) != MP_OKAY) ||
-          (mp_copy(fp_cache[idx].LUT[1<<(x-1)]->z,
-                   fp_cache[idx].LUT[1<<x]->z) != MP_OKAY)){
+      if ((mp_copy(cache->LUT[1<<(x-1)]->x,
+                   cache->LUT[1<<x]->x) != MP_OKAY) ||
+          (mp_copy(cache->LUT[1<<(x-1)]->y,
+                   cache->LUT[1<<x]->y) != MP_OKAY) ||
+          (mp_copy(cache->LUT[1<<(x-1)]->z,
+                   cache->LUT[1<<x]->z) != MP_OKAY)){
           err = MP_INIT_E;
           break;
       } else {
 
          /* now double it bitlen/FP_LUT times */
          for (y = 0; y < lut_gap; y++) {
-             if ((err = ecc_projective_dbl_point(fp_cache[idx].LUT[1<<x],
-                            fp_cache[idx].LUT[1<<x], a, modulus, mp)) != MP_OKAY) {
+             if ((err = ecc_projective_dbl_point(cache->LUT[1<<x],
+                            cache->LUT[1<<x], a, modulus, mp)) != MP_OKAY) {
                  break;
              }
          }
@@ -8823,9 +8881,9 @@ static int build_lut(int idx, mp_int* a, mp_int* modulus, mp_digit mp,
 
            /* perform the add */
            if ((err = ecc_projective_add_point(
-                           fp_cache[idx].LUT[lut_orders[y].terma],
-                           fp_cache[idx].LUT[lut_orders[y].termb],
-                           fp_cache[idx].LUT[y], a, modulus, mp)) != MP_OKAY) {
+                           cache->LUT[lut_orders[y].terma],
+                           cache->LUT[lut_orders[y].termb],
+                           cache->LUT[y], a, modulus, mp)) != MP_OKAY) {
               break;
            }
        }
@@ -8837,60 +8895,60 @@ static int build_lut(int idx, mp_int* a, mp_int* modulus, mp_digit mp,
            break;
 
        /* convert z to normal from montgomery */
-       err = mp_montgomery_reduce(fp_cache[idx].LUT[x]->z, modulus, mp);
+       err = mp_montgomery_reduce(cache->LUT[x]->z, modulus, mp);
 
        /* invert it */
        if (err == MP_OKAY)
-         err = mp_invmod(fp_cache[idx].LUT[x]->z, modulus,
-                         fp_cache[idx].LUT[x]->z);
+         err = mp_invmod(cache->LUT[x]->z, modulus,
+                         cache->LUT[x]->z);
 
        if (err == MP_OKAY)
          /* now square it */
-         err = mp_sqrmod(fp_cache[idx].LUT[x]->z, modulus, &tmp);
+         err = mp_sqrmod(cache->LUT[x]->z, modulus, &tmp);
 
        if (err == MP_OKAY)
          /* fix x */
-         err = mp_mulmod(fp_cache[idx].LUT[x]->x, &tmp, modulus,
-                         fp_cache[idx].LUT[x]->x);
+         err = mp_mulmod(cache->LUT[x]->x, &tmp, modulus,
+                         cache->LUT[x]->x);
 
        if (err == MP_OKAY)
          /* get 1/z^3 */
-         err = mp_mulmod(&tmp, fp_cache[idx].LUT[x]->z, modulus, &tmp);
+         err = mp_mulmod(&tmp, cache->LUT[x]->z, modulus, &tmp);
 
        if (err == MP_OKAY)
          /* fix y */
-         err = mp_mulmod(fp_cache[idx].LUT[x]->y, &tmp, modulus,
-                         fp_cache[idx].LUT[x]->y);
+         err = mp_mulmod(cache->LUT[x]->y, &tmp, modulus,
+                         cache->LUT[x]->y);
 
        if (err == MP_OKAY)
          /* free z */
-         mp_clear(fp_cache[idx].LUT[x]->z);
+         mp_clear(cache->LUT[x]->z);
    }
 
    mp_clear(&tmp);
 
    if (err == MP_OKAY) {
-       fp_cache[idx].LUT_set = 1;
+       cache->LUT_set = 1;
        return MP_OKAY;
    }
 
    /* err cleanup */
    for (y = 0; y < (1U<<FP_LUT); y++) {
-      wc_ecc_del_point(fp_cache[idx].LUT[y]);
-      fp_cache[idx].LUT[y] = NULL;
+      wc_ecc_del_point(cache->LUT[y]);
+      cache->LUT[y] = NULL;
    }
-   wc_ecc_del_point(fp_cache[idx].g);
-   fp_cache[idx].g         = NULL;
-   fp_cache[idx].LUT_set   = 0;
-   fp_cache[idx].lru_count = 0;
-   mp_clear(&fp_cache[idx].mu);
+   wc_ecc_del_point(cache->g);
+   cache->g         = NULL;
+   cache->LUT_set   = 0;
+   cache->lru_count = 0;
+   mp_clear(&cache->mu);
 
    return err;
 }
 
 /* perform a fixed point ECC mulmod */
-static int accel_fp_mul(int idx, mp_int* k, ecc_point *R, mp_int* a,
-                        mp_int* modulus, mp_digit mp, int map)
+static int accel_fp_mul(fp_cache_t* cache, mp_int* k, ecc_point *R,
+                        mp_int* a, mp_int* modulus, mp_digit mp, int map)
 {
 #define KB_SIZE 128
 
@@ -8995,14 +9053,14 @@ static int accel_fp_mul(int idx, mp_int* k, ecc_point *R, mp_int* a,
 
           /* add if not first, otherwise copy */
           if (!first && z) {
-             if ((err = ecc_projective_add_point(R, fp_cache[idx].LUT[z], R, a,
+             if ((err = ecc_projective_add_point(R, cache->LUT[z], R, a,
                                                      modulus, mp)) != MP_OKAY) {
                 break;
              }
              if (mp_iszero(R->z)) {
                  /* When all zero then should have done an add */
                  if (mp_iszero(R->x) && mp_iszero(R->y)) {
-                     if ((err = ecc_projective_dbl_point(fp_cache[idx].LUT[z],
+                     if ((err = ecc_projective_dbl_point(cache->LUT[z],
                                                R, a, modulus, mp)) != MP_OKAY) {
                          break;
                      }
@@ -9017,7 +9075,7 @@ static int accel_fp_mul(int idx, mp_int* k, ecc_point *R, mp_int* a,
                     if (err != MP_OKAY) {
                        break;
                     }
-                    err = mp_copy(&fp_cache[idx].mu, R->z);
+                    err = mp_copy(&cache->mu, R->z);
                     if (err != MP_OKAY) {
                        break;
                     }
@@ -9025,9 +9083,9 @@ static int accel_fp_mul(int idx, mp_int* k, ecc_point *R, mp_int* a,
                  }
              }
           } else if (z) {
-             if ((mp_copy(fp_cache[idx].LUT[z]->x, R->x) != MP_OKAY) ||
-                 (mp_copy(fp_cache[idx].LUT[z]->y, R->y) != MP_OKAY) ||
-                 (mp_copy(&fp_cache[idx].mu,       R->z) != MP_OKAY)) {
+             if ((mp_copy(cache->LUT[z]->x, R->x) != MP_OKAY) ||
+                 (mp_copy(cache->LUT[z]->y, R->y) != MP_OKAY) ||
+                 (mp_copy(&cache->mu,       R->z) != MP_OKAY)) {
                  err = GEN_MEM_ERR;
                  break;
              }
@@ -9066,7 +9124,7 @@ done:
 #ifdef ECC_SHAMIR
 #ifndef WOLFSSL_SP_MATH
 /* perform a fixed point ECC mulmod */
-static int accel_fp_mul2add(int idx1, int idx2,
+static int accel_fp_mul2add(fp_cache_t* cache1, fp_cache_t* cache2,
                             mp_int* kA, mp_int* kB,
                             ecc_point *R, mp_int* a,
                             mp_int* modulus, mp_digit mp)
@@ -9231,7 +9289,7 @@ static int accel_fp_mul2add(int idx1, int idx2,
 
              /* add if not first, otherwise copy */
              if (zA) {
-                if ((err = ecc_projective_add_point(R, fp_cache[idx1].LUT[zA],
+                if ((err = ecc_projective_add_point(R, cache1->LUT[zA],
                                                R, a, modulus, mp)) != MP_OKAY) {
                    break;
                 }
@@ -9239,7 +9297,7 @@ static int accel_fp_mul2add(int idx1, int idx2,
                     /* When all zero then should have done an add */
                     if (mp_iszero(R->x) && mp_iszero(R->y)) {
                         if ((err = ecc_projective_dbl_point(
-                                                  fp_cache[idx1].LUT[zA], R,
+                                                  cache1->LUT[zA], R,
                                                   a, modulus, mp)) != MP_OKAY) {
                             break;
                         }
@@ -9254,7 +9312,7 @@ static int accel_fp_mul2add(int idx1, int idx2,
                        if (err != MP_OKAY) {
                           break;
                        }
-                       err = mp_copy(&fp_cache[idx1].mu, R->z);
+                       err = mp_copy(&cache1->mu, R->z);
                        if (err != MP_OKAY) {
                           break;
                        }
@@ -9264,7 +9322,7 @@ static int accel_fp_mul2add(int idx1, int idx2,
              }
 
              if (zB) {
-                if ((err = ecc_projective_add_point(R, fp_cache[idx2].LUT[zB],
+                if ((err = ecc_projective_add_point(R, cache2->LUT[zB],
                                                R, a, modulus, mp)) != MP_OKAY) {
                    break;
                 }
@@ -9272,7 +9330,7 @@ static int accel_fp_mul2add(int idx1, int idx2,
                     /* When all zero then should have done an add */
                     if (mp_iszero(R->x) && mp_iszero(R->y)) {
                         if ((err = ecc_projective_dbl_point(
-                                                  fp_cache[idx2].LUT[zB], R,
+                                                  cache2->LUT[zB], R,
                                                   a, modulus, mp)) != MP_OKAY) {
                             break;
                         }
@@ -9287,7 +9345,7 @@ static int accel_fp_mul2add(int idx1, int idx2,
                        if (err != MP_OKAY) {
                           break;
                        }
-                       err = mp_copy(&fp_cache[idx2].mu, R->z);
+                       err = mp_copy(&cache2->mu, R->z);
                        if (err != MP_OKAY) {
                           break;
                        }
@@ -9297,9 +9355,9 @@ static int accel_fp_mul2add(int idx1, int idx2,
              }
           } else {
              if (zA) {
-                 if ((mp_copy(fp_cache[idx1].LUT[zA]->x, R->x) != MP_OKAY) ||
-                     (mp_copy(fp_cache[idx1].LUT[zA]->y, R->y) != MP_OKAY) ||
-                     (mp_copy(&fp_cache[idx1].mu,        R->z) != MP_OKAY)) {
+                 if ((mp_copy(cache1->LUT[zA]->x, R->x) != MP_OKAY) ||
+                     (mp_copy(cache1->LUT[zA]->y, R->y) != MP_OKAY) ||
+                     (mp_copy(&cache1->mu,        R->z) != MP_OKAY)) {
                      err = GEN_MEM_ERR;
                      break;
                  }
@@ -9308,14 +9366,14 @@ static int accel_fp_mul2add(int idx1, int idx2,
              if (zB && first == 0) {
                 if (zB) {
                    if ((err = ecc_projective_add_point(R,
-                        fp_cache[idx2].LUT[zB], R, a, modulus, mp)) != MP_OKAY){
+                        cache2->LUT[zB], R, a, modulus, mp)) != MP_OKAY){
                       break;
                    }
                    if (mp_iszero(R->z)) {
                        /* When all zero then should have done an add */
                        if (mp_iszero(R->x) && mp_iszero(R->y)) {
                            if ((err = ecc_projective_dbl_point(
-                                                  fp_cache[idx2].LUT[zB], R,
+                                                  cache2->LUT[zB], R,
                                                   a, modulus, mp)) != MP_OKAY) {
                                break;
                            }
@@ -9330,7 +9388,7 @@ static int accel_fp_mul2add(int idx1, int idx2,
                           if (err != MP_OKAY) {
                              break;
                           }
-                          err = mp_copy(&fp_cache[idx2].mu, R->z);
+                          err = mp_copy(&cache2->mu, R->z);
                           if (err != MP_OKAY) {
                              break;
                           }
@@ -9339,9 +9397,9 @@ static int accel_fp_mul2add(int idx1, int idx2,
                    }
                 }
              } else if (zB && first == 1) {
-                 if ((mp_copy(fp_cache[idx2].LUT[zB]->x, R->x) != MP_OKAY) ||
-                     (mp_copy(fp_cache[idx2].LUT[zB]->y, R->y) != MP_OKAY) ||
-                     (mp_copy(&fp_cache[idx2].mu,        R->z) != MP_OKAY)) {
+                 if ((mp_copy(cache2->LUT[zB]->x, R->x) != MP_OKAY) ||
+                     (mp_copy(cache2->LUT[zB]->y, R->y) != MP_OKAY) ||
+                     (mp_copy(&cache2->mu,        R->z) != MP_OKAY)) {
                      err = GEN_MEM_ERR;
                      break;
                  }
@@ -9380,7 +9438,7 @@ done:
 }
 
 
-/** ECC Fixed Point mulmod global with heap hint used
+/** ECC Fixed Point mul2add with an optional LUT owned by the caller
   Computes kA*A + kB*B = C using Shamir's Trick
   A        First point to multiply
   kA       What to multiple A by
@@ -9389,11 +9447,13 @@ done:
   C        [out] Destination point (can overlap with A or B)
   a        ECC curve parameter a
   modulus  Modulus for curve
+  lutB     LUT already built for B, NULL to look B up in the cache
   return MP_OKAY on success
 */
-int ecc_mul2add(ecc_point* A, mp_int* kA,
-                ecc_point* B, mp_int* kB,
-                ecc_point* C, mp_int* a, mp_int* modulus, void* heap)
+static int ecc_mul2add_lut(ecc_point* A, mp_int* kA,
+                           ecc_point* B, mp_int* kB,
+                           ecc_point* C, mp_int* a, mp_int* modulus,
+                           fp_cache_t* lutB, void* heap)
 {
    int  idx1 = -1, idx2 = -1, err, mpInit = 0;
    mp_digit mp;
@@ -9420,7 +9480,7 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
       if (idx1 == -1) {
          /* find hole and add it */
          if ((idx1 = find_hole()) >= 0) {
-            err = add_entry(idx1, A);
+            err = add_entry(&fp_cache[idx1], A);
          }
       }
       if (err == MP_OKAY && idx1 != -1) {
@@ -9428,7 +9488,7 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
          ++(fp_cache[idx1].lru_count);
       }
 
-      if (err == MP_OKAY) {
+      if (err == MP_OKAY && lutB == NULL) {
         /* find point */
         idx2 = find_base(B);
 
@@ -9436,7 +9496,7 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
         if (idx2 == -1) {
            /* find hole and add it */
            if ((idx2 = find_hole()) >= 0)
-              err = add_entry(idx2, B);
+              err = add_entry(&fp_cache[idx2], B);
          }
       }
 
@@ -9458,7 +9518,7 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
 
            if (err == MP_OKAY)
              /* build the LUT */
-               err = build_lut(idx1, a, modulus, mp, &mu);
+               err = build_lut(&fp_cache[idx1], a, modulus, mp, &mu);
         }
       }
 
@@ -9476,20 +9536,25 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
 
             if (err == MP_OKAY)
             /* build the LUT */
-              err = build_lut(idx2, a, modulus, mp, &mu);
+              err = build_lut(&fp_cache[idx2], a, modulus, mp, &mu);
         }
       }
 
 
+      if (err == MP_OKAY && idx2 >= 0) {
+        lutB = &fp_cache[idx2];
+      }
+
       if (err == MP_OKAY) {
-        if (idx1 >=0 && idx2 >= 0 && fp_cache[idx1].LUT_set &&
-                                     fp_cache[idx2].LUT_set) {
+        if (idx1 >=0 && lutB != NULL && fp_cache[idx1].LUT_set &&
+                                        lutB->LUT_set) {
            if (mpInit == 0) {
               /* compute mp */
               err = mp_montgomery_setup(modulus, &mp);
            }
            if (err == MP_OKAY)
-             err = accel_fp_mul2add(idx1, idx2, kA, kB, C, a, modulus, mp);
+             err = accel_fp_mul2add(&fp_cache[idx1], lutB, kA, kB, C, a,
+                                                                  modulus, mp);
         } else {
            err = normal_ecc_mul2add(A, kA, B, kB, C, a, modulus, heap);
         }
@@ -9502,6 +9567,24 @@ int ecc_mul2add(ecc_point* A, mp_int* kA,
 
     return err;
 }
+
+/** ECC Fixed Point mulmod global with heap hint used
+  Computes kA*A + kB*B = C using Shamir's Trick
+  A        First point to multiply
+  kA       What to multiple A by
+  B        Second point to multiply
+  kB       What to multiple B by
+  C        [out] Destination point (can overlap with A or B)
+  a        ECC curve parameter a
+  modulus  Modulus for curve
+  return MP_OKAY on success
+*/
+int ecc_mul2add(ecc_point* A, mp_int* kA,
+                ecc_point* B, mp_int* kB,
+                ecc_point* C, mp_int* a, mp_int* modulus, void* heap)
+{
+   return ecc_mul2add_lut(A, kA, B, kB, C, a, modulus, NULL, heap);
+}
 #endif
 #endif /* ECC_SHAMIR */
 
@@ -9550,7 +9633,7 @@ int wc_ecc_mulmod_ex(mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
          idx = find_hole();
 
          if (idx >= 0)
-            err = add_entry(idx, G);
+            err = add_entry(&fp_cache[idx], G);
       }
       if (err == MP_OKAY && idx >= 0) {
          /* increment LRU */
@@ -9572,7 +9655,7 @@ int wc_ecc_mulmod_ex(mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
 
            if (err == MP_OKAY)
              /* build the LUT */
-             err = build_lut(idx, a, modulus, mp, &mu);
+             err = build_lut(&fp_cache[idx], a, modulus, mp, &mu);
         }
       }
 
@@ -9583,7 +9666,7 @@ int wc_ecc_mulmod_ex(mp_int* k, ecc_point *G, ecc_point *R, mp_int* a,
               err = mp_montgomery_setup(modulus, &mp);
            }
            if (err == MP_OKAY)
-             err = accel_fp_mul(idx, k, R, a, modulus, mp, map);
+             err = accel_fp_mul(&fp_cache[idx], k, R, a, modulus, mp, map);
         } else {
            err = normal_ecc_mulmod(k, G, R, a, modulus, map, heap);
         }
@@ -9679,6 +9762,274 @@ void wc_ecc_fp_free(void)
 
 #endif /* FP_ECC */
 
+#ifdef WOLFSSL_ECC_KEY_TABLE
+
+/* Pre-computed multiples of a public key. Only read once generated so it can
+ * be shared by any number of keys and threads. */
+struct ecc_key_table {
+    int        curveId;     /* curve of the key the table was made for */
+    ecc_point* pub;         /* copy of the public key */
+    void*      heap;
+#ifdef WOLFSSL_SP_ECC_TABLE
+    byte*      sp;          /* SP table, P-256 and P-384 */
+#endif
+#ifdef WC_ECC_KEY_TABLE_FP
+    fp_cache_t fp;          /* fixed point LUT, other curves */
+#endif
+};
+
+/* Returns the size in bits of the SP verify used for the key, 0 when
+ * verification doesn't go through SP. */
+static int ecc_key_table_sp_bits(ecc_key* key)
+{
+#ifdef WOLFSSL_HAVE_SP_ECC
+#ifndef WOLFSSL_SP_NO_256
+    if (key->idx != ECC_CUSTOM_IDX && ecc_sets[key->idx].id == ECC_SECP256R1)
+        return 256;
+#endif
+#ifdef WOLFSSL_SP_384
+    if (key->idx != ECC_CUSTOM_IDX && ecc_sets[key->idx].id == ECC_SECP384R1)
+        return 384;
+#endif
+#endif
+    (void)key;
+    return 0;
+}
+
+/* Returns 1 when the key's table was made for the key's public point. The
+ * key may have been re-imported since the table was set. */
+static int ecc_key_table_match(ecc_key* key)
+{
+    ecc_key_table* table = key->table;
+
+    return table != NULL && key->dp != NULL &&
+           key->dp->id == table->curveId &&
+           mp_cmp(key->pubkey.x, table->pub->x) == MP_EQ &&
+           mp_cmp(key->pubkey.y, table->pub->y) == MP_EQ &&
+           mp_cmp(key->pubkey.z, table->pub->z) == MP_EQ;
+}
+
+#ifdef WOLFSSL_SP_ECC_TABLE
+/* Returns the SP table to verify with, NULL when there isn't a usable one */
+static const byte* ecc_key_table_sp(ecc_key* key)
+{
+    if (!ecc_key_table_match(key))
+        return NULL;
+
+    return key->table->sp;
+}
+#endif /* WOLFSSL_SP_ECC_TABLE */
+
+#ifdef WC_ECC_KEY_TABLE_FP
+/* Computes kA*A + kB*B = C where B is the public key of key, using the key's
+ * LUT for B when it has a usable one. */
+static int ecc_key_table_mul2add(ecc_key* key, ecc_point* A, mp_int* kA,
+    ecc_point* B, mp_int* kB, ecc_point* C, mp_int* a, mp_int* modulus)
+{
+    if (ecc_key_table_match(key) && key->table->fp.LUT_set) {
+        return ecc_mul2add_lut(A, kA, B, kB, C, a, modulus, &key->table->fp,
+                                                                     key->heap);
+    }
+
+    return ecc_mul2add(A, kA, B, kB, C, a, modulus, key->heap);
+}
+
+/* Build the fixed point LUT for the public key into the table */
+static int ecc_key_table_gen_fp(ecc_key_table* table, ecc_key* key)
+{
+    int      err;
+    mp_digit mp;
+    mp_int   mu;
+    DECLARE_CURVE_SPECS(curve, 2);
+
+    ALLOC_CURVE_SPECS(2);
+
+    err = mp_init(&mu);
+    if (err == MP_OKAY) {
+        err = wc_ecc_curve_load(key->dp, &curve,
+                                    ECC_CURVE_FIELD_PRIME | ECC_CURVE_FIELD_AF);
+    }
+    if (err == MP_OKAY)
+        err = mp_montgomery_setup(curve->prime, &mp);
+    if (err == MP_OKAY)
+        err = mp_montgomery_calc_normalization(&mu, curve->prime);
+    if (err == MP_OKAY)
+        err = add_entry(&table->fp, &key->pubkey);
+    if (err == MP_OKAY)
+        err = build_lut(&table->fp, curve->Af, curve->prime, mp, &mu);
+
+    mp_clear(&mu);
+    wc_ecc_curve_free(curve);
+    FREE_CURVE_SPECS();
+
+    return err;
+}
+#endif /* WC_ECC_KEY_TABLE_FP */
+
+#ifdef WOLFSSL_SP_ECC_TABLE
+/* Generate the SP table for the public key into the table */
+static int ecc_key_table_gen_sp(ecc_key_table* table, ecc_key* key, int bits)
+{
+    int    err = BAD_FUNC_ARG;
+    word32 len = 0;
+    int    i;
+
+    /* first pass gets the length, second generates */
+    for (i = 0; i < 2; i++) {
+    #ifndef WOLFSSL_SP_NO_256
+        if (bits == 256) {
+            err = sp_ecc_gen_table_256(&key->pubkey, table->sp, &len,
+                                                                   table->heap);
+        }
+    #endif
+    #ifdef WOLFSSL_SP_384
+        if (bits == 384) {
+            err = sp_ecc_gen_table_384(&key->pubkey, table->sp, &len,
+                                                                   table->heap);
+        }
+    #endif
+        if (err != LENGTH_ONLY_E)
+            break;
+
+        table->sp = (byte*)XMALLOC(len, table->heap, DYNAMIC_TYPE_ECC);
+        if (table->sp == NULL) {
+            err = MEMORY_E;
+            break;
+        }
+    }
+
+    return err;
+}
+#endif /* WOLFSSL_SP_ECC_TABLE */
+
+/* Generate a table of multiples of the public key to speed up verifying
+ * signatures made with it. The table is used for verification once set on a
+ * key with wc_ecc_set_key_table().
+ *
+ * key    [in]  Key with public part to make the table for.
+ * table  [out] New table, free with wc_ecc_key_table_free().
+ * heap   [in]  Heap hint for the table.
+ * returns BAD_FUNC_ARG when key or table is NULL or key has no public part,
+ * NOT_COMPILED_IN when tables aren't used when verifying on the key's curve,
+ * MEMORY_E on allocation failure and 0 on success.
+ */
+int wc_ecc_key_table_new(ecc_key* key, ecc_key_table** table, void* heap)
+{
+    int err = 0;
+    int spBits;
+    ecc_key_table* t;
+
+    if (key == NULL || table == NULL) {
+        return BAD_FUNC_ARG;
+    }
+    if (wc_ecc_is_valid_idx(key->idx) != 1 || key->dp == NULL ||
+            (key->type != ECC_PUBLICKEY && key->type != ECC_PRIVATEKEY)) {
+        return BAD_FUNC_ARG;
+    }
+
+    spBits = ecc_key_table_sp_bits(key);
+#ifndef WOLFSSL_SP_ECC_TABLE
+    if (spBits != 0) {
+        return NOT_COMPILED_IN;
+    }
+#endif
+#ifndef WC_ECC_KEY_TABLE_FP
+    if (spBits == 0) {
+        return NOT_COMPILED_IN;
+    }
+#endif
+
+    t = (ecc_key_table*)XMALLOC(sizeof(ecc_key_table), heap, DYNAMIC_TYPE_ECC);
+    if (t == NULL) {
+        return MEMORY_E;
+    }
+    XMEMSET(t, 0, sizeof(ecc_key_table));
+    t->heap = heap;
+    t->curveId = key->dp->id;
+
+    t->pub = wc_ecc_new_point_h(heap);
+    if (t->pub == NULL) {
+        err = MEMORY_E;
+    }
+    if (err == 0)
+        err = wc_ecc_copy_point(&key->pubkey, t->pub);
+
+#ifdef WOLFSSL_SP_ECC_TABLE
+    if (err == 0 && spBits != 0)
+        err = ecc_key_table_gen_sp(t, key, spBits);
+#endif
+#ifdef WC_ECC_KEY_TABLE_FP
+    if (err == 0 && spBits == 0)
+        err = ecc_key_table_gen_fp(t, key);
+#endif
+
+    if (err != 0) {
+        wc_ecc_key_table_free(t);
+        t = NULL;
+    }
+    *table = t;
+
+    return err;
+}
+
+/* Free a table made by wc_ecc_key_table_new(). Keys the table is set on must
+ * not be used to verify afterwards. */
+void wc_ecc_key_table_free(ecc_key_table* table)
+{
+    void* heap;
+
+    if (table == NULL) {
+        return;
+    }
+    heap = table->heap;
+
+#ifdef WC_ECC_KEY_TABLE_FP
+    if (table->fp.g != NULL) {
+        unsigned x;
+
+        for (x = 0; x < (1U<<FP_LUT); x++) {
+            wc_ecc_del_point(table->fp.LUT[x]);
+        }
+        wc_ecc_del_point(table->fp.g);
+        mp_clear(&table->fp.mu);
+    }
+#endif
+#ifdef WOLFSSL_SP_ECC_TABLE
+    if (table->sp != NULL) {
+        XFREE(table->sp, heap, DYNAMIC_TYPE_ECC);
+    }
+#endif
+    wc_ecc_del_point_h(table->pub, heap);
+    XFREE(table, heap, DYNAMIC_TYPE_ECC);
+    (void)heap;
+}
+
+/* Use the table when verifying with the key. The table is not owned by the
+ * key and must outlive its use. It is ignored if the key's public part no
+ * longer matches the table.
+ *
+ * key    [in] Key to verify with.
+ * table  [in] Table for the key's public part, NULL to stop using one.
+ * returns BAD_FUNC_ARG when key is NULL, ECC_BAD_ARG_E when the table was
+ * made for a different key and 0 on success.
+ */
+int wc_ecc_set_key_table(ecc_key* key, ecc_key_table* table)
+{
+    if (key == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    key->table = table;
+    if (table != NULL && !ecc_key_table_match(key)) {
+        key->table = NULL;
+        return ECC_BAD_ARG_E;
+    }
+
+    return 0;
+}
+
+#endif /* WOLFSSL_ECC_KEY_TABLE */
+
 #ifdef HAVE_ECC_ENCRYPT
 
 
@@ -36,8 +36,20 @@
 #if defined(OPENSSL_EXTRA) || defined(DEBUG_WOLFSSL_VERBOSE)
 static wolfSSL_Mutex debug_mutex; /* mutex for access to debug structure */
 
-/* accessing any node from the queue should be wrapped in a lock of
- * debug_mutex */
+#ifdef ERROR_QUEUE_PER_THREAD
+    /* every thread has its own queue, errors raised in one thread are not
+     * seen by others and no locking is needed */
+    #define ERRQ_T           THREAD_LS_T
+    #define ERRQ_LOCK()      0
+    #define ERRQ_UNLOCK()
+#else
+    /* accessing any node from the queue should be wrapped in a lock of
+     * debug_mutex */
+    #define ERRQ_T
+    #define ERRQ_LOCK()      wc_LockMutex(&debug_mutex)
+    #define ERRQ_UNLOCK()    wc_UnLockMutex(&debug_mutex)
+#endif
+
 static void* wc_error_heap;
 struct wc_error_queue {
     void*  heap; /* the heap hint used with nodes creation */
@@ -48,19 +60,47 @@ struct wc_error_queue {
     int    value;
     int    line;
 };
-volatile struct wc_error_queue* wc_errors;
-static struct wc_error_queue* wc_current_node;
-static struct wc_error_queue* wc_last_node;
+static ERRQ_T volatile struct wc_error_queue* wc_errors;
+static ERRQ_T struct wc_error_queue* wc_current_node;
+static ERRQ_T struct wc_error_queue* wc_last_node;
 /* pointer to last node in queue to make insertion O(1) */
 #endif
 
 #ifdef WOLFSSL_FUNC_TIME
-/* WARNING: This code is only to be used for debugging performance.
- *          The code is not thread-safe.
- *          Do not use WOLFSSL_FUNC_TIME in production code.
+/* Call counts and cycles spent in each timed function.
+ * Every thread updates its own counters under their own lock, which only
+ * readers contend for. The counters are kept on a list, guarded by
+ * func_time_mutex, so they can be merged when read and freed on cleanup.
+ * With pthreads, the counters of a thread that exits are folded into
+ * wc_func_exited_* and freed. Without thread local storage all threads share
+ * one set of counters.
  */
-static double wc_func_start[WC_FUNC_COUNT];
-static double wc_func_time[WC_FUNC_COUNT] = { 0, };
+typedef struct wc_FuncTimeStats {
+    struct wc_FuncTimeStats* next;
+    wolfSSL_Mutex lock;    /* guards cycles and calls */
+    word64 start[WC_FUNC_COUNT];
+    word64 cycles[WC_FUNC_COUNT];
+    word64 calls[WC_FUNC_COUNT];
+} wc_FuncTimeStats;
+
+#if defined(WOLFSSL_PTHREADS) && defined(HAVE_THREAD_LS)
+    #define WC_FUNC_TIME_THREAD_EXIT
+#endif
+
+static wolfSSL_Mutex func_time_mutex;
+static wc_FuncTimeStats* wc_func_stats = NULL;
+/* counters of threads that have exited, guarded by func_time_mutex */
+static word64 wc_func_exited_cycles[WC_FUNC_COUNT];
+static word64 wc_func_exited_calls[WC_FUNC_COUNT];
+/* bumped on cleanup so threads don't use counters that have been freed */
+static int wc_func_gen = 0;
+static THREAD_LS_T wc_FuncTimeStats* wc_func_local = NULL;
+static THREAD_LS_T int wc_func_local_gen = 0;
+#ifdef WC_FUNC_TIME_THREAD_EXIT
+/* its destructor runs when a thread with counters exits */
+static pthread_key_t wc_func_key;
+#endif
+
 static const char* wc_func_name[WC_FUNC_COUNT] = {
     "SendHelloRequest",
     "DoHelloRequest",
@@ -98,17 +138,102 @@ static const char* wc_func_name[WC_FUNC_COUNT] = {
     "DoEarlyData",
 };
 
-#include <sys/time.h>
+#if !defined(__GNUC__) || (!defined(__x86_64__) && !defined(__i386__) && \
+                           !defined(__aarch64__))
+    #include <sys/time.h>
+#endif
 
-/* WARNING: This function is not portable. */
-static WC_INLINE double current_time(int reset)
+/* Read the cycle counter, microseconds where there is none to read.
+ * WARNING: The fallback is not portable. */
+static WC_INLINE word64 current_cycles(void)
 {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    word32 lo, hi;
+
+    __asm__ __volatile__ ("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((word64)hi << 32) | lo;
+#elif defined(__GNUC__) && defined(__aarch64__)
+    word64 cnt;
+
+    __asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r"(cnt));
+    return cnt;
+#else
     struct timeval tv;
+
     gettimeofday(&tv, 0);
-    (void)reset;
+    return (word64)tv.tv_sec * 1000000 + (word64)tv.tv_usec;
+#endif
+}
 
-    return (double)tv.tv_sec + (double)tv.tv_usec / 1000000;
+/* Get the counters of the calling thread, allocated and put on the list on
+ * first use.
+ *
+ * returns NULL when the counters can't be allocated.
+ */
+static wc_FuncTimeStats* wc_FuncTimeLocal(void)
+{
+    wc_FuncTimeStats* stats = wc_func_local;
+
+    if (stats != NULL && wc_func_local_gen == wc_func_gen)
+        return stats;
+
+    stats = (wc_FuncTimeStats*)XMALLOC(sizeof(wc_FuncTimeStats), NULL,
+                                       DYNAMIC_TYPE_LOG);
+    if (stats == NULL)
+        return NULL;
+    XMEMSET(stats, 0, sizeof(wc_FuncTimeStats));
+    if (wc_InitMutex(&stats->lock) != 0) {
+        XFREE(stats, NULL, DYNAMIC_TYPE_LOG);
+        return NULL;
+    }
+
+    if (wc_LockMutex(&func_time_mutex) != 0) {
+        wc_FreeMutex(&stats->lock);
+        XFREE(stats, NULL, DYNAMIC_TYPE_LOG);
+        return NULL;
+    }
+    stats->next = wc_func_stats;
+    wc_func_stats = stats;
+    wc_func_local_gen = wc_func_gen;
+#ifdef WC_FUNC_TIME_THREAD_EXIT
+    if (pthread_setspecific(wc_func_key, stats) != 0) {
+        WOLFSSL_MSG("Counters of this thread kept until cleanup");
+    }
+#endif
+    wc_UnLockMutex(&func_time_mutex);
+
+    wc_func_local = stats;
+    return stats;
 }
+
+#ifdef WC_FUNC_TIME_THREAD_EXIT
+/* Fold the counters of an exiting thread into wc_func_exited_* and free them.
+ * Not called for counters freed by cleanup as it deletes the key. */
+static void wc_FuncTimeThreadExit(void* arg)
+{
+    wc_FuncTimeStats* stats = (wc_FuncTimeStats*)arg;
+    wc_FuncTimeStats** prev;
+    int i;
+
+    wc_func_local = NULL;
+    if (wc_LockMutex(&func_time_mutex) != 0)
+        return;
+    for (prev = &wc_func_stats; *prev != NULL; prev = &(*prev)->next) {
+        if (*prev == stats) {
+            *prev = stats->next;
+            break;
+        }
+    }
+    for (i = 0; i < WC_FUNC_COUNT; i++) {
+        wc_func_exited_cycles[i] += stats->cycles[i];
+        wc_func_exited_calls[i]  += stats->calls[i];
+    }
+    wc_UnLockMutex(&func_time_mutex);
+
+    wc_FreeMutex(&stats->lock);
+    XFREE(stats, NULL, DYNAMIC_TYPE_LOG);
+}
+#endif
 #endif /* WOLFSSL_FUNC_TIME */
 
 #ifdef DEBUG_WOLFSSL
@@ -170,41 +295,203 @@ void wolfSSL_Debugging_OFF(void)
 }
 
 #ifdef WOLFSSL_FUNC_TIME
-/* WARNING: This code is only to be used for debugging performance.
- *          The code is not thread-safe.
- *          Do not use WOLFSSL_FUNC_TIME in production code.
- */
 void WOLFSSL_START(int funcNum)
 {
-    double now = current_time(0) * 1000.0;
+    wc_FuncTimeStats* stats;
+    word64 now;
+
+    if (funcNum < 0 || funcNum >= WC_FUNC_COUNT)
+        return;
+    stats = wc_FuncTimeLocal();
+    if (stats == NULL)
+        return;
+
+    now = current_cycles();
 #ifdef WOLFSSL_FUNC_TIME_LOG
-    fprintf(stderr, "%17.3f: START - %s\n", now, wc_func_name[funcNum]);
+    fprintf(stderr, "%20llu: START - %s\n", (unsigned long long)now,
+            wc_func_name[funcNum]);
 #endif
-    wc_func_start[funcNum] = now;
+    stats->start[funcNum] = now;
 }
 
 void WOLFSSL_END(int funcNum)
 {
-    double now = current_time(0) * 1000.0;
-    wc_func_time[funcNum] += now - wc_func_start[funcNum];
+    wc_FuncTimeStats* stats;
+    word64 now = current_cycles();
+
+    if (funcNum < 0 || funcNum >= WC_FUNC_COUNT)
+        return;
+    stats = wc_FuncTimeLocal();
+    if (stats == NULL || stats->start[funcNum] == 0)
+        return;
+
+    if (wc_LockMutex(&stats->lock) == 0) {
+        stats->cycles[funcNum] += now - stats->start[funcNum];
+        stats->calls[funcNum]++;
+        wc_UnLockMutex(&stats->lock);
+    }
+    stats->start[funcNum] = 0;
 #ifdef WOLFSSL_FUNC_TIME_LOG
-    fprintf(stderr, "%17.3f: END   - %s\n", now, wc_func_name[funcNum]);
+    fprintf(stderr, "%20llu: END   - %s\n", (unsigned long long)now,
+            wc_func_name[funcNum]);
 #endif
 }
 
+/* Print the average cycles, over count runs, spent in each timed function. */
 void WOLFSSL_TIME(int count)
 {
     int i;
+    word64 calls, cycles;
     double avg, total = 0;
 
+    if (count <= 0)
+        count = 1;
+
     for (i = 0; i < WC_FUNC_COUNT; i++) {
-        if (wc_func_time[i] > 0) {
-            avg = wc_func_time[i] / count;
-            fprintf(stderr, "%8.3f ms: %s\n", avg, wc_func_name[i]);
+        if (wc_FuncTimeGet(i, &calls, &cycles) == 0 && calls > 0) {
+            avg = (double)cycles / count;
+            fprintf(stderr, "%14.0f cycles: %s (%llu calls)\n", avg,
+                    wc_func_name[i], (unsigned long long)calls);
             total += avg;
         }
     }
-    fprintf(stderr, "%8.3f ms\n", total);
+    fprintf(stderr, "%14.0f cycles\n", total);
+}
+
+/* Get the name of a timed function.
+ *
+ * funcNum  One of the wc_FuncNum values.
+ * returns NULL when funcNum is out of range.
+ */
+const char* wc_FuncTimeName(int funcNum)
+{
+    if (funcNum < 0 || funcNum >= WC_FUNC_COUNT)
+        return NULL;
+    return wc_func_name[funcNum];
+}
+
+/* Get the number of calls to, and cycles spent in, a timed function summed
+ * over all threads.
+ *
+ * funcNum  One of the wc_FuncNum values.
+ * calls    Number of completed calls. May be NULL.
+ * cycles   Cycles spent in the completed calls. May be NULL.
+ * returns BAD_FUNC_ARG when funcNum is out of range, BAD_MUTEX_E when the
+ *         lock fails and 0 otherwise.
+ */
+int wc_FuncTimeGet(int funcNum, word64* calls, word64* cycles)
+{
+    wc_FuncTimeStats* stats;
+    word64 totalCalls, totalCycles;
+
+    if (funcNum < 0 || funcNum >= WC_FUNC_COUNT)
+        return BAD_FUNC_ARG;
+
+    if (wc_LockMutex(&func_time_mutex) != 0)
+        return BAD_MUTEX_E;
+    totalCalls  = wc_func_exited_calls[funcNum];
+    totalCycles = wc_func_exited_cycles[funcNum];
+    for (stats = wc_func_stats; stats != NULL; stats = stats->next) {
+        if (wc_LockMutex(&stats->lock) != 0)
+            continue;
+        totalCalls  += stats->calls[funcNum];
+        totalCycles += stats->cycles[funcNum];
+        wc_UnLockMutex(&stats->lock);
+    }
+    wc_UnLockMutex(&func_time_mutex);
+
+    if (calls != NULL)
+        *calls = totalCalls;
+    if (cycles != NULL)
+        *cycles = totalCycles;
+    return 0;
+}
+
+/* Call cb with the merged counters of every timed function that has been
+ * called. Stops early when cb returns non-zero.
+ *
+ * returns BAD_FUNC_ARG when cb is NULL, otherwise the last value returned
+ *         from cb or 0 when there is nothing to report.
+ */
+int wc_FuncTimeDump(wc_FuncTimeCb cb, void* ctx)
+{
+    int i, ret = 0;
+    word64 calls, cycles;
+
+    if (cb == NULL)
+        return BAD_FUNC_ARG;
+
+    for (i = 0; i < WC_FUNC_COUNT && ret == 0; i++) {
+        ret = wc_FuncTimeGet(i, &calls, &cycles);
+        if (ret == 0 && calls > 0)
+            ret = cb(wc_func_name[i], calls, cycles, ctx);
+    }
+
+    return ret;
+}
+
+/* Zero the counters of all threads. A call being timed while resetting may
+ * be counted with its cycles lost. */
+void wc_FuncTimeReset(void)
+{
+    wc_FuncTimeStats* stats;
+
+    if (wc_LockMutex(&func_time_mutex) != 0)
+        return;
+    XMEMSET(wc_func_exited_cycles, 0, sizeof(wc_func_exited_cycles));
+    XMEMSET(wc_func_exited_calls, 0, sizeof(wc_func_exited_calls));
+    for (stats = wc_func_stats; stats != NULL; stats = stats->next) {
+        if (wc_LockMutex(&stats->lock) != 0)
+            continue;
+        XMEMSET(stats->cycles, 0, sizeof(stats->cycles));
+        XMEMSET(stats->calls, 0, sizeof(stats->calls));
+        wc_UnLockMutex(&stats->lock);
+    }
+    wc_UnLockMutex(&func_time_mutex);
+}
+
+/* Internal function that is called by wolfCrypt_Init() */
+int wc_FuncTimeInit(void)
+{
+    if (wc_InitMutex(&func_time_mutex) != 0) {
+        WOLFSSL_MSG("Bad Init Mutex");
+        return BAD_MUTEX_E;
+    }
+#ifdef WC_FUNC_TIME_THREAD_EXIT
+    if (pthread_key_create(&wc_func_key, wc_FuncTimeThreadExit) != 0) {
+        WOLFSSL_MSG("Bad thread key create");
+        wc_FreeMutex(&func_time_mutex);
+        return BAD_MUTEX_E;
+    }
+#endif
+    return 0;
+}
+
+/* Internal function that is called by wolfCrypt_Cleanup(). Frees the counters
+ * of all threads, no timed function may be running. */
+int wc_FuncTimeCleanup(void)
+{
+    wc_FuncTimeStats* stats;
+    wc_FuncTimeStats* next;
+
+#ifdef WC_FUNC_TIME_THREAD_EXIT
+    pthread_key_delete(wc_func_key);
+#endif
+    for (stats = wc_func_stats; stats != NULL; stats = next) {
+        next = stats->next;
+        wc_FreeMutex(&stats->lock);
+        XFREE(stats, NULL, DYNAMIC_TYPE_LOG);
+    }
+    wc_func_stats = NULL;
+    XMEMSET(wc_func_exited_cycles, 0, sizeof(wc_func_exited_cycles));
+    XMEMSET(wc_func_exited_calls, 0, sizeof(wc_func_exited_calls));
+    wc_func_gen++;
+
+    if (wc_FreeMutex(&func_time_mutex) != 0) {
+        WOLFSSL_MSG("Bad Mutex free");
+        return BAD_MUTEX_E;
+    }
+    return 0;
 }
 #endif
 
@@ -392,7 +679,7 @@ void WOLFSSL_ERROR(int error)
         (void)usrCtx; /* a user ctx for future flexibility */
         (void)func;
 
-        if (wc_LockMutex(&debug_mutex) != 0) {
+        if (ERRQ_LOCK() != 0) {
             WOLFSSL_MSG("Lock debug mutex failed");
             XSNPRINTF(buffer, sizeof(buffer),
                     "wolfSSL error occurred, error = %d", error);
@@ -422,7 +709,7 @@ void WOLFSSL_ERROR(int error)
             }
             #endif
 
-            wc_UnLockMutex(&debug_mutex);
+            ERRQ_UNLOCK();
         }
     #else
         XSNPRINTF(buffer, sizeof(buffer),
@@ -495,7 +782,7 @@ int wc_PeekErrorNode(int idx, const char **file, const char **reason,
 {
     struct wc_error_queue* err;
 
-    if (wc_LockMutex(&debug_mutex) != 0) {
+    if (ERRQ_LOCK() != 0) {
         WOLFSSL_MSG("Lock debug mutex failed");
         return BAD_MUTEX_E;
     }
@@ -510,7 +797,7 @@ int wc_PeekErrorNode(int idx, const char **file, const char **reason,
         for (i = 0; i < idx; i++) {
             if (err == NULL) {
                 WOLFSSL_MSG("Error node not found. Bad index?");
-                wc_UnLockMutex(&debug_mutex);
+                ERRQ_UNLOCK();
                 return BAD_FUNC_ARG;
             }
             err = err->next;
@@ -519,7 +806,7 @@ int wc_PeekErrorNode(int idx, const char **file, const char **reason,
 
     if (err == NULL) {
         WOLFSSL_MSG("No Errors in queue");
-        wc_UnLockMutex(&debug_mutex);
+        ERRQ_UNLOCK();
         return BAD_STATE_E;
     }
 
@@ -535,7 +822,7 @@ int wc_PeekErrorNode(int idx, const char **file, const char **reason,
         *line = err->line;
     }
 
-    wc_UnLockMutex(&debug_mutex);
+    ERRQ_UNLOCK();
 
     return err->value;
 }
@@ -556,7 +843,7 @@ int wc_PullErrorNode(const char **file, const char **reason, int *line)
     struct wc_error_queue* err;
     int value;
 
-    if (wc_LockMutex(&debug_mutex) != 0) {
+    if (ERRQ_LOCK() != 0) {
         WOLFSSL_MSG("Lock debug mutex failed");
         return BAD_MUTEX_E;
     }
@@ -564,7 +851,7 @@ int wc_PullErrorNode(const char **file, const char **reason, int *line)
     err = wc_current_node;
     if (err == NULL) {
         WOLFSSL_MSG("No Errors in queue");
-        wc_UnLockMutex(&debug_mutex);
+        ERRQ_UNLOCK();
         return BAD_STATE_E;
     }
 
@@ -582,7 +869,7 @@ int wc_PullErrorNode(const char **file, const char **reason, int *line)
 
     value = err->value;
     wc_current_node = err->next;
-    wc_UnLockMutex(&debug_mutex);
+    ERRQ_UNLOCK();
 
     return value;
 }
@@ -590,7 +877,8 @@ int wc_PullErrorNode(const char **file, const char **reason, int *line)
 
 /* create new error node and add it to the queue
  * buffers are assumed to be of size WOLFSSL_MAX_ERROR_SZ for this internal
- * function. debug_mutex should be locked before a call to this function. */
+ * function. debug_mutex should be locked before a call to this function unless
+ * each thread has its own queue. */
 int wc_AddErrorNode(int error, int line, char* buf, char* file)
 {
 #if defined(NO_ERROR_QUEUE)
@@ -678,7 +966,7 @@ void wc_RemoveErrorNode(int idx)
 {
     struct wc_error_queue* current;
 
-    if (wc_LockMutex(&debug_mutex) != 0) {
+    if (ERRQ_LOCK() != 0) {
         WOLFSSL_MSG("Lock debug mutex failed");
         return;
     }
@@ -704,7 +992,7 @@ void wc_RemoveErrorNode(int idx)
         XFREE(current, current->heap, DYNAMIC_TYPE_LOG);
     }
 
-    wc_UnLockMutex(&debug_mutex);
+    ERRQ_UNLOCK();
 }
 
 
@@ -715,7 +1003,7 @@ void wc_ClearErrorNodes(void)
 #if defined(DEBUG_WOLFSSL) || defined(WOLFSSL_NGINX) || \
     defined(OPENSSL_EXTRA) || defined(DEBUG_WOLFSSL_VERBOSE)
 
-    if (wc_LockMutex(&debug_mutex) != 0) {
+    if (ERRQ_LOCK() != 0) {
         WOLFSSL_MSG("Lock debug mutex failed");
         return;
     }
@@ -736,7 +1024,7 @@ void wc_ClearErrorNodes(void)
     wc_errors       = NULL;
     wc_last_node    = NULL;
     wc_current_node = NULL;
-    wc_UnLockMutex(&debug_mutex);
+    ERRQ_UNLOCK();
 #endif /* DEBUG_WOLFSSL || WOLFSSL_NGINX */
 }
 
@@ -753,6 +1041,8 @@ int wc_SetLoggingHeap(void* h)
 
 
 /* frees all nodes in the queue
+ * With ERROR_QUEUE_PER_THREAD only the calling thread's queue is freed, each
+ * thread should call this before exiting.
  *
  * id  this is the thread id
  */
@@ -761,7 +1051,7 @@ int wc_ERR_remove_state(void)
     struct wc_error_queue* current;
     struct wc_error_queue* next;
 
-    if (wc_LockMutex(&debug_mutex) != 0) {
+    if (ERRQ_LOCK() != 0) {
         WOLFSSL_MSG("Lock debug mutex failed");
         return BAD_MUTEX_E;
     }
@@ -776,8 +1066,9 @@ int wc_ERR_remove_state(void)
 
     wc_errors          = NULL;
     wc_last_node       = NULL;
+    wc_current_node    = NULL;
 
-    wc_UnLockMutex(&debug_mutex);
+    ERRQ_UNLOCK();
 
     return 0;
 }
@@ -803,7 +1094,7 @@ void wc_ERR_print_errors_cb(int (*cb)(const char *str, size_t len, void *u),
         return;
     }
 
-    if (wc_LockMutex(&debug_mutex) != 0)
+    if (ERRQ_LOCK() != 0)
     {
         WOLFSSL_MSG("Lock debug mutex failed");
     }
@@ -825,8 +1116,9 @@ void wc_ERR_print_errors_cb(int (*cb)(const char *str, size_t len, void *u),
         /* set global pointers to match having been freed */
         wc_errors = NULL;
         wc_last_node = NULL;
+        wc_current_node = NULL;
 
-        wc_UnLockMutex(&debug_mutex);
+        ERRQ_UNLOCK();
     }
 }
 
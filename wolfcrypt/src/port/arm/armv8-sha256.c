@@ -1376,6 +1376,40 @@ int wc_Sha256Copy(wc_Sha256* src, wc_Sha256* dst)
     return ret;
 }
 
+/* Calculate the SHA-256 hashes of many messages.
+ * The messages are hashed one after another.
+ *
+ * data   The messages to hash.
+ * len    Lengths of the messages.
+ * hash   Buffers to hold the hash results. Each WC_SHA256_DIGEST_SIZE bytes.
+ * count  Number of messages.
+ * returns 0 on success and BAD_FUNC_ARG when a parameter is invalid.
+ */
+int wc_Sha256HashMulti(const byte* data[], const word32 len[], byte* hash[],
+                       word32 count)
+{
+    int       ret = 0;
+    word32    i;
+    wc_Sha256 sha256;
+
+    if (count > 0 && (data == NULL || len == NULL || hash == NULL))
+        return BAD_FUNC_ARG;
+    for (i = 0; i < count; i++) {
+        if ((data[i] == NULL && len[i] > 0) || hash[i] == NULL)
+            return BAD_FUNC_ARG;
+    }
+
+    ret = wc_InitSha256_ex(&sha256, NULL, INVALID_DEVID);
+    for (i = 0; i < count && ret == 0; i++) {
+        ret = wc_Sha256Update(&sha256, data[i], len[i]);
+        if (ret == 0)
+            ret = wc_Sha256Final(&sha256, hash[i]);
+    }
+    wc_Sha256Free(&sha256);
+
+    return ret;
+}
+
 #endif /* !NO_SHA256 */
 
 
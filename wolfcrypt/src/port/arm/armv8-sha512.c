@@ -479,6 +479,40 @@ void wc_Sha512Free(wc_Sha512* sha512)
 #endif
 }
 
+/* Calculate the SHA-512 hashes of many messages.
+ * The messages are hashed one after another.
+ *
+ * data   The messages to hash.
+ * len    Lengths of the messages.
+ * hash   Buffers to hold the hash results. Each WC_SHA512_DIGEST_SIZE bytes.
+ * count  Number of messages.
+ * returns 0 on success and BAD_FUNC_ARG when a parameter is invalid.
+ */
+int wc_Sha512HashMulti(const byte* data[], const word32 len[], byte* hash[],
+                       word32 count)
+{
+    int       ret = 0;
+    word32    i;
+    wc_Sha512 sha512;
+
+    if (count > 0 && (data == NULL || len == NULL || hash == NULL))
+        return BAD_FUNC_ARG;
+    for (i = 0; i < count; i++) {
+        if ((data[i] == NULL && len[i] > 0) || hash[i] == NULL)
+            return BAD_FUNC_ARG;
+    }
+
+    ret = wc_InitSha512_ex(&sha512, NULL, INVALID_DEVID);
+    for (i = 0; i < count && ret == 0; i++) {
+        ret = wc_Sha512Update(&sha512, data[i], len[i]);
+        if (ret == 0)
+            ret = wc_Sha512Final(&sha512, hash[i]);
+    }
+    wc_Sha512Free(&sha512);
+
+    return ret;
+}
+
 #endif /* WOLFSSL_SHA512 */
 
 /* -------------------------------------------------------------------------- */
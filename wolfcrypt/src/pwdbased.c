@@ -171,12 +171,100 @@ int wc_PBKDF1(byte* output, const byte* passwd, int pLen, const byte* salt,
 
 #ifdef HAVE_PBKDF2
 
+#if defined(WC_SHA256_HMAC_ITERATE) && \
+    !(defined(WOLFSSL_ASYNC_CRYPT) && defined(WC_ASYNC_ENABLE_HMAC))
+/* Number of output blocks iterated at the same time. */
+#define PBKDF2_SHA256_BLOCKS    8
+
+/* PBKDF2 with HMAC-SHA256.
+ * The first HMAC of each output block is calculated with the HMAC object and
+ * the remaining iterations are done with the SHA-256 transform directly, on
+ * a number of output blocks at the same time.
+ *
+ * hmac        HMAC object with the password set as the key.
+ * output      Buffer to hold the derived key.
+ * salt        The salt.
+ * sLen        Length of the salt.
+ * iterations  Number of iterations.
+ * kLen        Length of the key to derive.
+ * heap        Dynamic memory allocation hint.
+ * returns 0 on success and MEMORY_E when dynamic memory allocation fails.
+ */
+static int PBKDF2_Sha256(Hmac* hmac, byte* output, const byte* salt, int sLen,
+                         int iterations, int kLen, void* heap)
+{
+    int    ret = 0;
+    word32 i = 1;
+    word32 n;
+    int    currentLen;
+    byte   cnt[4];
+#ifdef WOLFSSL_SMALL_STACK
+    byte*  u;
+#else
+    byte   u[2 * PBKDF2_SHA256_BLOCKS * WC_SHA256_DIGEST_SIZE];
+#endif
+    byte*  t;
+
+#ifdef WOLFSSL_SMALL_STACK
+    u = (byte*)XMALLOC(2 * PBKDF2_SHA256_BLOCKS * WC_SHA256_DIGEST_SIZE, heap,
+                       DYNAMIC_TYPE_TMP_BUFFER);
+    if (u == NULL)
+        return MEMORY_E;
+#endif
+    t = u + PBKDF2_SHA256_BLOCKS * WC_SHA256_DIGEST_SIZE;
+
+    while (ret == 0 && kLen > 0) {
+        /* first iteration of each output block */
+        for (n = 0; ret == 0 && n < PBKDF2_SHA256_BLOCKS &&
+                                (int)(n * WC_SHA256_DIGEST_SIZE) < kLen; n++) {
+            cnt[0] = (byte)(i >> 24);
+            cnt[1] = (byte)(i >> 16);
+            cnt[2] = (byte)(i >>  8);
+            cnt[3] = (byte)(i);
+            i++;
+
+            ret = wc_HmacUpdate(hmac, salt, sLen);
+            if (ret == 0)
+                ret = wc_HmacUpdate(hmac, cnt, sizeof(cnt));
+            if (ret == 0)
+                ret = wc_HmacFinal(hmac, u + n * WC_SHA256_DIGEST_SIZE);
+            if (ret == 0) {
+                XMEMCPY(t + n * WC_SHA256_DIGEST_SIZE,
+                        u + n * WC_SHA256_DIGEST_SIZE, WC_SHA256_DIGEST_SIZE);
+            }
+        }
+
+        if (ret == 0 && iterations > 1) {
+            ret = Sha256HmacIterate((const byte*)hmac->ipad,
+                                    (const byte*)hmac->opad, u, t, n,
+                                    iterations - 1);
+        }
+
+        if (ret == 0) {
+            currentLen = min(kLen, (int)(n * WC_SHA256_DIGEST_SIZE));
+            XMEMCPY(output, t, currentLen);
+            output += currentLen;
+            kLen   -= currentLen;
+        }
+    }
+
+    ForceZero(u, 2 * PBKDF2_SHA256_BLOCKS * WC_SHA256_DIGEST_SIZE);
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(u, heap, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+    (void)heap;
+
+    return ret;
+}
+#endif
+
 int wc_PBKDF2_ex(byte* output, const byte* passwd, int pLen, const byte* salt,
            int sLen, int iterations, int kLen, int hashType, void* heap, int devId)
 {
     word32 i = 1;
     int    hLen;
     int    j, ret;
+    byte   cnt[4];
 #ifdef WOLFSSL_SMALL_STACK
     byte*  buffer;
     Hmac*  hmac;
@@ -214,6 +302,16 @@ int wc_PBKDF2_ex(byte* output, const byte* passwd, int pLen, const byte* salt,
         /* use int hashType here, since HMAC FIPS uses the old unique value */
         ret = wc_HmacSetKey(hmac, hashType, passwd, pLen);
 
+    #if defined(WC_SHA256_HMAC_ITERATE) && \
+        !(defined(WOLFSSL_ASYNC_CRYPT) && defined(WC_ASYNC_ENABLE_HMAC))
+        if (ret == 0 && hashT == WC_HASH_TYPE_SHA256 &&
+                                                    devId == INVALID_DEVID) {
+            ret = PBKDF2_Sha256(hmac, output, salt, sLen, iterations, kLen,
+                                heap);
+            kLen = 0; /* all output derived */
+        }
+    #endif
+
         while (ret == 0 && kLen) {
             int currentLen;
 
@@ -222,15 +320,11 @@ int wc_PBKDF2_ex(byte* output, const byte* passwd, int pLen, const byte* salt,
                 break;
 
             /* encode i */
-            for (j = 0; j < 4; j++) {
-                byte b = (byte)(i >> ((3-j) * 8));
-
-                ret = wc_HmacUpdate(hmac, &b, 1);
-                if (ret != 0)
-                    break;
-            }
-
-            /* check ret from inside for loop */
+            cnt[0] = (byte)(i >> 24);
+            cnt[1] = (byte)(i >> 16);
+            cnt[2] = (byte)(i >>  8);
+            cnt[3] = (byte)(i);
+            ret = wc_HmacUpdate(hmac, cnt, sizeof(cnt));
             if (ret != 0)
                 break;
 
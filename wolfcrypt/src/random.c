@@ -697,8 +697,10 @@ int wc_RNG_TestSeed(const byte* seed, word32 seedSz)
 /* End NIST DRBG Code */
 
 
+/* parent  When not NULL, DRBG to take the seed from instead of the seed
+ *         source. The parent passed the health test when instantiated. */
 static int _InitRng(WC_RNG* rng, byte* nonce, word32 nonceSz,
-                    void* heap, int devId)
+                    void* heap, int devId, WC_RNG* parent)
 {
     int ret = RNG_FAILURE_E;
 #ifdef HAVE_HASHDRBG
@@ -707,6 +709,7 @@ static int _InitRng(WC_RNG* rng, byte* nonce, word32 nonceSz,
 
     (void)nonce;
     (void)nonceSz;
+    (void)parent;
 
     if (rng == NULL)
         return BAD_FUNC_ARG;
@@ -760,7 +763,7 @@ static int _InitRng(WC_RNG* rng, byte* nonce, word32 nonceSz,
     if (nonceSz == 0)
         seedSz = MAX_SEED_SZ;
 
-    if (wc_RNG_HealthTestLocal(0) == 0) {
+    if (parent != NULL || wc_RNG_HealthTestLocal(0) == 0) {
     #ifdef WC_ASYNC_ENABLE_SHA256
         DECLARE_VAR(seed, byte, MAX_SEED_SZ, rng->heap);
         if (seed == NULL)
@@ -785,7 +788,10 @@ static int _InitRng(WC_RNG* rng, byte* nonce, word32 nonceSz,
             ret = MEMORY_E;
         }
         else {
-            ret = wc_GenerateSeed(&rng->seed, seed, seedSz);
+            if (parent != NULL)
+                ret = wc_RNG_GenerateBlock(parent, seed, seedSz);
+            else
+                ret = wc_GenerateSeed(&rng->seed, seed, seedSz);
             if (ret != 0)
                 ret = DRBG_FAILURE;
             else
@@ -841,7 +847,8 @@ WC_RNG* wc_rng_new(byte* nonce, word32 nonceSz, void* heap)
 
     rng = (WC_RNG*)XMALLOC(sizeof(WC_RNG), heap, DYNAMIC_TYPE_RNG);
     if (rng) {
-        int error = _InitRng(rng, nonce, nonceSz, heap, INVALID_DEVID) != 0;
+        int error = _InitRng(rng, nonce, nonceSz, heap, INVALID_DEVID,
+                             NULL) != 0;
         if (error) {
             XFREE(rng, heap, DYNAMIC_TYPE_RNG);
             rng = NULL;
@@ -868,27 +875,169 @@ void wc_rng_free(WC_RNG* rng)
 
 int wc_InitRng(WC_RNG* rng)
 {
-    return _InitRng(rng, NULL, 0, NULL, INVALID_DEVID);
+    return _InitRng(rng, NULL, 0, NULL, INVALID_DEVID, NULL);
 }
 
 
 int wc_InitRng_ex(WC_RNG* rng, void* heap, int devId)
 {
-    return _InitRng(rng, NULL, 0, heap, devId);
+    return _InitRng(rng, NULL, 0, heap, devId, NULL);
 }
 
 
 int wc_InitRngNonce(WC_RNG* rng, byte* nonce, word32 nonceSz)
 {
-    return _InitRng(rng, nonce, nonceSz, NULL, INVALID_DEVID);
+    return _InitRng(rng, nonce, nonceSz, NULL, INVALID_DEVID, NULL);
 }
 
 
 int wc_InitRngNonce_ex(WC_RNG* rng, byte* nonce, word32 nonceSz,
                        void* heap, int devId)
 {
-    return _InitRng(rng, nonce, nonceSz, heap, devId);
+    return _InitRng(rng, nonce, nonceSz, heap, devId, NULL);
+}
+
+#ifdef WC_RNG_POOL
+/* Each thread keeps a parent DRBG, seeded from the seed source and health
+ * tested once, that seeds the DRBGs of new WC_RNG objects. This saves reading
+ * the seed source and running the health test for every new RNG. The new
+ * RNGs reseed from the seed source as usual. The parent is instantiated again
+ * after a fork and after seeding WC_RNG_POOL_RESEED children.
+ */
+#ifndef WC_RNG_POOL_RESEED
+    #define WC_RNG_POOL_RESEED 1024
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <unistd.h>
+    #define RNG_POOL_PID()  ((word32)getpid())
+#else
+    #define RNG_POOL_PID()  0
+#endif
+
+typedef struct RngPool {
+    WC_RNG rng;
+    word32 pid;    /* process the parent was seeded in */
+    word32 count;  /* children seeded since the parent was seeded */
+    byte   init;
+} RngPool;
+
+static THREAD_LS_T RngPool rngPool;
+
+#if defined(WOLFSSL_PTHREADS) && defined(HAVE_THREAD_LS)
+    #define WC_RNG_POOL_THREAD_EXIT
+#endif
+
+#ifdef WC_RNG_POOL_THREAD_EXIT
+/* its destructor frees the parent of a thread that exits */
+static pthread_key_t rngPoolKey;
+static int rngPoolKeyInit = 0;
+
+/* Free the parent DRBG of an exiting thread. Not called after cleanup as it
+ * deletes the key. */
+static void RngPoolThreadExit(void* arg)
+{
+    RngPool* pool = (RngPool*)arg;
+
+    if (pool->init) {
+        wc_FreeRng(&pool->rng);
+        pool->init = 0;
+    }
+}
+#endif
+
+/* Get the calling thread's parent DRBG, instantiating it when needed.
+ *
+ * returns NULL when the parent can't be instantiated.
+ */
+static WC_RNG* RngPoolParent(void)
+{
+    RngPool* pool = &rngPool;
+    word32   pid  = RNG_POOL_PID();
+
+    if (pool->init && (pool->pid != pid ||
+                       pool->count >= WC_RNG_POOL_RESEED)) {
+        wc_FreeRng(&pool->rng);
+        pool->init = 0;
+    }
+    if (!pool->init) {
+        if (_InitRng(&pool->rng, NULL, 0, NULL, INVALID_DEVID, NULL) != 0)
+            return NULL;
+        pool->pid   = pid;
+        pool->count = 0;
+        pool->init  = 1;
+    #ifdef WC_RNG_POOL_THREAD_EXIT
+        if (rngPoolKeyInit && pthread_setspecific(rngPoolKey, pool) != 0) {
+            WOLFSSL_MSG("Parent DRBG of this thread kept until wc_RngPoolFree");
+        }
+    #endif
+    }
+    pool->count++;
+
+    return &pool->rng;
+}
+
+/* Initialize an RNG with a DRBG seeded from the calling thread's parent DRBG.
+ * Falls back to the seed source when the parent is not available.
+ *
+ * rng    RNG to initialize.
+ * heap   Heap hint for the DRBG.
+ * devId  Device identifier.
+ * returns 0 on success.
+ */
+int wc_InitRngPool(WC_RNG* rng, void* heap, int devId)
+{
+    WC_RNG* parent;
+
+    if (rng == NULL)
+        return BAD_FUNC_ARG;
+
+    parent = RngPoolParent();
+    if (parent == NULL || _InitRng(rng, NULL, 0, heap, devId, parent) != 0) {
+        /* parent failed, seed from the seed source */
+        return _InitRng(rng, NULL, 0, heap, devId, NULL);
+    }
+
+    return 0;
+}
+
+/* Free the calling thread's parent DRBG. With pthreads and thread local
+ * storage the parent is also freed when the thread exits, otherwise call
+ * before a thread exits. */
+void wc_RngPoolFree(void)
+{
+    if (rngPool.init) {
+        wc_FreeRng(&rngPool.rng);
+        rngPool.init = 0;
+    }
+}
+
+/* Internal function that is called by wolfCrypt_Init() */
+int wc_RngPoolInit(void)
+{
+#ifdef WC_RNG_POOL_THREAD_EXIT
+    if (pthread_key_create(&rngPoolKey, RngPoolThreadExit) != 0) {
+        WOLFSSL_MSG("Bad thread key create");
+        return BAD_MUTEX_E;
+    }
+    rngPoolKeyInit = 1;
+#endif
+    return 0;
+}
+
+/* Internal function that is called by wolfCrypt_Cleanup(). Frees the calling
+ * thread's parent DRBG. */
+void wc_RngPoolCleanup(void)
+{
+#ifdef WC_RNG_POOL_THREAD_EXIT
+    if (rngPoolKeyInit) {
+        pthread_key_delete(rngPoolKey);
+        rngPoolKeyInit = 0;
+    }
+#endif
+    wc_RngPoolFree();
 }
+#endif /* WC_RNG_POOL */
 
 
 /* place a generated block in output */
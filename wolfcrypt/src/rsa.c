@@ -56,6 +56,9 @@ Possible RSA enable options:
  * NO_RSA:              Overall control of RSA                      default: on (not defined)
  * WC_RSA_BLINDING:     Uses Blinding w/ Private Ops                default: off
                         Note: slower by ~20%
+ * WC_RSA_BLIND_REFRESH: Private Ops per cached blinding pair,      default: 32
+                        pair is squared after each use and then
+                        regenerated from a new random
  * WOLFSSL_KEY_GEN:     Allows Private Key Generation               default: off
  * RSA_LOW_MEM:         NON CRT Private Operations, less memory     default: off
  * WC_NO_RSA_OAEP:      Disables RSA OAEP padding                   default: on (not defined)
@@ -269,6 +272,15 @@ int wc_InitRsaKey_ex(RsaKey* key, void* heap, int devId)
     key->dataLen = 0;
 #ifdef WC_RSA_BLINDING
     key->rng = NULL;
+    key->blind = NULL;
+#endif
+#ifdef HAVE_MP_MONT_CTX
+    key->mont = NULL;
+#endif
+#if (defined(WC_RSA_BLINDING) || defined(HAVE_MP_MONT_CTX)) && \
+    !defined(SINGLE_THREADED)
+    if (wc_InitMutex(&key->cacheMutex) != 0)
+        return BAD_MUTEX_E;
 #endif
 
 #ifdef WOLF_CRYPTO_CB
@@ -509,6 +521,32 @@ static int cc310_RSA_GenerateKeyPair(RsaKey* key, int size, long e)
 }
 #endif /* WOLFSSL_CRYPTOCELL */
 
+/* Free the Montgomery parameters and blinding pair cached on the key. Called
+ * when the key is freed and when new values are loaded into it, so a key
+ * loaded again without wc_FreeRsaKey() doesn't keep the old key's. */
+void wc_RsaFreeCache(RsaKey* key)
+{
+#ifdef WC_RSA_BLINDING
+    if (key->blind != NULL) {
+        mp_forcezero(&key->blind->r);
+        mp_forcezero(&key->blind->rInv);
+        mp_clear(&key->blind->r);
+        mp_clear(&key->blind->rInv);
+        mp_clear(&key->blind->n);
+        XFREE(key->blind, key->heap, DYNAMIC_TYPE_RSA);
+        key->blind = NULL;
+    }
+#endif
+#ifdef HAVE_MP_MONT_CTX
+    if (key->mont != NULL) {
+        ForceZero(key->mont, sizeof(RsaMont));
+        XFREE(key->mont, key->heap, DYNAMIC_TYPE_RSA);
+        key->mont = NULL;
+    }
+#endif
+    (void)key;
+}
+
 int wc_FreeRsaKey(RsaKey* key)
 {
     int ret = 0;
@@ -523,6 +561,12 @@ int wc_FreeRsaKey(RsaKey* key)
     wolfAsync_DevCtxFree(&key->asyncDev, WOLFSSL_ASYNC_MARKER_RSA);
 #endif
 
+    wc_RsaFreeCache(key);
+#if (defined(WC_RSA_BLINDING) || defined(HAVE_MP_MONT_CTX)) && \
+    !defined(SINGLE_THREADED)
+    wc_FreeMutex(&key->cacheMutex);
+#endif
+
 #ifndef WOLFSSL_RSA_PUBLIC_ONLY
     if (key->type == RSA_PRIVATE) {
 #if defined(WOLFSSL_KEY_GEN) || defined(OPENSSL_EXTRA) || !defined(RSA_LOW_MEM)
@@ -2043,6 +2087,170 @@ done:
 }
 
 #else
+#ifdef HAVE_MP_MONT_CTX
+/* Set ctx for modulus m unless it already holds the parameters of m */
+static int RsaUpdateMont(mp_mont_ctx* ctx, mp_int* m)
+{
+    if (mp_cmp(&ctx->m, m) == MP_EQ)
+        return 0;
+    if (mp_mont_ctx_set(ctx, m) != MP_OKAY) {
+        mp_zero(&ctx->m);
+        return MP_INIT_E;
+    }
+    return 0;
+}
+
+/* Get the Montgomery parameters of the moduli used by operation type.
+ * The parameters only depend on the key so they are computed on first use
+ * and kept on the key, they are computed again if the key has changed. */
+static int RsaGetMont(RsaKey* key, int type, RsaMont** mont)
+{
+    int ret = 0;
+
+#ifndef SINGLE_THREADED
+    if (wc_LockMutex(&key->cacheMutex) != 0)
+        return BAD_MUTEX_E;
+#endif
+
+    if (key->mont == NULL) {
+        key->mont = (RsaMont*)XMALLOC(sizeof(RsaMont), key->heap,
+                                                              DYNAMIC_TYPE_RSA);
+        if (key->mont == NULL)
+            ret = MEMORY_E;
+        else
+            XMEMSET(key->mont, 0, sizeof(RsaMont));
+    }
+
+    if (ret == 0) {
+        switch (type) {
+    #ifndef WOLFSSL_RSA_PUBLIC_ONLY
+        case RSA_PRIVATE_DECRYPT:
+        case RSA_PRIVATE_ENCRYPT:
+        #ifdef RSA_LOW_MEM
+            ret = RsaUpdateMont(&key->mont->n, &key->n);
+        #else
+            ret = RsaUpdateMont(&key->mont->p, &key->p);
+            if (ret == 0)
+                ret = RsaUpdateMont(&key->mont->q, &key->q);
+        #endif
+            break;
+    #endif
+        default:
+            ret = RsaUpdateMont(&key->mont->n, &key->n);
+            break;
+        }
+    }
+
+    *mont = key->mont;
+
+#ifndef SINGLE_THREADED
+    wc_UnLockMutex(&key->cacheMutex);
+#endif
+
+    return ret;
+}
+#endif /* HAVE_MP_MONT_CTX */
+
+#if defined(WC_RSA_BLINDING) && !defined(WC_NO_RNG) && \
+    !defined(WOLFSSL_SP_MATH) && !defined(WOLFSSL_RSA_PUBLIC_ONLY)
+
+#ifndef WC_RSA_BLIND_REFRESH
+    #define WC_RSA_BLIND_REFRESH 32
+#endif
+
+/* Make a new blinding pair from a random r, have cacheMutex */
+static int RsaNewBlinding(RsaKey* key, RsaBlind* blind, WC_RNG* rng)
+{
+    int ret;
+
+    ret = mp_rand(&blind->r, get_digit_count(&key->n), rng);
+
+    /* rInv = 1/r mod n */
+    if (ret == 0 && mp_invmod(&blind->r, &key->n, &blind->rInv) != MP_OKAY)
+        ret = MP_INVMOD_E;
+
+    /* r = r^e */
+    if (ret == 0 && mp_exptmod(&blind->r, &key->e, &key->n,
+                                                        &blind->r) != MP_OKAY)
+        ret = MP_EXPTMOD_E;
+
+    if (ret == 0 && mp_copy(&key->n, &blind->n) != MP_OKAY)
+        ret = MP_INIT_E;
+
+    blind->uses = 0;
+
+    return ret;
+}
+
+/* Get the blinding pair for a private operation, rnd = r^e and rndi = 1/r.
+ * Generating a pair costs an inversion and an exponentiation so the pair is
+ * cached on the key. After each use both values are squared, which still
+ * gives a matching pair, and a new random pair is made every
+ * WC_RSA_BLIND_REFRESH uses or when the key's modulus has changed. */
+static int RsaGetBlinding(RsaKey* key, WC_RNG* rng, mp_int* rnd, mp_int* rndi)
+{
+    int ret = 0;
+    RsaBlind* blind;
+
+    if (rng == NULL)
+        return MISSING_RNG_E;
+
+#ifndef SINGLE_THREADED
+    if (wc_LockMutex(&key->cacheMutex) != 0)
+        return BAD_MUTEX_E;
+#endif
+
+    blind = key->blind;
+    if (blind == NULL) {
+        blind = (RsaBlind*)XMALLOC(sizeof(RsaBlind), key->heap,
+                                                              DYNAMIC_TYPE_RSA);
+        if (blind == NULL)
+            ret = MEMORY_E;
+        else if (mp_init_multi(&blind->r, &blind->rInv, &blind->n, NULL, NULL,
+                                                              NULL) != MP_OKAY) {
+            XFREE(blind, key->heap, DYNAMIC_TYPE_RSA);
+            blind = NULL;
+            ret = MP_INIT_E;
+        }
+        else {
+            blind->uses = WC_RSA_BLIND_REFRESH;
+            key->blind = blind;
+        }
+    }
+
+    if (ret == 0 && (blind->uses >= WC_RSA_BLIND_REFRESH ||
+                                       mp_cmp(&blind->n, &key->n) != MP_EQ)) {
+        ret = RsaNewBlinding(key, blind, rng);
+    }
+
+    if (ret == 0 && mp_copy(&blind->r, rnd) != MP_OKAY)
+        ret = MP_INIT_E;
+    if (ret == 0 && mp_copy(&blind->rInv, rndi) != MP_OKAY)
+        ret = MP_INIT_E;
+
+    /* r = r^2, rInv = rInv^2 mod n so the next operation uses a new pair */
+    if (ret == 0 && mp_mulmod(&blind->r, &blind->r, &key->n,
+                                                        &blind->r) != MP_OKAY)
+        ret = MP_MULMOD_E;
+    if (ret == 0 && mp_mulmod(&blind->rInv, &blind->rInv, &key->n,
+                                                     &blind->rInv) != MP_OKAY)
+        ret = MP_MULMOD_E;
+
+    if (blind != NULL) {
+        if (ret == 0)
+            blind->uses++;
+        else
+            blind->uses = WC_RSA_BLIND_REFRESH; /* start over next time */
+    }
+
+#ifndef SINGLE_THREADED
+    wc_UnLockMutex(&key->cacheMutex);
+#endif
+
+    return ret;
+}
+#endif /* WC_RSA_BLINDING && !WC_NO_RNG && !WOLFSSL_SP_MATH */
+
 static int wc_RsaFunctionSync(const byte* in, word32 inLen, byte* out,
                           word32* outLen, int type, RsaKey* key, WC_RNG* rng)
 {
@@ -2061,6 +2269,9 @@ static int wc_RsaFunctionSync(const byte* in, word32 inLen, byte* out,
 #endif
     int    ret = 0;
     word32 keyLen = 0;
+#ifdef HAVE_MP_MONT_CTX
+    RsaMont* mont = NULL;
+#endif
 #endif
 
 #ifdef WOLFSSL_HAVE_SP_RSA
@@ -2192,6 +2403,11 @@ static int wc_RsaFunctionSync(const byte* in, word32 inLen, byte* out,
     if (ret == 0 && mp_read_unsigned_bin(tmp, (byte*)in, inLen) != MP_OKAY)
         ret = MP_READ_E;
 
+#ifdef HAVE_MP_MONT_CTX
+    if (ret == 0)
+        ret = RsaGetMont(key, type, &mont);
+#endif
+
     if (ret == 0) {
         switch(type) {
     #ifndef WOLFSSL_RSA_PUBLIC_ONLY
@@ -2199,16 +2415,8 @@ static int wc_RsaFunctionSync(const byte* in, word32 inLen, byte* out,
         case RSA_PRIVATE_ENCRYPT:
         {
         #if defined(WC_RSA_BLINDING) && !defined(WC_NO_RNG)
-            /* blind */
-            ret = mp_rand(rnd, get_digit_count(&key->n), rng);
-
-            /* rndi = 1/rnd mod n */
-            if (ret == 0 && mp_invmod(rnd, &key->n, rndi) != MP_OKAY)
-                ret = MP_INVMOD_E;
-
-            /* rnd = rnd^e */
-            if (ret == 0 && mp_exptmod(rnd, &key->e, &key->n, rnd) != MP_OKAY)
-                ret = MP_EXPTMOD_E;
+            /* blind, rnd = r^e and rndi = 1/r mod n */
+            ret = RsaGetBlinding(key, rng, rnd, rndi);
 
             /* tmp = tmp*rnd mod n */
             if (ret == 0 && mp_mulmod(tmp, rnd, &key->n, tmp) != MP_OKAY)
@@ -2216,8 +2424,14 @@ static int wc_RsaFunctionSync(const byte* in, word32 inLen, byte* out,
         #endif /* WC_RSA_BLINDING && !WC_NO_RNG */
 
         #ifdef RSA_LOW_MEM      /* half as much memory but twice as slow */
+          #ifdef HAVE_MP_MONT_CTX
+            if (ret == 0 && mp_exptmod_mont(tmp, &key->d, key->d.used,
+                                    &key->n, &mont->n, tmp) != MP_OKAY)
+                ret = MP_EXPTMOD_E;
+          #else
             if (ret == 0 && mp_exptmod(tmp, &key->d, &key->n, tmp) != MP_OKAY)
                 ret = MP_EXPTMOD_E;
+          #endif
         #else
             if (ret == 0) {
             #ifdef WOLFSSL_SMALL_STACK
@@ -2251,6 +2465,17 @@ static int wc_RsaFunctionSync(const byte* in, word32 inLen, byte* out,
                         clearb = 1;
                 }
 
+            #ifdef HAVE_MP_MONT_CTX
+                /* tmpa = tmp^dP mod p */
+                if (ret == 0 && mp_exptmod_mont(tmp, &key->dP, key->dP.used,
+                                    &key->p, &mont->p, tmpa) != MP_OKAY)
+                    ret = MP_EXPTMOD_E;
+
+                /* tmpb = tmp^dQ mod q */
+                if (ret == 0 && mp_exptmod_mont(tmp, &key->dQ, key->dQ.used,
+                                    &key->q, &mont->q, tmpb) != MP_OKAY)
+                    ret = MP_EXPTMOD_E;
+            #else
                 /* tmpa = tmp^dP mod p */
                 if (ret == 0 && mp_exptmod(tmp, &key->dP, &key->p,
                                                                tmpa) != MP_OKAY)
@@ -2260,6 +2485,7 @@ static int wc_RsaFunctionSync(const byte* in, word32 inLen, byte* out,
                 if (ret == 0 && mp_exptmod(tmp, &key->dQ, &key->q,
                                                                tmpb) != MP_OKAY)
                     ret = MP_EXPTMOD_E;
+            #endif
 
                 /* tmp = (tmpa - tmpb) * qInv (mod p) */
                 if (ret == 0 && mp_sub(tmpa, tmpb, tmp) != MP_OKAY)
@@ -2302,8 +2528,14 @@ static int wc_RsaFunctionSync(const byte* in, word32 inLen, byte* out,
     #endif
         case RSA_PUBLIC_ENCRYPT:
         case RSA_PUBLIC_DECRYPT:
+        #ifdef HAVE_MP_MONT_CTX
+            if (mp_exptmod_mont_nct(tmp, &key->e, &key->n, &mont->n,
+                                                                tmp) != MP_OKAY)
+                ret = MP_EXPTMOD_E;
+        #else
             if (mp_exptmod_nct(tmp, &key->e, &key->n, tmp) != MP_OKAY)
                 ret = MP_EXPTMOD_E;
+        #endif
             break;
         default:
             ret = RSA_WRONG_TYPE_E;
@@ -2361,13 +2593,13 @@ static int wc_RsaFunctionAsync(const byte* in, word32 inLen, byte* out,
 #ifdef WOLFSSL_ASYNC_CRYPT_TEST
     if (wc_AsyncTestInit(&key->asyncDev, ASYNC_TEST_RSA_FUNC)) {
         WC_ASYNC_TEST* testDev = &key->asyncDev.test;
-        testDev->rsaFunc.in = in;
-        testDev->rsaFunc.inSz = inLen;
-        testDev->rsaFunc.out = out;
-        testDev->rsaFunc.outSz = outLen;
-        testDev->rsaFunc.type = type;
-        testDev->rsaFunc.key = key;
-        testDev->rsaFunc.rng = rng;
+        testDev->args.rsaFunc.in = in;
+        testDev->args.rsaFunc.inSz = inLen;
+        testDev->args.rsaFunc.out = out;
+        testDev->args.rsaFunc.outSz = outLen;
+        testDev->args.rsaFunc.type = type;
+        testDev->args.rsaFunc.key = key;
+        testDev->args.rsaFunc.rng = rng;
         return WC_PENDING_E;
     }
 #endif /* WOLFSSL_ASYNC_CRYPT_TEST */
@@ -3947,6 +4179,8 @@ int wc_MakeRsaKey(RsaKey* key, int size, long e, WC_RNG* rng)
     if (e < 3 || (e & 1) == 0)
         return BAD_FUNC_ARG;
 
+    wc_RsaFreeCache(key);
+
 #if defined(WOLFSSL_CRYPTOCELL)
 
     return cc310_RSA_GenerateKeyPair(key, size, e);
@@ -3972,10 +4206,10 @@ int wc_MakeRsaKey(RsaKey* key, int size, long e, WC_RNG* rng)
     #else
         if (wc_AsyncTestInit(&key->asyncDev, ASYNC_TEST_RSA_MAKE)) {
             WC_ASYNC_TEST* testDev = &key->asyncDev.test;
-            testDev->rsaMake.rng = rng;
-            testDev->rsaMake.key = key;
-            testDev->rsaMake.size = size;
-            testDev->rsaMake.e = e;
+            testDev->args.rsaMake.rng = rng;
+            testDev->args.rsaMake.key = key;
+            testDev->args.rsaMake.size = size;
+            testDev->args.rsaMake.e = e;
             return WC_PENDING_E;
         }
     #endif
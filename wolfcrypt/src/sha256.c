@@ -281,6 +281,9 @@ static int InitSha256(wc_Sha256* sha256)
         extern int Transform_Sha256_AVX2_RORX_Len(wc_Sha256* sha256,
                                                   const byte* data, word32 len);
         #endif /* HAVE_INTEL_RORX */
+        /* Eight blocks, one from each data pointer, into eight interleaved
+         * states: word i of state j is at s[i * 8 + j]. */
+        extern int Transform_Sha256_AVX2_x8(word32* s, const byte** data);
     #endif /* HAVE_INTEL_AVX2 */
 
 #ifdef __cplusplus
@@ -1487,6 +1490,512 @@ void wc_Sha256Free(wc_Sha256* sha256)
 #endif
 }
 
+#ifdef HAVE_INTEL_AVX2
+/* Number of messages hashed at the same time by the AVX2 transform. */
+#define SHA256_MULTI_LANES    8
+
+/* Start hashing a message in a lane.
+ * The padding, and any data that doesn't fill a block, is put in the lane's
+ * pad buffer.
+ *
+ * s       The interleaved states.
+ * j       The lane.
+ * iv      The initial hash value.
+ * pad     The lane's pad buffer - two blocks.
+ * data    The message.
+ * len     Length of the message.
+ * full    Number of full blocks of message data.
+ * blocks  Number of blocks to process including the padding.
+ */
+static void Sha256MultiStart(word32* s, int j, const word32* iv, byte* pad,
+                             const byte* data, word32 len, word32* full,
+                             word32* blocks)
+{
+    int    i;
+    word32 rem;
+    word32 padLen;
+
+    for (i = 0; i < 8; i++)
+        s[i * SHA256_MULTI_LANES + j] = iv[i];
+
+    *full = len / WC_SHA256_BLOCK_SIZE;
+    rem = len - *full * WC_SHA256_BLOCK_SIZE;
+    padLen = (rem + 1 + 8 > WC_SHA256_BLOCK_SIZE) ? 2 * WC_SHA256_BLOCK_SIZE
+                                                  : WC_SHA256_BLOCK_SIZE;
+    *blocks = *full + padLen / WC_SHA256_BLOCK_SIZE;
+
+    if (rem > 0)
+        XMEMCPY(pad, data + *full * WC_SHA256_BLOCK_SIZE, rem);
+    pad[rem] = 0x80;
+    XMEMSET(pad + rem + 1, 0, padLen - rem - 1 - 4);
+    /* length in bits, big-endian */
+    pad[padLen - 5] = (byte)(len >> 29);
+    pad[padLen - 4] = (byte)(len >> 21);
+    pad[padLen - 3] = (byte)(len >> 13);
+    pad[padLen - 2] = (byte)(len >>  5);
+    pad[padLen - 1] = (byte)(len <<  3);
+}
+
+/* Hash many messages, eight at a time, with the AVX2 transform.
+ * Each lane of the transform works through one message at a time and starts
+ * on the next message not yet hashed when it completes one. Idle lanes process
+ * their pad buffer and the result is ignored. When only one message has data
+ * left to process, it is completed with the single stream transform.
+ *
+ * sha256  wc_Sha256 object, initialized, to complete the last message.
+ * pad     Pad buffers of the lanes - two blocks each.
+ * data    The messages.
+ * len     Lengths of the messages.
+ * hash    Buffers to hold the hash results.
+ * count   Number of messages.
+ * returns 0 on success.
+ */
+static int Sha256HashMulti_AVX2(wc_Sha256* sha256, byte* pad,
+                                const byte* data[], const word32 len[],
+                                byte* hash[], word32 count)
+{
+    int         ret = 0;
+    int         i;
+    int         j;
+    int         last = 0;
+    word32      s[8 * SHA256_MULTI_LANES];
+    word32      iv[8];
+    const byte* in[SHA256_MULTI_LANES];
+    word32      msg[SHA256_MULTI_LANES];
+    word32      blk[SHA256_MULTI_LANES];
+    word32      full[SHA256_MULTI_LANES];
+    word32      blocks[SHA256_MULTI_LANES];
+    word32      next = 0;
+    word32      active = 0;
+
+    XMEMCPY(iv, sha256->digest, sizeof(iv));
+
+    for (j = 0; j < SHA256_MULTI_LANES; j++) {
+        blk[j] = 0;
+        msg[j] = count;
+        if (next < count) {
+            msg[j] = next++;
+            Sha256MultiStart(s, j, iv, pad + j * 2 * WC_SHA256_BLOCK_SIZE,
+                    data[msg[j]], len[msg[j]], &full[j], &blocks[j]);
+            active++;
+        }
+    }
+
+    while (active > 0) {
+        if (active == 1 && next == count) {
+            for (last = 0; msg[last] == count; last++) {
+            }
+            /* Only padding left - do it with the other lanes idle. */
+            if (blk[last] < full[last])
+                break;
+        }
+
+        for (j = 0; j < SHA256_MULTI_LANES; j++) {
+            in[j] = pad + j * 2 * WC_SHA256_BLOCK_SIZE;
+            if (msg[j] == count)
+                continue;
+            if (blk[j] < full[j])
+                in[j] = data[msg[j]] + blk[j] * WC_SHA256_BLOCK_SIZE;
+            else
+                in[j] += (blk[j] - full[j]) * WC_SHA256_BLOCK_SIZE;
+        }
+        Transform_Sha256_AVX2_x8(s, in);
+
+        for (j = 0; j < SHA256_MULTI_LANES; j++) {
+            if (msg[j] == count || ++blk[j] < blocks[j])
+                continue;
+
+            for (i = 0; i < 8; i++) {
+                word32 v = s[i * SHA256_MULTI_LANES + j];
+                hash[msg[j]][i * 4 + 0] = (byte)(v >> 24);
+                hash[msg[j]][i * 4 + 1] = (byte)(v >> 16);
+                hash[msg[j]][i * 4 + 2] = (byte)(v >>  8);
+                hash[msg[j]][i * 4 + 3] = (byte)(v);
+            }
+            blk[j] = 0;
+            msg[j] = count;
+            if (next < count) {
+                msg[j] = next++;
+                Sha256MultiStart(s, j, iv,
+                        pad + j * 2 * WC_SHA256_BLOCK_SIZE, data[msg[j]],
+                        len[msg[j]], &full[j], &blocks[j]);
+            }
+            else {
+                active--;
+            }
+        }
+    }
+
+    if (active == 1) {
+        for (i = 0; i < 8; i++)
+            sha256->digest[i] = s[i * SHA256_MULTI_LANES + last];
+        sha256->loLen = blk[last] * WC_SHA256_BLOCK_SIZE;
+        ret = wc_Sha256Update(sha256,
+                data[msg[last]] + blk[last] * WC_SHA256_BLOCK_SIZE,
+                len[msg[last]] - blk[last] * WC_SHA256_BLOCK_SIZE);
+        if (ret == 0)
+            ret = wc_Sha256Final(sha256, hash[msg[last]]);
+    }
+
+    return ret;
+}
+#endif /* HAVE_INTEL_AVX2 */
+
+/* Calculate the SHA-256 hashes of many messages.
+ * With AVX2, eight messages are hashed at the same time.
+ *
+ * data   The messages to hash.
+ * len    Lengths of the messages.
+ * hash   Buffers to hold the hash results. Each WC_SHA256_DIGEST_SIZE bytes.
+ * count  Number of messages.
+ * returns 0 on success, BAD_FUNC_ARG when a parameter is invalid and MEMORY_E
+ * when dynamic memory allocation fails.
+ */
+int wc_Sha256HashMulti(const byte* data[], const word32 len[], byte* hash[],
+                       word32 count)
+{
+    int     ret = 0;
+    word32  i;
+#ifdef WOLFSSL_SMALL_STACK
+    wc_Sha256* sha256;
+#else
+    wc_Sha256  sha256[1];
+#endif
+#ifdef HAVE_INTEL_AVX2
+#ifdef WOLFSSL_SMALL_STACK
+    byte*   pad;
+#else
+    byte    pad[SHA256_MULTI_LANES * 2 * WC_SHA256_BLOCK_SIZE];
+#endif
+#endif
+
+    if (count > 0 && (data == NULL || len == NULL || hash == NULL))
+        return BAD_FUNC_ARG;
+    for (i = 0; i < count; i++) {
+        if ((data[i] == NULL && len[i] > 0) || hash[i] == NULL)
+            return BAD_FUNC_ARG;
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    sha256 = (wc_Sha256*)XMALLOC(sizeof(wc_Sha256), NULL,
+                                 DYNAMIC_TYPE_TMP_BUFFER);
+    if (sha256 == NULL)
+        return MEMORY_E;
+#endif
+
+    ret = wc_InitSha256_ex(sha256, NULL, INVALID_DEVID);
+    if (ret != 0) {
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(sha256, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    #endif
+        return ret;
+    }
+
+#ifdef HAVE_INTEL_AVX2
+    if (IS_INTEL_AVX2(intel_flags) && count > 1) {
+    #ifdef WOLFSSL_SMALL_STACK
+        pad = (byte*)XMALLOC(SHA256_MULTI_LANES * 2 * WC_SHA256_BLOCK_SIZE,
+                             NULL, DYNAMIC_TYPE_TMP_BUFFER);
+        if (pad == NULL)
+            ret = MEMORY_E;
+        else
+    #endif
+        {
+            ret = Sha256HashMulti_AVX2(sha256, pad, data, len, hash, count);
+        }
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(pad, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    #endif
+    }
+    else
+#endif
+    {
+        for (i = 0; i < count && ret == 0; i++) {
+            ret = wc_Sha256Update(sha256, data[i], len[i]);
+            if (ret == 0)
+                ret = wc_Sha256Final(sha256, hash[i]);
+        }
+    }
+
+    wc_Sha256Free(sha256);
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(sha256, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+
+    return ret;
+}
+
+#if defined(XTRANSFORM) && (!defined(WOLFSSL_ESP32WROOM32_CRYPT) || \
+                             defined(NO_WOLFSSL_ESP32WROOM32_CRYPT_HASH))
+/* Compress one block, in host order words, into the state.
+ *
+ * sha256  wc_Sha256 object used to call the transform.
+ * state   The state to start from.
+ * block   The block of 16 words in host order.
+ * out     The state after the block is processed.
+ * returns 0 on success.
+ */
+static int Sha256TransformWords(wc_Sha256* sha256, const word32* state,
+                                const word32* block, word32* out)
+{
+    int ret;
+
+    XMEMCPY(sha256->digest, state, WC_SHA256_DIGEST_SIZE);
+    XMEMCPY(sha256->buffer, block, WC_SHA256_BLOCK_SIZE);
+#if defined(LITTLE_ENDIAN_ORDER) && (defined(FREESCALE_MMCAU_SHA) || \
+    defined(HAVE_INTEL_AVX1) || defined(HAVE_INTEL_AVX2))
+    /* transform takes the big-endian bytes */
+    #if defined(HAVE_INTEL_AVX1) || defined(HAVE_INTEL_AVX2)
+    if (IS_INTEL_AVX1(intel_flags) || IS_INTEL_AVX2(intel_flags))
+    #endif
+    {
+        ByteReverseWords(sha256->buffer, sha256->buffer, WC_SHA256_BLOCK_SIZE);
+    }
+#endif
+    ret = XTRANSFORM(sha256, (const byte*)sha256->buffer);
+    if (ret == 0)
+        XMEMCPY(out, sha256->digest, WC_SHA256_DIGEST_SIZE);
+
+    return ret;
+}
+
+#ifdef HAVE_INTEL_AVX2
+/* Perform the HMAC iterations of eight chains at a time with the AVX2
+ * transform. The inner and outer hash of each iteration are one block each.
+ *
+ * inner       State after the key XORed with ipad.
+ * outer       State after the key XORed with opad.
+ * u           The last HMAC result of each chain.
+ * t           The XOR of all HMAC results of each chain.
+ * count       Number of chains.
+ * iterations  Number of HMAC operations to perform on each chain.
+ */
+static void Sha256HmacIterate_AVX2(const word32* inner, const word32* outer,
+                                   byte* u, byte* t, word32 count,
+                                   int iterations)
+{
+    int         i;
+    int         j;
+    int         k;
+    word32      c;
+    word32      n;
+    word32      s[8 * 8];
+    word32      tw[8 * 8];
+    word32      blk[8][WC_SHA256_BLOCK_SIZE / sizeof(word32)];
+    const byte* in[8];
+
+    for (j = 0; j < 8; j++) {
+        in[j] = (const byte*)blk[j];
+        XMEMSET(blk[j], 0, WC_SHA256_BLOCK_SIZE);
+        /* padding for 32 bytes after a block - 768 bits */
+        ((byte*)blk[j])[WC_SHA256_DIGEST_SIZE] = 0x80;
+        ((byte*)blk[j])[WC_SHA256_BLOCK_SIZE - 2] = 0x03;
+    }
+
+    for (c = 0; c < count; c += n) {
+        n = min(count - c, 8);
+        XMEMSET(tw, 0, sizeof(tw));
+        for (j = 0; j < (int)n; j++) {
+            XMEMCPY(s, t + (c + j) * WC_SHA256_DIGEST_SIZE,
+                    WC_SHA256_DIGEST_SIZE);
+            for (i = 0; i < 8; i++)
+                tw[i * 8 + j] = ByteReverseWord32(s[i]);
+            XMEMCPY(blk[j], u + (c + j) * WC_SHA256_DIGEST_SIZE,
+                    WC_SHA256_DIGEST_SIZE);
+        }
+
+        for (k = 0; k < iterations; k++) {
+            for (i = 0; i < 8; i++) {
+                for (j = 0; j < 8; j++)
+                    s[i * 8 + j] = inner[i];
+            }
+            Transform_Sha256_AVX2_x8(s, in);
+            for (j = 0; j < 8; j++) {
+                for (i = 0; i < 8; i++)
+                    blk[j][i] = ByteReverseWord32(s[i * 8 + j]);
+            }
+
+            for (i = 0; i < 8; i++) {
+                for (j = 0; j < 8; j++)
+                    s[i * 8 + j] = outer[i];
+            }
+            Transform_Sha256_AVX2_x8(s, in);
+            for (j = 0; j < 8; j++) {
+                for (i = 0; i < 8; i++)
+                    blk[j][i] = ByteReverseWord32(s[i * 8 + j]);
+            }
+            for (i = 0; i < 8 * 8; i++)
+                tw[i] ^= s[i];
+        }
+
+        for (j = 0; j < (int)n; j++) {
+            XMEMCPY(u + (c + j) * WC_SHA256_DIGEST_SIZE, blk[j],
+                    WC_SHA256_DIGEST_SIZE);
+            for (i = 0; i < 8; i++)
+                s[i] = ByteReverseWord32(tw[i * 8 + j]);
+            XMEMCPY(t + (c + j) * WC_SHA256_DIGEST_SIZE, s,
+                    WC_SHA256_DIGEST_SIZE);
+        }
+    }
+
+    ForceZero(s, sizeof(s));
+    ForceZero(tw, sizeof(tw));
+    ForceZero(blk, sizeof(blk));
+}
+#endif /* HAVE_INTEL_AVX2 */
+#endif /* XTRANSFORM */
+
+/* Perform HMAC-SHA256 iterations on 32 byte messages as done by PBKDF2.
+ * For each chain, the HMAC of the last result is calculated and XORed into
+ * the output.
+ * The states after the key XORed with the pads are calculated once and the
+ * transform is called directly, one block for the inner hash and one for the
+ * outer hash. With AVX2, eight chains are processed at a time.
+ *
+ * ipad        The key XORed with ipad - one block.
+ * opad        The key XORed with opad - one block.
+ * u           The last HMAC result of each chain. Updated.
+ * t           The XOR of the HMAC results of each chain. Updated.
+ * count       Number of chains.
+ * iterations  Number of HMAC operations to perform on each chain.
+ * returns 0 on success, BAD_FUNC_ARG when a parameter is NULL and MEMORY_E
+ * when dynamic memory allocation fails.
+ */
+int Sha256HmacIterate(const byte* ipad, const byte* opad, byte* u, byte* t,
+                      word32 count, int iterations)
+{
+    int        ret;
+    word32     c;
+    int        i;
+    int        k;
+#ifdef WOLFSSL_SMALL_STACK
+    wc_Sha256* sha256;
+#else
+    wc_Sha256  sha256[1];
+#endif
+#if defined(XTRANSFORM) && (!defined(WOLFSSL_ESP32WROOM32_CRYPT) || \
+                             defined(NO_WOLFSSL_ESP32WROOM32_CRYPT_HASH))
+    word32     inner[WC_SHA256_DIGEST_SIZE / sizeof(word32)];
+    word32     outer[WC_SHA256_DIGEST_SIZE / sizeof(word32)];
+    word32     w[WC_SHA256_DIGEST_SIZE / sizeof(word32)];
+    word32     tw[WC_SHA256_DIGEST_SIZE / sizeof(word32)];
+    word32     block[WC_SHA256_BLOCK_SIZE / sizeof(word32)];
+#else
+    byte       w[WC_SHA256_DIGEST_SIZE];
+#endif
+
+    if (ipad == NULL || opad == NULL || u == NULL || t == NULL)
+        return BAD_FUNC_ARG;
+
+#ifdef WOLFSSL_SMALL_STACK
+    sha256 = (wc_Sha256*)XMALLOC(sizeof(wc_Sha256), NULL,
+                                 DYNAMIC_TYPE_TMP_BUFFER);
+    if (sha256 == NULL)
+        return MEMORY_E;
+#endif
+
+    ret = wc_InitSha256_ex(sha256, NULL, INVALID_DEVID);
+    if (ret != 0) {
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(sha256, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    #endif
+        return ret;
+    }
+
+#if defined(XTRANSFORM) && (!defined(WOLFSSL_ESP32WROOM32_CRYPT) || \
+                             defined(NO_WOLFSSL_ESP32WROOM32_CRYPT_HASH))
+    /* states after the key blocks */
+    XMEMCPY(w, sha256->digest, sizeof(w));
+    XMEMCPY(block, ipad, WC_SHA256_BLOCK_SIZE);
+#ifdef LITTLE_ENDIAN_ORDER
+    ByteReverseWords(block, block, WC_SHA256_BLOCK_SIZE);
+#endif
+    ret = Sha256TransformWords(sha256, w, block, inner);
+    if (ret == 0) {
+        XMEMCPY(block, opad, WC_SHA256_BLOCK_SIZE);
+    #ifdef LITTLE_ENDIAN_ORDER
+        ByteReverseWords(block, block, WC_SHA256_BLOCK_SIZE);
+    #endif
+        ret = Sha256TransformWords(sha256, w, block, outer);
+    }
+
+#ifdef HAVE_INTEL_AVX2
+    if (ret == 0 && IS_INTEL_AVX2(intel_flags) && count > 1) {
+        Sha256HmacIterate_AVX2(inner, outer, u, t, count, iterations);
+        count = 0;
+    }
+#endif
+
+    /* padding for 32 bytes after a block - 768 bits */
+    XMEMSET(block, 0, sizeof(block));
+    block[8] = 0x80000000;
+    block[15] = (WC_SHA256_BLOCK_SIZE + WC_SHA256_DIGEST_SIZE) * 8;
+
+    for (c = 0; ret == 0 && c < count; c++) {
+        XMEMCPY(w, u + c * WC_SHA256_DIGEST_SIZE, sizeof(w));
+        XMEMCPY(tw, t + c * WC_SHA256_DIGEST_SIZE, sizeof(tw));
+    #ifdef LITTLE_ENDIAN_ORDER
+        ByteReverseWords(w, w, sizeof(w));
+        ByteReverseWords(tw, tw, sizeof(tw));
+    #endif
+
+        for (k = 0; ret == 0 && k < iterations; k++) {
+            XMEMCPY(block, w, sizeof(w));
+            ret = Sha256TransformWords(sha256, inner, block, w);
+            if (ret == 0) {
+                XMEMCPY(block, w, sizeof(w));
+                ret = Sha256TransformWords(sha256, outer, block, w);
+            }
+            for (i = 0; i < 8; i++)
+                tw[i] ^= w[i];
+        }
+
+    #ifdef LITTLE_ENDIAN_ORDER
+        ByteReverseWords(w, w, sizeof(w));
+        ByteReverseWords(tw, tw, sizeof(tw));
+    #endif
+        XMEMCPY(u + c * WC_SHA256_DIGEST_SIZE, w, sizeof(w));
+        XMEMCPY(t + c * WC_SHA256_DIGEST_SIZE, tw, sizeof(tw));
+    }
+
+    ForceZero(inner, sizeof(inner));
+    ForceZero(outer, sizeof(outer));
+    ForceZero(tw, sizeof(tw));
+    ForceZero(block, sizeof(block));
+#else
+    /* hash through the API when the transform can't be called directly */
+    for (c = 0; ret == 0 && c < count; c++) {
+        for (k = 0; ret == 0 && k < iterations; k++) {
+            ret = wc_Sha256Update(sha256, ipad, WC_SHA256_BLOCK_SIZE);
+            if (ret == 0) {
+                ret = wc_Sha256Update(sha256, u + c * WC_SHA256_DIGEST_SIZE,
+                                      WC_SHA256_DIGEST_SIZE);
+            }
+            if (ret == 0)
+                ret = wc_Sha256Final(sha256, w);
+            if (ret == 0)
+                ret = wc_Sha256Update(sha256, opad, WC_SHA256_BLOCK_SIZE);
+            if (ret == 0)
+                ret = wc_Sha256Update(sha256, w, WC_SHA256_DIGEST_SIZE);
+            if (ret == 0)
+                ret = wc_Sha256Final(sha256, u + c * WC_SHA256_DIGEST_SIZE);
+            for (i = 0; ret == 0 && i < WC_SHA256_DIGEST_SIZE; i++) {
+                t[c * WC_SHA256_DIGEST_SIZE + i] ^=
+                                              u[c * WC_SHA256_DIGEST_SIZE + i];
+            }
+        }
+    }
+#endif
+    ForceZero(w, sizeof(w));
+
+    wc_Sha256Free(sha256);
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(sha256, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+
+    return ret;
+}
+
 #endif /* !WOLFSSL_TI_HASH */
 #endif /* HAVE_FIPS */
 
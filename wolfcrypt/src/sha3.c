@@ -52,6 +52,47 @@
     #include <wolfcrypt/src/misc.c>
 #endif
 
+#ifdef USE_INTEL_SPEEDUP
+    #include <wolfssl/wolfcrypt/cpuid.h>
+
+    #if defined(__GNUC__) && ((__GNUC__ < 4) || \
+                              (__GNUC__ == 4 && __GNUC_MINOR__ <= 8))
+        #undef  NO_AVX2_SUPPORT
+        #define NO_AVX2_SUPPORT
+    #endif
+    #if defined(__clang__) && ((__clang_major__ < 3) || \
+                               (__clang_major__ == 3 && __clang_minor__ <= 5))
+        #undef  NO_AVX2_SUPPORT
+        #define NO_AVX2_SUPPORT
+    #elif defined(__clang__) && defined(NO_AVX2_SUPPORT)
+        #undef NO_AVX2_SUPPORT
+    #endif
+
+    #ifndef NO_AVX2_SUPPORT
+        #define HAVE_INTEL_AVX2
+    #endif
+#endif
+
+#if defined(USE_INTEL_SPEEDUP) && defined(HAVE_INTEL_AVX2)
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/* The block operation performed on four states at once.
+ * Word i of state j is at index i * 4 + j.
+ *
+ * s  The four interleaved states.
+ */
+extern void sha3_block_x4_avx2(word64* s);
+
+#ifdef __cplusplus
+    }  /* extern "C" */
+#endif
+
+static int    cpuidFlagsSet = 0;
+static word32 cpuidFlags = 0;
+#endif
+
 
 #ifdef WOLFSSL_SHA3_SMALL
 /* Rotate a 64-bit value left.
@@ -834,6 +875,173 @@ static int wc_Sha3GetHash(wc_Sha3* sha3, byte* hash, byte p, byte len)
     return ret;
 }
 
+#if defined(USE_INTEL_SPEEDUP) && defined(HAVE_INTEL_AVX2)
+/* Hash four messages with the block operation done on all four states at
+ * once.
+ * Blocks are processed together until the message with the fewest blocks has
+ * had its padded final block processed. Longer messages are then completed on
+ * their own from their state.
+ *
+ * s4       Buffer for the four interleaved states.
+ * sha3     wc_Sha3 object used for padding and to complete longer messages.
+ * data     The four messages.
+ * len      Lengths of the four messages.
+ * hash     Four buffers to hold the hash results.
+ * padChar  Padding character of the algorithm.
+ * p        Number of 64-bit numbers in a block of data to process.
+ * l        Number of bytes in output.
+ * returns 0 on success.
+ */
+static int Sha3Hash_x4_avx2(word64* s4, wc_Sha3* sha3, const byte* data[4],
+                            const word32 len[4], byte* hash[4], byte padChar,
+                            byte p, byte l)
+{
+    int         ret = 0;
+    int         j;
+    byte        i;
+    word32      blockSz = (word32)p * 8;
+    word32      blocks[4];
+    word32      common;
+    word32      n;
+    word32      o;
+    const byte* b;
+
+    /* Number of blocks including the padded final block. */
+    for (j = 0; j < 4; j++)
+        blocks[j] = len[j] / blockSz + 1;
+    common = blocks[0];
+    for (j = 1; j < 4; j++) {
+        if (blocks[j] < common)
+            common = blocks[j];
+    }
+
+    XMEMSET(s4, 0, sizeof(word64) * 25 * 4);
+    for (n = 0; n < common; n++) {
+        for (j = 0; j < 4; j++) {
+            o = n * blockSz;
+            b = data[j] + o;
+            if (n == blocks[j] - 1) {
+                /* Final block - remaining data and padding. */
+                o = len[j] - o;
+                if (o > 0)
+                    XMEMCPY(sha3->t, b, o);
+                sha3->t[o] = padChar;
+                XMEMSET(sha3->t + o + 1, 0, blockSz - o - 1);
+                sha3->t[blockSz - 1] |= 0x80;
+                b = sha3->t;
+            }
+            for (i = 0; i < p; i++)
+                s4[i * 4 + j] ^= Load64BitBigEndian(b + 8 * i);
+        }
+        sha3_block_x4_avx2(s4);
+    }
+
+    for (j = 0; j < 4 && ret == 0; j++) {
+        if (blocks[j] == common) {
+            for (i = 0; i < l; i++)
+                hash[j][i] = (byte)(s4[(i / 8) * 4 + j] >> (8 * (i % 8)));
+        }
+        else {
+            for (i = 0; i < 25; i++)
+                sha3->s[i] = s4[i * 4 + j];
+            sha3->i = 0;
+            o = common * blockSz;
+            ret = Sha3Update(sha3, data[j] + o, len[j] - o, p);
+            if (ret == 0)
+                ret = Sha3Final(sha3, padChar, hash[j], p, l);
+        }
+    }
+
+    return ret;
+}
+#endif
+
+/* Hash four messages at once.
+ * Uses AVX2 to perform the block operation on the four states together when
+ * available, otherwise the messages are hashed one after the other.
+ *
+ * data     The four messages.
+ * len      Lengths of the four messages.
+ * hash     Four buffers to hold the hash results.
+ * padChar  Padding character of the algorithm.
+ * p        Number of 64-bit numbers in a block of data to process.
+ * l        Number of bytes in output.
+ * returns 0 on success, BAD_FUNC_ARG when a parameter is invalid and MEMORY_E
+ * when dynamic memory allocation fails.
+ */
+static int Sha3Hash_x4(const byte* data[4], const word32 len[4],
+                       byte* hash[4], byte padChar, byte p, word32 l)
+{
+    int ret = 0;
+    int j;
+#ifdef WOLFSSL_SMALL_STACK
+    wc_Sha3* sha3;
+#else
+    wc_Sha3  sha3[1];
+#endif
+#if defined(USE_INTEL_SPEEDUP) && defined(HAVE_INTEL_AVX2)
+#ifdef WOLFSSL_SMALL_STACK
+    word64*  s4 = NULL;
+#else
+    word64   s4[25 * 4];
+#endif
+#endif
+
+    if (data == NULL || len == NULL || hash == NULL || l > (word32)p * 8)
+        return BAD_FUNC_ARG;
+    for (j = 0; j < 4; j++) {
+        if ((data[j] == NULL && len[j] > 0) || hash[j] == NULL)
+            return BAD_FUNC_ARG;
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    sha3 = (wc_Sha3*)XMALLOC(sizeof(wc_Sha3), NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    if (sha3 == NULL)
+        return MEMORY_E;
+#endif
+    InitSha3(sha3);
+
+#if defined(USE_INTEL_SPEEDUP) && defined(HAVE_INTEL_AVX2)
+    if (!cpuidFlagsSet) {
+        cpuidFlags = cpuid_get_flags();
+        cpuidFlagsSet = 1;
+    }
+
+    if (IS_INTEL_AVX2(cpuidFlags)) {
+    #ifdef WOLFSSL_SMALL_STACK
+        s4 = (word64*)XMALLOC(sizeof(word64) * 25 * 4, NULL,
+                              DYNAMIC_TYPE_TMP_BUFFER);
+        if (s4 == NULL)
+            ret = MEMORY_E;
+        else
+    #endif
+        {
+            ret = Sha3Hash_x4_avx2(s4, sha3, data, len, hash, padChar, p,
+                                   (byte)l);
+        }
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(s4, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    #endif
+    }
+    else
+#endif
+    {
+        for (j = 0; j < 4 && ret == 0; j++) {
+            ret = Sha3Update(sha3, data[j], len[j], p);
+            if (ret == 0)
+                ret = Sha3Final(sha3, padChar, hash[j], p, (byte)l);
+            if (ret == 0)
+                ret = InitSha3(sha3);
+        }
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(sha3, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+
+    return ret;
+}
+
 
 /* Initialize the state for a SHA3-224 hash operation.
  *
@@ -906,6 +1114,19 @@ int wc_Sha3_224_Copy(wc_Sha3* src, wc_Sha3* dst)
     return wc_Sha3Copy(src, dst);
 }
 
+/* Calculate the SHA3-224 hashes of four messages at once.
+ *
+ * data  The four messages to hash.
+ * len   Lengths of the four messages.
+ * hash  Four buffers to hold the hash results. Each at least 28 bytes.
+ * returns 0 on success.
+ */
+int wc_Sha3_224Hash_x4(const byte* data[4], const word32 len[4], byte* hash[4])
+{
+    return Sha3Hash_x4(data, len, hash, 0x06, WC_SHA3_224_COUNT,
+                       WC_SHA3_224_DIGEST_SIZE);
+}
+
 
 /* Initialize the state for a SHA3-256 hash operation.
  *
@@ -978,6 +1199,19 @@ int wc_Sha3_256_Copy(wc_Sha3* src, wc_Sha3* dst)
     return wc_Sha3Copy(src, dst);
 }
 
+/* Calculate the SHA3-256 hashes of four messages at once.
+ *
+ * data  The four messages to hash.
+ * len   Lengths of the four messages.
+ * hash  Four buffers to hold the hash results. Each at least 32 bytes.
+ * returns 0 on success.
+ */
+int wc_Sha3_256Hash_x4(const byte* data[4], const word32 len[4], byte* hash[4])
+{
+    return Sha3Hash_x4(data, len, hash, 0x06, WC_SHA3_256_COUNT,
+                       WC_SHA3_256_DIGEST_SIZE);
+}
+
 
 /* Initialize the state for a SHA3-384 hash operation.
  *
@@ -1050,6 +1284,19 @@ int wc_Sha3_384_Copy(wc_Sha3* src, wc_Sha3* dst)
     return wc_Sha3Copy(src, dst);
 }
 
+/* Calculate the SHA3-384 hashes of four messages at once.
+ *
+ * data  The four messages to hash.
+ * len   Lengths of the four messages.
+ * hash  Four buffers to hold the hash results. Each at least 48 bytes.
+ * returns 0 on success.
+ */
+int wc_Sha3_384Hash_x4(const byte* data[4], const word32 len[4], byte* hash[4])
+{
+    return Sha3Hash_x4(data, len, hash, 0x06, WC_SHA3_384_COUNT,
+                       WC_SHA3_384_DIGEST_SIZE);
+}
+
 
 /* Initialize the state for a SHA3-512 hash operation.
  *
@@ -1122,6 +1369,19 @@ int wc_Sha3_512_Copy(wc_Sha3* src, wc_Sha3* dst)
     return wc_Sha3Copy(src, dst);
 }
 
+/* Calculate the SHA3-512 hashes of four messages at once.
+ *
+ * data  The four messages to hash.
+ * len   Lengths of the four messages.
+ * hash  Four buffers to hold the hash results. Each at least 64 bytes.
+ * returns 0 on success.
+ */
+int wc_Sha3_512Hash_x4(const byte* data[4], const word32 len[4], byte* hash[4])
+{
+    return Sha3Hash_x4(data, len, hash, 0x06, WC_SHA3_512_COUNT,
+                       WC_SHA3_512_DIGEST_SIZE);
+}
+
 #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
 int wc_Sha3_SetFlags(wc_Sha3* sha3, word32 flags)
 {
@@ -1211,6 +1471,20 @@ int wc_Shake256_Copy(wc_Shake* src, wc_Shake* dst)
 {
     return wc_Sha3Copy(src, dst);
 }
+
+/* Calculate the SHAKE256 hashes of four messages at once.
+ *
+ * data     The four messages to hash.
+ * len      Lengths of the four messages.
+ * hash     Four buffers to hold the hash results.
+ * hashLen  Number of bytes of output for each message. At most 136 bytes.
+ * returns 0 on success.
+ */
+int wc_Shake256Hash_x4(const byte* data[4], const word32 len[4], byte* hash[4],
+                       word32 hashLen)
+{
+    return Sha3Hash_x4(data, len, hash, 0x1f, WC_SHA3_256_COUNT, hashLen);
+}
 #endif
 
 #endif /* WOLFSSL_SHA3 */
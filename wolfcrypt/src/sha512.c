@@ -326,6 +326,9 @@ static int InitSha512(wc_Sha512* sha512)
             extern int Transform_Sha512_AVX2_RORX_Len(wc_Sha512 *sha512,
                                                       word32 len);
         #endif
+        /* Four blocks, one from each data pointer, into four interleaved
+         * states: word i of state j is at s[i * 4 + j]. */
+        extern int Transform_Sha512_AVX2_x4(word64* s, const byte** data);
     #endif
 
 #ifdef __cplusplus
@@ -892,6 +895,240 @@ void wc_Sha512Free(wc_Sha512* sha512)
 #endif /* WOLFSSL_ASYNC_CRYPT */
 }
 
+#ifdef HAVE_INTEL_AVX2
+/* Number of messages hashed at the same time by the AVX2 transform. */
+#define SHA512_MULTI_LANES    4
+
+/* Start hashing a message in a lane.
+ * The padding, and any data that doesn't fill a block, is put in the lane's
+ * pad buffer.
+ *
+ * s       The interleaved states.
+ * j       The lane.
+ * iv      The initial hash value.
+ * pad     The lane's pad buffer - two blocks.
+ * data    The message.
+ * len     Length of the message.
+ * full    Number of full blocks of message data.
+ * blocks  Number of blocks to process including the padding.
+ */
+static void Sha512MultiStart(word64* s, int j, const word64* iv, byte* pad,
+                             const byte* data, word32 len, word32* full,
+                             word32* blocks)
+{
+    int    i;
+    word32 rem;
+    word32 padLen;
+
+    for (i = 0; i < 8; i++)
+        s[i * SHA512_MULTI_LANES + j] = iv[i];
+
+    *full = len / WC_SHA512_BLOCK_SIZE;
+    rem = len - *full * WC_SHA512_BLOCK_SIZE;
+    padLen = (rem + 1 + 16 > WC_SHA512_BLOCK_SIZE) ? 2 * WC_SHA512_BLOCK_SIZE
+                                                   : WC_SHA512_BLOCK_SIZE;
+    *blocks = *full + padLen / WC_SHA512_BLOCK_SIZE;
+
+    if (rem > 0)
+        XMEMCPY(pad, data + *full * WC_SHA512_BLOCK_SIZE, rem);
+    pad[rem] = 0x80;
+    XMEMSET(pad + rem + 1, 0, padLen - rem - 1 - 5);
+    /* length in bits, big-endian */
+    pad[padLen - 5] = (byte)(len >> 29);
+    pad[padLen - 4] = (byte)(len >> 21);
+    pad[padLen - 3] = (byte)(len >> 13);
+    pad[padLen - 2] = (byte)(len >>  5);
+    pad[padLen - 1] = (byte)(len <<  3);
+}
+
+/* Hash many messages, four at a time, with the AVX2 transform.
+ * Each lane of the transform works through one message at a time and starts
+ * on the next message not yet hashed when it completes one. Idle lanes process
+ * their pad buffer and the result is ignored. When only one message has data
+ * left to process, it is completed with the single stream transform.
+ *
+ * sha512  wc_Sha512 object, initialized, to complete the last message.
+ * pad     Pad buffers of the lanes - two blocks each.
+ * data    The messages.
+ * len     Lengths of the messages.
+ * hash    Buffers to hold the hash results.
+ * count   Number of messages.
+ * returns 0 on success.
+ */
+static int Sha512HashMulti_AVX2(wc_Sha512* sha512, byte* pad,
+                                const byte* data[], const word32 len[],
+                                byte* hash[], word32 count)
+{
+    int         ret = 0;
+    int         i;
+    int         j;
+    int         k;
+    int         last = 0;
+    word64      s[8 * SHA512_MULTI_LANES];
+    word64      iv[8];
+    const byte* in[SHA512_MULTI_LANES];
+    word32      msg[SHA512_MULTI_LANES];
+    word32      blk[SHA512_MULTI_LANES];
+    word32      full[SHA512_MULTI_LANES];
+    word32      blocks[SHA512_MULTI_LANES];
+    word32      next = 0;
+    word32      active = 0;
+
+    XMEMCPY(iv, sha512->digest, sizeof(iv));
+
+    for (j = 0; j < SHA512_MULTI_LANES; j++) {
+        blk[j] = 0;
+        msg[j] = count;
+        if (next < count) {
+            msg[j] = next++;
+            Sha512MultiStart(s, j, iv, pad + j * 2 * WC_SHA512_BLOCK_SIZE,
+                    data[msg[j]], len[msg[j]], &full[j], &blocks[j]);
+            active++;
+        }
+    }
+
+    while (active > 0) {
+        if (active == 1 && next == count) {
+            for (last = 0; msg[last] == count; last++) {
+            }
+            /* Only padding left - do it with the other lanes idle. */
+            if (blk[last] < full[last])
+                break;
+        }
+
+        for (j = 0; j < SHA512_MULTI_LANES; j++) {
+            in[j] = pad + j * 2 * WC_SHA512_BLOCK_SIZE;
+            if (msg[j] == count)
+                continue;
+            if (blk[j] < full[j])
+                in[j] = data[msg[j]] + blk[j] * WC_SHA512_BLOCK_SIZE;
+            else
+                in[j] += (blk[j] - full[j]) * WC_SHA512_BLOCK_SIZE;
+        }
+        Transform_Sha512_AVX2_x4(s, in);
+
+        for (j = 0; j < SHA512_MULTI_LANES; j++) {
+            if (msg[j] == count || ++blk[j] < blocks[j])
+                continue;
+
+            for (i = 0; i < 8; i++) {
+                word64 v = s[i * SHA512_MULTI_LANES + j];
+                for (k = 0; k < 8; k++)
+                    hash[msg[j]][i * 8 + k] = (byte)(v >> (56 - 8 * k));
+            }
+            blk[j] = 0;
+            msg[j] = count;
+            if (next < count) {
+                msg[j] = next++;
+                Sha512MultiStart(s, j, iv,
+                        pad + j * 2 * WC_SHA512_BLOCK_SIZE, data[msg[j]],
+                        len[msg[j]], &full[j], &blocks[j]);
+            }
+            else {
+                active--;
+            }
+        }
+    }
+
+    if (active == 1) {
+        for (i = 0; i < 8; i++)
+            sha512->digest[i] = s[i * SHA512_MULTI_LANES + last];
+        sha512->loLen = (word64)blk[last] * WC_SHA512_BLOCK_SIZE;
+        ret = wc_Sha512Update(sha512,
+                data[msg[last]] + blk[last] * WC_SHA512_BLOCK_SIZE,
+                len[msg[last]] - blk[last] * WC_SHA512_BLOCK_SIZE);
+        if (ret == 0)
+            ret = wc_Sha512Final(sha512, hash[msg[last]]);
+    }
+
+    return ret;
+}
+#endif /* HAVE_INTEL_AVX2 */
+
+/* Calculate the SHA-512 hashes of many messages.
+ * With AVX2, four messages are hashed at the same time.
+ *
+ * data   The messages to hash.
+ * len    Lengths of the messages.
+ * hash   Buffers to hold the hash results. Each WC_SHA512_DIGEST_SIZE bytes.
+ * count  Number of messages.
+ * returns 0 on success, BAD_FUNC_ARG when a parameter is invalid and MEMORY_E
+ * when dynamic memory allocation fails.
+ */
+int wc_Sha512HashMulti(const byte* data[], const word32 len[], byte* hash[],
+                       word32 count)
+{
+    int     ret = 0;
+    word32  i;
+#ifdef WOLFSSL_SMALL_STACK
+    wc_Sha512* sha512;
+#else
+    wc_Sha512  sha512[1];
+#endif
+#ifdef HAVE_INTEL_AVX2
+#ifdef WOLFSSL_SMALL_STACK
+    byte*   pad;
+#else
+    byte    pad[SHA512_MULTI_LANES * 2 * WC_SHA512_BLOCK_SIZE];
+#endif
+#endif
+
+    if (count > 0 && (data == NULL || len == NULL || hash == NULL))
+        return BAD_FUNC_ARG;
+    for (i = 0; i < count; i++) {
+        if ((data[i] == NULL && len[i] > 0) || hash[i] == NULL)
+            return BAD_FUNC_ARG;
+    }
+
+#ifdef WOLFSSL_SMALL_STACK
+    sha512 = (wc_Sha512*)XMALLOC(sizeof(wc_Sha512), NULL,
+                                 DYNAMIC_TYPE_TMP_BUFFER);
+    if (sha512 == NULL)
+        return MEMORY_E;
+#endif
+
+    ret = wc_InitSha512_ex(sha512, NULL, INVALID_DEVID);
+    if (ret != 0) {
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(sha512, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    #endif
+        return ret;
+    }
+
+#ifdef HAVE_INTEL_AVX2
+    if (IS_INTEL_AVX2(intel_flags) && count > 1) {
+    #ifdef WOLFSSL_SMALL_STACK
+        pad = (byte*)XMALLOC(SHA512_MULTI_LANES * 2 * WC_SHA512_BLOCK_SIZE,
+                             NULL, DYNAMIC_TYPE_TMP_BUFFER);
+        if (pad == NULL)
+            ret = MEMORY_E;
+        else
+    #endif
+        {
+            ret = Sha512HashMulti_AVX2(sha512, pad, data, len, hash, count);
+        }
+    #ifdef WOLFSSL_SMALL_STACK
+        XFREE(pad, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+    #endif
+    }
+    else
+#endif
+    {
+        for (i = 0; i < count && ret == 0; i++) {
+            ret = wc_Sha512Update(sha512, data[i], len[i]);
+            if (ret == 0)
+                ret = wc_Sha512Final(sha512, hash[i]);
+        }
+    }
+
+    wc_Sha512Free(sha512);
+#ifdef WOLFSSL_SMALL_STACK
+    XFREE(sha512, NULL, DYNAMIC_TYPE_TMP_BUFFER);
+#endif
+
+    return ret;
+}
+
 #endif /* WOLFSSL_SHA512 */
 
 /* -------------------------------------------------------------------------- */
@@ -14169,7 +14169,7 @@ static int sp_256_ecc_mulmod_fast_5(sp_point_256* r, const sp_point_256* g, cons
     return err;
 }
 
-#ifdef FP_ECC
+#if defined(FP_ECC) || defined(WOLFSSL_SP_ECC_TABLE)
 /* Double the Montgomery form projective point p a number of times.
  *
  * r  Result of repeated doubling of point.
@@ -14258,7 +14258,7 @@ static void sp_256_proj_point_dbl_n_5(sp_point_256* p, int n, sp_digit* t)
     sp_256_div2_5(y, y, p256_mod);
 }
 
-#endif /* FP_ECC */
+#endif /* FP_ECC || WOLFSSL_SP_ECC_TABLE */
 /* Add two Montgomery form projective points. The second point has a q value of
  * one.
  * Only the first point can be the same pointer as the result point.
@@ -14341,7 +14341,7 @@ static void sp_256_proj_point_add_qz1_5(sp_point_256* r, const sp_point_256* p,
     }
 }
 
-#ifdef FP_ECC
+#if defined(FP_ECC) || defined(WOLFSSL_SP_ECC_TABLE)
 /* Convert the projective point to affine.
  * Ordinates are in Montgomery form.
  *
@@ -14445,7 +14445,7 @@ static int sp_256_gen_stripe_table_5(const sp_point_256* a,
     return err;
 }
 
-#endif /* FP_ECC */
+#endif /* FP_ECC || WOLFSSL_SP_ECC_TABLE */
 /* Multiply the point by the scalar and return the result.
  * If map is true then convert result to affine coordinates.
  *
@@ -16913,8 +16913,14 @@ int sp_ecc_sign_256(const byte* hash, word32 hashLen, WC_RNG* rng, mp_int* priv,
  * returns RNG failures, MEMORY_E when memory allocation fails and
  * MP_OKAY on success.
  */
+#ifdef WOLFSSL_SP_ECC_TABLE
+static int sp_256_ecc_verify_5(const byte* hash, word32 hashLen, mp_int* pX,
+    mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm, int* res,
+    const sp_table_entry_256* table, void* heap)
+#else
 int sp_ecc_verify_256(const byte* hash, word32 hashLen, mp_int* pX,
     mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm, int* res, void* heap)
+#endif
 {
 #if (defined(WOLFSSL_SP_SMALL) || defined(WOLFSSL_SMALL_STACK)) && !defined(WOLFSSL_SP_NO_MALLOC)
     sp_digit* d = NULL;
@@ -16990,7 +16996,15 @@ int sp_ecc_verify_256(const byte* hash, word32 hashLen, mp_int* pX,
             err = sp_256_ecc_mulmod_base_5(p1, u1, 0, heap);
     }
     if (err == MP_OKAY) {
+#ifdef WOLFSSL_SP_ECC_TABLE
+        if (table != NULL) {
+            err = sp_256_ecc_mulmod_stripe_5(p2, p2, table, u2, 0, heap);
+        }
+        else
+#endif
+        {
             err = sp_256_ecc_mulmod_5(p2, p2, u2, 0, heap);
+        }
     }
 
     if (err == MP_OKAY) {
@@ -17056,6 +17070,104 @@ int sp_ecc_verify_256(const byte* hash, word32 hashLen, mp_int* pX,
 
     return err;
 }
+
+#ifdef WOLFSSL_SP_ECC_TABLE
+/* Verify the signature values with the hash and public key.
+ *
+ * hash     Hash that was signed.
+ * hashLen  Length of the hash data.
+ * pX       X ordinate of the public key.
+ * pY       Y ordinate of the public key.
+ * pZ       Z ordinate of the public key.
+ * r        First part of signature as an mp_int.
+ * sm       Second part of signature as an mp_int.
+ * res      Result of verification: 1 when valid, 0 otherwise.
+ * heap     Heap to use for allocation.
+ * returns MEMORY_E when memory allocation fails and MP_OKAY on success.
+ */
+int sp_ecc_verify_256(const byte* hash, word32 hashLen, mp_int* pX,
+    mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm, int* res, void* heap)
+{
+    return sp_256_ecc_verify_5(hash, hashLen, pX, pY, pZ, r, sm, res, NULL,
+                                                                          heap);
+}
+
+/* Verify the signature values with the hash and a pre-computed table of
+ * multiples of the public key generated by sp_ecc_gen_table_256().
+ *
+ * hash     Hash that was signed.
+ * hashLen  Length of the hash data.
+ * pX       X ordinate of the public key.
+ * pY       Y ordinate of the public key.
+ * pZ       Z ordinate of the public key.
+ * r        First part of signature as an mp_int.
+ * sm       Second part of signature as an mp_int.
+ * res      Result of verification: 1 when valid, 0 otherwise.
+ * table    Table of points for the public key.
+ * heap     Heap to use for allocation.
+ * returns BAD_FUNC_ARG when table is NULL, MEMORY_E when memory allocation
+ * fails and MP_OKAY on success.
+ */
+int sp_ecc_verify_table_256(const byte* hash, word32 hashLen, mp_int* pX,
+    mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm, int* res,
+    const byte* table, void* heap)
+{
+    if (table == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    return sp_256_ecc_verify_5(hash, hashLen, pX, pY, pZ, r, sm, res,
+                                (const sp_table_entry_256*)table, heap);
+}
+
+/* Generate the table of points used to multiply the point by a scalar.
+ * The table is aligned for sp_digit when allocated with XMALLOC.
+ *
+ * gm     Point to generate table for.
+ * table  Buffer to hold the table. NULL to get the length.
+ * len    [in] Length of buffer. [out] Length of table.
+ * heap   Heap to use for allocation.
+ * returns BAD_FUNC_ARG when gm or len is NULL, LENGTH_ONLY_E when table is
+ * NULL, BUFFER_E when the buffer is too small, MEMORY_E when memory
+ * allocation fails and MP_OKAY on success.
+ */
+int sp_ecc_gen_table_256(ecc_point* gm, byte* table, word32* len, void* heap)
+{
+#if (!defined(WOLFSSL_SP_SMALL) && !defined(WOLFSSL_SMALL_STACK)) || defined(WOLFSSL_SP_NO_MALLOC)
+    sp_point_256 pd;
+#endif
+    sp_point_256* point = NULL;
+    sp_digit tmp[2 * 5 * 5];
+    int err = MP_OKAY;
+
+    if ((gm == NULL) || (len == NULL)) {
+        err = BAD_FUNC_ARG;
+    }
+    else if (table == NULL) {
+        *len = (word32)(sizeof(sp_table_entry_256) * 256);
+        err = LENGTH_ONLY_E;
+    }
+    else if (*len < (word32)(sizeof(sp_table_entry_256) * 256)) {
+        err = BUFFER_E;
+    }
+
+    if (err == MP_OKAY) {
+        err = sp_256_point_new_5(heap, pd, point);
+    }
+    if (err == MP_OKAY) {
+        sp_256_point_from_ecc_point_5(point, gm);
+        err = sp_256_gen_stripe_table_5(point, (sp_table_entry_256*)table, tmp,
+                                                                          heap);
+    }
+    if (err == MP_OKAY) {
+        *len = (word32)(sizeof(sp_table_entry_256) * 256);
+    }
+
+    sp_256_point_free_5(point, 0, heap);
+
+    return err;
+}
+#endif /* WOLFSSL_SP_ECC_TABLE */
 #endif /* HAVE_ECC_VERIFY */
 
 #ifdef HAVE_ECC_CHECK_KEY
@@ -19355,7 +19467,7 @@ static int sp_384_ecc_mulmod_fast_7(sp_point_384* r, const sp_point_384* g, cons
     return err;
 }
 
-#ifdef FP_ECC
+#if defined(FP_ECC) || defined(WOLFSSL_SP_ECC_TABLE)
 /* Double the Montgomery form projective point p a number of times.
  *
  * r  Result of repeated doubling of point.
@@ -19444,7 +19556,7 @@ static void sp_384_proj_point_dbl_n_7(sp_point_384* p, int n, sp_digit* t)
     sp_384_div2_7(y, y, p384_mod);
 }
 
-#endif /* FP_ECC */
+#endif /* FP_ECC || WOLFSSL_SP_ECC_TABLE */
 /* Add two Montgomery form projective points. The second point has a q value of
  * one.
  * Only the first point can be the same pointer as the result point.
@@ -19527,7 +19639,7 @@ static void sp_384_proj_point_add_qz1_7(sp_point_384* r, const sp_point_384* p,
     }
 }
 
-#ifdef FP_ECC
+#if defined(FP_ECC) || defined(WOLFSSL_SP_ECC_TABLE)
 /* Convert the projective point to affine.
  * Ordinates are in Montgomery form.
  *
@@ -19631,7 +19743,7 @@ static int sp_384_gen_stripe_table_7(const sp_point_384* a,
     return err;
 }
 
-#endif /* FP_ECC */
+#endif /* FP_ECC || WOLFSSL_SP_ECC_TABLE */
 /* Multiply the point by the scalar and return the result.
  * If map is true then convert result to affine coordinates.
  *
@@ -22601,8 +22713,14 @@ int sp_ecc_sign_384(const byte* hash, word32 hashLen, WC_RNG* rng, mp_int* priv,
  * returns RNG failures, MEMORY_E when memory allocation fails and
  * MP_OKAY on success.
  */
+#ifdef WOLFSSL_SP_ECC_TABLE
+static int sp_384_ecc_verify_7(const byte* hash, word32 hashLen, mp_int* pX,
+    mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm, int* res,
+    const sp_table_entry_384* table, void* heap)
+#else
 int sp_ecc_verify_384(const byte* hash, word32 hashLen, mp_int* pX,
     mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm, int* res, void* heap)
+#endif
 {
 #if (defined(WOLFSSL_SP_SMALL) || defined(WOLFSSL_SMALL_STACK)) && !defined(WOLFSSL_SP_NO_MALLOC)
     sp_digit* d = NULL;
@@ -22678,7 +22796,15 @@ int sp_ecc_verify_384(const byte* hash, word32 hashLen, mp_int* pX,
             err = sp_384_ecc_mulmod_base_7(p1, u1, 0, heap);
     }
     if (err == MP_OKAY) {
+#ifdef WOLFSSL_SP_ECC_TABLE
+        if (table != NULL) {
+            err = sp_384_ecc_mulmod_stripe_7(p2, p2, table, u2, 0, heap);
+        }
+        else
+#endif
+        {
             err = sp_384_ecc_mulmod_7(p2, p2, u2, 0, heap);
+        }
     }
 
     if (err == MP_OKAY) {
@@ -22746,6 +22872,104 @@ int sp_ecc_verify_384(const byte* hash, word32 hashLen, mp_int* pX,
 
     return err;
 }
+
+#ifdef WOLFSSL_SP_ECC_TABLE
+/* Verify the signature values with the hash and public key.
+ *
+ * hash     Hash that was signed.
+ * hashLen  Length of the hash data.
+ * pX       X ordinate of the public key.
+ * pY       Y ordinate of the public key.
+ * pZ       Z ordinate of the public key.
+ * r        First part of signature as an mp_int.
+ * sm       Second part of signature as an mp_int.
+ * res      Result of verification: 1 when valid, 0 otherwise.
+ * heap     Heap to use for allocation.
+ * returns MEMORY_E when memory allocation fails and MP_OKAY on success.
+ */
+int sp_ecc_verify_384(const byte* hash, word32 hashLen, mp_int* pX,
+    mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm, int* res, void* heap)
+{
+    return sp_384_ecc_verify_7(hash, hashLen, pX, pY, pZ, r, sm, res, NULL,
+                                                                          heap);
+}
+
+/* Verify the signature values with the hash and a pre-computed table of
+ * multiples of the public key generated by sp_ecc_gen_table_384().
+ *
+ * hash     Hash that was signed.
+ * hashLen  Length of the hash data.
+ * pX       X ordinate of the public key.
+ * pY       Y ordinate of the public key.
+ * pZ       Z ordinate of the public key.
+ * r        First part of signature as an mp_int.
+ * sm       Second part of signature as an mp_int.
+ * res      Result of verification: 1 when valid, 0 otherwise.
+ * table    Table of points for the public key.
+ * heap     Heap to use for allocation.
+ * returns BAD_FUNC_ARG when table is NULL, MEMORY_E when memory allocation
+ * fails and MP_OKAY on success.
+ */
+int sp_ecc_verify_table_384(const byte* hash, word32 hashLen, mp_int* pX,
+    mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm, int* res,
+    const byte* table, void* heap)
+{
+    if (table == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    return sp_384_ecc_verify_7(hash, hashLen, pX, pY, pZ, r, sm, res,
+                                (const sp_table_entry_384*)table, heap);
+}
+
+/* Generate the table of points used to multiply the point by a scalar.
+ * The table is aligned for sp_digit when allocated with XMALLOC.
+ *
+ * gm     Point to generate table for.
+ * table  Buffer to hold the table. NULL to get the length.
+ * len    [in] Length of buffer. [out] Length of table.
+ * heap   Heap to use for allocation.
+ * returns BAD_FUNC_ARG when gm or len is NULL, LENGTH_ONLY_E when table is
+ * NULL, BUFFER_E when the buffer is too small, MEMORY_E when memory
+ * allocation fails and MP_OKAY on success.
+ */
+int sp_ecc_gen_table_384(ecc_point* gm, byte* table, word32* len, void* heap)
+{
+#if (!defined(WOLFSSL_SP_SMALL) && !defined(WOLFSSL_SMALL_STACK)) || defined(WOLFSSL_SP_NO_MALLOC)
+    sp_point_384 pd;
+#endif
+    sp_point_384* point = NULL;
+    sp_digit tmp[2 * 7 * 7];
+    int err = MP_OKAY;
+
+    if ((gm == NULL) || (len == NULL)) {
+        err = BAD_FUNC_ARG;
+    }
+    else if (table == NULL) {
+        *len = (word32)(sizeof(sp_table_entry_384) * 256);
+        err = LENGTH_ONLY_E;
+    }
+    else if (*len < (word32)(sizeof(sp_table_entry_384) * 256)) {
+        err = BUFFER_E;
+    }
+
+    if (err == MP_OKAY) {
+        err = sp_384_point_new_7(heap, pd, point);
+    }
+    if (err == MP_OKAY) {
+        sp_384_point_from_ecc_point_7(point, gm);
+        err = sp_384_gen_stripe_table_7(point, (sp_table_entry_384*)table, tmp,
+                                                                          heap);
+    }
+    if (err == MP_OKAY) {
+        *len = (word32)(sizeof(sp_table_entry_384) * 256);
+    }
+
+    sp_384_point_free_7(point, 0, heap);
+
+    return err;
+}
+#endif /* WOLFSSL_SP_ECC_TABLE */
 #endif /* HAVE_ECC_VERIFY */
 
 #ifdef HAVE_ECC_CHECK_KEY
@@ -7879,7 +7879,7 @@ static void sp_256_proj_point_add_qz1_4(sp_point_256* r, const sp_point_256* p,
     }
 }
 
-#ifdef FP_ECC
+#if defined(FP_ECC) || defined(WOLFSSL_SP_ECC_TABLE)
 /* Convert the projective point to affine.
  * Ordinates are in Montgomery form.
  *
@@ -7983,8 +7983,9 @@ static int sp_256_gen_stripe_table_4(const sp_point_256* a,
     return err;
 }
 
-#endif /* FP_ECC */
-#if defined(FP_ECC) || defined(WOLFSSL_SP_SMALL)
+#endif /* FP_ECC || WOLFSSL_SP_ECC_TABLE */
+#if defined(FP_ECC) || defined(WOLFSSL_SP_SMALL) || \
+    defined(WOLFSSL_SP_ECC_TABLE)
 /* Multiply the point by the scalar and return the result.
  * If map is true then convert result to affine coordinates.
  *
@@ -8070,7 +8071,7 @@ static int sp_256_ecc_mulmod_stripe_4(sp_point_256* r, const sp_point_256* g,
     return err;
 }
 
-#endif /* FP_ECC || WOLFSSL_SP_SMALL */
+#endif /* FP_ECC || WOLFSSL_SP_SMALL || WOLFSSL_SP_ECC_TABLE */
 #ifdef FP_ECC
 #ifndef FP_ENTRIES
     #define FP_ENTRIES 16
@@ -8285,7 +8286,7 @@ static void sp_256_proj_point_add_qz1_avx2_4(sp_point_256* r, const sp_point_256
     }
 }
 
-#ifdef FP_ECC
+#if defined(FP_ECC) || defined(WOLFSSL_SP_ECC_TABLE)
 /* Convert the projective point to affine.
  * Ordinates are in Montgomery form.
  *
@@ -8389,8 +8390,9 @@ static int sp_256_gen_stripe_table_avx2_4(const sp_point_256* a,
     return err;
 }
 
-#endif /* FP_ECC */
-#if defined(FP_ECC) || defined(WOLFSSL_SP_SMALL)
+#endif /* FP_ECC || WOLFSSL_SP_ECC_TABLE */
+#if defined(FP_ECC) || defined(WOLFSSL_SP_SMALL) || \
+    defined(WOLFSSL_SP_ECC_TABLE)
 /* Multiply the point by the scalar and return the result.
  * If map is true then convert result to affine coordinates.
  *
@@ -8476,7 +8478,7 @@ static int sp_256_ecc_mulmod_stripe_avx2_4(sp_point_256* r, const sp_point_256*
     return err;
 }
 
-#endif /* FP_ECC || WOLFSSL_SP_SMALL */
+#endif /* FP_ECC || WOLFSSL_SP_SMALL || WOLFSSL_SP_ECC_TABLE */
 /* Multiply the base point of P256 by the scalar and return the result.
  * If map is true then convert result to affine coordinates.
  *
@@ -23087,8 +23089,14 @@ int sp_ecc_sign_256(const byte* hash, word32 hashLen, WC_RNG* rng, mp_int* priv,
  * returns RNG failures, MEMORY_E when memory allocation fails and
  * MP_OKAY on success.
  */
+#ifdef WOLFSSL_SP_ECC_TABLE
+static int sp_256_ecc_verify_4(const byte* hash, word32 hashLen, mp_int* pX,
+    mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm, int* res,
+    const sp_table_entry_256* table, void* heap)
+#else
 int sp_ecc_verify_256(const byte* hash, word32 hashLen, mp_int* pX,
     mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm, int* res, void* heap)
+#endif
 {
 #if (defined(WOLFSSL_SP_SMALL) || defined(WOLFSSL_SMALL_STACK)) && !defined(WOLFSSL_SP_NO_MALLOC)
     sp_digit* d = NULL;
@@ -23186,6 +23194,18 @@ int sp_ecc_verify_256(const byte* hash, word32 hashLen, mp_int* pX,
             err = sp_256_ecc_mulmod_base_4(p1, u1, 0, heap);
     }
     if (err == MP_OKAY) {
+#ifdef WOLFSSL_SP_ECC_TABLE
+        if (table != NULL) {
+#ifdef HAVE_INTEL_AVX2
+            if (IS_INTEL_BMI2(cpuid_flags) && IS_INTEL_ADX(cpuid_flags))
+                err = sp_256_ecc_mulmod_stripe_avx2_4(p2, p2, table, u2, 0,
+                                                                          heap);
+            else
+#endif
+                err = sp_256_ecc_mulmod_stripe_4(p2, p2, table, u2, 0, heap);
+        }
+        else
+#endif
 #ifdef HAVE_INTEL_AVX2
         if (IS_INTEL_BMI2(cpuid_flags) && IS_INTEL_ADX(cpuid_flags))
             err = sp_256_ecc_mulmod_avx2_4(p2, p2, u2, 0, heap);
@@ -23275,6 +23295,113 @@ int sp_ecc_verify_256(const byte* hash, word32 hashLen, mp_int* pX,
 
     return err;
 }
+
+#ifdef WOLFSSL_SP_ECC_TABLE
+/* Verify the signature values with the hash and public key.
+ *
+ * hash     Hash that was signed.
+ * hashLen  Length of the hash data.
+ * pX       X ordinate of the public key.
+ * pY       Y ordinate of the public key.
+ * pZ       Z ordinate of the public key.
+ * r        First part of signature as an mp_int.
+ * sm       Second part of signature as an mp_int.
+ * res      Result of verification: 1 when valid, 0 otherwise.
+ * heap     Heap to use for allocation.
+ * returns MEMORY_E when memory allocation fails and MP_OKAY on success.
+ */
+int sp_ecc_verify_256(const byte* hash, word32 hashLen, mp_int* pX,
+    mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm, int* res, void* heap)
+{
+    return sp_256_ecc_verify_4(hash, hashLen, pX, pY, pZ, r, sm, res, NULL,
+                                                                          heap);
+}
+
+/* Verify the signature values with the hash and a pre-computed table of
+ * multiples of the public key generated by sp_ecc_gen_table_256().
+ *
+ * hash     Hash that was signed.
+ * hashLen  Length of the hash data.
+ * pX       X ordinate of the public key.
+ * pY       Y ordinate of the public key.
+ * pZ       Z ordinate of the public key.
+ * r        First part of signature as an mp_int.
+ * sm       Second part of signature as an mp_int.
+ * res      Result of verification: 1 when valid, 0 otherwise.
+ * table    Table of points for the public key.
+ * heap     Heap to use for allocation.
+ * returns BAD_FUNC_ARG when table is NULL, MEMORY_E when memory allocation
+ * fails and MP_OKAY on success.
+ */
+int sp_ecc_verify_table_256(const byte* hash, word32 hashLen, mp_int* pX,
+    mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm, int* res,
+    const byte* table, void* heap)
+{
+    if (table == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    return sp_256_ecc_verify_4(hash, hashLen, pX, pY, pZ, r, sm, res,
+                                (const sp_table_entry_256*)table, heap);
+}
+
+/* Generate the table of points used to multiply the point by a scalar.
+ * The table is aligned for sp_digit when allocated with XMALLOC.
+ *
+ * gm     Point to generate table for.
+ * table  Buffer to hold the table. NULL to get the length.
+ * len    [in] Length of buffer. [out] Length of table.
+ * heap   Heap to use for allocation.
+ * returns BAD_FUNC_ARG when gm or len is NULL, LENGTH_ONLY_E when table is
+ * NULL, BUFFER_E when the buffer is too small, MEMORY_E when memory
+ * allocation fails and MP_OKAY on success.
+ */
+int sp_ecc_gen_table_256(ecc_point* gm, byte* table, word32* len, void* heap)
+{
+#if (!defined(WOLFSSL_SP_SMALL) && !defined(WOLFSSL_SMALL_STACK)) || defined(WOLFSSL_SP_NO_MALLOC)
+    sp_point_256 pd;
+#endif
+    sp_point_256* point = NULL;
+    sp_digit tmp[2 * 4 * 5];
+    int err = MP_OKAY;
+#ifdef HAVE_INTEL_AVX2
+    word32 cpuid_flags = cpuid_get_flags();
+#endif
+
+    if ((gm == NULL) || (len == NULL)) {
+        err = BAD_FUNC_ARG;
+    }
+    else if (table == NULL) {
+        *len = (word32)(sizeof(sp_table_entry_256) * 256);
+        err = LENGTH_ONLY_E;
+    }
+    else if (*len < (word32)(sizeof(sp_table_entry_256) * 256)) {
+        err = BUFFER_E;
+    }
+
+    if (err == MP_OKAY) {
+        err = sp_256_point_new_4(heap, pd, point);
+    }
+    if (err == MP_OKAY) {
+        sp_256_point_from_ecc_point_4(point, gm);
+#ifdef HAVE_INTEL_AVX2
+        if (IS_INTEL_BMI2(cpuid_flags) && IS_INTEL_ADX(cpuid_flags))
+            err = sp_256_gen_stripe_table_avx2_4(point,
+                                   (sp_table_entry_256*)table, tmp, heap);
+        else
+#endif
+            err = sp_256_gen_stripe_table_4(point, (sp_table_entry_256*)table,
+                                                                     tmp, heap);
+    }
+    if (err == MP_OKAY) {
+        *len = (word32)(sizeof(sp_table_entry_256) * 256);
+    }
+
+    sp_256_point_free_4(point, 0, heap);
+
+    return err;
+}
+#endif /* WOLFSSL_SP_ECC_TABLE */
 #endif /* HAVE_ECC_VERIFY */
 
 #ifdef HAVE_ECC_CHECK_KEY
@@ -25966,7 +26093,7 @@ static void sp_384_proj_point_add_qz1_6(sp_point_384* r, const sp_point_384* p,
     }
 }
 
-#ifdef FP_ECC
+#if defined(FP_ECC) || defined(WOLFSSL_SP_ECC_TABLE)
 /* Convert the projective point to affine.
  * Ordinates are in Montgomery form.
  *
@@ -26070,7 +26197,7 @@ static int sp_384_gen_stripe_table_6(const sp_point_384* a,
     return err;
 }
 
-#endif /* FP_ECC */
+#endif /* FP_ECC || WOLFSSL_SP_ECC_TABLE */
 /* Multiply the point by the scalar and return the result.
  * If map is true then convert result to affine coordinates.
  *
@@ -26370,7 +26497,7 @@ static void sp_384_proj_point_add_qz1_avx2_6(sp_point_384* r, const sp_point_384
     }
 }
 
-#ifdef FP_ECC
+#if defined(FP_ECC) || defined(WOLFSSL_SP_ECC_TABLE)
 /* Convert the projective point to affine.
  * Ordinates are in Montgomery form.
  *
@@ -26474,7 +26601,7 @@ static int sp_384_gen_stripe_table_avx2_6(const sp_point_384* a,
     return err;
 }
 
-#endif /* FP_ECC */
+#endif /* FP_ECC || WOLFSSL_SP_ECC_TABLE */
 /* Multiply the point by the scalar and return the result.
  * If map is true then convert result to affine coordinates.
  *
@@ -28882,8 +29009,14 @@ int sp_ecc_sign_384(const byte* hash, word32 hashLen, WC_RNG* rng, mp_int* priv,
  * returns RNG failures, MEMORY_E when memory allocation fails and
  * MP_OKAY on success.
  */
+#ifdef WOLFSSL_SP_ECC_TABLE
+static int sp_384_ecc_verify_6(const byte* hash, word32 hashLen, mp_int* pX,
+    mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm, int* res,
+    const sp_table_entry_384* table, void* heap)
+#else
 int sp_ecc_verify_384(const byte* hash, word32 hashLen, mp_int* pX,
     mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm, int* res, void* heap)
+#endif
 {
 #if (defined(WOLFSSL_SP_SMALL) || defined(WOLFSSL_SMALL_STACK)) && !defined(WOLFSSL_SP_NO_MALLOC)
     sp_digit* d = NULL;
@@ -28981,6 +29114,18 @@ int sp_ecc_verify_384(const byte* hash, word32 hashLen, mp_int* pX,
             err = sp_384_ecc_mulmod_base_6(p1, u1, 0, heap);
     }
     if (err == MP_OKAY) {
+#ifdef WOLFSSL_SP_ECC_TABLE
+        if (table != NULL) {
+#ifdef HAVE_INTEL_AVX2
+            if (IS_INTEL_BMI2(cpuid_flags) && IS_INTEL_ADX(cpuid_flags))
+                err = sp_384_ecc_mulmod_stripe_avx2_6(p2, p2, table, u2, 0,
+                                                                          heap);
+            else
+#endif
+                err = sp_384_ecc_mulmod_stripe_6(p2, p2, table, u2, 0, heap);
+        }
+        else
+#endif
 #ifdef HAVE_INTEL_AVX2
         if (IS_INTEL_BMI2(cpuid_flags) && IS_INTEL_ADX(cpuid_flags))
             err = sp_384_ecc_mulmod_avx2_6(p2, p2, u2, 0, heap);
@@ -29074,6 +29219,113 @@ int sp_ecc_verify_384(const byte* hash, word32 hashLen, mp_int* pX,
 
     return err;
 }
+
+#ifdef WOLFSSL_SP_ECC_TABLE
+/* Verify the signature values with the hash and public key.
+ *
+ * hash     Hash that was signed.
+ * hashLen  Length of the hash data.
+ * pX       X ordinate of the public key.
+ * pY       Y ordinate of the public key.
+ * pZ       Z ordinate of the public key.
+ * r        First part of signature as an mp_int.
+ * sm       Second part of signature as an mp_int.
+ * res      Result of verification: 1 when valid, 0 otherwise.
+ * heap     Heap to use for allocation.
+ * returns MEMORY_E when memory allocation fails and MP_OKAY on success.
+ */
+int sp_ecc_verify_384(const byte* hash, word32 hashLen, mp_int* pX,
+    mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm, int* res, void* heap)
+{
+    return sp_384_ecc_verify_6(hash, hashLen, pX, pY, pZ, r, sm, res, NULL,
+                                                                          heap);
+}
+
+/* Verify the signature values with the hash and a pre-computed table of
+ * multiples of the public key generated by sp_ecc_gen_table_384().
+ *
+ * hash     Hash that was signed.
+ * hashLen  Length of the hash data.
+ * pX       X ordinate of the public key.
+ * pY       Y ordinate of the public key.
+ * pZ       Z ordinate of the public key.
+ * r        First part of signature as an mp_int.
+ * sm       Second part of signature as an mp_int.
+ * res      Result of verification: 1 when valid, 0 otherwise.
+ * table    Table of points for the public key.
+ * heap     Heap to use for allocation.
+ * returns BAD_FUNC_ARG when table is NULL, MEMORY_E when memory allocation
+ * fails and MP_OKAY on success.
+ */
+int sp_ecc_verify_table_384(const byte* hash, word32 hashLen, mp_int* pX,
+    mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm, int* res,
+    const byte* table, void* heap)
+{
+    if (table == NULL) {
+        return BAD_FUNC_ARG;
+    }
+
+    return sp_384_ecc_verify_6(hash, hashLen, pX, pY, pZ, r, sm, res,
+                                (const sp_table_entry_384*)table, heap);
+}
+
+/* Generate the table of points used to multiply the point by a scalar.
+ * The table is aligned for sp_digit when allocated with XMALLOC.
+ *
+ * gm     Point to generate table for.
+ * table  Buffer to hold the table. NULL to get the length.
+ * len    [in] Length of buffer. [out] Length of table.
+ * heap   Heap to use for allocation.
+ * returns BAD_FUNC_ARG when gm or len is NULL, LENGTH_ONLY_E when table is
+ * NULL, BUFFER_E when the buffer is too small, MEMORY_E when memory
+ * allocation fails and MP_OKAY on success.
+ */
+int sp_ecc_gen_table_384(ecc_point* gm, byte* table, word32* len, void* heap)
+{
+#if (!defined(WOLFSSL_SP_SMALL) && !defined(WOLFSSL_SMALL_STACK)) || defined(WOLFSSL_SP_NO_MALLOC)
+    sp_point_384 pd;
+#endif
+    sp_point_384* point = NULL;
+    sp_digit tmp[2 * 6 * 7];
+    int err = MP_OKAY;
+#ifdef HAVE_INTEL_AVX2
+    word32 cpuid_flags = cpuid_get_flags();
+#endif
+
+    if ((gm == NULL) || (len == NULL)) {
+        err = BAD_FUNC_ARG;
+    }
+    else if (table == NULL) {
+        *len = (word32)(sizeof(sp_table_entry_384) * 256);
+        err = LENGTH_ONLY_E;
+    }
+    else if (*len < (word32)(sizeof(sp_table_entry_384) * 256)) {
+        err = BUFFER_E;
+    }
+
+    if (err == MP_OKAY) {
+        err = sp_384_point_new_6(heap, pd, point);
+    }
+    if (err == MP_OKAY) {
+        sp_384_point_from_ecc_point_6(point, gm);
+#ifdef HAVE_INTEL_AVX2
+        if (IS_INTEL_BMI2(cpuid_flags) && IS_INTEL_ADX(cpuid_flags))
+            err = sp_384_gen_stripe_table_avx2_6(point,
+                                   (sp_table_entry_384*)table, tmp, heap);
+        else
+#endif
+            err = sp_384_gen_stripe_table_6(point, (sp_table_entry_384*)table,
+                                                                     tmp, heap);
+    }
+    if (err == MP_OKAY) {
+        *len = (word32)(sizeof(sp_table_entry_384) * 256);
+    }
+
+    sp_384_point_free_6(point, 0, heap);
+
+    return err;
+}
+#endif /* WOLFSSL_SP_ECC_TABLE */
 #endif /* HAVE_ECC_VERIFY */
 
 #ifdef HAVE_ECC_CHECK_KEY
@@ -1565,7 +1565,7 @@ int fp_exptmod_nb(exptModNb_t* nb, fp_int* G, fp_int* X, fp_int* P, fp_int* Y)
    Cryptographic Hardware and Embedded Systems, CHES 2002
 */
 static int _fp_exptmod_ct(fp_int * G, fp_int * X, int digits, fp_int * P,
-                          fp_int * Y)
+                          fp_mont_ctx* ctx, fp_int * Y)
 {
 #ifndef WOLFSSL_SMALL_STACK
 #ifdef WC_NO_CACHE_RESISTANT
@@ -1580,7 +1580,10 @@ static int _fp_exptmod_ct(fp_int * G, fp_int * X, int digits, fp_int * P,
   int      err, bitcnt, digidx, y;
 
   /* now setup montgomery  */
-  if ((err = fp_montgomery_setup (P, &mp)) != FP_OKAY) {
+  if (ctx != NULL) {
+     mp = ctx->rho;
+  }
+  else if ((err = fp_montgomery_setup (P, &mp)) != FP_OKAY) {
      return err;
   }
 
@@ -1599,9 +1602,6 @@ static int _fp_exptmod_ct(fp_int * G, fp_int * X, int digits, fp_int * P,
   fp_init(&R[2]);
 #endif
 
-  /* now we need R mod m */
-  fp_montgomery_calc_normalization (&R[0], P);
-
   /* now set R[0][1] to G * R mod m */
   if (fp_cmp_mag(P, G) != FP_GT) {
      /* G > P so we reduce it first */
@@ -1609,7 +1609,24 @@ static int _fp_exptmod_ct(fp_int * G, fp_int * X, int digits, fp_int * P,
   } else {
      fp_copy(G, &R[1]);
   }
-  fp_mulmod (&R[1], &R[0], P, &R[1]);
+  if (ctx != NULL) {
+     /* R mod m and G * R^2 / R mod m from cached values */
+     fp_copy(&ctx->r, &R[0]);
+     err = fp_mul(&R[1], &ctx->r2, &R[1]);
+     if (err == FP_OKAY)
+        err = fp_montgomery_reduce(&R[1], P, mp);
+     if (err != FP_OKAY) {
+     #ifdef WOLFSSL_SMALL_STACK
+        XFREE(R, NULL, DYNAMIC_TYPE_BIGINT);
+     #endif
+        return err;
+     }
+  }
+  else {
+     /* now we need R mod m */
+     fp_montgomery_calc_normalization (&R[0], P);
+     fp_mulmod (&R[1], &R[0], P, &R[1]);
+  }
 
   /* for j = t-1 downto 0 do
         r_!k = R0*R1; r_k = r_k^2
@@ -1707,7 +1724,8 @@ static int _fp_exptmod_ct(fp_int * G, fp_int * X, int digits, fp_int * P,
 /* y = g**x (mod b)
  * Some restrictions... x must be positive and < b
  */
-static int _fp_exptmod_nct(fp_int * G, fp_int * X, fp_int * P, fp_int * Y)
+static int _fp_exptmod_nct(fp_int * G, fp_int * X, fp_int * P,
+                           fp_mont_ctx* ctx, fp_int * Y)
 {
   fp_int  *res;
   fp_digit buf, mp;
@@ -1733,7 +1751,10 @@ static int _fp_exptmod_nct(fp_int * G, fp_int * X, fp_int * P, fp_int * Y)
   }
 
   /* now setup montgomery  */
-  if ((err = fp_montgomery_setup (P, &mp)) != FP_OKAY) {
+  if (ctx != NULL) {
+     mp = ctx->rho;
+  }
+  else if ((err = fp_montgomery_setup (P, &mp)) != FP_OKAY) {
      return err;
   }
 
@@ -1761,9 +1782,6 @@ static int _fp_exptmod_nct(fp_int * G, fp_int * X, fp_int * P, fp_int * Y)
    * The first half of the table is not computed though except for M[0] and M[1]
    */
 
-   /* now we need R mod m */
-   fp_montgomery_calc_normalization (res, P);
-
    /* now set M[1] to G * R mod m */
    if (fp_cmp_mag(P, G) != FP_GT) {
       /* G > P so we reduce it first */
@@ -1771,7 +1789,24 @@ static int _fp_exptmod_nct(fp_int * G, fp_int * X, fp_int * P, fp_int * Y)
    } else {
       fp_copy(G, &M[1]);
    }
-   fp_mulmod (&M[1], res, P, &M[1]);
+   if (ctx != NULL) {
+      /* R mod m and G * R^2 / R mod m from cached values */
+      fp_copy(&ctx->r, res);
+      err = fp_mul(&M[1], &ctx->r2, &M[1]);
+      if (err == FP_OKAY)
+         err = fp_montgomery_reduce(&M[1], P, mp);
+      if (err != FP_OKAY) {
+#ifndef WOLFSSL_NO_MALLOC
+         XFREE(M, NULL, DYNAMIC_TYPE_BIGINT);
+#endif
+         return err;
+      }
+   }
+   else {
+      /* now we need R mod m */
+      fp_montgomery_calc_normalization (res, P);
+      fp_mulmod (&M[1], res, P, &M[1]);
+   }
 
   /* compute the value at M[1<<(winsize-1)] by
    * squaring M[1] (winsize-1) times */
@@ -2328,9 +2363,9 @@ int fp_exptmod(fp_int * G, fp_int * X, fp_int * P, fp_int * Y)
          fp_copy(X, &tmp[1]);
          tmp[1].sign = FP_ZPOS;
 #ifdef TFM_TIMING_RESISTANT
-         err =  _fp_exptmod_ct(&tmp[0], &tmp[1], tmp[1].used, P, Y);
+         err =  _fp_exptmod_ct(&tmp[0], &tmp[1], tmp[1].used, P, NULL, Y);
 #else
-         err =  _fp_exptmod_nct(&tmp[0], &tmp[1], P, Y);
+         err =  _fp_exptmod_nct(&tmp[0], &tmp[1], P, NULL, Y);
 #endif
          if (P->sign == FP_NEG) {
             fp_add(Y, P, Y);
@@ -2350,9 +2385,9 @@ int fp_exptmod(fp_int * G, fp_int * X, fp_int * P, fp_int * Y)
    else {
       /* Positive exponent so just exptmod */
 #ifdef TFM_TIMING_RESISTANT
-      return _fp_exptmod_ct(G, X, X->used, P, Y);
+      return _fp_exptmod_ct(G, X, X->used, P, NULL, Y);
 #else
-      return _fp_exptmod_nct(G, X, P, Y);
+      return _fp_exptmod_nct(G, X, P, NULL, Y);
 #endif
    }
 }
@@ -2405,9 +2440,9 @@ int fp_exptmod_ex(fp_int * G, fp_int * X, int digits, fp_int * P, fp_int * Y)
       if (err == FP_OKAY) {
          X->sign = FP_ZPOS;
 #ifdef TFM_TIMING_RESISTANT
-         err =  _fp_exptmod_ct(&tmp[0], X, digits, P, Y);
+         err =  _fp_exptmod_ct(&tmp[0], X, digits, P, NULL, Y);
 #else
-         err =  _fp_exptmod_nct(&tmp[0], X, P, Y);
+         err =  _fp_exptmod_nct(&tmp[0], X, P, NULL, Y);
          (void)digits;
 #endif
          if (X != Y) {
@@ -2428,9 +2463,9 @@ int fp_exptmod_ex(fp_int * G, fp_int * X, int digits, fp_int * P, fp_int * Y)
    else {
       /* Positive exponent so just exptmod */
 #ifdef TFM_TIMING_RESISTANT
-      return _fp_exptmod_ct(G, X, digits, P, Y);
+      return _fp_exptmod_ct(G, X, digits, P, NULL, Y);
 #else
-      return  _fp_exptmod_nct(G, X, P, Y);
+      return  _fp_exptmod_nct(G, X, P, NULL, Y);
 #endif
    }
 }
@@ -2481,7 +2516,7 @@ int fp_exptmod_nct(fp_int * G, fp_int * X, fp_int * P, fp_int * Y)
       err = fp_invmod(&tmp[0], &tmp[1], &tmp[0]);
       if (err == FP_OKAY) {
          X->sign = FP_ZPOS;
-         err =  _fp_exptmod_nct(&tmp[0], X, P, Y);
+         err =  _fp_exptmod_nct(&tmp[0], X, P, NULL, Y);
          if (X != Y) {
             X->sign = FP_NEG;
          }
@@ -2499,10 +2534,91 @@ int fp_exptmod_nct(fp_int * G, fp_int * X, fp_int * P, fp_int * Y)
    }
    else {
       /* Positive exponent so just exptmod */
-      return  _fp_exptmod_nct(G, X, P, Y);
+      return  _fp_exptmod_nct(G, X, P, NULL, Y);
+   }
+}
+
+#ifdef HAVE_MP_MONT_CTX
+
+/* compute the Montgomery parameters of odd modulus m into ctx */
+int fp_mont_ctx_set(fp_mont_ctx *ctx, fp_int *m)
+{
+   int err;
+
+   if (ctx == NULL || m == NULL || fp_iszero(m) || m->used > (FP_SIZE/2)) {
+      return FP_VAL;
    }
+
+   if ((err = fp_montgomery_setup(m, &ctx->rho)) != FP_OKAY) {
+      return err;
+   }
+
+   fp_init(&ctx->r);
+   fp_init(&ctx->r2);
+   fp_init_copy(&ctx->m, m);
+
+   /* r = R mod m, r2 = R * R mod m */
+   fp_montgomery_calc_normalization(&ctx->r, m);
+   return fp_mulmod(&ctx->r, &ctx->r, m, &ctx->r2);
 }
 
+/* y = g**x (mod p) using Montgomery parameters of p set in ctx,
+ * x must be positive */
+int fp_exptmod_mont(fp_int * G, fp_int * X, int digits, fp_int * P,
+                    fp_mont_ctx * ctx, fp_int * Y)
+{
+   if (ctx == NULL || X->sign == FP_NEG) {
+      return FP_VAL;
+   }
+
+   /* prevent overflows */
+   if (P->used > (FP_SIZE/2)) {
+      return FP_VAL;
+   }
+   if (fp_iszero(X)) {
+      fp_set(Y, 1);
+      return FP_OKAY;
+   }
+   if (fp_iszero(G)) {
+      fp_set(Y, 0);
+      return FP_OKAY;
+   }
+
+#ifdef TFM_TIMING_RESISTANT
+   return _fp_exptmod_ct(G, X, digits, P, ctx, Y);
+#else
+   (void)digits;
+   return _fp_exptmod_nct(G, X, P, ctx, Y);
+#endif
+}
+
+/* y = g**x (mod p) using Montgomery parameters of p set in ctx, not constant
+ * time so only for public exponents, x must be positive */
+int fp_exptmod_mont_nct(fp_int * G, fp_int * X, fp_int * P, fp_mont_ctx * ctx,
+                        fp_int * Y)
+{
+   if (ctx == NULL || X->sign == FP_NEG) {
+      return FP_VAL;
+   }
+
+   /* prevent overflows */
+   if (P->used > (FP_SIZE/2)) {
+      return FP_VAL;
+   }
+   if (fp_iszero(X)) {
+      fp_set(Y, 1);
+      return FP_OKAY;
+   }
+   if (fp_iszero(G)) {
+      fp_set(Y, 0);
+      return FP_OKAY;
+   }
+
+   return _fp_exptmod_nct(G, X, P, ctx, Y);
+}
+
+#endif /* HAVE_MP_MONT_CTX */
+
 /* computes a = 2**b */
 void fp_2expt(fp_int *a, int b)
 {
@@ -3724,6 +3840,25 @@ int mp_exptmod_nct (mp_int * G, mp_int * X, mp_int * P, mp_int * Y)
   return fp_exptmod_nct(G, X, P, Y);
 }
 
+#ifdef HAVE_MP_MONT_CTX
+int mp_mont_ctx_set (mp_mont_ctx * ctx, mp_int * m)
+{
+  return fp_mont_ctx_set(ctx, m);
+}
+
+int mp_exptmod_mont (mp_int * G, mp_int * X, int digits, mp_int * P,
+                     mp_mont_ctx * ctx, mp_int * Y)
+{
+  return fp_exptmod_mont(G, X, digits, P, ctx, Y);
+}
+
+int mp_exptmod_mont_nct (mp_int * G, mp_int * X, mp_int * P,
+                         mp_mont_ctx * ctx, mp_int * Y)
+{
+  return fp_exptmod_mont_nct(G, X, P, ctx, Y);
+}
+#endif
+
 
 /* compare two ints (signed)*/
 int mp_cmp (mp_int * a, mp_int * b)
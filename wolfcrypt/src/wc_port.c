@@ -35,6 +35,9 @@
 #ifdef WOLFSSL_ASYNC_CRYPT
     #include <wolfssl/wolfcrypt/async.h>
 #endif
+#ifdef WC_RNG_POOL
+    #include <wolfssl/wolfcrypt/random.h>
+#endif
 
 /* IPP header files for library initialization */
 #ifdef HAVE_FAST_RSA
@@ -219,6 +222,18 @@ int wolfCrypt_Init(void)
             return ret;
         }
     #endif
+    #ifdef WOLFSSL_FUNC_TIME
+        if ((ret = wc_FuncTimeInit()) != 0) {
+            WOLFSSL_MSG("Error creating function time mutex");
+            return ret;
+        }
+    #endif
+    #ifdef WC_RNG_POOL
+        if ((ret = wc_RngPoolInit()) != 0) {
+            WOLFSSL_MSG("Error creating RNG pool thread key");
+            return ret;
+        }
+    #endif
 
 #ifdef HAVE_ECC
     #ifdef FP_ECC
@@ -285,10 +300,17 @@ int wolfCrypt_Cleanup(void)
         wc_ecc_curve_cache_free();
     #endif
 #endif /* HAVE_ECC */
+    #ifdef WC_RNG_POOL
+        wc_RngPoolCleanup();
+    #endif
 
     #if defined(OPENSSL_EXTRA) || defined(DEBUG_WOLFSSL_VERBOSE)
         ret = wc_LoggingCleanup();
     #endif
+    #ifdef WOLFSSL_FUNC_TIME
+        if (wc_FuncTimeCleanup() != 0 && ret == 0)
+            ret = BAD_MUTEX_E;
+    #endif
 
     #if defined(WOLFSSL_TRACK_MEMORY) && !defined(WOLFSSL_STATIC_MEMORY)
         ShowMemoryTracker();
@@ -1855,6 +1877,87 @@ int wolfSSL_CryptHwMutexUnLock(void) {
 
 #endif
 
+#if defined(WOLFSSL_PTHREADS) && !defined(SINGLE_THREADED) && \
+    !defined(WOLFSSL_NO_RWLOCK)
+
+    int wc_InitRwLock(wolfSSL_RwLock* m)
+    {
+        if (pthread_rwlock_init(m, 0) == 0)
+            return 0;
+        else
+            return BAD_MUTEX_E;
+    }
+
+
+    int wc_FreeRwLock(wolfSSL_RwLock* m)
+    {
+        if (pthread_rwlock_destroy(m) == 0)
+            return 0;
+        else
+            return BAD_MUTEX_E;
+    }
+
+
+    int wc_LockRwLock_Rd(wolfSSL_RwLock* m)
+    {
+        if (pthread_rwlock_rdlock(m) == 0)
+            return 0;
+        else
+            return BAD_MUTEX_E;
+    }
+
+
+    int wc_LockRwLock_Wr(wolfSSL_RwLock* m)
+    {
+        if (pthread_rwlock_wrlock(m) == 0)
+            return 0;
+        else
+            return BAD_MUTEX_E;
+    }
+
+
+    int wc_UnLockRwLock(wolfSSL_RwLock* m)
+    {
+        if (pthread_rwlock_unlock(m) == 0)
+            return 0;
+        else
+            return BAD_MUTEX_E;
+    }
+
+#else
+
+    /* no read-write lock on this platform, readers are exclusive too */
+    int wc_InitRwLock(wolfSSL_RwLock* m)
+    {
+        return wc_InitMutex(m);
+    }
+
+
+    int wc_FreeRwLock(wolfSSL_RwLock* m)
+    {
+        return wc_FreeMutex(m);
+    }
+
+
+    int wc_LockRwLock_Rd(wolfSSL_RwLock* m)
+    {
+        return wc_LockMutex(m);
+    }
+
+
+    int wc_LockRwLock_Wr(wolfSSL_RwLock* m)
+    {
+        return wc_LockMutex(m);
+    }
+
+
+    int wc_UnLockRwLock(wolfSSL_RwLock* m)
+    {
+        return wc_UnLockMutex(m);
+    }
+
+#endif
+
 #ifndef NO_ASN_TIME
 #if defined(_WIN32_WCE)
 time_t windows_time(time_t* timer)
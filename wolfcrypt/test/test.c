@@ -2400,6 +2400,43 @@ int sha256_test(void)
         ERROR_OUT(-2309, exit);
     if (XMEMCMP(hash, large_digest, WC_SHA256_DIGEST_SIZE) != 0)
         ERROR_OUT(-2310, exit);
+
+    /* BEGIN MULTIPLE MESSAGE HASH TEST */ {
+    const byte* data[11];
+    word32      len[11];
+    byte        hashes[11][WC_SHA256_DIGEST_SIZE];
+    byte*       out[11];
+
+    /* more messages than lanes with lengths around the block boundaries */
+    for (i = 0; i < 11; i++) {
+        if (i < 3) {
+            data[i] = (const byte*)test_sha[i].input;
+            len[i] = (word32)test_sha[i].inLen;
+        }
+        else {
+            data[i] = large_input + i;
+            len[i] = (word32)sizeof(large_input) - 11 - (i - 3) * 129;
+        }
+        out[i] = hashes[i];
+    }
+    ret = wc_Sha256HashMulti(data, len, out, 11);
+    if (ret != 0)
+        ERROR_OUT(-2311, exit);
+    for (i = 0; i < 3; i++) {
+        if (XMEMCMP(hashes[i], test_sha[i].output,
+                                                 WC_SHA256_DIGEST_SIZE) != 0)
+            ERROR_OUT(-2312, exit);
+    }
+    for (i = 3; i < 11; i++) {
+        ret = wc_Sha256Update(&sha, data[i], len[i]);
+        if (ret == 0)
+            ret = wc_Sha256Final(&sha, hash);
+        if (ret != 0)
+            ERROR_OUT(-2313, exit);
+        if (XMEMCMP(hashes[i], hash, WC_SHA256_DIGEST_SIZE) != 0)
+            ERROR_OUT(-2314, exit);
+    }
+    } /* END MULTIPLE MESSAGE HASH TEST */
     } /* END LARGE HASH TEST */
 
 exit:
@@ -2510,6 +2547,43 @@ int sha512_test(void)
         ERROR_OUT(-2409, exit);
     if (XMEMCMP(hash, large_digest, WC_SHA512_DIGEST_SIZE) != 0)
         ERROR_OUT(-2410, exit);
+
+    /* BEGIN MULTIPLE MESSAGE HASH TEST */ {
+    const byte* data[11];
+    word32      len[11];
+    byte        hashes[11][WC_SHA512_DIGEST_SIZE];
+    byte*       out[11];
+
+    /* more messages than lanes with lengths around the block boundaries */
+    for (i = 0; i < 11; i++) {
+        if (i < 3) {
+            data[i] = (const byte*)test_sha[i].input;
+            len[i] = (word32)test_sha[i].inLen;
+        }
+        else {
+            data[i] = large_input + i;
+            len[i] = (word32)sizeof(large_input) - 11 - (i - 3) * 129;
+        }
+        out[i] = hashes[i];
+    }
+    ret = wc_Sha512HashMulti(data, len, out, 11);
+    if (ret != 0)
+        ERROR_OUT(-2411, exit);
+    for (i = 0; i < 3; i++) {
+        if (XMEMCMP(hashes[i], test_sha[i].output,
+                                                 WC_SHA512_DIGEST_SIZE) != 0)
+            ERROR_OUT(-2412, exit);
+    }
+    for (i = 3; i < 11; i++) {
+        ret = wc_Sha512Update(&sha, data[i], len[i]);
+        if (ret == 0)
+            ret = wc_Sha512Final(&sha, hash);
+        if (ret != 0)
+            ERROR_OUT(-2413, exit);
+        if (XMEMCMP(hashes[i], hash, WC_SHA512_DIGEST_SIZE) != 0)
+            ERROR_OUT(-2414, exit);
+    }
+    } /* END MULTIPLE MESSAGE HASH TEST */
     } /* END LARGE HASH TEST */
 
 exit:
@@ -2639,6 +2713,7 @@ static int sha3_224_test(void)
     testVector test_sha[3];
     int ret = 0;
     int times = sizeof(test_sha) / sizeof(struct testVector), i;
+    byte large_input[1024];
 
     a.input  = "";
     a.output = "\x6b\x4e\x03\x42\x36\x67\xdb\xb7\x3b\x6e\x15\x45\x4f\x0e\xb1"
@@ -2685,7 +2760,6 @@ static int sha3_224_test(void)
     }
 
     /* BEGIN LARGE HASH TEST */ {
-    byte large_input[1024];
     const char* large_digest =
         "\x13\xe5\xd3\x98\x7b\x94\xda\x41\x12\xc7\x1e\x92\x3a\x19"
         "\x21\x20\x86\x6f\x24\xbf\x0a\x31\xbc\xfd\xd6\x70\x36\xf3";
@@ -2707,6 +2781,56 @@ static int sha3_224_test(void)
         ERROR_OUT(-2608, exit);
     } /* END LARGE HASH TEST */
 
+    /* BEGIN FOUR MESSAGE HASH TEST */ {
+    const byte* data[4];
+    word32      len[4];
+    byte        hashes[4][WC_SHA3_224_DIGEST_SIZE];
+    byte*       out[4];
+
+    /* different lengths - longest message completed on its own */
+    for (i = 0; i < 3; i++) {
+        data[i] = (const byte*)test_sha[i].input;
+        len[i] = (word32)test_sha[i].inLen;
+        out[i] = hashes[i];
+    }
+    data[3] = large_input;
+    len[3] = (word32)sizeof(large_input);
+    out[3] = hashes[3];
+    ret = wc_Sha3_224Hash_x4(data, len, out);
+    if (ret != 0)
+        ERROR_OUT(-2613, exit);
+    for (i = 0; i < 3; i++) {
+        if (XMEMCMP(hashes[i], test_sha[i].output,
+                                                WC_SHA3_224_DIGEST_SIZE) != 0)
+            ERROR_OUT(-2614, exit);
+    }
+    ret = wc_Sha3_224_Update(&sha, large_input, (word32)sizeof(large_input));
+    if (ret == 0)
+        ret = wc_Sha3_224_Final(&sha, hash);
+    if (ret != 0)
+        ERROR_OUT(-2615, exit);
+    if (XMEMCMP(hashes[3], hash, WC_SHA3_224_DIGEST_SIZE) != 0)
+        ERROR_OUT(-2616, exit);
+
+    /* same lengths - all blocks processed together */
+    for (i = 0; i < 4; i++) {
+        data[i] = large_input + i;
+        len[i] = (word32)sizeof(large_input) - 3;
+    }
+    ret = wc_Sha3_224Hash_x4(data, len, out);
+    if (ret != 0)
+        ERROR_OUT(-2617, exit);
+    for (i = 0; i < 4; i++) {
+        ret = wc_Sha3_224_Update(&sha, data[i], len[i]);
+        if (ret == 0)
+            ret = wc_Sha3_224_Final(&sha, hash);
+        if (ret != 0)
+            ERROR_OUT(-2618, exit);
+        if (XMEMCMP(hashes[i], hash, WC_SHA3_224_DIGEST_SIZE) != 0)
+            ERROR_OUT(-2619, exit);
+    }
+    } /* END FOUR MESSAGE HASH TEST */
+
 exit:
     wc_Sha3_224_Free(&sha);
 
@@ -2803,6 +2927,56 @@ static int sha3_256_test(void)
         ERROR_OUT(-2708, exit);
     } /* END LARGE HASH TEST */
 
+    /* BEGIN FOUR MESSAGE HASH TEST */ {
+    const byte* data[4];
+    word32      len[4];
+    byte        hashes[4][WC_SHA3_256_DIGEST_SIZE];
+    byte*       out[4];
+
+    /* different lengths - longest message completed on its own */
+    for (i = 0; i < 3; i++) {
+        data[i] = (const byte*)test_sha[i].input;
+        len[i] = (word32)test_sha[i].inLen;
+        out[i] = hashes[i];
+    }
+    data[3] = large_input;
+    len[3] = (word32)sizeof(large_input);
+    out[3] = hashes[3];
+    ret = wc_Sha3_256Hash_x4(data, len, out);
+    if (ret != 0)
+        ERROR_OUT(-2713, exit);
+    for (i = 0; i < 3; i++) {
+        if (XMEMCMP(hashes[i], test_sha[i].output,
+                                                WC_SHA3_256_DIGEST_SIZE) != 0)
+            ERROR_OUT(-2714, exit);
+    }
+    ret = wc_Sha3_256_Update(&sha, large_input, (word32)sizeof(large_input));
+    if (ret == 0)
+        ret = wc_Sha3_256_Final(&sha, hash);
+    if (ret != 0)
+        ERROR_OUT(-2715, exit);
+    if (XMEMCMP(hashes[3], hash, WC_SHA3_256_DIGEST_SIZE) != 0)
+        ERROR_OUT(-2716, exit);
+
+    /* same lengths - all blocks processed together */
+    for (i = 0; i < 4; i++) {
+        data[i] = large_input + i;
+        len[i] = (word32)sizeof(large_input) - 3;
+    }
+    ret = wc_Sha3_256Hash_x4(data, len, out);
+    if (ret != 0)
+        ERROR_OUT(-2717, exit);
+    for (i = 0; i < 4; i++) {
+        ret = wc_Sha3_256_Update(&sha, data[i], len[i]);
+        if (ret == 0)
+            ret = wc_Sha3_256_Final(&sha, hash);
+        if (ret != 0)
+            ERROR_OUT(-2718, exit);
+        if (XMEMCMP(hashes[i], hash, WC_SHA3_256_DIGEST_SIZE) != 0)
+            ERROR_OUT(-2719, exit);
+    }
+    } /* END FOUR MESSAGE HASH TEST */
+
     /* this is a software only variant of SHA3 not supported by external hardware devices */
 #if defined(WOLFSSL_HASH_FLAGS) && !defined(WOLFSSL_ASYNC_CRYPT)
     /* Test for Keccak256 */
@@ -2843,6 +3017,7 @@ static int sha3_384_test(void)
     testVector test_sha[3];
     int ret;
     int times = sizeof(test_sha) / sizeof(struct testVector), i;
+    byte large_input[1024];
 
     a.input  = "";
     a.output = "\x0c\x63\xa7\x5b\x84\x5e\x4f\x7d\x01\x10\x7d\x85\x2e\x4c\x24"
@@ -2914,7 +3089,6 @@ static int sha3_384_test(void)
     }
 
     /* BEGIN LARGE HASH TEST */ {
-    byte large_input[1024];
     const char* large_digest =
         "\x30\x44\xec\x17\xef\x47\x9f\x55\x36\x11\xd6\x3f\x8a\x31\x5a\x71"
         "\x8a\x71\xa7\x1d\x8e\x84\xe8\x6c\x24\x02\x2f\x7a\x08\x4e\xea\xd7"
@@ -2937,6 +3111,56 @@ static int sha3_384_test(void)
         ERROR_OUT(-2808, exit);
     } /* END LARGE HASH TEST */
 
+    /* BEGIN FOUR MESSAGE HASH TEST */ {
+    const byte* data[4];
+    word32      len[4];
+    byte        hashes[4][WC_SHA3_384_DIGEST_SIZE];
+    byte*       out[4];
+
+    /* different lengths - longest message completed on its own */
+    for (i = 0; i < 3; i++) {
+        data[i] = (const byte*)test_sha[i].input;
+        len[i] = (word32)test_sha[i].inLen;
+        out[i] = hashes[i];
+    }
+    data[3] = large_input;
+    len[3] = (word32)sizeof(large_input);
+    out[3] = hashes[3];
+    ret = wc_Sha3_384Hash_x4(data, len, out);
+    if (ret != 0)
+        ERROR_OUT(-2813, exit);
+    for (i = 0; i < 3; i++) {
+        if (XMEMCMP(hashes[i], test_sha[i].output,
+                                                WC_SHA3_384_DIGEST_SIZE) != 0)
+            ERROR_OUT(-2814, exit);
+    }
+    ret = wc_Sha3_384_Update(&sha, large_input, (word32)sizeof(large_input));
+    if (ret == 0)
+        ret = wc_Sha3_384_Final(&sha, hash);
+    if (ret != 0)
+        ERROR_OUT(-2815, exit);
+    if (XMEMCMP(hashes[3], hash, WC_SHA3_384_DIGEST_SIZE) != 0)
+        ERROR_OUT(-2816, exit);
+
+    /* same lengths - all blocks processed together */
+    for (i = 0; i < 4; i++) {
+        data[i] = large_input + i;
+        len[i] = (word32)sizeof(large_input) - 3;
+    }
+    ret = wc_Sha3_384Hash_x4(data, len, out);
+    if (ret != 0)
+        ERROR_OUT(-2817, exit);
+    for (i = 0; i < 4; i++) {
+        ret = wc_Sha3_384_Update(&sha, data[i], len[i]);
+        if (ret == 0)
+            ret = wc_Sha3_384_Final(&sha, hash);
+        if (ret != 0)
+            ERROR_OUT(-2818, exit);
+        if (XMEMCMP(hashes[i], hash, WC_SHA3_384_DIGEST_SIZE) != 0)
+            ERROR_OUT(-2819, exit);
+    }
+    } /* END FOUR MESSAGE HASH TEST */
+
 exit:
     wc_Sha3_384_Free(&sha);
 
@@ -2955,6 +3179,7 @@ static int sha3_512_test(void)
     testVector test_sha[3];
     int ret;
     int times = sizeof(test_sha) / sizeof(struct testVector), i;
+    byte large_input[1024];
 
     a.input  = "";
     a.output = "\xa6\x9f\x73\xcc\xa2\x3a\x9a\xc5\xc8\xb5\x67\xdc\x18\x5a\x75"
@@ -3010,7 +3235,6 @@ static int sha3_512_test(void)
     }
 
     /* BEGIN LARGE HASH TEST */ {
-    byte large_input[1024];
     const char* large_digest =
         "\x9c\x13\x26\xb6\x26\xb2\x94\x31\xbc\xf4\x34\xe9\x6f\xf2\xd6\x29"
         "\x9a\xd0\x9b\x32\x63\x2f\x18\xa7\x5f\x23\xc9\x60\xc2\x32\x0c\xbc"
@@ -3034,6 +3258,56 @@ static int sha3_512_test(void)
         ERROR_OUT(-2908, exit);
     } /* END LARGE HASH TEST */
 
+    /* BEGIN FOUR MESSAGE HASH TEST */ {
+    const byte* data[4];
+    word32      len[4];
+    byte        hashes[4][WC_SHA3_512_DIGEST_SIZE];
+    byte*       out[4];
+
+    /* different lengths - longest message completed on its own */
+    for (i = 0; i < 3; i++) {
+        data[i] = (const byte*)test_sha[i].input;
+        len[i] = (word32)test_sha[i].inLen;
+        out[i] = hashes[i];
+    }
+    data[3] = large_input;
+    len[3] = (word32)sizeof(large_input);
+    out[3] = hashes[3];
+    ret = wc_Sha3_512Hash_x4(data, len, out);
+    if (ret != 0)
+        ERROR_OUT(-2913, exit);
+    for (i = 0; i < 3; i++) {
+        if (XMEMCMP(hashes[i], test_sha[i].output,
+                                                WC_SHA3_512_DIGEST_SIZE) != 0)
+            ERROR_OUT(-2914, exit);
+    }
+    ret = wc_Sha3_512_Update(&sha, large_input, (word32)sizeof(large_input));
+    if (ret == 0)
+        ret = wc_Sha3_512_Final(&sha, hash);
+    if (ret != 0)
+        ERROR_OUT(-2915, exit);
+    if (XMEMCMP(hashes[3], hash, WC_SHA3_512_DIGEST_SIZE) != 0)
+        ERROR_OUT(-2916, exit);
+
+    /* same lengths - all blocks processed together */
+    for (i = 0; i < 4; i++) {
+        data[i] = large_input + i;
+        len[i] = (word32)sizeof(large_input) - 3;
+    }
+    ret = wc_Sha3_512Hash_x4(data, len, out);
+    if (ret != 0)
+        ERROR_OUT(-2917, exit);
+    for (i = 0; i < 4; i++) {
+        ret = wc_Sha3_512_Update(&sha, data[i], len[i]);
+        if (ret == 0)
+            ret = wc_Sha3_512_Final(&sha, hash);
+        if (ret != 0)
+            ERROR_OUT(-2918, exit);
+        if (XMEMCMP(hashes[i], hash, WC_SHA3_512_DIGEST_SIZE) != 0)
+            ERROR_OUT(-2919, exit);
+    }
+    } /* END FOUR MESSAGE HASH TEST */
+
 exit:
     wc_Sha3_512_Free(&sha);
 
@@ -3166,6 +3440,36 @@ int shake256_test(void)
         ERROR_OUT(-3106, exit);
     } /* END LARGE HASH TEST */
 
+    /* BEGIN FOUR MESSAGE HASH TEST */ {
+    const byte* data[4];
+    word32      len[4];
+    byte        hashes[4][sizeof(hash)];
+    byte*       out[4];
+
+    for (i = 0; i < 3; i++) {
+        data[i] = (const byte*)test_sha[i].input;
+        len[i] = (word32)test_sha[i].inLen;
+        out[i] = hashes[i];
+    }
+    data[3] = large_input;
+    len[3] = (word32)sizeof(large_input);
+    out[3] = hashes[3];
+    ret = wc_Shake256Hash_x4(data, len, out, (word32)sizeof(hash));
+    if (ret != 0)
+        ERROR_OUT(-3107, exit);
+    for (i = 0; i < 3; i++) {
+        if (XMEMCMP(hashes[i], test_sha[i].output, sizeof(hash)) != 0)
+            ERROR_OUT(-3108, exit);
+    }
+    ret = wc_Shake256_Update(&sha, large_input, (word32)sizeof(large_input));
+    if (ret == 0)
+        ret = wc_Shake256_Final(&sha, hash, (word32)sizeof(hash));
+    if (ret != 0)
+        ERROR_OUT(-3109, exit);
+    if (XMEMCMP(hashes[3], hash, sizeof(hash)) != 0)
+        ERROR_OUT(-3110, exit);
+    } /* END FOUR MESSAGE HASH TEST */
+
 exit:
     wc_Shake256_Free(&sha);
 
@@ -7962,6 +8266,56 @@ int aes_test(void)
         if (XMEMCMP(ctr256Cipher, cipher, sizeof(ctr256Cipher)))
             return -5742;
 #endif /* WOLFSSL_AES_256 */
+
+#ifdef WOLFSSL_AES_128
+        {
+            /* many blocks in one call must match small calls, counter
+             * carries across bytes part way through */
+            const byte wrapIv[] =
+            {
+                0xf0,0xf1,0xf2,0xf3,0xf4,0xf5,0xf6,0xf7,
+                0xf8,0xf9,0xfa,0xfb,0xfc,0xfd,0xff,0xf5
+            };
+            byte bulkPlain[AES_BLOCK_SIZE * 37 + 5];
+            byte bulkCipher[AES_BLOCK_SIZE * 37 + 5];
+            byte pieceCipher[AES_BLOCK_SIZE * 37 + 5];
+            word32 i, pieceSz;
+
+            for (i = 0; i < (word32)sizeof(bulkPlain); i++)
+                bulkPlain[i] = (byte)i;
+
+            wc_AesSetKeyDirect(&enc, ctr128Key, sizeof(ctr128Key),
+                               wrapIv, AES_ENCRYPTION);
+            ret = wc_AesCtrEncrypt(&enc, bulkCipher, bulkPlain,
+                                   sizeof(bulkPlain));
+            if (ret != 0)
+                return -5747;
+
+            wc_AesSetKeyDirect(&dec, ctr128Key, sizeof(ctr128Key),
+                               wrapIv, AES_ENCRYPTION);
+            for (i = 0; i < (word32)sizeof(bulkPlain); i += pieceSz) {
+                pieceSz = (i % 3 == 0) ? 7 : AES_BLOCK_SIZE + 3;
+                if (pieceSz > (word32)sizeof(bulkPlain) - i)
+                    pieceSz = (word32)sizeof(bulkPlain) - i;
+                ret = wc_AesCtrEncrypt(&dec, pieceCipher + i, bulkPlain + i,
+                                       pieceSz);
+                if (ret != 0)
+                    return -5748;
+            }
+            if (XMEMCMP(bulkCipher, pieceCipher, sizeof(bulkCipher)))
+                return -5749;
+
+            /* in place decrypt */
+            wc_AesSetKeyDirect(&dec, ctr128Key, sizeof(ctr128Key),
+                               wrapIv, AES_ENCRYPTION);
+            ret = wc_AesCtrEncrypt(&dec, bulkCipher, bulkCipher,
+                                   sizeof(bulkCipher));
+            if (ret != 0)
+                return -5750;
+            if (XMEMCMP(bulkCipher, bulkPlain, sizeof(bulkPlain)))
+                return -5751;
+        }
+#endif /* WOLFSSL_AES_128 */
     }
 #endif /* WOLFSSL_AES_COUNTER */
 
@@ -13070,6 +13424,34 @@ int rsa_test(void)
     }
     TEST_SLEEP();
 
+#ifdef WC_RSA_BLINDING
+    /* blinding pair cached on key is updated per use and regenerated
+     * periodically, signatures must not change */
+    idx = (word32)ret; /* save off signature length */
+    {
+        int i;
+        for (i = 0; i < 40; i++) {
+            do {
+    #if defined(WOLFSSL_ASYNC_CRYPT)
+                ret = wc_AsyncWait(ret, &key.asyncDev,
+                                                      WC_ASYNC_FLAG_CALL_AGAIN);
+    #endif
+                if (ret >= 0) {
+                    ret = wc_RsaSSL_Sign(in, inLen, plain, plainSz, &key,
+                                                                         &rng);
+                }
+            } while (ret == WC_PENDING_E);
+            if (ret != (int)idx) {
+                ERROR_OUT(-7777, exit_rsa);
+            }
+            if (XMEMCMP(plain, out, idx)) {
+                ERROR_OUT(-7778, exit_rsa);
+            }
+        }
+    }
+    TEST_SLEEP();
+#endif
+
 #elif defined(WOLFSSL_PUBLIC_MP)
     (void)outSz;
     (void)inLen;
@@ -17390,6 +17772,14 @@ int pbkdf2_test(void)
         0x43, 0x6d, 0xb5, 0xe8, 0xd0, 0xfb, 0x3f, 0x35, 0x42, 0x48, 0x39, 0xbc,
         0x2d, 0xd4, 0xf9, 0x37, 0xd4, 0x95, 0x16, 0xa7, 0x2a, 0x9a, 0x21, 0xd1
     };
+    const byte verify2[] = {
+        0x4d, 0xdc, 0xd8, 0xf6, 0x0b, 0x98, 0xbe, 0x21, 0x83, 0x0c, 0xee, 0x5e,
+        0xf2, 0x27, 0x01, 0xf9, 0x64, 0x1a, 0x44, 0x18, 0xd0, 0x4c, 0x04, 0x14,
+        0xae, 0xff, 0x08, 0x87, 0x6b, 0x34, 0xab, 0x56, 0xa1, 0xd4, 0x25, 0xa1,
+        0x22, 0x58, 0x33, 0x54, 0x9a, 0xdb, 0x84, 0x1b, 0x51, 0xc9, 0xb3, 0x17,
+        0x6a, 0x27, 0x2b, 0xde, 0xbb, 0xa1, 0xd0, 0x78, 0x47, 0x8f, 0x62, 0xb3,
+        0x97, 0xf3, 0x3c, 0x8d
+    };
 
     int ret = wc_PBKDF2_ex(derived, (byte*)passwd, (int)XSTRLEN(passwd), salt,
               (int)sizeof(salt), iterations, kLen, WC_SHA256, HEAP_HINT, devId);
@@ -17399,6 +17789,15 @@ int pbkdf2_test(void)
     if (XMEMCMP(derived, verify, sizeof(verify)) != 0)
         return -9200;
 
+    /* RFC 7914 - key of two hash outputs */
+    ret = wc_PBKDF2_ex(derived, (byte*)"Password", 8, (byte*)"NaCl", 4, 80000,
+              (int)sizeof(verify2), WC_SHA256, HEAP_HINT, devId);
+    if (ret != 0)
+        return ret;
+
+    if (XMEMCMP(derived, verify2, sizeof(verify2)) != 0)
+        return -9201;
+
     return 0;
 
 }
@@ -43,6 +43,9 @@
 #ifdef HAVE_CHACHA
     #include <wolfssl/wolfcrypt/chacha.h>
 #endif
+#if defined(HAVE_CHACHA) && defined(HAVE_POLY1305)
+    #include <wolfssl/wolfcrypt/chacha20_poly1305.h>
+#endif
 #ifndef NO_ASN
     #include <wolfssl/wolfcrypt/asn.h>
     #include <wolfssl/wolfcrypt/pkcs12.h>
@@ -1129,6 +1132,16 @@ enum {
     #define WOLFSSL_DTLS_PEERSEQ_SZ WOLFSSL_MULTICAST_PEERS
 #endif /* WOLFSSL_MULTICAST */
 
+#ifdef WOLFSSL_DTLS_CID
+    #ifndef DTLS_CID_MAX_SIZE
+        /* largest connection ID we will use or accept from the peer */
+        #define DTLS_CID_MAX_SIZE 10
+    #endif
+    #if DTLS_CID_MAX_SIZE > 255
+        #error DTLS_CID_MAX_SIZE must fit in the one byte length field
+    #endif
+#endif /* WOLFSSL_DTLS_CID */
+
 #ifndef WOLFSSL_MAX_MTU
     #define WOLFSSL_MAX_MTU 1500
 #endif /* WOLFSSL_MAX_MTU */
@@ -1179,6 +1192,11 @@ enum {
     #define MAX_EARLY_DATA_SZ  4096
 #endif
 
+#ifndef WOLFSSL_MAX_COALESCE_RECORDS
+    /* maximum application data records built before sending them at once */
+    #define WOLFSSL_MAX_COALESCE_RECORDS 16
+#endif
+
 #ifndef WOLFSSL_MAX_RSA_BITS
     #if (defined(USE_FAST_MATH) && defined(FP_MAX_BITS) && FP_MAX_BITS >= 16384)
         #define WOLFSSL_MAX_RSA_BITS (FP_MAX_BITS / 2)
@@ -1254,7 +1272,12 @@ enum Misc {
     MAX_TLS13_PLAIN_SZ = (1 << 14) + 1,    /* Max unencrypted data sz */
     MAX_TLS13_ENC_SZ   = (1 << 14) + 256,  /* Max encrypted data sz   */
 #endif
+#ifndef WOLFSSL_DTLS_CID
     MAX_MSG_EXTRA   = 38 + WC_MAX_DIGEST_SIZE,
+#else
+    MAX_MSG_EXTRA   = 38 + WC_MAX_DIGEST_SIZE + DTLS_CID_MAX_SIZE + 1,
+                                /* plus connection ID and inner type */
+#endif
                                 /* max added to msg, mac + pad  from */
                                 /* RECORD_HEADER_SZ + BLOCK_SZ (pad) + Max
                                    digest sz + BLOC_SZ (iv) + pad byte (1) */
@@ -1389,6 +1412,13 @@ enum Misc {
     AEAD_VMIN_OFFSET    = 10,  /* Auth Data: Minor Version   */
     AEAD_LEN_OFFSET     = 11,  /* Auth Data: Length          */
     AEAD_AUTH_DATA_SZ   = 13,  /* Size of the data to authenticate */
+#ifdef WOLFSSL_DTLS_CID
+    /* seq placeholder (8), tls12_cid (1), cid length (1), tls12_cid (1),
+     * version (2), epoch and sequence (8), cid, length (2) */
+    AEAD_AUTH_DATA_MAX_SZ = 23 + DTLS_CID_MAX_SIZE,
+#else
+    AEAD_AUTH_DATA_MAX_SZ = AEAD_AUTH_DATA_SZ,
+#endif
     AEAD_NONCE_SZ       = 12,
     AESGCM_IMP_IV_SZ    = 4,   /* Size of GCM/CCM AEAD implicit IV */
     AESGCM_EXP_IV_SZ    = 8,   /* Size of GCM/CCM AEAD explicit IV */
@@ -1469,6 +1499,11 @@ enum Misc {
     MAX_WOLFSSL_FILE_SIZE = 1024ul * 1024ul * 4,  /* 4 mb file size alloc limit */
 #endif
 
+#ifndef MIN_BIO_MEM_SZ
+    MIN_BIO_MEM_SZ     =  256, /* initial memory BIO buffer allocation */
+#endif
+    MAX_BIO_MEM_SZ     = 0x7FFFFFFF, /* memory BIO buffer must fit in an int */
+
     MAX_X509_SIZE      = 2048, /* max static x509 buffer size */
     CERT_MIN_SIZE      =  256, /* min PEM cert size with header/footer */
 
@@ -1585,6 +1620,22 @@ enum Misc {
     #define SESSION_TICKET_HINT_DEFAULT 300
 #endif
 
+/* seconds the built-in ticket callback encrypts with one key before rotating,
+ * tickets from the previous key are accepted for the ticket hint after */
+#ifndef WOLFSSL_TICKET_KEY_LIFETIME
+    #define WOLFSSL_TICKET_KEY_LIFETIME (60 * 60)
+#endif
+
+/* built-in ticket callback needs HMAC-SHA256 to derive keys and an AEAD */
+#if defined(HAVE_SESSION_TICKET) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB)
+    #if defined(NO_HMAC) || defined(NO_SHA256) || \
+        (!(defined(HAVE_AESGCM) && defined(WOLFSSL_AES_256)) && \
+         !(defined(HAVE_CHACHA) && defined(HAVE_POLY1305)))
+        #define WOLFSSL_NO_DEF_TICKET_ENC_CB
+    #endif
+#endif
+
 
 /* don't use extra 3/4k stack space unless need to */
 #ifdef HAVE_NTRU
@@ -1717,6 +1768,8 @@ WOLFSSL_LOCAL int SNI_Callback(WOLFSSL* ssl);
 #ifdef WOLFSSL_TLS13
 WOLFSSL_LOCAL int  DecryptTls13(WOLFSSL* ssl, byte* output, const byte* input,
                                 word16 sz, const byte* aad, word16 aadSz);
+WOLFSSL_LOCAL int  DeriveTls13Keys(WOLFSSL* ssl, int secret, int side,
+                                   int store);
 WOLFSSL_LOCAL int  DoTls13HandShakeMsgType(WOLFSSL* ssl, byte* input,
                                            word32* inOutIdx, byte type,
                                            word32 size, word32 totalSz);
@@ -1878,10 +1931,31 @@ struct WOLFSSL_CIPHER {
 
 /* wolfSSL OCSP controller */
 #ifdef HAVE_OCSP
+
+#ifndef OCSP_TABLE_SIZE
+    #define OCSP_TABLE_SIZE 11
+#endif
+
+#ifndef OCSP_CACHE_MAX_STATUS
+    #define OCSP_CACHE_MAX_STATUS 256  /* default max cached responses */
+#endif
+
+#ifndef OCSP_STATUS_TABLE_SIZE
+    #define OCSP_STATUS_TABLE_SIZE 67  /* initial rows, grows with load */
+#endif
+#ifndef OCSP_STATUS_TABLE_LOAD
+    #define OCSP_STATUS_TABLE_LOAD 2   /* average responses per row */
+#endif
+
 struct WOLFSSL_OCSP {
     WOLFSSL_CERT_MANAGER* cm;            /* pointer back to cert manager */
-    OcspEntry*            ocspList;      /* OCSP response list */
-    wolfSSL_Mutex         ocspLock;      /* OCSP list lock */
+    OcspEntry*            ocspTable[OCSP_TABLE_SIZE]; /* entries by issuer */
+    CertStatus**          statusTable;   /* responses by issuer and serial */
+    word32                statusTableSz; /* rows in statusTable */
+    CertStatus*           lruHead;       /* least recently used response */
+    CertStatus*           lruTail;       /* most recently used response */
+    wolfSSL_Mutex         ocspLock;      /* OCSP table lock */
+    int                   totalStatus;   /* cached responses in table */
     int                   error;
 #if defined(OPENSSL_ALL) || defined(OPENSSL_EXTRA) || \
     defined(WOLFSSL_NGINX) || defined(WOLFSSL_HAPROXY)
@@ -1908,7 +1982,7 @@ typedef struct CRL_Entry CRL_Entry;
 
 /* Complete CRL */
 struct CRL_Entry {
-    CRL_Entry* next;                      /* next entry */
+    CRL_Entry* next;                      /* next entry on table row */
     byte    issuerHash[CRL_DIGEST_SIZE];  /* issuer hash                 */
     /* byte    crlHash[CRL_DIGEST_SIZE];      raw crl data hash           */
     /* restore the hash here if needed for optimized comparisons */
@@ -1916,8 +1990,8 @@ struct CRL_Entry {
     byte    nextDate[MAX_DATE_SIZE]; /* next update date   */
     byte    lastDateFormat;          /* last date format */
     byte    nextDateFormat;          /* next date format */
-    RevokedCert* certs;              /* revoked cert list  */
-    int          totalCerts;         /* number on list     */
+    RevokedCert* certs;              /* revoked certs, sorted by serial */
+    int          totalCerts;         /* number in array    */
     int     verified;
     byte*   toBeSigned;
     word32  tbsSz;
@@ -1944,16 +2018,21 @@ struct CRL_Monitor {
     #undef HAVE_CRL_MONITOR
 #endif
 
+#ifndef CRL_TABLE_SIZE
+    #define CRL_TABLE_SIZE 11
+#endif
+
 /* wolfSSL CRL controller */
 struct WOLFSSL_CRL {
     WOLFSSL_CERT_MANAGER* cm;            /* pointer back to cert manager */
-    CRL_Entry*            crlList;       /* our CRL list */
+    CRL_Entry*            crlTable[CRL_TABLE_SIZE]; /* CRLs by issuer hash */
 #ifdef HAVE_CRL_IO
     CbCrlIO               crlIOCb;
 #endif
-    wolfSSL_Mutex         crlLock;       /* CRL list lock */
+    wolfSSL_RwLock        crlLock;       /* CRL table lock, shared lookups */
     CRL_Monitor           monitors[2];   /* PEM and DER possible */
 #ifdef HAVE_CRL_MONITOR
+    wolfSSL_Mutex         setupLock;     /* guards setup, used with cond */
     pthread_cond_t        cond;          /* condition to signal setup */
     pthread_t             tid;           /* monitoring thread */
     int                   mfd;           /* monitor fd, -1 if no init yet */
@@ -1972,15 +2051,36 @@ struct WOLFSSL_CRL {
 
 
 #ifndef CA_TABLE_SIZE
-    #define CA_TABLE_SIZE 11
+    #define CA_TABLE_SIZE 11     /* initial rows, grows with CA_TABLE_LOAD */
+#endif
+#ifndef CA_TABLE_LOAD
+    #define CA_TABLE_LOAD 2      /* average signers per row before growing */
 #endif
 #ifdef WOLFSSL_TRUST_PEER_CERT
     #define TP_TABLE_SIZE 11
 #endif
 
 /* wolfSSL Certificate Manager */
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+#ifndef CERT_VERIFY_CACHE_SIZE
+    #define CERT_VERIFY_CACHE_SIZE 1024 /* default verified certs remembered */
+#endif
+
+/* certificate whose signature was verified, one per cache row */
+typedef struct CertVerifyEntry {
+    byte certHash[WC_SHA256_DIGEST_SIZE];   /* SHA-256 of cert DER */
+    byte signerHash[WC_SHA256_DIGEST_SIZE]; /* SHA-256 of signer key */
+    byte used;                              /* 0 when row unused */
+} CertVerifyEntry;
+#endif
+
 struct WOLFSSL_CERT_MANAGER {
-    Signer*         caTable[CA_TABLE_SIZE]; /* the CA signer table */
+    Signer**        caTable;             /* CA signers by key id hash */
+#ifndef NO_SKID
+    Signer**        caNameTable;         /* CA signers by subject name hash */
+#endif
+    word32          caTableSz;           /* rows in each CA table */
+    word32          caCount;             /* number of CA signers */
     void*           heap;                /* heap helper */
 #ifdef WOLFSSL_TRUST_PEER_CERT
     TrustedPeerCert* tpTable[TP_TABLE_SIZE]; /* table of trusted peer certs */
@@ -2001,7 +2101,12 @@ struct WOLFSSL_CERT_MANAGER {
     CbMissingCRL    cbMissingCRL;        /* notify through cb of missing crl */
     CbOCSPIO        ocspIOCb;            /* I/O callback for OCSP lookup */
     CbOCSPRespFree  ocspRespFreeCb;      /* Frees OCSP Response from IO Cb */
-    wolfSSL_Mutex   caLock;              /* CA list lock */
+    wolfSSL_RwLock  caLock;              /* CA table lock */
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+    CertVerifyEntry* verifyCache;        /* verified certs, NULL until used */
+    word32          verifyCacheSz;       /* rows in verify cache, 0 is off */
+    wolfSSL_RwLock  verifyLock;          /* verify cache lock */
+#endif
     byte            crlEnabled;          /* is CRL on ? */
     byte            crlCheckAll;         /* always leaf, but all ? */
     byte            ocspEnabled;         /* is OCSP on ? */
@@ -2009,6 +2114,9 @@ struct WOLFSSL_CERT_MANAGER {
     byte            ocspSendNonce;       /* send the OCSP nonce ? */
     byte            ocspUseOverrideURL;  /* ignore cert's responder, override */
     byte            ocspStaplingEnabled; /* is OCSP Stapling on ? */
+#ifdef HAVE_OCSP
+    int             ocspCacheSz;         /* max cached OCSP responses */
+#endif
 
 #ifndef NO_RSA
     short           minRsaKeySz;         /* minimum allowed RSA key size */
@@ -2068,6 +2176,11 @@ struct WOLFSSL_SOCKADDR {
 
 typedef struct WOLFSSL_DTLS_CTX {
     WOLFSSL_SOCKADDR peer;
+#ifdef WOLFSSL_DTLS_CID
+    WOLFSSL_SOCKADDR pendingPeer; /* new address seen for a CID connection,
+                                   * adopted once a newer record from it
+                                   * authenticates */
+#endif
     int rfd;
     int wfd;
 } WOLFSSL_DTLS_CTX;
@@ -2092,6 +2205,19 @@ typedef struct WOLFSSL_DTLS_PEERSEQ {
 } WOLFSSL_DTLS_PEERSEQ;
 
 
+#ifdef WOLFSSL_DTLS_CID
+/* DTLS 1.2 Connection ID state (RFC 9146). rx is the CID we asked the peer to
+ * put on the records it sends us, tx the CID the peer asked us to send. */
+typedef struct DtlsCidInfo {
+    byte rx[DTLS_CID_MAX_SIZE];
+    byte tx[DTLS_CID_MAX_SIZE];
+    byte rxSz;
+    byte txSz;
+    byte negotiated;    /* both sides agreed on using connection IDs */
+} DtlsCidInfo;
+#endif /* WOLFSSL_DTLS_CID */
+
+
 #define MAX_WRITE_IV_SZ 16 /* max size of client/server write_IV */
 
 /* keys and secrets
@@ -2173,6 +2299,9 @@ typedef enum {
 #endif
     TLSX_QUANTUM_SAFE_HYBRID        = 0x0018, /* a.k.a. QSH  */
     TLSX_SESSION_TICKET             = 0x0023,
+#ifdef WOLFSSL_DTLS_CID
+    TLSX_CONNECTION_ID              = 0x0036, /* RFC 9146 */
+#endif
 #ifdef WOLFSSL_TLS13
     #if defined(HAVE_SESSION_TICKET) || !defined(NO_PSK)
     TLSX_PRE_SHARED_KEY             = 0x0029,
@@ -2243,7 +2372,8 @@ WOLFSSL_LOCAL int   TLSX_Parse(WOLFSSL* ssl, byte* input, word16 length,
    || defined(HAVE_QSH)                           \
    || defined(HAVE_SESSION_TICKET)                \
    || defined(HAVE_SECURE_RENEGOTIATION)          \
-   || defined(HAVE_SERVER_RENEGOTIATION_INFO)
+   || defined(HAVE_SERVER_RENEGOTIATION_INFO)     \
+   || defined(WOLFSSL_DTLS_CID)
 
 #error Using TLS extensions requires HAVE_TLS_EXTENSIONS to be defined.
 
@@ -2439,6 +2569,11 @@ WOLFSSL_LOCAL int TLSX_AddEmptyRenegotiationInfo(TLSX** extensions, void* heap);
 
 #endif /* HAVE_SECURE_RENEGOTIATION */
 
+/** DTLS 1.2 Connection ID - RFC 9146 */
+#ifdef WOLFSSL_DTLS_CID
+WOLFSSL_LOCAL int TLSX_UseConnectionID(WOLFSSL* ssl);
+#endif
+
 /** Session Ticket - RFC 5077 (session 3.2) */
 #ifdef HAVE_SESSION_TICKET
 
@@ -2615,6 +2750,92 @@ enum SetCBIO {
 };
 #endif
 
+#if defined(HAVE_SESSION_TICKET) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB)
+#define WOLFSSL_TICKET_KEY_SZ        32   /* AEAD key size */
+#define WOLFSSL_TICKET_SECRET_MIN_SZ 16
+#define WOLFSSL_TICKET_SECRET_MAX_SZ 64
+#define WOLFSSL_TICKET_KEYS_CACHED    2   /* current and previous period */
+
+/* ticket key derived from the secret for one rotation period */
+typedef struct TicketEncCbKey {
+    word32 period;                        /* LowResTimer() / lifetime */
+    byte   name[WOLFSSL_TICKET_NAME_SZ];  /* key name placed in tickets */
+    byte   key[WOLFSSL_TICKET_KEY_SZ];    /* AEAD key */
+    byte   valid;
+} TicketEncCbKey;
+
+/* built-in session ticket callback state, keys are derived from the secret
+ * so servers sharing it rotate in lockstep and accept each other's tickets */
+typedef struct TicketEncCbCtx {
+    TicketEncCbKey keys[WOLFSSL_TICKET_KEYS_CACHED];
+    byte           secret[WOLFSSL_TICKET_SECRET_MAX_SZ];
+    word32         secretSz;              /* 0 until set or generated */
+    word32         lifetime;              /* seconds per key period */
+    wolfSSL_Mutex  mutex;
+} TicketEncCbCtx;
+#endif
+
+#if defined(WOLFSSL_KEY_SHARE_POOL) && !defined(HAVE_TLS_EXTENSIONS)
+    #undef WOLFSSL_KEY_SHARE_POOL
+#endif
+
+#ifdef WOLFSSL_KEY_SHARE_POOL
+#if !defined(SINGLE_THREADED) && defined(HAVE_PTHREAD)
+    #define WOLFSSL_KEY_SHARE_POOL_THREAD
+#endif
+#ifndef KEY_SHARE_POOL_GROUPS
+    #define KEY_SHARE_POOL_GROUPS    4   /* named groups pooled per context */
+#endif
+#ifndef KEY_SHARE_POOL_MAX_DEPTH
+    #define KEY_SHARE_POOL_MAX_DEPTH 256 /* key pairs kept per named group */
+#endif
+#ifndef KEY_SHARE_POOL_RETRY_MS
+    #define KEY_SHARE_POOL_RETRY_MS      10   /* first wait after a failure */
+#endif
+#ifndef KEY_SHARE_POOL_RETRY_MAX_MS
+    #define KEY_SHARE_POOL_RETRY_MAX_MS  1000 /* longest wait between tries */
+#endif
+
+typedef struct KeySharePoolEntry KeySharePoolEntry;
+
+/* pre-generated ephemeral key pair, taken by exactly one handshake */
+struct KeySharePoolEntry {
+    KeySharePoolEntry* next;
+    byte*              priv;      /* private key, raw encoding */
+    byte*              pub;       /* public key as sent on the wire */
+    word32             privSz;
+    word32             pubSz;
+};
+
+typedef struct KeySharePoolGroup {
+    KeySharePoolEntry* head;      /* ready key pairs */
+    word16             group;     /* named group, 0 when slot unused */
+    int                depth;     /* key pairs to keep ready */
+    int                count;     /* key pairs in list */
+} KeySharePoolGroup;
+
+/* key pairs generated ahead of the handshakes of a context */
+typedef struct KeySharePool {
+    KeySharePoolGroup  groups[KEY_SHARE_POOL_GROUPS];
+    wolfSSL_Mutex      lock;      /* guards groups */
+#ifdef WOLFSSL_KEY_SHARE_POOL_THREAD
+    pthread_cond_t     cond;      /* signals a take or stop to refill thread */
+    pthread_t          tid;       /* refill thread */
+    WC_RNG             rng;       /* used by refill thread only */
+    int                running;   /* refill thread started, guarded by lock */
+    int                stop;      /* refill thread asked to exit, by lock */
+#endif
+    void*              heap;
+} KeySharePool;
+
+WOLFSSL_LOCAL KeySharePoolEntry* KeySharePool_Take(WOLFSSL_CTX* ctx,
+                                                   word16 group);
+WOLFSSL_LOCAL void KeySharePool_FreeEntry(KeySharePoolEntry* entry,
+                                          void* heap);
+WOLFSSL_LOCAL void KeySharePool_Free(WOLFSSL_CTX* ctx);
+#endif /* WOLFSSL_KEY_SHARE_POOL */
+
 /* wolfSSL context type */
 struct WOLFSSL_CTX {
     WOLFSSL_METHOD* method;
@@ -2656,7 +2877,11 @@ struct WOLFSSL_CTX {
 #endif
     Suites*     suites;           /* make dynamic, user may not need/set */
     void*       heap;             /* for user memory overrides */
+#ifndef NO_SESSION_CACHE
+    WOLFSSL_SESSION_CACHE* sessionCache; /* NULL uses the internal cache */
+#endif
     byte        verifyDepth;
+    byte        coalesceRecords;  /* app data records to send at once */
     byte        verifyPeer:1;
     byte        verifyNone:1;
     byte        failNoCert:1;
@@ -2737,6 +2962,7 @@ struct WOLFSSL_CTX {
 #endif
     CallbackIORecv CBIORecv;
     CallbackIOSend CBIOSend;
+    CallbackIOSendv CBIOSendv;    /* flushes coalesced records */
 #ifdef WOLFSSL_DTLS
     CallbackGenCookie CBIOCookie;       /* gen cookie callback */
 #ifdef WOLFSSL_SESSION_EXPORT
@@ -2828,11 +3054,17 @@ struct WOLFSSL_CTX {
         SessionTicketEncCb ticketEncCb;   /* enc/dec session ticket Cb */
         void*              ticketEncCtx;  /* session encrypt context */
         int                ticketHint;    /* ticket hint in seconds */
+        #ifndef WOLFSSL_NO_DEF_TICKET_ENC_CB
+        TicketEncCbCtx     ticketKeyCtx;  /* built-in ticket Cb keys */
+        #endif
     #endif
     #ifdef HAVE_SUPPORTED_CURVES
         byte userCurves;                  /* indicates user called wolfSSL_CTX_UseSupportedCurve */
     #endif
 #endif
+#ifdef WOLFSSL_KEY_SHARE_POOL
+    KeySharePool*   keySharePool;       /* pre-generated key exchange keys */
+#endif
 #ifdef ATOMIC_USER
     CallbackMacEncrypt    MacEncryptCb;    /* Atomic User Mac/Encrypt Cb */
     CallbackDecryptVerify DecryptVerifyCb; /* Atomic User Decrypt/Verify Cb */
@@ -3190,6 +3422,9 @@ struct WOLFSSL_SESSION {
 #ifdef HAVE_EX_DATA
     WOLFSSL_CRYPTO_EX_DATA ex_data;
 #endif
+#ifndef NO_SESSION_CACHE
+    WOLFSSL_SESSION_CACHE* cache;                 /* holding cache when in one */
+#endif
 };
 
 
@@ -3489,6 +3724,7 @@ typedef struct Options {
     byte            asyncState;         /* sub-state for enum asyncState */
     byte            buildMsgState;      /* sub-state for enum buildMsgState */
     byte            alertCount;         /* detect warning dos attempt */
+    byte            coalesceRecords;    /* app data records to send at once */
 #ifdef WOLFSSL_MULTICAST
     word16          mcastID;            /* Multicast group ID */
 #endif
@@ -3795,6 +4031,20 @@ typedef struct MsgsReceived {
 } MsgsReceived;
 
 
+/* Handshake hash contexts, bit mask of which are running */
+enum HsHashType {
+    HS_HASH_MD5    = 0x01,
+    HS_HASH_SHA    = 0x02,
+    HS_HASH_SHA256 = 0x04,
+    HS_HASH_SHA384 = 0x08,
+    HS_HASH_SHA512 = 0x10,
+    HS_HASH_ALL    = 0x1f
+};
+
+#ifndef HS_HASH_BUFFER_SZ
+    #define HS_HASH_BUFFER_SZ 512   /* initial size of message buffer */
+#endif
+
 /* Handshake hashes */
 typedef struct HS_Hashes {
     Hashes          verifyHashes;
@@ -3820,6 +4070,11 @@ typedef struct HS_Hashes {
     int             length;             /* length of handshake messages' data */
     int             prevLen;            /* length of messages but last */
 #endif
+    byte*           rawMsgs;            /* messages until hashes are known */
+    word32          rawLen;             /* length of buffered messages */
+    word32          rawSz;              /* size of message buffer */
+    byte            hashMask;           /* HS_HASH_* contexts running */
+    byte            buffering;          /* still buffering raw messages */
 } HS_Hashes;
 
 
@@ -3895,6 +4150,7 @@ struct WOLFSSL {
 #endif
     CallbackIORecv  CBIORecv;
     CallbackIOSend  CBIOSend;
+    CallbackIOSendv CBIOSendv;
 #ifdef WOLFSSL_STATIC_MEMORY
     WOLFSSL_HEAP_HINT heap_hint;
 #endif
@@ -4058,6 +4314,9 @@ struct WOLFSSL {
     word32 macDropCount;
     word32 replayDropCount;
 #endif /* WOLFSSL_DTLS_DROP_STATS */
+#ifdef WOLFSSL_DTLS_CID
+    DtlsCidInfo     dtlsCidInfo;        /* connection IDs for the records */
+#endif /* WOLFSSL_DTLS_CID */
 #endif /* WOLFSSL_DTLS */
 #ifdef WOLFSSL_CALLBACKS
     TimeoutInfo     timeoutInfo;        /* info saved during handshake */
@@ -4269,7 +4528,8 @@ enum ContentType {
     change_cipher_spec = 20,
     alert              = 21,
     handshake          = 22,
-    application_data   = 23
+    application_data   = 23,
+    dtls12_cid         = 25  /* RFC 9146 record carrying a connection ID */
 };
 
 
@@ -4344,6 +4604,15 @@ extern const WOLF_EC_NIST_NAME kNistCurves[];
 WOLFSSL_LOCAL int SendChangeCipher(WOLFSSL*);
 WOLFSSL_LOCAL int SendTicket(WOLFSSL*);
 WOLFSSL_LOCAL int DoClientTicket(WOLFSSL*, const byte*, word32);
+#if defined(HAVE_SESSION_TICKET) && !defined(NO_WOLFSSL_SERVER) && \
+    !defined(WOLFSSL_NO_DEF_TICKET_ENC_CB)
+WOLFSSL_LOCAL int DefTicketEncCb(WOLFSSL* ssl,
+                                 byte key_name[WOLFSSL_TICKET_NAME_SZ],
+                                 byte iv[WOLFSSL_TICKET_IV_SZ],
+                                 byte mac[WOLFSSL_TICKET_MAC_SZ],
+                                 int enc, byte* ticket, int inLen, int* outLen,
+                                 void* userCtx);
+#endif
 WOLFSSL_LOCAL int SendData(WOLFSSL*, const void*, int);
 #ifdef WOLFSSL_TLS13
 #ifdef WOLFSSL_TLS13_DRAFT_18
@@ -4366,6 +4635,8 @@ WOLFSSL_LOCAL int SendCertificateStatus(WOLFSSL*);
 WOLFSSL_LOCAL int SendServerKeyExchange(WOLFSSL*);
 WOLFSSL_LOCAL int SendBuffered(WOLFSSL*);
 WOLFSSL_LOCAL int ReceiveData(WOLFSSL*, byte*, int, int);
+WOLFSSL_LOCAL int ReceiveDataZeroCopy(WOLFSSL*, const byte**);
+WOLFSSL_LOCAL int ReleaseDataZeroCopy(WOLFSSL*, int);
 WOLFSSL_LOCAL int SendFinished(WOLFSSL*);
 WOLFSSL_LOCAL int SendAlert(WOLFSSL*, int, int);
 WOLFSSL_LOCAL int ProcessReply(WOLFSSL*);
@@ -4464,6 +4735,12 @@ WOLFSSL_LOCAL WC_RNG* WOLFSSL_RSA_GetRNG(WOLFSSL_RSA *rsa, WC_RNG **tmpRNG,
     #ifndef NO_SKID
         WOLFSSL_LOCAL Signer* GetCAByName(void* cm, byte* hash);
     #endif
+    #ifdef WOLFSSL_CERT_VERIFY_CACHE
+        WOLFSSL_LOCAL int  CertVerifyCache_Find(void* cm, const byte* certHash,
+                                                const Signer* signer);
+        WOLFSSL_LOCAL void CertVerifyCache_Add(void* cm, const byte* certHash,
+                                               const Signer* signer);
+    #endif
 #endif /* !NO_CERTS */
 WOLFSSL_LOCAL int  BuildTlsHandshakeHash(WOLFSSL* ssl, byte* hash,
                                    word32* hashLen);
@@ -4511,6 +4788,9 @@ WOLFSSL_LOCAL  int GrowInputBuffer(WOLFSSL* ssl, int size, int usedLength);
     WOLFSSL_LOCAL int  VerifyForDtlsMsgPoolSend(WOLFSSL*, byte, word32);
     WOLFSSL_LOCAL void DtlsMsgPoolReset(WOLFSSL*);
     WOLFSSL_LOCAL int  DtlsMsgPoolSend(WOLFSSL*, int);
+#ifdef WOLFSSL_DTLS_CID
+    WOLFSSL_LOCAL int  DtlsCidSupportedSuite(WOLFSSL*);
+#endif
 #endif /* WOLFSSL_DTLS */
 
 #ifndef NO_TLS
@@ -4610,6 +4890,9 @@ WOLFSSL_LOCAL int SetDhExternal(WOLFSSL_DH *dh);
 
 WOLFSSL_LOCAL int InitHandshakeHashes(WOLFSSL* ssl);
 WOLFSSL_LOCAL void FreeHandshakeHashes(WOLFSSL* ssl);
+WOLFSSL_LOCAL int SetHandshakeHashes(WOLFSSL* ssl, byte mask);
+WOLFSSL_LOCAL int FinalizeHandshakeHashes(WOLFSSL* ssl);
+WOLFSSL_LOCAL int HashRaw(WOLFSSL* ssl, const byte* data, int sz);
 
 WOLFSSL_LOCAL int BuildMessage(WOLFSSL* ssl, byte* output, int outSz,
                         const byte* input, int inSz, int type, int hashOutput,
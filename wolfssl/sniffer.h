@@ -72,6 +72,9 @@ SSL_SNIFFER_API int ssl_Trace(const char* traceFile, char* error);
 WOLFSSL_API
 SSL_SNIFFER_API int ssl_EnableRecovery(int onOff, int maxMemory, char* error);
 
+WOLFSSL_API
+SSL_SNIFFER_API int ssl_SetSessionTableSize(unsigned int rows, char* error);
+
 WOLFSSL_API
 SSL_SNIFFER_API int ssl_GetSessionStats(unsigned int* active,
                                         unsigned int* total,
@@ -213,6 +216,36 @@ SSL_SNIFFER_API int ssl_DecodePacketWithChainSessionInfoStoreData(
         void* vChain, unsigned int chainSz, void* ctx, SSLInfo* sslInfo,
         char* error);
 
+
+/* SSLSecretCb secretTypes, named after the NSS key log file labels */
+enum {
+    SNIFFER_SECRET_TLS12_MASTER_SECRET = 0,         /* CLIENT_RANDOM */
+    SNIFFER_SECRET_CLIENT_HANDSHAKE_TRAFFIC_SECRET, /* TLS v1.3 */
+    SNIFFER_SECRET_SERVER_HANDSHAKE_TRAFFIC_SECRET, /* TLS v1.3 */
+    SNIFFER_SECRET_CLIENT_TRAFFIC_SECRET,           /* TLS v1.3, _0 */
+    SNIFFER_SECRET_SERVER_TRAFFIC_SECRET,           /* TLS v1.3, _0 */
+    SNIFFER_SECRET_COUNT
+};
+
+/* secretSz holds the size of secret on input and the size of the secret
+ * found on output, return 0 when the secret was found */
+typedef int (*SSLSecretCb)(const unsigned char* clientRandom, int secretType,
+                           unsigned char* secret, unsigned int* secretSz,
+                           void* ctx);
+
+WOLFSSL_API
+SSL_SNIFFER_API int ssl_SetSecretCallback(SSLSecretCb cb, char* error);
+
+WOLFSSL_API
+SSL_SNIFFER_API int ssl_SetSecretCtx(void* ctx, char* error);
+
+WOLFSSL_API
+SSL_SNIFFER_API int ssl_SetSecretServer(const char* address, int port,
+                                        char* error);
+
+WOLFSSL_API
+SSL_SNIFFER_API int ssl_LoadKeyLogFile(const char* keyLogFile, char* error);
+
 #ifdef __cplusplus
     }  /* extern "C" */
 #endif
@@ -130,6 +130,13 @@
 #define NO_DATA_DEST_STR 91
 #define STORE_DATA_FAIL_STR 92
 #define CHAIN_INPUT_STR 93
+#define SESSION_TABLE_STR 94
+#define SECRET_MISSING_STR 95
+
+#define KEY_LOG_FILE_STR 96
+#define GOT_ENC_EXT_STR 97
+#define GOT_KEY_UPDATE_STR 98
+#define GOT_HELLO_RETRY_STR 99
 /* !!!! also add to msgTable in sniffer.c and .rc file !!!! */
 
 
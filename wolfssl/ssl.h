@@ -103,6 +103,7 @@
 typedef struct WOLFSSL          WOLFSSL;
 #endif
 typedef struct WOLFSSL_SESSION  WOLFSSL_SESSION;
+typedef struct WOLFSSL_SESSION_CACHE WOLFSSL_SESSION_CACHE;
 typedef struct WOLFSSL_METHOD   WOLFSSL_METHOD;
 #ifndef WOLFSSL_WOLFSSL_CTX_TYPE_DEFINED
 #define WOLFSSL_WOLFSSL_CTX_TYPE_DEFINED
@@ -861,6 +862,8 @@ WOLFSSL_ABI WOLFSSL_API int  wolfSSL_connect(WOLFSSL*);
 WOLFSSL_ABI WOLFSSL_API int  wolfSSL_write(WOLFSSL*, const void*, int);
 WOLFSSL_ABI WOLFSSL_API int  wolfSSL_read(WOLFSSL*, void*, int);
 WOLFSSL_API int  wolfSSL_peek(WOLFSSL*, void*, int);
+WOLFSSL_API int  wolfSSL_read_zc(WOLFSSL*, const unsigned char**);
+WOLFSSL_API int  wolfSSL_read_zc_release(WOLFSSL*, int);
 WOLFSSL_API int  wolfSSL_accept(WOLFSSL*);
 WOLFSSL_API int  wolfSSL_CTX_mutual_auth(WOLFSSL_CTX* ctx, int req);
 WOLFSSL_API int  wolfSSL_mutual_auth(WOLFSSL* ssl, int req);
@@ -996,6 +999,23 @@ WOLFSSL_API int  wolfSSL_restore_session_cache(const char*);
 WOLFSSL_API int  wolfSSL_memsave_session_cache(void*, int);
 WOLFSSL_API int  wolfSSL_memrestore_session_cache(const void*, int);
 WOLFSSL_API int  wolfSSL_get_session_cache_memsize(void);
+/* session cache sizing, before wolfSSL_Init() */
+WOLFSSL_API int  wolfSSL_set_session_cache_size(unsigned int sessions);
+
+/* session cache of a WOLFSSL_CTX, replacement policy of full rows */
+enum {
+    WOLFSSL_SESSION_CACHE_FIFO  = 0,
+    WOLFSSL_SESSION_CACHE_LRU   = 1,
+    WOLFSSL_SESSION_CACHE_CLOCK = 2
+};
+WOLFSSL_API WOLFSSL_SESSION_CACHE* wolfSSL_SessionCacheNew(unsigned int sessions,
+                               unsigned int timeout, int policy, void* heap);
+WOLFSSL_API void wolfSSL_SessionCacheFree(WOLFSSL_SESSION_CACHE*);
+WOLFSSL_API int  wolfSSL_CTX_SetSessionCache(WOLFSSL_CTX*,
+                                             WOLFSSL_SESSION_CACHE*);
+WOLFSSL_API int  wolfSSL_SessionCacheGetStats(WOLFSSL_SESSION_CACHE*,
+                  unsigned int* active, unsigned int* hits,
+                  unsigned int* misses, unsigned int* evictions);
 
 /* certificate cache persistence, uses ctx since certs are per ctx */
 WOLFSSL_API int  wolfSSL_CTX_save_cert_cache(WOLFSSL_CTX*, const char*);
@@ -1037,6 +1057,27 @@ WOLFSSL_API int  wolfSSL_dtls_set_mtu(WOLFSSL*, unsigned short);
 
 WOLFSSL_API int  wolfSSL_dtls_get_drop_stats(WOLFSSL*,
                                              unsigned int*, unsigned int*);
+
+#ifdef WOLFSSL_DTLS_CID
+WOLFSSL_API int  wolfSSL_dtls_cid_use(WOLFSSL* ssl);
+WOLFSSL_API int  wolfSSL_dtls_cid_is_enabled(WOLFSSL* ssl);
+WOLFSSL_API int  wolfSSL_dtls_cid_set(WOLFSSL* ssl, const unsigned char* cid,
+                                      unsigned int cidSz);
+WOLFSSL_API int  wolfSSL_dtls_cid_get_rx_size(WOLFSSL* ssl,
+                                              unsigned int* cidSz);
+WOLFSSL_API int  wolfSSL_dtls_cid_get_rx(WOLFSSL* ssl, unsigned char* buf,
+                                         unsigned int bufSz);
+WOLFSSL_API int  wolfSSL_dtls_cid_get_tx_size(WOLFSSL* ssl,
+                                              unsigned int* cidSz);
+WOLFSSL_API int  wolfSSL_dtls_cid_get_tx(WOLFSSL* ssl, unsigned char* buf,
+                                         unsigned int bufSz);
+WOLFSSL_API const unsigned char* wolfSSL_dtls_cid_parse(
+                   const unsigned char* msg, unsigned int msgSz,
+                   unsigned int cidSz);
+WOLFSSL_API int  wolfSSL_dtls_cid_set_pending_peer(WOLFSSL* ssl,
+                                                   const void* peer,
+                                                   unsigned int peerSz);
+#endif /* WOLFSSL_DTLS_CID */
 WOLFSSL_API int  wolfSSL_CTX_mcast_set_member_id(WOLFSSL_CTX*, unsigned short);
 WOLFSSL_API int  wolfSSL_set_secret(WOLFSSL*, unsigned short,
                      const unsigned char*, unsigned int,
@@ -2270,6 +2311,9 @@ WOLFSSL_API int wolfSSL_make_eap_keys(WOLFSSL*, void* key, unsigned int len,
 #ifndef NO_CERTS
     /* SSL_CTX versions */
     WOLFSSL_API int wolfSSL_CTX_UnloadCAs(WOLFSSL_CTX*);
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+    WOLFSSL_API int wolfSSL_CTX_SetVerifyCacheSize(WOLFSSL_CTX*, int sz);
+#endif
 #ifdef WOLFSSL_TRUST_PEER_CERT
     WOLFSSL_API int wolfSSL_CTX_Unload_trust_peers(WOLFSSL_CTX*);
     WOLFSSL_API int wolfSSL_CTX_trust_peer_buffer(WOLFSSL_CTX*,
@@ -2316,6 +2360,8 @@ WOLFSSL_API int wolfSSL_make_eap_keys(WOLFSSL*, void* key, unsigned int len,
 
 WOLFSSL_API int wolfSSL_CTX_set_group_messages(WOLFSSL_CTX*);
 WOLFSSL_API int wolfSSL_set_group_messages(WOLFSSL*);
+WOLFSSL_API int wolfSSL_CTX_set_coalesce_writes(WOLFSSL_CTX*, int records);
+WOLFSSL_API int wolfSSL_set_coalesce_writes(WOLFSSL*, int records);
 
 
 #ifdef HAVE_FUZZER
@@ -2704,6 +2750,10 @@ WOLFSSL_API void* wolfSSL_GetRsaDecCtx(WOLFSSL* ssl);
     WOLFSSL_API int wolfSSL_CertManagerLoadCABuffer(WOLFSSL_CERT_MANAGER*,
                                   const unsigned char* in, long sz, int format);
     WOLFSSL_API int wolfSSL_CertManagerUnloadCAs(WOLFSSL_CERT_MANAGER* cm);
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+    WOLFSSL_API int wolfSSL_CertManagerSetVerifyCacheSize(
+                                            WOLFSSL_CERT_MANAGER* cm, int sz);
+#endif
 #ifdef WOLFSSL_TRUST_PEER_CERT
     WOLFSSL_API int wolfSSL_CertManagerUnload_trust_peers(WOLFSSL_CERT_MANAGER* cm);
 #endif
@@ -2743,6 +2793,10 @@ WOLFSSL_API void* wolfSSL_GetRsaDecCtx(WOLFSSL* ssl);
                                                                    const char*);
     WOLFSSL_API int wolfSSL_CertManagerSetOCSP_Cb(WOLFSSL_CERT_MANAGER*,
                                                CbOCSPIO, CbOCSPRespFree, void*);
+    WOLFSSL_API int wolfSSL_CertManagerSetOCSPCacheSize(WOLFSSL_CERT_MANAGER*,
+                                                                        int sz);
+    WOLFSSL_API int wolfSSL_CertManagerRefreshOCSP(WOLFSSL_CERT_MANAGER*,
+                                                          unsigned int maxAge);
 
     WOLFSSL_API int wolfSSL_CertManagerEnableOCSPStapling(
                                                       WOLFSSL_CERT_MANAGER* cm);
@@ -2782,6 +2836,8 @@ WOLFSSL_API WOLFSSL_STACK* wolfSSL_CertManagerGetCerts(WOLFSSL_CERT_MANAGER* cm)
     WOLFSSL_API int wolfSSL_CTX_SetOCSP_OverrideURL(WOLFSSL_CTX*, const char*);
     WOLFSSL_API int wolfSSL_CTX_SetOCSP_Cb(WOLFSSL_CTX*,
                                                CbOCSPIO, CbOCSPRespFree, void*);
+    WOLFSSL_API int wolfSSL_CTX_SetOCSPCacheSize(WOLFSSL_CTX*, int sz);
+    WOLFSSL_API int wolfSSL_CTX_RefreshOCSP(WOLFSSL_CTX*, unsigned int maxAge);
     WOLFSSL_API int wolfSSL_CTX_EnableOCSPStapling(WOLFSSL_CTX*);
     WOLFSSL_API int wolfSSL_CTX_DisableOCSPStapling(WOLFSSL_CTX*);
 #endif /* !NO_CERTS */
@@ -3064,6 +3120,15 @@ WOLFSSL_API int wolfSSL_UseKeyShare(WOLFSSL* ssl, word16 group);
 WOLFSSL_API int wolfSSL_NoKeyShares(WOLFSSL* ssl);
 #endif
 
+#ifdef WOLFSSL_KEY_SHARE_POOL
+WOLFSSL_API int wolfSSL_CTX_UseKeySharePool(WOLFSSL_CTX* ctx, word16 group,
+                                            int depth);
+WOLFSSL_API int wolfSSL_CTX_KeySharePoolRefill(WOLFSSL_CTX* ctx);
+WOLFSSL_API int wolfSSL_CTX_KeySharePoolCount(WOLFSSL_CTX* ctx, word16 group);
+WOLFSSL_API int wolfSSL_CTX_KeySharePoolStart(WOLFSSL_CTX* ctx);
+WOLFSSL_API int wolfSSL_CTX_KeySharePoolStop(WOLFSSL_CTX* ctx);
+#endif
+
 
 /* Secure Renegotiation */
 #ifdef HAVE_SECURE_RENEGOTIATION
@@ -3113,6 +3178,12 @@ WOLFSSL_API int wolfSSL_CTX_set_TicketEncCb(WOLFSSL_CTX* ctx,
                                             SessionTicketEncCb);
 WOLFSSL_API int wolfSSL_CTX_set_TicketHint(WOLFSSL_CTX* ctx, int);
 WOLFSSL_API int wolfSSL_CTX_set_TicketEncCtx(WOLFSSL_CTX* ctx, void*);
+WOLFSSL_API int wolfSSL_CTX_UseDefTicketEncCb(WOLFSSL_CTX* ctx);
+WOLFSSL_API int wolfSSL_CTX_set_TicketKeySecret(WOLFSSL_CTX* ctx,
+                                               const unsigned char* secret,
+                                               unsigned int sz);
+WOLFSSL_API int wolfSSL_CTX_set_TicketKeyLifetime(WOLFSSL_CTX* ctx,
+                                                 unsigned int seconds);
 
 #endif /* NO_WOLFSSL_SERVER */
 
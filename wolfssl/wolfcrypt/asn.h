@@ -724,6 +724,9 @@ struct SignatureCtx {
     int typeH;
     int digestSz;
     word32 keyOID;
+#if defined(HAVE_ECC) && defined(WOLFSSL_ECC_KEY_TABLE)
+    struct ecc_key_table* eccTable;  /* signer's table, not owned */
+#endif
 #ifdef WOLFSSL_ASYNC_CRYPT
     WC_ASYNC_DEV* asyncDev;
     void* asyncCtx;
@@ -985,6 +988,12 @@ struct DecodedCert {
     #define SIGNER_DIGEST_SIZE WC_SHA_DIGEST_SIZE
 #endif
 
+/* verified certificates are remembered by the SHA-256 of their DER */
+#if defined(WOLFSSL_CERT_VERIFY_CACHE) && (defined(NO_SHA256) || \
+    defined(WOLFCRYPT_ONLY) || defined(NO_CERTS))
+    #undef WOLFSSL_CERT_VERIFY_CACHE
+#endif
+
 /* CA Signers */
 /* if change layout change PERSIST_CERT_CACHE functions too */
 struct Signer {
@@ -1016,8 +1025,19 @@ struct Signer {
 #endif
 #ifdef WOLFSSL_RENESAS_TSIP_TLS
     word32 cm_idx;
+#endif
+#if defined(HAVE_ECC) && defined(WOLFSSL_ECC_KEY_TABLE)
+    struct ecc_key_table* eccTable;  /* pre-computed public key table */
+#endif
+#ifdef WOLFSSL_CERT_VERIFY_CACHE
+    byte    verifyHash[WC_SHA256_DIGEST_SIZE];
+                                     /* sha256 of key type, key id and key */
+    byte    verifyHashSet;           /* verifyHash computed */
 #endif
     Signer* next;
+#ifndef NO_SKID
+    Signer* nameNext;                /* next in subject name hash row */
+#endif
 };
 
 
@@ -1078,6 +1098,9 @@ WOLFSSL_LOCAL int wc_GetPubX509(DecodedCert* cert, int verify, int* badDate);
 WOLFSSL_LOCAL const byte* OidFromId(word32 id, word32 type, word32* oidSz);
 WOLFSSL_LOCAL Signer* MakeSigner(void*);
 WOLFSSL_LOCAL void    FreeSigner(Signer*, void*);
+#if defined(HAVE_ECC) && defined(WOLFSSL_ECC_KEY_TABLE)
+WOLFSSL_LOCAL int     MakeSignerEccTable(Signer*, void*);
+#endif
 WOLFSSL_LOCAL void    FreeSignerTable(Signer**, int, void*);
 #ifdef WOLFSSL_TRUST_PEER_CERT
 WOLFSSL_LOCAL void    FreeTrustedPeer(TrustedPeerCert*, void*);
@@ -1280,7 +1303,7 @@ typedef struct OcspResponse OcspResponse;
 
 
 struct CertStatus {
-    CertStatus* next;
+    CertStatus* next;        /* next in OCSP cache row */
 
     byte serial[EXTERNAL_SERIAL_SIZE];
     int serialSz;
@@ -1300,6 +1323,11 @@ struct CertStatus {
 
     byte*  rawOcspResponse;
     word32 rawOcspResponseSz;
+    word32 cachedTime;       /* when stored in the OCSP cache, seconds */
+    word32 hash;             /* OCSP cache hash of issuer and serial */
+    struct OcspEntry* entry; /* OCSP cache issuer of the response */
+    CertStatus* lruPrev;     /* OCSP cache, less recently used */
+    CertStatus* lruNext;     /* OCSP cache, more recently used */
 };
 
 
@@ -1366,8 +1394,9 @@ struct OcspEntry
     OcspEntry *next;                      /* next entry             */
     byte issuerHash[OCSP_DIGEST_SIZE];    /* issuer hash            */
     byte issuerKeyHash[OCSP_DIGEST_SIZE]; /* issuer public key hash */
-    CertStatus *status;                   /* OCSP response list     */
-    int totalStatus;                      /* number on list         */
+    int totalStatus;                      /* cached responses       */
+    byte* url;                            /* responder for refresh  */
+    int urlSz;                            /* length of url          */
 };
 
 WOLFSSL_LOCAL void InitOcspResponse(OcspResponse*, CertStatus*, byte*, word32);
@@ -0,0 +1,292 @@
+/* async.h
+ *
+ * Copyright (C) 2006-2020 wolfSSL Inc.
+ *
+ * This file is part of wolfSSL.
+ *
+ * wolfSSL is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * wolfSSL is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1335, USA
+ */
+
+/* Software asynchronous crypto device. Public key operations on keys
+ * initialized with the device id returned by wolfAsync_DevOpen() return
+ * WC_PENDING_E and are completed by a pool of worker threads. Completion is
+ * reported through wolfEventQueue_Poll(). */
+
+#ifndef WOLF_CRYPT_ASYNC_H
+#define WOLF_CRYPT_ASYNC_H
+
+#include <wolfssl/wolfcrypt/types.h>
+
+#ifdef WOLFSSL_ASYNC_CRYPT
+
+#if defined(HAVE_CAVIUM) || defined(HAVE_INTEL_QA)
+    #error The in-tree async device only provides the software backend
+#endif
+
+#ifndef WC_NO_ASYNC_THREADING
+    #include <pthread.h>
+#endif
+#include <wolfssl/wolfcrypt/wolfevent.h>
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/* Device id handed out by wolfAsync_DevOpen() */
+#ifndef WOLFSSL_ASYNC_DEVID
+    #define WOLFSSL_ASYNC_DEVID         0x41535943 /* "ASYC" */
+#endif
+
+/* Number of worker threads, 0 means one per online CPU */
+#ifndef WC_ASYNC_THREAD_COUNT
+    #define WC_ASYNC_THREAD_COUNT       0
+#endif
+#ifndef WC_ASYNC_THREAD_MAX
+    #define WC_ASYNC_THREAD_MAX         64
+#endif
+
+/* Maximum operations a benchmark keeps in flight */
+#ifndef WOLF_ASYNC_MAX_PENDING
+    #define WOLF_ASYNC_MAX_PENDING      8
+#endif
+
+/* Only the public key algorithms are worth handing to another thread. The
+ * symmetric and hash paths may be enabled explicitly for testing. */
+#ifndef WC_ASYNC_NO_PKI
+    #ifndef NO_RSA
+        #define WC_ASYNC_ENABLE_RSA
+    #endif
+    #ifdef HAVE_ECC
+        #define WC_ASYNC_ENABLE_ECC
+    #endif
+    #ifndef NO_DH
+        #define WC_ASYNC_ENABLE_DH
+    #endif
+#endif /* !WC_ASYNC_NO_PKI */
+
+/* Smallest buffer handed to the device when AES/3DES are enabled */
+#ifndef WC_ASYNC_THRESH_AES_CBC
+    #define WC_ASYNC_THRESH_AES_CBC     1024
+#endif
+#ifndef WC_ASYNC_THRESH_AES_GCM
+    #define WC_ASYNC_THRESH_AES_GCM     1024
+#endif
+#ifndef WC_ASYNC_THRESH_DES3_CBC
+    #define WC_ASYNC_THRESH_DES3_CBC    1024
+#endif
+
+/* Markers identifying the object owning a WC_ASYNC_DEV */
+#define WOLFSSL_ASYNC_MARKER_INVALID    0x0
+#define WOLFSSL_ASYNC_MARKER_ARC4       0xBEEF0001
+#define WOLFSSL_ASYNC_MARKER_AES        0xBEEF0002
+#define WOLFSSL_ASYNC_MARKER_3DES       0xBEEF0003
+#define WOLFSSL_ASYNC_MARKER_RNG        0xBEEF0004
+#define WOLFSSL_ASYNC_MARKER_HMAC       0xBEEF0005
+#define WOLFSSL_ASYNC_MARKER_RSA        0xBEEF0006
+#define WOLFSSL_ASYNC_MARKER_ECC        0xBEEF0007
+#define WOLFSSL_ASYNC_MARKER_SHA512     0xBEEF0008
+#define WOLFSSL_ASYNC_MARKER_SHA        0xBEEF0009
+#define WOLFSSL_ASYNC_MARKER_SHA256     0xBEEF000A
+#define WOLFSSL_ASYNC_MARKER_DH         0xBEEF000B
+#define WOLFSSL_ASYNC_MARKER_MD5        0xBEEF000C
+#define WOLFSSL_ASYNC_MARKER_SHA224     0xBEEF000D
+#define WOLFSSL_ASYNC_MARKER_SHA384     0xBEEF000E
+#define WOLFSSL_ASYNC_MARKER_SHA3       0xBEEF000F
+
+/* Event flags */
+enum WC_ASYNC_FLAGS {
+    WC_ASYNC_FLAG_NONE       = 0x00000000,
+    WC_ASYNC_FLAG_CALL_AGAIN = 0x00000001, /* operation must be called again
+                                              to finish */
+};
+
+/* Operations the software device knows how to replay */
+enum WC_ASYNC_TEST_TYPE {
+    ASYNC_TEST_NONE = 0,
+    ASYNC_TEST_RSA_FUNC,
+    ASYNC_TEST_RSA_MAKE,
+    ASYNC_TEST_ECC_MAKE,
+    ASYNC_TEST_ECC_SIGN,
+    ASYNC_TEST_ECC_VERIFY,
+    ASYNC_TEST_ECC_SHARED_SEC,
+    ASYNC_TEST_DH_GEN,
+    ASYNC_TEST_DH_AGREE,
+    ASYNC_TEST_AES_CBC_ENCRYPT,
+    ASYNC_TEST_AES_CBC_DECRYPT,
+    ASYNC_TEST_AES_GCM_ENCRYPT,
+    ASYNC_TEST_AES_GCM_DECRYPT,
+    ASYNC_TEST_DES3_CBC_ENCRYPT,
+    ASYNC_TEST_DES3_CBC_DECRYPT,
+};
+
+struct Aes;
+struct Des3;
+struct RsaKey;
+struct ecc_key;
+struct DhKey;
+struct WC_RNG;
+
+/* Arguments captured when an operation is deferred, in args by operation
+ * type. Big integers and points are kept as void* since their type depends on
+ * the math library. */
+typedef struct WC_ASYNC_TEST {
+    int type;
+    union {
+        struct {
+            const byte* in;
+            byte* out;
+            word32* outSz;
+            struct RsaKey* key;
+            struct WC_RNG* rng;
+            word32 inSz;
+            int type;
+        } rsaFunc;
+        struct {
+            struct WC_RNG* rng;
+            struct RsaKey* key;
+            long e;
+            int size;
+        } rsaMake;
+        struct {
+            struct WC_RNG* rng;
+            struct ecc_key* key;
+            int size;
+            int curve_id;
+        } eccMake;
+        struct {
+            const byte* in;
+            struct WC_RNG* rng;
+            struct ecc_key* key;
+            void* r;
+            void* s;
+            word32 inSz;
+        } eccSign;
+        struct {
+            void* r;
+            void* s;
+            const byte* hash;
+            int* stat;
+            struct ecc_key* key;
+            word32 hashlen;
+        } eccVerify;
+        struct {
+            struct ecc_key* private_key;
+            void* public_point;
+            byte* out;
+            word32* outLen;
+        } eccSharedSec;
+        struct {
+            struct DhKey* key;
+            struct WC_RNG* rng;
+            byte* priv;
+            word32* privSz;
+            byte* pub;
+            word32* pubSz;
+        } dhGen;
+        struct {
+            struct DhKey* key;
+            byte* agree;
+            word32* agreeSz;
+            const byte* priv;
+            const byte* otherPub;
+            word32 privSz;
+            word32 pubSz;
+        } dhAgree;
+        struct {
+            struct Aes* aes;
+            byte* out;
+            const byte* in;
+            const byte* iv;
+            const byte* authTag;
+            const byte* authIn;
+            word32 sz;
+            word32 ivSz;
+            word32 authTagSz;
+            word32 authInSz;
+        } aes;
+        struct {
+            struct Des3* des;
+            byte* out;
+            const byte* in;
+            word32 sz;
+        } des;
+    } args;
+} WC_ASYNC_TEST;
+
+/* Where a deferred operation is, changed with the pool lock held */
+enum WC_ASYNC_SW_STATE {
+    WC_ASYNC_SW_IDLE = 0,
+    WC_ASYNC_SW_QUEUED,     /* waiting for a worker */
+    WC_ASYNC_SW_RUNNING,    /* taken by a worker or by wc_AsyncWait() */
+};
+
+typedef struct WC_ASYNC_DEV {
+    WOLF_EVENT event;   /* must be first, events are mapped back to devices */
+    word32 marker;      /* WOLFSSL_ASYNC_MARKER_* of owner, 0 when sync */
+    int    swRet;       /* result written by the worker thread */
+    int    swState;     /* WC_ASYNC_SW_* */
+    void*  heap;
+    struct WC_ASYNC_DEV* swNext; /* worker job list */
+    WC_ASYNC_TEST test;
+} WC_ASYNC_DEV;
+
+
+/* Device */
+WOLFSSL_API int  wolfAsync_DevOpen(int* devId);
+WOLFSSL_API int  wolfAsync_DevOpenThread(int* devId, void* threadId);
+WOLFSSL_API void wolfAsync_DevClose(int* devId);
+WOLFSSL_API int  wolfAsync_HardwareStart(void);
+WOLFSSL_API void wolfAsync_HardwareStop(void);
+
+/* Per-object context */
+WOLFSSL_API int  wolfAsync_DevCtxInit(WC_ASYNC_DEV* asyncDev, word32 marker,
+    void* heap, int devId);
+WOLFSSL_API void wolfAsync_DevCtxFree(WC_ASYNC_DEV* asyncDev, word32 marker);
+WOLFSSL_API int  wolfAsync_DevCopy(WC_ASYNC_DEV* src, WC_ASYNC_DEV* dst);
+
+/* Events */
+WOLFSSL_API int  wolfAsync_EventInit(WOLF_EVENT* event, WOLF_EVENT_TYPE type,
+    void* context, word32 flags);
+WOLFSSL_API int  wolfAsync_EventPoll(WOLF_EVENT* event, WOLF_EVENT_FLAG flags);
+WOLFSSL_API int  wolfAsync_EventPop(WOLF_EVENT* event, WOLF_EVENT_TYPE type);
+WOLFSSL_API int  wolfAsync_EventQueuePush(WOLF_EVENT_QUEUE* queue,
+    WOLF_EVENT* event);
+WOLFSSL_API int  wolfAsync_EventQueuePoll(WOLF_EVENT_QUEUE* queue,
+    void* context_filter, WOLF_EVENT** events, int maxEvents,
+    WOLF_EVENT_FLAG flags, int* eventCount);
+
+/* Operations */
+WOLFSSL_API int  wc_AsyncTestInit(WC_ASYNC_DEV* asyncDev, int type);
+WOLFSSL_API int  wc_AsyncHandle(WC_ASYNC_DEV* asyncDev,
+    WOLF_EVENT_QUEUE* queue, word32 flags);
+WOLFSSL_API int  wc_AsyncWait(int ret, WC_ASYNC_DEV* asyncDev, word32 flags);
+
+/* Threading helpers */
+WOLFSSL_API int  wc_AsyncGetNumberOfCpus(void);
+#ifndef WC_NO_ASYNC_THREADING
+    typedef void* (*AsyncThreadFunc_t)(void*);
+    WOLFSSL_API int  wc_AsyncThreadCreate(pthread_t* thread,
+        AsyncThreadFunc_t function, void* params);
+    WOLFSSL_API int  wc_AsyncThreadJoin(pthread_t* thread);
+    WOLFSSL_API void wc_AsyncThreadYield(void);
+#endif
+
+#ifdef __cplusplus
+    }   /* extern "C" */
+#endif
+
+#endif /* WOLFSSL_ASYNC_CRYPT */
+
+#endif /* WOLF_CRYPT_ASYNC_H */
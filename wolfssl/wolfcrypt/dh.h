@@ -67,6 +67,12 @@ struct DhKey {
 #ifdef WOLFSSL_ASYNC_CRYPT
     WC_ASYNC_DEV asyncDev;
 #endif
+#ifdef HAVE_MP_MONT_CTX
+    mp_mont_ctx* mont;                      /* cached Montgomery params of p */
+    #ifndef SINGLE_THREADED
+    wolfSSL_Mutex montMutex;
+    #endif
+#endif
 };
 
 #ifndef WC_DH_TYPE_DEFINED
@@ -93,6 +99,7 @@ WOLFSSL_API const DhParams* wc_Dh_ffdhe8192_Get(void);
 WOLFSSL_API int wc_InitDhKey(DhKey* key);
 WOLFSSL_API int wc_InitDhKey_ex(DhKey* key, void* heap, int devId);
 WOLFSSL_API int wc_FreeDhKey(DhKey* key);
+WOLFSSL_LOCAL void wc_DhFreeCache(DhKey* key);
 
 WOLFSSL_API int wc_DhGenerateKeyPair(DhKey* key, WC_RNG* rng, byte* priv,
                                  word32* privSz, byte* pub, word32* pubSz);
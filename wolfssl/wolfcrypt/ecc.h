@@ -326,6 +326,11 @@ typedef struct alt_fp_int {
     #define WC_ECCKEY_TYPE_DEFINED
 #endif
 
+#ifdef WOLFSSL_ECC_KEY_TABLE
+    /* Pre-computed multiples of a public key, opaque */
+    typedef struct ecc_key_table ecc_key_table;
+#endif
+
 
 /* A point on an ECC curve, stored in Jacobian format such that (x,y,z) =>
    (x/z^2, y/z^3, 1) when interpreted as affine */
@@ -413,6 +418,9 @@ struct ecc_key {
 #ifdef WOLFSSL_DSP
     remote_handle64 handle;
 #endif
+#ifdef WOLFSSL_ECC_KEY_TABLE
+    ecc_key_table* table; /* used when verifying, not owned by the key */
+#endif
 };
 
 
@@ -503,6 +511,15 @@ int wc_ecc_verify_hash_ex(mp_int *r, mp_int *s, const byte* hash,
                           word32 hashlen, int* stat, ecc_key* key);
 #endif /* HAVE_ECC_VERIFY */
 
+#ifdef WOLFSSL_ECC_KEY_TABLE
+WOLFSSL_API
+int wc_ecc_key_table_new(ecc_key* key, ecc_key_table** table, void* heap);
+WOLFSSL_API
+void wc_ecc_key_table_free(ecc_key_table* table);
+WOLFSSL_API
+int wc_ecc_set_key_table(ecc_key* key, ecc_key_table* table);
+#endif /* WOLFSSL_ECC_KEY_TABLE */
+
 WOLFSSL_API
 int wc_ecc_init(ecc_key* key);
 WOLFSSL_ABI WOLFSSL_API
@@ -46,10 +46,7 @@ enum wc_LogLevels {
 };
 
 #ifdef WOLFSSL_FUNC_TIME
-/* WARNING: This code is only to be used for debugging performance.
- *          The code is not thread-safe.
- *          Do not use WOLFSSL_FUNC_TIME in production code.
- */
+/* Functions timed with WOLFSSL_START() and WOLFSSL_END(). */
 enum wc_FuncNum {
     WC_FUNC_HELLO_REQUEST_SEND = 0,
     WC_FUNC_HELLO_REQUEST_DO,
@@ -122,13 +119,20 @@ WOLFSSL_API void wolfSSL_Debugging_OFF(void);
 #endif /* OPENSSL_EXTRA || DEBUG_WOLFSSL_VERBOSE */
 
 #ifdef WOLFSSL_FUNC_TIME
-    /* WARNING: This code is only to be used for debugging performance.
-     *          The code is not thread-safe.
-     *          Do not use WOLFSSL_FUNC_TIME in production code.
-     */
+    /* Counters are kept per thread and summed when read. */
+    typedef int (*wc_FuncTimeCb)(const char* name, word64 calls, word64 cycles,
+                                 void* ctx);
+
+    WOLFSSL_LOCAL int wc_FuncTimeInit(void);
+    WOLFSSL_LOCAL int wc_FuncTimeCleanup(void);
     WOLFSSL_API void WOLFSSL_START(int funcNum);
     WOLFSSL_API void WOLFSSL_END(int funcNum);
     WOLFSSL_API void WOLFSSL_TIME(int count);
+    WOLFSSL_API const char* wc_FuncTimeName(int funcNum);
+    WOLFSSL_API int  wc_FuncTimeGet(int funcNum, word64* calls,
+                                    word64* cycles);
+    WOLFSSL_API int  wc_FuncTimeDump(wc_FuncTimeCb cb, void* ctx);
+    WOLFSSL_API void wc_FuncTimeReset(void);
 #else
     #define WOLFSSL_START(n)
     #define WOLFSSL_END(n)
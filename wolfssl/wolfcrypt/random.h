@@ -75,6 +75,16 @@
     #endif
 #endif
 
+/* RNG pool seeds new DRBGs from a per thread parent DRBG */
+#ifdef WC_RNG_POOL
+    #if defined(HAVE_FIPS) || !defined(HAVE_HASHDRBG)
+        #error WC_RNG_POOL requires the Hash DRBG and is not for FIPS builds
+    #endif
+    #if !defined(HAVE_THREAD_LS) && !defined(SINGLE_THREADED)
+        #error WC_RNG_POOL requires thread local storage
+    #endif
+#endif
+
 
 /* avoid redefinition of structs */
 #if !defined(HAVE_FIPS) || \
@@ -213,6 +223,12 @@ WOLFSSL_API int  wc_InitRngNonce_ex(WC_RNG* rng, byte* nonce, word32 nonceSz,
 WOLFSSL_ABI WOLFSSL_API int wc_RNG_GenerateBlock(WC_RNG*, byte*, word32 sz);
 WOLFSSL_API int  wc_RNG_GenerateByte(WC_RNG*, byte*);
 WOLFSSL_API int  wc_FreeRng(WC_RNG*);
+#ifdef WC_RNG_POOL
+WOLFSSL_API int  wc_InitRngPool(WC_RNG* rng, void* heap, int devId);
+WOLFSSL_API void wc_RngPoolFree(void);
+WOLFSSL_LOCAL int  wc_RngPoolInit(void);
+WOLFSSL_LOCAL void wc_RngPoolCleanup(void);
+#endif
 #else
 #include <wolfssl/wolfcrypt/error-crypt.h>
 #define wc_InitRng(rng) NOT_COMPILED_IN
@@ -148,6 +148,27 @@ typedef struct RsaNb {
 #endif
 
 /* RSA */
+#ifdef HAVE_MP_MONT_CTX
+/* Montgomery parameters cached on a key, computed on first use */
+typedef struct RsaMont {
+    mp_mont_ctx n;
+#ifndef WOLFSSL_RSA_PUBLIC_ONLY
+    mp_mont_ctx p;
+    mp_mont_ctx q;
+#endif
+} RsaMont;
+#endif
+
+#ifdef WC_RSA_BLINDING
+/* Blinding pair cached on a private key, updated after every use */
+typedef struct RsaBlind {
+    mp_int r;                                 /* r^e mod n, blinds input */
+    mp_int rInv;                              /* r^-1 mod n, unblinds output */
+    mp_int n;                                 /* modulus pair was made for */
+    word32 uses;                              /* uses since pair generated */
+} RsaBlind;
+#endif
+
 struct RsaKey {
     mp_int n, e;
 #ifndef WOLFSSL_RSA_PUBLIC_ONLY
@@ -163,6 +184,14 @@ struct RsaKey {
     word32 dataLen;
 #ifdef WC_RSA_BLINDING
     WC_RNG* rng;                              /* for PrivateDecrypt blinding */
+    RsaBlind* blind;                          /* cached blinding pair */
+#endif
+#ifdef HAVE_MP_MONT_CTX
+    RsaMont* mont;                            /* cached Montgomery params */
+#endif
+#if (defined(WC_RSA_BLINDING) || defined(HAVE_MP_MONT_CTX)) && \
+    !defined(SINGLE_THREADED)
+    wolfSSL_Mutex cacheMutex;                 /* for cached blind and mont */
 #endif
 #ifdef WOLF_CRYPTO_CB
     int   devId;
@@ -281,6 +310,7 @@ WOLFSSL_API int  wc_RsaPublicKeyDecode(const byte* input, word32* inOutIdx,
 WOLFSSL_API int  wc_RsaPublicKeyDecodeRaw(const byte* n, word32 nSz,
                                         const byte* e, word32 eSz, RsaKey* key);
 WOLFSSL_API int wc_RsaKeyToDer(RsaKey*, byte* output, word32 inLen);
+WOLFSSL_LOCAL void wc_RsaFreeCache(RsaKey* key);
 
 
 #ifdef WC_RSA_BLINDING
@@ -1962,6 +1962,12 @@ extern void uITRON4_free(void *p) ;
         #error No async hardware defined with WOLFSSL_ASYNC_CRYPT!
     #endif
 
+    /* async worker threads are pthreads */
+    #if (defined(SINGLE_THREADED) || defined(USE_WINDOWS_API)) && \
+        !defined(WC_NO_ASYNC_THREADING)
+        #define WC_NO_ASYNC_THREADING
+    #endif
+
     /* Enable ECC_CACHE_CURVE for ASYNC */
     #if !defined(ECC_CACHE_CURVE)
         #define ECC_CACHE_CURVE
@@ -192,6 +192,17 @@ WOLFSSL_API void wc_Sha256Free(wc_Sha256*);
 
 WOLFSSL_API int wc_Sha256GetHash(wc_Sha256*, byte*);
 WOLFSSL_API int wc_Sha256Copy(wc_Sha256* src, wc_Sha256* dst);
+WOLFSSL_API int wc_Sha256HashMulti(const byte* data[], const word32 len[],
+                                  byte* hash[], word32 count);
+
+#if !defined(HAVE_FIPS) && !defined(WOLFSSL_TI_HASH) && \
+    !defined(WOLFSSL_CRYPTOCELL) && !defined(WOLFSSL_ARMASM)
+    /* HMAC iterations on digest sized messages for PBKDF2 */
+    #define WC_SHA256_HMAC_ITERATE
+WOLFSSL_LOCAL int Sha256HmacIterate(const byte* ipad, const byte* opad,
+                                    byte* u, byte* t, word32 count,
+                                    int iterations);
+#endif
 
 #ifdef WOLFSSL_PIC32MZ_HASH
 WOLFSSL_API void wc_Sha256SizeSet(wc_Sha256*, word32);
@@ -123,6 +123,8 @@ WOLFSSL_API int wc_Sha3_224_Final(wc_Sha3*, byte*);
 WOLFSSL_API void wc_Sha3_224_Free(wc_Sha3*);
 WOLFSSL_API int wc_Sha3_224_GetHash(wc_Sha3*, byte*);
 WOLFSSL_API int wc_Sha3_224_Copy(wc_Sha3* src, wc_Sha3* dst);
+WOLFSSL_API int wc_Sha3_224Hash_x4(const byte* data[4], const word32 len[4],
+                                  byte* hash[4]);
 
 WOLFSSL_API int wc_InitSha3_256(wc_Sha3*, void*, int);
 WOLFSSL_API int wc_Sha3_256_Update(wc_Sha3*, const byte*, word32);
@@ -130,6 +132,8 @@ WOLFSSL_API int wc_Sha3_256_Final(wc_Sha3*, byte*);
 WOLFSSL_API void wc_Sha3_256_Free(wc_Sha3*);
 WOLFSSL_API int wc_Sha3_256_GetHash(wc_Sha3*, byte*);
 WOLFSSL_API int wc_Sha3_256_Copy(wc_Sha3* src, wc_Sha3* dst);
+WOLFSSL_API int wc_Sha3_256Hash_x4(const byte* data[4], const word32 len[4],
+                                  byte* hash[4]);
 
 WOLFSSL_API int wc_InitSha3_384(wc_Sha3*, void*, int);
 WOLFSSL_API int wc_Sha3_384_Update(wc_Sha3*, const byte*, word32);
@@ -137,6 +141,8 @@ WOLFSSL_API int wc_Sha3_384_Final(wc_Sha3*, byte*);
 WOLFSSL_API void wc_Sha3_384_Free(wc_Sha3*);
 WOLFSSL_API int wc_Sha3_384_GetHash(wc_Sha3*, byte*);
 WOLFSSL_API int wc_Sha3_384_Copy(wc_Sha3* src, wc_Sha3* dst);
+WOLFSSL_API int wc_Sha3_384Hash_x4(const byte* data[4], const word32 len[4],
+                                  byte* hash[4]);
 
 WOLFSSL_API int wc_InitSha3_512(wc_Sha3*, void*, int);
 WOLFSSL_API int wc_Sha3_512_Update(wc_Sha3*, const byte*, word32);
@@ -144,12 +150,16 @@ WOLFSSL_API int wc_Sha3_512_Final(wc_Sha3*, byte*);
 WOLFSSL_API void wc_Sha3_512_Free(wc_Sha3*);
 WOLFSSL_API int wc_Sha3_512_GetHash(wc_Sha3*, byte*);
 WOLFSSL_API int wc_Sha3_512_Copy(wc_Sha3* src, wc_Sha3* dst);
+WOLFSSL_API int wc_Sha3_512Hash_x4(const byte* data[4], const word32 len[4],
+                                  byte* hash[4]);
 
 WOLFSSL_API int wc_InitShake256(wc_Shake*, void*, int);
 WOLFSSL_API int wc_Shake256_Update(wc_Shake*, const byte*, word32);
 WOLFSSL_API int wc_Shake256_Final(wc_Shake*, byte*, word32);
 WOLFSSL_API void wc_Shake256_Free(wc_Shake*);
 WOLFSSL_API int wc_Shake256_Copy(wc_Shake* src, wc_Sha3* dst);
+WOLFSSL_API int wc_Shake256Hash_x4(const byte* data[4], const word32 len[4],
+                                   byte* hash[4], word32 hashLen);
 
 #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
     WOLFSSL_API int wc_Sha3_SetFlags(wc_Sha3* sha3, word32 flags);
@@ -162,6 +162,8 @@ WOLFSSL_API void wc_Sha512Free(wc_Sha512*);
 
 WOLFSSL_API int wc_Sha512GetHash(wc_Sha512*, byte*);
 WOLFSSL_API int wc_Sha512Copy(wc_Sha512* src, wc_Sha512* dst);
+WOLFSSL_API int wc_Sha512HashMulti(const byte* data[], const word32 len[],
+                                  byte* hash[], word32 count);
 
 #if defined(WOLFSSL_HASH_FLAGS) || defined(WOLF_CRYPTO_CB)
     WOLFSSL_API int wc_Sha512SetFlags(wc_Sha512* sha512, word32 flags);
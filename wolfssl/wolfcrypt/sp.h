@@ -35,6 +35,14 @@
 
 #include <wolfssl/wolfcrypt/ecc.h>
 
+/* Tables of multiples of an arbitrary point, used when verifying repeatedly
+ * with the same public key. Generated by the C and x86_64 implementations. */
+#if defined(WOLFSSL_ECC_KEY_TABLE) && defined(WOLFSSL_HAVE_SP_ECC) && \
+    !defined(WOLFSSL_SP_SMALL) && !defined(RSA_LOW_MEM) && \
+    (!defined(WOLFSSL_SP_ASM) || defined(WOLFSSL_SP_X86_64_ASM))
+    #define WOLFSSL_SP_ECC_TABLE
+#endif
+
 #if defined(_MSC_VER)
     #define SP_NOINLINE __declspec(noinline)
 #elif defined(__IAR_SYSTEMS_ICC__) || defined(__GNUC__) || defined(__KEIL__)
@@ -109,6 +117,12 @@ int sp_ecc_sign_256(const byte* hash, word32 hashLen, WC_RNG* rng, mp_int* priv,
                     mp_int* rm, mp_int* sm, mp_int* km, void* heap);
 int sp_ecc_verify_256(const byte* hash, word32 hashLen, mp_int* pX, mp_int* pY,
                       mp_int* pZ, mp_int* r, mp_int* sm, int* res, void* heap);
+#ifdef WOLFSSL_SP_ECC_TABLE
+int sp_ecc_gen_table_256(ecc_point* gm, byte* table, word32* len, void* heap);
+int sp_ecc_verify_table_256(const byte* hash, word32 hashLen, mp_int* pX,
+                            mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm,
+                            int* res, const byte* table, void* heap);
+#endif
 int sp_ecc_is_point_256(mp_int* pX, mp_int* pY);
 int sp_ecc_check_key_256(mp_int* pX, mp_int* pY, mp_int* privm, void* heap);
 int sp_ecc_proj_add_point_256(mp_int* pX, mp_int* pY, mp_int* pZ,
@@ -131,6 +145,12 @@ int sp_ecc_sign_384(const byte* hash, word32 hashLen, WC_RNG* rng, mp_int* priv,
                     mp_int* rm, mp_int* sm, mp_int* km, void* heap);
 int sp_ecc_verify_384(const byte* hash, word32 hashLen, mp_int* pX, mp_int* pY,
                       mp_int* pZ, mp_int* r, mp_int* sm, int* res, void* heap);
+#ifdef WOLFSSL_SP_ECC_TABLE
+int sp_ecc_gen_table_384(ecc_point* gm, byte* table, word32* len, void* heap);
+int sp_ecc_verify_table_384(const byte* hash, word32 hashLen, mp_int* pX,
+                            mp_int* pY, mp_int* pZ, mp_int* r, mp_int* sm,
+                            int* res, const byte* table, void* heap);
+#endif
 int sp_ecc_is_point_384(mp_int* pX, mp_int* pY);
 int sp_ecc_check_key_384(mp_int* pX, mp_int* pY, mp_int* privm, void* heap);
 int sp_ecc_proj_add_point_384(mp_int* pX, mp_int* pY, mp_int* pZ,
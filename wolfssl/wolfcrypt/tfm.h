@@ -332,6 +332,22 @@ typedef fp_digit mp_digit;
 typedef fp_word  mp_word;
 typedef fp_int   mp_int;
 
+/* Montgomery parameters of a modulus used for many exponentiations, e.g.
+ * the primes of a long lived RSA key. Set once with fp_mont_ctx_set(). */
+#if !defined(NO_MP_MONT_CTX) && !defined(FREESCALE_LTC_TFM) && \
+    !defined(WOLFSSL_ESP32WROOM32_CRYPT_RSA_PRI)
+    #define HAVE_MP_MONT_CTX
+
+typedef struct fp_mont_ctx {
+    fp_int   m;         /* modulus parameters were computed for */
+    fp_int   r;         /* R mod m, one in Montgomery form */
+    fp_int   r2;        /* R^2 mod m, for converting into Montgomery form */
+    fp_digit rho;       /* -1/m mod b */
+} fp_mont_ctx;
+
+typedef fp_mont_ctx mp_mont_ctx;
+#endif
+
 
 /* wolf big int and common functions */
 #include <wolfssl/wolfcrypt/wolfmath.h>
@@ -558,6 +574,13 @@ int fp_montgomery_reduce(fp_int *a, fp_int *m, fp_digit mp);
 int fp_exptmod(fp_int *a, fp_int *b, fp_int *c, fp_int *d);
 int fp_exptmod_ex(fp_int *a, fp_int *b, int minDigits, fp_int *c, fp_int *d);
 int fp_exptmod_nct(fp_int *a, fp_int *b, fp_int *c, fp_int *d);
+#ifdef HAVE_MP_MONT_CTX
+int fp_mont_ctx_set(fp_mont_ctx *ctx, fp_int *m);
+int fp_exptmod_mont(fp_int *a, fp_int *b, int minDigits, fp_int *c,
+                    fp_mont_ctx *ctx, fp_int *d);
+int fp_exptmod_mont_nct(fp_int *a, fp_int *b, fp_int *c, fp_mont_ctx *ctx,
+                        fp_int *d);
+#endif
 
 #ifdef WC_RSA_NONBLOCK
 
@@ -750,6 +773,13 @@ MP_API int  mp_exptmod (mp_int * g, mp_int * x, mp_int * p, mp_int * y);
 MP_API int  mp_exptmod_ex (mp_int * g, mp_int * x, int minDigits, mp_int * p,
                            mp_int * y);
 MP_API int  mp_exptmod_nct (mp_int * g, mp_int * x, mp_int * p, mp_int * y);
+#ifdef HAVE_MP_MONT_CTX
+MP_API int  mp_mont_ctx_set (mp_mont_ctx * ctx, mp_int * m);
+MP_API int  mp_exptmod_mont (mp_int * g, mp_int * x, int minDigits, mp_int * p,
+                             mp_mont_ctx * ctx, mp_int * y);
+MP_API int  mp_exptmod_mont_nct (mp_int * g, mp_int * x, mp_int * p,
+                                 mp_mont_ctx * ctx, mp_int * y);
+#endif
 MP_API int  mp_mul_2d(mp_int *a, int b, mp_int *c);
 MP_API int  mp_2expt(mp_int* a, int b);
 
@@ -243,6 +243,14 @@
     #endif /* USE_WINDOWS_API */
 #endif /* SINGLE_THREADED */
 
+/* read-write lock, a plain mutex where the platform has none */
+#if defined(WOLFSSL_PTHREADS) && !defined(SINGLE_THREADED) && \
+    !defined(WOLFSSL_NO_RWLOCK)
+    typedef pthread_rwlock_t wolfSSL_RwLock;
+#else
+    typedef wolfSSL_Mutex wolfSSL_RwLock;
+#endif
+
 /* Enable crypt HW mutex for Freescale MMCAU, PIC32MZ or STM32 */
 #if defined(FREESCALE_MMCAU) || defined(WOLFSSL_MICROCHIP_PIC32MZ) || \
     defined(STM32_CRYPTO)
@@ -276,6 +284,12 @@ WOLFSSL_API wolfSSL_Mutex* wc_InitAndAllocMutex(void);
 WOLFSSL_API int wc_FreeMutex(wolfSSL_Mutex*);
 WOLFSSL_API int wc_LockMutex(wolfSSL_Mutex*);
 WOLFSSL_API int wc_UnLockMutex(wolfSSL_Mutex*);
+/* Read-write lock functions */
+WOLFSSL_API int wc_InitRwLock(wolfSSL_RwLock*);
+WOLFSSL_API int wc_FreeRwLock(wolfSSL_RwLock*);
+WOLFSSL_API int wc_LockRwLock_Rd(wolfSSL_RwLock*);
+WOLFSSL_API int wc_LockRwLock_Wr(wolfSSL_RwLock*);
+WOLFSSL_API int wc_UnLockRwLock(wolfSSL_RwLock*);
 #if defined(OPENSSL_EXTRA) || defined(HAVE_WEBSERVER)
 /* dynamically set which mutex to use. unlock / lock is controlled by flag */
 typedef void (mutex_cb)(int flag, int type, const char* file, int line);
@@ -301,6 +301,10 @@
     #if !defined(HAVE_SOCKADDR) && !defined(WOLFSSL_NO_SOCK)
         #define HAVE_SOCKADDR
     #endif
+    #if !defined(HAVE_SENDMSG) && !defined(USE_WINDOWS_API) && \
+        !defined(NO_WRITEV) && !defined(WOLFSSL_NO_SOCK)
+        #define HAVE_SENDMSG
+    #endif
 #endif
 
 #ifdef USE_WINDOWS_API
@@ -379,12 +383,22 @@ WOLFSSL_API  int wolfIO_Recv(SOCKET_T sd, char *buf, int sz, int rdFlags);
 #endif /* WOLFSSL_NO_SOCK */
 
 
+/* one buffer of a vectored send */
+typedef struct WOLFSSL_IOVEC {
+    char* buf;
+    int   sz;
+} WOLFSSL_IOVEC;
+
 WOLFSSL_API int BioSend(WOLFSSL* ssl, char *buf, int sz, void *ctx);
 WOLFSSL_API int BioReceive(WOLFSSL* ssl, char* buf, int sz, void* ctx);
 #if defined(USE_WOLFSSL_IO)
     /* default IO callbacks */
     WOLFSSL_API int EmbedReceive(WOLFSSL* ssl, char* buf, int sz, void* ctx);
     WOLFSSL_API int EmbedSend(WOLFSSL* ssl, char* buf, int sz, void* ctx);
+    #ifdef HAVE_SENDMSG
+        WOLFSSL_API int EmbedSendv(WOLFSSL* ssl, WOLFSSL_IOVEC* iov, int iovcnt,
+                                   void* ctx);
+    #endif
 
     #ifdef WOLFSSL_DTLS
         WOLFSSL_API int EmbedReceiveFrom(WOLFSSL* ssl, char* buf, int sz, void*);
@@ -446,10 +460,15 @@ WOLFSSL_API int BioReceive(WOLFSSL* ssl, char* buf, int sz, void* ctx);
 /* I/O callbacks */
 typedef int (*CallbackIORecv)(WOLFSSL *ssl, char *buf, int sz, void *ctx);
 typedef int (*CallbackIOSend)(WOLFSSL *ssl, char *buf, int sz, void *ctx);
+/* vectored send, used to flush coalesced records, one entry per record */
+typedef int (*CallbackIOSendv)(WOLFSSL *ssl, WOLFSSL_IOVEC *iov, int iovcnt,
+                               void *ctx);
 WOLFSSL_API void wolfSSL_CTX_SetIORecv(WOLFSSL_CTX*, CallbackIORecv);
 WOLFSSL_API void wolfSSL_CTX_SetIOSend(WOLFSSL_CTX*, CallbackIOSend);
+WOLFSSL_API void wolfSSL_CTX_SetIOSendv(WOLFSSL_CTX*, CallbackIOSendv);
 WOLFSSL_API void wolfSSL_SSLSetIORecv(WOLFSSL*, CallbackIORecv);
 WOLFSSL_API void wolfSSL_SSLSetIOSend(WOLFSSL*, CallbackIOSend);
+WOLFSSL_API void wolfSSL_SSLSetIOSendv(WOLFSSL*, CallbackIOSendv);
 /* deprecated old name */
 #define wolfSSL_SetIORecv wolfSSL_CTX_SetIORecv
 #define wolfSSL_SetIOSend wolfSSL_CTX_SetIOSend